@@ -60,6 +60,9 @@ struct SomasInfo {
   void *base_address_{nullptr};
   // Block offset -> address.
   std::map<size_t, void *> merged_base_addresses_;
+  // The memory preallocated once for the whole block and kept across the steps, base_address_ points to it. The graph
+  // runs without the memory alloc and free actors when it is set.
+  std::shared_ptr<void> static_arena_{nullptr};
 
   // The owner graph id.
   uint32_t graph_id_{0};
@@ -475,6 +478,7 @@ class BACKEND_EXPORT KernelGraph : public FuncGraph {
   // somas total memory size
   SomasInfo *MutableSomasInfo() const { return somas_info_.get(); }
   size_t somas_whole_block_size() const { return somas_info_->whole_block_size_; }
+  bool is_somas_static_arena() const { return somas_info_->static_arena_ != nullptr; }
   const std::map<size_t, size_t> &somas_merged_blocks_map() const { return somas_info_->merged_blocks_map_; }
 
  private:
@@ -16,6 +16,7 @@
 
 #include "backend/common/somas/somas.h"
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iterator>
 #include <memory>
@@ -1509,8 +1510,11 @@ void Somas::Solve(const session::KernelGraph &graph) {
   }
 
   somas_solver_ = std::make_shared<SomasSolverPre>();
+  auto solve_start = std::chrono::steady_clock::now();
   auto status =
     somas_solver_->Solving(graph, &solver_tensor_desc_map_, &reuse_matrix_, processed_contiguous_tensors_list_, false);
+  auto solve_time =
+    std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - solve_start).count();
   MS_LOG(INFO) << "End Solving";
 
   GenGraphStatisticInfo();
@@ -1529,6 +1533,9 @@ void Somas::Solve(const session::KernelGraph &graph) {
   UpdateContiguousTensorsOffset(contiguous_list_with_ref_index_map_);
 
   reused_memory_size_ = static_cast<size_t>(somas_solver_->GetMaxOffset());
+  MS_LOG(INFO) << "Somas planned peak: " << reused_memory_size_ << ", lower bound: " << lower_bound_ << ", ratio: "
+               << (lower_bound_ == 0 ? 1.0 : static_cast<double>(reused_memory_size_) / lower_bound_)
+               << ", solve time: " << solve_time << " ms";
 
   MS_LOG(INFO) << "Somas Assign end.";
 }
@@ -17,6 +17,8 @@
 #include "backend/common/somas/somas_solver_alg.h"
 
 #include <algorithm>
+#include <numeric>
+#include <random>
 #include <stack>
 #include <utility>
 
@@ -45,7 +47,17 @@ bool (*g_pBranching[kNumFittingTypes])(const pair<size_t, size_t> &a, const pair
   LargestFit, WorstFit
 #endif
 };
-size_t (*algorithm[kNumAlgorithmTypes])(FootPrint *p) = {SharedObjects, SingleObject};
+// kGlobalFit places the blocks without the footprints.
+size_t (*algorithm[kNumAlgorithmTypes])(FootPrint *p) = {SharedObjects, SingleObject, SingleObject};
+// The blocks placed between two checks of the time budget.
+constexpr size_t kDeadlineCheckBlocks = 64;
+// The local search of GlobalFit stops after this many iterations in a row without a lower peak.
+constexpr size_t kGlobalFitMaxStalls = 64;
+constexpr size_t kGlobalFitFirstOrders = 3;
+// A tensor of Global Fit takes its conflicts from the placed tensors in the order of the offsets, which gives the
+// forbidden ranges sorted, unless it has so few conflicts that sorting them costs less than walking the placed tensors.
+constexpr size_t kGlobalFitWalkRatio = 64;
+constexpr size_t kBitSetWidth = 64;
 
 size_t FootPrint::Result() {
   std::shared_ptr<FootPrint> foot_print = shared_from_this();
@@ -230,7 +242,12 @@ bool FastHeuristic::Eval(vector<BlockTensor> *block_tensors_v, const std::shared
   m_tensors_allocated_ = 0;
   SomasSolverTensorDescPtr tensor = nullptr;
 
+  size_t blocks_allocated = 0;
   for (auto &block : *block_tensors_v) {
+    if ((++blocks_allocated % kDeadlineCheckBlocks == 0) && OutOfTime()) {
+      MS_LOG(INFO) << "Fast Heuristic search runs out of time after " << blocks_allocated << " blocks";
+      return false;
+    }
     if (!block.m_bre_allocate_) {
       offset = block.m_start_tensor_->offset_;
       auto aux_id = foot_print->m_solId_;
@@ -271,5 +288,232 @@ bool FastHeuristic::Eval(vector<BlockTensor> *block_tensors_v, const std::shared
     << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start).count() << " ms";
   return true;
 }
+
+vector<vector<size_t>> GlobalFit::FirstOrders(const vector<BlockTensor> &block_tensors_v) const {
+  // The blocks come sorted by size. The number of conflicts stands for the lifetime of the block, the long living
+  // blocks are better placed first, so the blocks are also placed by size times conflicts and by conflicts alone.
+  vector<size_t> conflicts(block_tensors_v.size(), 0);
+  for (size_t i = 0; i < block_tensors_v.size(); ++i) {
+    for (auto tensor = block_tensors_v[i].m_start_tensor_; tensor != nullptr; tensor = tensor->right_) {
+      conflicts[i] = std::max(conflicts[i], constraints_->size() - (*constraints_)[tensor->index_].CountOnesNum());
+    }
+  }
+  vector<vector<size_t>> orders(kGlobalFitFirstOrders, vector<size_t>(block_tensors_v.size()));
+  std::iota(orders[0].begin(), orders[0].end(), 0);
+  orders[1] = orders[0];
+  std::stable_sort(orders[1].begin(), orders[1].end(), [&block_tensors_v, &conflicts](size_t a, size_t b) {
+    return block_tensors_v[a].m_size_ * conflicts[a] > block_tensors_v[b].m_size_ * conflicts[b];
+  });
+  orders[2] = orders[0];
+  std::stable_sort(orders[2].begin(), orders[2].end(),
+                   [&conflicts](size_t a, size_t b) { return conflicts[a] > conflicts[b]; });
+  return orders;
+}
+
+size_t GlobalFit::Eval(vector<BlockTensor> *block_tensors_v) {
+  MS_EXCEPTION_IF_NULL(block_tensors_v);
+  const auto &blocks = *block_tensors_v;
+  offsets_.assign(constraints_->size(), 0);
+  sizes_.assign(constraints_->size(), 0);
+  starts_.assign(blocks.size(), 0);
+  by_offset_.clear();
+  FindConflicts(blocks);
+  vector<size_t> order;
+  vector<size_t> best_starts;
+  size_t peak = SIZE_MAX;
+  for (auto &first_order : FirstOrders(blocks)) {
+    size_t first_peak = Place(blocks, first_order, 0);
+    if (first_peak < peak) {
+      peak = first_peak;
+      order.swap(first_order);
+      best_starts = starts_;
+    }
+  }
+  if (peak == SIZE_MAX) {
+    MS_LOG(INFO) << "Global Fit runs out of time before placing all the blocks";
+    return SIZE_MAX;
+  }
+
+  // Move a block reaching the peak to a random position before it, the order is kept when the peak does not increase,
+  // so that the search walks over the orders of the same peak until one with a lower peak.
+  std::mt19937 gen(0);
+  size_t stalls = 0;
+  // The first blocks of the order placed as in starts_, they are not placed again.
+  size_t valid = 0;
+  vector<size_t> peak_positions;
+  while ((stalls < kGlobalFitMaxStalls) && !OutOfTime()) {
+    peak_positions.clear();
+    for (size_t pos = 1; pos < order.size(); ++pos) {
+      if (best_starts[order[pos]] + blocks[order[pos]].m_size_ == peak) {
+        peak_positions.push_back(pos);
+      }
+    }
+    if (peak_positions.empty()) {
+      // The first block alone reaches the peak, no order does better.
+      break;
+    }
+    size_t pos = peak_positions[gen() % peak_positions.size()];
+    size_t target = gen() % pos;
+    vector<size_t> new_order = order;
+    auto moved = new_order.begin() + SizeToLong(pos);
+    std::rotate(new_order.begin() + SizeToLong(target), moved, moved + 1);
+    ++iterations_;
+    size_t new_peak = Place(blocks, new_order, std::min(target, valid));
+    valid = target;
+    stalls = new_peak < peak ? 0 : stalls + 1;
+    if (new_peak <= peak) {
+      peak = new_peak;
+      order.swap(new_order);
+      best_starts = starts_;
+      valid = order.size();
+    }
+  }
+
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    size_t offset = best_starts[i];
+    for (auto tensor = blocks[i].m_start_tensor_; tensor != nullptr; tensor = tensor->right_) {
+      tensor->offset_ = offset;
+      offset += tensor->size_;
+    }
+  }
+  return peak;
+}
+
+void GlobalFit::FindConflicts(const vector<BlockTensor> &block_tensors_v) {
+  DynamicBitSet in_blocks(constraints_->size());
+  for (const auto &block : block_tensors_v) {
+    for (auto tensor = block.m_start_tensor_; tensor != nullptr; tensor = tensor->right_) {
+      if (tensor->size_ != 0) {
+        in_blocks.SetBitTrue(tensor->index_);
+      }
+    }
+  }
+  conflict_words_.assign(constraints_->size(), {0, 0});
+  num_conflicts_.assign(constraints_->size(), 0);
+  for (const auto &block : block_tensors_v) {
+    for (auto tensor = block.m_start_tensor_; tensor != nullptr; tensor = tensor->right_) {
+      const auto &reuse = (*constraints_)[tensor->index_];
+      size_t first = in_blocks.bit_size_;
+      size_t last = 0;
+      size_t count = 0;
+      for (size_t i = 0; i < in_blocks.bit_size_; ++i) {
+        uint64_t conflicts = in_blocks.bit_[i] & ~reuse.bit_[i];
+        if (conflicts != 0) {
+          first = std::min(first, i);
+          last = i + 1;
+          count += static_cast<size_t>(__builtin_popcountll(conflicts));
+        }
+      }
+      conflict_words_[tensor->index_] = {std::min(first, last), last};
+      num_conflicts_[tensor->index_] = count;
+    }
+  }
+}
+
+size_t GlobalFit::Place(const vector<BlockTensor> &block_tensors_v, const vector<size_t> &order, size_t from) {
+  size_t peak = 0;
+  for (size_t pos = 0; pos < from; ++pos) {
+    peak = std::max(peak, starts_[order[pos]] + block_tensors_v[order[pos]].m_size_);
+  }
+  for (size_t pos = from; pos < order.size(); ++pos) {
+    for (auto tensor = block_tensors_v[order[pos]].m_start_tensor_; tensor != nullptr; tensor = tensor->right_) {
+      placed_.SetBitFalse(tensor->index_);
+    }
+  }
+  (void)by_offset_.erase(std::remove_if(by_offset_.begin(), by_offset_.end(),
+                                        [this](size_t index) { return !placed_.IsBitTrue(index); }),
+                         by_offset_.end());
+  for (size_t pos = from; pos < order.size(); ++pos) {
+    if (((pos - from + 1) % kDeadlineCheckBlocks == 0) && OutOfTime()) {
+      return SIZE_MAX;
+    }
+    const auto &block = block_tensors_v[order[pos]];
+    size_t offset = FindOffset(block);
+    starts_[order[pos]] = offset;
+    for (auto tensor = block.m_start_tensor_; tensor != nullptr; tensor = tensor->right_) {
+      offsets_[tensor->index_] = offset;
+      sizes_[tensor->index_] = tensor->size_;
+      placed_.SetBitTrue(tensor->index_);
+      if (tensor->size_ != 0) {
+        auto where = std::upper_bound(by_offset_.begin(), by_offset_.end(), offset,
+                                      [this](size_t value, size_t index) { return value < offsets_[index]; });
+        (void)by_offset_.insert(where, tensor->index_);
+      }
+      offset += tensor->size_;
+    }
+    peak = std::max(peak, offset);
+  }
+  return peak;
+}
+
+size_t GlobalFit::FindOffset(const BlockTensor &block) {
+  auto begin_less = [](const pair<size_t, size_t> &a, const pair<size_t, size_t> &b) { return a.first < b.first; };
+  forbidden_.clear();
+  size_t relative = 0;
+  for (auto tensor = block.m_start_tensor_; tensor != nullptr; tensor = tensor->right_) {
+    if (tensor->size_ == 0) {
+      continue;
+    }
+    auto run = SizeToLong(forbidden_.size());
+    if (num_conflicts_[tensor->index_] * kGlobalFitWalkRatio < by_offset_.size()) {
+      ScanConflicts(tensor->index_, tensor->size_, relative);
+      std::sort(forbidden_.begin() + run, forbidden_.end(), begin_less);
+    } else {
+      WalkConflicts(tensor->index_, tensor->size_, relative);
+    }
+    // The ranges of each tensor of the block are sorted, merge them with the ones of the tensors before it.
+    std::inplace_merge(forbidden_.begin(), forbidden_.begin() + run, forbidden_.end(), begin_less);
+    relative += tensor->size_;
+  }
+
+  // Any start between the merged forbidden ranges fits, pick the gap by the fitting strategy like the footprints do.
+  auto fit_func = g_pBranching[branching_strategy_];
+  bool found = false;
+  pair<size_t, size_t> fit_ret;
+  size_t top = 0;
+  for (const auto &range : forbidden_) {
+    if (range.first > top) {
+      auto fit_update = pair<size_t, size_t>(top, range.first - top);
+      if (!found || fit_func(fit_update, fit_ret)) {
+        fit_ret = fit_update;
+        found = true;
+      }
+    }
+    top = std::max(top, range.second);
+  }
+  return found ? fit_ret.first : top;
+}
+
+void GlobalFit::ScanConflicts(size_t index, size_t size, size_t relative) {
+  const auto &reuse = (*constraints_)[index];
+  const auto &words = conflict_words_[index];
+  for (size_t i = words.first; i < words.second; ++i) {
+    uint64_t conflicts = placed_.bit_[i] & ~reuse.bit_[i];
+    while (conflicts != 0) {
+      auto leading = static_cast<size_t>(__builtin_clzll(conflicts));
+      conflicts &= ~(static_cast<uint64_t>(1) << (kBitSetWidth - 1 - leading));
+      AddForbidden(i * kBitSetWidth + leading, size, relative);
+    }
+  }
+}
+
+void GlobalFit::WalkConflicts(size_t index, size_t size, size_t relative) {
+  const auto &reuse = (*constraints_)[index];
+  for (auto other : by_offset_) {
+    if (((reuse.bit_[other / kBitSetWidth] >> (kBitSetWidth - 1 - other % kBitSetWidth)) & 1) == 0) {
+      AddForbidden(other, size, relative);
+    }
+  }
+}
+
+void GlobalFit::AddForbidden(size_t other, size_t size, size_t relative) {
+  size_t other_end = offsets_[other] + sizes_[other];
+  if ((sizes_[other] == 0) || (other_end <= relative)) {
+    return;
+  }
+  // The tensor overlaps the other one when the block starts in (offset - relative - size, end - relative).
+  size_t begin = (offsets_[other] + 1 > relative + size) ? offsets_[other] + 1 - relative - size : 0;
+  forbidden_.emplace_back(begin, other_end - relative);
+}
 }  // namespace somas
 }  // namespace mindspore
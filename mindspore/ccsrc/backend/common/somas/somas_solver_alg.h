@@ -18,10 +18,12 @@
 #define MINDSPORE_CCSRC_BACKEND_COMMON_SOMAS_SOMAS_SOLVER_ALG_H_
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstddef>
 #include <cstring>
+#include <limits>
 #include <list>
 #include <memory>
 #include <numeric>
@@ -178,19 +180,101 @@ class FootPrint : public std::enable_shared_from_this<FootPrint> {
   uint32_t m_algorithm_;
 };
 
+// The time a solver may run, shared by the solvers of a sweep, it may be set while they run.
+class SolverTimeBudget {
+ public:
+  void Set(const std::chrono::nanoseconds &budget) { budget_ns_.store(budget.count(), std::memory_order_relaxed); }
+  std::chrono::nanoseconds Get() const { return std::chrono::nanoseconds(budget_ns_.load(std::memory_order_relaxed)); }
+  // Whether a solver started at the time given has run longer than the budget.
+  bool Exceeded(const std::chrono::steady_clock::time_point &start) const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() >
+           budget_ns_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<int64_t> budget_ns_{std::numeric_limits<int64_t>::max()};
+};
+
 class FastHeuristic {
  public:
   FastHeuristic() : m_alignment_(512), m_tensors_allocated_(0) {}
   ~FastHeuristic() = default;
 
   void setAlignment(const size_t &a) { m_alignment_ = a; }
+  // Eval gives up once the solver started at the time given runs out of the budget.
+  void setTimeBudget(const SolverTimeBudget *budget, const std::chrono::steady_clock::time_point &start) {
+    m_budget_ = budget;
+    m_start_ = start;
+  }
   void Destroy();
   bool Eval(vector<BlockTensor> *block_tensors_v, const std::shared_ptr<FootPrint> &foot_print,
             const std::vector<DynamicBitSet> *pConstraints);
 
  private:
+  bool OutOfTime() const { return m_budget_ != nullptr && m_budget_->Exceeded(m_start_); }
+
   size_t m_alignment_;
   size_t m_tensors_allocated_;
+  const SolverTimeBudget *m_budget_{nullptr};
+  std::chrono::steady_clock::time_point m_start_;
+};
+
+// Places the blocks one by one in the gap of the whole memory range picked by the fitting strategy, among the tensors
+// already placed and in conflict with the block, instead of footprint by footprint. The conflicting tensors are found
+// by walking the placed tensors in the order of the offsets and checking the constraints of the block, or for a
+// tensor with few conflicts, by intersecting its constraints with the placed tensors 64 tensors at a time. The blocks
+// are placed in a few orders, then the best order is improved by local search: a block reaching the peak is moved
+// forward and the blocks after it are placed again, which is kept unless the peak increases, until the search stalls
+// or the time budget runs out.
+class GlobalFit {
+ public:
+  GlobalFit(const std::vector<DynamicBitSet> *constraints, FittingType branching_strategy)
+      : constraints_(constraints), branching_strategy_(branching_strategy), placed_(constraints->size()) {}
+  ~GlobalFit() = default;
+
+  // Eval gives up once the solver started at the time given runs out of the budget.
+  void setTimeBudget(const SolverTimeBudget *budget, const std::chrono::steady_clock::time_point &start) {
+    budget_ = budget;
+    start_ = start;
+  }
+  // Set the offsets of the tensors of the blocks, sorted by size, and return the peak, or SIZE_MAX when the time budget
+  // runs out before the blocks are all placed once.
+  size_t Eval(vector<BlockTensor> *block_tensors_v);
+  size_t iterations() const { return iterations_; }
+
+ private:
+  bool OutOfTime() const { return budget_ != nullptr && budget_->Exceeded(start_); }
+  // The orders of the blocks to place first, the best placement is improved by the local search.
+  vector<vector<size_t>> FirstOrders(const vector<BlockTensor> &block_tensors_v) const;
+  void FindConflicts(const vector<BlockTensor> &block_tensors_v);
+  // Place the blocks in the order from the position given, the blocks before it stay where they are. The start offset
+  // of each block goes to starts_, returns the peak, or SIZE_MAX when the time budget runs out.
+  size_t Place(const vector<BlockTensor> &block_tensors_v, const vector<size_t> &order, size_t from);
+  size_t FindOffset(const BlockTensor &block);
+  // Add the forbidden ranges of the tensor of the size given, at the offset relative to the block, from the placed
+  // tensors in conflict with it. The walk adds them sorted by begin, the scan in the order of the index.
+  void ScanConflicts(size_t index, size_t size, size_t relative);
+  void WalkConflicts(size_t index, size_t size, size_t relative);
+  void AddForbidden(size_t other, size_t size, size_t relative);
+
+  const std::vector<DynamicBitSet> *constraints_;
+  FittingType branching_strategy_;
+  const SolverTimeBudget *budget_{nullptr};
+  std::chrono::steady_clock::time_point start_;
+  DynamicBitSet placed_;
+  // The offset and size of the placed tensors by index.
+  vector<size_t> offsets_;
+  vector<size_t> sizes_;
+  vector<size_t> starts_;
+  // The placed tensors sorted by offset.
+  vector<size_t> by_offset_;
+  // The words of the constraints from the first to past the last holding a conflict with a tensor of the blocks, and
+  // the number of these conflicts, by index.
+  vector<pair<size_t, size_t>> conflict_words_;
+  vector<size_t> num_conflicts_;
+  // The start offsets of the block which conflict with the placed tensors, as [begin, end).
+  vector<pair<size_t, size_t>> forbidden_;
+  size_t iterations_{0};
 };
 }  // namespace somas
 }  // namespace mindspore
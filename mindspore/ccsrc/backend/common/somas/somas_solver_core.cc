@@ -42,6 +42,7 @@ Status SomasSolverCore::MemoryAllocationSolver() {
     MS_LOG(INFO) << "Sorting strategy: " << sortingNames[sort_strategy_];
     MS_LOG(INFO) << "Offset strategy: " << branchingNames[branching_strategy_];
   }
+  start_ = std::chrono::steady_clock::now();
   BuildBlocks();
   SortTensors();
   upperbound_ = FindSolutions();
@@ -224,8 +225,9 @@ void SomasSolverCore::SortTensors() {  // need to sort the tensors for Fast Heur
 }
 
 size_t SomasSolverCore::Search(const std::shared_ptr<FootPrint> &pFootprint) {
-  size_t result = 0;
+  size_t result = SIZE_MAX;
   FastHeuristic fh;
+  fh.setTimeBudget(time_budget_.get(), start_);
   MS_LOG(INFO) << "Calling FastSolver Search for " << block_tensors_.size() << " tensors ";
   auto start = std::chrono::system_clock::now();
   if (fh.Eval(&block_tensors_, pFootprint, &constraints_)) {
@@ -253,6 +255,32 @@ size_t SomasSolverCore::Search(const std::shared_ptr<FootPrint> &pFootprint) {
   return upperbound_;
 }
 
+size_t SomasSolverCore::SearchGlobalFit() {
+  GlobalFit gf(&constraints_, branching_strategy_);
+  gf.setTimeBudget(time_budget_.get(), start_);
+  MS_LOG(INFO) << "Calling Global Fit Search for " << block_tensors_.size() << " tensors ";
+  auto start = std::chrono::system_clock::now();
+  size_t result = gf.Eval(&block_tensors_);
+  auto end = std::chrono::system_clock::now();
+  timing_ = std::chrono::duration_cast<std::chrono::milliseconds>((end - start)).count();
+  if (result == SIZE_MAX) {
+    MS_LOG(INFO) << "Global Fit could not find solution";
+  } else if (is_multi_thread_valid_) {
+    const double giga = 1073741824.;
+    MS_LOG(INFO) << timing_ << " ms\t" << sol_count_ + 1 << "/"
+                 << static_cast<size_t>(kNumFittingTypes) * static_cast<size_t>(kNumAlgorithmTypes) *
+                      static_cast<size_t>(kNumSortingTypes)
+                 << "\t" << result << " Bytes (" << result / giga << " GB)\t" << algorithmTypeNames[algorithm_]
+                 << "\t" << sortingNames[sort_strategy_] << "\t" << branchingNames[branching_strategy_] << "\t"
+                 << gf.iterations() << " local search iterations";
+  }
+  if (result < upperbound_) {
+    upperbound_ = result;
+    best_sol_ = sol_count_;
+  }
+  return upperbound_;
+}
+
 void SomasSolverCore::AppendLifelongTensors() {
   MS_LOG(DEBUG) << "Appending lifelong tensors to solution";
   size_t offset = upperbound_;
@@ -278,8 +306,15 @@ size_t SomasSolverCore::FindSolutions() {
   pFootprint->setBranchingStrategy(static_cast<uint32_t>(branching_strategy_));
   pFootprint->setCurrentSol(sol_count_);
   pFootprint->setAlgorithm(static_cast<uint32_t>(algorithm_));
-  Search(pFootprint);
-  AppendLifelongTensors();
+  if (algorithm_ == kGlobalFit) {
+    SearchGlobalFit();
+  } else {
+    Search(pFootprint);
+  }
+  // No solution within the time budget, the upperbound stays SIZE_MAX so that the solution is never picked.
+  if (upperbound_ != SIZE_MAX) {
+    AppendLifelongTensors();
+  }
   Destroy(&pFootprint);
   return upperbound_;
 }
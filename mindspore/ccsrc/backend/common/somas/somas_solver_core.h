@@ -57,6 +57,8 @@ class SomasSolverCore {
   void SetSortingStrategy(SortingType sort_strategy) { sort_strategy_ = sort_strategy; }
   void SetFittingStrategy(FittingType branching_strategy) { branching_strategy_ = branching_strategy; }
   void SetAlgorithmStrategy(AlgorithmType algorithm_strategy) { algorithm_ = algorithm_strategy; }
+  // The solver gives up once it runs out of the time budget, leaving the upperbound SIZE_MAX.
+  void SetTimeBudget(const std::shared_ptr<const SolverTimeBudget> &time_budget) { time_budget_ = time_budget; }
   const size_t &GetUpperbound() const { return upperbound_; }
   const size_t &Getlifelongmemory() const { return lifelong_memory_; }
 
@@ -75,9 +77,12 @@ class SomasSolverCore {
   size_t lifelong_memory_{0};
   bool verify_{false};
   bool is_multi_thread_valid_{true};
+  std::shared_ptr<const SolverTimeBudget> time_budget_{nullptr};
+  std::chrono::steady_clock::time_point start_;
 
   size_t FindSolutions();
   size_t Search(const std::shared_ptr<FootPrint> &pFootprint);
+  size_t SearchGlobalFit();
   void AppendLifelongTensors();
   void Destroy(std::shared_ptr<FootPrint> *pFootprint) const;
 };
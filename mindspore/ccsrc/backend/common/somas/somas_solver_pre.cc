@@ -14,12 +14,16 @@
  * limitations under the License.
 */
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <memory>
 #include <string>
 #include <utility>
 #include "include/common/thread_pool.h"
+#include "utils/ms_utils.h"
 
 #include "backend/common/somas/somas_solver_core.h"
 #include "backend/common/somas/somas_solver_pre.h"
@@ -29,6 +33,27 @@ namespace mindspore {
 namespace somas {
 constexpr auto kSolBytesThreshold = 100 * 1024 * 1024;
 constexpr auto kSolNumThresholdMultiThread = 8;
+// The time in ms each solution has to search, the first solution always runs to the end so that there is one. Unless
+// the env sets it, the budget is twice the time the first solution took, and at least 100 ms.
+constexpr auto kSolverTimeBudgetEnv = "MS_DEV_SOMAS_SOLVER_TIME_BUDGET";
+constexpr int64_t kSolverTimeScale = 2;
+constexpr int64_t kMinSolverTimeBudget = 100;
+
+// The time budget in ms set by the env, 0 when the budget follows the first solution.
+static int64_t GetSolverTimeBudget() {
+  auto env = common::GetEnv(kSolverTimeBudgetEnv);
+  if (env.empty()) {
+    return 0;
+  }
+  char *end = nullptr;
+  auto budget = std::strtoll(env.c_str(), &end, 10);
+  if (end == env.c_str() || *end != '\0' || budget <= 0) {
+    MS_LOG(WARNING) << "Invalid " << kSolverTimeBudgetEnv << ": " << env << ", the budget follows the first solution.";
+    return 0;
+  }
+  return budget;
+}
+
 Status SomasSolverPre::CheckTensors(const TensorsDescMap *pTensors, uint32_t index1, uint32_t index2) const {
   auto tensors = *pTensors;
   if (tensors[index1] == nullptr) {
@@ -105,6 +130,10 @@ void FindBest(size_t total_sol, const vector<std::shared_ptr<SomasSolverCore>> &
   for (size_t sol = 0; sol < total_sol; sol++) {
     auto &solver = solvers[sol];
     auto &upperbound = solver->GetUpperbound();
+    // Ran out of time without a solution.
+    if (upperbound == SIZE_MAX) {
+      continue;
+    }
     if (upperbound > best_info->worst) {
       best_info->worst = upperbound;
     }
@@ -141,6 +170,11 @@ Status SomasSolverPre::Solving(const session::KernelGraph &graph, TensorsDescMap
       return FAILED;
     }
     auto start = std::chrono::system_clock::now();
+    auto time_budget = GetSolverTimeBudget();
+    auto budget = std::make_shared<SolverTimeBudget>();
+    if (time_budget > 0) {
+      budget->Set(std::chrono::milliseconds(time_budget));
+    }
     for (size_t algorithm_strategy = 0, sol = 0; algorithm_strategy < numAlgorithmTypes; algorithm_strategy++) {
       for (size_t sort_strategy = 0; sort_strategy < numSortingTypes; sort_strategy++) {
         for (size_t branching_strategy = 0; branching_strategy < numFittingTypes; branching_strategy++) {
@@ -150,8 +184,19 @@ Status SomasSolverPre::Solving(const session::KernelGraph &graph, TensorsDescMap
           pSolver->SetSortingStrategy(SortingType(sort_strategy));
           pSolver->SetFittingStrategy(FittingType(branching_strategy));
           pSolver->VerifySolution(bVerifySolution);
-          auto task = [pSolver]() {
-            return pSolver->MemoryAllocationSolver() == SUCCESS ? common::SUCCESS : common::FAIL;
+          if (sol != 0) {
+            pSolver->SetTimeBudget(budget);
+          }
+          bool first_sets_budget = (sol == 0) && (time_budget == 0);
+          auto task = [pSolver, budget, first_sets_budget]() {
+            auto solver_start = std::chrono::steady_clock::now();
+            auto status = pSolver->MemoryAllocationSolver();
+            if (first_sets_budget) {
+              budget->Set(std::max<std::chrono::nanoseconds>((std::chrono::steady_clock::now() - solver_start) *
+                                                               kSolverTimeScale,
+                                                             std::chrono::milliseconds(kMinSolverTimeBudget)));
+            }
+            return status == SUCCESS ? common::SUCCESS : common::FAIL;
           };
           tasks.emplace_back(task);
           solvers.emplace_back(pSolver);
@@ -162,6 +207,16 @@ Status SomasSolverPre::Solving(const session::KernelGraph &graph, TensorsDescMap
     common::ThreadPool::GetInstance().SyncRun(tasks);
     BestInfo best_info;
     FindBest(total_sol, solvers, &best_info);
+    auto timeouts = std::count_if(solvers.begin(), solvers.end(),
+                                  [](const auto &solver) { return solver->GetUpperbound() == SIZE_MAX; });
+    if (timeouts > 0) {
+      MS_LOG(INFO) << timeouts << " of " << total_sol << " solutions ran out of the time budget "
+                   << std::chrono::duration_cast<std::chrono::milliseconds>(budget->Get()).count() << " ms";
+    }
+    if (best_info.best == SIZE_MAX) {
+      MS_LOG(WARNING) << "SOMAS SOLVER found no solution";
+      return FAILED;
+    }
     auto end = std::chrono::system_clock::now();
     size_t total_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
     auto &best_solver = solvers[best_info.best_sol];
@@ -41,10 +41,10 @@ constexpr char const *sortingNames[6] = {"size(>), index(<)",
                                          "size(>), constraints(>), index(<)",
                                          "size(>), constraints(>), index(>)"};
 constexpr char const *branchingNames[4] = {"bestfit", "smallest", "largest", "worstfit"};
-constexpr char const *algorithmTypeNames[2] = {"Shared Objects", "Single Object"};
+constexpr char const *algorithmTypeNames[3] = {"Shared Objects", "Single Object", "Global Fit"};
 constexpr auto kParallelComputeSizeThreshold = 2000;
 enum Status { FAILED, SUCCESS };
-enum AlgorithmType { kManyObjects = 0, kSingleObject, kNumAlgorithmTypes };
+enum AlgorithmType { kManyObjects = 0, kSingleObject, kGlobalFit, kNumAlgorithmTypes };
 enum SortingType {
   kGreaterSizeSmallerIndex = 0,
 #ifdef SOMAS_DEBUG
@@ -153,14 +153,14 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   virtual ~DynamicMemPoolBestFit();
 
   // The main program entry of memory alloc.
-  DeviceMemPtr AllocTensorMem(size_t size, bool from_persistent_mem = false);
+  virtual DeviceMemPtr AllocTensorMem(size_t size, bool from_persistent_mem = false);
   // The main program entry of continuous memory alloc.
-  std::vector<DeviceMemPtr> AllocContinuousTensorMem(const std::vector<size_t> &size_list);
+  virtual std::vector<DeviceMemPtr> AllocContinuousTensorMem(const std::vector<size_t> &size_list);
   // The main program entry of memory free.
-  void FreeTensorMem(const DeviceMemPtr &device_addr);
+  virtual void FreeTensorMem(const DeviceMemPtr &device_addr);
 
   // Release the real device memory.
-  void ReleaseDeviceRes();
+  virtual void ReleaseDeviceRes();
 
   // Get the minimum memory unit size using for dynamic extend.
   size_t MemAllocUnitSize(bool from_persistent_mem = false) const;
@@ -168,18 +168,18 @@ class BACKEND_EXPORT DynamicMemPoolBestFit {
   void SetMemAllocUintSize(size_t common_size, size_t persist_size = DYNAMIC_MEM_ALLOC_UNIT_SIZE);
 
   // The statistics information.
-  size_t TotalMemStatistics() const {
+  virtual size_t TotalMemStatistics() const {
     return common_mem_->mps_.total_mem_size_ + persistent_mem_->mps_.total_mem_size_;
   }
-  size_t TotalUsedMemStatistics() const {
+  virtual size_t TotalUsedMemStatistics() const {
     return common_mem_->mps_.total_used_mem_size_ + persistent_mem_->mps_.total_used_mem_size_;
   }
-  size_t UsedMemPeakStatistics() const {
+  virtual size_t UsedMemPeakStatistics() const {
     return common_mem_->mps_.used_mem_peak_size_ + persistent_mem_->mps_.used_mem_peak_size_;
   }
 
   // Display the brief state information of memory block and memory buf.
-  void DumpDynamicMemPoolStateInfo();
+  virtual void DumpDynamicMemPoolStateInfo();
   // Display the detailed debug information of memory block and memory buf.
   void DumpDynamicMemPoolDebugInfo();
 
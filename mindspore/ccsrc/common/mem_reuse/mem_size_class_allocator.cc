@@ -0,0 +1,715 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/mem_reuse/mem_size_class_allocator.h"
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+// The size class memory a thread cache gets from the central heap at once, and it returns the same when it holds
+// twice as much of a size class, or when it holds more than kMaxThreadCacheMemSize in all.
+constexpr size_t kBatchMemSize = 256 << 10;
+constexpr size_t kMaxBatchNum = 32;
+constexpr size_t kMaxThreadCacheMemSize = 4 << 20;
+
+size_t BatchNum(int size_class) {
+  return std::min(std::max(kBatchMemSize / DynamicMemPoolSizeClass::SizeClassSize(size_class), size_t(1)),
+                  kMaxBatchNum);
+}
+
+size_t PagesOf(size_t size) { return (size + kSizeClassPageSize - 1) >> kSizeClassPageShift; }
+
+// The live pools and the slots of the exited threads. They are never destroyed, so the threads exiting after the
+// static objects are gone still find them.
+struct ThreadCacheRegistry {
+  std::mutex mutex_;
+  std::set<DynamicMemPoolSizeClass *> pools_;
+  std::vector<size_t> free_slots_;
+  size_t next_slot_{0};
+};
+
+ThreadCacheRegistry &GetThreadCacheRegistry() {
+  static auto registry = new ThreadCacheRegistry();
+  return *registry;
+}
+}  // namespace
+
+// Every thread gets a slot for its cache in each pool. When the thread exits, the memory of its caches goes back to
+// the central heaps and the slot goes to the next thread.
+struct DynamicMemPoolSizeClass::ThreadSlot {
+  ThreadSlot() {
+    auto &registry = GetThreadCacheRegistry();
+    std::lock_guard<std::mutex> locker(registry.mutex_);
+    if (!registry.free_slots_.empty()) {
+      slot_ = registry.free_slots_.back();
+      registry.free_slots_.pop_back();
+    } else if (registry.next_slot_ < kMaxThreadCacheNum) {
+      slot_ = registry.next_slot_++;
+    }
+  }
+  ~ThreadSlot() {
+    if (slot_ >= kMaxThreadCacheNum) {
+      return;
+    }
+    auto &registry = GetThreadCacheRegistry();
+    std::lock_guard<std::mutex> locker(registry.mutex_);
+    for (auto pool : registry.pools_) {
+      pool->ReturnThreadCache(slot_);
+    }
+    registry.free_slots_.push_back(slot_);
+  }
+
+  // kMaxThreadCacheNum when there are too many threads.
+  size_t slot_{kMaxThreadCacheNum};
+};
+
+// The memory block from device, carved into pages.
+struct DynamicMemPoolSizeClass::Arena {
+  DeviceMemPtr base_{nullptr};
+  size_t num_pages_{0};
+  // The span of each page, every page of an allocated span and the first and last pages of a free span are set.
+  std::unique_ptr<std::atomic<Span *>[]> page_map_;
+};
+
+enum class SpanStatus : int { kFree, kLarge, kSlab, kPageClass };
+
+// The run of pages.
+struct DynamicMemPoolSizeClass::Span {
+  Arena *arena_{nullptr};
+  size_t first_page_{0};
+  size_t num_pages_{0};
+  SpanStatus status_{SpanStatus::kFree};
+  int size_class_{-1};
+  // The free objects and the number of used objects of a slab.
+  std::vector<DeviceMemPtr> free_objects_;
+  size_t used_objects_{0};
+  // The allocations in a large span not freed yet, several for the continuous memory.
+  size_t pieces_{0};
+  // The links in the free lists or the slab lists.
+  Span *prev_{nullptr};
+  Span *next_{nullptr};
+
+  DeviceMemPtr addr() const { return AddressOffset(arena_->base_, first_page_ << kSizeClassPageShift); }
+  size_t size() const { return num_pages_ << kSizeClassPageShift; }
+};
+
+// The size class memory of a thread, only used by its thread except the statistics.
+struct DynamicMemPoolSizeClass::ThreadCache {
+  ThreadCache() {
+    for (int size_class = 0; size_class < static_cast<int>(kSizeClassNum); ++size_class) {
+      bins_[size_class].reserve(BatchNum(size_class) * 2 + 1);
+    }
+  }
+  std::vector<DeviceMemPtr> bins_[kSizeClassNum];
+  std::atomic<size_t> cached_mem_size_{0};
+  std::atomic<size_t> requested_mem_size_{0};
+  std::atomic<size_t> rounded_mem_size_{0};
+};
+
+double SizeClassMemStats::ExternalFragmentation() const {
+  if (free_mem_size_ == 0) {
+    return 0;
+  }
+  return 1.0 - static_cast<double>(largest_free_span_size_) / free_mem_size_;
+}
+
+double SizeClassMemStats::InternalFragmentation() const {
+  if (rounded_mem_size_ == 0) {
+    return 0;
+  }
+  return 1.0 - static_cast<double>(requested_mem_size_) / rounded_mem_size_;
+}
+
+DynamicMemPoolSizeClass::DynamicMemPoolSizeClass()
+    : arenas_(std::make_unique<std::atomic<Arena *>[]>(kMaxArenaNum)),
+      thread_caches_(std::make_unique<std::atomic<ThreadCache *>[]>(kMaxThreadCacheNum)) {
+  auto &registry = GetThreadCacheRegistry();
+  std::lock_guard<std::mutex> locker(registry.mutex_);
+  (void)registry.pools_.insert(this);
+}
+
+DynamicMemPoolSizeClass::~DynamicMemPoolSizeClass() {
+  {
+    auto &registry = GetThreadCacheRegistry();
+    std::lock_guard<std::mutex> locker(registry.mutex_);
+    (void)registry.pools_.erase(this);
+  }
+  ClearCentralHeap();
+}
+
+int DynamicMemPoolSizeClass::SizeClassOf(size_t size) {
+  if (size <= (size_t(1) << kSmallSizeClassMaxShift)) {
+    int size_class = 0;
+    while ((size_t(1) << (kSmallSizeClassMinShift + IntToSize(size_class))) < size) {
+      ++size_class;
+    }
+    return size_class;
+  }
+  size_t num_pages = PagesOf(size);
+  if (num_pages > kPageSizeClassMaxPages) {
+    return -1;
+  }
+  return SizeToInt(kSmallSizeClassNum + num_pages - 1);
+}
+
+size_t DynamicMemPoolSizeClass::SizeClassSize(int size_class) {
+  if (IntToSize(size_class) < kSmallSizeClassNum) {
+    return size_t(1) << (kSmallSizeClassMinShift + IntToSize(size_class));
+  }
+  return (IntToSize(size_class) - kSmallSizeClassNum + 1) << kSizeClassPageShift;
+}
+
+DeviceMemPtr DynamicMemPoolSizeClass::AllocTensorMem(size_t size, bool from_persistent_mem) {
+  if (!size_class_enabled_) {
+    return DynamicMemPoolBestFit::AllocTensorMem(size, from_persistent_mem);
+  }
+  size_t align_size = AlignMemorySize(size);
+  // The persistent memory is never freed, keep it out of the thread caches.
+  int size_class = from_persistent_mem ? -1 : SizeClassOf(align_size);
+  ThreadCache *cache = size_class < 0 ? nullptr : GetThreadCache();
+  if (cache == nullptr) {
+    std::lock_guard<std::mutex> locker(heap_mutex_);
+    DeviceMemPtr device_addr = nullptr;
+    if (size_class >= 0) {
+      std::vector<DeviceMemPtr> objects;
+      if (FetchObjects(size_class, 1, &objects)) {
+        device_addr = objects[0];
+        rounded_mem_size_ += SizeClassSize(size_class);
+      }
+    } else {
+      Span *span = AllocSpan(PagesOf(align_size));
+      if (span != nullptr) {
+        span->status_ = SpanStatus::kLarge;
+        span->pieces_ = 1;
+        state_.total_used_mem_size_ += span->size();
+        state_.used_mem_peak_size_ = std::max(state_.used_mem_peak_size_, state_.total_used_mem_size_);
+        device_addr = span->addr();
+        rounded_mem_size_ += span->size();
+      }
+    }
+    if (device_addr == nullptr) {
+      DumpDynamicMemPoolStateInfo();
+      return nullptr;
+    }
+    requested_mem_size_ += size;
+    return device_addr;
+  }
+
+  auto &bin = cache->bins_[size_class];
+  size_t class_size = SizeClassSize(size_class);
+  if (bin.empty()) {
+    std::lock_guard<std::mutex> locker(heap_mutex_);
+    if (!FetchObjects(size_class, BatchNum(size_class), &bin)) {
+      DumpDynamicMemPoolStateInfo();
+      return nullptr;
+    }
+    (void)cache->cached_mem_size_.fetch_add(bin.size() * class_size, std::memory_order_relaxed);
+  }
+  DeviceMemPtr device_addr = bin.back();
+  bin.pop_back();
+  (void)cache->cached_mem_size_.fetch_sub(class_size, std::memory_order_relaxed);
+  (void)cache->requested_mem_size_.fetch_add(size, std::memory_order_relaxed);
+  (void)cache->rounded_mem_size_.fetch_add(class_size, std::memory_order_relaxed);
+  return device_addr;
+}
+
+std::vector<DeviceMemPtr> DynamicMemPoolSizeClass::AllocContinuousTensorMem(const std::vector<size_t> &size_list) {
+  if (!size_class_enabled_) {
+    return DynamicMemPoolBestFit::AllocContinuousTensorMem(size_list);
+  }
+  std::vector<DeviceMemPtr> device_addr_list;
+  if (size_list.empty()) {
+    return device_addr_list;
+  }
+  size_t total_size = std::accumulate(size_list.begin(), size_list.end(), IntToSize(0));
+  std::lock_guard<std::mutex> locker(heap_mutex_);
+  // The pieces share one large span, which goes back to the heap with its last piece.
+  Span *span = AllocSpan(PagesOf(AlignMemorySize(total_size)));
+  if (span == nullptr) {
+    DumpDynamicMemPoolStateInfo();
+    return device_addr_list;
+  }
+  span->status_ = SpanStatus::kLarge;
+  span->pieces_ = size_list.size();
+  state_.total_used_mem_size_ += span->size();
+  state_.used_mem_peak_size_ = std::max(state_.used_mem_peak_size_, state_.total_used_mem_size_);
+  requested_mem_size_ += total_size;
+  rounded_mem_size_ += span->size();
+  auto buf_addr = span->addr();
+  for (size_t size : size_list) {
+    device_addr_list.emplace_back(buf_addr);
+    buf_addr = AddressOffset(buf_addr, size);
+  }
+  return device_addr_list;
+}
+
+void DynamicMemPoolSizeClass::FreeTensorMem(const DeviceMemPtr &device_addr) {
+  if (!size_class_enabled_) {
+    DynamicMemPoolBestFit::FreeTensorMem(device_addr);
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(device_addr);
+  Span *span = FindSpan(device_addr);
+  if (span == nullptr) {
+    // Maybe destroy the memory pool first, then destroy the address, so this is normal case.
+    MS_LOG(DEBUG) << "Can't find the span of the device address[" << device_addr << "].";
+    return;
+  }
+  // The status and the size class of a span do not change while its memory is allocated.
+  if (span->status_ == SpanStatus::kSlab || span->status_ == SpanStatus::kPageClass) {
+    int size_class = span->size_class_;
+    ThreadCache *cache = GetThreadCache();
+    if (cache == nullptr) {
+      std::lock_guard<std::mutex> locker(heap_mutex_);
+      ReturnObjects(size_class, &device_addr, 1);
+      return;
+    }
+    auto &bin = cache->bins_[size_class];
+    bin.emplace_back(device_addr);
+    size_t class_size = SizeClassSize(size_class);
+    size_t cached_mem_size = cache->cached_mem_size_.fetch_add(class_size, std::memory_order_relaxed) + class_size;
+    size_t batch_num = BatchNum(size_class);
+    if (bin.size() > batch_num * 2 || cached_mem_size > kMaxThreadCacheMemSize) {
+      ReturnCachedObjects(cache, size_class, batch_num);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> locker(heap_mutex_);
+  if (span->status_ != SpanStatus::kLarge || span->pieces_ == 0) {
+    MS_LOG(EXCEPTION) << "The memory of the device address[" << device_addr << "] is not used.";
+  }
+  if (--span->pieces_ > 0) {
+    return;
+  }
+  state_.total_used_mem_size_ -= span->size();
+  FreeSpan(span);
+}
+
+void DynamicMemPoolSizeClass::FlushThreadCache() {
+  if (!size_class_enabled_) {
+    return;
+  }
+  ThreadCache *cache = GetThreadCache();
+  if (cache == nullptr) {
+    return;
+  }
+  for (int size_class = 0; size_class < static_cast<int>(kSizeClassNum); ++size_class) {
+    if (!cache->bins_[size_class].empty()) {
+      ReturnCachedObjects(cache, size_class, cache->bins_[size_class].size());
+    }
+  }
+}
+
+void DynamicMemPoolSizeClass::ReleaseDeviceRes() {
+  if (!size_class_enabled_) {
+    DynamicMemPoolBestFit::ReleaseDeviceRes();
+    return;
+  }
+  std::lock_guard<std::mutex> locker(heap_mutex_);
+  DumpDynamicMemPoolStateInfo();
+  for (size_t i = 0; i < arena_num_.load(); ++i) {
+    auto arena = arenas_[i].load();
+    if (!FreeDeviceMem(arena->base_)) {
+      MS_LOG(ERROR) << "Free device memory[" << arena->base_ << "] error.";
+    }
+  }
+  ClearCentralHeap();
+  state_ = DeviceState();
+}
+
+size_t DynamicMemPoolSizeClass::TotalMemStatistics() const {
+  return size_class_enabled_ ? state_.total_mem_size_ : DynamicMemPoolBestFit::TotalMemStatistics();
+}
+
+size_t DynamicMemPoolSizeClass::TotalUsedMemStatistics() const {
+  return size_class_enabled_ ? state_.total_used_mem_size_ : DynamicMemPoolBestFit::TotalUsedMemStatistics();
+}
+
+size_t DynamicMemPoolSizeClass::UsedMemPeakStatistics() const {
+  return size_class_enabled_ ? state_.used_mem_peak_size_ : DynamicMemPoolBestFit::UsedMemPeakStatistics();
+}
+
+SizeClassMemStats DynamicMemPoolSizeClass::GetSizeClassMemStats() {
+  SizeClassMemStats stats;
+  std::lock_guard<std::mutex> locker(heap_mutex_);
+  stats.total_mem_size_ = state_.total_mem_size_;
+  stats.used_mem_size_ = state_.total_used_mem_size_;
+  stats.used_mem_peak_size_ = state_.used_mem_peak_size_;
+  stats.requested_mem_size_ = requested_mem_size_;
+  stats.rounded_mem_size_ = rounded_mem_size_;
+  for (size_t i = 0; i < kMaxThreadCacheNum; ++i) {
+    auto cache = thread_caches_[i].load(std::memory_order_acquire);
+    if (cache != nullptr) {
+      stats.cached_mem_size_ += cache->cached_mem_size_.load(std::memory_order_relaxed);
+      stats.requested_mem_size_ += cache->requested_mem_size_.load(std::memory_order_relaxed);
+      stats.rounded_mem_size_ += cache->rounded_mem_size_.load(std::memory_order_relaxed);
+    }
+  }
+  for (size_t i = 0; i < kSmallSizeClassNum; ++i) {
+    for (auto slab = slab_lists_[i]; slab != nullptr; slab = slab->next_) {
+      stats.slab_free_mem_size_ += slab->free_objects_.size() * SizeClassSize(SizeToInt(i));
+    }
+  }
+  auto add_free_span = [&stats](const Span *span) {
+    stats.free_mem_size_ += span->size();
+    stats.largest_free_span_size_ = std::max(stats.largest_free_span_size_, span->size());
+    ++stats.free_span_num_;
+  };
+  for (size_t i = 1; i <= kMaxListPages; ++i) {
+    for (auto span = free_lists_[i]; span != nullptr; span = span->next_) {
+      add_free_span(span);
+    }
+  }
+  for (const auto &item : large_free_spans_) {
+    add_free_span(item.second);
+  }
+  return stats;
+}
+
+void DynamicMemPoolSizeClass::DumpDynamicMemPoolStateInfo() {
+  if (!size_class_enabled_) {
+    DynamicMemPoolBestFit::DumpDynamicMemPoolStateInfo();
+    return;
+  }
+  // Called with the mutex locked from the allocation, read the statistics directly.
+  MS_LOG(INFO) << "The size class memory pool total allocated mem:" << state_.total_mem_size_ / kMBToByte
+               << "M, peak used mem:" << state_.used_mem_peak_size_ / kMBToByte
+               << "M, in used mem:" << state_.total_used_mem_size_ / kMBToByte
+               << "M, arena counts:" << arena_num_.load()
+               << ", large free span counts:" << large_free_spans_.size() << ".";
+}
+
+DynamicMemPoolSizeClass::ThreadCache *DynamicMemPoolSizeClass::GetThreadCache() {
+  thread_local ThreadSlot thread_slot;
+  size_t slot = thread_slot.slot_;
+  if (slot >= kMaxThreadCacheNum) {
+    return nullptr;
+  }
+  auto cache = thread_caches_[slot].load(std::memory_order_acquire);
+  if (cache == nullptr) {
+    // Only the thread of the slot sets it.
+    cache = new (std::nothrow) ThreadCache();
+    thread_caches_[slot].store(cache, std::memory_order_release);
+  }
+  return cache;
+}
+
+bool DynamicMemPoolSizeClass::FetchObjects(int size_class, size_t num, std::vector<DeviceMemPtr> *objects) {
+  MS_EXCEPTION_IF_NULL(objects);
+  size_t class_size = SizeClassSize(size_class);
+  size_t fetched = 0;
+  if (IntToSize(size_class) >= kSmallSizeClassNum) {
+    for (; fetched < num; ++fetched) {
+      Span *span = AllocSpan(PagesOf(class_size));
+      if (span == nullptr) {
+        break;
+      }
+      span->status_ = SpanStatus::kPageClass;
+      span->size_class_ = size_class;
+      objects->emplace_back(span->addr());
+    }
+  } else {
+    auto &slab_list = slab_lists_[size_class];
+    while (fetched < num) {
+      Span *slab = slab_list;
+      if (slab == nullptr) {
+        slab = AllocSpan(1);
+        if (slab == nullptr) {
+          break;
+        }
+        slab->status_ = SpanStatus::kSlab;
+        slab->size_class_ = size_class;
+        size_t num_objects = kSizeClassPageSize / class_size;
+        slab->free_objects_.resize(num_objects);
+        for (size_t i = 0; i < num_objects; ++i) {
+          // Hand out the objects from the lowest address.
+          slab->free_objects_[i] = AddressOffset(slab->addr(), (num_objects - i - 1) * class_size);
+        }
+        slab->used_objects_ = 0;
+        PushSpan(&slab_list, slab);
+      }
+      for (; fetched < num && !slab->free_objects_.empty(); ++fetched) {
+        objects->emplace_back(slab->free_objects_.back());
+        slab->free_objects_.pop_back();
+        ++slab->used_objects_;
+      }
+      if (slab->free_objects_.empty()) {
+        slab_list = slab->next_;
+        if (slab_list != nullptr) {
+          slab_list->prev_ = nullptr;
+        }
+        slab->next_ = nullptr;
+      }
+    }
+  }
+  state_.total_used_mem_size_ += fetched * class_size;
+  state_.used_mem_peak_size_ = std::max(state_.used_mem_peak_size_, state_.total_used_mem_size_);
+  return fetched > 0;
+}
+
+void DynamicMemPoolSizeClass::ReturnObjects(int size_class, const DeviceMemPtr *objects, size_t num) {
+  size_t class_size = SizeClassSize(size_class);
+  for (size_t i = 0; i < num; ++i) {
+    Span *span = FindSpan(objects[i]);
+    MS_EXCEPTION_IF_NULL(span);
+    if (span->size_class_ != size_class) {
+      MS_LOG(EXCEPTION) << "The device address[" << objects[i] << "] is not of size class " << size_class << ".";
+    }
+    if (span->status_ == SpanStatus::kPageClass) {
+      FreeSpan(span);
+      continue;
+    }
+    auto &slab_list = slab_lists_[size_class];
+    if (span->free_objects_.empty()) {
+      PushSpan(&slab_list, span);
+    }
+    span->free_objects_.emplace_back(objects[i]);
+    if (--span->used_objects_ > 0) {
+      continue;
+    }
+    // The slab is unused, give back its page.
+    if (span->prev_ != nullptr) {
+      span->prev_->next_ = span->next_;
+    } else {
+      slab_list = span->next_;
+    }
+    if (span->next_ != nullptr) {
+      span->next_->prev_ = span->prev_;
+    }
+    span->prev_ = nullptr;
+    span->next_ = nullptr;
+    std::vector<DeviceMemPtr>().swap(span->free_objects_);
+    FreeSpan(span);
+  }
+  state_.total_used_mem_size_ -= num * class_size;
+}
+
+void DynamicMemPoolSizeClass::ReturnThreadCache(size_t slot) {
+  // Under the mutex, so that ReleaseDeviceRes does not delete the cache meanwhile.
+  std::lock_guard<std::mutex> locker(heap_mutex_);
+  auto cache = thread_caches_[slot].load(std::memory_order_acquire);
+  if (cache == nullptr) {
+    return;
+  }
+  for (int size_class = 0; size_class < static_cast<int>(kSizeClassNum); ++size_class) {
+    auto &bin = cache->bins_[size_class];
+    if (!bin.empty()) {
+      ReturnObjects(size_class, bin.data(), bin.size());
+      bin.clear();
+    }
+  }
+  cache->cached_mem_size_.store(0, std::memory_order_relaxed);
+}
+
+void DynamicMemPoolSizeClass::ReturnCachedObjects(ThreadCache *cache, int size_class, size_t num) {
+  auto &bin = cache->bins_[size_class];
+  num = std::min(num, bin.size());
+  {
+    std::lock_guard<std::mutex> locker(heap_mutex_);
+    ReturnObjects(size_class, bin.data() + bin.size() - num, num);
+  }
+  bin.resize(bin.size() - num);
+  (void)cache->cached_mem_size_.fetch_sub(num * SizeClassSize(size_class), std::memory_order_relaxed);
+}
+
+DynamicMemPoolSizeClass::Span *DynamicMemPoolSizeClass::AllocSpan(size_t num_pages) {
+  Span *span = nullptr;
+  for (size_t i = num_pages; i <= kMaxListPages && span == nullptr; ++i) {
+    span = free_lists_[i];
+  }
+  if (span == nullptr) {
+    auto iter = large_free_spans_.lower_bound(std::make_pair(num_pages, nullptr));
+    if (iter != large_free_spans_.end()) {
+      span = iter->second;
+    }
+  }
+  if (span == nullptr) {
+    if (!AddArena(num_pages)) {
+      return nullptr;
+    }
+    return AllocSpan(num_pages);
+  }
+  EraseFreeSpan(span);
+  if (span->num_pages_ > num_pages) {
+    // Split the rest into a free span.
+    auto rest = new (std::nothrow) Span();
+    MS_EXCEPTION_IF_NULL(rest);
+    rest->arena_ = span->arena_;
+    rest->first_page_ = span->first_page_ + num_pages;
+    rest->num_pages_ = span->num_pages_ - num_pages;
+    span->num_pages_ = num_pages;
+    InsertFreeSpan(rest);
+  }
+  span->size_class_ = -1;
+  span->pieces_ = 0;
+  // The address of any page finds the allocated span.
+  SetSpanPages(span, span->first_page_, span->first_page_ + span->num_pages_);
+  return span;
+}
+
+void DynamicMemPoolSizeClass::FreeSpan(Span *span) {
+  auto arena = span->arena_;
+  span->status_ = SpanStatus::kFree;
+  span->size_class_ = -1;
+  // Coalesce with the free neighbours, found by the pages around the span.
+  if (span->first_page_ > 0) {
+    auto prev = arena->page_map_[span->first_page_ - 1].load(std::memory_order_relaxed);
+    if (prev != nullptr && prev->status_ == SpanStatus::kFree) {
+      EraseFreeSpan(prev);
+      prev->num_pages_ += span->num_pages_;
+      delete span;
+      span = prev;
+    }
+  }
+  size_t end_page = span->first_page_ + span->num_pages_;
+  if (end_page < arena->num_pages_) {
+    auto next = arena->page_map_[end_page].load(std::memory_order_relaxed);
+    if (next != nullptr && next->status_ == SpanStatus::kFree) {
+      EraseFreeSpan(next);
+      span->num_pages_ += next->num_pages_;
+      delete next;
+    }
+  }
+  InsertFreeSpan(span);
+}
+
+bool DynamicMemPoolSizeClass::AddArena(size_t num_pages) {
+  if (arena_num_.load() >= kMaxArenaNum) {
+    MS_LOG(WARNING) << "The size class memory pool can not hold more than " << kMaxArenaNum << " memory blocks.";
+    return false;
+  }
+  size_t size = num_pages << kSizeClassPageShift;
+  size_t alloc_size = CalMemBlockAllocSize(size, false);
+  if (alloc_size < size) {
+    return false;
+  }
+  DeviceMemPtr device_addr = nullptr;
+  auto real_alloc_size = AllocDeviceMem(alloc_size, &device_addr);
+  if (real_alloc_size < size || device_addr == nullptr) {
+    MS_LOG(WARNING) << "Memory not enough: alloc size[" << real_alloc_size << "] is smaller than required size[" << size
+                    << "].";
+    if (device_addr != nullptr) {
+      (void)FreeDeviceMem(device_addr);
+    }
+    return false;
+  }
+  auto arena = new (std::nothrow) Arena();
+  MS_EXCEPTION_IF_NULL(arena);
+  arena->base_ = device_addr;
+  arena->num_pages_ = real_alloc_size >> kSizeClassPageShift;
+  arena->page_map_ = std::make_unique<std::atomic<Span *>[]>(arena->num_pages_);
+  auto span = new (std::nothrow) Span();
+  MS_EXCEPTION_IF_NULL(span);
+  span->arena_ = arena;
+  span->num_pages_ = arena->num_pages_;
+  size_t index = arena_num_.load();
+  arenas_[index].store(arena, std::memory_order_release);
+  arena_num_.store(index + 1, std::memory_order_release);
+  InsertFreeSpan(span);
+  state_.total_mem_size_ += arena->num_pages_ << kSizeClassPageShift;
+  MS_LOG(INFO) << "Add the memory block of size class memory pool, size:" << real_alloc_size
+               << ", total allocated mem:" << state_.total_mem_size_ << ".";
+  return true;
+}
+
+void DynamicMemPoolSizeClass::InsertFreeSpan(Span *span) {
+  span->status_ = SpanStatus::kFree;
+  auto &page_map = span->arena_->page_map_;
+  page_map[span->first_page_].store(span, std::memory_order_relaxed);
+  page_map[span->first_page_ + span->num_pages_ - 1].store(span, std::memory_order_relaxed);
+  if (span->num_pages_ <= kMaxListPages) {
+    PushSpan(&free_lists_[span->num_pages_], span);
+  } else {
+    (void)large_free_spans_.emplace(span->num_pages_, span);
+  }
+}
+
+void DynamicMemPoolSizeClass::EraseFreeSpan(Span *span) {
+  if (span->num_pages_ > kMaxListPages) {
+    (void)large_free_spans_.erase(std::make_pair(span->num_pages_, span));
+    return;
+  }
+  if (span->prev_ != nullptr) {
+    span->prev_->next_ = span->next_;
+  } else {
+    free_lists_[span->num_pages_] = span->next_;
+  }
+  if (span->next_ != nullptr) {
+    span->next_->prev_ = span->prev_;
+  }
+  span->prev_ = nullptr;
+  span->next_ = nullptr;
+}
+
+void DynamicMemPoolSizeClass::SetSpanPages(Span *span, size_t begin, size_t end) {
+  auto &page_map = span->arena_->page_map_;
+  for (size_t i = begin; i < end; ++i) {
+    page_map[i].store(span, std::memory_order_release);
+  }
+}
+
+DynamicMemPoolSizeClass::Span *DynamicMemPoolSizeClass::FindSpan(const DeviceMemPtr &device_addr) const {
+  auto addr = static_cast<uint8_t *>(device_addr);
+  size_t arena_num = arena_num_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < arena_num; ++i) {
+    auto arena = arenas_[i].load(std::memory_order_acquire);
+    auto base = static_cast<uint8_t *>(arena->base_);
+    if (addr >= base && addr < base + (arena->num_pages_ << kSizeClassPageShift)) {
+      return arena->page_map_[static_cast<size_t>(addr - base) >> kSizeClassPageShift].load(std::memory_order_acquire);
+    }
+  }
+  return nullptr;
+}
+
+void DynamicMemPoolSizeClass::ClearCentralHeap() {
+  for (size_t i = 0; i < kMaxThreadCacheNum; ++i) {
+    delete thread_caches_[i].exchange(nullptr);
+  }
+  // Walk the spans of each arena by their first pages.
+  for (size_t i = 0; i < arena_num_.load(); ++i) {
+    auto arena = arenas_[i].exchange(nullptr);
+    for (size_t page = 0; page < arena->num_pages_;) {
+      auto span = arena->page_map_[page].load();
+      MS_EXCEPTION_IF_NULL(span);
+      page += span->num_pages_;
+      delete span;
+    }
+    delete arena;
+  }
+  arena_num_ = 0;
+  std::fill(std::begin(free_lists_), std::end(free_lists_), nullptr);
+  std::fill(std::begin(slab_lists_), std::end(slab_lists_), nullptr);
+  large_free_spans_.clear();
+  requested_mem_size_ = 0;
+  rounded_mem_size_ = 0;
+}
+
+void DynamicMemPoolSizeClass::PushSpan(Span **list, Span *span) {
+  span->prev_ = nullptr;
+  span->next_ = *list;
+  if (*list != nullptr) {
+    (*list)->prev_ = span;
+  }
+  *list = span;
+}
+}  // namespace device
+}  // namespace mindspore
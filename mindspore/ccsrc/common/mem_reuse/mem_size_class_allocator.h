@@ -0,0 +1,155 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_SIZE_CLASS_ALLOCATOR_H_
+#define MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_SIZE_CLASS_ALLOCATOR_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+#include "common/mem_reuse/mem_dynamic_allocator.h"
+
+namespace mindspore {
+namespace device {
+// The memory blocks are carved into pages of 64K.
+constexpr size_t kSizeClassPageShift = 16;
+constexpr size_t kSizeClassPageSize = 1 << kSizeClassPageShift;
+// The powers of two from 512B to 32K are the small size classes, their memory is carved from one page slabs.
+constexpr size_t kSmallSizeClassMinShift = 9;
+constexpr size_t kSmallSizeClassMaxShift = 15;
+constexpr size_t kSmallSizeClassNum = kSmallSizeClassMaxShift - kSmallSizeClassMinShift + 1;
+// The runs from 1 to 16 pages are the page size classes, up to 1M.
+constexpr size_t kPageSizeClassMaxPages = 16;
+constexpr size_t kSizeClassNum = kSmallSizeClassNum + kPageSizeClassMaxPages;
+
+// The fragmentation statistics information of the size class memory pool.
+struct SizeClassMemStats {
+  // Memory allocated from device.
+  size_t total_mem_size_{0};
+  // Memory handed out by the central heap, to the tensors or to the thread caches.
+  size_t used_mem_size_{0};
+  size_t used_mem_peak_size_{0};
+  // Memory held by the thread caches.
+  size_t cached_mem_size_{0};
+  // Free memory in the slabs of the small size classes.
+  size_t slab_free_mem_size_{0};
+  // Free memory of the central heap, and its largest free span.
+  size_t free_mem_size_{0};
+  size_t largest_free_span_size_{0};
+  size_t free_span_num_{0};
+  // The accumulated size requested by the allocations, and the same rounded up to their size class.
+  size_t requested_mem_size_{0};
+  size_t rounded_mem_size_{0};
+
+  // The share of the free memory out of the largest free span, 0 when the free memory is in one piece.
+  double ExternalFragmentation() const;
+  // The share of the allocated memory lost to the rounding up to the size classes.
+  double InternalFragmentation() const;
+};
+
+// The dynamic memory pool with size class bins and per-thread caches. The tensors up to 1M are served from the cache
+// of the calling thread, which gets and returns its memory to the central heap in batches, so the actors allocating
+// and freeing on many threads rarely take the lock. The central heap keeps the free spans of pages in size segregated
+// lists and coalesces a freed span with its neighbours in constant time. The best-fit pool is used until
+// set_size_class_enabled(true) is called.
+class BACKEND_EXPORT DynamicMemPoolSizeClass : public DynamicMemPoolBestFit {
+ public:
+  DynamicMemPoolSizeClass();
+  ~DynamicMemPoolSizeClass() override;
+
+  DeviceMemPtr AllocTensorMem(size_t size, bool from_persistent_mem = false) override;
+  std::vector<DeviceMemPtr> AllocContinuousTensorMem(const std::vector<size_t> &size_list) override;
+  void FreeTensorMem(const DeviceMemPtr &device_addr) override;
+  void ReleaseDeviceRes() override;
+
+  size_t TotalMemStatistics() const override;
+  size_t TotalUsedMemStatistics() const override;
+  size_t UsedMemPeakStatistics() const override;
+  void DumpDynamicMemPoolStateInfo() override;
+
+  bool size_class_enabled() const { return size_class_enabled_; }
+  // Get the fragmentation statistics information.
+  SizeClassMemStats GetSizeClassMemStats();
+  // Return the memory cached by the calling thread to the central heap.
+  void FlushThreadCache();
+
+  // The size class of the aligned size, -1 for the sizes above the size classes.
+  static int SizeClassOf(size_t size);
+  static size_t SizeClassSize(int size_class);
+
+ protected:
+  // Only called before the first allocation.
+  void set_size_class_enabled(bool enabled) { size_class_enabled_ = enabled; }
+
+ private:
+  struct Arena;
+  struct Span;
+  struct ThreadCache;
+  struct ThreadSlot;
+
+  // Get the cache of the calling thread, nullptr when there are too many threads.
+  ThreadCache *GetThreadCache();
+  // Return the memory cached in the slot of an exiting thread to the central heap.
+  void ReturnThreadCache(size_t slot);
+  // Allocate the size class memory from the central heap to the thread cache or to the caller.
+  bool FetchObjects(int size_class, size_t num, std::vector<DeviceMemPtr> *objects);
+  // Return the size class memory to the central heap.
+  void ReturnObjects(int size_class, const DeviceMemPtr *objects, size_t num);
+  void ReturnCachedObjects(ThreadCache *cache, int size_class, size_t num);
+
+  // The central heap of pages, all called with the mutex locked.
+  Span *AllocSpan(size_t num_pages);
+  void FreeSpan(Span *span);
+  bool AddArena(size_t num_pages);
+  void InsertFreeSpan(Span *span);
+  void EraseFreeSpan(Span *span);
+  void SetSpanPages(Span *span, size_t begin, size_t end);
+  static void PushSpan(Span **list, Span *span);
+  void ClearCentralHeap();
+
+  // Find the span holding the address without the lock, the memory of the address must be allocated.
+  Span *FindSpan(const DeviceMemPtr &device_addr) const;
+
+  bool size_class_enabled_{false};
+  std::mutex heap_mutex_;
+
+  // The arenas are only appended, so that FindSpan reads them without the lock.
+  static constexpr size_t kMaxArenaNum = 256;
+  std::unique_ptr<std::atomic<Arena *>[]> arenas_;
+  std::atomic<size_t> arena_num_{0};
+
+  // The free spans, by their number of pages up to kMaxListPages, the longer ones by size.
+  static constexpr size_t kMaxListPages = 128;
+  Span *free_lists_[kMaxListPages + 1]{nullptr};
+  std::set<std::pair<size_t, Span *>> large_free_spans_;
+  // The slabs with free objects of each small size class.
+  Span *slab_lists_[kSmallSizeClassNum]{nullptr};
+
+  static constexpr size_t kMaxThreadCacheNum = 1024;
+  std::unique_ptr<std::atomic<ThreadCache *>[]> thread_caches_;
+
+  DeviceState state_;
+  // The requested and rounded sizes of the allocations not going through the thread caches.
+  size_t requested_mem_size_{0};
+  size_t rounded_mem_size_{0};
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_MEM_REUSE_MEM_SIZE_CLASS_ALLOCATOR_H_
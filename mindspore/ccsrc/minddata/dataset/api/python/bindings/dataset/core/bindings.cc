@@ -69,6 +69,11 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_enable_autotune", &ConfigManager::enable_autotune)
                     .def("set_autotune_interval", &ConfigManager::set_autotune_interval)
                     .def("get_autotune_interval", &ConfigManager::autotune_interval)
+                    .def("set_autotune_budget", &ConfigManager::set_autotune_budget)
+                    .def("get_autotune_cpu_budget", &ConfigManager::autotune_cpu_budget)
+                    .def("get_autotune_memory_budget", &ConfigManager::autotune_memory_budget)
+                    .def("set_autotune_start_config", &ConfigManager::set_autotune_start_config)
+                    .def("get_autotune_start_config", &ConfigManager::autotune_start_config)
                     .def("set_enable_watchdog", &ConfigManager::set_enable_watchdog)
                     .def("get_enable_watchdog", &ConfigManager::enable_watchdog)
                     .def("set_multiprocessing_timeout_interval", &ConfigManager::set_multiprocessing_timeout_interval)
@@ -77,6 +82,18 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_dynamic_shape", &ConfigManager::dynamic_shape)
                     .def("set_fast_recovery", &ConfigManager::set_fast_recovery)
                     .def("get_fast_recovery", &ConfigManager::fast_recovery)
+                    .def("set_state_history_size", &ConfigManager::set_state_history_size)
+                    .def("get_state_history_size", &ConfigManager::state_history_size)
+                    .def("set_lock_free_connector", &ConfigManager::set_lock_free_connector)
+                    .def("get_lock_free_connector", &ConfigManager::lock_free_connector)
+                    .def("set_mindrecord_mmap", &ConfigManager::set_mindrecord_mmap)
+                    .def("get_mindrecord_mmap", &ConfigManager::mindrecord_mmap)
+                    .def("set_async_read_depth", &ConfigManager::set_async_read_depth)
+                    .def("get_async_read_depth", &ConfigManager::async_read_depth)
+                    .def("set_tensor_pool_size", &ConfigManager::set_tensor_pool_size)
+                    .def("get_tensor_pool_size", &ConfigManager::tensor_pool_size)
+                    .def("set_shuffle_spill_dir", &ConfigManager::set_shuffle_spill_dir)
+                    .def("get_shuffle_spill_dir", &ConfigManager::shuffle_spill_dir)
                     .def("load", [](ConfigManager &c, const std::string &s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
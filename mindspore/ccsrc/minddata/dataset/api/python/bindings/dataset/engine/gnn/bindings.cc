@@ -31,10 +31,12 @@ PYBIND_REGISTER(
   Graph, 0, ([](const py::module *m) {
     (void)py::class_<gnn::GraphData, std::shared_ptr<gnn::GraphData>>(*m, "GraphDataClient")
       .def(py::init([](const std::string &data_format, const std::string &dataset_file, int32_t num_workers,
-                       const std::string &working_mode, const std::string &hostname, int32_t port) {
+                       const std::string &working_mode, const std::string &hostname, int32_t port,
+                       const std::string &storage_format, const std::string &snapshot_file) {
         std::shared_ptr<gnn::GraphData> out;
         if (working_mode == "local") {
-          out = std::make_shared<gnn::GraphDataImpl>(data_format, dataset_file, num_workers);
+          out = std::make_shared<gnn::GraphDataImpl>(data_format, dataset_file, num_workers, false, storage_format,
+                                                     snapshot_file);
         } else if (working_mode == "client") {
           out = std::make_shared<gnn::GraphDataClient>(dataset_file, hostname, port);
         }
@@ -103,6 +105,15 @@ PYBIND_REGISTER(
              THROW_IF_ERROR(g.GetSampledNeighbors(node_list, neighbor_nums, neighbor_types, strategy, &out));
              return out;
            })
+      .def("get_sampled_subgraph",
+           [](gnn::GraphData &g, const std::vector<gnn::NodeIdType> &node_list,
+              const std::vector<gnn::NodeIdType> &neighbor_nums, const std::vector<gnn::NodeType> &neighbor_types,
+              SamplingStrategy strategy, std::vector<gnn::FeatureType> feature_types) {
+             TensorRow out;
+             THROW_IF_ERROR(
+               g.GetSampledSubgraph(node_list, neighbor_nums, neighbor_types, strategy, feature_types, &out));
+             return out.getRow();
+           })
       .def("get_neg_sampled_neighbors",
            [](gnn::GraphData &g, const std::vector<gnn::NodeIdType> &node_list, gnn::NodeIdType neighbor_num,
               gnn::NodeType neg_neighbor_type) {
@@ -112,6 +112,11 @@ PYBIND_REGISTER(CharNGram, 1, ([](const py::module *m) {
                       std::shared_ptr<CharNGram> char_n_gram;
                       THROW_IF_ERROR(CharNGram::BuildFromFile(&char_n_gram, path, max_vectors));
                       return char_n_gram;
+                    })
+                    .def_static("from_binary", [](const std::string &path) {
+                      std::shared_ptr<CharNGram> char_n_gram;
+                      THROW_IF_ERROR(CharNGram::BuildFromBinary(&char_n_gram, path));
+                      return char_n_gram;
                     });
                 }));
 
@@ -122,6 +127,11 @@ PYBIND_REGISTER(FastText, 1, ([](const py::module *m) {
                       std::shared_ptr<FastText> fast_text;
                       THROW_IF_ERROR(FastText::BuildFromFile(&fast_text, path, max_vectors));
                       return fast_text;
+                    })
+                    .def_static("from_binary", [](const std::string &path) {
+                      std::shared_ptr<FastText> fast_text;
+                      THROW_IF_ERROR(FastText::BuildFromBinary(&fast_text, path));
+                      return fast_text;
                     });
                 }));
 
@@ -132,6 +142,11 @@ PYBIND_REGISTER(GloVe, 1, ([](const py::module *m) {
                       std::shared_ptr<GloVe> glove;
                       THROW_IF_ERROR(GloVe::BuildFromFile(&glove, path, max_vectors));
                       return glove;
+                    })
+                    .def_static("from_binary", [](const std::string &path) {
+                      std::shared_ptr<GloVe> glove;
+                      THROW_IF_ERROR(GloVe::BuildFromBinary(&glove, path));
+                      return glove;
                     });
                 }));
 
@@ -142,7 +157,16 @@ PYBIND_REGISTER(Vectors, 0, ([](const py::module *m) {
                       std::shared_ptr<Vectors> vectors;
                       THROW_IF_ERROR(Vectors::BuildFromFile(&vectors, path, max_vectors));
                       return vectors;
-                    });
+                    })
+                    .def_static("from_binary", [](const std::string &path) {
+                      std::shared_ptr<Vectors> vectors;
+                      THROW_IF_ERROR(Vectors::BuildFromBinary(&vectors, path));
+                      return vectors;
+                    })
+                    .def_static("convert_to_binary",
+                                [](const std::string &path, const std::string &binary_path, int32_t max_vectors) {
+                                  THROW_IF_ERROR(Vectors::ConvertToBinary(path, binary_path, max_vectors));
+                                });
                 }));
 }  // namespace dataset
 }  // namespace mindspore
@@ -94,6 +94,7 @@ PYBIND_REGISTER(ShuffleMode, 1, ([](const py::module *m) {
                     .value("FILES", ShuffleMode::kFiles)
                     .value("GLOBAL", ShuffleMode::kGlobal)
                     .value("INFILE", ShuffleMode::kInfile)
+                    .value("PARTIAL", ShuffleMode::kPartial)
                     .export_values();
                 }));
 }  // namespace dataset
@@ -17,8 +17,10 @@
 #include "minddata/dataset/audio/kernels/audio_utils.h"
 
 #include <fstream>
+#include <type_traits>
 
 #include "mindspore/core/base/float16.h"
+#include "minddata/dataset/audio/kernels/stft_engine.h"
 #include "minddata/dataset/core/type_id.h"
 #include "minddata/dataset/util/random.h"
 #include "utils/file_utils.h"
@@ -1409,6 +1411,15 @@ template <typename T>
 Status SpectrogramImpl(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int pad,
                        WindowType window, int n_fft, int hop_length, int win_length, float power, bool normalized,
                        bool center, BorderType pad_mode, bool onesided) {
+  // The power spectrograms of float32 waveforms take the real FFT, the naive DFT below is left for the others
+  if constexpr (std::is_same<T, float>::value) {
+    if (StftEngine::Supports(power, onesided)) {
+      std::shared_ptr<StftEngine> engine;
+      RETURN_IF_NOT_OK(StftEngine::Create(n_fft, win_length, hop_length, pad, window, power, normalized, center,
+                                          pad_mode, nullptr, &engine));
+      return engine->Compute(input, output);
+    }
+  }
   std::shared_ptr<Tensor> fft_window_tensor;
   std::shared_ptr<Tensor> fft_window_later;
   TensorShape shape = input->shape();
@@ -598,6 +598,13 @@ Status MelScale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *o
   return Status::OK();
 }
 
+/// \brief Create a window function.
+/// \param[out] output Float32 tensor of the window, of shape <len>.
+/// \param[in] window_type Type of the window.
+/// \param[in] len Length of the window.
+/// \return Status code.
+Status Window(std::shared_ptr<Tensor> *output, WindowType window_type, int len);
+
 /// \brief Transform audio signal into spectrogram.
 /// \param[in] n_fft Size of FFT, creates n_fft / 2 + 1 bins.
 /// \param[in] win_length Window size.
@@ -45,6 +45,12 @@ Status MelScaleOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr
   }
 }
 
+Status MelScaleOp::Filterbank(int32_t n_freqs, std::shared_ptr<Tensor> *fbanks) const {
+  RETURN_UNEXPECTED_IF_NULL(fbanks);
+  RETURN_IF_NOT_OK(ValidateEqual("MelScale", "n_stft", n_stft_, "freq", n_freqs));
+  return CreateFbanks<float>(fbanks, n_stft_, f_min_, f_max_, n_mels_, sample_rate_, norm_, mel_type_);
+}
+
 Status MelScaleOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
   outputs.clear();
@@ -49,6 +49,12 @@ class MelScaleOp : public TensorOp {
 
   Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
 
+  /// \brief Create the float32 mel filterbank applied to a spectrogram.
+  /// \param[in] n_freqs Number of frequency bins of the spectrogram, which must be n_stft
+  /// \param[out] fbanks The filterbank of shape <n_stft, n_mels>
+  /// \return Status code
+  Status Filterbank(int32_t n_freqs, std::shared_ptr<Tensor> *fbanks) const;
+
  private:
   int32_t n_mels_;
   int32_t sample_rate_;
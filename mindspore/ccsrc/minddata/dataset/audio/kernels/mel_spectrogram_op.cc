@@ -0,0 +1,83 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/audio/kernels/mel_spectrogram_op.h"
+
+#include <utility>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+MelSpectrogramOp::MelSpectrogramOp(std::shared_ptr<SpectrogramOp> spectrogram, std::shared_ptr<MelScaleOp> mel_scale,
+                                   std::shared_ptr<TensorOp> amplitude_to_db)
+    : spectrogram_(std::move(spectrogram)),
+      mel_scale_(std::move(mel_scale)),
+      amplitude_to_db_(std::move(amplitude_to_db)) {}
+
+Status MelSpectrogramOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  std::shared_ptr<Tensor> mel_spectrogram;
+  if (!spectrogram_->UsesEngine() || input->type() == DataType::DE_FLOAT64) {
+    // float64 waveforms keep their precision through the ops one after the other
+    std::shared_ptr<Tensor> spectrogram;
+    RETURN_IF_NOT_OK(spectrogram_->Compute(input, &spectrogram));
+    RETURN_IF_NOT_OK(mel_scale_->Compute(spectrogram, &mel_spectrogram));
+  } else {
+    std::shared_ptr<StftEngine> engine;
+    {
+      std::unique_lock<std::mutex> lock(engine_mutex_);
+      if (engine_ == nullptr) {
+        std::shared_ptr<Tensor> fbanks;
+        RETURN_IF_NOT_OK(mel_scale_->Filterbank(spectrogram_->NumBins(), &fbanks));
+        RETURN_IF_NOT_OK(spectrogram_->CreateEngine(fbanks, &engine_));
+      }
+      engine = engine_;
+    }
+    RETURN_IF_NOT_OK(engine->Compute(input, &mel_spectrogram));
+  }
+  if (amplitude_to_db_ == nullptr) {
+    *output = std::move(mel_spectrogram);
+    return Status::OK();
+  }
+  return amplitude_to_db_->Compute(mel_spectrogram, output);
+}
+
+Status MelSpectrogramOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  std::vector<TensorShape> spectrogram_shapes;
+  RETURN_IF_NOT_OK(spectrogram_->OutputShape(inputs, spectrogram_shapes));
+  if (amplitude_to_db_ == nullptr) {
+    return mel_scale_->OutputShape(spectrogram_shapes, outputs);
+  }
+  std::vector<TensorShape> mel_shapes;
+  RETURN_IF_NOT_OK(mel_scale_->OutputShape(spectrogram_shapes, mel_shapes));
+  return amplitude_to_db_->OutputShape(mel_shapes, outputs);
+}
+
+Status MelSpectrogramOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = inputs[0] == DataType(DataType::DE_FLOAT64) ? inputs[0] : DataType(DataType::DE_FLOAT32);
+  return Status::OK();
+}
+
+void MelSpectrogramOp::Print(std::ostream &out) const {
+  out << Name() << ": " << spectrogram_->Name() << ", " << mel_scale_->Name();
+  if (amplitude_to_db_ != nullptr) {
+    out << ", " << amplitude_to_db_->Name();
+  }
+  out << std::endl;
+}
+}  // namespace dataset
+}  // namespace mindspore
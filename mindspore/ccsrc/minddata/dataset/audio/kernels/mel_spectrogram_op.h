@@ -0,0 +1,65 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_AUDIO_KERNELS_MEL_SPECTROGRAM_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_AUDIO_KERNELS_MEL_SPECTROGRAM_OP_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/audio/kernels/mel_scale_op.h"
+#include "minddata/dataset/audio/kernels/spectrogram_op.h"
+#include "minddata/dataset/audio/kernels/stft_engine.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+
+namespace mindspore {
+namespace dataset {
+// Spectrogram followed by MelScale, and optionally by AmplitudeToDB, in one op. The mel spectrogram of a waveform is
+// computed frame by frame by a StftEngine holding the mel filterbank, the linear spectrogram is never materialized.
+// Created by TensorOpFusionPass.
+class MelSpectrogramOp : public TensorOp {
+ public:
+  /// \param[in] spectrogram The Spectrogram op
+  /// \param[in] mel_scale The MelScale op after it
+  /// \param[in] amplitude_to_db The AmplitudeToDB op after them, nullptr for none
+  MelSpectrogramOp(std::shared_ptr<SpectrogramOp> spectrogram, std::shared_ptr<MelScaleOp> mel_scale,
+                   std::shared_ptr<TensorOp> amplitude_to_db = nullptr);
+
+  ~MelSpectrogramOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kMelSpectrogramOp; }
+
+ private:
+  std::shared_ptr<SpectrogramOp> spectrogram_;
+  std::shared_ptr<MelScaleOp> mel_scale_;
+  std::shared_ptr<TensorOp> amplitude_to_db_;
+  std::mutex engine_mutex_;
+  std::shared_ptr<StftEngine> engine_;  // Created by the first Compute, then shared by all the workers
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_AUDIO_KERNELS_MEL_SPECTROGRAM_OP_H_
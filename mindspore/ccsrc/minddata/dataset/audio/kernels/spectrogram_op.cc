@@ -22,8 +22,24 @@ namespace mindspore {
 namespace dataset {
 Status SpectrogramOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   IO_CHECK(input, output);
-  return Spectrogram(input, output, pad_, window_, n_fft_, hop_length_, win_length_, power_, normalized_, center_,
-                     pad_mode_, onesided_);
+  if (!UsesEngine() || input->type() == DataType::DE_FLOAT64) {
+    return Spectrogram(input, output, pad_, window_, n_fft_, hop_length_, win_length_, power_, normalized_, center_,
+                       pad_mode_, onesided_);
+  }
+  std::shared_ptr<StftEngine> engine;
+  {
+    std::unique_lock<std::mutex> lock(engine_mutex_);
+    if (engine_ == nullptr) {
+      RETURN_IF_NOT_OK(CreateEngine(nullptr, &engine_));
+    }
+    engine = engine_;
+  }
+  return engine->Compute(input, output);
+}
+
+Status SpectrogramOp::CreateEngine(const std::shared_ptr<Tensor> &fbanks, std::shared_ptr<StftEngine> *engine) const {
+  return StftEngine::Create(n_fft_, win_length_, hop_length_, pad_, window_, power_, normalized_, center_, pad_mode_,
+                            fbanks, engine);
 }
 
 Status SpectrogramOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
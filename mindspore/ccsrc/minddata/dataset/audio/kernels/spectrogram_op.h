@@ -18,9 +18,11 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_AUDIO_KERNELS_SPECTROGRAM_OP_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "minddata/dataset/audio/kernels/stft_engine.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 
@@ -49,6 +51,18 @@ class SpectrogramOp : public TensorOp {
 
   Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
 
+  /// \brief Whether the spectrogram of a float32 waveform is computed by a StftEngine.
+  bool UsesEngine() const { return StftEngine::Supports(power_, onesided_); }
+
+  /// \brief Prepare a StftEngine computing this spectrogram.
+  /// \param[in] fbanks Mel filterbank of shape <n_fft / 2 + 1, n_mels> applied to the spectrogram, nullptr for none
+  /// \param[out] engine The engine
+  /// \return Status code
+  Status CreateEngine(const std::shared_ptr<Tensor> &fbanks, std::shared_ptr<StftEngine> *engine) const;
+
+  /// \return Number of frequency bins of the one sided spectrogram
+  int32_t NumBins() const { return n_fft_ / 2 + 1; }
+
  private:
   int32_t n_fft_;
   int32_t win_length_;
@@ -60,6 +74,8 @@ class SpectrogramOp : public TensorOp {
   bool center_;
   BorderType pad_mode_;
   bool onesided_;
+  std::mutex engine_mutex_;
+  std::shared_ptr<StftEngine> engine_;  // Created by the first Compute, then shared by all the workers
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,433 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/audio/kernels/stft_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "minddata/dataset/audio/kernels/audio_utils.h"
+#include "minddata/dataset/kernels/data/data_utils.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MD_STFT_X86_SIMD
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define MD_STFT_NEON
+#endif
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// One stage of radix 2 butterflies over the n complex values, combining the sub-FFTs of size h into those of size 2h.
+// w_re and w_im hold the h twiddles of the stage.
+void ButterflyStage(float *re, float *im, const float *w_re, const float *w_im, int32_t n, int32_t h) {
+  for (int32_t s = 0; s < n; s += 2 * h) {
+    float *a_re = re + s;
+    float *a_im = im + s;
+    float *b_re = a_re + h;
+    float *b_im = a_im + h;
+    for (int32_t j = 0; j < h; ++j) {
+      float t_re = b_re[j] * w_re[j] - b_im[j] * w_im[j];
+      float t_im = b_re[j] * w_im[j] + b_im[j] * w_re[j];
+      b_re[j] = a_re[j] - t_re;
+      b_im[j] = a_im[j] - t_im;
+      a_re[j] += t_re;
+      a_im[j] += t_im;
+    }
+  }
+}
+
+// The SIMD stages below run the butterflies of ButterflyStage on a vector of lanes at a time, h must be a multiple of
+// the number of lanes.
+#ifdef MD_STFT_X86_SIMD
+constexpr int32_t kSimdLanes = 8;
+
+__attribute__((target("avx"))) void ButterflyStageAvx(float *re, float *im, const float *w_re, const float *w_im,
+                                                      int32_t n, int32_t h) {
+  for (int32_t s = 0; s < n; s += 2 * h) {
+    float *a_re = re + s;
+    float *a_im = im + s;
+    float *b_re = a_re + h;
+    float *b_im = a_im + h;
+    for (int32_t j = 0; j < h; j += kSimdLanes) {
+      __m256 wr = _mm256_loadu_ps(w_re + j);
+      __m256 wi = _mm256_loadu_ps(w_im + j);
+      __m256 br = _mm256_loadu_ps(b_re + j);
+      __m256 bi = _mm256_loadu_ps(b_im + j);
+      __m256 ar = _mm256_loadu_ps(a_re + j);
+      __m256 ai = _mm256_loadu_ps(a_im + j);
+      __m256 tr = _mm256_sub_ps(_mm256_mul_ps(br, wr), _mm256_mul_ps(bi, wi));
+      __m256 ti = _mm256_add_ps(_mm256_mul_ps(br, wi), _mm256_mul_ps(bi, wr));
+      _mm256_storeu_ps(b_re + j, _mm256_sub_ps(ar, tr));
+      _mm256_storeu_ps(b_im + j, _mm256_sub_ps(ai, ti));
+      _mm256_storeu_ps(a_re + j, _mm256_add_ps(ar, tr));
+      _mm256_storeu_ps(a_im + j, _mm256_add_ps(ai, ti));
+    }
+  }
+}
+
+// The dataset sources are not built with -mavx, the AVX stage is only taken when the CPU has it
+bool HasSimd() {
+  static const bool has_avx = __builtin_cpu_supports("avx");
+  return has_avx;
+}
+#endif
+
+#ifdef MD_STFT_NEON
+constexpr int32_t kSimdLanes = 4;
+
+void ButterflyStageNeon(float *re, float *im, const float *w_re, const float *w_im, int32_t n, int32_t h) {
+  for (int32_t s = 0; s < n; s += 2 * h) {
+    float *a_re = re + s;
+    float *a_im = im + s;
+    float *b_re = a_re + h;
+    float *b_im = a_im + h;
+    for (int32_t j = 0; j < h; j += kSimdLanes) {
+      float32x4_t wr = vld1q_f32(w_re + j);
+      float32x4_t wi = vld1q_f32(w_im + j);
+      float32x4_t br = vld1q_f32(b_re + j);
+      float32x4_t bi = vld1q_f32(b_im + j);
+      float32x4_t ar = vld1q_f32(a_re + j);
+      float32x4_t ai = vld1q_f32(a_im + j);
+      float32x4_t tr = vsubq_f32(vmulq_f32(br, wr), vmulq_f32(bi, wi));
+      float32x4_t ti = vaddq_f32(vmulq_f32(br, wi), vmulq_f32(bi, wr));
+      vst1q_f32(b_re + j, vsubq_f32(ar, tr));
+      vst1q_f32(b_im + j, vsubq_f32(ai, ti));
+      vst1q_f32(a_re + j, vaddq_f32(ar, tr));
+      vst1q_f32(a_im + j, vaddq_f32(ai, ti));
+    }
+  }
+}
+
+bool HasSimd() { return true; }
+#endif
+
+// The index of the sample of a signal of `length` samples found at `index`, which is outside of the signal, once the
+// signal is padded with `mode`. -1 if the padding is a zero.
+int64_t FoldIndex(int64_t index, int64_t length, BorderType mode) {
+  if (length <= 0 || mode == BorderType::kConstant) {
+    return -1;
+  }
+  if (mode == BorderType::kEdge) {
+    return index < 0 ? 0 : length - 1;
+  }
+  if (mode == BorderType::kReflect) {
+    if (length == 1) {
+      return 0;
+    }
+    int64_t period = TWO * (length - 1);
+    int64_t folded = ((index % period) + period) % period;
+    return folded < length ? folded : period - folded;
+  }
+  int64_t period = TWO * length;
+  int64_t folded = ((index % period) + period) % period;
+  return folded < length ? folded : period - 1 - folded;
+}
+}  // namespace
+
+RealFft::RealFft(int32_t n) : n_(n), radix2_(n >= 4 && (n & (n - 1)) == 0) {
+  if (!radix2_) {
+    return;
+  }
+  const int32_t half = n / TWO;
+  int32_t bits = 0;
+  while ((1 << bits) < half) {
+    bits++;
+  }
+  bit_rev_.resize(half);
+  for (int32_t k = 0; k < half; ++k) {
+    int32_t reversed = 0;
+    for (int32_t b = 0; b < bits; ++b) {
+      reversed |= ((k >> b) & 1) << (bits - 1 - b);
+    }
+    bit_rev_[k] = reversed;
+  }
+  // The twiddles are computed in double, the butterflies only round the products
+  twiddle_re_.resize(half);
+  twiddle_im_.resize(half);
+  for (int32_t h = 1; h < half; h *= TWO) {
+    for (int32_t j = 0; j < h; ++j) {
+      double angle = -PI * j / h;
+      twiddle_re_[h + j] = static_cast<float>(std::cos(angle));
+      twiddle_im_[h + j] = static_cast<float>(std::sin(angle));
+    }
+  }
+  post_re_.resize(half + 1);
+  post_im_.resize(half + 1);
+  for (int32_t k = 0; k <= half; ++k) {
+    double angle = -TWO * PI * k / n;
+    post_re_[k] = static_cast<float>(std::cos(angle));
+    post_im_[k] = static_cast<float>(std::sin(angle));
+  }
+}
+
+void RealFft::InitWorkspace(Workspace *workspace) const {
+  if (radix2_) {
+    workspace->re.resize(n_ / TWO);
+    workspace->im.resize(n_ / TWO);
+  } else {
+    workspace->re.resize(n_);
+    // The sizes not multiple of 4 get the full spectrum back
+    workspace->spectrum.resize(n_);
+    workspace->fallback.SetFlag(Eigen::FFT<float>::HalfSpectrum);
+  }
+}
+
+void RealFft::Butterflies(float *re, float *im) const {
+  const int32_t half = n_ / TWO;
+  for (int32_t h = 1; h < half; h *= TWO) {
+    const float *w_re = twiddle_re_.data() + h;
+    const float *w_im = twiddle_im_.data() + h;
+#if defined(MD_STFT_X86_SIMD)
+    if (h >= kSimdLanes && HasSimd()) {
+      ButterflyStageAvx(re, im, w_re, w_im, half, h);
+      continue;
+    }
+#elif defined(MD_STFT_NEON)
+    if (h >= kSimdLanes && HasSimd()) {
+      ButterflyStageNeon(re, im, w_re, w_im, half, h);
+      continue;
+    }
+#endif
+    ButterflyStage(re, im, w_re, w_im, half, h);
+  }
+}
+
+void RealFft::PowerSpectrum(const float *frame, const float *window, Workspace *workspace, float *power) const {
+  if (n_ <= TWO) {
+    // Eigen::FFT does not take these
+    float first = frame[0] * window[0];
+    float second = n_ == TWO ? frame[1] * window[1] : 0;
+    power[0] = (first + second) * (first + second);
+    if (n_ == TWO) {
+      power[1] = (first - second) * (first - second);
+    }
+    return;
+  }
+  if (!radix2_) {
+    float *windowed = workspace->re.data();
+    for (int32_t k = 0; k < n_; ++k) {
+      windowed[k] = frame[k] * window[k];
+    }
+    workspace->fallback.fwd(workspace->spectrum.data(), windowed, n_);
+    for (int32_t k = 0; k <= n_ / TWO; ++k) {
+      power[k] = std::norm(workspace->spectrum[k]);
+    }
+    return;
+  }
+  // z[k] = x[2k] + i * x[2k + 1], loaded in bit reversed order for the butterflies
+  const int32_t half = n_ / TWO;
+  float *re = workspace->re.data();
+  float *im = workspace->im.data();
+  for (int32_t k = 0; k < half; ++k) {
+    int32_t r = bit_rev_[k];
+    re[r] = frame[TWO * k] * window[TWO * k];
+    im[r] = frame[TWO * k + 1] * window[TWO * k + 1];
+  }
+  Butterflies(re, im);
+  // X[k] = E[k] + exp(-2i * pi * k / n) * O[k], with E and O the spectra of the even and the odd samples:
+  // E[k] = (Z[k] + conj(Z[half - k])) / 2 and O[k] = -i * (Z[k] - conj(Z[half - k])) / 2
+  power[0] = (re[0] + im[0]) * (re[0] + im[0]);
+  power[half] = (re[0] - im[0]) * (re[0] - im[0]);
+  const float kHalf = 0.5;
+  for (int32_t k = 1; k < half; ++k) {
+    int32_t m = half - k;
+    float e_re = kHalf * (re[k] + re[m]);
+    float e_im = kHalf * (im[k] - im[m]);
+    float o_re = kHalf * (im[k] + im[m]);
+    float o_im = kHalf * (re[m] - re[k]);
+    float x_re = e_re + post_re_[k] * o_re - post_im_[k] * o_im;
+    float x_im = e_im + post_re_[k] * o_im + post_im_[k] * o_re;
+    power[k] = x_re * x_re + x_im * x_im;
+  }
+}
+
+StftEngine::StftEngine(int32_t n_fft, int32_t hop_length, int32_t pad, float power, bool center, BorderType pad_mode)
+    : n_fft_(n_fft),
+      hop_length_(hop_length),
+      pad_(pad),
+      power_(power),
+      center_(center),
+      pad_mode_(pad_mode),
+      scale_(1.0) {}
+
+Status StftEngine::Create(int32_t n_fft, int32_t win_length, int32_t hop_length, int32_t pad, WindowType window,
+                          float power, bool normalized, bool center, BorderType pad_mode,
+                          const std::shared_ptr<Tensor> &fbanks, std::shared_ptr<StftEngine> *engine) {
+  RETURN_UNEXPECTED_IF_NULL(engine);
+  CHECK_FAIL_RETURN_UNEXPECTED(hop_length > 0, "Spectrogram: hop_length must be positive, but got: " +
+                                                 std::to_string(hop_length) + ".");
+  CHECK_FAIL_RETURN_UNEXPECTED(win_length > 0 && win_length <= n_fft,
+                               "Spectrogram: win_length must be in range (0, n_fft], but got win_length: " +
+                                 std::to_string(win_length) + ", n_fft: " + std::to_string(n_fft) + ".");
+  CHECK_FAIL_RETURN_UNEXPECTED(pad >= 0, "Spectrogram: pad must be non negative, but got: " + std::to_string(pad));
+  auto stft = std::shared_ptr<StftEngine>(new StftEngine(n_fft, hop_length, pad, power, center, pad_mode));
+
+  // The window of win_length is centered in n_fft, like the padded window of Spectrogram
+  stft->window_.assign(n_fft, 0);
+  int32_t pad_left = (n_fft - win_length) / TWO;
+  if (win_length == 1) {
+    stft->window_[pad_left] = 1;
+  } else {
+    std::shared_ptr<Tensor> window_tensor;
+    RETURN_IF_NOT_OK(Window(&window_tensor, window, win_length));
+    auto value = window_tensor->begin<float>();
+    for (int32_t k = 0; k < win_length; ++k, ++value) {
+      stft->window_[pad_left + k] = *value;
+    }
+  }
+  double win_sum = 0.;
+  for (float value : stft->window_) {
+    win_sum += static_cast<double>(value) * value;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(win_sum != 0, "Window: the total value of window function can not be zero.");
+  // Dividing the spectrum by the norm of the window divides the squared magnitudes by its square
+  if (normalized) {
+    stft->scale_ = static_cast<float>(1.0 / win_sum);
+  }
+  stft->fft_ = std::make_unique<RealFft>(n_fft);
+
+  if (fbanks != nullptr) {
+    const int32_t n_freqs = n_fft / TWO + 1;
+    CHECK_FAIL_RETURN_UNEXPECTED(fbanks->type() == DataType::DE_FLOAT32 && fbanks->Rank() == TWO &&
+                                   fbanks->shape()[0] == n_freqs,
+                                 "[Internal ERROR] Spectrogram: the mel filterbank must be float32 of shape <" +
+                                   std::to_string(n_freqs) + ", n_mels>, but got " + fbanks->shape().ToString());
+    const auto n_mels = static_cast<int32_t>(fbanks->shape()[1]);
+    const float *weights = &*fbanks->begin<float>();
+    stft->filters_.resize(n_mels);
+    for (int32_t m = 0; m < n_mels; ++m) {
+      int32_t first = 0;
+      while (first < n_freqs && weights[first * n_mels + m] == 0) {
+        first++;
+      }
+      int32_t last = n_freqs - 1;
+      while (last >= first && weights[last * n_mels + m] == 0) {
+        last--;
+      }
+      stft->filters_[m].start = first;
+      for (int32_t f = first; f <= last; ++f) {
+        stft->filters_[m].weights.push_back(weights[f * n_mels + m]);
+      }
+    }
+  }
+  *engine = std::move(stft);
+  return Status::OK();
+}
+
+void StftEngine::GatherFrame(const float *waveform, int64_t length, int64_t begin, float *frame) const {
+  const int64_t center_pad = center_ ? n_fft_ / TWO : 0;
+  // The waveform with the constant padding of pad_, which the padding of pad_mode_ goes around
+  const int64_t padded_length = length + TWO * pad_;
+  for (int32_t k = 0; k < n_fft_; ++k) {
+    int64_t index = begin + k - center_pad;
+    if (index < 0 || index >= padded_length) {
+      index = FoldIndex(index, padded_length, pad_mode_);
+      if (index < 0) {
+        frame[k] = 0;
+        continue;
+      }
+    }
+    index -= pad_;
+    frame[k] = index >= 0 && index < length ? waveform[index] : 0;
+  }
+}
+
+Status StftEngine::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) const {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  RETURN_UNEXPECTED_IF_NULL(output);
+  TensorShape input_shape = input->shape();
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    input->type().IsNumeric(),
+    "Spectrogram: input tensor type should be int, float or double, but got: " + input->type().ToString());
+  CHECK_FAIL_RETURN_UNEXPECTED(input_shape.Size() > 0, "Spectrogram: input tensor is not in shape of <..., time>.");
+  std::shared_ptr<Tensor> waveform = input;
+  if (input->type() != DataType::DE_FLOAT32) {
+    RETURN_IF_NOT_OK(TypeCast(input, &waveform, DataType(DataType::DE_FLOAT32)));
+  }
+
+  const int64_t length = input_shape[-1];
+  const int64_t padded_length = length + TWO * pad_ + (center_ ? TWO * (n_fft_ / TWO) : 0);
+  CHECK_FAIL_RETURN_UNEXPECTED(n_fft_ <= padded_length, "Spectrogram: n_fft should be more than 0 and less than " +
+                                                          std::to_string(padded_length) +
+                                                          ", but got n_fft: " + std::to_string(n_fft_) + ".");
+  const int64_t n_frames = 1 + (padded_length - n_fft_) / hop_length_;
+  const int64_t n_bins = n_fft_ / TWO + 1;
+  const int64_t n_rows = filters_.empty() ? n_bins : static_cast<int64_t>(filters_.size());
+  std::vector<dsize_t> output_shape = input_shape.AsVector();
+  output_shape.pop_back();
+  int64_t n_waveforms = 1;
+  for (auto dim : output_shape) {
+    n_waveforms *= dim;
+  }
+  output_shape.push_back(n_rows);
+  output_shape.push_back(n_frames);
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape(output_shape), DataType(DataType::DE_FLOAT32), output));
+  if (n_waveforms == 0) {
+    return Status::OK();
+  }
+
+  RealFft::Workspace workspace;
+  fft_->InitWorkspace(&workspace);
+  std::vector<float> frame(n_fft_);
+  std::vector<float> spectrum(n_bins);
+  const float half_power = power_ / TWO;
+  const int64_t center_pad = center_ ? n_fft_ / TWO : 0;
+  const auto *waveforms = reinterpret_cast<const float *>(waveform->GetBuffer());
+  float *out = &*(*output)->begin<float>();
+  for (int64_t w = 0; w < n_waveforms; ++w) {
+    const float *samples = waveforms + w * length;
+    float *spectrogram = out + w * n_rows * n_frames;
+    for (int64_t j = 0; j < n_frames; ++j) {
+      // Most of the frames lie within the waveform and are read in place, only those over the padding are copied
+      int64_t offset = j * hop_length_ - center_pad - pad_;
+      const float *frame_begin = samples + offset;
+      if (offset < 0 || offset + n_fft_ > length) {
+        GatherFrame(samples, length, j * hop_length_, frame.data());
+        frame_begin = frame.data();
+      }
+      fft_->PowerSpectrum(frame_begin, window_.data(), &workspace, spectrum.data());
+      for (int64_t k = 0; k < n_bins; ++k) {
+        float value = spectrum[k] * scale_;
+        if (power_ == 1) {
+          value = std::sqrt(value);
+        } else if (power_ != TWO) {
+          value = std::pow(value, half_power);
+        }
+        spectrum[k] = value;
+      }
+      if (filters_.empty()) {
+        for (int64_t k = 0; k < n_bins; ++k) {
+          spectrogram[k * n_frames + j] = spectrum[k];
+        }
+        continue;
+      }
+      for (int64_t m = 0; m < n_rows; ++m) {
+        const MelFilter &filter = filters_[m];
+        const float *bins = spectrum.data() + filter.start;
+        float sum = 0;
+        for (size_t f = 0; f < filter.weights.size(); ++f) {
+          sum += bins[f] * filter.weights[f];
+        }
+        spectrogram[m * n_frames + j] = sum;
+      }
+    }
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
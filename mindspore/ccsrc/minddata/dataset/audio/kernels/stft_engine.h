@@ -0,0 +1,135 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_AUDIO_KERNELS_STFT_ENGINE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_AUDIO_KERNELS_STFT_ENGINE_H_
+
+#include <unsupported/Eigen/FFT>
+
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/include/dataset/constants.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Forward FFT of real frames, giving the n / 2 + 1 bins of the one sided spectrum.
+///
+///     A power of two size runs a complex FFT of half the size on the even and odd samples, with the real and the
+///     imaginary parts in separate arrays so the butterflies of a stage are contiguous and run on SIMD registers. Other
+///     sizes fall back to Eigen::FFT.
+class RealFft {
+ public:
+  /// \brief The buffers of one transform. A workspace is used by one thread at a time, the tables of the plan are
+  ///     shared.
+  struct Workspace {
+    std::vector<float> re;
+    std::vector<float> im;
+    Eigen::FFT<float> fallback;
+    std::vector<std::complex<float>> spectrum;
+  };
+
+  /// \param[in] n Size of the transform, at least 1
+  explicit RealFft(int32_t n);
+
+  ~RealFft() = default;
+
+  /// \brief Prepare the buffers of a workspace for this size.
+  void InitWorkspace(Workspace *workspace) const;
+
+  /// \brief Compute the power spectrum of a frame.
+  /// \param[in] frame The n samples of the frame
+  /// \param[in] window The n values of the window, multiplied with the samples
+  /// \param[in] workspace Buffers from InitWorkspace
+  /// \param[out] power The n / 2 + 1 squared magnitudes of the bins
+  void PowerSpectrum(const float *frame, const float *window, Workspace *workspace, float *power) const;
+
+  /// \return The size of the transform
+  int32_t Size() const { return n_; }
+
+ private:
+  // Complex FFT of half the size in the split buffers, which hold the input in bit reversed order
+  void Butterflies(float *re, float *im) const;
+
+  int32_t n_;
+  bool radix2_;                     // Whether n is a power of two of at least 4
+  std::vector<int32_t> bit_rev_;    // Bit reversed index of each of the n / 2 complex inputs
+  std::vector<float> twiddle_re_;   // exp(-i * pi * j / h) at h + j, for the stages of half size h
+  std::vector<float> twiddle_im_;
+  std::vector<float> post_re_;      // exp(-2i * pi * k / n), to split the half size FFT into the real one
+  std::vector<float> post_im_;
+};
+
+/// \brief Computes power spectrograms with a real FFT, frame by frame, optionally on the mel scale.
+///
+///     The window, the FFT plan and the mel filterbank are prepared once and shared by all the calls. Each frame is
+///     padded, windowed and transformed in a small buffer and goes straight to its column of the output, so neither the
+///     padded signal, the frames nor the complex spectrogram are ever materialized. The result is the one of
+///     Spectrogram with onesided true and a power other than 0, followed by MelScale when there is a filterbank.
+class StftEngine {
+ public:
+  /// \brief Prepare an engine, the arguments are those of Spectrogram.
+  /// \param[in] fbanks Mel filterbank of shape <n_fft / 2 + 1, n_mels> from CreateFbanks, nullptr for a linear
+  ///     spectrogram
+  /// \param[out] engine The engine
+  /// \return Status error if the window can not be created
+  static Status Create(int32_t n_fft, int32_t win_length, int32_t hop_length, int32_t pad, WindowType window,
+                       float power, bool normalized, bool center, BorderType pad_mode,
+                       const std::shared_ptr<Tensor> &fbanks, std::shared_ptr<StftEngine> *engine);
+
+  /// \brief Whether the engine gives the output of Spectrogram with these arguments, the complex and the two sided
+  ///     spectrograms are left to Spectrogram.
+  static bool Supports(float power, bool onesided) { return onesided && power != 0; }
+
+  ~StftEngine() = default;
+
+  /// \brief Compute the spectrogram of a waveform.
+  /// \param[in] input Tensor of shape <..., time> of any numeric type, computed in float32
+  /// \param[out] output Float32 tensor of shape <..., n_fft / 2 + 1, n_frames>, or <..., n_mels, n_frames> with a
+  ///     filterbank
+  /// \return Status error if the input is invalid
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) const;
+
+ private:
+  // The non zero weights of a mel filter, which covers a few contiguous bins only
+  struct MelFilter {
+    int32_t start;  // First bin
+    std::vector<float> weights;
+  };
+
+  StftEngine(int32_t n_fft, int32_t hop_length, int32_t pad, float power, bool center, BorderType pad_mode);
+
+  // Copy the samples of the frame starting at `begin` of the padded signal, which does not lie fully within the
+  // waveform, to `frame`
+  void GatherFrame(const float *waveform, int64_t length, int64_t begin, float *frame) const;
+
+  int32_t n_fft_;
+  int32_t hop_length_;
+  int32_t pad_;
+  float power_;
+  bool center_;
+  BorderType pad_mode_;
+  float scale_;                     // Multiplies the squared magnitudes, 1 / sum(window^2) when normalized
+  std::vector<float> window_;       // Padded to n_fft
+  std::unique_ptr<RealFft> fft_;
+  std::vector<MelFilter> filters_;  // Empty for a linear spectrogram
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_AUDIO_KERNELS_STFT_ENGINE_H_
@@ -93,6 +93,14 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_cache_port(j.value("cachePort", cache_port_));
   set_num_connections(j.value("numConnections", num_connections_));
   set_cache_prefetch_size(j.value("cachePrefetchSize", cache_prefetch_size_));
+  set_lock_free_connector(j.value("lockFreeConnector", lock_free_connector_));
+  set_mindrecord_mmap(j.value("mindrecordMmap", mindrecord_mmap_));
+  set_async_read_depth(j.value("asyncReadDepth", async_read_depth_));
+  set_tensor_pool_size(j.value("tensorPoolSize", tensor_pool_size_));
+  set_shuffle_spill_dir(j.value("shuffleSpillDir", shuffle_spill_dir_));
+  set_state_history_size(j.value("stateHistorySize", state_history_size_));
+  set_autotune_budget(j.value("autotuneCpuBudget", autotune_cpu_budget_),
+                      j.value("autotuneMemoryBudget", autotune_memory_budget_));
   return Status::OK();
 }
 
@@ -259,6 +259,30 @@ class ConfigManager {
   // @param interval - autotune interval in steps
   void set_autotune_interval(int64_t interval) { autotune_interval_ = interval; }
 
+  // setter function
+  // @param cpu_budget - Percentage of the system CPU above which autotune takes workers away instead of adding them
+  // @param memory_budget - Percentage of the system memory above which autotune shrinks the queues
+  void set_autotune_budget(float cpu_budget, float memory_budget) {
+    autotune_cpu_budget_ = cpu_budget;
+    autotune_memory_budget_ = memory_budget;
+  }
+
+  // getter function
+  // @return - Percentage of the system CPU autotune lets the system use, 100 if there is no budget
+  float autotune_cpu_budget() const { return autotune_cpu_budget_; }
+
+  // getter function
+  // @return - Percentage of the system memory autotune lets the system use, 100 if there is no budget
+  float autotune_memory_budget() const { return autotune_memory_budget_; }
+
+  // setter function
+  // @param json_filepath - AutoTune configuration file saved by a previous run to start tuning from, empty for none
+  void set_autotune_start_config(const std::string &json_filepath) { autotune_start_config_ = json_filepath; }
+
+  // getter function
+  // @return - AutoTune configuration file to start tuning from, empty for none
+  std::string autotune_start_config() const { return autotune_start_config_; }
+
   // setter function
   // @param enable - To enable watchdog python thread
   void set_enable_watchdog(bool enable) { enable_watchdog_ = enable; }
@@ -293,6 +317,55 @@ class ConfigManager {
   // @return - Flag to indicate whether md pipeline recovers fast in failover reset
   bool fast_recovery() const { return fast_recovery_; }
 
+  // setter function
+  // @param lock_free_connector - Set whether the connectors between ParallelOp workers are lock free ring buffers
+  void set_lock_free_connector(const bool lock_free_connector) { lock_free_connector_ = lock_free_connector; }
+
+  // getter function
+  // @return - Flag to indicate whether the connectors between ParallelOp workers are lock free ring buffers
+  bool lock_free_connector() const { return lock_free_connector_; }
+
+  // setter function
+  // @param mindrecord_mmap - Set whether MindRecord files are memory mapped and their blobs passed on without copy
+  void set_mindrecord_mmap(const bool mindrecord_mmap) { mindrecord_mmap_ = mindrecord_mmap; }
+
+  // getter function
+  // @return - Flag to indicate whether MindRecord files are memory mapped
+  bool mindrecord_mmap() const { return mindrecord_mmap_; }
+
+  // setter function
+  // @param async_read_depth - Set the number of reads kept in flight per file by the non mappable source ops
+  void set_async_read_depth(int32_t async_read_depth) { async_read_depth_ = async_read_depth; }
+
+  // getter function
+  // @return - Number of reads kept in flight per file by the non mappable source ops, 0 if they read synchronously
+  int32_t async_read_depth() const { return async_read_depth_; }
+
+  // setter function
+  // @param tensor_pool_size - Set the size in MB of the free tensor buffers each pipeline keeps for reuse
+  void set_tensor_pool_size(int32_t tensor_pool_size) { tensor_pool_size_ = tensor_pool_size; }
+
+  // getter function
+  // @return - Size in MB of the free tensor buffers each pipeline keeps for reuse, 0 if tensors are not pooled
+  int32_t tensor_pool_size() const { return tensor_pool_size_; }
+
+  // setter function
+  // @param spill_dir - Directory the shuffle operations write their buffered rows to, empty to keep them in memory
+  void set_shuffle_spill_dir(const std::string &spill_dir) { shuffle_spill_dir_ = spill_dir; }
+
+  // getter function
+  // @return - Directory the shuffle operations write their buffered rows to, empty if they keep them in memory
+  std::string shuffle_spill_dir() const { return shuffle_spill_dir_; }
+
+  // setter function
+  // @param state_history_size - Set the number of steps whose pipeline state is kept to restore a reset pipeline
+  void set_state_history_size(int32_t state_history_size) { state_history_size_ = state_history_size; }
+
+  // getter function
+  // @return - Number of steps whose pipeline state is kept to restore a reset pipeline, 0 if it is not kept.
+  //     The states are only kept in memory, for a reset within the same process.
+  int32_t state_history_size() const { return state_history_size_; }
+
  private:
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
@@ -326,8 +399,17 @@ class ConfigManager {
   bool enable_watchdog_;                       // Watchdog python thread enabled flag
   uint32_t multiprocessing_timeout_interval_;  // Multiprocessing timeout interval in seconds
   std::string autotune_json_filepath_;         // Filepath name of the final AutoTune Configuration JSON file
+  float autotune_cpu_budget_{100.0};           // Percentage of the system CPU autotune lets the system use
+  float autotune_memory_budget_{100.0};        // Percentage of the system memory autotune lets the system use
+  std::string autotune_start_config_;          // AutoTune configuration file of a previous run to start from
   bool dynamic_shape_{false};
   bool fast_recovery_{true};  // Used for failover scenario to recover quickly or produce same augmentations
+  bool lock_free_connector_{false};  // Use lock free ring buffers for the worker connectors
+  bool mindrecord_mmap_{false};      // Memory map MindRecord files and borrow tensors from the mapping
+  int32_t async_read_depth_{0};      // Reads in flight per file of the non mappable source ops
+  int32_t tensor_pool_size_{0};      // Size in MB of the tensor buffer pool of each pipeline
+  std::string shuffle_spill_dir_;    // Directory of the shuffle buffer files, empty to shuffle in memory
+  int32_t state_history_size_{0};    // Number of steps whose pipeline state is kept for reset
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -34,6 +34,7 @@
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/core/type_id.h"
 #include "minddata/dataset/include/dataset/constants.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/validators.h"
 #include "utils/ms_utils.h"
 
@@ -61,17 +62,22 @@ namespace dataset {
   }
 
 Tensor::Tensor(const TensorShape &shape, const DataType &type) : shape_(shape), type_(type), data_(nullptr) {
-  // grab the mem pool from global context and create the allocator for char data area
-  std::shared_ptr<MemoryPool> global_pool = GlobalContext::Instance()->mem_pool();
-  data_allocator_ = std::make_unique<Allocator<unsigned char>>(global_pool);
+  // grab the mem pool of the pipeline running this thread, or else the one from global context,
+  // and create the allocator for char data area
+  std::shared_ptr<MemoryPool> pool = GetThreadMemoryPool();
+  if (pool == nullptr) {
+    pool = GlobalContext::Instance()->mem_pool();
+  }
+  data_allocator_ = std::make_unique<Allocator<unsigned char>>(pool);
 }
 
 Tensor::Tensor(Tensor &&other) noexcept
     : shape_(other.shape()),
       type_(other.type()),
-      data_(other.GetMutableBuffer()),
+      data_(other.data_),
       data_end_(other.data_end_),
-      data_allocator_(std::move(other.data_allocator_)) {
+      data_allocator_(std::move(other.data_allocator_)),
+      data_owner_(std::move(other.data_owner_)) {
   other.Invalidate();
 }
 
@@ -79,9 +85,10 @@ Tensor &Tensor::operator=(Tensor &&other) noexcept {
   if (&other != this) {
     shape_ = other.shape();
     type_ = other.type();
-    data_ = other.GetMutableBuffer();
+    data_ = other.data_;
     data_end_ = other.data_end_;
     data_allocator_ = std::move(other.data_allocator_);
+    data_owner_ = std::move(other.data_owner_);
     yuv_shape_ = other.yuv_shape_;
     other.Invalidate();
   }
@@ -171,6 +178,29 @@ Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type,
   return Status::OK();
 }
 
+Status Tensor::CreateFromMemoryView(const TensorShape &shape, const DataType &type, const uchar *src,
+                                    const dsize_t &length, const std::shared_ptr<const void> &owner,
+                                    TensorPtr *out) {
+  RETURN_UNEXPECTED_IF_NULL(src);
+  RETURN_UNEXPECTED_IF_NULL(owner);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(), "Only numeric tensor can be created as a view.");
+  CHECK_FAIL_RETURN_UNEXPECTED(reinterpret_cast<uintptr_t>(src) % type.SizeInBytes() == 0,
+                               "Source data of a tensor view is not aligned to its type.");
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, shape, type);
+  CHECK_FAIL_RETURN_UNEXPECTED(out != nullptr, "Allocate memory failed.");
+  dsize_t calculated_length = (*out)->SizeInBytes();
+  CHECK_FAIL_RETURN_UNEXPECTED(calculated_length == length, "Length of source data does not match the shape.");
+  if (length == 0) {
+    return Status::OK();
+  }
+  (*out)->data_ = const_cast<uchar *>(src);
+  (*out)->data_end_ = (*out)->data_ + length;
+  (*out)->data_owner_ = owner;
+  return Status::OK();
+}
+
 #ifdef ENABLE_PYTHON
 Status Tensor::CreateFromNpString(py::array arr, std::shared_ptr<Tensor> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
@@ -371,7 +401,12 @@ Status Tensor::CopyStridedArray(unsigned char *dst, unsigned char *src, std::vec
 // Name: Destructor
 // Description: Destructor
 Tensor::~Tensor() {
-  if (data_ != nullptr) {
+  if (data_owner_ != nullptr) {
+    // The data is borrowed, just drop the reference to its owner.
+    data_ = nullptr;
+    data_end_ = nullptr;
+    data_owner_ = nullptr;
+  } else if (data_ != nullptr) {
     if (data_allocator_ != nullptr) {
       data_allocator_->deallocate(data_);
       data_ = nullptr;
@@ -494,6 +529,23 @@ Status Tensor::AllocateBuffer(const dsize_t &length) {
   return Status::OK();
 }
 
+Status Tensor::CopyOnWrite() {
+  if (data_owner_ == nullptr) {
+    return Status::OK();
+  }
+  const uchar *src = data_;
+  dsize_t length = data_end_ - data_;
+  // Hold the owner until the data is copied
+  auto owner = std::move(data_owner_);
+  data_owner_ = nullptr;
+  data_ = nullptr;
+  data_end_ = nullptr;
+  RETURN_IF_NOT_OK(AllocateBuffer(length));
+  int ret_code = memcpy_s(data_, length, src, length);
+  CHECK_FAIL_RETURN_UNEXPECTED(ret_code == 0, "Failed to copy the data of a tensor view.");
+  return Status::OK();
+}
+
 Status Tensor::Reshape(const TensorShape &shape) {
   if (shape.NumOfElements() == shape_.NumOfElements()) {
     shape_ = shape;
@@ -510,6 +562,7 @@ void Tensor::Invalidate() {
   data_ = nullptr;
   data_end_ = nullptr;
   data_allocator_ = nullptr;
+  data_owner_ = nullptr;
 }
 
 template <typename T>
@@ -610,7 +663,7 @@ Status Tensor::InsertTensor(const std::vector<dsize_t> &ind, const std::shared_p
   } else {
     if (start_addr_of_ind != nullptr) {
       int ret_code =
-        memcpy_s(start_addr_of_ind, tensor->SizeInBytes(), tensor->GetMutableBuffer(), tensor->SizeInBytes());
+        memcpy_s(start_addr_of_ind, tensor->SizeInBytes(), tensor->GetBuffer(), tensor->SizeInBytes());
       if (ret_code == 0) {
         return Status::OK();
       } else {
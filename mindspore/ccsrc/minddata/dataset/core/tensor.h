@@ -107,6 +107,20 @@ class DATASET_API Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a numeric tensor that borrows the memory at src instead of copying it. The tensor keeps a reference to
+  /// owner, which must keep src valid for as long as it is referenced.
+  /// \note The borrowed memory is never written, the tensor copies it on the first mutable access to its data
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor, must be numeric
+  /// \param[in] src pointer to the source data, must be aligned to the size of type
+  /// \param[in] length length of the src data
+  /// \param[in] owner the object which owns the memory at src
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromMemoryView(const TensorShape &shape, const DataType &type, const uchar *src,
+                                     const dsize_t &length, const std::shared_ptr<const void> &owner,
+                                     TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -332,6 +346,7 @@ class DATASET_API Tensor {
   /// \param[in] value of type `T`
   template <typename T>
   Status SetItemAt(const std::vector<dsize_t> &index, const T &value) {
+    RETURN_IF_NOT_OK(CopyOnWrite());
     T *ptr = nullptr;
     RETURN_IF_NOT_OK(GetItemPtr<T>(&ptr, index));
     *ptr = value;
@@ -370,6 +385,7 @@ class DATASET_API Tensor {
   template <typename T>
   Status Fill(const T &value) {
     CHECK_FAIL_RETURN_UNEXPECTED(!type_.IsString(), "Can not fill on tensor of type string or bytes.");
+    RETURN_IF_NOT_OK(CopyOnWrite());
     int64_t cellSize = type_.SizeInBytes();
     if ((data_ != nullptr) && type_.IsCompatible<T>()) {
       for (dsize_t i = 0; i < Size(); i++) {
@@ -392,6 +408,10 @@ class DATASET_API Tensor {
   /// \return bool - true if tensor is not empty
   bool HasData() const { return data_ != nullptr; }
 
+  /// Check if tensor borrows its data, see CreateFromMemoryView
+  /// \return bool - true if the data of the tensor is owned by someone else
+  bool IsView() const { return data_owner_ != nullptr; }
+
   /// Check if tensor is complex
   /// \return bool - true if tensor is complex
   bool IsComplex() const {
@@ -753,7 +773,7 @@ class DATASET_API Tensor {
   /// \return TensorIterator
   template <typename T>
   TensorIterator<T> begin() {
-    return TensorIterator<T>(data_);
+    return TensorIterator<T>(GetMutableBuffer());
   }
 
   /// Return a linear iterator that points to the place after the last element of the Tensor.
@@ -761,7 +781,8 @@ class DATASET_API Tensor {
   /// \return TensorIterator
   template <typename T>
   TensorIterator<T> end() {
-    return TensorIterator<T>(data_end_);
+    // begin() and end() may be called in any order, both copy a view before returning
+    return GetMutableBuffer() == nullptr ? TensorIterator<T>(nullptr) : TensorIterator<T>(data_end_);
   }
 
   /// Copies the last dimension at `index` from Tensor `src` to this Tensor.
@@ -777,9 +798,14 @@ class DATASET_API Tensor {
   Status AllocateBuffer(const dsize_t &length);
 
   /// Get the starting memory address for the data of the tensor.  This potentially
-  /// drives an allocation if the data is null.
-  /// \return unsigned char*
-  unsigned char *GetMutableBuffer() { return data_; }
+  /// drives an allocation if the data is null, or a copy if the tensor is a view.
+  /// \return unsigned char*, nullptr if the data of a view could not be copied
+  unsigned char *GetMutableBuffer() { return CopyOnWrite().IsOk() ? data_ : nullptr; }
+
+  /// Copy the data of a view into memory of its own, so the tensor can be written without touching the owner.
+  /// Does nothing if the tensor is not a view.
+  /// \return Error Status
+  Status CopyOnWrite();
 
   /// A function that prints Tensor recursively, first called by print
   /// \param[in] out
@@ -833,6 +859,8 @@ class DATASET_API Tensor {
   CharAllocPtr data_allocator_;
   /// pointer to the end of the physical data
   unsigned char *data_end_ = nullptr;
+  /// owner of data_ if the tensor is a view, data_ is not released by the tensor in that case
+  std::shared_ptr<const void> data_owner_;
 
   /// shape for interpretation of YUV image
   std::vector<uint32_t> yuv_shape_;
@@ -33,7 +33,7 @@ TensorRow::TensorRow(row_id_type id, const std::initializer_list<value_type> &ls
     : id_(id), path_({}), row_(lst), tensor_row_flag_(kFlagNone) {}
 
 TensorRow::TensorRow(const TensorRow &tr)
-    : id_(tr.id_), path_(tr.path_), row_(tr.row_), tensor_row_flag_(tr.tensor_row_flag_) {}
+    : id_(tr.id_), path_(tr.path_), row_(tr.row_), state_(tr.state_), tensor_row_flag_(tr.tensor_row_flag_) {}
 
 TensorRow::TensorRow(TensorRow::TensorRowFlags flag) : id_(kDefaultRowId), path_({}), tensor_row_flag_(flag) {}
 
@@ -44,6 +44,7 @@ TensorRow &TensorRow::operator=(const TensorRow &tr) {
   row_ = tr.row_;
   id_ = tr.id_;
   path_ = tr.path_;
+  state_ = tr.state_;
   tensor_row_flag_ = tr.tensor_row_flag_;
   return *this;
 }
@@ -64,6 +65,7 @@ TensorRow::TensorRow(TensorRow &&tr) noexcept {
   id_ = tr.id_;
   path_ = std::move(tr.path_);
   row_ = std::move(tr.row_);
+  state_ = std::move(tr.state_);
   tensor_row_flag_ = tr.tensor_row_flag_;
 }
 
@@ -75,6 +77,7 @@ TensorRow &TensorRow::operator=(TensorRow &&tr) noexcept {
   id_ = tr.id_;
   tr.id_ = kDefaultRowId;
   path_ = std::move(tr.path_);
+  state_ = std::move(tr.state_);
   tensor_row_flag_ = tr.tensor_row_flag_;
   return *this;
 }
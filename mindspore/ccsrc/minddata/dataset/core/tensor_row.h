@@ -20,6 +20,7 @@
 #include <deque>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "minddata/dataset/core/tensor.h"
@@ -28,6 +29,7 @@ namespace mindspore {
 namespace dataset {
 
 class TensorRow;                             // A set of Tensor pointers with an id
+struct RowState;                             // Where the pipeline was when a row was sent
 using TensorTable = std::vector<TensorRow>;  // The table of tensors is a vector of rows
 using TensorQTable = std::deque<TensorRow>;  // A different flavour of tensor table, this one has queue functionality
 
@@ -167,6 +169,11 @@ class TensorRow {
 
   void setPath(const std::vector<std::string> &path) { path_ = path; }
 
+  // Functions to fetch/set the state of the pipeline carried by the row
+  std::shared_ptr<const RowState> getState() const { return state_; }
+
+  void setState(std::shared_ptr<const RowState> state) { state_ = std::move(state); }
+
   const vector_type &getRow() const { return row_; }
 
   dsize_t SizeInBytes() const {
@@ -243,6 +250,7 @@ class TensorRow {
   row_id_type id_;
   std::vector<std::string> path_;
   std::vector<std::shared_ptr<Tensor>> row_;
+  std::shared_ptr<const RowState> state_;
 
   TensorRowFlags tensor_row_flag_;
 
@@ -41,6 +41,10 @@ CacheAdminArgHandler::CacheAdminArgHandler()
       shm_mem_sz_(kDefaultSharedMemorySize),
       log_level_(kDefaultLogLevel),
       memory_cap_ratio_(kDefaultMemoryCapRatio),
+      eviction_policy_("none"),
+      session_mem_quota_(0),
+      session_disk_quota_(0),
+      compression_("none"),
       hostname_(kCfgDefaultCacheHost),
       port_(kCfgDefaultCachePort),
       spill_dir_("") {
@@ -90,6 +94,11 @@ CacheAdminArgHandler::CacheAdminArgHandler()
   arg_map_["--memory_cap_ratio"] = ArgValue::kArgMemoryCapRatio;
   arg_map_["--list_sessions"] = ArgValue::kArgListSessions;
   arg_map_["--server_info"] = ArgValue::kArgServerInfo;
+  arg_map_["-e"] = ArgValue::kArgEvictionPolicy;
+  arg_map_["--eviction_policy"] = ArgValue::kArgEvictionPolicy;
+  arg_map_["--session_memory_quota"] = ArgValue::kArgSessionMemoryQuota;
+  arg_map_["--session_disk_quota"] = ArgValue::kArgSessionDiskQuota;
+  arg_map_["--compression"] = ArgValue::kArgCompression;
   // Initialize argument tracker with false values
   for (int16_t i = 0; i < static_cast<int16_t>(ArgValue::kArgNumArgs); ++i) {
     ArgValue currAV = static_cast<ArgValue>(i);
@@ -334,6 +343,22 @@ Status CacheAdminArgHandler::ParseArgStream(std::stringstream *arg_stream) {
         RETURN_IF_NOT_OK(AssignArg(tok, &memory_cap_ratio_, arg_stream));
         break;
       }
+      case ArgValue::kArgEvictionPolicy: {
+        RETURN_IF_NOT_OK(AssignArg(tok, &eviction_policy_, arg_stream));
+        break;
+      }
+      case ArgValue::kArgSessionMemoryQuota: {
+        RETURN_IF_NOT_OK(AssignArg(tok, &session_mem_quota_, arg_stream));
+        break;
+      }
+      case ArgValue::kArgSessionDiskQuota: {
+        RETURN_IF_NOT_OK(AssignArg(tok, &session_disk_quota_, arg_stream));
+        break;
+      }
+      case ArgValue::kArgCompression: {
+        RETURN_IF_NOT_OK(AssignArg(tok, &compression_, arg_stream));
+        break;
+      }
       case ArgValue::kArgListSessions: {
         RETURN_IF_NOT_OK(AssignArg(tok, static_cast<std::string *>(nullptr), arg_stream, CommandId::kCmdListSessions));
         break;
@@ -388,6 +413,16 @@ Status CacheAdminArgHandler::Validate() {
     return Status(StatusCode::kMDSyntaxError, "Memory cap ratio should be positive and no greater than 1");
   }
 
+  CacheEvictionPolicy policy;
+  RETURN_IF_NOT_OK(StringToCacheEvictionPolicy(eviction_policy_, &policy));
+
+  if (session_mem_quota_ < 0 || session_disk_quota_ < 0) {
+    return Status(StatusCode::kMDSyntaxError, "Session quota (in MB) should not be negative.");
+  }
+
+  CacheCompression compression;
+  RETURN_IF_NOT_OK(StringToCacheCompression(compression_, &compression));
+
   if (port_ < kMinLegalPort || port_ > kMaxLegalPort) {
     return Status(StatusCode::kMDSyntaxError, "Port must be in range (1025..65535).");
   }
@@ -412,7 +447,7 @@ Status CacheAdminArgHandler::RunCommand() {
     case CommandId::kCmdGenerateSession: {
       CacheClientGreeter comm(hostname_, port_, 1);
       RETURN_IF_NOT_OK(comm.ServiceStart());
-      auto rq = std::make_shared<GenerateSessionIdRequest>();
+      auto rq = std::make_shared<GenerateSessionIdRequest>(compression_);
       RETURN_IF_NOT_OK(comm.HandleRequest(rq));
       RETURN_IF_NOT_OK(rq->Wait());
       std::cout << "Session created for server on port " << std::to_string(port_) << ": " << rq->GetSessionId()
@@ -443,13 +478,15 @@ Status CacheAdminArgHandler::RunCommand() {
       if (!session_info.empty()) {
         std::cout << std::setw(12) << "Session" << std::setw(12) << "Cache Id" << std::setw(12) << "Mem cached"
                   << std::setw(12) << "Disk cached" << std::setw(16) << "Avg cache size" << std::setw(10) << "Numa hit"
-                  << std::endl;
+                  << std::setw(13) << "Compression" << std::setw(15) << "Avg decode us" << std::endl;
         for (auto curr_session : session_info) {
           std::string cache_id;
           std::string stat_mem_cached;
           std::string stat_disk_cached;
           std::string stat_avg_cached;
           std::string stat_numa_hit;
+          std::string stat_compression;
+          std::string stat_decode;
           uint32_t crc = (curr_session.connection_id & 0x00000000FFFFFFFF);
           cache_id = (curr_session.connection_id == 0) ? "n/a" : std::to_string(crc);
           stat_mem_cached =
@@ -460,10 +497,23 @@ Status CacheAdminArgHandler::RunCommand() {
             (curr_session.stats.avg_cache_sz == 0) ? "n/a" : std::to_string(curr_session.stats.avg_cache_sz);
           stat_numa_hit =
             (curr_session.stats.num_numa_hit == 0) ? "n/a" : std::to_string(curr_session.stats.num_numa_hit);
+          // The ratio of the size of the rows before compression over their size as stored
+          if (curr_session.stats.stored_sz == 0 || curr_session.stats.raw_sz == curr_session.stats.stored_sz) {
+            stat_compression = "n/a";
+          } else {
+            std::stringstream ss;
+            ss << std::fixed << std::setprecision(2)
+               << static_cast<double>(curr_session.stats.raw_sz) / curr_session.stats.stored_sz << "x";
+            stat_compression = ss.str();
+          }
+          stat_decode = (curr_session.stats.num_decoded == 0)
+                          ? "n/a"
+                          : std::to_string(curr_session.stats.decode_time_us / curr_session.stats.num_decoded);
 
           std::cout << std::setw(12) << curr_session.session_id << std::setw(12) << cache_id << std::setw(12)
                     << stat_mem_cached << std::setw(12) << stat_disk_cached << std::setw(16) << stat_avg_cached
-                    << std::setw(10) << stat_numa_hit << std::endl;
+                    << std::setw(10) << stat_numa_hit << std::setw(13) << stat_compression << std::setw(15)
+                    << stat_decode << std::endl;
         }
       } else {
         std::cout << "No active sessions." << std::endl;
@@ -643,8 +693,10 @@ Status CacheAdminArgHandler::StartServer() {
     std::string minloglevel_string = std::to_string(log_level_);
     std::string daemonize_string = "true";
     std::string memory_cap_ratio_string = std::to_string(memory_cap_ratio_);
+    std::string session_mem_quota_string = std::to_string(session_mem_quota_);
+    std::string session_disk_quota_string = std::to_string(session_disk_quota_);
 
-    char *argv[9];
+    char *argv[12];
     argv[0] = cache_server_binary.data();
     argv[1] = spill_dir_.data();
     argv[2] = workers_string.data();
@@ -653,7 +705,10 @@ Status CacheAdminArgHandler::StartServer() {
     argv[5] = minloglevel_string.data();
     argv[6] = daemonize_string.data();
     argv[7] = memory_cap_ratio_string.data();
-    argv[8] = nullptr;
+    argv[8] = eviction_policy_.data();
+    argv[9] = session_mem_quota_string.data();
+    argv[10] = session_disk_quota_string.data();
+    argv[11] = nullptr;
 
     // Now exec the binary
     execv(cache_server_binary.data(), argv);
@@ -673,10 +728,15 @@ void CacheAdminArgHandler::Help() {
   std::cerr << "                [[-w | --workers] <number of workers>]    Default is " << kDefaultNumWorkers << ".\n";
   std::cerr << "                [[-s | --spilldir] <spilling directory>]  Default is no spilling.\n";
   std::cerr << "                [[-l | --loglevel] <log level>]           Default is 1 (INFO level).\n";
+  std::cerr << "                [[-e | --eviction_policy] <none | lru | clock | lfu>]\n";
+  std::cerr << "                                                          Default is none (no eviction).\n";
+  std::cerr << "                [--session_memory_quota <size in MB>]     Default is 0 (no quota).\n";
+  std::cerr << "                [--session_disk_quota <size in MB>]       Default is 0 (no quota).\n";
   std::cerr << "            [--destroy_session  | -d] <session id>\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
   std::cerr << "            [--generate_session | -g]\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
+  std::cerr << "                [--compression <none | fast | zlib>]     Default is none (no compression).\n";
   std::cerr << "            [--list_sessions]\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
   std::cerr << "            [--server_info]\n";
@@ -75,7 +75,11 @@ class CacheAdminArgHandler {
     kArgMemoryCapRatio = 12,
     kArgListSessions = 13,
     kArgServerInfo = 14,
-    kArgNumArgs = 15  // Must be the last position to provide a count
+    kArgEvictionPolicy = 15,
+    kArgSessionMemoryQuota = 16,
+    kArgSessionDiskQuota = 17,
+    kArgCompression = 18,
+    kArgNumArgs = 19  // Must be the last position to provide a count
   };
 
   Status StartServer();
@@ -104,6 +108,10 @@ class CacheAdminArgHandler {
   int32_t shm_mem_sz_;
   int32_t log_level_;
   float memory_cap_ratio_;
+  std::string eviction_policy_;
+  int32_t session_mem_quota_;
+  int32_t session_disk_quota_;
+  std::string compression_;
   std::string hostname_;
   int32_t port_;
   std::string spill_dir_;
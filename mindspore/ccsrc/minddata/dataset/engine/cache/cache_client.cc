@@ -24,7 +24,14 @@
 namespace mindspore {
 namespace dataset {
 CacheClient::Builder::Builder()
-    : session_id_(0), cache_mem_sz_(0), spill_(false), hostname_(""), port_(0), num_connections_(0), prefetch_size_(0) {
+    : session_id_(0),
+      cache_mem_sz_(0),
+      spill_(false),
+      hostname_(""),
+      port_(0),
+      num_connections_(0),
+      prefetch_size_(0),
+      zero_copy_fetch_(true) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   hostname_ = cfg->cache_host();
   port_ = cfg->cache_port();
@@ -37,6 +44,7 @@ Status CacheClient::Builder::Build(std::shared_ptr<CacheClient> *out) {
   RETURN_IF_NOT_OK(SanityCheck());
   *out = std::make_shared<CacheClient>(session_id_, cache_mem_sz_, spill_, hostname_, port_, num_connections_,
                                        prefetch_size_);
+  (*out)->zero_copy_fetch_ = zero_copy_fetch_;
   return Status::OK();
 }
 
@@ -63,6 +71,8 @@ CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool
       local_bypass_(false),
       num_connections_(num_connections),
       prefetch_size_(prefetch_size),
+      zero_copy_fetch_(true),
+      fetch_ring_addr_(-1),
       fetch_all_keys_(true) {
   cinfo_.set_session_id(session_id);
   comm_ = std::make_shared<CacheClientGreeter>(hostname, port, num_connections_);
@@ -70,7 +80,8 @@ CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool
 
 CacheClient::~CacheClient() {
   cache_miss_keys_wp_.Set();
-  // Manually release the async buffer because we need the comm layer.
+  // Manually release the fetch ring and the async buffer because we need the comm layer.
+  ReleaseFetchRing();
   if (async_buffer_stream_) {
     Status rc = async_buffer_stream_->ReleaseBuffer();
     if (rc.IsError()) {
@@ -102,7 +113,7 @@ void CacheClient::Print(std::ostream &out) const {
       << "\n  Server cache id: " << server_connection_id_ << "\n  Cache mem size: " << GetCacheMemSz()
       << "\n  Spilling: " << std::boolalpha << isSpill() << "\n  Number of rpc workers: " << GetNumConnections()
       << "\n  Prefetch size: " << GetPrefetchSize() << "\n  Local client support: " << std::boolalpha
-      << SupportLocalClient();
+      << SupportLocalClient() << "\n  Zero copy fetch: " << std::boolalpha << (fetch_ring_ != nullptr);
 }
 
 std::string CacheClient::GetHostname() const { return comm_->GetHostname(); }
@@ -130,9 +141,23 @@ Status CacheClient::AsyncWriteRow(const TensorRow &row) {
 Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable *out) const {
   RETURN_UNEXPECTED_IF_NULL(out);
   auto rq = std::make_shared<BatchFetchRequest>(this, row_id);
+  int64_t mem_addr = -1;
+  if (fetch_ring_ != nullptr) {
+    Status rc = FetchThroughRing(rq->GetRowIdsPayload(), &mem_addr);
+    if (rc.IsOk()) {
+      return RestoreRowsInPlace(rq.get(), mem_addr, out);
+    }
+    // Go through gRPC if the ring can't take the request, or the shared memory is short. The server can then send
+    // the rows in the reply.
+    if (rc.StatusCode() != StatusCode::kMDNotImplementedYet && rc.StatusCode() != StatusCode::kMDOutOfMemory) {
+      return rc;
+    }
+  }
   RETURN_IF_NOT_OK(PushRequest(rq));
   RETURN_IF_NOT_OK(rq->Wait());
-  int64_t mem_addr;
+  if (zero_copy_fetch_ && rq->DataInSharedMemory(&mem_addr)) {
+    return RestoreRowsInPlace(rq.get(), mem_addr, out);
+  }
   Status rc = rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), &mem_addr);
   // Free the memory by sending a request back to the server.
   if (mem_addr != -1) {
@@ -146,6 +171,92 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
   return rc;
 }
 
+Status CacheClient::FetchThroughRing(const std::string &payload, int64_t *addr) const {
+  int32_t slot = -1;
+  RETURN_IF_NOT_OK(fetch_ring_->Submit(payload, &slot));
+  return fetch_ring_->WaitForResult(slot, kFetchRingTimeoutInSec, addr);
+}
+
+Status CacheClient::RestoreRowsInPlace(BatchFetchRequest *rq, int64_t addr, TensorTable *out) const {
+  // If anything goes wrong, the tensors built so far go away with the lease and the block goes back to the server.
+  auto lease = std::make_shared<SharedBlockLease>(comm_, server_connection_id_, client_id_, addr);
+  auto *ptr = reinterpret_cast<const void *>(reinterpret_cast<int64_t>(SharedMemoryBaseAddr()) + addr);
+  return rq->RestoreRowsInPlace(out, ptr, lease);
+}
+
+CacheClient::SharedBlockLease::~SharedBlockLease() {
+  // The comm layer stops with the client. The blocks still leased then stay with the server until it shuts down.
+  if (comm_->ServiceState() != Service::STATE::kRunning) {
+    return;
+  }
+  try {
+    auto mfree_req = std::make_shared<FreeSharedBlockRequest>(connection_id_, client_id_, addr_);
+    // We won't wait for the result for the sake of performance.
+    Status rc = comm_->HandleRequest(mfree_req);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << rc;
+    }
+  } catch (const std::exception &e) {
+    // Can't do anything in destructor. So just log the error.
+    MS_LOG(ERROR) << e.what();
+  }
+}
+
+Status CacheClient::InitFetchRing() {
+  auto mem_rq =
+    std::make_shared<AllocateSharedBlockRequest>(server_connection_id_, client_id_, CacheFetchRing::RequiredSize());
+  RETURN_IF_NOT_OK(PushRequest(mem_rq));
+  RETURN_IF_NOT_OK(mem_rq->Wait());
+  auto addr = mem_rq->GetAddr();
+  auto base = SharedMemoryBaseAddr();
+  auto ring = std::make_unique<CacheFetchRing>(reinterpret_cast<void *>(reinterpret_cast<int64_t>(base) + addr));
+  ring->Init();
+  // As many pollers as rpc workers, so that as many fetches as through gRPC can be in flight.
+  auto reg_rq = std::make_shared<RegisterFetchRingRequest>(server_connection_id_, client_id_, addr, num_connections_);
+  Status rc = PushRequest(reg_rq);
+  if (rc.IsOk()) {
+    rc = reg_rq->Wait();
+  }
+  if (rc.IsError()) {
+    // No poller got started, so the memory can go back right away.
+    auto mfree_req = std::make_shared<FreeSharedBlockRequest>(server_connection_id_, client_id_, addr);
+    if (PushRequest(mfree_req).IsOk()) {
+      (void)mfree_req->Wait();
+    }
+    return rc;
+  }
+  fetch_ring_ = std::move(ring);
+  fetch_ring_addr_ = addr;
+  return Status::OK();
+}
+
+void CacheClient::ReleaseFetchRing() {
+  if (fetch_ring_ == nullptr) {
+    return;
+  }
+  fetch_ring_->Close();
+  if (!fetch_ring_->WaitForPollers(kFetchRingCloseTimeoutInMs)) {
+    // A poller may still write into the ring, so it is better to leave the memory with the server.
+    MS_LOG(WARNING) << "The pollers of the fetch ring at " << fetch_ring_addr_ << " are still running.";
+    fetch_ring_.reset();
+    return;
+  }
+  fetch_ring_.reset();
+  try {
+    auto mfree_req = std::make_shared<FreeSharedBlockRequest>(server_connection_id_, client_id_, fetch_ring_addr_);
+    Status rc = PushRequest(mfree_req);
+    if (rc.IsOk()) {
+      rc = mfree_req->Wait();
+    }
+    if (rc.IsError()) {
+      MS_LOG(ERROR) << rc;
+    }
+  } catch (const std::exception &e) {
+    // Can't do anything in destructor. So just log the error.
+    MS_LOG(ERROR) << e.what();
+  }
+}
+
 Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
   UniqueLock lck(&mux_);
   // To create a cache, we identify ourself at the client by:
@@ -215,6 +326,13 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
       if (local_bypass_) {
         async_buffer_stream_ = std::make_shared<AsyncBufferStream>();
         RETURN_IF_NOT_OK(async_buffer_stream_->Init(this));
+        if (zero_copy_fetch_) {
+          // A server which can't poll the ring still serves the fetches through gRPC.
+          Status ring_rc = InitFetchRing();
+          if (ring_rc.IsError()) {
+            MS_LOG(WARNING) << "Fetch ring not available, rows are fetched through gRPC. " << ring_rc;
+          }
+        }
       }
     }
     // We are not resetting the Duplicate key return code. We are passing it back to the CacheOp. This will tell the
@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/engine/cache/cache_fetch_ring.h"
 #ifdef ENABLE_CACHE
 #include "minddata/dataset/engine/cache/cache_grpc_client.h"
 #else
@@ -117,6 +118,16 @@ class CacheClient {
       return *this;
     }
 
+    /// Setter function to build the fetched tensors over the shared memory instead of copying them, and to send the
+    /// fetch requests through a ring in the shared memory instead of gRPC. Only applies to a client on the same host
+    /// as the server.
+    /// \param zero_copy_fetch
+    /// \return Builder object itself
+    Builder &SetZeroCopyFetch(bool zero_copy_fetch) {
+      zero_copy_fetch_ = zero_copy_fetch;
+      return *this;
+    }
+
     /// Getter functions
     session_id_type GetSessionId() const { return session_id_; }
     uint64_t GetCacheMemSz() const { return cache_mem_sz_; }
@@ -125,6 +136,7 @@ class CacheClient {
     int32_t GetPort() const { return port_; }
     int32_t GetNumConnections() const { return num_connections_; }
     int32_t GetPrefetchSize() const { return prefetch_size_; }
+    bool GetZeroCopyFetch() const { return zero_copy_fetch_; }
 
     Status SanityCheck();
 
@@ -138,6 +150,7 @@ class CacheClient {
     int32_t port_;
     int32_t num_connections_;
     int32_t prefetch_size_;
+    bool zero_copy_fetch_;
   };
 
   /// \brief Constructor
@@ -232,6 +245,7 @@ class CacheClient {
   int32_t GetNumConnections() const { return num_connections_; }
   int32_t GetPrefetchSize() const { return prefetch_size_; }
   int32_t GetClientId() const { return client_id_; }
+  bool GetZeroCopyFetch() const { return zero_copy_fetch_; }
   std::string GetHostname() const;
   int32_t GetPort() const;
 
@@ -260,6 +274,9 @@ class CacheClient {
   // Default size of the async write buffer
   constexpr static int64_t kAsyncBufferSize = 16 * 1048576L;  // 16M
   constexpr static int32_t kNumAsyncBuffer = 3;
+  // How long to wait for the server to fetch rows through the fetch ring, and for its pollers to stop
+  constexpr static int32_t kFetchRingTimeoutInSec = 60;
+  constexpr static int32_t kFetchRingCloseTimeoutInMs = 1000;
 
   /// Force a final flush to the cache server. Must be called when receiving eoe.
   Status FlushAsyncWriteBuffer() {
@@ -287,6 +304,9 @@ class CacheClient {
   int32_t num_connections_;
   int32_t prefetch_size_;
   mutable std::shared_ptr<CacheClientGreeter> comm_;
+  bool zero_copy_fetch_;
+  std::unique_ptr<CacheFetchRing> fetch_ring_;
+  int64_t fetch_ring_addr_;
   std::atomic<bool> fetch_all_keys_;
   WaitPost cache_miss_keys_wp_;
   /// A structure shared by all the prefetchers to know what keys are missing at the server.
@@ -354,6 +374,39 @@ class CacheClient {
     int32_t cur_;
   };
   std::shared_ptr<AsyncBufferStream> async_buffer_stream_;
+
+  /// Holds a block of shared memory filled by the server while the tensors built over it are in use, and gives the
+  /// block back to the server when the last of them goes away.
+  class SharedBlockLease {
+   public:
+    SharedBlockLease(std::shared_ptr<CacheClientGreeter> comm, connection_id_type connection_id, int32_t client_id,
+                     int64_t addr)
+        : comm_(std::move(comm)), connection_id_(connection_id), client_id_(client_id), addr_(addr) {}
+    ~SharedBlockLease();
+
+   private:
+    std::shared_ptr<CacheClientGreeter> comm_;  // Also keeps the shared memory attached
+    connection_id_type connection_id_;
+    int32_t client_id_;
+    int64_t addr_;
+  };
+
+  /// \brief Allocate a fetch ring in the shared memory and have the server poll it
+  /// \return Status object
+  Status InitFetchRing();
+
+  /// \brief Stop the pollers of the fetch ring and give its memory back to the server
+  void ReleaseFetchRing();
+
+  /// \brief Fetch rows through the fetch ring
+  /// \param[in] payload The serialized row ids
+  /// \param[out] addr Offset of the shared memory block holding the rows
+  /// \return Status object. kMDNotImplementedYet if the request has to go through gRPC instead.
+  Status FetchThroughRing(const std::string &payload, int64_t *addr) const;
+
+  /// \brief Build the rows fetched over the shared memory block holding them, which is leased until they are gone
+  /// \return Status object
+  Status RestoreRowsInPlace(BatchFetchRequest *rq, int64_t addr, TensorTable *out) const;
 };
 }  // namespace dataset
 }  // namespace mindspore
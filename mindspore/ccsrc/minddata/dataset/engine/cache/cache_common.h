@@ -53,6 +53,9 @@ constexpr static uint32_t kLocalClientSupport = 1;
 /// \brief A flag used by CacheRow request (client side) and BatchFetch (server side) reply to indicate if the data is
 /// inline in the protobuf. This also implies kLocalClientSupport is also true.
 constexpr static uint32_t kDataIsInSharedMemory = 2;
+/// \brief A flag used by the BatchFetch request (client side) to get the rows in shared memory whatever their amount,
+/// because the client builds the tensors over the shared memory rather than copying them out.
+constexpr static uint32_t kFetchToSharedMemory = 4;
 /// \brief Size of each message used in message queue.
 constexpr static int32_t kSharedMessageSize = 2048;
 /// \brief The default common path for all users
@@ -0,0 +1,294 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/cache/cache_compression.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#ifdef ENABLE_CACHE
+#include <zlib.h>
+#endif
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// The fast codec
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr int32_t kHashBits = 14;
+constexpr size_t kRunMask = 15;
+constexpr uint8_t kLengthByteMax = 255;
+// Past 2^kSkipTrigger misses in a row, the search skips more and more bytes, so data which doesn't compress costs
+// little time
+constexpr int32_t kSkipTrigger = 6;
+
+inline uint32_t Load32(const uint8_t *p) {
+  uint32_t v;
+  (void)std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t Hash(uint32_t v) { return (v * 2654435761U) >> (32 - kHashBits); }
+
+// A length past the 4 bits of the token goes in bytes of 255 until the rest
+void PutLength(size_t len, std::vector<uint8_t> *out) {
+  while (len >= kLengthByteMax) {
+    out->push_back(kLengthByteMax);
+    len -= kLengthByteMax;
+  }
+  out->push_back(static_cast<uint8_t>(len));
+}
+
+bool GetLength(const uint8_t **ip, const uint8_t *iend, size_t *len) {
+  uint8_t b;
+  do {
+    if (*ip >= iend) {
+      return false;
+    }
+    b = *(*ip)++;
+    *len += b;
+  } while (b == kLengthByteMax);
+  return true;
+}
+
+// A match_len of 0 is the last run, which has no match
+void PutSequence(const uint8_t *literals, size_t num_literals, size_t offset, size_t match_len,
+                 std::vector<uint8_t> *out) {
+  size_t ml = match_len > 0 ? match_len - kMinMatch : 0;
+  auto token = static_cast<uint8_t>((std::min(num_literals, kRunMask) << 4) | std::min(ml, kRunMask));
+  out->push_back(token);
+  if (num_literals >= kRunMask) {
+    PutLength(num_literals - kRunMask, out);
+  }
+  out->insert(out->end(), literals, literals + num_literals);
+  if (match_len > 0) {
+    out->push_back(static_cast<uint8_t>(offset & 0xff));
+    out->push_back(static_cast<uint8_t>(offset >> 8));
+    if (ml >= kRunMask) {
+      PutLength(ml - kRunMask, out);
+    }
+  }
+}
+}  // namespace
+
+Status StringToCacheCompression(const std::string &name, CacheCompression *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  if (name == "none") {
+    *out = CacheCompression::kNone;
+  } else if (name == "fast") {
+    *out = CacheCompression::kFast;
+  } else if (name == "zlib") {
+    *out = CacheCompression::kZlib;
+  } else {
+    RETURN_STATUS_ERROR(StatusCode::kMDSyntaxError,
+                        "Invalid compression: " + name + ". It should be one of none, fast and zlib.");
+  }
+  return Status::OK();
+}
+
+std::string CacheCompressionToString(CacheCompression compression) {
+  switch (compression) {
+    case CacheCompression::kFast:
+      return "fast";
+    case CacheCompression::kZlib:
+      return "zlib";
+    default:
+      return "none";
+  }
+}
+
+Status CacheRowCodec::Compress(CacheCompression compression, const std::vector<ReadableSlice> &buf,
+                               int32_t delta_stride, std::vector<uint8_t> *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  out->clear();
+  size_t raw_sz = 0;
+  for (auto &v : buf) {
+    raw_sz += v.GetSize();
+  }
+  // Positions of the fast codec are 32 bits
+  if (raw_sz == 0 || raw_sz > std::numeric_limits<uint32_t>::max()) {
+    return Status::OK();
+  }
+  std::vector<uint8_t> raw(raw_sz);
+  size_t pos = 0;
+  for (auto &v : buf) {
+    if (v.GetSize() > 0) {
+      (void)std::memcpy(raw.data() + pos, v.GetPointer(), v.GetSize());
+      pos += v.GetSize();
+    }
+  }
+  if (delta_stride < 0 || delta_stride > std::numeric_limits<uint16_t>::max() ||
+      static_cast<size_t>(delta_stride) >= raw_sz) {
+    delta_stride = 0;
+  }
+  if (delta_stride > 0) {
+    for (size_t i = raw_sz - 1; i >= static_cast<size_t>(delta_stride); --i) {
+      raw[i] = static_cast<uint8_t>(raw[i] - raw[i - delta_stride]);
+    }
+  }
+  out->resize(sizeof(Header));
+  switch (compression) {
+    case CacheCompression::kFast:
+      FastCompress(raw.data(), raw_sz, out);
+      break;
+    case CacheCompression::kZlib:
+      RETURN_IF_NOT_OK(ZlibCompress(raw.data(), raw_sz, out));
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("Invalid compression " + std::to_string(static_cast<int>(compression)));
+  }
+  if (out->size() >= raw_sz) {
+    out->clear();
+    return Status::OK();
+  }
+  Header hdr{kMagic, static_cast<int8_t>(compression), 0, static_cast<uint16_t>(delta_stride), raw_sz};
+  (void)std::memcpy(out->data(), &hdr, sizeof(hdr));
+  return Status::OK();
+}
+
+Status CacheRowCodec::Decompress(const ReadableSlice &src, WritableSlice *dest, size_t *raw_sz) {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  CHECK_FAIL_RETURN_UNEXPECTED(src.GetSize() >= sizeof(Header), "Compressed row is too small.");
+  Header hdr{};
+  (void)std::memcpy(&hdr, src.GetPointer(), sizeof(hdr));
+  CHECK_FAIL_RETURN_UNEXPECTED(hdr.magic == kMagic, "Not a compressed row.");
+  if (dest->GetSize() < hdr.raw_sz) {
+    RETURN_STATUS_UNEXPECTED("Destination too small to decompress a row. Need " + std::to_string(hdr.raw_sz) +
+                             " bytes but get " + std::to_string(dest->GetSize()));
+  }
+  auto *in = static_cast<const uint8_t *>(src.GetPointer()) + sizeof(Header);
+  auto in_sz = src.GetSize() - sizeof(Header);
+  auto *raw = static_cast<uint8_t *>(dest->GetMutablePointer());
+  switch (static_cast<CacheCompression>(hdr.compression)) {
+    case CacheCompression::kFast:
+      RETURN_IF_NOT_OK(FastDecompress(in, in_sz, raw, hdr.raw_sz));
+      break;
+    case CacheCompression::kZlib:
+      RETURN_IF_NOT_OK(ZlibDecompress(in, in_sz, raw, hdr.raw_sz));
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("Invalid compression " + std::to_string(static_cast<int>(hdr.compression)));
+  }
+  for (size_t i = hdr.delta_stride; hdr.delta_stride > 0 && i < hdr.raw_sz; ++i) {
+    raw[i] = static_cast<uint8_t>(raw[i] + raw[i - hdr.delta_stride]);
+  }
+  if (raw_sz != nullptr) {
+    *raw_sz = hdr.raw_sz;
+  }
+  return Status::OK();
+}
+
+void CacheRowCodec::FastCompress(const uint8_t *src, size_t sz, std::vector<uint8_t> *out) {
+  // Last position of each hash. Position 0 is where the table starts, it is always checked before use.
+  std::vector<uint32_t> table(1 << kHashBits, 0);
+  size_t anchor = 0;
+  size_t i = 0;
+  size_t misses = 0;
+  while (i + kMinMatch <= sz) {
+    auto seq = Load32(src + i);
+    auto h = Hash(seq);
+    size_t cand = table[h];
+    table[h] = static_cast<uint32_t>(i);
+    if (cand < i && i - cand <= kMaxOffset && Load32(src + cand) == seq) {
+      size_t len = kMinMatch;
+      while (i + len < sz && src[cand + len] == src[i + len]) {
+        ++len;
+      }
+      PutSequence(src + anchor, i - anchor, i - cand, len, out);
+      i += len;
+      anchor = i;
+      misses = 0;
+    } else {
+      i += 1 + (misses++ >> kSkipTrigger);
+    }
+  }
+  PutSequence(src + anchor, sz - anchor, 0, 0, out);
+}
+
+Status CacheRowCodec::FastDecompress(const uint8_t *src, size_t sz, uint8_t *dest, size_t dest_sz) {
+  const uint8_t *ip = src;
+  const uint8_t *iend = src + sz;
+  uint8_t *op = dest;
+  uint8_t *oend = dest + dest_sz;
+  const std::string err_msg = "Corrupted compressed row.";
+  while (ip < iend) {
+    uint8_t token = *ip++;
+    size_t num_literals = token >> 4;
+    if (num_literals == kRunMask) {
+      CHECK_FAIL_RETURN_UNEXPECTED(GetLength(&ip, iend, &num_literals), err_msg);
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      num_literals <= static_cast<size_t>(iend - ip) && num_literals <= static_cast<size_t>(oend - op), err_msg);
+    (void)std::memcpy(op, ip, num_literals);
+    ip += num_literals;
+    op += num_literals;
+    // The last run has no match
+    if (ip == iend) {
+      break;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(iend - ip >= 2, err_msg);
+    size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    size_t len = token & kRunMask;
+    if (len == kRunMask) {
+      CHECK_FAIL_RETURN_UNEXPECTED(GetLength(&ip, iend, &len), err_msg);
+    }
+    len += kMinMatch;
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      offset > 0 && offset <= static_cast<size_t>(op - dest) && len <= static_cast<size_t>(oend - op), err_msg);
+    const uint8_t *match = op - offset;
+    if (offset >= len) {
+      (void)std::memcpy(op, match, len);
+    } else {
+      // The match overlaps the bytes it produces, like a run of the same bytes
+      for (size_t k = 0; k < len; ++k) {
+        op[k] = match[k];
+      }
+    }
+    op += len;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(op == oend, err_msg);
+  return Status::OK();
+}
+
+#ifdef ENABLE_CACHE
+Status CacheRowCodec::ZlibCompress(const uint8_t *src, size_t sz, std::vector<uint8_t> *out) {
+  auto pos = out->size();
+  uLongf len = compressBound(static_cast<uLong>(sz));
+  out->resize(pos + len);
+  auto rc = compress2(out->data() + pos, &len, src, static_cast<uLong>(sz), Z_DEFAULT_COMPRESSION);
+  CHECK_FAIL_RETURN_UNEXPECTED(rc == Z_OK, "zlib fails to compress a row. Error " + std::to_string(rc));
+  out->resize(pos + len);
+  return Status::OK();
+}
+
+Status CacheRowCodec::ZlibDecompress(const uint8_t *src, size_t sz, uint8_t *dest, size_t dest_sz) {
+  uLongf len = static_cast<uLongf>(dest_sz);
+  auto rc = uncompress(dest, &len, src, static_cast<uLong>(sz));
+  CHECK_FAIL_RETURN_UNEXPECTED(rc == Z_OK && len == dest_sz, "Corrupted compressed row. zlib error " +
+                                                                 std::to_string(rc));
+  return Status::OK();
+}
+#else
+Status CacheRowCodec::ZlibCompress(const uint8_t *, size_t, std::vector<uint8_t> *) {
+  RETURN_STATUS_UNEXPECTED("zlib compression is not supported by this build.");
+}
+
+Status CacheRowCodec::ZlibDecompress(const uint8_t *, size_t, uint8_t *, size_t) {
+  RETURN_STATUS_UNEXPECTED("zlib compression is not supported by this build.");
+}
+#endif
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_COMPRESSION_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_COMPRESSION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "minddata/dataset/util/slice.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief How the cache server compresses the rows of the caches of a session
+enum class CacheCompression : int8_t {
+  kNone = 0,  // Rows are stored as they come
+  kFast = 1,  // A byte oriented LZ77 codec in the spirit of LZ4, which favours speed over ratio
+  kZlib = 2   // Deflate, which favours ratio over speed
+};
+
+/// \brief Convert a codec name (none, fast or zlib) to a codec
+/// \param[in] name The name of the codec
+/// \param[out] out The codec
+/// \return Status object
+Status StringToCacheCompression(const std::string &name, CacheCompression *out);
+
+/// \brief Convert a codec to its name
+std::string CacheCompressionToString(CacheCompression compression);
+
+/// \brief Compress and decompress the rows of a cache. A compressed row starts with a small header saying how it was
+/// compressed, so it is decompressed without knowing the codec of the cache.
+///
+/// Before the codec, a row may go through a lossless delta filter which replaces each byte by its difference with the
+/// byte a stride before it. Given the number of channels as the stride, the bytes of a decoded uint8 image become
+/// the differences between neighbouring pixels, mostly small values which compress far better than the pixels.
+class CacheRowCodec {
+ public:
+  /// \brief Compress a row
+  /// \param[in] compression The codec, other than kNone
+  /// \param[in] buf The row in pieces, compressed as one contiguous buffer
+  /// \param[in] delta_stride The stride of the delta filter, 0 for no filter
+  /// \param[out] out The compressed row. Empty if the row doesn't get smaller, in which case it is stored as it is.
+  /// \return Status object
+  static Status Compress(CacheCompression compression, const std::vector<ReadableSlice> &buf, int32_t delta_stride,
+                         std::vector<uint8_t> *out);
+
+  /// \brief Decompress a row
+  /// \param[in] src The compressed row
+  /// \param[out] dest Where the row goes. Its size must be at least the size of the row before compression.
+  /// \param[out] raw_sz Optional. The size of the row before compression.
+  /// \return Status object
+  static Status Decompress(const ReadableSlice &src, WritableSlice *dest, size_t *raw_sz = nullptr);
+
+ private:
+  // Written in front of each compressed row
+  struct Header {
+    uint32_t magic;
+    int8_t compression;
+    uint8_t reserved;
+    uint16_t delta_stride;
+    uint64_t raw_sz;
+  };
+  static constexpr uint32_t kMagic = 0x5a43444d;  // MDCZ
+
+  /// \brief The fast codec. A compressed block is a sequence of literal runs each followed by a match, a copy of
+  /// earlier bytes given as an offset back and a length. The last run has no match.
+  static void FastCompress(const uint8_t *src, size_t sz, std::vector<uint8_t> *out);
+  static Status FastDecompress(const uint8_t *src, size_t sz, uint8_t *dest, size_t dest_sz);
+
+  static Status ZlibCompress(const uint8_t *src, size_t sz, std::vector<uint8_t> *out);
+  static Status ZlibDecompress(const uint8_t *src, size_t sz, uint8_t *dest, size_t dest_sz);
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_COMPRESSION_H_
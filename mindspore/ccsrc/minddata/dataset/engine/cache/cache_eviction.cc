@@ -0,0 +1,255 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/cache/cache_eviction.h"
+
+namespace mindspore {
+namespace dataset {
+Status StringToCacheEvictionPolicy(const std::string &name, CacheEvictionPolicy *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  if (name == "none") {
+    *out = CacheEvictionPolicy::kNone;
+  } else if (name == "lru") {
+    *out = CacheEvictionPolicy::kLru;
+  } else if (name == "clock") {
+    *out = CacheEvictionPolicy::kClock;
+  } else if (name == "lfu") {
+    *out = CacheEvictionPolicy::kLfu;
+  } else {
+    RETURN_STATUS_ERROR(StatusCode::kMDSyntaxError,
+                        "Invalid eviction policy: " + name + ". It should be one of none, lru, clock and lfu.");
+  }
+  return Status::OK();
+}
+
+std::string CacheEvictionPolicyToString(CacheEvictionPolicy policy) {
+  switch (policy) {
+    case CacheEvictionPolicy::kLru:
+      return "lru";
+    case CacheEvictionPolicy::kClock:
+      return "clock";
+    case CacheEvictionPolicy::kLfu:
+      return "lfu";
+    default:
+      return "none";
+  }
+}
+
+Status CacheEvictor::CreateCacheEvictor(CacheEvictionPolicy policy, std::unique_ptr<CacheEvictor> *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  switch (policy) {
+    case CacheEvictionPolicy::kLru:
+      *out = std::make_unique<LruCacheEvictor>();
+      break;
+    case CacheEvictionPolicy::kClock:
+      *out = std::make_unique<ClockCacheEvictor>();
+      break;
+    case CacheEvictionPolicy::kLfu:
+      *out = std::make_unique<LfuCacheEvictor>();
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("No evictor for eviction policy " + CacheEvictionPolicyToString(policy));
+  }
+  return Status::OK();
+}
+
+void LruCacheEvictor::Add(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+  lru_.push_front(key);
+  index_.emplace(key, lru_.begin());
+}
+
+void LruCacheEvictor::Touch(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second);
+  }
+}
+
+void LruCacheEvictor::Remove(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    lru_.erase(it->second);
+    index_.erase(it);
+  }
+}
+
+bool LruCacheEvictor::Evict(key_type *key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (lru_.empty()) {
+    return false;
+  }
+  *key = lru_.back();
+  lru_.pop_back();
+  index_.erase(*key);
+  return true;
+}
+
+size_t LruCacheEvictor::Size() const {
+  std::unique_lock<std::mutex> lck(mux_);
+  return index_.size();
+}
+
+void ClockCacheEvictor::Add(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    ring_[it->second].referenced = true;
+    return;
+  }
+  size_t slot;
+  if (!free_slots_.empty()) {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+    ring_[slot] = {key, false, true};
+  } else {
+    slot = ring_.size();
+    ring_.push_back({key, false, true});
+  }
+  index_.emplace(key, slot);
+}
+
+void ClockCacheEvictor::Touch(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    ring_[it->second].referenced = true;
+  }
+}
+
+void ClockCacheEvictor::Remove(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    ring_[it->second].in_use = false;
+    free_slots_.push_back(it->second);
+    index_.erase(it);
+  }
+}
+
+bool ClockCacheEvictor::Evict(key_type *key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (index_.empty()) {
+    return false;
+  }
+  // At most two rounds, the first one may only clear the bits
+  while (true) {
+    hand_ = hand_ % ring_.size();
+    auto &slot = ring_[hand_];
+    ++hand_;
+    if (!slot.in_use) {
+      continue;
+    }
+    if (slot.referenced) {
+      slot.referenced = false;
+      continue;
+    }
+    *key = slot.key;
+    slot.in_use = false;
+    free_slots_.push_back(hand_ - 1);
+    index_.erase(*key);
+    return true;
+  }
+}
+
+size_t ClockCacheEvictor::Size() const {
+  std::unique_lock<std::mutex> lck(mux_);
+  return index_.size();
+}
+
+void LfuCacheEvictor::Add(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (index_.find(key) != index_.end()) {
+    lck.unlock();
+    Touch(key);
+    return;
+  }
+  auto &bucket = buckets_[1];
+  bucket.push_front(key);
+  index_.emplace(key, std::make_pair(1, bucket.begin()));
+}
+
+void LfuCacheEvictor::Touch(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return;
+  }
+  auto count = it->second.first;
+  auto bucket_it = buckets_.find(count);
+  auto &next_bucket = buckets_[count + 1];
+  next_bucket.splice(next_bucket.begin(), bucket_it->second, it->second.second);
+  if (bucket_it->second.empty()) {
+    buckets_.erase(bucket_it);
+  }
+  it->second.first = count + 1;
+}
+
+void LfuCacheEvictor::Remove(key_type key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return;
+  }
+  auto bucket_it = buckets_.find(it->second.first);
+  bucket_it->second.erase(it->second.second);
+  if (bucket_it->second.empty()) {
+    buckets_.erase(bucket_it);
+  }
+  index_.erase(it);
+}
+
+bool LfuCacheEvictor::Evict(key_type *key) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (buckets_.empty()) {
+    return false;
+  }
+  auto bucket_it = buckets_.begin();
+  *key = bucket_it->second.back();
+  bucket_it->second.pop_back();
+  if (bucket_it->second.empty()) {
+    buckets_.erase(bucket_it);
+  }
+  index_.erase(*key);
+  return true;
+}
+
+size_t LfuCacheEvictor::Size() const {
+  std::unique_lock<std::mutex> lck(mux_);
+  return index_.size();
+}
+
+bool CacheQuota::Reserve(std::atomic<uint64_t> *usage, uint64_t limit, uint64_t sz) {
+  if (limit == 0) {
+    *usage += sz;
+    return true;
+  }
+  uint64_t cur = usage->load();
+  do {
+    if (cur + sz > limit) {
+      return false;
+    }
+  } while (!usage->compare_exchange_weak(cur, cur + sz));
+  return true;
+}
+}  // namespace dataset
+}  // namespace mindspore
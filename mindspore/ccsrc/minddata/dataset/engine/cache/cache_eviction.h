@@ -0,0 +1,183 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_EVICTION_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_EVICTION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief How the cache server picks the rows to move out of a tier which is full
+enum class CacheEvictionPolicy : int8_t {
+  kNone = 0,   // Rows never leave a tier. Once the memory and the disk are full, nothing more is cached.
+  kLru = 1,    // The least recently used row
+  kClock = 2,  // The first row not used since the clock hand last went past it
+  kLfu = 3     // The least frequently used row, the least recently used one among those used as often
+};
+
+/// \brief Convert a policy name (none, lru, clock or lfu) to a policy
+/// \param[in] name The name of the policy
+/// \param[out] out The policy
+/// \return Status object
+Status StringToCacheEvictionPolicy(const std::string &name, CacheEvictionPolicy *out);
+
+/// \brief Convert a policy to its name
+std::string CacheEvictionPolicyToString(CacheEvictionPolicy policy);
+
+/// \brief A CacheEvictor keeps track of the rows held by one tier of the cache, and picks the row to move out
+/// when the tier is full. All the functions are thread safe.
+class CacheEvictor {
+ public:
+  using key_type = int64_t;
+
+  virtual ~CacheEvictor() = default;
+
+  /// \brief A row is added to the tier. Adding a row already in the tier is the same as using it.
+  virtual void Add(key_type key) = 0;
+
+  /// \brief A row of the tier is used. Rows not in the tier are ignored.
+  virtual void Touch(key_type key) = 0;
+
+  /// \brief A row leaves the tier for another reason than being evicted. Rows not in the tier are ignored.
+  virtual void Remove(key_type key) = 0;
+
+  /// \brief Pick the row to move out, which leaves the tier
+  /// \param[out] key The row picked
+  /// \return False if there is no row in the tier
+  virtual bool Evict(key_type *key) = 0;
+
+  /// \brief Number of rows in the tier
+  virtual size_t Size() const = 0;
+
+  /// \brief Create an evictor
+  /// \param[in] policy The policy of the evictor, other than kNone
+  /// \param[out] out The evictor
+  /// \return Status object
+  static Status CreateCacheEvictor(CacheEvictionPolicy policy, std::unique_ptr<CacheEvictor> *out);
+};
+
+/// \brief Rows in a list from the most to the least recently used
+class LruCacheEvictor : public CacheEvictor {
+ public:
+  LruCacheEvictor() = default;
+  ~LruCacheEvictor() override = default;
+
+  void Add(key_type key) override;
+  void Touch(key_type key) override;
+  void Remove(key_type key) override;
+  bool Evict(key_type *key) override;
+  size_t Size() const override;
+
+ private:
+  mutable std::mutex mux_;
+  std::list<key_type> lru_;
+  std::unordered_map<key_type, std::list<key_type>::iterator> index_;
+};
+
+/// \brief Rows in a ring of slots with a reference bit each. The hand goes around the ring clearing the bits set and
+/// stops at the first slot whose bit is clear. Using a row only sets its bit, which is cheaper than moving it in a
+/// list.
+class ClockCacheEvictor : public CacheEvictor {
+ public:
+  ClockCacheEvictor() : hand_(0) {}
+  ~ClockCacheEvictor() override = default;
+
+  void Add(key_type key) override;
+  void Touch(key_type key) override;
+  void Remove(key_type key) override;
+  bool Evict(key_type *key) override;
+  size_t Size() const override;
+
+ private:
+  struct Slot {
+    key_type key;
+    bool referenced;
+    bool in_use;
+  };
+  mutable std::mutex mux_;
+  std::vector<Slot> ring_;
+  std::vector<size_t> free_slots_;
+  std::unordered_map<key_type, size_t> index_;
+  size_t hand_;
+};
+
+/// \brief Rows in a list per use count, each list from the most to the least recently used
+class LfuCacheEvictor : public CacheEvictor {
+ public:
+  LfuCacheEvictor() = default;
+  ~LfuCacheEvictor() override = default;
+
+  void Add(key_type key) override;
+  void Touch(key_type key) override;
+  void Remove(key_type key) override;
+  bool Evict(key_type *key) override;
+  size_t Size() const override;
+
+ private:
+  using bucket_type = std::list<key_type>;
+  mutable std::mutex mux_;
+  std::map<uint64_t, bucket_type> buckets_;
+  std::unordered_map<key_type, std::pair<uint64_t, bucket_type::iterator>> index_;
+};
+
+/// \brief Memory and disk quota shared by all the caches of a session, so that the caches of several training jobs
+/// sharing one server can't take the whole memory or disk from each other. A limit of 0 means no limit.
+class CacheQuota {
+ public:
+  CacheQuota(uint64_t mem_limit, uint64_t disk_limit)
+      : mem_limit_(mem_limit), disk_limit_(disk_limit), mem_usage_(0), disk_usage_(0) {}
+  ~CacheQuota() = default;
+
+  /// \brief Reserve memory for a row
+  /// \return False if the row does not fit in the quota, and nothing is reserved
+  bool ReserveMemory(uint64_t sz) { return Reserve(&mem_usage_, mem_limit_, sz); }
+
+  /// \brief Give back the memory of a row
+  void ReleaseMemory(uint64_t sz) { mem_usage_ -= sz; }
+
+  /// \brief Reserve disk space for a row
+  /// \return False if the row does not fit in the quota, and nothing is reserved
+  bool ReserveDisk(uint64_t sz) { return Reserve(&disk_usage_, disk_limit_, sz); }
+
+  /// \brief Give back the disk space of a row
+  void ReleaseDisk(uint64_t sz) { disk_usage_ -= sz; }
+
+  uint64_t GetMemoryLimit() const { return mem_limit_; }
+  uint64_t GetDiskLimit() const { return disk_limit_; }
+  uint64_t GetMemoryUsage() const { return mem_usage_; }
+  uint64_t GetDiskUsage() const { return disk_usage_; }
+
+ private:
+  static bool Reserve(std::atomic<uint64_t> *usage, uint64_t limit, uint64_t sz);
+
+  const uint64_t mem_limit_;
+  const uint64_t disk_limit_;
+  std::atomic<uint64_t> mem_usage_;
+  std::atomic<uint64_t> disk_usage_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_EVICTION_H_
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/cache/cache_fetch_ring.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+namespace mindspore {
+namespace dataset {
+void CacheFetchRing::Backoff(int32_t round) {
+  constexpr int32_t kSpinRounds = 64;
+  constexpr int32_t kMaxSleepInUs = 500;
+  if (round < kSpinRounds) {
+    std::this_thread::yield();
+  } else {
+    std::this_thread::sleep_for(std::chrono::microseconds(std::min(round - kSpinRounds + 1, kMaxSleepInUs)));
+  }
+}
+
+void CacheFetchRing::Init() {
+  ring_ = new (ring_) Layout;
+  ring_->num_pollers.store(0);
+  ring_->closed.store(false);
+  ring_->next.store(0);
+  ring_->hand.store(0);
+  for (auto &s : ring_->slots) {
+    s.state.store(static_cast<int32_t>(SlotState::kFree));
+    s.rc = 0;
+    s.payload_sz = 0;
+    s.addr = -1;
+    s.msg[0] = '\0';
+  }
+}
+
+Status CacheFetchRing::Submit(const std::string &payload, int32_t *slot) {
+  RETURN_UNEXPECTED_IF_NULL(slot);
+  if (static_cast<int64_t>(payload.size()) > kMaxPayloadSize || ring_->closed.load() ||
+      ring_->num_pollers.load() == 0) {
+    return Status(StatusCode::kMDNotImplementedYet);
+  }
+  auto start = ring_->next.fetch_add(1);
+  for (auto i = 0; i < kNumSlots; ++i) {
+    auto k = static_cast<int32_t>((start + i) % kNumSlots);
+    if (Transit(k, SlotState::kFree, SlotState::kClaimed)) {
+      auto &s = ring_->slots[k];
+      (void)std::memcpy(s.payload, payload.data(), payload.size());
+      s.payload_sz = static_cast<int64_t>(payload.size());
+      s.state.store(static_cast<int32_t>(SlotState::kSubmitted));
+      *slot = k;
+      return Status::OK();
+    }
+  }
+  return Status(StatusCode::kMDNotImplementedYet);
+}
+
+Status CacheFetchRing::WaitForResult(int32_t slot, int32_t timeout_in_sec, int64_t *addr) {
+  RETURN_UNEXPECTED_IF_NULL(addr);
+  CHECK_FAIL_RETURN_UNEXPECTED(slot >= 0 && slot < kNumSlots, "Invalid slot " + std::to_string(slot));
+  auto &s = ring_->slots[slot];
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout_in_sec);
+  int32_t round = 0;
+  while (s.state.load() != static_cast<int32_t>(SlotState::kDone)) {
+    // If the pollers are gone, take the request back unless one of them got it before it left.
+    if (ring_->num_pollers.load() == 0 && Transit(slot, SlotState::kSubmitted, SlotState::kFree)) {
+      return Status(StatusCode::kMDNotImplementedYet);
+    }
+    // On a timeout, a request in progress is handed over to its poller, which frees the slot and the rows once it is
+    // done. If the result came in meanwhile, it is taken as usual.
+    if (std::chrono::steady_clock::now() > deadline &&
+        (Transit(slot, SlotState::kSubmitted, SlotState::kFree) ||
+         Transit(slot, SlotState::kInProgress, SlotState::kAbandoned))) {
+      RETURN_STATUS_ERROR(StatusCode::kMDTimeOut, "Timed out waiting for the cache server to fetch the rows.");
+    }
+    Backoff(round++);
+  }
+  auto rc = static_cast<StatusCode>(s.rc);
+  std::string msg(s.msg);
+  *addr = s.addr;
+  s.state.store(static_cast<int32_t>(SlotState::kFree));
+  if (rc != StatusCode::kSuccess) {
+    return Status(rc, msg);
+  }
+  return Status::OK();
+}
+
+bool CacheFetchRing::WaitForPollers(int32_t timeout_in_ms) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_in_ms);
+  int32_t round = 0;
+  while (ring_->num_pollers.load() > 0) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    Backoff(round++);
+  }
+  return true;
+}
+
+bool CacheFetchRing::Poll(int32_t *slot, std::string *payload) {
+  auto start = ring_->hand.load();
+  for (auto i = 0; i < kNumSlots; ++i) {
+    auto k = static_cast<int32_t>((start + i) % kNumSlots);
+    if (Transit(k, SlotState::kSubmitted, SlotState::kInProgress)) {
+      auto &s = ring_->slots[k];
+      ring_->hand.store(static_cast<uint32_t>(k + 1));
+      payload->assign(s.payload, std::min(s.payload_sz, kMaxPayloadSize));
+      *slot = k;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CacheFetchRing::Complete(int32_t slot, const Status &rc, int64_t addr) {
+  auto &s = ring_->slots[slot];
+  s.rc = static_cast<uint32_t>(rc.StatusCode());
+  s.addr = addr;
+  auto msg = rc.IsOk() ? std::string() : rc.GetErrDescription();
+  auto len = std::min(msg.size(), static_cast<size_t>(kMaxMessageSize - 1));
+  (void)std::memcpy(s.msg, msg.data(), len);
+  s.msg[len] = '\0';
+  if (Transit(slot, SlotState::kInProgress, SlotState::kDone)) {
+    return true;
+  }
+  // The client gave up on the request
+  s.state.store(static_cast<int32_t>(SlotState::kFree));
+  return false;
+}
+}  // namespace dataset
+}  // namespace mindspore
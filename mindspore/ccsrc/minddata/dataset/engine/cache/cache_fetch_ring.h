@@ -0,0 +1,133 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_FETCH_RING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_FETCH_RING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A ring of request slots which a client on the same host as the server places in the shared memory.
+/// The client writes the row ids of a batch fetch into a slot. The server polls the ring, copies the rows into a
+/// block of the shared memory and writes back the offset of the block. Neither gRPC nor any lock is involved, each
+/// slot goes through its states by compare and swap.
+/// \note This class is only a view of the ring. The memory is owned by the client which allocates it.
+class CacheFetchRing {
+ public:
+  constexpr static int32_t kNumSlots = 16;
+  constexpr static int64_t kMaxPayloadSize = 32768;
+  constexpr static int32_t kMaxMessageSize = 256;
+
+  /// \brief States of a slot. Each one says who moves the slot to the next state.
+  enum class SlotState : int32_t {
+    kFree = 0,        // The client claims the slot
+    kClaimed = 1,     // The client writes the row ids and submits them
+    kSubmitted = 2,   // A poller of the server picks the slot up
+    kInProgress = 3,  // The poller fetches the rows and writes back the result
+    kDone = 4,        // The client reads the result and frees the slot
+    kAbandoned = 5    // The client timed out while the poller had the request, the poller drops the result and
+                      // frees the slot
+  };
+
+  explicit CacheFetchRing(void *addr) : ring_(static_cast<Layout *>(addr)) {}
+  ~CacheFetchRing() = default;
+
+  /// \brief Size of the shared memory block holding a ring
+  static int64_t RequiredSize() { return sizeof(Layout); }
+
+  /// \brief Wait a bit longer each round an idle loop goes through. The first rounds only yield the cpu.
+  /// \param round Number of rounds so far
+  static void Backoff(int32_t round);
+
+  /// \brief Set up an empty ring. Called by the client before it registers the ring.
+  void Init();
+
+  /// \brief Send a batch fetch to the server
+  /// \param[in] payload The serialized row ids
+  /// \param[out] slot The slot holding the request
+  /// \return Status object. kMDNotImplementedYet if the request can't go through the ring, either because no poller
+  /// is running, all the slots are in use or the payload is too big, and has to go through gRPC instead.
+  Status Submit(const std::string &payload, int32_t *slot);
+
+  /// \brief Wait for the result of a batch fetch and free its slot
+  /// \param[in] slot The slot returned by Submit
+  /// \param[in] timeout_in_sec How long to wait for the server
+  /// \param[out] addr Offset of the shared memory block holding the rows
+  /// \return Status object. The error of the server if the fetch fails, and kMDNotImplementedYet if the pollers
+  /// stop before the request is picked up, in which case it has to go through gRPC instead.
+  Status WaitForResult(int32_t slot, int32_t timeout_in_sec, int64_t *addr);
+
+  /// \brief Tell the pollers to stop. No more request is accepted.
+  void Close() { ring_->closed.store(true); }
+
+  /// \brief Wait for all the pollers to stop after Close
+  /// \return False if some are still running after the timeout, in which case the ring must not be freed
+  bool WaitForPollers(int32_t timeout_in_ms);
+
+  /// \brief A poller starts or stops
+  void PollerStarted() { ++ring_->num_pollers; }
+  void PollerStopped() { --ring_->num_pollers; }
+
+  bool IsClosed() const { return ring_->closed.load(); }
+
+  /// \brief Pick up the next request submitted
+  /// \param[out] slot The slot of the request
+  /// \param[out] payload The serialized row ids
+  /// \return False if there is no request waiting
+  bool Poll(int32_t *slot, std::string *payload);
+
+  /// \brief Write back the result of a request
+  /// \param slot The slot returned by Poll
+  /// \param rc The status of the fetch
+  /// \param addr Offset of the shared memory block holding the rows when the fetch succeeds
+  /// \return False if the client gave up on the request, the slot is then free and the caller frees the block
+  bool Complete(int32_t slot, const Status &rc, int64_t addr);
+
+ private:
+  struct alignas(64) Slot {
+    std::atomic<int32_t> state;
+    uint32_t rc;
+    int64_t payload_sz;
+    int64_t addr;
+    char msg[kMaxMessageSize];
+    char payload[kMaxPayloadSize];
+  };
+
+  struct Layout {
+    alignas(64) std::atomic<int32_t> num_pollers;
+    std::atomic<bool> closed;
+    alignas(64) std::atomic<uint32_t> next;  // Where the client starts looking for a free slot
+    alignas(64) std::atomic<uint32_t> hand;  // Where the pollers start looking for a request
+    Slot slots[kNumSlots];
+  };
+
+  static_assert(std::atomic<int32_t>::is_always_lock_free, "The ring is shared between processes");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free, "The ring is shared between processes");
+  static_assert(std::atomic<bool>::is_always_lock_free, "The ring is shared between processes");
+
+  bool Transit(int32_t slot, SlotState from, SlotState to) {
+    auto expected = static_cast<int32_t>(from);
+    return ring_->slots[slot].state.compare_exchange_strong(expected, static_cast<int32_t>(to));
+  }
+
+  Layout *ring_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_FETCH_RING_H_
@@ -31,7 +31,7 @@ namespace ms = mindspore;
 namespace ds = mindspore::dataset;
 
 namespace {
-const int32_t kTotalArgs = 8;
+const int32_t kTotalArgs = 11;
 enum ArgIndex : uint8_t {
   kProcessName = 0,
   kRootDir = 1,
@@ -40,7 +40,10 @@ enum ArgIndex : uint8_t {
   kSharedMemorySize = 4,
   kLogLevel = 5,
   kDemonize = 6,
-  kMemoryCapRatio = 7
+  kMemoryCapRatio = 7,
+  kEvictionPolicy = 8,
+  kSessionMemoryQuota = 9,
+  kSessionDiskQuota = 10
 };
 
 ms::Status BuildServer(ds::CacheServer::Builder *builder, ds::SharedMessage *msg, int32_t port, bool daemonize) {
@@ -135,12 +138,17 @@ ms::Status StartServer(int argc, char **argv) {
   }
 
   int32_t port = static_cast<int32_t>(strtol(argv[ArgIndex::kPort], nullptr, ds::kDecimal));
+  ds::CacheEvictionPolicy eviction_policy;
+  RETURN_IF_NOT_OK(ds::StringToCacheEvictionPolicy(argv[ArgIndex::kEvictionPolicy], &eviction_policy));
   builder.SetRootDirectory(argv[ArgIndex::kRootDir])
     .SetNumWorkers(static_cast<int32_t>(strtol(argv[ArgIndex::kNumWorkers], nullptr, ds::kDecimal)))
     .SetPort(port)
     .SetSharedMemorySizeInGB(static_cast<int32_t>(strtol(argv[ArgIndex::kSharedMemorySize], nullptr, ds::kDecimal)))
     .SetLogLevel(static_cast<int8_t>((strtol(argv[ArgIndex::kLogLevel], nullptr, ds::kDecimal))))
-    .SetMemoryCapRatio(strtof(argv[ArgIndex::kMemoryCapRatio], nullptr));
+    .SetMemoryCapRatio(strtof(argv[ArgIndex::kMemoryCapRatio], nullptr))
+    .SetEvictionPolicy(eviction_policy)
+    .SetSessionMemoryQuota(static_cast<int32_t>(strtol(argv[ArgIndex::kSessionMemoryQuota], nullptr, ds::kDecimal)))
+    .SetSessionDiskQuota(static_cast<int32_t>(strtol(argv[ArgIndex::kSessionDiskQuota], nullptr, ds::kDecimal)));
 
   auto daemonize_string = argv[ArgIndex::kDemonize];
   bool daemonize = strcmp(daemonize_string, "true") == 0 || strcmp(daemonize_string, "TRUE") == 0 ||
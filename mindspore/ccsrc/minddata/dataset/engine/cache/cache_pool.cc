@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <chrono>
+#include <numeric>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/engine/cache/cache_pool.h"
 #include "minddata/dataset/engine/cache/cache_server.h"
@@ -21,8 +23,36 @@
 
 namespace mindspore {
 namespace dataset {
-CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+namespace {
+// Rows move to the disk once the memory used is above the high watermark, until it is below the low watermark
+constexpr float kHighWatermark = 0.95;
+constexpr float kLowWatermark = 0.85;
+// Share of the memory moved to the disk at least after an allocation failed
+constexpr float kMinDemoteRatio = 0.05;
+// Most rows dropped from the disk to make room for one row
+constexpr int32_t kMaxDropsPerWrite = 16;
+}  // namespace
+
+CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root, CacheEvictionPolicy policy,
+                     bool drop_allowed, std::shared_ptr<CacheQuota> quota, CacheCompression compression)
+    : mp_(std::move(mp)),
+      root_(root),
+      subfolder_(Services::GetUniqueID()),
+      sm_(nullptr),
+      tree_(nullptr),
+      policy_(policy),
+      drop_allowed_(drop_allowed),
+      quota_(std::move(quota)),
+      compression_(compression),
+      num_decoded_(0),
+      decode_time_ns_(0),
+      mem_usage_(0),
+      num_evicted_(0),
+      mem_capacity_(0),
+      evict_enabled_(true),
+      demote_request_(false),
+      demote_stalled_(false),
+      epoch_(0) {
   // Initialize soft memory cap to the current available memory on the machine.
   soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
   temp_mem_usage_ = 0;
@@ -40,12 +70,39 @@ Status CachePool::DoServiceStart() {
     RETURN_IF_NOT_OK(sm_->ServiceStart());
     MS_LOG(INFO) << "CachePool will use disk folder: " << spill.ToString();
   }
+  if (EvictionEnabled()) {
+    auto nodes = mp_->GetAvailableNodes();
+    numa_id_t num_nodes = nodes.empty() ? 1 : *std::max_element(nodes.begin(), nodes.end()) + 1;
+    mem_evictors_.resize(num_nodes);
+    node_mem_usage_ = std::make_unique<std::atomic<int64_t>[]>(num_nodes);
+    for (numa_id_t i = 0; i < num_nodes; ++i) {
+      RETURN_IF_NOT_OK(CacheEvictor::CreateCacheEvictor(policy_, &mem_evictors_[i]));
+      node_mem_usage_[i] = 0;
+    }
+    RETURN_IF_NOT_OK(CacheEvictor::CreateCacheEvictor(policy_, &disk_evictor_));
+    mem_capacity_ = static_cast<uint64_t>(mp_->GetAvailableMemory());
+    // Nothing to move the rows to without a disk
+    if (sm_ != nullptr) {
+      RETURN_IF_NOT_OK(vg_.ServiceStart());
+      RETURN_IF_NOT_OK(demote_cv_.Register(vg_.GetIntrpService()));
+      RETURN_IF_NOT_OK(vg_.CreateAsyncTask("Cache demoter", std::bind(&CachePool::Demoter, this)));
+    }
+    MS_LOG(INFO) << "CachePool eviction policy: " << CacheEvictionPolicyToString(policy_)
+                 << ", drop allowed: " << drop_allowed_;
+  }
   return Status::OK();
 }
 
 Status CachePool::DoServiceStop() {
   Status rc;
   Status rc2;
+  if (EvictionEnabled() && sm_ != nullptr) {
+    rc = vg_.ServiceStop();
+    if (rc.IsError() && rc != StatusCode::kMDInterrupted) {
+      rc2 = rc;
+    }
+  }
+  retired_.clear();
   if (sm_ != nullptr) {
     rc = sm_->ServiceStop();
     if (rc.IsError()) {
@@ -79,7 +136,23 @@ Status CachePool::DoServiceStop() {
 
 CachePool::~CachePool() noexcept { (void)ServiceStop(); }
 
-Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlice> &buf) {
+Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlice> &buf, int32_t delta_stride) {
+  if (compression_ != CacheCompression::kNone) {
+    std::vector<uint8_t> packed;
+    RETURN_IF_NOT_OK(CacheRowCodec::Compress(compression_, buf, delta_stride, &packed));
+    // A row which doesn't get smaller is stored as it is
+    if (!packed.empty()) {
+      size_t raw_sz = 0;
+      for (auto &v : buf) {
+        raw_sz += v.GetSize();
+      }
+      return Store(key, {ReadableSlice(packed.data(), packed.size())}, raw_sz);
+    }
+  }
+  return Store(key, buf, 0);
+}
+
+Status CachePool::Store(key_type key, const std::vector<ReadableSlice> &buf, size_t raw_sz) {
   DataLocator bl;
   Status rc;
   size_t sz = 0;
@@ -88,10 +161,14 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     sz += v.GetSize();
   }
   bl.sz = sz;
+  bl.raw_sz = raw_sz;
+  bool mem_reserved = (quota_ == nullptr || quota_->ReserveMemory(sz));
   // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got killed
   // or crashing the machine, set lower bound memory, which means stopping cache once the rest available memory is less
   // than the lower bound. (The default is 20% of physical RAM)
-  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
+  if (!mem_reserved) {
+    rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of the memory quota of the session.");
+  } else if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
     MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
                     << ". The cache server will not cache any more data.";
     rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
@@ -127,19 +204,32 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     if (rc.IsError()) {
       mp_->Deallocate(bl.ptr);
       bl.ptr = nullptr;
+      if (quota_ != nullptr) {
+        quota_->ReleaseMemory(sz);
+      }
       return rc;
     }
   } else if (rc == StatusCode::kMDOutOfMemory) {
+    if (mem_reserved && quota_ != nullptr) {
+      quota_->ReleaseMemory(sz);
+    }
+    // Make room in the memory for the rows to come, but don't wait for it.
+    if (EvictionEnabled() && sm_ != nullptr) {
+      WakeDemoter(true);
+    }
     // If no memory, write to disk.
     if (sm_ != nullptr) {
       MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.sz << " bytes.";
-      RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
+      RETURN_IF_NOT_OK(WriteToDisk(buf, &bl));
     } else {
       // If asked to spill to disk instead but there is no storage set up, simply return no memory
       // instead.
       RETURN_STATUS_OOM("No enough storage for cache server to cache data.");
     }
   } else {
+    if (mem_reserved && quota_ != nullptr) {
+      quota_->ReleaseMemory(sz);
+    }
     return rc;
   }
   // Insert into the B+ tree. We may still get out of memory error. So need to catch it.
@@ -148,41 +238,86 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
   } catch (const std::bad_alloc &e) {
     rc = STATUS_ERROR(StatusCode::kMDOutOfMemory, "Out of memory.");
   }
+  // A dropped row keeps its key, so it comes back as a duplicate key
+  if (rc == StatusCode::kMDDuplicateKey && EvictionEnabled()) {
+    rc = Readmit(key, bl);
+  }
   // Duplicate key is treated as error and we will also free the memory.
-  if (rc.IsError() && bl.ptr != nullptr) {
-    mp_->Deallocate(bl.ptr);
-    bl.ptr = nullptr;
+  if (rc.IsError()) {
+    if (quota_ != nullptr && bl.ptr != nullptr) {
+      quota_->ReleaseMemory(bl.sz);
+    } else if (quota_ != nullptr) {
+      quota_->ReleaseDisk(bl.sz);
+    }
+    FreeLocator(bl);
     return rc;
   }
+  if (EvictionEnabled()) {
+    Track(key, bl);
+    if (bl.ptr != nullptr && sm_ != nullptr && MemoryAbove(kHighWatermark)) {
+      WakeDemoter(false);
+    }
+  }
   return rc;
 }
 
 Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) const {
   RETURN_UNEXPECTED_IF_NULL(dest);
   auto r = tree_->Search(key);
-  if (r.second) {
-    auto &it = r.first;
-    if (it->ptr != nullptr) {
-      ReadableSlice src(it->ptr, it->sz);
-      RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
-    } else if (sm_ != nullptr) {
-      size_t expectedLength = 0;
-      RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
-      if (expectedLength != it->sz) {
-        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
-                      << " Internal key: " << key << "\n";
-        RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
+  if (r.second && r.first->sz == 0) {
+    // Dropped since it was located. The fetch which located it holds the space until it is done.
+    std::unique_lock<std::mutex> lck(retire_mux_);
+    for (auto it = retired_.rbegin(); it != retired_.rend(); ++it) {
+      if (it->key == key && it->locator.ptr == nullptr && sm_ != nullptr) {
+        return ReadLocator(key, it->locator, dest, bytesRead);
       }
     }
-    if (bytesRead != nullptr) {
-      *bytesRead = it->sz;
-    }
+    RETURN_STATUS_UNEXPECTED("Key not found");
+  }
+  if (r.second) {
+    RETURN_IF_NOT_OK(ReadLocator(key, *r.first, dest, bytesRead));
   } else {
     RETURN_STATUS_UNEXPECTED("Key not found");
   }
   return Status::OK();
 }
 
+Status CachePool::ReadLocator(key_type key, const DataLocator &bl, WritableSlice *dest, size_t *bytesRead) const {
+  ReadableSlice src;
+  std::vector<uint8_t> packed;
+  if (bl.ptr != nullptr) {
+    src = ReadableSlice(bl.ptr, bl.sz);
+  } else if (sm_ != nullptr) {
+    // A compressed row on the disk is read into a buffer first
+    WritableSlice out(*dest);
+    if (bl.raw_sz > 0) {
+      packed.resize(bl.sz);
+      out = WritableSlice(packed.data(), packed.size());
+    }
+    size_t expectedLength = 0;
+    RETURN_IF_NOT_OK(sm_->Read(bl.storage_key, &out, &expectedLength));
+    if (expectedLength != bl.sz) {
+      MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << bl.sz << "."
+                    << " Internal key: " << key << "\n";
+      RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
+    }
+    src = out;
+  }
+  if (bl.raw_sz > 0) {
+    auto start = std::chrono::steady_clock::now();
+    RETURN_IF_NOT_OK(CacheRowCodec::Decompress(src, dest));
+    auto end = std::chrono::steady_clock::now();
+    ++num_decoded_;
+    decode_time_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+  } else if (bl.ptr != nullptr) {
+    RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+  }
+  if (bytesRead != nullptr) {
+    *bytesRead = bl.raw_sz > 0 ? bl.raw_sz : bl.sz;
+  }
+  return Status::OK();
+}
+
 Path CachePool::GetSpillPath() const {
   auto spill = Path(root_) / subfolder_;
   return spill;
@@ -190,7 +325,7 @@ Path CachePool::GetSpillPath() const {
 
 CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
   tree_->LockShared();  // Prevent any node split while we search.
-  CacheStat cs{-1, -1, 0, 0, 0, 0};
+  CacheStat cs{-1, -1, 0, 0, 0, 0, 0, 0, 0, num_decoded_, decode_time_ns_ / 1000};
   int64_t total_sz = 0;
   if (tree_->begin() != tree_->end()) {
     cs.min_key = tree_->begin().key();
@@ -198,7 +333,15 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
     for (auto it = tree_->begin(); it != tree_->end(); ++it) {
       it.LockShared();
       total_sz += it.value().sz;
-      if (it.value().ptr != nullptr) {
+      cs.raw_sz += it.value().raw_sz > 0 ? it.value().raw_sz : it.value().sz;
+      auto cur_key = it.key();
+      if (it.value().sz == 0) {
+        // A dropped row
+        ++cs.num_evicted;
+        if (GetMissingKeys) {
+          cs.gap.push_back(cur_key);
+        }
+      } else if (it.value().ptr != nullptr) {
         ++cs.num_mem_cached;
       } else {
         ++cs.num_disk_cached;
@@ -206,7 +349,6 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
       if (it.value().node_hit) {
         ++cs.num_numa_hit;
       }
-      auto cur_key = it.key();
       if (GetMissingKeys) {
         for (auto i = cs.max_key + 1; i < cur_key; ++i) {
           cs.gap.push_back((i));
@@ -216,7 +358,8 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
       it.Unlock();
     }
   }
-  if (total_sz > 0) {
+  cs.stored_sz = total_sz;
+  if (total_sz > 0 && cs.num_disk_cached + cs.num_mem_cached > 0) {
     // integer arithmetic. NO need to cast to float or double.
     cs.average_cache_sz = total_sz / (cs.num_disk_cached + cs.num_mem_cached);
     if (cs.average_cache_sz == 0) {
@@ -233,11 +376,17 @@ Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers
   auto r = tree_->Search(key);
   if (r.second) {
     auto &it = r.first;
+    if (EvictionEnabled() && it->ptr != nullptr) {
+      MemEvictor(it->node_id)->Touch(key);
+    } else if (EvictionEnabled() && it->sz > 0) {
+      disk_evictor_->Touch(key);
+    }
     DataLocatorMsgBuilder bld(*fbb);
     bld.add_key(key);
-    bld.add_size(it->sz);
+    // A compressed row is only copied out through Read, which decompresses it
+    bld.add_size(it->raw_sz > 0 ? it->raw_sz : it->sz);
     bld.add_node_id(it->node_id);
-    bld.add_addr(reinterpret_cast<int64_t>(it->ptr));
+    bld.add_addr(it->raw_sz > 0 ? 0 : reinterpret_cast<int64_t>(it->ptr));
     auto offset = bld.Finish();
     *out = offset;
   } else {
@@ -247,5 +396,282 @@ Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers
   }
   return Status::OK();
 }
+
+void CachePool::SetLocking(bool on_off) {
+  {
+    std::unique_lock<std::mutex> lck(update_mux_);
+    evict_enabled_ = on_off;
+    tree_->SetLocking(on_off);
+  }
+  // The demoter is parked while the rows stay where they are
+  if (on_off && EvictionEnabled() && sm_ != nullptr) {
+    WakeDemoter(false);
+  }
+}
+
+uint64_t CachePool::BeginFetch() {
+  if (!EvictionEnabled()) {
+    return 0;
+  }
+  std::unique_lock<std::mutex> lck(retire_mux_);
+  active_fetches_.insert(epoch_);
+  return epoch_;
+}
+
+void CachePool::EndFetch(uint64_t ticket) {
+  if (!EvictionEnabled()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lck(retire_mux_);
+  auto it = active_fetches_.find(ticket);
+  if (it != active_fetches_.end()) {
+    active_fetches_.erase(it);
+  }
+  ReclaimLocked();
+}
+
+CacheEvictor *CachePool::MemEvictor(numa_id_t node_id) const {
+  if (node_id < 0 || node_id >= static_cast<numa_id_t>(mem_evictors_.size())) {
+    node_id = 0;
+  }
+  return mem_evictors_[node_id].get();
+}
+
+bool CachePool::MemoryAbove(float ratio) const {
+  if (mem_capacity_ > 0 && mem_usage_ > static_cast<uint64_t>(mem_capacity_ * ratio)) {
+    return true;
+  }
+  return quota_ != nullptr && quota_->GetMemoryLimit() > 0 &&
+         quota_->GetMemoryUsage() > static_cast<uint64_t>(quota_->GetMemoryLimit() * ratio);
+}
+
+void CachePool::WakeDemoter(bool request) {
+  {
+    std::unique_lock<std::mutex> lck(demote_mux_);
+    demote_request_ = demote_request_ || request;
+    demote_stalled_ = false;
+  }
+  demote_cv_.NotifyOne();
+}
+
+Status CachePool::Demoter() {
+  TaskManager::FindMe()->Post();
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lck(demote_mux_);
+      // No row moves while locking is off, and after a round which could not move any row (nothing left in the
+      // memory, or the disk is full) the demoter waits to be woken again instead of retrying in a loop
+      RETURN_IF_NOT_OK(demote_cv_.Wait(&lck, [this]() {
+        return evict_enabled_ && (demote_request_ || (!demote_stalled_ && MemoryAbove(kHighWatermark)));
+      }));
+      demote_request_ = false;
+    }
+    // Some room is made at least after a failed allocation, then rows keep moving down to the low watermark
+    auto min_bytes = static_cast<uint64_t>(mem_capacity_ * kMinDemoteRatio);
+    uint64_t demoted = 0;
+    size_t sz = 0;
+    do {
+      RETURN_IF_INTERRUPTED();
+      RETURN_IF_NOT_OK(DemoteOne(&sz));
+      demoted += sz;
+    } while (sz > 0 && (demoted < min_bytes || MemoryAbove(kLowWatermark)));
+    if (demoted == 0) {
+      std::unique_lock<std::mutex> lck(demote_mux_);
+      demote_stalled_ = true;
+    }
+  }
+}
+
+Status CachePool::DemoteOne(size_t *sz) {
+  *sz = 0;
+  if (!evict_enabled_) {
+    return Status::OK();
+  }
+  // Take the row from the node using the most memory
+  numa_id_t node_id = -1;
+  key_type key = 0;
+  std::vector<numa_id_t> nodes(mem_evictors_.size());
+  std::iota(nodes.begin(), nodes.end(), 0);
+  std::sort(nodes.begin(), nodes.end(),
+            [this](numa_id_t a, numa_id_t b) { return node_mem_usage_[a] > node_mem_usage_[b]; });
+  for (auto node : nodes) {
+    if (mem_evictors_[node]->Evict(&key)) {
+      node_id = node;
+      break;
+    }
+  }
+  if (node_id == -1) {
+    return Status::OK();
+  }
+  // The space of the row may be retired by a concurrent Readmit while it is copied, so hold it like a fetch
+  auto ticket = BeginFetch();
+  DataLocator cur;
+  {
+    auto r = tree_->Search(key);
+    if (r.second) {
+      cur = *r.first;
+    }
+  }
+  if (cur.ptr == nullptr) {
+    // Not in the memory any more
+    EndFetch(ticket);
+    *sz = 1;
+    return Status::OK();
+  }
+  DataLocator bl;
+  bl.sz = cur.sz;
+  bl.raw_sz = cur.raw_sz;
+  bl.node_id = cur.node_id;
+  Status rc = WriteToDisk({ReadableSlice(cur.ptr, cur.sz)}, &bl);
+  EndFetch(ticket);
+  if (rc == StatusCode::kMDNoSpace) {
+    // The disk is full too, leave the row where it is
+    MemEvictor(node_id)->Add(key);
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(rc);
+  std::unique_ptr<DataLocator> old;
+  bool unchanged = false;
+  {
+    std::unique_lock<std::mutex> lck(update_mux_);
+    {
+      auto r = tree_->Search(key);
+      unchanged = r.second && r.first->ptr == cur.ptr;
+    }
+    if (unchanged && evict_enabled_) {
+      old = tree_->DoUpdate(key, bl);
+    }
+  }
+  if (old == nullptr) {
+    if (quota_ != nullptr) {
+      quota_->ReleaseDisk(bl.sz);
+    }
+    FreeLocator(bl);
+    // Locking was turned off meanwhile, the row stays in the memory and can still be moved later
+    if (unchanged) {
+      MemEvictor(node_id)->Add(key);
+    }
+    return Status::OK();
+  }
+  Track(key, bl);
+  Retire(key, std::move(*old));
+  *sz = cur.sz;
+  return Status::OK();
+}
+
+Status CachePool::DropOne(bool *dropped) {
+  *dropped = false;
+  key_type key = 0;
+  while (disk_evictor_->Evict(&key)) {
+    std::unique_ptr<DataLocator> old;
+    {
+      std::unique_lock<std::mutex> lck(update_mux_);
+      if (!evict_enabled_) {
+        disk_evictor_->Add(key);
+        return Status::OK();
+      }
+      bool on_disk = false;
+      {
+        auto r = tree_->Search(key);
+        on_disk = r.second && r.first->ptr == nullptr && r.first->sz > 0;
+      }
+      if (on_disk) {
+        old = tree_->DoUpdate(key, DataLocator());
+      }
+    }
+    // Skip a row no longer on the disk
+    if (old != nullptr) {
+      ++num_evicted_;
+      Retire(key, std::move(*old));
+      *dropped = true;
+      return Status::OK();
+    }
+  }
+  return Status::OK();
+}
+
+Status CachePool::WriteToDisk(const std::vector<ReadableSlice> &buf, DataLocator *bl) {
+  int32_t num_drops = 0;
+  while (true) {
+    Status rc;
+    if (quota_ != nullptr && !quota_->ReserveDisk(bl->sz)) {
+      rc = STATUS_ERROR(StatusCode::kMDNoSpace, "Out of the disk quota of the session.");
+    } else {
+      rc = sm_->Write(&bl->storage_key, buf);
+      if (rc.IsError() && quota_ != nullptr) {
+        quota_->ReleaseDisk(bl->sz);
+      }
+    }
+    if (rc != StatusCode::kMDNoSpace || !EvictionEnabled() || !drop_allowed_ || num_drops >= kMaxDropsPerWrite) {
+      return rc;
+    }
+    bool dropped = false;
+    RETURN_IF_NOT_OK(DropOne(&dropped));
+    if (!dropped) {
+      return rc;
+    }
+    ++num_drops;
+  }
+}
+
+Status CachePool::Readmit(key_type key, const DataLocator &bl) {
+  std::unique_lock<std::mutex> lck(update_mux_);
+  bool dropped = false;
+  {
+    auto r = tree_->Search(key);
+    dropped = r.second && r.first->sz == 0;
+  }
+  if (!dropped) {
+    return Status(StatusCode::kMDDuplicateKey);
+  }
+  (void)tree_->DoUpdate(key, bl);
+  --num_evicted_;
+  return Status::OK();
+}
+
+void CachePool::Track(key_type key, const DataLocator &bl) {
+  if (bl.ptr != nullptr) {
+    mem_usage_ += bl.sz;
+    node_mem_usage_[mem_evictors_.size() > static_cast<size_t>(bl.node_id) ? bl.node_id : 0] += bl.sz;
+    MemEvictor(bl.node_id)->Add(key);
+  } else {
+    disk_evictor_->Add(key);
+  }
+}
+
+void CachePool::Retire(key_type key, DataLocator &&bl) {
+  if (bl.ptr != nullptr) {
+    mem_usage_ -= bl.sz;
+    node_mem_usage_[mem_evictors_.size() > static_cast<size_t>(bl.node_id) ? bl.node_id : 0] -= bl.sz;
+    if (quota_ != nullptr) {
+      quota_->ReleaseMemory(bl.sz);
+    }
+  } else if (quota_ != nullptr) {
+    quota_->ReleaseDisk(bl.sz);
+  }
+  std::unique_lock<std::mutex> lck(retire_mux_);
+  retired_.push_back({epoch_, key, std::move(bl)});
+  ++epoch_;
+  ReclaimLocked();
+}
+
+void CachePool::ReclaimLocked() {
+  // A fetch sees the rows retired at or after its ticket
+  while (!retired_.empty() && (active_fetches_.empty() || retired_.front().epoch < *active_fetches_.begin())) {
+    FreeLocator(retired_.front().locator);
+    retired_.pop_front();
+  }
+}
+
+void CachePool::FreeLocator(const DataLocator &bl) {
+  if (bl.ptr != nullptr) {
+    mp_->Deallocate(bl.ptr);
+  } else if (bl.sz > 0 && sm_ != nullptr) {
+    Status rc = sm_->Free(bl.storage_key);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to free the disk space of a row: " << rc.ToString();
+    }
+  }
+}
 }  // namespace dataset
 }  // namespace mindspore
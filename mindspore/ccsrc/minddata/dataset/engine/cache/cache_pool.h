@@ -16,25 +16,43 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 #include "minddata/dataset/engine/cache/cache_common.h"
+#include "minddata/dataset/engine/cache/cache_compression.h"
+#include "minddata/dataset/engine/cache/cache_eviction.h"
 #include "minddata/dataset/engine/cache/cache_numa.h"
 #include "minddata/dataset/engine/cache/storage_manager.h"
 #include "minddata/dataset/util/allocator.h"
+#include "minddata/dataset/util/cond_var.h"
 #include "minddata/dataset/util/service.h"
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/auto_index.h"
 #include "minddata/dataset/util/btree.h"
+#include "minddata/dataset/util/task_manager.h"
 
 namespace mindspore {
 namespace dataset {
 /// \brief A CachePool provides service for backup/restore a buffer. A buffer can be represented in a form of vector of
 /// ReadableSlice where all memory blocks will be copied to one contiguous block which can be in memory or spilled to
 /// disk (if a disk directory is provided). User must provide a key to insert the buffer.
+///
+/// With an eviction policy, the memory and the disk are two tiers rather than a memory which overflows to the disk:
+///   - a thread in the background moves the rows picked by the policy from the memory to the disk, once the memory
+///     used goes above a high watermark, down to a low watermark. Each numa node has its own policy so that the rows
+///     move out of the busiest node.
+///   - when the disk is full, the rows picked by the policy are dropped, if dropping is allowed. A dropped row keeps
+///     its key with an empty locator, it is a cache miss and can be inserted again.
+/// A fetch copies a row from the locator returned by GetDataLocator, so the space of a row moved out of a tier is
+/// only given back once all the fetches started before the move are done.
+///
+/// With a compression, a row is compressed before it goes to a tier, and decompressed by Read. The locator of a
+/// compressed row gives the size of the row before compression and no address, so it is always fetched through Read.
 /// \see ReadableSlice
 class CachePool : public Service {
  public:
@@ -48,35 +66,40 @@ class CachePool : public Service {
   // An internal class to locate the whereabouts of a backed up buffer which can be either in
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), node_id(0), node_hit(false), storage_key(0) {}
+    DataLocator() : ptr(nullptr), sz(0), raw_sz(0), node_id(0), node_hit(false), storage_key(0) {}
     ~DataLocator() = default;
     DataLocator(const DataLocator &other) = default;
     DataLocator &operator=(const DataLocator &other) = default;
     DataLocator(DataLocator &&other) noexcept {
       ptr = other.ptr;
       sz = other.sz;
+      raw_sz = other.raw_sz;
       node_id = other.node_id;
       node_hit = other.node_hit;
       storage_key = other.storage_key;
       other.ptr = nullptr;
       other.sz = 0;
+      other.raw_sz = 0;
       other.storage_key = 0;
     }
     DataLocator &operator=(DataLocator &&other) noexcept {
       if (&other != this) {
         ptr = other.ptr;
         sz = other.sz;
+        raw_sz = other.raw_sz;
         node_id = other.node_id;
         node_hit = other.node_hit;
         storage_key = other.storage_key;
         other.ptr = nullptr;
         other.sz = 0;
+        other.raw_sz = 0;
         other.storage_key = 0;
       }
       return *this;
     }
     pointer ptr;
     size_t sz;
+    size_t raw_sz;      // size before compression, 0 if the row is not compressed
     numa_id_t node_id;  // where the numa node the memory is allocated to
     bool node_hit;      // we can allocate to the preferred node
     StorageManager::key_type storage_key;
@@ -95,13 +118,25 @@ class CachePool : public Service {
     int64_t num_disk_cached;
     int64_t average_cache_sz;
     int64_t num_numa_hit;
+    int64_t num_evicted;
+    int64_t raw_sz;          // total size of the rows before compression
+    int64_t stored_sz;       // total size of the rows as stored
+    int64_t num_decoded;     // number of rows decompressed
+    int64_t decode_time_us;  // time spent decompressing them
     std::vector<key_type> gap;
   };
 
   /// \brief Constructor
   /// \param alloc Allocator to allocate memory from
   /// \param root Optional disk folder to spill
-  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "");
+  /// \param policy How the rows to move out of a full tier are picked. kNone to never move rows.
+  /// \param drop_allowed If rows can be dropped from the disk, which is only right when they can be produced again
+  /// \param quota Optional quota of the session, shared with the other caches of the session
+  /// \param compression How the rows are compressed
+  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "",
+                     CacheEvictionPolicy policy = CacheEvictionPolicy::kNone, bool drop_allowed = false,
+                     std::shared_ptr<CacheQuota> quota = nullptr,
+                     CacheCompression compression = CacheCompression::kNone);
 
   CachePool(const CachePool &) = delete;
   CachePool(CachePool &&) = delete;
@@ -118,9 +153,9 @@ class CachePool : public Service {
   /// All memory blocks will be consolidated into one contiguous block and be cached in either memory or on disk.
   /// \param[in] key User supplied key
   /// \param[in] buf A sequence of ReadableSlice objects.
-  /// \param[in] writeToDiskDirectly If true, no spill to disk if spill is enabled, or return no memory
+  /// \param[in] delta_stride Stride of the delta filter applied before the compression, 0 for no filter
   /// \return Error code
-  Status Insert(CachePool::key_type key, const std::vector<ReadableSlice> &buf);
+  Status Insert(CachePool::key_type key, const std::vector<ReadableSlice> &buf, int32_t delta_stride = 0);
 
   /// \brief Restore a cached buffer (from memory or disk)
   /// \param[in] key A previous key returned from Insert
@@ -133,6 +168,15 @@ class CachePool : public Service {
   Status GetDataLocator(key_type, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &,
                         flatbuffers::Offset<DataLocatorMsg> *) const;
 
+  /// \brief Start a fetch of rows located by GetDataLocator. The rows moved out of a tier from now on keep their
+  /// space until EndFetch.
+  /// \return Ticket of the fetch
+  uint64_t BeginFetch();
+
+  /// \brief End a fetch
+  /// \param ticket The ticket returned by BeginFetch
+  void EndFetch(uint64_t ticket);
+
   /// \brief Get statistics.
   /// \return CacheStat object
   CacheStat GetStat(bool GetMissingKeys = false) const;
@@ -140,10 +184,18 @@ class CachePool : public Service {
   std::string MyName() const { return subfolder_; }
 
   /// \brief Toggle locking
-  /// \note Once locking is off. It is user's responsibility to ensure concurrency
-  void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
+  /// \note Once locking is off. It is user's responsibility to ensure concurrency. No row moves out of a tier
+  /// while locking is off.
+  void SetLocking(bool on_off);
 
  private:
+  // A row moved out of a tier, whose space is given back once the fetches which may read it are done
+  struct RetiredRow {
+    uint64_t epoch;
+    key_type key;
+    DataLocator locator;
+  };
+
   std::shared_ptr<NumaMemoryPool> mp_;
   Path root_;
   const std::string subfolder_;
@@ -154,6 +206,80 @@ class CachePool : public Service {
                                           // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
   uint64_t min_avail_mem_;                // lower bound of the available memory
   const int kMemoryCapAdjustInterval = 104857600;
+
+  // The tiers
+  CacheEvictionPolicy policy_;
+  bool drop_allowed_;
+  std::shared_ptr<CacheQuota> quota_;
+  CacheCompression compression_;
+  mutable std::atomic<int64_t> num_decoded_;
+  mutable std::atomic<int64_t> decode_time_ns_;
+  std::vector<std::unique_ptr<CacheEvictor>> mem_evictors_;  // one per numa node
+  std::unique_ptr<CacheEvictor> disk_evictor_;
+  std::unique_ptr<std::atomic<int64_t>[]> node_mem_usage_;
+  std::atomic<uint64_t> mem_usage_;
+  std::atomic<int64_t> num_evicted_;
+  uint64_t mem_capacity_;
+  std::mutex update_mux_;  // serializes the moves of rows between the tiers
+  std::atomic<bool> evict_enabled_;
+  TaskGroup vg_;
+  std::mutex demote_mux_;
+  CondVar demote_cv_;
+  bool demote_request_;
+  bool demote_stalled_;  // the last round moved no row, wait for a new wake up rather than retry at once
+  // The rows moved out of a tier
+  mutable std::mutex retire_mux_;
+  uint64_t epoch_;
+  std::multiset<uint64_t> active_fetches_;
+  std::deque<RetiredRow> retired_;
+
+  bool EvictionEnabled() const { return policy_ != CacheEvictionPolicy::kNone; }
+
+  /// \brief The evictor of the memory tier of a numa node
+  CacheEvictor *MemEvictor(numa_id_t node_id) const;
+
+  /// \brief If the memory used is above a ratio of the capacity, of the pool or of the quota of the session
+  bool MemoryAbove(float ratio) const;
+
+  /// \brief Wake the thread which moves rows to the disk
+  /// \param request True if an allocation failed, so some rows are moved even below the high watermark
+  void WakeDemoter(bool request);
+
+  /// \brief Body of the thread which moves rows to the disk
+  Status Demoter();
+
+  /// \brief Move one row from the memory to the disk
+  /// \param[out] sz Size of the row moved, 0 if none. A row which could not be moved is given back to its evictor.
+  Status DemoteOne(size_t *sz);
+
+  /// \brief Drop one row from the disk
+  /// \param[out] dropped False if there is no row to drop
+  Status DropOne(bool *dropped);
+
+  /// \brief Store a row in the memory or the disk
+  /// \param raw_sz Size of the row before compression, 0 if the row is not compressed
+  Status Store(key_type key, const std::vector<ReadableSlice> &buf, size_t raw_sz);
+
+  /// \brief Copy a row out of its locator, decompressing it if needed
+  Status ReadLocator(key_type key, const DataLocator &bl, WritableSlice *dest, size_t *bytesRead) const;
+
+  /// \brief Write a buffer to the disk, dropping rows to make room when it is allowed
+  Status WriteToDisk(const std::vector<ReadableSlice> &buf, DataLocator *bl);
+
+  /// \brief Insert again a row which was dropped
+  Status Readmit(key_type key, const DataLocator &bl);
+
+  /// \brief Record a row in its tier
+  void Track(key_type key, const DataLocator &bl);
+
+  /// \brief Take a row moved out of its tier away from the usage, and give its space back when it is safe
+  void Retire(key_type key, DataLocator &&bl);
+
+  /// \brief Give back the space of the retired rows no fetch can read any more
+  void ReclaimLocked();
+
+  /// \brief Give back the space of a row
+  void FreeLocator(const DataLocator &bl);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -153,27 +153,43 @@ BatchFetchRequest::BatchFetchRequest(const CacheClient *cc, const std::vector<ro
   rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
 }
 
+bool BatchFetchRequest::DataInSharedMemory(int64_t *addr) const {
+  // Tap into the reply flag to see where we can find the data. Server may decide the amount is
+  // so small that it doesn't use shared memory method.
+  if (!support_local_bypass_ || !BitTest(reply_.flag(), kDataIsInSharedMemory)) {
+    return false;
+  }
+  *addr = strtoll(reply_.result().data(), nullptr, kDecimal);
+  return true;
+}
+
 Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr) {
   RETURN_UNEXPECTED_IF_NULL(out);
-  auto num_elements = row_id_.size();
+  RETURN_UNEXPECTED_IF_NULL(out_addr);
   const char *ptr = nullptr;
-  int64_t sz = 0;
-  // Tap into the reply flag to see where we can find the data. Server may decide the amount is
-  // so small that it doesn't use shared memory method.
-  auto flag = reply_.flag();
-  bool dataOnSharedMemory = support_local_bypass_ ? (BitTest(flag, kDataIsInSharedMemory)) : false;
-  if (dataOnSharedMemory) {
-    auto addr = strtoll(reply_.result().data(), nullptr, kDecimal);
+  int64_t addr = -1;
+  if (DataInSharedMemory(&addr)) {
     ptr = reinterpret_cast<const char *>(reinterpret_cast<int64_t>(baseAddr) + addr);
-    RETURN_UNEXPECTED_IF_NULL(out);
-    *out_addr = addr;
   } else {
     ptr = reply_.result().data();
-    *out_addr = -1;
+    auto *offset_array = reinterpret_cast<const int64_t *>(ptr);
+    CHECK_FAIL_RETURN_UNEXPECTED(offset_array[row_id_.size()] == reply_.result().length(), "Length mismatch");
   }
+  *out_addr = addr;
+  return ParseRows(ptr, nullptr, out);
+}
+
+Status BatchFetchRequest::RestoreRowsInPlace(TensorTable *out, const void *ptr,
+                                             const std::shared_ptr<const void> &lease) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  RETURN_UNEXPECTED_IF_NULL(ptr);
+  return ParseRows(static_cast<const char *>(ptr), lease, out);
+}
+
+Status BatchFetchRequest::ParseRows(const char *ptr, const std::shared_ptr<const void> &lease, TensorTable *out) {
+  auto num_elements = row_id_.size();
   auto *offset_array = reinterpret_cast<const int64_t *>(ptr);
-  sz = offset_array[num_elements];
-  CHECK_FAIL_RETURN_UNEXPECTED(support_local_bypass_ || sz == reply_.result().length(), "Length mismatch");
+  int64_t sz = offset_array[num_elements];
   TensorTable tbl;
   tbl.reserve(num_elements);
   ReadableSlice all(ptr, sz);
@@ -193,7 +209,7 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
         auto col_ts = msg->column()->Get(k);
         std::shared_ptr<Tensor> ts;
         ReadableSlice data(row_data, ts_offset, msg->data_sz()->Get(k));
-        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts));
+        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts, lease));
         row.push_back(ts);
         ts_offset += data.GetSize();
       }
@@ -304,6 +320,10 @@ Status GetStatRequest::PostReply() {
   stat_.max_row_id = msg->max_row_id();
   stat_.min_row_id = msg->min_row_id();
   stat_.cache_service_state = msg->state();
+  stat_.raw_sz = msg->raw_sz();
+  stat_.stored_sz = msg->stored_sz();
+  stat_.num_decoded = msg->num_decoded();
+  stat_.decode_time_us = msg->decode_time_us();
   return Status::OK();
 }
 
@@ -332,6 +352,10 @@ Status ListSessionsRequest::PostReply() {
     stats.min_row_id = current_session_info->stats()->min_row_id();
     stats.max_row_id = current_session_info->stats()->max_row_id();
     stats.cache_service_state = current_session_info->stats()->state();
+    stats.raw_sz = current_session_info->stats()->raw_sz();
+    stats.stored_sz = current_session_info->stats()->stored_sz();
+    stats.num_decoded = current_session_info->stats()->num_decoded();
+    stats.decode_time_us = current_session_info->stats()->decode_time_us();
     current_info.stats = stats;  // fixed length struct.  = operator is safe
     session_info_list_.push_back(current_info);
   }
@@ -45,6 +45,10 @@ struct CacheServiceStat {
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
+  int64_t raw_sz;          // total size of the rows before compression
+  int64_t stored_sz;       // total size of the rows as stored
+  int64_t num_decoded;     // number of rows decompressed
+  int64_t decode_time_us;  // time spent decompressing them
 };
 
 struct CacheServerCfgInfo {
@@ -87,6 +91,7 @@ class BaseRequest {
     kBatchCacheRows = 19,
     kInternalCacheRow = 20,
     kGetCacheState = 21,
+    kRegisterFetchRing = 22,
     // Add new request before it.
     kRequestUnknown = 32767
   };
@@ -148,7 +153,8 @@ class BaseRequest {
            type_ == RequestType::kCacheSchema || type_ == RequestType::kFetchSchema ||
            type_ == RequestType::kBuildPhaseDone || type_ == RequestType::kToggleWriteMode ||
            type_ == RequestType::kConnectReset || type_ == RequestType::kStopService ||
-           type_ == RequestType::kHeartBeat || type_ == RequestType::kGetCacheMissKeys;
+           type_ == RequestType::kHeartBeat || type_ == RequestType::kGetCacheMissKeys ||
+           type_ == RequestType::kRegisterFetchRing;
   }
 
   /// \brief Return if the request is of session request type
@@ -235,7 +241,25 @@ class BatchFetchRequest : public BaseRequest {
   ~BatchFetchRequest() override = default;
   Status RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr);
 
+  /// \brief Restore the rows from a block of the shared memory without copying the numeric tensors
+  /// \param[out] out The rows
+  /// \param[in] ptr Start of the block
+  /// \param[in] lease Keeps the block alive. The numeric tensors reference the block and hold the lease, the other
+  /// tensors are copied out.
+  /// \return Status object
+  Status RestoreRowsInPlace(TensorTable *out, const void *ptr, const std::shared_ptr<const void> &lease);
+
+  /// \brief Check where the server put the rows
+  /// \param[out] addr Offset of the shared memory block holding the rows
+  /// \return False if the rows are in the reply
+  bool DataInSharedMemory(int64_t *addr) const;
+
+  /// \brief The serialized row ids, which a fetch ring sends in place of this request
+  const std::string &GetRowIdsPayload() const { return rq_.buf_data(0); }
+
  private:
+  Status ParseRows(const char *ptr, const std::shared_ptr<const void> &lease, TensorTable *out);
+
   bool support_local_bypass_;
   std::vector<row_id_type> row_id_;
 };
@@ -384,10 +408,15 @@ class DropSessionRequest : public BaseRequest {
 class GenerateSessionIdRequest : public BaseRequest {
  public:
   friend class CacheServer;
-  GenerateSessionIdRequest() : BaseRequest(RequestType::kGenerateSessionId) {
+  /// \param compression Optional. Name of the codec compressing the rows of the caches of the session
+  explicit GenerateSessionIdRequest(const std::string &compression = "")
+      : BaseRequest(RequestType::kGenerateSessionId) {
     // We don't have anything client info nor connection id to send. But we will manually
     // set the connection id to 0.
     rq_.set_connection_id(0);
+    if (!compression.empty()) {
+      rq_.add_buf_data(compression);
+    }
   }
 
   ~GenerateSessionIdRequest() override = default;
@@ -431,6 +460,27 @@ class ListSessionsRequest : public BaseRequest {
   CacheServerCfgInfo server_cfg_{};
 };
 
+/// \brief Request to start polling a fetch ring placed by the client in a block of the shared memory
+/// \see CacheFetchRing
+class RegisterFetchRingRequest : public BaseRequest {
+ public:
+  friend class CacheServer;
+  /// \brief Constructor
+  /// \param connection_id
+  /// \param client_id
+  /// \param addr Offset of the ring in the shared memory
+  /// \param num_pollers Number of server threads polling the ring
+  explicit RegisterFetchRingRequest(connection_id_type connection_id, int32_t client_id, int64_t addr,
+                                    int32_t num_pollers)
+      : BaseRequest(RequestType::kRegisterFetchRing) {
+    rq_.set_connection_id(connection_id);
+    rq_.add_buf_data(std::to_string(addr));
+    rq_.add_buf_data(std::to_string(num_pollers));
+    rq_.set_client_id(client_id);
+  }
+  ~RegisterFetchRingRequest() override = default;
+};
+
 class AllocateSharedBlockRequest : public BaseRequest {
  public:
   friend class CacheServer;
@@ -19,6 +19,7 @@
 #include <limits>
 #include <vector>
 #include "minddata/dataset/include/dataset/constants.h"
+#include "minddata/dataset/engine/cache/cache_fetch_ring.h"
 #include "minddata/dataset/engine/cache/cache_ipc.h"
 #include "minddata/dataset/engine/cache/cache_service.h"
 #include "minddata/dataset/engine/cache/cache_request.h"
@@ -234,7 +235,20 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
     RETURN_IF_NOT_OK(GlobalMemoryCheck(cache_mem_sz));
     std::unique_ptr<CacheService> cs;
     try {
-      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id);
+      // All the caches of a session share its quota. We are still holding the session lock.
+      std::shared_ptr<CacheQuota> quota;
+      if (session_mem_quota_ > 0 || session_disk_quota_ > 0) {
+        auto &q = session_quotas_[session_id];
+        if (q == nullptr) {
+          q = std::make_shared<CacheQuota>(session_mem_quota_, session_disk_quota_);
+        }
+        quota = q;
+      }
+      auto compression_it = session_compressions_.find(session_id);
+      auto compression =
+        compression_it != session_compressions_.end() ? compression_it->second : CacheCompression::kNone;
+      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id, eviction_policy_, quota,
+                                          compression);
       RETURN_IF_NOT_OK(cs->ServiceStart());
       cookie = cs->cookie();
       client_id = cs->num_clients_.fetch_add(1);
@@ -503,10 +517,19 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
       row_id.push_back(p->row_id()->Get(i));
     }
     std::shared_ptr<flatbuffers::FlatBufferBuilder> fbb = std::make_shared<flatbuffers::FlatBufferBuilder>();
-    RETURN_IF_NOT_OK(cs->PreBatchFetch(connection_id, row_id, fbb));
+    uint64_t ticket = 0;
+    RETURN_IF_NOT_OK(cs->PreBatchFetch(connection_id, row_id, fbb, &ticket));
     // Let go of the shared lock. We don't need to interact with the CacheService anymore.
     // We shouldn't be holding any lock while we can wait for a long time for the rows to come back.
     lck.Unlock();
+    // Rows moved out of a tier in the meantime keep their space until all of them are copied.
+    auto end_fetch = [this, connection_id, ticket]() {
+      SharedLock end_lck(&rwLock_);
+      CacheService *svc = GetService(connection_id);
+      if (svc != nullptr) {
+        svc->EndBatchFetch(ticket);
+      }
+    };
     auto locator = flatbuffers::GetRoot<BatchDataLocatorMsg>(fbb->GetBufferPointer());
     int64_t mem_sz = sizeof(int64_t) * (sz + 1);
     for (auto i = 0; i < sz; ++i) {
@@ -520,17 +543,30 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
     }
     auto client_flag = rq->flag();
     bool local_client = BitTest(client_flag, kLocalClientSupport);
+    bool to_shared_memory = BitTest(client_flag, kFetchToSharedMemory);
     // For large amount data to be sent back, we will use shared memory provided it is a local
     // client that has local bypass support
-    bool local_bypass = local_client ? (mem_sz >= kLocalByPassThreshold) : false;
+    bool local_bypass = local_client ? (to_shared_memory || mem_sz >= kLocalByPassThreshold) : false;
+    void *q = nullptr;
+    if (local_bypass) {
+      Status rc = AllocateSharedMemory(client_id, mem_sz, &q);
+      if (rc.IsError()) {
+        // The blocks still referenced by the tensors of a client may be holding the shared memory. Unless the client
+        // can only take the rows in shared memory, send them in the reply instead.
+        if (to_shared_memory || rc.StatusCode() != StatusCode::kMDOutOfMemory) {
+          end_fetch();
+          return rc;
+        }
+        local_bypass = false;
+      }
+    }
     reply->set_flag(local_bypass ? kDataIsInSharedMemory : 0);
     if (local_bypass) {
       // We will use shared memory
       auto *base = SharedMemoryBaseAddr();
-      void *q = nullptr;
-      RETURN_IF_NOT_OK(AllocateSharedMemory(client_id, mem_sz, &q));
       WritableSlice dest(q, mem_sz);
-      Status rc = BatchFetch(fbb, &dest);
+      rc = BatchFetch(fbb, &dest);
+      end_fetch();
       if (rc.IsError()) {
         DeallocateSharedMemory(client_id, q);
         return rc;
@@ -546,12 +582,18 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
       std::string mem;
       try {
         mem.resize(mem_sz);
-        CHECK_FAIL_RETURN_UNEXPECTED(mem.capacity() >= mem_sz, "Programming error");
       } catch (const std::bad_alloc &e) {
+        end_fetch();
         RETURN_STATUS_OOM("Out of memory.");
       }
+      if (mem.capacity() < mem_sz) {
+        end_fetch();
+        RETURN_STATUS_UNEXPECTED("Programming error");
+      }
       WritableSlice dest(mem.data(), mem_sz);
-      RETURN_IF_NOT_OK(BatchFetch(fbb, &dest));
+      Status rc = BatchFetch(fbb, &dest);
+      end_fetch();
+      RETURN_IF_NOT_OK(rc);
       reply->set_result(std::move(mem));
     }
   }
@@ -578,6 +620,10 @@ Status CacheServer::GetStat(CacheRequest *rq, CacheReply *reply) {
     bld.add_max_row_id(svc_stat.stat_.max_key);
     bld.add_min_row_id(svc_stat.stat_.min_key);
     bld.add_state(svc_stat.state_);
+    bld.add_raw_sz(svc_stat.stat_.raw_sz);
+    bld.add_stored_sz(svc_stat.stat_.stored_sz);
+    bld.add_num_decoded(svc_stat.stat_.num_decoded);
+    bld.add_decode_time_us(svc_stat.stat_.decode_time_us);
     auto offset = bld.Finish();
     fbb.Finish(offset);
     reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
@@ -709,9 +755,10 @@ Status CacheServer::ListSessions(CacheReply *reply) {
         auto &cs = it.second;
         CacheService::ServiceStat svc_stat;
         RETURN_IF_NOT_OK(cs->GetStat(&svc_stat));
-        auto current_stats = CreateServiceStatMsg(fbb, svc_stat.stat_.num_mem_cached, svc_stat.stat_.num_disk_cached,
-                                                  svc_stat.stat_.average_cache_sz, svc_stat.stat_.num_numa_hit,
-                                                  svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_);
+        auto current_stats = CreateServiceStatMsg(
+          fbb, svc_stat.stat_.num_mem_cached, svc_stat.stat_.num_disk_cached, svc_stat.stat_.average_cache_sz,
+          svc_stat.stat_.num_numa_hit, svc_stat.stat_.min_key, svc_stat.stat_.max_key, svc_stat.state_,
+          svc_stat.stat_.raw_sz, svc_stat.stat_.stored_sz, svc_stat.stat_.num_decoded, svc_stat.stat_.decode_time_us);
         auto current_session_info = CreateListSessionMsg(fbb, current_session_id, current_conn_id, current_stats);
         session_msgs_vector.push_back(current_session_info);
       }
@@ -850,7 +897,15 @@ Status CacheServer::ProcessSessionRequest(CacheServerRequest *cache_req) {
       break;
     }
     case BaseRequest::RequestType::kGenerateSessionId: {
-      cache_req->rc_ = GenerateClientSessionID(GenerateSessionID(), &reply);
+      // The compression of the caches of the session is optional
+      auto compression = CacheCompression::kNone;
+      if (!rq.buf_data().empty()) {
+        cache_req->rc_ = StringToCacheCompression(rq.buf_data(0), &compression);
+        if (cache_req->rc_.IsError()) {
+          break;
+        }
+      }
+      cache_req->rc_ = GenerateClientSessionID(GenerateSessionID(compression), &reply);
       break;
     }
     case BaseRequest::RequestType::kListSessions: {
@@ -928,6 +983,10 @@ Status CacheServer::ProcessAdminRequest(CacheServerRequest *cache_req) {
       cache_req->rc_ = GetCacheState(&rq, &reply);
       break;
     }
+    case BaseRequest::RequestType::kRegisterFetchRing: {
+      cache_req->rc_ = RegisterFetchRing(&rq);
+      break;
+    }
     default:
       std::string errMsg("Internal error, request type is not admin request: ");
       errMsg += std::to_string(static_cast<uint16_t>(cache_req->type_));
@@ -994,6 +1053,7 @@ session_id_type CacheServer::GetSessionID(connection_id_type connection_id) cons
 
 CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port,
                          int32_t shared_meory_sz_in_gb, float memory_cap_ratio, int8_t log_level,
+                         CacheEvictionPolicy eviction_policy, int32_t session_mem_quota, int32_t session_disk_quota,
                          std::shared_ptr<CacheServerHW> hw_info)
     : top_(spill_path),
       num_workers_(num_workers),
@@ -1002,6 +1062,9 @@ CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int
       shared_memory_sz_in_gb_(shared_meory_sz_in_gb),
       global_shutdown_(false),
       memory_cap_ratio_(memory_cap_ratio),
+      eviction_policy_(eviction_policy),
+      session_mem_quota_(static_cast<uint64_t>(session_mem_quota) * 1048576L),  // quota is in MB unit
+      session_disk_quota_(static_cast<uint64_t>(session_disk_quota) * 1048576L),
       numa_affinity_(true),
       log_level_(log_level),
       hw_info_(std::move(hw_info)) {
@@ -1080,6 +1143,8 @@ Status CacheServer::DestroySession(CacheRequest *rq) {
     }
   }
   // Finally remove the session itself
+  (void)session_quotas_.erase(drop_session_id);
+  (void)session_compressions_.erase(drop_session_id);
   auto n = active_sessions_.erase(drop_session_id);
   if (n > 0) {
     MS_LOG(INFO) << "Session destroyed with id " << drop_session_id;
@@ -1097,7 +1162,7 @@ Status CacheServer::DestroySession(CacheRequest *rq) {
   }
 }
 
-session_id_type CacheServer::GenerateSessionID() {
+session_id_type CacheServer::GenerateSessionID(CacheCompression compression) {
   UniqueLock sess_lck(&sessions_lock_);
   auto mt = GetRandomDevice();
   std::uniform_int_distribution<session_id_type> distribution(0, std::numeric_limits<session_id_type>::max());
@@ -1108,6 +1173,9 @@ session_id_type CacheServer::GenerateSessionID() {
     auto r = active_sessions_.insert(session_id);
     duplicate = !r.second;
   } while (duplicate);
+  if (compression != CacheCompression::kNone) {
+    session_compressions_[session_id] = compression;
+  }
   return session_id;
 }
 
@@ -1143,6 +1211,81 @@ Status CacheServer::FreeSharedMemory(CacheRequest *rq) {
   return Status::OK();
 }
 
+Status CacheServer::RegisterFetchRing(CacheRequest *rq) {
+  auto client_id = rq->client_id();
+  auto connection_id = rq->connection_id();
+  CHECK_FAIL_RETURN_UNEXPECTED(client_id != -1, "Client ID not set");
+  constexpr int32_t kExpectedBufDataSize = 2;
+  CHECK_FAIL_RETURN_UNEXPECTED(rq->buf_data().size() == kExpectedBufDataSize, "Expect two pieces of data");
+  {
+    SharedLock lck(&rwLock_);
+    if (GetService(connection_id) == nullptr) {
+      std::string errMsg = "Connection " + std::to_string(connection_id) + " not found";
+      RETURN_STATUS_UNEXPECTED(errMsg);
+    }
+  }
+  auto addr = strtoll(rq->buf_data(0).data(), nullptr, kDecimal);
+  auto num_pollers = strtol(rq->buf_data(1).data(), nullptr, kDecimal);
+  int64_t shm_mem_sz = shared_memory_sz_in_gb_ * 1073741824L;
+  CHECK_FAIL_RETURN_UNEXPECTED(addr >= 0 && addr + CacheFetchRing::RequiredSize() <= shm_mem_sz,
+                               "The fetch ring is out of the shared memory");
+  CHECK_FAIL_RETURN_UNEXPECTED(num_pollers > 0, "Number of pollers must be positive");
+  // No more pollers than grpc workers, which is how many fetches gRPC serves at a time.
+  num_pollers = std::min<int64_t>(num_pollers, num_grpc_workers_);
+  for (auto i = 0; i < num_pollers; ++i) {
+    auto f = std::bind(&CacheServer::FetchRingPoller, this, connection_id, client_id, addr);
+    RETURN_IF_NOT_OK(vg_.CreateAsyncTask("Fetch ring poller", f));
+  }
+  MS_LOG(INFO) << "Client id " << client_id << " with connection id " << connection_id << " fetches rows through "
+               << num_pollers << " pollers";
+  return Status::OK();
+}
+
+Status CacheServer::FetchRingPoller(connection_id_type connection_id, int32_t client_id, int64_t addr) {
+  CacheFetchRing ring(static_cast<char *>(SharedMemoryBaseAddr()) + addr);
+  ring.PollerStarted();
+  TaskManager::FindMe()->Post();
+  // Check once in a while if the cache is still around when the ring is idle.
+  constexpr int32_t kCheckServiceInterval = 1000;
+  int32_t idle = 0;
+  Status rc;
+  std::string payload;
+  while (!global_shutdown_ && !ring.IsClosed()) {
+    if (this_thread::is_interrupted()) {
+      rc = Status(StatusCode::kMDInterrupted);
+      break;
+    }
+    int32_t slot = -1;
+    if (ring.Poll(&slot, &payload)) {
+      idle = 0;
+      CacheRequest fetch_rq;
+      fetch_rq.set_type(static_cast<int16_t>(BaseRequest::RequestType::kBatchFetchRows));
+      fetch_rq.set_connection_id(connection_id);
+      fetch_rq.set_client_id(client_id);
+      fetch_rq.set_flag(kLocalClientSupport | kFetchToSharedMemory);
+      fetch_rq.add_buf_data(payload);
+      CacheReply fetch_reply;
+      Status fetch_rc = BatchFetchRows(&fetch_rq, &fetch_reply);
+      int64_t result = fetch_rc.IsOk() ? strtoll(fetch_reply.result().data(), nullptr, kDecimal) : -1;
+      // Nobody reads the rows of a request the client gave up on
+      if (!ring.Complete(slot, fetch_rc, result) && result != -1) {
+        DeallocateSharedMemory(client_id, static_cast<char *>(SharedMemoryBaseAddr()) + result);
+      }
+      continue;
+    }
+    if (++idle % kCheckServiceInterval == 0) {
+      SharedLock lck(&rwLock_);
+      if (GetService(connection_id) == nullptr) {
+        break;
+      }
+      idle = kCheckServiceInterval;
+    }
+    CacheFetchRing::Backoff(idle);
+  }
+  ring.PollerStopped();
+  return rc;
+}
+
 Status CacheServer::GetCacheState(CacheRequest *rq, CacheReply *reply) {
   auto connection_id = rq->connection_id();
   SharedLock lck(&rwLock_);
@@ -1279,6 +1422,12 @@ Status CacheServer::Builder::SanityCheck() {
   if (memory_cap_ratio_ <= 0 || memory_cap_ratio_ > 1) {
     RETURN_STATUS_UNEXPECTED("Memory cap ratio should be positive and no greater than 1");
   }
+  if (session_mem_quota_ < 0 || session_disk_quota_ < 0) {
+    RETURN_STATUS_UNEXPECTED("Session quota should not be negative");
+  }
+  if (eviction_policy_ != CacheEvictionPolicy::kNone && top_.empty()) {
+    MS_LOG(WARNING) << "Without a spilling directory, rows are never moved out of the memory.";
+  }
 
   // Check if the shared memory.
   RETURN_IF_NOT_OK(IpcResourceCleanup());
@@ -1307,7 +1456,10 @@ CacheServer::Builder::Builder()
       port_(kCfgDefaultCachePort),
       shared_memory_sz_in_gb_(kDefaultSharedMemorySize),
       memory_cap_ratio_(kDefaultMemoryCapRatio),
-      log_level_(kDefaultLogLevel) {
+      log_level_(kDefaultLogLevel),
+      eviction_policy_(CacheEvictionPolicy::kNone),
+      session_mem_quota_(0),
+      session_disk_quota_(0) {
   if (num_workers_ == 0) {
     num_workers_ = 1;
   }
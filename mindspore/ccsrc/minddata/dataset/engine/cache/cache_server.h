@@ -73,6 +73,9 @@ class CacheServer : public Service {
     int32_t GetSharedMemorySzInGb() const { return shared_memory_sz_in_gb_; }
     float GetMemoryCapRatio() const { return memory_cap_ratio_; }
     int8_t GetLogLevel() const { return log_level_; }
+    CacheEvictionPolicy GetEvictionPolicy() const { return eviction_policy_; }
+    int32_t GetSessionMemoryQuota() const { return session_mem_quota_; }
+    int32_t GetSessionDiskQuota() const { return session_disk_quota_; }
 
     Builder &SetRootDirectory(std::string root) {
       top_ = std::move(root);
@@ -98,6 +101,20 @@ class CacheServer : public Service {
       log_level_ = log_level;
       return *this;
     }
+    Builder &SetEvictionPolicy(CacheEvictionPolicy policy) {
+      eviction_policy_ = policy;
+      return *this;
+    }
+    /// \brief Memory quota of each session in MB, 0 for no quota
+    Builder &SetSessionMemoryQuota(int32_t sz) {
+      session_mem_quota_ = sz;
+      return *this;
+    }
+    /// \brief Disk quota of each session in MB, 0 for no quota
+    Builder &SetSessionDiskQuota(int32_t sz) {
+      session_disk_quota_ = sz;
+      return *this;
+    }
 
     Status SanityCheck();
 
@@ -108,6 +125,9 @@ class CacheServer : public Service {
           << "Tcp/ip port: " << GetPort() << "\n"
           << "Shared memory size (in GB): " << GetSharedMemorySzInGb() << "\n"
           << "Memory cap ratio: " << GetMemoryCapRatio() << "\n"
+          << "Eviction policy: " << CacheEvictionPolicyToString(GetEvictionPolicy()) << "\n"
+          << "Session memory quota (in MB): " << GetSessionMemoryQuota() << "\n"
+          << "Session disk quota (in MB): " << GetSessionDiskQuota() << "\n"
           << "Log level: " << std::to_string(GetLogLevel());
     }
 
@@ -143,7 +163,8 @@ class CacheServer : public Service {
       // We need to bring up the Task Manager by bringing up the Services singleton.
       RETURN_IF_NOT_OK(Services::CreateInstance());
       RETURN_IF_NOT_OK(CacheServer::CreateInstance(top_, num_workers_, port_, shared_memory_sz_in_gb_,
-                                                   memory_cap_ratio_, log_level_, std::move(hw_info_)));
+                                                   memory_cap_ratio_, log_level_, eviction_policy_, session_mem_quota_,
+                                                   session_disk_quota_, std::move(hw_info_)));
       return Status(StatusCode::kSuccess, warning_string);
     }
 
@@ -154,6 +175,9 @@ class CacheServer : public Service {
     int32_t shared_memory_sz_in_gb_;
     float memory_cap_ratio_;
     int8_t log_level_;
+    CacheEvictionPolicy eviction_policy_;
+    int32_t session_mem_quota_;
+    int32_t session_disk_quota_;
     std::shared_ptr<CacheServerHW> hw_info_;
 
     /// \brief Sanity checks on the shared memory.
@@ -174,11 +198,13 @@ class CacheServer : public Service {
 
   static Status CreateInstance(const std::string &spill_path, int32_t num_workers, int32_t port,
                                int32_t shared_memory_sz, float memory_cap_ratio, int8_t log_level,
-                               std::shared_ptr<CacheServerHW> hw_info) {
+                               CacheEvictionPolicy eviction_policy, int32_t session_mem_quota,
+                               int32_t session_disk_quota, std::shared_ptr<CacheServerHW> hw_info) {
     std::call_once(init_instance_flag_, [&]() -> Status {
       auto &SvcManager = Services::GetInstance();
       RETURN_IF_NOT_OK(SvcManager.AddHook(&instance_, spill_path, num_workers, port, shared_memory_sz, memory_cap_ratio,
-                                          log_level, hw_info));
+                                          log_level, eviction_policy, session_mem_quota, session_disk_quota,
+                                          hw_info));
       return Status::OK();
     });
     return Status::OK();
@@ -267,6 +293,7 @@ class CacheServer : public Service {
   /// to the base address of the shared memory where we attach to.
   /// \return Base address of the shared memory.
   const void *SharedMemoryBaseAddr() const { return shm_->SharedMemoryBaseAddr(); }
+  void *SharedMemoryBaseAddr() { return shm_->SharedMemoryBaseAddr(); }
 
   /// \brief Return the public key of the shared memory.
   int32_t GetKey() const { return shm_->GetKey(); }
@@ -283,6 +310,8 @@ class CacheServer : public Service {
   std::string top_;
   cache_index all_caches_;
   std::set<session_id_type> active_sessions_;
+  std::map<session_id_type, std::shared_ptr<CacheQuota>> session_quotas_;
+  std::map<session_id_type, CacheCompression> session_compressions_;
   std::shared_ptr<QueueList<CacheServerRequest *>> cache_q_;
   std::shared_ptr<CacheServerGreeterImpl> comm_layer_;
   TaskGroup vg_;
@@ -293,6 +322,9 @@ class CacheServer : public Service {
   int8_t log_level_;  // log_level is saved here for informational purpose only. It's not a functional field.
   std::atomic<bool> global_shutdown_;
   float memory_cap_ratio_;
+  CacheEvictionPolicy eviction_policy_;
+  uint64_t session_mem_quota_;   // in bytes, 0 for no quota
+  uint64_t session_disk_quota_;  // in bytes, 0 for no quota
   std::shared_ptr<CacheServerHW> hw_info_;
   std::map<worker_id_t, Task *> numa_tasks_;
   bool numa_affinity_;
@@ -302,8 +334,12 @@ class CacheServer : public Service {
   /// \brief Constructor
   /// \param spill_path Top directory for spilling buffers to.
   /// \param num_workers Number of threads for handling requests.
+  /// \param eviction_policy How the caches move rows out of a full tier
+  /// \param session_mem_quota Memory all the caches of a session can use in MB, 0 for no quota
+  /// \param session_disk_quota Disk space all the caches of a session can use in MB, 0 for no quota
   explicit CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port, int32_t share_memory_sz_in_gb,
-                       float memory_cap_ratio, int8_t log_level, std::shared_ptr<CacheServerHW> hw_info);
+                       float memory_cap_ratio, int8_t log_level, CacheEvictionPolicy eviction_policy,
+                       int32_t session_mem_quota, int32_t session_disk_quota, std::shared_ptr<CacheServerHW> hw_info);
 
   /// \brief Locate a cache service from connection id.
   /// \return Pointer to cache service. Null if not found
@@ -347,8 +383,9 @@ class CacheServer : public Service {
   session_id_type GetSessionID(connection_id_type connection_id) const;
 
   /// \brief Generate a session ID for the client
+  /// \param compression How the rows of the caches of the session are compressed
   /// \return Session ID
-  session_id_type GenerateSessionID();
+  session_id_type GenerateSessionID(CacheCompression compression = CacheCompression::kNone);
 
   /// \brief Handle kAllocateSharedBlock request
   /// \param rq CacheRequest
@@ -361,6 +398,19 @@ class CacheServer : public Service {
   /// \return Status object
   Status FreeSharedMemory(CacheRequest *rq);
 
+  /// \brief Handle kRegisterFetchRing request. Start the threads polling the fetch ring of a client.
+  /// \param rq
+  /// \return Status object
+  Status RegisterFetchRing(CacheRequest *rq);
+
+  /// \brief Entry point of a thread polling a fetch ring. It stops when the client closes the ring, the cache is
+  /// destroyed or the server shuts down.
+  /// \param connection_id The cache of the client
+  /// \param client_id The client
+  /// \param addr Offset of the ring in the shared memory
+  /// \return Status object
+  Status FetchRingPoller(connection_id_type connection_id, int32_t client_id, int64_t addr);
+
   /// \brief Handle CacheRow request
   /// \note There are two different implementation depends if shared memory is used for transportation.
   /// \return Status object
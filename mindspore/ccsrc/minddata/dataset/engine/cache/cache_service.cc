@@ -22,9 +22,50 @@
 
 namespace mindspore {
 namespace dataset {
-CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id)
+namespace {
+// A row made mostly of uint8 images, of shape <H, W> or <H, W, C>, goes through the delta filter before the
+// compression, with the number of channels as the stride so that each byte is subtracted by the same channel of the
+// pixel on its left.
+int32_t DeltaStride(const TensorRowHeaderMsg *msg) {
+  constexpr int32_t kGrayImageRank = 2;
+  constexpr int32_t kImageRank = 3;
+  constexpr int64_t kMaxChannels = 4;
+  auto column_hdr = msg->column();
+  auto data_sz = msg->data_sz();
+  int64_t total_sz = 0;
+  int64_t image_sz = 0;
+  int64_t stride = 0;
+  for (uint32_t i = 0; i < column_hdr->size() && i < data_sz->size(); ++i) {
+    auto sz = data_sz->Get(i);
+    total_sz += sz;
+    auto meta = column_hdr->Get(i);
+    if (meta->type() != TensorType::TensorType_DE_UINT8) {
+      continue;
+    }
+    auto rank = meta->dims()->size();
+    int64_t channels = 0;
+    if (rank == kGrayImageRank) {
+      channels = 1;
+    } else if (rank == kImageRank) {
+      channels = meta->dims()->Get(kImageRank - 1);
+    }
+    // Images of different channels in one row don't share a stride
+    if (channels > 0 && channels <= kMaxChannels && (stride == 0 || stride == channels)) {
+      stride = channels;
+      image_sz += sz;
+    }
+  }
+  return image_sz * 2 >= total_sz ? static_cast<int32_t>(stride) : 0;
+}
+}  // namespace
+
+CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id, CacheEvictionPolicy policy,
+                           std::shared_ptr<CacheQuota> quota, CacheCompression compression)
     : root_(root),
       cache_mem_sz_(mem_sz * 1048576L),  // mem_sz is in MB unit
+      policy_(policy),
+      quota_(std::move(quota)),
+      compression_(compression),
       cp_(nullptr),
       next_id_(0),
       generate_id_(generate_id),
@@ -53,7 +94,9 @@ Status CacheService::DoServiceStart() {
     RETURN_STATUS_UNEXPECTED("Unable to bring up numa memory pool");
   }
   // Put together a CachePool for backing up the Tensor.
-  cp_ = std::make_shared<CachePool>(numa_pool_, root_);
+  // Rows are only dropped from the disk when they can be produced again by reading the source dataset,
+  // which is not the case of a cache with a build phase
+  cp_ = std::make_shared<CachePool>(numa_pool_, root_, policy_, !generate_id_, quota_, compression_);
   RETURN_IF_NOT_OK(cp_->ServiceStart());
   // Assign a name to this cache. Used for exclusive connection. But we can just use CachePool's name.
   cookie_ = cp_->MyName();
@@ -116,8 +159,9 @@ Status CacheService::CacheRow(const std::vector<const void *> &buf, row_id_type
     for (auto i = 0; i < column_hdr->size(); ++i) {
       all_data.emplace_back(buf.at(i + 1), msg->data_sz()->Get(i));
     }
-    // Now we cache the buffer.
-    Status rc = cp_->Insert(*row_id_generated, all_data);
+    // Now we cache the buffer. The compression if any is done here on the worker thread.
+    int32_t delta_stride = compression_ != CacheCompression::kNone ? DeltaStride(msg) : 0;
+    Status rc = cp_->Insert(*row_id_generated, all_data, delta_stride);
     if (rc == Status(StatusCode::kMDDuplicateKey)) {
       MS_LOG(DEBUG) << "Ignoring duplicate key.";
     } else {
@@ -170,8 +214,10 @@ Status CacheService::FastCacheRow(const ReadableSlice &src, row_id_type *row_id_
       }
       *row_id_generated = msg->row_id();
     }
-    // Now we cache the buffer.
-    Status rc = cp_->Insert(*row_id_generated, {src});
+    // Now we cache the buffer. The compression if any is done here on the worker thread.
+    int32_t delta_stride =
+      compression_ != CacheCompression::kNone ? DeltaStride(GetTensorRowHeaderMsg(src.GetPointer())) : 0;
+    Status rc = cp_->Insert(*row_id_generated, {src}, delta_stride);
     if (rc == Status(StatusCode::kMDDuplicateKey)) {
       MS_LOG(DEBUG) << "Ignoring duplicate key.";
     } else {
@@ -196,6 +242,7 @@ Status CacheService::FastCacheRow(const ReadableSlice &src, row_id_type *row_id_
 std::ostream &operator<<(std::ostream &out, const CacheService &cs) {
   // Then show any custom derived-internal stuff
   out << "\nCache memory size: " << cs.cache_mem_sz_;
+  out << "\nCompression: " << CacheCompressionToString(cs.compression_);
   out << "\nSpill path: ";
   if (cs.root_.empty()) {
     out << "None";
@@ -231,18 +278,24 @@ Status CacheService::GetStat(CacheService::ServiceStat *out) {
 }
 
 Status CacheService::PreBatchFetch(connection_id_type connection_id, const std::vector<row_id_type> &v,
-                                   const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb) {
+                                   const std::shared_ptr<flatbuffers::FlatBufferBuilder> &fbb, uint64_t *ticket) {
+  RETURN_UNEXPECTED_IF_NULL(ticket);
   SharedLock rw(&rw_lock_);
   if (HasBuildPhase() && st_ != CacheServiceState::kFetchPhase) {
     // For this kind of cache service, we can't fetch yet until we are done with caching all the rows.
     RETURN_STATUS_UNEXPECTED("Can't accept fetch request in non-fetch phase. Current phase: " +
                              std::to_string(static_cast<int>(st_.load())));
   }
+  *ticket = cp_->BeginFetch();
   std::vector<flatbuffers::Offset<DataLocatorMsg>> datalocator_v;
   datalocator_v.reserve(v.size());
   for (auto row_id : v) {
     flatbuffers::Offset<DataLocatorMsg> offset;
-    RETURN_IF_NOT_OK(cp_->GetDataLocator(row_id, fbb, &offset));
+    Status rc = cp_->GetDataLocator(row_id, fbb, &offset);
+    if (rc.IsError()) {
+      cp_->EndFetch(*ticket);
+      return rc;
+    }
     datalocator_v.push_back(offset);
   }
   auto offset_v = fbb->CreateVector(datalocator_v);
@@ -254,6 +307,8 @@ Status CacheService::PreBatchFetch(connection_id_type connection_id, const std::
   return Status::OK();
 }
 
+void CacheService::EndBatchFetch(uint64_t ticket) { cp_->EndFetch(ticket); }
+
 Status CacheService::InternalFetchRow(const FetchRowMsg *p) {
   RETURN_UNEXPECTED_IF_NULL(p);
   SharedLock rw(&rw_lock_);
@@ -49,7 +49,12 @@ class CacheService : public Service {
   /// \param root Spill path. Empty string means no spilling
   /// \param generate_id If the cache service should generate row id for buffer that is cached.
   /// For non-mappable dataset, this should be set to true.
-  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id);
+  /// \param policy How the rows to move out of a full tier are picked
+  /// \param quota Optional quota of the session the cache belongs to
+  /// \param compression How the rows are compressed, as chosen for the session the cache belongs to
+  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id,
+               CacheEvictionPolicy policy = CacheEvictionPolicy::kNone, std::shared_ptr<CacheQuota> quota = nullptr,
+               CacheCompression compression = CacheCompression::kNone);
   ~CacheService() override;
 
   Status DoServiceStart() override;
@@ -71,9 +76,14 @@ class CacheService : public Service {
   /// \brief This function is used in preparation for batch fetching.
   /// It calculates how much memory we should allocate and which row id are present, etc.
   /// All needed results are stored in the flat buffer.
+  /// \param[out] ticket The rows located keep their space until EndBatchFetch is called with it
   /// \return Status object
   Status PreBatchFetch(connection_id_type connection_id, const std::vector<row_id_type> &v,
-                       const std::shared_ptr<flatbuffers::FlatBufferBuilder> &);
+                       const std::shared_ptr<flatbuffers::FlatBufferBuilder> &, uint64_t *ticket);
+
+  /// \brief The rows located by PreBatchFetch are copied out
+  /// \param ticket The ticket returned by PreBatchFetch
+  void EndBatchFetch(uint64_t ticket);
 
   /// \brief Getter function
   /// \return Spilling path
@@ -128,6 +138,9 @@ class CacheService : public Service {
   mutable RWLock rw_lock_;
   std::string root_;
   uint64_t cache_mem_sz_;
+  CacheEvictionPolicy policy_;
+  std::shared_ptr<CacheQuota> quota_;
+  CacheCompression compression_;
   std::shared_ptr<CachePool> cp_;
   std::atomic<row_id_type> next_id_;
   bool generate_id_;
@@ -36,6 +36,7 @@ const char CachePerfRun::kCachePipelineBinary[] = "cache_pipeline";
 const int32_t port_opt = 1000;      // there is no short option for port
 const int32_t hostname_opt = 1001;  // there is no short option for hostname
 const int32_t connect_opt = 1002;   // there is no short option for connect
+const int32_t compress_opt = 1003;  // there is no short option for compression
 
 void CachePerfRun::PrintHelp() {
   std::cout << "Options:\n"
@@ -59,6 +60,13 @@ void CachePerfRun::PrintHelp() {
                "       --spill:          Set spill to disk to True. Default = "
             << std::boolalpha << kDftSpill << "\n"
             << "    -w,--workers:        Set the number of parallel workers. Default = " << cfg_.num_parallel_workers()
+            << "\n"
+               "       --no_zero_copy:   Fetch the rows through gRPC and copy them out of the shared memory, to "
+               "compare with the zero copy fetch path. Default = "
+            << std::boolalpha << kDftNoZeroCopy
+            << "\n"
+               "       --compression:    Compress the rows in the cache, one of none, fast and zlib. Default = "
+            << kDftCompression
             << "\n"
                "       --connection:     Set number of TCP/IP connections per pipeline. Default = "
             << kDftNumConnections << "\n"
@@ -125,6 +133,11 @@ int32_t CachePerfRun::ProcessArgsHelper(int32_t opt) {
         break;
       }
 
+      case compress_opt: {
+        compression_ = optarg;
+        break;
+      }
+
       case 'h':  // -h or --help
         PrintHelp();
         rc = -1;
@@ -187,6 +200,13 @@ int32_t CachePerfRun::SanityCheck(std::map<int32_t, int32_t> seen_opts) {
     std::cerr << "Sample size is smaller than the number of pipelines." << std::endl;
     return -1;
   }
+
+  CacheCompression compression;
+  Status rc = StringToCacheCompression(compression_, &compression);
+  if (rc.IsError()) {
+    std::cerr << rc.GetErrDescription() << std::endl;
+    return -1;
+  }
   return 0;
 }
 
@@ -198,6 +218,7 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
 
   int shuffle = 0;
   int spill = 0;
+  int no_zero_copy = 0;
 
   const char *const short_opts = ":n:e:p:a:s:r:w:";
   const option long_opts[] = {{"pipeline", required_argument, nullptr, 'n'},
@@ -211,7 +232,9 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
                               {"port", required_argument, nullptr, port_opt},
                               {"hostname", required_argument, nullptr, hostname_opt},
                               {"spill", no_argument, &spill, 1},
+                              {"no_zero_copy", no_argument, &no_zero_copy, 1},
                               {"connection", required_argument, nullptr, connect_opt},
+                              {"compression", required_argument, nullptr, compress_opt},
                               {"help", no_argument, nullptr, 'h'},
                               {nullptr, no_argument, nullptr, 0}};
 
@@ -249,6 +272,8 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
           shuffle_ = true;
         } else if (long_opts[option_indxex].flag == &spill) {
           cache_builder_.SetSpill(true);
+        } else if (long_opts[option_indxex].flag == &no_zero_copy) {
+          cache_builder_.SetZeroCopyFetch(false);
         }
         continue;
       }
@@ -275,7 +300,8 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
 Status CachePerfRun::GetSession() {
   CacheClientGreeter comm(cache_builder_.GetHostname(), cache_builder_.GetPort(), 1);
   RETURN_IF_NOT_OK(comm.ServiceStart());
-  auto rq = std::make_shared<GenerateSessionIdRequest>();
+  // The caches of the session compress their rows
+  auto rq = std::make_shared<GenerateSessionIdRequest>(compression_);
   RETURN_IF_NOT_OK(comm.HandleRequest(rq));
   RETURN_IF_NOT_OK(rq->Wait());
   session_ = rq->GetSessionId();
@@ -291,6 +317,7 @@ CachePerfRun::CachePerfRun()
       num_rows_(0),
       row_size_(0),
       shuffle_(kDftShuffle),
+      compression_(kDftCompression),
       session_(0),
       crc_(0),
       epoch_sync_cnt_(0) {
@@ -345,14 +372,19 @@ CachePerfRun::~CachePerfRun() {
 void CachePerfRun::PrintEpochSummary() const {
   std::cout << std::setw(12) << "Pipeline #" << std::setw(10) << "worker id" << std::setw(11) << "min (μs)"
             << std::setw(11) << "max (μs)" << std::setw(11) << "avg (μs)" << std::setw(14) << "median (μs)"
-            << std::setw(14) << "buffer count" << std::setw(18) << "Elapsed time (s)" << std::endl;
+            << std::setw(14) << "buffer count" << std::setw(18) << "Elapsed time (s)" << std::setw(12) << "MB/s"
+            << std::endl;
   for (auto &it : epoch_results_) {
     auto epoch_worker_summary = it.second;
+    // Bytes fetched per microsecond spent in GetRows, i.e. MB per second
+    auto fetch_time = epoch_worker_summary.avg() * epoch_worker_summary.cnt();
+    auto throughput = fetch_time > 0 ? epoch_worker_summary.bytes() / fetch_time : 0;
     std::cout << std::setw(12) << (epoch_worker_summary.pipeline() + 1) << std::setw(10)
               << epoch_worker_summary.worker() << std::setw(10) << epoch_worker_summary.min() << std::setw(10)
               << epoch_worker_summary.max() << std::setw(10) << epoch_worker_summary.avg() << std::setw(13)
               << epoch_worker_summary.med() << std::setw(14) << epoch_worker_summary.cnt() << std::setw(18)
-              << epoch_worker_summary.elapse() << std::endl;
+              << epoch_worker_summary.elapse() << std::setw(12) << throughput
+              << std::endl;
   }
 }
 
@@ -454,7 +486,9 @@ Status CachePerfRun::StartPipelines() {
                                std::to_string(cache_builder_.GetPrefetchSize()) + "," +
                                std::to_string(cache_builder_.GetCacheMemSz()) + "," +
                                std::to_string(cache_builder_.GetNumConnections()) + "," +
-                               (cache_builder_.isSpill() ? std::string("true").data() : std::string("false").data());
+                               (cache_builder_.isSpill() ? std::string("true").data() : std::string("false").data()) +
+                               "," +
+                               (cache_builder_.GetZeroCopyFetch() ? std::string("true") : std::string("false"));
       char *argv[4];
       argv[0] = const_cast<char *>(kCachePipelineBinary);
       argv[1] = pipeline_cfg.data();
@@ -45,6 +45,8 @@ constexpr int32_t kDftNumberOfEpochs = 10;
 constexpr int32_t kDftCacheSize = 0;
 constexpr bool kDftShuffle = false;
 constexpr bool kDftSpill = false;
+constexpr bool kDftNoZeroCopy = false;
+constexpr char kDftCompression[] = "none";
 
 class CachePerfRun {
  public:
@@ -77,6 +79,7 @@ class CachePerfRun {
   int64_t num_rows_;
   int32_t row_size_;
   bool shuffle_;
+  std::string compression_;
   CacheClient::Builder cache_builder_;
   session_id_type session_;
   int32_t crc_;
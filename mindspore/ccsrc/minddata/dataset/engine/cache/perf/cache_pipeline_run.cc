@@ -88,11 +88,13 @@ int32_t CachePipelineRun::ProcessClientArgs(char *argv) {
         cache_builder_.SetNumConnections(std::stoi(s));
       } else if (numArgs == 5) {
         cache_builder_.SetSpill(strcmp(s.data(), "true") == 0);
+      } else if (numArgs == 6) {
+        cache_builder_.SetZeroCopyFetch(strcmp(s.data(), "true") == 0);
       }
       ++numArgs;
     }
-    if (numArgs != 6) {
-      std::cerr << "Incomplete arguments. Expect 6. But get " << numArgs << std::endl;
+    if (numArgs != 7) {
+      std::cerr << "Incomplete arguments. Expect 7. But get " << numArgs << std::endl;
       return -1;
     }
   } catch (const std::exception &e) {
@@ -331,6 +333,7 @@ Status CachePipelineRun::WriterWorkerEntry(int32_t worker_id) {
   proto.set_min(min_val);
   proto.set_max(max_val);
   proto.set_elapse(elapse_time);
+  proto.set_bytes(total_bytes);
   auto sz = duration.size();
   proto.set_cnt(sz);
   if (sz > 0) {
@@ -408,6 +411,7 @@ Status CachePipelineRun::ReaderWorkerEntry(int32_t worker_id) {
   int64_t min_val = std::numeric_limits<int64_t>::max();
   int64_t max_val = 0;
   int64_t total_val = 0;
+  int64_t total_bytes = 0;
   int64_t cnt = 0;
   std::vector<int64_t> duration;
   duration.reserve(num_rows_ / num_pipelines_ / cfg_.num_parallel_workers());
@@ -445,6 +449,11 @@ Status CachePipelineRun::ReaderWorkerEntry(int32_t worker_id) {
     max_val = std::max(max_val, ms);
     duration.push_back(ms);
     total_val += ms;
+    for (const auto &row : ttbl) {
+      for (const auto &ts : row) {
+        total_bytes += ts->SizeInBytes();
+      }
+    }
     ++cnt;
   } while (true);
 
@@ -145,6 +145,8 @@ Status StorageContainer::Insert(const std::vector<ReadableSlice> &buf, off64_t *
   return Status::OK();
 }
 
+void StorageContainer::Free(off64_t offset, size_t sz) noexcept { bs_->Free(static_cast<addr_t>(offset), sz); }
+
 Status StorageContainer::Truncate() const noexcept {
   if (is_open_) {
     RETURN_IF_NOT_OK(cont_.TruncateFile(fd_));
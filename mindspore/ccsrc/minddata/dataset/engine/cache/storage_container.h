@@ -50,6 +50,11 @@ class StorageContainer {
 
   Status Insert(const std::vector<ReadableSlice> &buf, off64_t *offset) noexcept;
 
+  /// \brief Release the space of a buffer inserted before, so that it can be reused by a later Insert
+  /// \param offset The offset returned by Insert
+  /// \param sz The total size of the buffer inserted
+  void Free(off64_t offset, size_t sz) noexcept;
+
   Status Write(const ReadableSlice &dest, off64_t offset) const noexcept;
 
   Status Read(WritableSlice *dest, off64_t offset) const noexcept;
@@ -154,6 +154,19 @@ Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, s
   return Status::OK();
 }
 
+Status StorageManager::Free(StorageManager::key_type key) {
+  auto r = index_.Search(key);
+  if (r.second) {
+    auto &it = r.first;
+    value_type v = *it;
+    // The index entry stays, keys are never reused. Only the space in the container is given back.
+    containers_.at(v.first)->Free(v.second.first, v.second.second);
+  } else {
+    RETURN_STATUS_UNEXPECTED("Key not found");
+  }
+  return Status::OK();
+}
+
 Status StorageManager::DoServiceStop() noexcept {
   Status rc;
   Status rc1;
@@ -66,6 +66,12 @@ class StorageManager : public Service {
 
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead) const;
 
+  /// \brief Release the disk space of a buffer written before, so that a later Write can reuse it.
+  /// The key must not be read again.
+  /// \param key The key returned by Write
+  /// \return Status object
+  Status Free(key_type key);
+
   Status DoServiceStart() override;
 
   Status DoServiceStop() noexcept override;
@@ -20,6 +20,8 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/services.h"
@@ -83,8 +85,9 @@ class Connector {
     pop_from_ = 0;
 
     // Initialize the queues_ to have num_producers_ number of queues.
-    // Each queue is a blocking queue and has the same queue_capacity.
-    queues_.Init(num_producers_, queue_capacity);
+    // Each queue is a blocking queue and has the same queue_capacity. The queues are lock free ring
+    // buffers if it is turned on in the config.
+    queues_.Init(num_producers_, queue_capacity, GlobalContext::config_manager()->lock_free_connector());
   }
 
   // Destructor of Connector
@@ -373,8 +373,31 @@ Status TreeConsumer::Reset(int64_t step) {
     }
   }
 #endif
-  tree_adapter_ = std::make_unique<TreeAdapter>(TreeAdapter::UsageFlag::kDeReset);
-  RETURN_IF_NOT_OK(tree_adapter_->Compile(old_root, num_epochs_, step));
+  // Restore the new pipeline to the state of the step if the old one kept it, else skip the rows before the step
+  nlohmann::json state;
+  bool restore = false;
+  if (step > 0 && GlobalContext::config_manager()->fast_recovery()) {
+    Status rc = tree_adapter_->GetState(step, &state);
+    restore = rc.IsOk();
+    if (!restore) {
+      MS_LOG(INFO) << "The pipeline state of step " << step << " is not available, skipping the rows instead. "
+                   << rc.GetErrDescription();
+    }
+  }
+  if (restore) {
+    tree_adapter_ = std::make_unique<TreeAdapter>(TreeAdapter::UsageFlag::kDeReset);
+    RETURN_IF_NOT_OK(tree_adapter_->Compile(old_root, num_epochs_, 0));
+    Status rc = tree_adapter_->RestoreState(state);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to restore the pipeline state of step " << step << ", skipping the rows instead. "
+                      << rc.GetErrDescription();
+      restore = false;
+    }
+  }
+  if (!restore) {
+    tree_adapter_ = std::make_unique<TreeAdapter>(TreeAdapter::UsageFlag::kDeReset);
+    RETURN_IF_NOT_OK(tree_adapter_->Compile(old_root, num_epochs_, step));
+  }
   RETURN_IF_NOT_OK(tree_adapter_->Launch());
   MS_LOG(INFO) << "Launched a new pipeline after reset. UUID: " << tree_adapter_->tree_->GetUniqueId();
   std::shared_ptr<DatasetOp> root2 = std::shared_ptr<DatasetOp>(tree_adapter_->GetRoot());
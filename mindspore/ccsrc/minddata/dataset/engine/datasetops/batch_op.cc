@@ -83,7 +83,7 @@ Status BatchOp::operator()() {
   RETURN_IF_NOT_OK(callback_manager_.Init(this));
   // Synchronize with TaskManager
   TaskManager::FindMe()->Post();
-  int64_t epoch_num = 0, batch_num = 0, cnt = 0;
+  int64_t epoch_num = restored_epoch_num_, batch_num = restored_batch_num_, cnt = restored_batch_cnt_;
   int64_t ep_step = 0, total_step = 0;
   RETURN_IF_NOT_OK(callback_manager_.Begin(CallbackParam(0, ep_step, total_step)));
 
@@ -92,7 +92,7 @@ Status BatchOp::operator()() {
   child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
   RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   int32_t cur_batch_size = 0;
-  RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(0, 0, 0)));
+  RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, cnt - epoch_num)));
   while (child_iterator_->EofHandled() == false) {
     if (op_current_repeats_ % GetOpNumRepeatsPerEpoch() == 0) {
       ep_step = 0;
@@ -265,7 +265,30 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
       RETURN_IF_NOT_OK(worker_out_queues_[workerId]->EmplaceBack(TensorRow(TensorRow::TensorRowFlags::kFlagWait)));
     } else if (table_pair.second.ctrl_ == batchCtrl::kNoCtrl) {
       TensorRow new_row;
+      std::shared_ptr<RowState> state;
+      if (track_state_ && table_pair.first != nullptr && !table_pair.first->empty()) {
+        // The child continues after the last row of the batch
+        const CBatchInfo &info = table_pair.second;
+        state = std::make_shared<RowState>(
+          id(), std::vector<int64_t>{info.epoch_num_, info.batch_num_ + 1, info.total_batch_num_ + info.epoch_num_},
+          table_pair.first->back().getState());
+        // A single row is batched in place, the row may still be kept for the state of an operator below
+        if (table_pair.first->size() == 1) {
+          for (auto &tensor : table_pair.first->front()) {
+            std::shared_ptr<Tensor> copy;
+            if (tensor->HasData()) {
+              RETURN_IF_NOT_OK(Tensor::CreateFromTensor(tensor, &copy));
+            } else {
+              RETURN_IF_NOT_OK(Tensor::CreateEmpty(tensor->shape(), tensor->type(), &copy));
+            }
+            tensor = std::move(copy);
+          }
+        }
+      }
       RETURN_IF_NOT_OK(MakeBatchedRow(std::move(table_pair), &new_row));
+      if (state != nullptr) {
+        new_row.setState(std::move(state));
+      }
       RETURN_IF_NOT_OK(worker_out_queues_[workerId]->EmplaceBack(std::move(new_row)));
     }
     RETURN_IF_NOT_OK(worker_in_queues_[workerId]->PopFront(&table_pair));
@@ -273,6 +296,25 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
   return Status::OK();
 }
 
+Status BatchOp::GetState(const RowState &state, nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  constexpr size_t kCursorSize = 3;
+  CHECK_FAIL_RETURN_UNEXPECTED(state.cursor.size() == kCursorSize, "Invalid state of " + Name() + ".");
+  (*out_json)["epoch_num"] = state.cursor[0];
+  (*out_json)["batch_num"] = state.cursor[1];
+  (*out_json)["batch_cnt"] = state.cursor[2];
+  return Status::OK();
+}
+
+Status BatchOp::RestoreState(const nlohmann::json &state) {
+  CHECK_FAIL_RETURN_UNEXPECTED(state.contains("epoch_num") && state.contains("batch_num") && state.contains("batch_cnt"),
+                               "Invalid state of " + Name() + ".");
+  restored_epoch_num_ = state["epoch_num"].get<int64_t>();
+  restored_batch_num_ = state["batch_num"].get<int64_t>();
+  restored_batch_cnt_ = state["batch_cnt"].get<int64_t>();
+  return Status::OK();
+}
+
 Status BatchOp::MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair, TensorRow *new_row) {
   RETURN_UNEXPECTED_IF_NULL(table_pair.first);
   bool concat_batch = false;
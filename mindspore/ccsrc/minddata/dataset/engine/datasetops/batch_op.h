@@ -193,6 +193,17 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   // @return Name of the current Op
   std::string Name() const override { return kBatchOp; }
 
+  // Gives the epoch and the batch numbers after a batch was sent, the partial batch is then empty
+  // @param state - The state put on the batch
+  // @param out_json - The state of the operator
+  // @return Status The status code returned
+  Status GetState(const RowState &state, nlohmann::json *out_json) override;
+
+  // Restores the operator to a state given by GetState
+  // @param state - The state of the operator
+  // @return Status The status code returned
+  Status RestoreState(const nlohmann::json &state) override;
+
   // batch the rows in src table then put it to dest table
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
@@ -300,6 +311,9 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   std::unordered_map<std::string, int32_t> child_map_;  // col_name_id_map of the child node
   int64_t batch_num_;
   int64_t batch_cnt_;
+  int64_t restored_epoch_num_ = 0;  // epoch number of the restored state
+  int64_t restored_batch_num_ = 0;  // number of batches sent in the epoch of the restored state
+  int64_t restored_batch_cnt_ = 0;  // number of batches sent before the restored state, counting one per epoch more
 #ifdef ENABLE_PYTHON
   py::function batch_size_func_;  // Function pointer of batch size function
   py::function batch_map_func_;   // Function pointer of per batch map function
@@ -257,6 +257,7 @@ Status DataQueueOp::SendDataToAscend() {
       }
       RETURN_IF_NOT_OK(SendRowToTdt(curr_row, is_profiling_enable, &tdt_cost));
       PrintEndInfoWhenFirstBatch(&first_push_flag_);
+      tree_->RecordRowState(curr_row);
 #ifndef ENABLE_SECURITY
       ProfilingRecorder(is_profiling_enable, profiling_node, send_batch, tdt_cost, &batch_start_time, &end_time,
                         connector_capacity, connector_size);
@@ -654,6 +655,7 @@ Status DataQueueOp::SendDataToGPU() {
       }
 
       PrintBeginInfoWhenFirstBatch(first_push_flag_);
+      tree_->RecordRowState(current_row);
       RETURN_IF_NOT_OK(receive_queues_[num_buf++ % num_workers_]->Add(std::move(current_row)));
       PrintEndInfoWhenFirstBatch(&first_push_flag_);
 #ifndef ENABLE_SECURITY
@@ -749,6 +751,7 @@ Status DataQueueOp::SendDataToCPU() {
         MS_LOG(DEBUG) << "Feature size is " << tensor->SizeInBytes() << ".";
       }
       total_batch++;
+      tree_->RecordRowState(curr_row);
       if (stop_send_) {
         break;
       }
@@ -912,6 +915,7 @@ Status DataQueueOp::SendDataToAscendDynamic() {
       RETURN_IF_NOT_OK(CheckExceptions(curr_row));
       std::vector<device::DataQueueItem> items = ConvertTensorRowToDataQueueItem(curr_row);
       RETURN_IF_NOT_OK(RetryPushData(items, false, &data_queue_cost));
+      tree_->RecordRowState(curr_row);
       if (create_data_info_queue_) {
         DATA_INFO data_info;
         (void)std::transform(curr_row.begin(), curr_row.end(), std::back_inserter(data_info),
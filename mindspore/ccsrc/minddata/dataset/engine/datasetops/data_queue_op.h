@@ -102,6 +102,9 @@ class DataQueueOp : public PipelineOp {
   // @return Name of the current Op
   std::string Name() const override { return kDeviceQueueOp; }
 
+  // @return True, the rows sent carry the state of the rows received
+  bool Stateless() const override { return true; }
+
  private:
   // Name: FilterMetadata(TensorRow *);
   // Description: Auto filter metadata column before sending to device.
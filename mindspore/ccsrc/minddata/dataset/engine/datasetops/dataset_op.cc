@@ -47,7 +47,8 @@ DatasetOp::DatasetOp(int32_t op_connector_size, std::shared_ptr<SamplerRT> sampl
       op_current_epochs_(0),
       out_connector_(nullptr),
       dataset_size_(-1),
-      num_classes_(-1) {
+      num_classes_(-1),
+      track_state_(false) {
   // The operator starts out with an invalid operator id.  The only way to
   // get it out of invalid state is to assign the operator to an execution tree.
 }
@@ -223,6 +224,14 @@ void DatasetOp::CreateConnector() {
   }
 }
 
+std::shared_ptr<OpLatency> DatasetOp::EnableLatency() {
+  latency_ = std::make_shared<OpLatency>(TensorOpNames());
+  if (out_connector_ != nullptr) {
+    out_connector_->SetLatency(latency_.get());
+  }
+  return latency_;
+}
+
 // A print method typically used for debugging.  showAll of true will recursively descend to child prints
 void DatasetOp::Print(std::ostream &out, bool show_all) const {
   // When show_all is false, we display a 1 liner piece of text for the op.
@@ -435,6 +444,20 @@ void DatasetOp::UpdateRepeatAndEpochCounter() {
   MS_LOG(DEBUG) << Name() << " current repeats: " << op_current_repeats_ << ", current epochs: " << op_current_epochs_;
 }
 
+Status DatasetOp::GetState(const RowState &state, nlohmann::json *out_json) {
+  RETURN_STATUS_UNEXPECTED("The state of " + Name() + " cannot be restored.");
+}
+
+Status DatasetOp::RestoreState(const nlohmann::json &state) {
+  RETURN_STATUS_UNEXPECTED("The state of " + Name() + " cannot be restored.");
+}
+
+int32_t DatasetOp::RestoreRepeats(int32_t num_eoes) {
+  op_current_repeats_ = num_eoes;
+  op_current_epochs_ = op_num_repeats_per_epoch_ > 0 ? num_eoes / op_num_repeats_per_epoch_ : 0;
+  return num_eoes;
+}
+
 int64_t DatasetOp::GetTreeBatchSize() {
   if (child_.size() == 1) {
     return child_[0]->GetTreeBatchSize();
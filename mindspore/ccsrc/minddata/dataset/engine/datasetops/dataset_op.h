@@ -23,9 +23,11 @@
 #include <vector>
 #include <utility>
 
+#include <nlohmann/json.hpp>
 #include "minddata/dataset/callback/callback_manager.h"
 #include "minddata/dataset/include/dataset/constants.h"
 #include "minddata/dataset/engine/operator_connector.h"
+#include "minddata/dataset/engine/pipeline_state.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -201,6 +203,33 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   //     before providing their own implementations.
   virtual Status PrepareOperator();
 
+  // \brief Operators which keep a state between rows put it on the rows they send, see RowState. This function
+  //     gives the state of the operator when it sent a row, to restore a new pipeline to it.
+  // \param[in] state The state the operator put on the row
+  // \param[out] out_json The state of the operator
+  // \return Status The status code returned
+  virtual Status GetState(const RowState &state, nlohmann::json *out_json);
+
+  // \brief Restores the operator to a state given by GetState. Called before the tree is launched.
+  // \param[in] state The state of the operator
+  // \return Status The status code returned
+  virtual Status RestoreState(const nlohmann::json &state);
+
+  // \brief Tells the operator it will not be asked for a state older than the given one, so that it can drop what
+  //     it kept to give it.
+  // \param[in] state The oldest state the operator put on a row which may still be asked for
+  virtual void ReleaseState(const RowState &state) {}
+
+  // \brief Getter function
+  // \return T/F if the operator keeps no state between rows, so that it needs none to be restored
+  virtual bool Stateless() const { return false; }
+
+  // \brief Sets the repeat and epoch counters of a restored operator from the number of eoe messages its child
+  //     sent before the restored state.
+  // \param[in] num_eoes The number of eoe messages the child sent
+  // \return The number of eoe messages this operator sent before the restored state
+  virtual int32_t RestoreRepeats(int32_t num_eoes);
+
   // \brief Getter function
   // \return The operator id
   int32_t id() const { return operator_id_; }
@@ -260,6 +289,15 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return out_connector_ == nullptr ? int64_t(-1) : static_cast<int64_t>(out_connector_->out_rows_count());
   }
 
+  // \brief Start recording the latencies of the rows of the operator and of its output connector, for the profiler.
+  //     To be called before the operator is launched.
+  // \return The latencies, shared with the operator
+  std::shared_ptr<OpLatency> EnableLatency();
+
+  // \brief Getter function
+  // \return The latencies of the rows of the operator, nullptr unless they are recorded
+  std::shared_ptr<OpLatency> Latency() const { return latency_; }
+
   // \brief Getter function
   // \return connector size of current op
   int32_t ConnectorCapacity() const {
@@ -375,6 +413,10 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // Launch the Op
   virtual Status Launch() { return Status::OK(); }
 
+  // \brief Getter function, the TensorOps whose latencies are recorded by EnableLatency. None unless it is a map
+  // \return The names of the TensorOps applied to each row
+  virtual std::vector<std::string> TensorOpNames() const { return {}; }
+
   std::vector<std::shared_ptr<DatasetOp>> child_;                // Child nodes
   std::vector<DatasetOp *> parent_;                              // Parent nodes. No ownership
   std::shared_ptr<SamplerRT> sampler_;                           // Some leaf ops might have a sampler
@@ -392,6 +434,8 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   CallbackManager callback_manager_;                             // Manages callbacks associated with a DatasetOp
   int64_t dataset_size_;                                         // Size of the dataset
   int64_t num_classes_;                                          // Number of classes
+  bool track_state_;                                             // Put the state of the operator on the rows
+  std::shared_ptr<OpLatency> latency_;                           // Latencies of the rows, only when profiling
 
  private:
   // Sets the operator id.
@@ -54,7 +54,15 @@ Status EpochCtrlOp::GetNextRow(TensorRow *row) {
   // EOF can simply be forwarded because this op does not spawn any thread, thus does not require clean up.
   if (row->eoe()) {
     RETURN_IF_NOT_OK(EoeReceived(0));
+    if (skip_eoe_) {
+      skip_eoe_ = false;
+      RETURN_IF_NOT_OK(child_[0]->GetNextRow(row));
+      if (row->eoe()) {
+        RETURN_IF_NOT_OK(EoeReceived(0));
+      }
+    }
   }
+  skip_eoe_ = false;
 
   return Status::OK();
 }
@@ -79,5 +87,12 @@ Status EpochCtrlOp::EoeReceived(int32_t worker_id) {
 }
 
 int64_t EpochCtrlOp::GetTreeRepeatCount() { return child_[0]->GetTreeRepeatCount(); }
+
+int32_t EpochCtrlOp::RestoreRepeats(int32_t num_eoes) {
+  (void)DatasetOp::RestoreRepeats(num_eoes);
+  repeat_count_ = num_eoes;
+  skip_eoe_ = true;
+  return num_eoes;
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -37,6 +37,9 @@ class EpochCtrlOp : public RepeatOp {
   void Print(std::ostream &out, bool show_all) const override;
   std::string Name() const override { return kEpochCtrlOp; }
 
+  // @return True, only the repeat counters are restored, see RestoreRepeats
+  bool Stateless() const override { return true; }
+
   // This function returns the row that is at the top of our output connector. The caller is
   // typically our parent node, when the parent is asking us to provide the next row of data.
   // Since EpochCtrlOp is derived from RepeatOp which is an inlined op, getting a row from us
@@ -49,6 +52,16 @@ class EpochCtrlOp : public RepeatOp {
   Status EoeReceived(int32_t worker_id) override;
 
   int64_t GetTreeRepeatCount() override;
+
+  // Sets the epoch count from the number of eoe messages of the child before the restored state
+  // @param num_eoes - The number of eoe messages the child sent
+  // @return The number of eoe messages the operator sent
+  int32_t RestoreRepeats(int32_t num_eoes) override;
+
+ private:
+  // The state was restored right after the last row of an epoch, the child sends again the eoe which was sent
+  // before the restored state
+  bool skip_eoe_ = false;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -69,6 +69,9 @@ class FilterOp : public ParallelOp<TensorRow, TensorRow> {
   // @return Name of the current Op
   std::string Name() const override { return kFilterOp; }
 
+  // @return True, the rows sent carry the state of the rows received
+  bool Stateless() const override { return true; }
+
  private:
   // predicate_func python callable which returns a boolean value.
   std::shared_ptr<TensorOp> predicate_func_;
@@ -38,12 +38,20 @@ Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
   for (int32_t row = 0; row < num_rows; row++) {
     TensorRow input_row = in[row];
     TensorRow result_row;
+    uint64_t start = latency_ != nullptr ? LatencyRecorder::Now() : 0;
     for (size_t i = 0; i < ops_.size(); i++) {
-      // Call compute function for cpu
-      Status rc = ops_[i]->Compute(input_row, &result_row);
+      // Call compute function for cpu, rows which are batches go to the batched kernel of the op if it has one
+      Status rc =
+        batch_compute_ ? ops_[i]->BatchCompute(input_row, &result_row) : ops_[i]->Compute(input_row, &result_row);
       if (rc.IsError()) {
         RETURN_IF_NOT_OK(RebuildMapErrorMsg(input_row, i, &rc));
       }
+      if (latency_ != nullptr) {
+        // The end of an operation is the start of the next one, one clock read per operation
+        uint64_t end = LatencyRecorder::Now();
+        latency_->TensorOp(first_op_ + i)->Record(end - start);
+        start = end;
+      }
 
       // Assign result_row to to_process for the next TensorOp processing, except for the last TensorOp in the list.
       if (i + 1 < ops_.size()) {
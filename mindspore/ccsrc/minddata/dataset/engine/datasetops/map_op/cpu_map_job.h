@@ -19,6 +19,7 @@
 #include <memory>
 #include <vector>
 #include "minddata/dataset/engine/datasetops/map_op/map_job.h"
+#include "minddata/dataset/engine/perf/op_latency.h"
 
 namespace mindspore {
 namespace dataset {
@@ -36,8 +37,22 @@ class CpuMapJob : public MapJob {
   // A pure virtual run function to execute a cpu map job
   Status Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) override;
 
+  // Run the operations on whole batches with TensorOp::BatchCompute instead of TensorOp::Compute
+  void SetBatchCompute(bool batch_compute) { batch_compute_ = batch_compute; }
+
+  // Record the time of each operation in the latencies of the map, the first operation of the job being the
+  // TensorOp at first_op in the map
+  void SetLatency(OpLatency *latency, size_t first_op) {
+    latency_ = latency;
+    first_op_ = first_op;
+  }
+
  private:
   Status RebuildMapErrorMsg(const TensorRow &input_row, const size_t &i, Status *rc);
+
+  bool batch_compute_ = false;
+  OpLatency *latency_ = nullptr;
+  size_t first_op_ = 0;
 };
 
 }  // namespace dataset
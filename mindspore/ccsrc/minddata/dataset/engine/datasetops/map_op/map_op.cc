@@ -40,7 +40,8 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
       tensor_operations_(tensor_operations),
       in_columns_(in_col_names),
       out_columns_(out_col_names),
-      python_mp_(nullptr) {
+      python_mp_(nullptr),
+      batch_compute_(false) {
   // Set connector size via config.
   // If caller didn't specify the out_col_names, assume they are same as the in_columns.
 
@@ -73,6 +74,7 @@ void MapOp::Print(std::ostream &out, bool show_all) const {
     for (size_t i = 0; i < in_columns_.size(); i++) {
       out << " " << in_columns_[i];
     }
+    out << "\nBatch compute: " << (batch_compute_ ? "yes" : "no");
     for (size_t i = 0; i < tfuncs_.size(); i++) {
       out << "\n  TensorOps with worker_id " << i << ":";
       for (size_t j = 0; j < tfuncs_[i].size(); j++) {
@@ -107,7 +109,10 @@ Status MapOp::GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job,
     // map_job could be nullptr when we are at the first tensor op or when the target device of the prev op
     // is different with that of the current op.
     if (map_job == nullptr) {
-      map_job = std::make_shared<CpuMapJob>();
+      auto cpu_map_job = std::make_shared<CpuMapJob>();
+      cpu_map_job->SetBatchCompute(batch_compute_);
+      cpu_map_job->SetLatency(latency_.get(), j);
+      map_job = std::move(cpu_map_job);
     }
     RETURN_IF_NOT_OK(map_job->AddOperation(tfuncs_[worker_id][j]));
 
@@ -214,8 +219,12 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
     } else {
       CHECK_FAIL_RETURN_UNEXPECTED(in_row.size() != 0, "[Internal ERROR] MapOp got an empty TensorRow.");
       TensorRow out_row;
+      uint64_t start = latency_ != nullptr ? LatencyRecorder::Now() : 0;
       // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
       RETURN_IF_NOT_OK(WorkerCompute(in_row, &out_row, job_list));
+      if (latency_ != nullptr) {
+        latency_->Compute()->Record(LatencyRecorder::Now() - start);
+      }
       // Push the row onto the connector for next operator to consume.
       RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(out_row)));
     }
@@ -287,6 +296,7 @@ Status MapOp::WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
     }
     *out_row = std::move(result_table[0]);
   }
+  out_row->setState(in_row.getState());
 
   return Status::OK();
 }
@@ -451,5 +461,14 @@ std::vector<int32_t> MapOp::GetMPWorkerPIDs() const {
   }
   return DatasetOp::GetMPWorkerPIDs();
 }
+
+std::vector<std::string> MapOp::TensorOpNames() const {
+  std::vector<std::string> names;
+  if (!tfuncs_.empty()) {
+    (void)std::transform(tfuncs_[0].begin(), tfuncs_[0].end(), std::back_inserter(names),
+                         [](const std::shared_ptr<TensorOp> &op) { return op->Name(); });
+  }
+  return names;
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -113,6 +113,9 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
   // @return Name of the current Op
   std::string Name() const override { return kMapOp; }
 
+  // @return True, the rows sent carry the state of the rows received
+  bool Stateless() const override { return true; }
+
   /// Send wait flag row to worker at worker_id to make it wait
   /// \param worker_id id of the worker
   /// \return Status code
@@ -145,6 +148,10 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
   /// \param python_mp PythonMultiprocessingRuntime
   void SetPythonMp(std::shared_ptr<PythonMultiprocessingRuntime> python_mp);
 
+  /// Make the workers call TensorOp::BatchCompute instead of TensorOp::Compute, every input row must be a batch
+  /// \param batch_compute whether to run the TensorOps on whole batches
+  void SetBatchCompute(bool batch_compute) { batch_compute_ = batch_compute; }
+
   /// Return the list of PIDs of worker processes
   /// \return vector of int
   std::vector<int32_t> GetMPWorkerPIDs() const override;
@@ -178,6 +185,8 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
 
   std::shared_ptr<PythonMultiprocessingRuntime> python_mp_;  // python multiprocessing instance
 
+  bool batch_compute_;  // whether the TensorOps are run on whole batches
+
   // Private function for worker/thread to loop continuously. It comprises the main
   // logic of MapOp: getting the data from previous Op, validating user specified column names,
   // applying a list of TensorOps to each of the data, process the results and then
@@ -214,6 +223,7 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
   Status Launch() override;
   Status AddNewWorkers(int32_t num_new_workers) override;
   Status RemoveWorkers(int32_t num_workers) override;
+  std::vector<std::string> TensorOpNames() const override;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -23,6 +23,8 @@
 #include <utility>
 #include <vector>
 #include "minddata/dataset/include/dataset/constants.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
@@ -146,8 +148,11 @@ class ParallelOp : public DatasetOp {
   /// \return Status The status code returned
   virtual Status RegisterAndLaunchThreads() {
     RETURN_UNEXPECTED_IF_NULL(tree_);
-    worker_in_queues_.Init(num_workers_, worker_connector_size_);
-    worker_out_queues_.Init(num_workers_, worker_connector_size_);
+    // Each worker queue has a single producer and a single consumer, a lock free ring avoids the futex
+    // wake up on every row when there are many workers.
+    bool lock_free = GlobalContext::config_manager()->lock_free_connector();
+    worker_in_queues_.Init(num_workers_, worker_connector_size_, lock_free);
+    worker_out_queues_.Init(num_workers_, worker_connector_size_, lock_free);
 
     // Registers QueueList and individual Queues for interrupt services
     RETURN_IF_NOT_OK(worker_in_queues_.Register(tree_->AllTasks()));
@@ -162,6 +167,11 @@ class ParallelOp : public DatasetOp {
     return Status::OK();
   }
 
+  /// Called by the collector on each row it sends, in order. Operators which keep a state between rows put it on the
+  /// row here, see RowState.
+  /// \param[in,out] row The row about to be sent
+  virtual void StampState(TensorRow *row) {}
+
   virtual Status Collector() {
     TaskManager::FindMe()->Post();
     // num_rows received, including eoe, num_step of current epoch
@@ -195,6 +205,7 @@ class ParallelOp : public DatasetOp {
         ++total_step;
         RETURN_IF_NOT_OK(callback_manager_.StepEnd(CallbackParam(current_epochs + 1, ep_step, total_step)));
       }
+      StampState(&row);
       RETURN_IF_NOT_OK(out_connector_->Add(std::move(row)));
     } while (!row.eof());
     return Status::OK();
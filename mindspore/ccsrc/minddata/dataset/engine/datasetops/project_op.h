@@ -80,6 +80,9 @@ class ProjectOp : public PipelineOp {
   // @return Name of the current Op
   std::string Name() const override { return kProjectOp; }
 
+  // @return True, the rows sent carry the state of the rows received
+  bool Stateless() const override { return true; }
+
  private:
   std::vector<std::string> columns_to_project_;
   std::vector<int32_t> projected_column_indices_;
@@ -59,6 +59,9 @@ class RenameOp : public PipelineOp {
   // @return Name of the current Op
   std::string Name() const override { return kRenameOp; }
 
+  // @return True, the rows sent carry the state of the rows received
+  bool Stateless() const override { return true; }
+
   // Gets a row from the child node and projects that row. The caller is typically our parent node.
   // @param row - output pointer to the projected row.
   // @param worker_id - The worker id
@@ -130,5 +130,16 @@ Status RepeatOp::Reset() {
 }
 
 int64_t RepeatOp::GetTreeRepeatCount() { return num_repeats_; }
+
+int32_t RepeatOp::RestoreRepeats(int32_t num_eoes) {
+  (void)DatasetOp::RestoreRepeats(num_eoes);
+  if (num_repeats_ <= 0) {
+    // Infinite repeats never send an eoe
+    repeat_count_ = num_eoes;
+    return 0;
+  }
+  repeat_count_ = num_eoes % num_repeats_;
+  return num_eoes / num_repeats_;
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -81,6 +81,9 @@ class RepeatOp : public PipelineOp {
   // @return Name of the current Op
   std::string Name() const override { return kRepeatOp; }
 
+  // @return True, only the repeat counters are restored, see RestoreRepeats
+  bool Stateless() const override { return true; }
+
   /// \brief Getter function
   /// \return The number of repeats that the user requested
   int32_t num_repeats() { return num_repeats_; }
@@ -91,6 +94,11 @@ class RepeatOp : public PipelineOp {
 
   int64_t GetTreeRepeatCount() override;
 
+  // Sets the repeat count from the number of eoe messages of the child before the restored state
+  // @param num_eoes - The number of eoe messages the child sent
+  // @return The number of eoe messages the operator sent
+  int32_t RestoreRepeats(int32_t num_eoes) override;
+
   // \brief Adds an operator to the repeat ops list of tracked leaf/eoe nodes
   // \param[in] eoe_op The input leaf/eoe operator to add to the list
   void AddToEoeList(std::shared_ptr<DatasetOp> eoe_op) { eoe_ops_.push_back(std::move(eoe_op)); }
@@ -20,13 +20,16 @@
 #include <iomanip>
 #include <iostream>
 #include <random>
+#include <sstream>
 #include <utility>
 
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 
 #include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/path.h"
 #include "minddata/dataset/util/random.h"
 #include "minddata/dataset/util/status.h"
 
@@ -44,8 +47,26 @@ ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_con
       reshuffle_each_epoch_(reset_every_epoch),
       rng_(shuffle_seed),
       shuffle_buffer_(std::make_unique<TensorTable>()),
+      spill_dir_(GlobalContext::config_manager()->shuffle_spill_dir()),
+      spill_container_(-1),
       shuffle_last_row_idx_(0),
-      shuffle_buffer_state_(kShuffleStateInit) {}
+      shuffle_buffer_state_(kShuffleStateInit),
+      rows_sent_(0),
+      restored_(false),
+      skip_child_eoe_(false) {
+  checkpoint_.rng = std::mt19937_64(shuffle_seed);
+}
+
+ShuffleOp::~ShuffleOp() {
+  // The containers truncate and close their file when destroyed, the files themselves are removed here
+  spill_containers_.clear();
+  for (const auto &file : spill_files_) {
+    Status rc = Path(file).Remove();
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to remove the shuffle spill file " << file << ": " << rc.GetErrDescription();
+    }
+  }
+}
 
 // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
 // itself rather than waiting for the reset driven from operators above it in the pipeline.
@@ -60,8 +81,10 @@ Status ShuffleOp::SelfReset() {
   }
 
   shuffle_buffer_ = std::make_unique<TensorTable>();
+  spill_buffer_.clear();
   shuffle_last_row_idx_ = 0;
   shuffle_buffer_state_ = kShuffleStateInit;
+  current_step_.epoch_start = true;
   return Status::OK();
 }
 
@@ -77,7 +100,11 @@ void ShuffleOp::Print(std::ostream &out, bool show_all) const {
     PipelineOp::Print(out, show_all);
     // Then show any custom derived-internal stuff
     out << "\nShuffle size: " << shuffle_size_ << "\nShuffle buffer state: " << shuffle_buffer_state_
-        << "\nShuffle seed: " << shuffle_seed_ << "\n\n";
+        << "\nShuffle seed: " << shuffle_seed_;
+    if (!spill_dir_.empty()) {
+      out << "\nShuffle spill directory: " << spill_dir_;
+    }
+    out << "\n\n";
   }
 }
 
@@ -89,6 +116,20 @@ Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
   // If we are already at the full size, then we overwrite the last slot with our row (and the last
   // slot better be empty because it should already have been swapped out during the random row
   // selection that was done previously!)
+  if (!spill_dir_.empty()) {
+    SpilledRow location;
+    RETURN_IF_NOT_OK(SpillRow(new_shuffle_row, &location));
+    if (shuffle_last_row_idx_ < (shuffle_size_ - 1)) {
+      spill_buffer_.push_back(location);
+      shuffle_last_row_idx_ = static_cast<int32_t>(spill_buffer_.size()) - 1;
+    } else {
+      if (spill_buffer_[shuffle_last_row_idx_].container >= 0) {
+        RETURN_STATUS_UNEXPECTED("[Internal ERROR] Last row of shuffle buffer should not be occupied!");
+      }
+      spill_buffer_[shuffle_last_row_idx_] = location;
+    }
+    return Status::OK();
+  }
   if (shuffle_last_row_idx_ < (shuffle_size_ - 1)) {
     shuffle_buffer_->push_back(std::move(new_shuffle_row));
     shuffle_last_row_idx_ = (shuffle_buffer_->size()) - 1;
@@ -101,6 +142,157 @@ Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
   return Status::OK();
 }
 
+int64_t ShuffleOp::ShuffleBufferSize() const {
+  return spill_dir_.empty() ? static_cast<int64_t>(shuffle_buffer_->size())
+                            : static_cast<int64_t>(spill_buffer_.size());
+}
+
+Status ShuffleOp::TakeRowFromShuffleBuffer(int64_t slot, TensorRow *row) {
+  if (spill_dir_.empty()) {
+    *row = std::move((*shuffle_buffer_)[slot]);
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(LoadRow(spill_buffer_[slot], row));
+  spill_buffer_[slot] = SpilledRow();
+  return Status::OK();
+}
+
+void ShuffleOp::MoveRowInShuffleBuffer(int64_t from, int64_t to) {
+  if (spill_dir_.empty()) {
+    (*shuffle_buffer_)[to] = std::move((*shuffle_buffer_)[from]);
+  } else {
+    spill_buffer_[to] = spill_buffer_[from];
+    spill_buffer_[from] = SpilledRow();
+  }
+}
+
+// A spilled row is written as one record: a header of int64 values, the bytes of the paths of the row, then the
+// data of its tensors. The header holds the number of header values, the row id, the number of paths and of
+// tensors, the length of each path, then the type, the rank, the dimensions and the data size of each tensor.
+void ShuffleOp::MakeRecord(const TensorRow &row, std::vector<int64_t> *header, std::string *paths,
+                           std::vector<ReadableSlice> *record) {
+  *header = {0, row.getId(), static_cast<int64_t>(row.getPath().size()), static_cast<int64_t>(row.size())};
+  paths->clear();
+  for (const auto &path : row.getPath()) {
+    header->push_back(static_cast<int64_t>(path.size()));
+    *paths += path;
+  }
+  for (const auto &tensor : row) {
+    header->push_back(static_cast<int64_t>(tensor->type().value()));
+    header->push_back(static_cast<int64_t>(tensor->Rank()));
+    for (auto dim : tensor->shape().AsVector()) {
+      header->push_back(dim);
+    }
+    header->push_back(tensor->HasData() ? tensor->SizeInBytes() : 0);
+  }
+  (*header)[0] = static_cast<int64_t>(header->size());
+  *record = {ReadableSlice(header->data(), header->size() * sizeof(int64_t))};
+  if (!paths->empty()) {
+    record->emplace_back(paths->data(), paths->size());
+  }
+  for (const auto &tensor : row) {
+    if (tensor->HasData() && tensor->SizeInBytes() > 0) {
+      record->emplace_back(tensor->GetBuffer(), tensor->SizeInBytes());
+    }
+  }
+}
+
+Status ShuffleOp::SpillRow(const TensorRow &row, SpilledRow *location) {
+  std::vector<int64_t> header;
+  std::string paths;
+  std::vector<ReadableSlice> record;
+  MakeRecord(row, &header, &paths, &record);
+
+  size_t record_size = 0;
+  for (const auto &slice : record) {
+    record_size += slice.GetSize();
+  }
+
+  // Write to the last file used, then to any other one with room left, then to a new one
+  off64_t offset = 0;
+  auto num_containers = static_cast<int32_t>(spill_containers_.size());
+  for (int32_t i = 0; i < num_containers; ++i) {
+    int32_t index = (std::max(spill_container_, 0) + i) % num_containers;
+    Status rc = spill_containers_[index]->Insert(record, &offset);
+    if (rc.IsOk()) {
+      spill_container_ = index;
+      location->container = index;
+      location->offset = offset;
+      location->size = record_size;
+      return Status::OK();
+    }
+    if (rc.StatusCode() != StatusCode::kMDBuddySpaceFull) {
+      return rc;
+    }
+  }
+  std::string file = (Path(spill_dir_) / ("shuffle_" + std::to_string(id()) + "_" +
+                                          std::to_string(GetRandomDevice()()) + "_" +
+                                          std::to_string(num_containers) + ".spill"))
+                       .ToString();
+  std::shared_ptr<StorageContainer> container;
+  RETURN_IF_NOT_OK(StorageContainer::CreateStorageContainer(&container, file));
+  spill_containers_.push_back(container);
+  spill_files_.push_back(file);
+  MS_LOG(INFO) << "Shuffle operator spills its buffer to " << file << ".";
+  spill_container_ = num_containers;
+  return SpillRow(row, location);
+}
+
+Status ShuffleOp::LoadRow(const SpilledRow &location, TensorRow *row) {
+  CHECK_FAIL_RETURN_UNEXPECTED(location.container >= 0, "[Internal ERROR] Shuffle buffer slot should be occupied!");
+  auto container = spill_containers_[location.container];
+  std::vector<uint8_t> record(location.size);
+  WritableSlice dest(record.data(), record.size());
+  RETURN_IF_NOT_OK(container->Read(&dest, location.offset));
+  container->Free(location.offset, location.size);
+  return ParseRecord(record.data(), record.size(), row);
+}
+
+Status ShuffleOp::ParseRecord(const uint8_t *record, size_t size, TensorRow *row) {
+  // The record of a restored state is not aligned, the header is copied out of it
+  const int64_t kFixedHeader = 4;
+  const std::string err_msg = "[Internal ERROR] Shuffle spill record is corrupted.";
+  int64_t header_size = 0;
+  CHECK_FAIL_RETURN_UNEXPECTED(size >= kFixedHeader * sizeof(int64_t), err_msg);
+  (void)memcpy_s(&header_size, sizeof(int64_t), record, sizeof(int64_t));
+  CHECK_FAIL_RETURN_UNEXPECTED(header_size >= kFixedHeader && size >= static_cast<size_t>(header_size) * sizeof(int64_t),
+                               err_msg);
+  std::vector<int64_t> header(header_size);
+  (void)memcpy_s(header.data(), header_size * sizeof(int64_t), record, header_size * sizeof(int64_t));
+  int64_t pos = kFixedHeader;
+  const uint8_t *data = record + header_size * sizeof(int64_t);
+  const uint8_t *data_end = record + size;
+  *row = TensorRow();
+  row->setId(header[1]);
+  std::vector<std::string> paths;
+  for (int64_t i = 0; i < header[2]; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(pos < header_size, err_msg);
+    auto length = static_cast<size_t>(header[pos++]);
+    CHECK_FAIL_RETURN_UNEXPECTED(length <= static_cast<size_t>(data_end - data), err_msg);
+    paths.emplace_back(reinterpret_cast<const char *>(data), length);
+    data += length;
+  }
+  row->setPath(paths);
+  for (int64_t i = 0; i < header[3]; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED(pos + 1 < header_size, err_msg);
+    DataType type(static_cast<DataType::Type>(header[pos++]));
+    int64_t rank = header[pos++];
+    CHECK_FAIL_RETURN_UNEXPECTED(rank >= 0 && pos + rank < header_size, err_msg);
+    std::vector<dsize_t> dims(header.begin() + pos, header.begin() + pos + rank);
+    pos += rank;
+    int64_t data_size = header[pos++];
+    CHECK_FAIL_RETURN_UNEXPECTED(data_size >= 0 && data_size <= data_end - data, err_msg);
+    std::shared_ptr<Tensor> tensor;
+    if (data_size > 0) {
+      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(TensorShape(dims), type, data, data_size, &tensor));
+      data += data_size;
+    } else {
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape(dims), type, &tensor));
+    }
+    row->push_back(std::move(tensor));
+  }
+  return Status::OK();
+}
 // Class functor operator () override.
 // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
 // provide the master loop that drives the logic for performing the work
@@ -118,13 +310,21 @@ Status ShuffleOp::operator()() {
 
   // Main operator loop
   while (true) {
-    // Do an initial populate of the shuffle buffer
-    RETURN_IF_NOT_OK(InitShuffleBuffer());
-
-    // This is our main loop exit condition, when the iterator has no more data completely.
-    if (child_iterator_->EofHandled()) {
-      RETURN_IF_NOT_OK(out_connector_->SendEOF());
-      break;
+    if (restored_) {
+      // A restored shuffle buffer continues from the row sent last
+      restored_ = false;
+      if (shuffle_buffer_state_ == kShuffleStateActive) {
+        RETURN_IF_NOT_OK(RefillShuffleBuffer());
+      }
+    } else {
+      // Do an initial populate of the shuffle buffer
+      RETURN_IF_NOT_OK(InitShuffleBuffer());
+
+      // This is our main loop exit condition, when the iterator has no more data completely.
+      if (child_iterator_->EofHandled()) {
+        RETURN_IF_NOT_OK(out_connector_->SendEOF());
+        break;
+      }
     }
 
     // Next, enter into the main execution loop of the shuffle op.
@@ -142,8 +342,12 @@ Status ShuffleOp::operator()() {
       // tensor table. We remove the data from the shuffle buffer, leaving that slot
       // in the table as an empty vector
       int64_t random_slot = rng_() % (shuffle_last_row_idx_ + 1);
-      TensorRow random_row = std::move((*shuffle_buffer_)[random_slot]);
+      TensorRow random_row;
+      RETURN_IF_NOT_OK(TakeRowFromShuffleBuffer(random_slot, &random_row));
       MS_LOG(DEBUG) << "Shuffle operator sending a row to output.";
+      if (TrackingState()) {
+        RecordStep(&random_row);
+      }
       RETURN_IF_NOT_OK(out_connector_->Add(std::move(random_row)));
 
       // Step 3)
@@ -151,30 +355,12 @@ Status ShuffleOp::operator()() {
       // just vacated.  This makes the shuffle buffer contiguous, with an empty slot at the
       // tail of the shuffle buffer.
       if (random_slot != shuffle_last_row_idx_) {
-        (*shuffle_buffer_)[random_slot] = std::move((*shuffle_buffer_)[shuffle_last_row_idx_]);
+        MoveRowInShuffleBuffer(shuffle_last_row_idx_, random_slot);
       }
 
       // Step 4)
-      // Refill the last slot of the shuffle buffer with the next row from input if we are in the
-      // active state.
-      // If we are in the draining state, we do not need to fetch another row to replace the one we
-      // just drained.
-      if (shuffle_buffer_state_ == kShuffleStateActive) {
-        TensorRow new_row;
-        RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
-
-        if (!new_row.empty()) {
-          RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
-        } else {
-          shuffle_buffer_state_ = kShuffleStateDrain;
-        }
-      }
-
-      // If we are draining, reposition (decrement) our tail index in the shuffle buffer since we
-      // just drained a row from it.
-      if (shuffle_buffer_state_ == kShuffleStateDrain) {
-        shuffle_last_row_idx_--;
-      }
+      // Refill the last slot of the shuffle buffer, or shrink it if it is being drained.
+      RETURN_IF_NOT_OK(RefillShuffleBuffer());
     }
 
     // Since we overloaded eoeReceived function, we are responsible to flow the EOE up the
@@ -191,6 +377,187 @@ Status ShuffleOp::operator()() {
   return Status::OK();
 }
 
+Status ShuffleOp::RefillShuffleBuffer() {
+  // Refill the last slot of the shuffle buffer with the next row from input if we are in the
+  // active state.
+  // If we are in the draining state, we do not need to fetch another row to replace the one we
+  // just drained.
+  if (shuffle_buffer_state_ == kShuffleStateActive) {
+    TensorRow new_row;
+    RETURN_IF_NOT_OK(FetchRowFromChild(&new_row));
+
+    if (!new_row.empty()) {
+      RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
+    } else {
+      shuffle_buffer_state_ = kShuffleStateDrain;
+    }
+  }
+
+  // If we are draining, reposition (decrement) our tail index in the shuffle buffer since we
+  // just drained a row from it.
+  if (shuffle_buffer_state_ == kShuffleStateDrain) {
+    shuffle_last_row_idx_--;
+  }
+  return Status::OK();
+}
+
+Status ShuffleOp::FetchRowFromChild(TensorRow *row) {
+  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(row));
+  if (!TrackingState()) {
+    return Status::OK();
+  }
+  if (!row->empty()) {
+    // The row is sent on and may be changed in place by the operators above, so the state keeps a copy of it
+    TensorRow copy(*row);
+    for (auto &tensor : copy) {
+      std::shared_ptr<Tensor> copy_tensor;
+      RETURN_IF_NOT_OK(Tensor::CreateFromTensor(tensor, &copy_tensor));
+      tensor = std::move(copy_tensor);
+    }
+    current_step_.fetched.push_back(std::move(copy));
+    child_state_ = row->getState();
+  } else if (row->eoe()) {
+    current_step_.child_eoe = true;
+  }
+  return Status::OK();
+}
+
+void ShuffleOp::RecordStep(TensorRow *row) {
+  rows_sent_++;
+  row->setState(std::make_shared<RowState>(id(), std::vector<int64_t>{rows_sent_}, child_state_));
+  std::lock_guard<std::mutex> lock(state_mux_);
+  steps_.push_back(std::move(current_step_));
+  current_step_ = Step();
+}
+
+// A checkpoint is updated the way the shuffle buffer is, but the rows are kept in slot order without the empty slot
+Status ShuffleOp::ReplayStep(const Step &step, Checkpoint *checkpoint) const {
+  if (step.epoch_start) {
+    checkpoint->buffer.clear();
+    checkpoint->eoes++;
+    checkpoint->draining = false;
+    if (!reshuffle_each_epoch_) {
+      checkpoint->rng = std::mt19937_64(shuffle_seed_);
+    }
+  }
+  checkpoint->buffer.insert(checkpoint->buffer.end(), step.fetched.begin(), step.fetched.end());
+  if (step.child_eoe) {
+    checkpoint->draining = true;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(!checkpoint->buffer.empty(), "[Internal ERROR] Shuffle buffer state is corrupted.");
+  auto random_slot = checkpoint->rng() % checkpoint->buffer.size();
+  if (random_slot != checkpoint->buffer.size() - 1) {
+    checkpoint->buffer[random_slot] = std::move(checkpoint->buffer.back());
+  }
+  checkpoint->buffer.pop_back();
+  checkpoint->rows_sent++;
+  return Status::OK();
+}
+
+void ShuffleOp::ReleaseState(const RowState &state) {
+  if (state.cursor.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(state_mux_);
+  while (!steps_.empty() && checkpoint_.rows_sent < state.cursor[0]) {
+    Status rc = ReplayStep(steps_.front(), &checkpoint_);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to update the state of " << NameWithID() << ": " << rc.GetErrDescription();
+      return;
+    }
+    steps_.pop_front();
+  }
+}
+
+Status ShuffleOp::GetState(const RowState &state, nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  CHECK_FAIL_RETURN_UNEXPECTED(TrackingState(), "The state of " + Name() + " is not kept when its buffer is spilled.");
+  CHECK_FAIL_RETURN_UNEXPECTED(!state.cursor.empty(), "Invalid state of " + Name() + ".");
+  int64_t rows_sent = state.cursor[0];
+  Checkpoint checkpoint;
+  {
+    std::lock_guard<std::mutex> lock(state_mux_);
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      rows_sent >= checkpoint_.rows_sent && rows_sent <= checkpoint_.rows_sent + static_cast<int64_t>(steps_.size()),
+      "The state of " + Name() + " after " + std::to_string(rows_sent) + " rows is no longer kept.");
+    checkpoint = checkpoint_;
+    for (auto it = steps_.begin(); checkpoint.rows_sent < rows_sent; ++it) {
+      RETURN_IF_NOT_OK(ReplayStep(*it, &checkpoint));
+    }
+  }
+  std::ostringstream rng;
+  rng << checkpoint.rng;
+  nlohmann::json buffer = nlohmann::json::array();
+  for (const auto &row : checkpoint.buffer) {
+    std::vector<int64_t> header;
+    std::string paths;
+    std::vector<ReadableSlice> record;
+    MakeRecord(row, &header, &paths, &record);
+    std::vector<uint8_t> bytes;
+    for (const auto &slice : record) {
+      const auto *data = static_cast<const uint8_t *>(slice.GetPointer());
+      bytes.insert(bytes.end(), data, data + slice.GetSize());
+    }
+    buffer.push_back(nlohmann::json::binary(std::move(bytes)));
+  }
+  (*out_json)["rows_sent"] = checkpoint.rows_sent;
+  (*out_json)["eoes"] = checkpoint.eoes;
+  (*out_json)["draining"] = checkpoint.draining;
+  (*out_json)["rng"] = rng.str();
+  (*out_json)["buffer"] = std::move(buffer);
+  return Status::OK();
+}
+
+Status ShuffleOp::RestoreState(const nlohmann::json &state) {
+  CHECK_FAIL_RETURN_UNEXPECTED(spill_dir_.empty(), "The state of " + Name() + " is not kept when its buffer is spilled.");
+  for (const auto &key : {"rows_sent", "eoes", "draining", "rng", "buffer"}) {
+    CHECK_FAIL_RETURN_UNEXPECTED(state.contains(key), "Invalid state of " + Name() + ", missing " + key + ".");
+  }
+  Checkpoint checkpoint;
+  checkpoint.rows_sent = state["rows_sent"].get<int64_t>();
+  checkpoint.eoes = state["eoes"].get<int32_t>();
+  checkpoint.draining = state["draining"].get<bool>();
+  std::istringstream rng(state["rng"].get<std::string>());
+  rng >> checkpoint.rng;
+  CHECK_FAIL_RETURN_UNEXPECTED(!rng.fail(), "Invalid state of " + Name() + ", the random generator is corrupted.");
+  // The rows of the shuffle buffer are sent on, so the checkpoint gets its own copy of them
+  TensorTable buffer;
+  for (const auto &record : state["buffer"]) {
+    CHECK_FAIL_RETURN_UNEXPECTED(record.is_binary(), "Invalid state of " + Name() + ".");
+    const auto &bytes = record.get_binary();
+    TensorRow row;
+    RETURN_IF_NOT_OK(ParseRecord(bytes.data(), bytes.size(), &row));
+    buffer.push_back(std::move(row));
+    RETURN_IF_NOT_OK(ParseRecord(bytes.data(), bytes.size(), &row));
+    checkpoint.buffer.push_back(std::move(row));
+  }
+  auto num_rows = static_cast<int32_t>(checkpoint.buffer.size());
+  CHECK_FAIL_RETURN_UNEXPECTED(checkpoint.draining || num_rows == shuffle_size_ - 1,
+                               "Invalid state of " + Name() + ", the shuffle buffer should be full.");
+
+  // The shuffle buffer is restored right after the row was sent: when the buffer is refilled, the last slot is
+  // empty, when it is drained, the child sends again its eoe before the next epoch.
+  rng_ = checkpoint.rng;
+  rows_sent_ = checkpoint.rows_sent;
+  shuffle_buffer_ = std::make_unique<TensorTable>(std::move(buffer));
+  if (checkpoint.draining) {
+    shuffle_last_row_idx_ = num_rows - 1;
+    shuffle_buffer_state_ = kShuffleStateDrain;
+    skip_child_eoe_ = true;
+  } else {
+    shuffle_buffer_->emplace_back();
+    shuffle_last_row_idx_ = num_rows;
+    shuffle_buffer_state_ = kShuffleStateActive;
+  }
+  restored_ = true;
+  std::lock_guard<std::mutex> lock(state_mux_);
+  checkpoint_ = std::move(checkpoint);
+  steps_.clear();
+  return Status::OK();
+}
+
+int32_t ShuffleOp::RestoreRepeats(int32_t num_eoes) { return DatasetOp::RestoreRepeats(checkpoint_.eoes); }
+
 // Private function populate the shuffle buffer initially by fetching from the child output
 // connector until the shuffle buffer is full (or there is no more data coming).
 Status ShuffleOp::InitShuffleBuffer() {
@@ -210,7 +577,13 @@ Status ShuffleOp::InitShuffleBuffer() {
   // Before we drop into the fetching loop, call the fetch once for the first time
   // to fill the first row and grab the first buffer.
   TensorRow new_row;
-  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+  if (skip_child_eoe_) {
+    // The eoe of the child was fetched before the state was restored
+    skip_child_eoe_ = false;
+    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+    CHECK_FAIL_RETURN_UNEXPECTED(new_row.eoe(), "[Internal ERROR] Restored shuffle operator expects an eoe.");
+  }
+  RETURN_IF_NOT_OK(FetchRowFromChild(&new_row));
 
   if (child_iterator_->EofHandled()) {
     MS_LOG(DEBUG) << "Shuffle operator init picked up EOF. No more epochs.";
@@ -224,12 +597,12 @@ Status ShuffleOp::InitShuffleBuffer() {
 
   // Now fill the rest of the shuffle buffer until we are unable to get the next row or we reached
   // the desired shuffle buffer size.
-  while (!new_row.empty() && shuffle_buffer_->size() < static_cast<size_t>(shuffle_size_ - 1)) {
+  while (!new_row.empty() && ShuffleBufferSize() < static_cast<int64_t>(shuffle_size_ - 1)) {
     // Add the previously fetched row
     RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
 
     // Fetch the next row
-    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+    RETURN_IF_NOT_OK(FetchRowFromChild(&new_row));
   }
 
   // If we quit the loop due to being at the shuffle size, still need to add the last row here.
@@ -16,8 +16,10 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_OP_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_OP_H_
 
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <random>
 #include <string>
@@ -26,6 +28,7 @@
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/core/tensor_shape.h"
+#include "minddata/dataset/engine/cache/storage_container.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/datasetops/pipeline_op.h"
 #include "minddata/dataset/util/status.h"
@@ -53,8 +56,8 @@ class ShuffleOp : public PipelineOp {
   // @param op_connector_size - The output connector queue size
   ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch);
 
-  // Destructor
-  ~ShuffleOp() = default;
+  // Destructor, removes the spill files
+  ~ShuffleOp();
 
   // A print method typically used for debugging
   // @param out - The output stream to write output to
@@ -87,11 +90,119 @@ class ShuffleOp : public PipelineOp {
   // @return Name of the current Op
   std::string Name() const override { return kShuffleOp; }
 
+  // Gives the shuffle buffer and the random generator after a row was sent, by replaying the steps kept since the
+  // oldest state which may be asked for. Not supported when the shuffle buffer is spilled.
+  // @param state - The state put on the row
+  // @param out_json - The state of the operator
+  // @return Status The status code returned
+  Status GetState(const RowState &state, nlohmann::json *out_json) override;
+
+  // Restores the operator to a state given by GetState
+  // @param state - The state of the operator
+  // @return Status The status code returned
+  Status RestoreState(const nlohmann::json &state) override;
+
+  // Drops the steps kept before the given state
+  // @param state - The oldest state which may be asked for
+  void ReleaseState(const RowState &state) override;
+
+  // Sets the repeat counters from the restored number of epochs
+  // @param num_eoes - The number of eoe messages the child sent before the restored state
+  // @return The number of eoe messages the operator sent before the restored state
+  int32_t RestoreRepeats(int32_t num_eoes) override;
+
  private:
+  // The shuffle buffer after a number of rows were sent, before it is refilled, with the rows in slot order
+  struct Checkpoint {
+    int64_t rows_sent = 0;
+    int32_t eoes = 0;       // Number of eoe sent
+    bool draining = false;  // The child sent its eoe and the shuffle buffer is no longer refilled
+    std::mt19937_64 rng;
+    TensorTable buffer;
+  };
+
+  // What the operator did between two rows sent
+  struct Step {
+    bool epoch_start = false;  // The shuffle buffer was reset for a new epoch
+    TensorTable fetched;       // The rows fetched from the child
+    bool child_eoe = false;    // The eoe of the child was fetched
+  };
+
+  // Location of a row of the shuffle buffer in the spill files
+  struct SpilledRow {
+    int32_t container = -1;  // Index of the spill file in spill_containers_, -1 for an empty slot
+    off64_t offset = 0;
+    size_t size = 0;
+  };
+
   // Private function to add a new row to the shuffle buffer.
   // @return Status The status code returned
   Status AddRowToShuffleBuffer(TensorRow new_shuffle_row);
 
+  // @return The number of slots of the shuffle buffer
+  int64_t ShuffleBufferSize() const;
+
+  // Private function to take the row out of a slot of the shuffle buffer, leaving the slot empty.
+  // @param slot - The slot
+  // @param row - The row taken
+  // @return Status The status code returned
+  Status TakeRowFromShuffleBuffer(int64_t slot, TensorRow *row);
+
+  // Private function to move the row of a slot of the shuffle buffer to another, leaving the first one empty.
+  // @param from - The slot holding the row
+  // @param to - The empty slot to move the row to
+  void MoveRowInShuffleBuffer(int64_t from, int64_t to);
+
+  // Private function to write a row to the spill files.
+  // @param row - The row
+  // @param location - Where the row was written
+  // @return Status The status code returned
+  Status SpillRow(const TensorRow &row, SpilledRow *location);
+
+  // Private function to read a row back from the spill files and release its space.
+  // @param location - Where the row was written
+  // @param row - The row read
+  // @return Status The status code returned
+  Status LoadRow(const SpilledRow &location, TensorRow *row);
+
+  // Private function to write a row to a record, in the format of the spill files.
+  // @param row - The row
+  // @param header - The header of the record, which the record points to
+  // @param paths - The paths of the row, which the record points to
+  // @param record - The pieces of the record
+  static void MakeRecord(const TensorRow &row, std::vector<int64_t> *header, std::string *paths,
+                         std::vector<ReadableSlice> *record);
+
+  // Private function to read a row from a record.
+  // @param record - The record
+  // @param size - The size of the record
+  // @param row - The row read
+  // @return Status The status code returned
+  static Status ParseRecord(const uint8_t *record, size_t size, TensorRow *row);
+
+  // Private function to fetch a row from the child, which is kept for the next step if the state is tracked.
+  // @param row - The row fetched
+  // @return Status The status code returned
+  Status FetchRowFromChild(TensorRow *row);
+
+  // Private function to refill the last slot of the shuffle buffer from the child after a row was sent, or to
+  // shrink the shuffle buffer if it is being drained.
+  // @return Status The status code returned
+  Status RefillShuffleBuffer();
+
+  // Private function to put the state on a row about to be sent and to keep the step which led to it.
+  // @param row - The row
+  void RecordStep(TensorRow *row);
+
+  // Private function to apply a step to a checkpoint.
+  // @param step - The step
+  // @param checkpoint - The checkpoint
+  // @return Status The status code returned
+  Status ReplayStep(const Step &step, Checkpoint *checkpoint) const;
+
+  // @return T/F if the state is put on the rows sent
+  bool TrackingState() const { return track_state_ && spill_dir_.empty(); }
+
   // Private function to populate the shuffle buffer initially by fetching from the child output
   // connector until the shuffle buffer is full (or there is no more data coming).
   // @return Status The status code returned
@@ -113,10 +224,29 @@ class ShuffleOp : public PipelineOp {
   std::mt19937_64 rng_;
   // A single (potentially large) buffer of tensor rows for performing shuffling.
   std::unique_ptr<TensorTable> shuffle_buffer_;
+  // When a spill directory is configured, the shuffle buffer only keeps the location of each row in memory and
+  // the rows themselves are written to files of the directory, in place of shuffle_buffer_.
+  std::string spill_dir_;
+  std::vector<SpilledRow> spill_buffer_;
+  std::vector<std::shared_ptr<StorageContainer>> spill_containers_;
+  std::vector<std::string> spill_files_;
+  int32_t spill_container_;  // The spill file written last
   int32_t shuffle_last_row_idx_;  // Internal tracking of the last slot of our shuffle buffer
   int32_t shuffle_buffer_state_;  // State tracking for the shuffle buffer phases of work
 
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
+
+  // When the state is tracked, the state of the shuffle buffer before the oldest state which may be asked for is
+  // kept, with the steps since. A state is given by applying the steps to a copy of the checkpoint. The rows of the
+  // checkpoint and of the steps are deep copies, they do not share the tensors of the rows sent.
+  std::mutex state_mux_;
+  Checkpoint checkpoint_;
+  std::deque<Step> steps_;
+  Step current_step_;                                // The step before the next row sent
+  std::shared_ptr<const RowState> child_state_;      // The state of the last row fetched from the child
+  int64_t rows_sent_;                                // Number of rows sent, when the state is tracked
+  bool restored_;                                    // The shuffle buffer was restored and is not initialized
+  bool skip_child_eoe_;                              // The child sends again the eoe fetched before the restored state
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -88,15 +88,13 @@ Status ClueOp::LoadFile(const std::string &file, int64_t start_offset, int64_t e
     LOG_AND_RETURN_STATUS_SYNTAX_ERROR(err_msg);
   }
 
-  std::ifstream handle(realpath.value());
-  if (!handle.is_open()) {
-    RETURN_STATUS_UNEXPECTED("Invalid file, failed to open " + file + ", the file is damaged or permission denied.");
-  }
+  std::unique_ptr<AsyncFileReader> handle;
+  RETURN_IF_NOT_OK(OpenFileReader(realpath.value(), &handle));
 
   int64_t rows_total = 0;
   std::string line;
 
-  while (getline(handle, line)) {
+  while (handle->GetLine(&line)) {
     if (line.empty()) {
       continue;
     }
@@ -134,7 +132,7 @@ Status ClueOp::LoadFile(const std::string &file, int64_t start_offset, int64_t e
     RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(t_row)));
   }
 
-  return Status::OK();
+  return handle->GetError();
 }
 
 // A print method typically used for debugging
@@ -478,22 +478,19 @@ Status CsvOp::LoadFile(const std::string &file, int64_t start_offset, int64_t en
     RETURN_STATUS_UNEXPECTED("Invalid file path, " + file + " does not exist.");
   }
 
-  std::ifstream ifs;
-  ifs.open(realpath.value(), std::ifstream::in);
-  if (!ifs.is_open()) {
-    RETURN_STATUS_UNEXPECTED("Invalid file, failed to open " + file + ", the file is damaged or permission denied.");
-  }
+  std::unique_ptr<AsyncFileReader> ifs;
+  RETURN_IF_NOT_OK(OpenFileReader(realpath.value(), &ifs));
   if (column_name_list_.empty()) {
     std::string tmp;
-    getline(ifs, tmp);
+    (void)ifs->GetLine(&tmp);
   }
   csv_parser.Reset();
   try {
-    while (ifs.good()) {
-      // when ifstream reaches the end of file, the function get() return std::char_traits<char>::eof()
+    while (!ifs->Eof()) {
+      // when the reader reaches the end of file, the function Get() return AsyncFileReader::kEof
       // which is a 32-bit -1, it's not equal to the 8-bit -1 on Euler OS. So instead of char, we use
       // int to receive its return value.
-      int chr = ifs.get();
+      int chr = ifs->Get();
       int err = csv_parser.ProcessMessage(chr);
       if (err != 0) {
         // if error code is -2, the returned error is interrupted
@@ -513,7 +510,7 @@ Status CsvOp::LoadFile(const std::string &file, int64_t start_offset, int64_t en
     std::string err_row = std::to_string(csv_parser.GetTotalRows() + 1);
     RETURN_STATUS_UNEXPECTED("Invalid csv, " + file + " parse failed at line " + err_row + " : value out of range.");
   }
-  return Status::OK();
+  return ifs->GetError();
 }
 
 // A print method typically used for debugging
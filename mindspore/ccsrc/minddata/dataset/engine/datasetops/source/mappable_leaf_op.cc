@@ -68,6 +68,9 @@ Status MappableLeafOp::operator()() {
   RETURN_IF_NOT_OK(callback_manager_.Begin(CallbackParam(0, ep_step, total_step)));
   TensorRow sample_row;
   RETURN_IF_NOT_OK(sampler_->GetNextSample(&sample_row));
+  if (restored_eoes_ > 0 || restored_rows_ > 0) {
+    RETURN_IF_NOT_OK(RestoreSampler(&sample_row));
+  }
   while (true) {  // each iteration is 1 epoch, breaks when IsLastIteration() is true
     if (op_current_repeats_ % GetOpNumRepeatsPerEpoch() == 0) {
       ep_step = 0;
@@ -112,6 +115,72 @@ Status MappableLeafOp::Reset() {
   return Status::OK();
 }
 
+Status MappableLeafOp::RestoreSampler(TensorRow *sample_row) {
+  // The sampler of each epoch before the restored state draws all its ids, which are not loaded
+  for (int32_t i = 0; i < restored_eoes_; ++i) {
+    while (!sample_row->eoe()) {
+      RETURN_IF_NOT_OK(sampler_->GetNextSample(sample_row));
+    }
+    RETURN_IF_NOT_OK(Reset());
+    RETURN_IF_NOT_OK(sampler_->GetNextSample(sample_row));
+  }
+  // Then the ids of the rows sent in the restored epoch are dropped, ids out of bound were not sent
+  int64_t num_skip = restored_rows_;
+  while (num_skip > 0) {
+    CHECK_FAIL_RETURN_UNEXPECTED(!sample_row->eoe(), "Invalid state, the sampler of " + Name() + " ran out of ids " +
+                                                       std::to_string(num_skip) + " rows before the restored state.");
+    std::shared_ptr<Tensor> sample_ids = (*sample_row)[0];
+    std::vector<int64_t> remaining;
+    for (auto itr = sample_ids->begin<int64_t>(); itr != sample_ids->end<int64_t>(); ++itr) {
+      if (num_skip > 0 && (*itr) < num_rows_) {
+        num_skip--;
+      } else {
+        remaining.push_back(*itr);
+      }
+    }
+    if (remaining.empty()) {
+      RETURN_IF_NOT_OK(sampler_->GetNextSample(sample_row));
+    } else {
+      std::shared_ptr<Tensor> remaining_ids;
+      RETURN_IF_NOT_OK(Tensor::CreateFromVector(remaining, &remaining_ids));
+      *sample_row = {remaining_ids};
+    }
+  }
+  MS_LOG(INFO) << Name() << " is restored after " << restored_rows_ << " rows of epoch " << restored_eoes_ << ".";
+  return Status::OK();
+}
+
+void MappableLeafOp::StampState(TensorRow *row) {
+  if (row->eoe()) {
+    state_eoes_++;
+    state_rows_ = 0;
+  } else if (track_state_ && row->Flags() == TensorRow::TensorRowFlags::kFlagNone) {
+    state_rows_++;
+    row->setState(std::make_shared<RowState>(id(), std::vector<int64_t>{state_eoes_, state_rows_}, nullptr));
+  }
+}
+
+Status MappableLeafOp::GetState(const RowState &state, nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  constexpr size_t kCursorSize = 2;
+  CHECK_FAIL_RETURN_UNEXPECTED(state.cursor.size() == kCursorSize, "Invalid state of " + Name() + ".");
+  (*out_json)["eoes"] = state.cursor[0];
+  (*out_json)["rows"] = state.cursor[1];
+  return Status::OK();
+}
+
+Status MappableLeafOp::RestoreState(const nlohmann::json &state) {
+  CHECK_FAIL_RETURN_UNEXPECTED(state.contains("eoes") && state.contains("rows"), "Invalid state of " + Name() + ".");
+  restored_eoes_ = state["eoes"].get<int32_t>();
+  restored_rows_ = state["rows"].get<int64_t>();
+  CHECK_FAIL_RETURN_UNEXPECTED(restored_eoes_ >= 0 && restored_rows_ >= 0, "Invalid state of " + Name() + ".");
+  state_eoes_ = restored_eoes_;
+  state_rows_ = restored_rows_;
+  return Status::OK();
+}
+
+int32_t MappableLeafOp::RestoreRepeats(int32_t num_eoes) { return DatasetOp::RestoreRepeats(restored_eoes_); }
+
 // hand shake with Sampler, allow Sampler to call RandomAccessOp's functions to get NumRows
 Status MappableLeafOp::InitSampler() {
   RETURN_IF_NOT_OK(sampler_->HandshakeRandomAccessOp(this));
@@ -64,6 +64,22 @@ class MappableLeafOp : public ParallelOp<std::unique_ptr<IOBlock>, TensorRow>, p
   /// @return Name of the current Op
   std::string Name() const override { return "MappableLeafPp"; }
 
+  /// \brief Gives the number of eoe and rows sent before a row, the sampler is replayed up to them on restore
+  /// \param[in] state The state put on the row
+  /// \param[out] out_json The state of the operator
+  /// \return Status The status code returned
+  Status GetState(const RowState &state, nlohmann::json *out_json) override;
+
+  /// \brief Restores the operator to a state given by GetState
+  /// \param[in] state The state of the operator
+  /// \return Status The status code returned
+  Status RestoreState(const nlohmann::json &state) override;
+
+  /// \brief Sets the repeat counters from the restored number of eoe messages, as the operator is a leaf
+  /// \param[in] num_eoes Unused
+  /// \return The restored number of eoe messages
+  int32_t RestoreRepeats(int32_t num_eoes) override;
+
 #ifdef ENABLE_PYTHON
   /// \brief Decrypt the encrypted image data as a public function.
   /// \param[in] path - The path of the image that needs to be decrypted.
@@ -93,6 +109,16 @@ class MappableLeafOp : public ParallelOp<std::unique_ptr<IOBlock>, TensorRow>, p
   /// \return Status The status code returned
   Status WorkerEntry(int32_t worker_id) override;
 
+  /// Puts the number of eoe and rows sent so far on the rows, in the order the collector sends them
+  /// \param[in,out] row The row about to be sent
+  void StampState(TensorRow *row) override;
+
+  /// Moves the sampler forward to the restored state, by drawing the ids of the rows sent before it without loading
+  /// the rows
+  /// \param[in,out] sample_row The first sample of the sampler, then the first sample after the restored state
+  /// \return Status The status code returned
+  Status RestoreSampler(TensorRow *sample_row);
+
   /// Virtual function to Load a tensor row at location row_id
   /// \param row_id_type row_id - id for this tensor row
   /// \param TensorRow row - loaded row
@@ -104,6 +130,11 @@ class MappableLeafOp : public ParallelOp<std::unique_ptr<IOBlock>, TensorRow>, p
   Status Reset() override;
   Status SendWaitFlagToWorker(int32_t worker_id) override;
   Status SendQuitFlagToWorker(int32_t worker_id) override;
+
+  int32_t state_eoes_ = 0;     // Number of eoe sent, for the state put on the rows
+  int64_t state_rows_ = 0;     // Number of rows sent since the last eoe, for the state put on the rows
+  int32_t restored_eoes_ = 0;  // Number of eoe sent before the restored state
+  int64_t restored_rows_ = 0;  // Number of rows sent after the last eoe before the restored state
 };
 }  // namespace dataset
 }  // namespace mindspore
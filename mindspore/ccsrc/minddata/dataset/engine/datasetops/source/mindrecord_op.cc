@@ -62,6 +62,7 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, std::vector<std::str
 
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
+  shard_reader_->SetUseMmap(GlobalContext::config_manager()->mindrecord_mmap());
   RETURN_IF_NOT_OK(shard_reader_->Open(dataset_file_, load_dataset_, num_mind_record_workers_, columns_to_load_,
                                        operators_, num_padded_));
 
@@ -185,11 +186,26 @@ Status MindRecordOp::WorkerEntry(int32_t worker_id) {
 Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, int32_t worker_id) {
   RETURN_UNEXPECTED_IF_NULL(fetched_row);
   *fetched_row = {};
+  if (shard_reader_->UseMmap()) {
+    // The blob stays in the mapped file, the tensors of the row borrow it where they can
+    mindrecord::TaskType task_type = mindrecord::TaskType::kCommonTask;
+    mindrecord::ShardBlobView blob;
+    mindrecord::json columns_json;
+    RETURN_IF_NOT_OK(shard_reader_->GetNextViewById(row_id, worker_id, &task_type, &blob, &columns_json));
+    if (task_type == mindrecord::TaskType::kCommonTask && blob.data == nullptr) {
+      return Status::OK();
+    }
+    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, blob.data.get(), blob.size, blob.data, columns_json, task_type));
+    std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
+    fetched_row->setPath(file_path);
+    fetched_row->setId(row_id);
+    return Status::OK();
+  }
   auto rc = shard_reader_->GetNextById(row_id, worker_id);
   auto task_type = rc.first;
-  auto tupled_buffer = rc.second;
+  const auto &tupled_buffer = rc.second;
   if (task_type == mindrecord::TaskType::kPaddedTask) {
-    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, {}, mindrecord::json(), task_type));
+    RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, nullptr, 0, nullptr, mindrecord::json(), task_type));
     std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
     fetched_row->setPath(file_path);
     fetched_row->setId(row_id);
@@ -199,9 +215,10 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   }
   if (task_type == mindrecord::TaskType::kCommonTask) {
     for (const auto &tupled_row : tupled_buffer) {
-      std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-      mindrecord::json columns_json = std::get<1>(tupled_row);
-      RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, columns_blob, columns_json, task_type));
+      const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
+      const mindrecord::json &columns_json = std::get<1>(tupled_row);
+      RETURN_IF_NOT_OK(
+        LoadTensorRow(fetched_row, columns_blob.data(), columns_blob.size(), nullptr, columns_json, task_type));
       std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
       fetched_row->setPath(file_path);
       fetched_row->setId(row_id);
@@ -211,7 +228,8 @@ Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, uint64_t row_id, i
   return Status::OK();
 }
 
-Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
+                                   const std::shared_ptr<const void> &blob_owner,
                                    const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
   for (int32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
     auto column_name = columns_to_load_[i_col];
@@ -248,9 +266,9 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
         data = reinterpret_cast<const unsigned char *>(data_ptr.get());
       }
     } else {
-      RETURN_IF_NOT_OK(shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr,
-                                                          &n_bytes, &column_data_type, &column_data_type_size,
-                                                          &column_shape));
+      RETURN_IF_NOT_OK(shard_column->GetColumnValueByName(column_name, columns_blob, blob_size, columns_json, &data,
+                                                          &data_ptr, &n_bytes, &column_data_type,
+                                                          &column_data_type_size, &column_shape));
     }
 
     std::shared_ptr<Tensor> tensor;
@@ -261,22 +279,29 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
     CHECK_FAIL_RETURN_UNEXPECTED(column_data_type_size != 0,
                                  "[Internal ERROR] Found memory size of column data type is 0.");
     auto num_elements = n_bytes / column_data_type_size;
+    // The column can be borrowed if it is stored as is in the blob, i.e. it was not decoded into data_ptr
+    bool borrow = blob_owner != nullptr && data_ptr == nullptr && n_bytes > 0 && type.IsNumeric() &&
+                  reinterpret_cast<uintptr_t>(data) % type.SizeInBytes() == 0;
     if (type == DataType::DE_STRING) {
       std::string s{data, data + n_bytes};
       RETURN_IF_NOT_OK(Tensor::CreateScalar(s, &tensor));
-    } else if (column.HasShape()) {
-      auto new_shape = TensorShape(column.Shape());
-      // if the numpy is null, create empty tensor shape
-      if (num_elements == 0) {
-        new_shape = TensorShape({});
+    } else {
+      TensorShape new_shape({static_cast<dsize_t>(num_elements)});
+      if (column.HasShape()) {
+        new_shape = TensorShape(column.Shape());
+        // if the numpy is null, create empty tensor shape
+        if (num_elements == 0) {
+          new_shape = TensorShape({});
+        } else {
+          RETURN_IF_NOT_OK(column.MaterializeTensorShape(static_cast<int32_t>(num_elements), &new_shape));
+        }
+      }
+      if (borrow && new_shape.NumOfElements() * type.SizeInBytes() == static_cast<dsize_t>(n_bytes)) {
+        RETURN_IF_NOT_OK(Tensor::CreateFromMemoryView(new_shape, type, data, static_cast<dsize_t>(n_bytes),
+                                                      blob_owner, &tensor));
       } else {
-        RETURN_IF_NOT_OK(column.MaterializeTensorShape(static_cast<int32_t>(num_elements), &new_shape));
+        RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
       }
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
-    } else {
-      std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(num_elements)};
-      auto new_shape = TensorShape(shapeDetails);
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
     }
     tensor_row->push_back(std::move(tensor));
   }
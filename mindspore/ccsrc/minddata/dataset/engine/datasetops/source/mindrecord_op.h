@@ -123,9 +123,12 @@ class MindRecordOp : public MappableLeafOp {
   /// Parses a single cell and puts the data into a tensor
   /// @param tensor_row - the tensor row to put the parsed data in
   /// @param columns_blob - the blob data received from the reader
+  /// @param blob_size - the size of the blob data
+  /// @param blob_owner - the owner of the blob data if it can be borrowed by the tensors, nullptr to copy it
   /// @param columns_json - the data for fields received from the reader
-  Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
-                       const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
+  Status LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t blob_size,
+                       const std::shared_ptr<const void> &blob_owner, const mindrecord::json &columns_json,
+                       const mindrecord::TaskType task_type);
 
   Status LoadTensorRow(row_id_type row_id, TensorRow *row) override {
     return Status(StatusCode::kMDSyntaxError, "[Internal ERROR] Cannot call this method.");
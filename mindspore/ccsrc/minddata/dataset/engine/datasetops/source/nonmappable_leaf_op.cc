@@ -16,6 +16,7 @@
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
 
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/jagged_connector.h"
@@ -39,7 +40,8 @@ NonMappableLeafOp::NonMappableLeafOp(int32_t num_workers, int32_t worker_connect
       load_io_block_queue_(true),
       shuffle_files_(shuffle_files),
       num_rows_per_shard_(0),
-      num_rows_(0) {
+      num_rows_(0),
+      async_read_depth_(GlobalContext::config_manager()->async_read_depth()) {
   worker_connector_size_ = worker_connector_size;
 }
 
@@ -52,6 +54,12 @@ Status NonMappableLeafOp::operator()() {
   // Put here to avoid register failed when Worker_Entry thread exits unexpected
   RETURN_IF_NOT_OK(io_block_queue_wait_post_.Register(tree_->AllTasks()));
 
+  if (async_read_depth_ > 0 && !AsyncFileReader::IoUringSupported() && io_thread_pool_ == nullptr) {
+    // Enough threads to keep async_read_depth_ reads in flight for the file of every worker.
+    constexpr int32_t kMaxIoThreads = 32;
+    io_thread_pool_ = std::make_shared<IoThreadPool>(std::min(num_workers_ * async_read_depth_, kMaxIoThreads));
+  }
+
   // launch one thread, responsible for filling mIOBlockQueue
   RETURN_IF_NOT_OK(tree_->LaunchWorkers(1, std::bind(&NonMappableLeafOp::WaitToFillIOBlockQueue, this), "", id()));
 
@@ -64,6 +72,8 @@ Status NonMappableLeafOp::operator()() {
   TaskManager::FindMe()->Post();
 
   NotifyToFillIOBlockQueue();
+  // The rows sent in the restored epoch before the restored state are read again, but not sent
+  int64_t rows_to_drop = restored_rows_;
   while (!finished_reading_dataset_) {
     int32_t workers_done = 0;
     int64_t rows_read = 0;
@@ -78,9 +88,17 @@ Status NonMappableLeafOp::operator()() {
       if (fetched_row.eoe()) {
         workers_done++;
       } else if (total_rows_ == 0 || rows_read < total_rows_) {
+        rows_read++;
+        if (rows_to_drop > 0) {
+          rows_to_drop--;
+          continue;
+        }
+        if (track_state_) {
+          fetched_row.setState(
+            std::make_shared<RowState>(id(), std::vector<int64_t>{op_current_repeats_, rows_read}, nullptr));
+        }
         // we need to push a row
         RETURN_IF_NOT_OK(out_connector_->Add(std::move(fetched_row)));
-        rows_read++;
       } else {
         // IOBlockQueue thread needs to:
         // -stop pushing stuff to IOBlockQueue
@@ -154,6 +172,12 @@ Status NonMappableLeafOp::WorkerEntry(int32_t worker_id) {
   return Status::OK();
 }
 
+Status NonMappableLeafOp::OpenFileReader(const std::string &file, std::unique_ptr<AsyncFileReader> *reader) {
+  RETURN_IF_NOT_OK(AsyncFileReader::Open(file, async_read_depth_, io_thread_pool_, reader));
+  MS_LOG(DEBUG) << Name() << " operator reads " << file << " with " << (*reader)->BackendName() << " backend.";
+  return Status::OK();
+}
+
 // Pushes a control indicator onto the IOBlockQueue for each worker to consume.
 // When the worker pops this control indicator, it will shut itself down gracefully.
 Status NonMappableLeafOp::PostEndOfData() {
@@ -244,6 +268,25 @@ bool NonMappableLeafOp::NeedPushFileToBlockQueue(const std::string &file_name, i
   return push;
 }
 
+Status NonMappableLeafOp::GetState(const RowState &state, nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  constexpr size_t kCursorSize = 2;
+  CHECK_FAIL_RETURN_UNEXPECTED(state.cursor.size() == kCursorSize, "Invalid state of " + Name() + ".");
+  (*out_json)["eoes"] = state.cursor[0];
+  (*out_json)["rows"] = state.cursor[1];
+  return Status::OK();
+}
+
+Status NonMappableLeafOp::RestoreState(const nlohmann::json &state) {
+  CHECK_FAIL_RETURN_UNEXPECTED(state.contains("eoes") && state.contains("rows"), "Invalid state of " + Name() + ".");
+  restored_eoes_ = state["eoes"].get<int32_t>();
+  restored_rows_ = state["rows"].get<int64_t>();
+  CHECK_FAIL_RETURN_UNEXPECTED(restored_eoes_ >= 0 && restored_rows_ >= 0, "Invalid state of " + Name() + ".");
+  return Status::OK();
+}
+
+int32_t NonMappableLeafOp::RestoreRepeats(int32_t num_eoes) { return DatasetOp::RestoreRepeats(restored_eoes_); }
+
 void NonMappableLeafOp::ShuffleKeys(std::vector<int64_t> *i_keys, uint32_t seed) {
   std::mt19937 rng(seed);
   std::shuffle(i_keys->begin(), i_keys->end(), rng);
@@ -260,6 +303,10 @@ Status NonMappableLeafOp::WaitToFillIOBlockQueue() {
     }
   }
   uint32_t seed = 0;
+  // The files of each epoch before the restored state are shuffled the same way, to read them in the same order
+  for (int32_t i = 0; shuffle_files_ && i < restored_eoes_; ++i) {
+    ShuffleKeys(&i_keys, num_devices_ == 1 ? GetSeed() : ++seed);
+  }
   while (true) {
     RETURN_IF_NOT_OK(io_block_queue_wait_post_.Wait());
     io_block_queue_wait_post_.Clear();
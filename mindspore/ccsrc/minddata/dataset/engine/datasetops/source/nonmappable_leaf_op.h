@@ -24,6 +24,7 @@
 #include <map>
 
 #include "minddata/dataset/util/wait_post.h"
+#include "minddata/dataset/util/async_file_reader.h"
 #include "minddata/dataset/util/auto_index.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/core/tensor.h"
@@ -79,6 +80,23 @@ class NonMappableLeafOp : public ParallelOp<std::unique_ptr<IOBlock>, TensorRow>
   // @return Name of the current Op
   std::string Name() const override { return "NonMappableLeafOp"; }
 
+  // Gives the number of eoe and rows sent before a row. On restore, the order of the files is replayed and the rows
+  // sent in the restored epoch are read again and dropped.
+  // @param state - the state put on the row.
+  // @param out_json - the state of the operator.
+  // @return Status - the error code returned.
+  Status GetState(const RowState &state, nlohmann::json *out_json) override;
+
+  // Restores the operator to a state given by GetState.
+  // @param state - the state of the operator.
+  // @return Status - the error code returned.
+  Status RestoreState(const nlohmann::json &state) override;
+
+  // Sets the repeat counters from the restored number of eoe messages, as the operator is a leaf.
+  // @param num_eoes - unused.
+  // @return The restored number of eoe messages.
+  int32_t RestoreRepeats(int32_t num_eoes) override;
+
  protected:
   // The entry point for when workers are launched.
   // @param worker_id - the id of the worker that is executing this function.
@@ -122,6 +140,12 @@ class NonMappableLeafOp : public ParallelOp<std::unique_ptr<IOBlock>, TensorRow>
   // @return Status - the error code returned.
   virtual Status LoadFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id) = 0;
 
+  // Opens a file for LoadFile. The file is read ahead of the parser when async_read_depth is set.
+  // @param file - the real path of the file.
+  // @param reader - the opened reader.
+  // @return Status - the error code returned.
+  Status OpenFileReader(const std::string &file, std::unique_ptr<AsyncFileReader> *reader);
+
   // Select file and push it to the block queue.
   // @param file_name - File name.
   // @param start_file - If file contains the first sample of data.
@@ -159,6 +183,10 @@ class NonMappableLeafOp : public ParallelOp<std::unique_ptr<IOBlock>, TensorRow>
   bool shuffle_files_;
   int64_t num_rows_per_shard_;
   int64_t num_rows_;
+  int32_t async_read_depth_;                      // reads in flight per file, 0 to read synchronously
+  std::shared_ptr<IoThreadPool> io_thread_pool_;  // issues the reads when io_uring is not available
+  int32_t restored_eoes_ = 0;                     // number of eoe sent before the restored state
+  int64_t restored_rows_ = 0;                     // number of rows sent after the last eoe before the restored state
 };
 }  // namespace dataset
 }  // namespace mindspore
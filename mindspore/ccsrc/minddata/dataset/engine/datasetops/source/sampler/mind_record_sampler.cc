@@ -23,7 +23,7 @@
 namespace mindspore {
 namespace dataset {
 MindRecordSamplerRT::MindRecordSamplerRT(mindrecord::ShardReader *shard_reader, int64_t samples_per_tensor)
-    : SamplerRT(0, samples_per_tensor), shard_reader_(shard_reader), sample_ids_(nullptr), next_id_(0) {}
+    : SamplerRT(0, samples_per_tensor), shard_reader_(shard_reader), next_id_(0) {}
 
 Status MindRecordSamplerRT::GetNextSample(TensorRow *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
@@ -39,7 +39,7 @@ Status MindRecordSamplerRT::GetNextSample(TensorRow *out) {
     RETURN_IF_NOT_OK(CreateSamplerTensor(&sampleIdsTensor, last_id - next_id_));
     auto id_ptr = sampleIdsTensor->begin<int64_t>();
     for (int64_t i = 0; i < (last_id - next_id_); i++) {
-      *(id_ptr + static_cast<ptrdiff_t>(i)) = (*sample_ids_)[i];
+      *(id_ptr + static_cast<ptrdiff_t>(i)) = shard_reader_->GetSampleId(next_id_ + i);
     }
     next_id_ = last_id;
 
@@ -49,17 +49,16 @@ Status MindRecordSamplerRT::GetNextSample(TensorRow *out) {
 }
 
 Status MindRecordSamplerRT::InitSampler() {
-  sample_ids_ = shard_reader_->GetSampleIds();
-  if (!sample_ids_) {
-    // Note, sample_ids_.empty() is okay and will just give no sample ids.
+  if (shard_reader_ == nullptr) {
     RETURN_STATUS_UNEXPECTED(
-      "[Internal ERROR]Init Sampler failed as sample_ids is empty, here ShardReader did not provide a valid sample ids "
-      "vector via MindRecordSamplerRT.");
+      "[Internal ERROR]Init Sampler failed as ShardReader is null, here ShardReader did not provide the sample ids "
+      "via MindRecordSamplerRT.");
   }
 
   // Usually, the num samples is given from the user interface. In our case, that data is in mindrecord.
-  // Mindrecord already created the sample ids at this point, so the num samples is the size of the sampled id list.
-  num_samples_ = sample_ids_->size();
+  // Mindrecord already did the sampling at this point, so the num samples is the number of sampled ids, which
+  // the partial shuffle computes on demand instead of keeping in a list.
+  num_samples_ = shard_reader_->GetSampleCount();
   return Status::OK();
 }
 
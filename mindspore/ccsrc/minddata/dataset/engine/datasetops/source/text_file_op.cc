@@ -84,16 +84,13 @@ Status TextFileOp::LoadFile(const std::string &file, int64_t start_offset, int64
     RETURN_STATUS_UNEXPECTED("Invalid file path, " + file + " does not exist.");
   }
 
-  std::ifstream handle(realpath.value());
-  if (!handle.is_open()) {
-    RETURN_STATUS_UNEXPECTED("Invalid file, failed to open text:" + file +
-                             ", the file is damaged or permission denied.");
-  }
+  std::unique_ptr<AsyncFileReader> handle;
+  RETURN_IF_NOT_OK(OpenFileReader(realpath.value(), &handle));
 
   int64_t rows_total = 0;
   std::string line;
 
-  while (getline(handle, line)) {
+  while (handle->GetLine(&line)) {
     if (line.empty()) {
       continue;
     }
@@ -115,7 +112,7 @@ Status TextFileOp::LoadFile(const std::string &file, int64_t start_offset, int64
     rows_total++;
   }
 
-  return Status::OK();
+  return handle->GetError();
 }
 
 Status TextFileOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
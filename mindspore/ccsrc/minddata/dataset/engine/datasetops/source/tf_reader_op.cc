@@ -232,16 +232,13 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
     RETURN_STATUS_UNEXPECTED("Invalid file path, " + filename + " does not exist.");
   }
 
-  std::ifstream reader;
-  reader.open(realpath.value());
-  if (!reader) {
-    RETURN_STATUS_UNEXPECTED("Invalid file, " + filename + " open failed: permission denied!");
-  }
+  std::unique_ptr<AsyncFileReader> reader;
+  RETURN_IF_NOT_OK(OpenFileReader(realpath.value(), &reader));
 
   int64_t rows_read = 0;
   int64_t rows_total = 0;
 
-  while (reader.peek() != EOF) {
+  while (reader->Peek() != AsyncFileReader::kEof) {
     if (!load_jagged_connector_) {
       break;
     }
@@ -249,15 +246,15 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
 
     // read length
     int64_t record_length = 0;
-    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
+    (void)reader->Read(reinterpret_cast<char *>(&record_length), static_cast<int64_t>(sizeof(int64_t)));
 
     // ignore crc header
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
+    (void)reader->Ignore(static_cast<int64_t>(sizeof(int32_t)));
 
     // read serialized Example
     std::string serialized_example;
     serialized_example.resize(record_length);
-    (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
+    (void)reader->Read(&serialized_example[0], record_length);
 
     int32_t num_columns = data_schema_->NumColumns();
     TensorRow newRow(num_columns, nullptr);
@@ -278,11 +275,11 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
     }
 
     // ignore crc footer
-    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
+    (void)reader->Ignore(static_cast<int64_t>(sizeof(int32_t)));
     rows_total++;
   }
 
-  return Status::OK();
+  return reader->GetError();
 }
 
 // Parses a single row and puts the data into a tensor table.
@@ -42,15 +42,40 @@ ExecutionTree::ExecutionTree(std::shared_ptr<ConfigManager> cfg)
   tg_ = std::make_unique<TaskGroup>();
   root_ = nullptr;
   unique_id_ = Services::GetUniqueID();
+  CreateTensorPool(cfg->tensor_pool_size());
 }
 #else
 ExecutionTree::ExecutionTree() : id_count_(0), tree_state_(kDeTStateInit), prepare_flags_(0) {
   tg_ = std::make_unique<TaskGroup>();
   root_ = nullptr;
   unique_id_ = Services::GetUniqueID();
+  CreateTensorPool(GlobalContext::config_manager()->tensor_pool_size());
 }
 #endif
 
+void ExecutionTree::CreateTensorPool(int32_t pool_size) {
+  if (pool_size <= 0) {
+    return;
+  }
+  constexpr uint64_t kBytesPerMB = 1024 * 1024;
+  tensor_pool_ = std::make_shared<TensorBufferPool>(static_cast<uint64_t>(pool_size) * kBytesPerMB);
+  // The buffers outlive the tree if the rows are still referenced, they hold the pool until they are freed
+  tg_->SetMemoryPool(tensor_pool_);
+  MS_LOG(INFO) << "Tensors of tree " << unique_id_ << " are allocated from a pool of " << pool_size << " MB.";
+}
+
+void ExecutionTree::EnableStateHistory(int32_t size) {
+  if (size > 0 && tree_state_ == kDeTStateInit) {
+    state_history_ = std::make_shared<StateHistory>(size);
+  }
+}
+
+void ExecutionTree::RecordRowState(const TensorRow &row) {
+  if (state_history_ != nullptr) {
+    state_history_->Record(row);
+  }
+}
+
 // Destructor
 ExecutionTree::~ExecutionTree() {
 #ifdef WITH_BACKEND
@@ -91,6 +116,12 @@ Status ExecutionTree::AssociateNode(const std::shared_ptr<DatasetOp> &op) {
 
   // Assign our tree into the op so that each op has a link back to the tree
   op->set_tree(this);
+
+  // The operators put their state on the rows only if the tree keeps it
+  if (state_history_ != nullptr) {
+    op->track_state_ = true;
+    state_history_->AddOp(op.get());
+  }
   return Status::OK();
 }
 
@@ -28,7 +28,9 @@
 #endif
 #endif
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
+#include "minddata/dataset/engine/pipeline_state.h"
 #include "minddata/dataset/util/status.h"
+#include "minddata/dataset/util/tensor_buffer_pool.h"
 #ifndef ENABLE_SECURITY
 #include "mindspore/ccsrc/minddata/dataset/engine/perf/profiling.h"
 #endif
@@ -220,6 +222,22 @@ class ExecutionTree {
   /// \return unique ID as a string
   std::string GetUniqueId() { return unique_id_; }
 
+  /// \brief Getter method
+  /// \return the pool the tensors created by the tree are allocated from, nullptr if tensors are not pooled
+  std::shared_ptr<TensorBufferPool> TensorPool() const { return tensor_pool_; }
+
+  /// \brief Getter method
+  /// \return the states of the rows sent to the consumer, nullptr if the states are not kept
+  std::shared_ptr<StateHistory> state_history() const { return state_history_; }
+
+  /// \brief Keeps the states of the rows sent to the consumer. Must be called before any node is added.
+  /// \param size - the number of steps whose state is kept
+  void EnableStateHistory(int32_t size);
+
+  /// \brief Keeps the state of a row sent to the consumer, if the states are kept
+  /// \param row - the row sent to the consumer
+  void RecordRowState(const TensorRow &row);
+
  private:
   /// \brief A helper functions for doing the recursive printing
   /// \param dataset_op - The dataset op to print
@@ -229,12 +247,18 @@ class ExecutionTree {
   void PrintNode(std::ostream &out, const std::shared_ptr<DatasetOp> &dataset_op, std::string indent, bool last,
                  bool detailed) const;
 
+  /// \brief Creates the pool of the tensors created by the tasks of the tree, if tensors are pooled
+  /// \param pool_size - the size of the pool in MB, 0 to use the global memory pool
+  void CreateTensorPool(int32_t pool_size);
+
   std::unique_ptr<TaskGroup> tg_;    // Class for worker management
   std::shared_ptr<DatasetOp> root_;  // The root node of the tree
   int32_t id_count_;                 // Counter for generating operator id's
   uint32_t prepare_flags_;           // Flags used during tree prepare
   TreeState tree_state_;             // Tracking the current tree state
   std::string unique_id_;            // A unique identifier for the tree
+  std::shared_ptr<TensorBufferPool> tensor_pool_;  // The pool the tensors of the tree are allocated from
+  std::shared_ptr<StateHistory> state_history_;    // The states of the rows sent to the consumer
 
 #ifdef WITH_BACKEND
   // Constructor for if defined(ENABLE_GPUQUE) || defined(ENABLE_TDTQUE)
@@ -0,0 +1,562 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_csr.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#include "minddata/dataset/core/tensor.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+namespace {
+constexpr char kCsrMagic[] = "MDGNNCSR";
+constexpr size_t kCsrMagicSize = 8;
+constexpr size_t kCsrPrefixSize = kCsrMagicSize + sizeof(uint64_t);
+constexpr size_t kCsrAlignment = 64;
+constexpr int32_t kCsrVersion = 1;
+
+size_t AlignUp(size_t size) { return (size + kCsrAlignment - 1) / kCsrAlignment * kCsrAlignment; }
+
+// The arrays of an image being built, referring to buffers owned by the caller
+class ImageWriter {
+ public:
+  template <typename T>
+  void Add(const std::string &name, const std::vector<T> &array) {
+    sections_.push_back({name, array.data(), array.size() * sizeof(T)});
+  }
+
+  void Add(const std::string &name, const void *data, size_t size) { sections_.push_back({name, data, size}); }
+
+  // Lay the header and the arrays out in one image
+  Status Finish(mindrecord::json *header, std::vector<uint8_t> *image) {
+    size_t offset = 0;
+    for (const auto &section : sections_) {
+      (*header)["sections"][section.name] = {offset, section.size};
+      offset = AlignUp(offset + section.size);
+    }
+    std::string text = header->dump();
+    size_t data_start = AlignUp(kCsrPrefixSize + text.size());
+    image->assign(data_start + offset, 0);
+    uint64_t text_size = text.size();
+    (void)std::copy(kCsrMagic, kCsrMagic + kCsrMagicSize, image->begin());
+    (void)std::memcpy(image->data() + kCsrMagicSize, &text_size, sizeof(text_size));
+    (void)std::copy(text.begin(), text.end(), image->begin() + kCsrPrefixSize);
+    for (const auto &section : sections_) {
+      auto pos = (*header)["sections"][section.name][0].get<size_t>();
+      if (section.size > 0) {
+        (void)std::memcpy(image->data() + data_start + pos, section.data, section.size);
+      }
+    }
+    return Status::OK();
+  }
+
+ private:
+  struct Section {
+    std::string name;
+    const void *data;
+    size_t size;
+  };
+  std::vector<Section> sections_;
+};
+
+// Map ids to rows, keeping the first row of an id loaded several times as the id maps of GraphDataImpl do
+void BuildLookup(const std::vector<int32_t> &ids, std::vector<int32_t> *rows, mindrecord::json *jsn) {
+  bool direct = true;
+  int32_t min_id = 0;
+  if (!ids.empty()) {
+    auto min_max = std::minmax_element(ids.begin(), ids.end());
+    min_id = *min_max.first;
+    int64_t span = static_cast<int64_t>(*min_max.second) - min_id + 1;
+    // A table indexed by the id is at most twice the size of the sorted rows
+    direct = span <= static_cast<int64_t>(ids.size()) * 2;
+    if (direct) {
+      rows->assign(span, -1);
+      for (size_t i = ids.size(); i > 0; --i) {
+        (*rows)[ids[i - 1] - min_id] = static_cast<int32_t>(i - 1);
+      }
+    } else {
+      rows->resize(ids.size());
+      std::iota(rows->begin(), rows->end(), 0);
+      std::stable_sort(rows->begin(), rows->end(), [&ids](int32_t a, int32_t b) { return ids[a] < ids[b]; });
+    }
+  }
+  *jsn = {{"direct", direct}, {"min_id", min_id}, {"size", rows->size()}};
+}
+
+// Allocate a zero filled matrix for each feature type, the default feature giving its type and shape
+Status InitColumns(const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &features, int64_t num_rows,
+                   std::map<FeatureType, GraphCsr::FeatureColumn> *layouts,
+                   std::map<FeatureType, std::vector<uint8_t>> *columns) {
+  for (const auto &item : features) {
+    RETURN_UNEXPECTED_IF_NULL(item.second);
+    auto value = item.second->Value();
+    RETURN_UNEXPECTED_IF_NULL(value);
+    CHECK_FAIL_RETURN_UNEXPECTED(value->type().IsNumeric(),
+                                 "Invalid data, the csr graph storage only supports numeric features, but feature " +
+                                   std::to_string(item.first) + " is of type " + value->type().ToString() + ".");
+    GraphCsr::FeatureColumn column;
+    column.type = value->type();
+    column.shape = value->shape();
+    column.row_bytes = static_cast<size_t>(value->SizeInBytes());
+    (*layouts)[item.first] = column;
+    (*columns)[item.first].assign(column.row_bytes * num_rows, 0);
+  }
+  return Status::OK();
+}
+
+Status CopyFeature(const std::shared_ptr<Feature> &feature, const GraphCsr::FeatureColumn &column, int64_t row,
+                   std::vector<uint8_t> *data) {
+  auto value = feature->Value();
+  CHECK_FAIL_RETURN_UNEXPECTED(value->type() == column.type && value->shape() == column.shape,
+                               "Invalid data, the csr graph storage requires all the features " +
+                                 std::to_string(feature->type()) + " to be of the same type and shape, but got " +
+                                 value->type().ToString() + value->shape().ToString() + " and " +
+                                 column.type.ToString() + column.shape.ToString() + ".");
+  if (column.row_bytes > 0) {
+    (void)std::memcpy(data->data() + row * column.row_bytes, value->GetBuffer(), column.row_bytes);
+  }
+  return Status::OK();
+}
+
+mindrecord::json ColumnsToJson(const std::map<FeatureType, GraphCsr::FeatureColumn> &layouts) {
+  mindrecord::json jsn = mindrecord::json::object();
+  for (const auto &item : layouts) {
+    jsn[std::to_string(item.first)] = {{"type", item.second.type.ToString()},
+                                       {"shape", item.second.shape.AsVector()}};
+  }
+  return jsn;
+}
+}  // namespace
+
+Status GraphCsr::Build(std::vector<std::deque<std::shared_ptr<Node>>> *nodes,
+                       std::vector<std::deque<std::shared_ptr<Edge>>> *edges,
+                       const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &node_features,
+                       const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &edge_features,
+                       const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &graph_features,
+                       const mindrecord::json &meta, std::unique_ptr<GraphCsr> *out) {
+  RETURN_UNEXPECTED_IF_NULL(nodes);
+  RETURN_UNEXPECTED_IF_NULL(edges);
+  RETURN_UNEXPECTED_IF_NULL(out);
+  int64_t num_nodes = 0;
+  for (const auto &dq : *nodes) {
+    num_nodes += static_cast<int64_t>(dq.size());
+  }
+  int64_t num_edges = 0;
+  for (const auto &dq : *edges) {
+    num_edges += static_cast<int64_t>(dq.size());
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    num_nodes < std::numeric_limits<int32_t>::max() && num_edges < std::numeric_limits<int32_t>::max(),
+    "Invalid data, the csr graph storage supports less than 2^31 nodes and edges.");
+
+  // The nodes and their features
+  std::vector<NodeIdType> node_ids;
+  std::vector<NodeType> node_types;
+  node_ids.reserve(num_nodes);
+  node_types.reserve(num_nodes);
+  std::map<FeatureType, FeatureColumn> node_layouts;
+  std::map<FeatureType, std::vector<uint8_t>> node_columns;
+  RETURN_IF_NOT_OK(InitColumns(node_features, num_nodes, &node_layouts, &node_columns));
+  for (auto &dq : *nodes) {
+    while (!dq.empty()) {
+      std::shared_ptr<Node> node = dq.front();
+      auto row = static_cast<int64_t>(node_ids.size());
+      node_ids.push_back(node->id());
+      node_types.push_back(node->type());
+      for (const auto &layout : node_layouts) {
+        std::shared_ptr<Feature> feature;
+        if (node->GetFeatures(layout.first, &feature).IsOk()) {
+          RETURN_IF_NOT_OK(CopyFeature(feature, layout.second, row, &node_columns[layout.first]));
+        }
+      }
+      dq.pop_front();
+    }
+  }
+  std::vector<int32_t> node_lookup;
+  mindrecord::json node_lookup_jsn;
+  BuildLookup(node_ids, &node_lookup, &node_lookup_jsn);
+  IdLookup node_index;
+  node_index.direct = node_lookup_jsn["direct"].get<bool>();
+  node_index.min_id = node_lookup_jsn["min_id"].get<int32_t>();
+  node_index.size = static_cast<int64_t>(node_lookup.size());
+  node_index.rows = node_lookup.data();
+
+  // The edges and their features
+  std::vector<EdgeIdType> edge_ids;
+  std::vector<EdgeType> edge_types;
+  std::vector<NodeIdType> edge_src;
+  std::vector<NodeIdType> edge_dst;
+  std::vector<WeightType> edge_weights;
+  edge_ids.reserve(num_edges);
+  edge_types.reserve(num_edges);
+  edge_src.reserve(num_edges);
+  edge_dst.reserve(num_edges);
+  edge_weights.reserve(num_edges);
+  std::map<FeatureType, FeatureColumn> edge_layouts;
+  std::map<FeatureType, std::vector<uint8_t>> edge_columns;
+  RETURN_IF_NOT_OK(InitColumns(edge_features, num_edges, &edge_layouts, &edge_columns));
+  for (auto &dq : *edges) {
+    while (!dq.empty()) {
+      std::shared_ptr<Edge> edge = dq.front();
+      auto row = static_cast<int64_t>(edge_ids.size());
+      NodeIdType src_id, dst_id;
+      RETURN_IF_NOT_OK(edge->GetNode(&src_id, &dst_id));
+      CHECK_FAIL_RETURN_UNEXPECTED(
+        Lookup(node_index, node_ids.data(), num_nodes, src_id) >= 0,
+        "[Internal Error] src node with id '" + std::to_string(src_id) + "' has not been created yet.");
+      CHECK_FAIL_RETURN_UNEXPECTED(
+        Lookup(node_index, node_ids.data(), num_nodes, dst_id) >= 0,
+        "[Internal Error] dst node with id '" + std::to_string(dst_id) + "' has not been created yet.");
+      edge_ids.push_back(edge->id());
+      edge_types.push_back(edge->type());
+      edge_src.push_back(src_id);
+      edge_dst.push_back(dst_id);
+      edge_weights.push_back(edge->weight());
+      for (const auto &layout : edge_layouts) {
+        std::shared_ptr<Feature> feature;
+        if (edge->GetFeatures(layout.first, &feature).IsOk()) {
+          RETURN_IF_NOT_OK(CopyFeature(feature, layout.second, row, &edge_columns[layout.first]));
+        }
+      }
+      dq.pop_front();
+    }
+  }
+  std::vector<int32_t> edge_lookup;
+  mindrecord::json edge_lookup_jsn;
+  BuildLookup(edge_ids, &edge_lookup, &edge_lookup_jsn);
+
+  // The neighbors of each node type, in the order the edges were loaded in as LocalNode::AddNeighbor keeps them
+  std::map<NodeType, std::vector<int64_t>> offsets;
+  for (int64_t i = 0; i < num_edges; ++i) {
+    int64_t src_row = Lookup(node_index, node_ids.data(), num_nodes, edge_src[i]);
+    NodeType neighbor_type = node_types[Lookup(node_index, node_ids.data(), num_nodes, edge_dst[i])];
+    auto &type_offsets = offsets[neighbor_type];
+    if (type_offsets.empty()) {
+      type_offsets.assign(num_nodes + 1, 0);
+    }
+    ++type_offsets[src_row + 1];
+  }
+  std::map<NodeType, std::vector<int32_t>> neighbors;
+  std::map<NodeType, std::vector<WeightType>> weights;
+  std::map<NodeType, std::vector<EdgeIdType>> adjacent_edges;
+  std::map<NodeType, std::vector<int64_t>> cursors;
+  for (auto &item : offsets) {
+    std::partial_sum(item.second.begin(), item.second.end(), item.second.begin());
+    neighbors[item.first].resize(item.second.back());
+    weights[item.first].resize(item.second.back());
+    adjacent_edges[item.first].resize(item.second.back());
+    cursors[item.first] = item.second;
+  }
+  for (int64_t i = 0; i < num_edges; ++i) {
+    int64_t src_row = Lookup(node_index, node_ids.data(), num_nodes, edge_src[i]);
+    int64_t dst_row = Lookup(node_index, node_ids.data(), num_nodes, edge_dst[i]);
+    NodeType neighbor_type = node_types[dst_row];
+    int64_t pos = cursors[neighbor_type][src_row]++;
+    neighbors[neighbor_type][pos] = static_cast<int32_t>(dst_row);
+    weights[neighbor_type][pos] = edge_weights[i];
+    adjacent_edges[neighbor_type][pos] = edge_ids[i];
+  }
+  cursors.clear();
+
+  // The graph features, each a single row
+  std::map<FeatureType, FeatureColumn> graph_layouts;
+  for (const auto &item : graph_features) {
+    RETURN_UNEXPECTED_IF_NULL(item.second);
+    auto value = item.second->Value();
+    RETURN_UNEXPECTED_IF_NULL(value);
+    CHECK_FAIL_RETURN_UNEXPECTED(value->type().IsNumeric(),
+                                 "Invalid data, the csr graph storage only supports numeric features, but feature " +
+                                   std::to_string(item.first) + " is of type " + value->type().ToString() + ".");
+    FeatureColumn column;
+    column.type = value->type();
+    column.shape = value->shape();
+    column.data = value->GetBuffer();
+    column.row_bytes = static_cast<size_t>(value->SizeInBytes());
+    graph_layouts[item.first] = column;
+  }
+
+  ImageWriter writer;
+  writer.Add("node_ids", node_ids);
+  writer.Add("node_types", node_types);
+  writer.Add("node_lookup", node_lookup);
+  writer.Add("edge_ids", edge_ids);
+  writer.Add("edge_types", edge_types);
+  writer.Add("edge_src", edge_src);
+  writer.Add("edge_dst", edge_dst);
+  writer.Add("edge_lookup", edge_lookup);
+  std::vector<int32_t> adjacency_types;
+  for (const auto &item : offsets) {
+    std::string prefix = "adjacency_" + std::to_string(item.first);
+    adjacency_types.push_back(item.first);
+    writer.Add(prefix + "_offsets", item.second);
+    writer.Add(prefix + "_neighbors", neighbors[item.first]);
+    writer.Add(prefix + "_weights", weights[item.first]);
+    writer.Add(prefix + "_edges", adjacent_edges[item.first]);
+  }
+  for (const auto &item : node_columns) {
+    writer.Add("node_feature_" + std::to_string(item.first), item.second);
+  }
+  for (const auto &item : edge_columns) {
+    writer.Add("edge_feature_" + std::to_string(item.first), item.second);
+  }
+  for (const auto &item : graph_layouts) {
+    writer.Add("graph_feature_" + std::to_string(item.first), item.second.data, item.second.row_bytes);
+  }
+
+  mindrecord::json header;
+  header["version"] = kCsrVersion;
+  header["num_nodes"] = num_nodes;
+  header["num_edges"] = num_edges;
+  header["node_lookup"] = node_lookup_jsn;
+  header["edge_lookup"] = edge_lookup_jsn;
+  header["adjacency"] = adjacency_types;
+  header["node_features"] = ColumnsToJson(node_layouts);
+  header["edge_features"] = ColumnsToJson(edge_layouts);
+  header["graph_features"] = ColumnsToJson(graph_layouts);
+  header["meta"] = meta;
+
+  auto csr = std::make_unique<GraphCsr>();
+  RETURN_IF_NOT_OK(writer.Finish(&header, &csr->image_));
+  RETURN_IF_NOT_OK(csr->Parse(csr->image_.data(), csr->image_.size()));
+  MS_LOG(INFO) << "Graph stored in csr form, nodes: " << num_nodes << ", edges: " << num_edges
+               << ", bytes: " << csr->image_.size();
+  *out = std::move(csr);
+  return Status::OK();
+}
+
+Status GraphCsr::Load(const std::string &path, std::unique_ptr<GraphCsr> *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  auto csr = std::make_unique<GraphCsr>();
+#if !defined(_WIN32) && !defined(_WIN64)
+  RETURN_IF_NOT_OK(mindrecord::ShardMappedFile::Open(path, &csr->file_));
+  RETURN_IF_NOT_OK(csr->Parse(csr->file_->Data(), csr->file_->Size()));
+#else
+  std::ifstream fs(path, std::ios::in | std::ios::binary);
+  CHECK_FAIL_RETURN_UNEXPECTED(fs.is_open(), "Invalid file, failed to open graph snapshot file: " + path);
+  csr->image_.assign(std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>());
+  fs.close();
+  RETURN_IF_NOT_OK(csr->Parse(csr->image_.data(), csr->image_.size()));
+#endif
+  MS_LOG(INFO) << "Graph snapshot loaded from " << path << ", nodes: " << csr->num_nodes_
+               << ", edges: " << csr->num_edges_;
+  *out = std::move(csr);
+  return Status::OK();
+}
+
+Status GraphCsr::Save(const std::string &path) const {
+  // write to a temporary file first, a run mapping the snapshot never sees it partially written
+  std::string tmp_path = path + ".tmp";
+  std::ofstream fs(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED(fs.is_open(), "Invalid file, failed to open graph snapshot file: " + tmp_path);
+  (void)fs.write(reinterpret_cast<const char *>(data_), static_cast<std::streamsize>(size_));
+  bool failed = fs.fail();
+  fs.close();
+  if (failed || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    (void)std::remove(tmp_path.c_str());
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to write graph snapshot file: " + path);
+  }
+  MS_LOG(INFO) << "Graph snapshot saved to " << path << ", bytes: " << size_;
+  return Status::OK();
+}
+
+Status GraphCsr::Parse(const uint8_t *image, size_t size) {
+  CHECK_FAIL_RETURN_UNEXPECTED(size >= kCsrPrefixSize && std::equal(kCsrMagic, kCsrMagic + kCsrMagicSize, image),
+                               "Invalid file, the file is not a graph snapshot.");
+  uint64_t text_size = 0;
+  (void)std::memcpy(&text_size, image + kCsrMagicSize, sizeof(text_size));
+  CHECK_FAIL_RETURN_UNEXPECTED(text_size <= size - kCsrPrefixSize, "Invalid file, the graph snapshot is truncated.");
+  mindrecord::json header;
+  try {
+    header = mindrecord::json::parse(std::string(reinterpret_cast<const char *>(image + kCsrPrefixSize), text_size));
+    CHECK_FAIL_RETURN_UNEXPECTED(header["version"].get<int32_t>() == kCsrVersion,
+                                 "Invalid file, unsupported graph snapshot version: " + header["version"].dump());
+    size_t data_start = AlignUp(kCsrPrefixSize + text_size);
+    auto section = [&header, image, size, data_start](const std::string &name, size_t bytes,
+                                                      const void **out) -> Status {
+      auto itr = header["sections"].find(name);
+      CHECK_FAIL_RETURN_UNEXPECTED(itr != header["sections"].end(), "Invalid file, graph snapshot misses " + name);
+      auto offset = (*itr)[0].get<size_t>();
+      CHECK_FAIL_RETURN_UNEXPECTED((*itr)[1].get<size_t>() == bytes && data_start + offset + bytes <= size,
+                                   "Invalid file, graph snapshot has a wrong " + name);
+      *out = image + data_start + offset;
+      return Status::OK();
+    };
+    auto array = [&section](const std::string &name, size_t bytes, auto **out) -> Status {
+      const void *ptr = nullptr;
+      RETURN_IF_NOT_OK(section(name, bytes, &ptr));
+      *out = static_cast<std::remove_pointer_t<decltype(out)>>(ptr);
+      return Status::OK();
+    };
+    auto lookup = [&array](const mindrecord::json &jsn, const std::string &name, IdLookup *out) -> Status {
+      out->direct = jsn["direct"].get<bool>();
+      out->min_id = jsn["min_id"].get<int32_t>();
+      out->size = jsn["size"].get<int64_t>();
+      return array(name, out->size * sizeof(int32_t), &out->rows);
+    };
+    auto columns = [&section](const mindrecord::json &jsn, const std::string &prefix, int64_t num_rows,
+                              std::map<FeatureType, FeatureColumn> *out) -> Status {
+      for (auto itr = jsn.begin(); itr != jsn.end(); ++itr) {
+        FeatureColumn column;
+        column.type = DataType(itr.value()["type"].get<std::string>());
+        column.shape = TensorShape(itr.value()["shape"].get<std::vector<dsize_t>>());
+        column.row_bytes = static_cast<size_t>(column.shape.NumOfElements()) * column.type.SizeInBytes();
+        const void *ptr = nullptr;
+        RETURN_IF_NOT_OK(section(prefix + itr.key(), column.row_bytes * num_rows, &ptr));
+        column.data = static_cast<const uint8_t *>(ptr);
+        (*out)[static_cast<FeatureType>(std::stoi(itr.key()))] = column;
+      }
+      return Status::OK();
+    };
+
+    num_nodes_ = header["num_nodes"].get<int64_t>();
+    num_edges_ = header["num_edges"].get<int64_t>();
+    RETURN_IF_NOT_OK(array("node_ids", num_nodes_ * sizeof(NodeIdType), &node_ids_));
+    RETURN_IF_NOT_OK(array("node_types", num_nodes_ * sizeof(NodeType), &node_types_));
+    RETURN_IF_NOT_OK(lookup(header["node_lookup"], "node_lookup", &node_lookup_));
+    RETURN_IF_NOT_OK(array("edge_ids", num_edges_ * sizeof(EdgeIdType), &edge_ids_));
+    RETURN_IF_NOT_OK(array("edge_types", num_edges_ * sizeof(EdgeType), &edge_types_));
+    RETURN_IF_NOT_OK(array("edge_src", num_edges_ * sizeof(NodeIdType), &edge_src_));
+    RETURN_IF_NOT_OK(array("edge_dst", num_edges_ * sizeof(NodeIdType), &edge_dst_));
+    RETURN_IF_NOT_OK(lookup(header["edge_lookup"], "edge_lookup", &edge_lookup_));
+    for (const auto &type : header["adjacency"]) {
+      std::string prefix = "adjacency_" + std::to_string(type.get<int32_t>());
+      Adjacency adjacency;
+      RETURN_IF_NOT_OK(array(prefix + "_offsets", (num_nodes_ + 1) * sizeof(int64_t), &adjacency.offsets));
+      auto num_neighbors = static_cast<size_t>(adjacency.offsets[num_nodes_]);
+      RETURN_IF_NOT_OK(array(prefix + "_neighbors", num_neighbors * sizeof(int32_t), &adjacency.neighbors));
+      RETURN_IF_NOT_OK(array(prefix + "_weights", num_neighbors * sizeof(WeightType), &adjacency.weights));
+      RETURN_IF_NOT_OK(array(prefix + "_edges", num_neighbors * sizeof(EdgeIdType), &adjacency.edges));
+      adjacency_[static_cast<NodeType>(type.get<int32_t>())] = adjacency;
+    }
+    RETURN_IF_NOT_OK(columns(header["node_features"], "node_feature_", num_nodes_, &node_features_));
+    RETURN_IF_NOT_OK(columns(header["edge_features"], "edge_feature_", num_edges_, &edge_features_));
+    RETURN_IF_NOT_OK(columns(header["graph_features"], "graph_feature_", 1, &graph_features_));
+    meta_ = header["meta"];
+  } catch (const std::exception &e) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse the header of the graph snapshot: " +
+                             std::string(e.what()));
+  }
+  data_ = image;
+  size_ = size;
+  return Status::OK();
+}
+
+int64_t GraphCsr::Lookup(const IdLookup &lookup, const int32_t *ids, int64_t num, int32_t id) {
+  if (lookup.direct) {
+    int64_t index = static_cast<int64_t>(id) - lookup.min_id;
+    return index >= 0 && index < lookup.size ? lookup.rows[index] : -1;
+  }
+  const int32_t *itr = std::lower_bound(lookup.rows, lookup.rows + num, id,
+                                        [ids](int32_t row, int32_t value) { return ids[row] < value; });
+  return itr != lookup.rows + num && ids[*itr] == id ? *itr : -1;
+}
+
+const GraphCsr::Adjacency *GraphCsr::GetAdjacency(NodeType neighbor_type) const {
+  auto itr = adjacency_.find(neighbor_type);
+  return itr == adjacency_.end() ? nullptr : &itr->second;
+}
+
+void GraphCsr::GetAllNeighbors(int64_t row, NodeType neighbor_type, std::vector<NodeIdType> *out,
+                               bool exclude_itself) const {
+  out->clear();
+  if (!exclude_itself) {
+    out->push_back(node_ids_[row]);
+  }
+  const Adjacency *adjacency = GetAdjacency(neighbor_type);
+  if (adjacency == nullptr) {
+    return;
+  }
+  for (int64_t i = adjacency->offsets[row]; i < adjacency->offsets[row + 1]; ++i) {
+    out->push_back(node_ids_[adjacency->neighbors[i]]);
+  }
+}
+
+Status GraphCsr::SampleNeighbors(int64_t row, NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
+                                 std::mt19937 *rnd, std::vector<int32_t> *scratch,
+                                 std::vector<NodeIdType> *out) const {
+  const Adjacency *adjacency = GetAdjacency(neighbor_type);
+  int64_t begin = adjacency == nullptr ? 0 : adjacency->offsets[row];
+  int64_t degree = adjacency == nullptr ? 0 : adjacency->offsets[row + 1] - begin;
+  if (degree == 0) {
+    MS_LOG(DEBUG) << "There are no neighbors. node_id:" << node_ids_[row] << " neighbor_type:" << neighbor_type;
+    // If there are no neighbors, they are filled with kDefaultNodeId
+    out->insert(out->end(), samples_num, kDefaultNodeId);
+    return Status::OK();
+  }
+  const int32_t *neighbors = adjacency->neighbors + begin;
+  if (strategy == SamplingStrategy::kRandom) {
+    // Each round draws distinct neighbors with a partial Fisher-Yates shuffle, until enough are drawn
+    int32_t remaining = samples_num;
+    while (remaining > 0) {
+      int64_t take = std::min<int64_t>(remaining, degree);
+      scratch->resize(degree);
+      std::iota(scratch->begin(), scratch->end(), 0);
+      for (int64_t i = 0; i < take; ++i) {
+        std::uniform_int_distribution<int64_t> dist(i, degree - 1);
+        std::swap((*scratch)[i], (*scratch)[dist(*rnd)]);
+        out->push_back(node_ids_[neighbors[(*scratch)[i]]]);
+      }
+      remaining -= static_cast<int32_t>(take);
+    }
+  } else if (strategy == SamplingStrategy::kEdgeWeight) {
+    const WeightType *weights = adjacency->weights + begin;
+    std::discrete_distribution<int64_t> dist(weights, weights + degree);
+    for (int32_t i = 0; i < samples_num; ++i) {
+      out->push_back(node_ids_[neighbors[dist(*rnd)]]);
+    }
+  } else {
+    RETURN_STATUS_UNEXPECTED("Invalid strategy");
+  }
+  return Status::OK();
+}
+
+EdgeIdType GraphCsr::GetEdgeByAdjNodeId(int64_t src_row, NodeIdType dst_id) const {
+  int64_t dst_row = NodeRow(dst_id);
+  if (dst_row < 0) {
+    return -1;
+  }
+  const Adjacency *adjacency = GetAdjacency(node_types_[dst_row]);
+  if (adjacency == nullptr) {
+    return -1;
+  }
+  for (int64_t i = adjacency->offsets[src_row]; i < adjacency->offsets[src_row + 1]; ++i) {
+    if (adjacency->neighbors[i] == dst_row) {
+      return adjacency->edges[i];
+    }
+  }
+  return -1;
+}
+
+const GraphCsr::FeatureColumn *GraphCsr::GetNodeFeature(FeatureType type) const {
+  auto itr = node_features_.find(type);
+  return itr == node_features_.end() ? nullptr : &itr->second;
+}
+
+const GraphCsr::FeatureColumn *GraphCsr::GetEdgeFeature(FeatureType type) const {
+  auto itr = edge_features_.find(type);
+  return itr == edge_features_.end() ? nullptr : &itr->second;
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/core/tensor_shape.h"
+#include "minddata/dataset/engine/gnn/edge.h"
+#include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/status.h"
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_mapped_file.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+// Compact storage of a whole graph in contiguous arrays, in place of a Node and an Edge object per node and edge.
+//   - the nodes and the edges are rows of their arrays, kept in the order they were loaded in
+//   - the neighbors of each neighbor node type are in CSR form: num_nodes + 1 offsets into flat arrays holding the
+//     row of each neighbor, the weight and the id of the edge to it
+//   - each node or edge feature type is a matrix with a row per node or edge, zero where the feature is missing,
+//     which is also the default feature
+//   - ids are mapped to rows by a table indexed by the id when the ids are dense, by binary search otherwise
+// All the arrays live in one image behind a json header. The image is also the layout of the snapshot file, so a
+// snapshot is used in place through mmap rather than loaded.
+class GraphCsr {
+ public:
+  // The CSR arrays of the neighbors of one node type
+  struct Adjacency {
+    const int64_t *offsets = nullptr;
+    const int32_t *neighbors = nullptr;
+    const WeightType *weights = nullptr;
+    const EdgeIdType *edges = nullptr;
+  };
+
+  // A feature type stored as a matrix
+  struct FeatureColumn {
+    DataType type;
+    TensorShape shape = TensorShape::CreateScalar();  // Shape of the feature of one row
+    const uint8_t *data = nullptr;
+    size_t row_bytes = 0;
+  };
+
+  GraphCsr() = default;
+
+  ~GraphCsr() = default;
+
+  // Build the storage of the nodes and edges produced by a graph loader
+  // @param std::vector<std::deque<std::shared_ptr<Node>>> *nodes - The nodes, emptied as they are stored
+  // @param std::vector<std::deque<std::shared_ptr<Edge>>> *edges - The edges, emptied as they are stored
+  // @param std::unordered_map<FeatureType, std::shared_ptr<Feature>> &node_features - Default feature of each node
+  //     feature type, which gives the type and shape of its column
+  // @param std::unordered_map<FeatureType, std::shared_ptr<Feature>> &edge_features - Same for the edge features
+  // @param std::unordered_map<FeatureType, std::shared_ptr<Feature>> &graph_features - The graph features
+  // @param mindrecord::json &meta - Information kept as is in the image for its user
+  // @param std::unique_ptr<GraphCsr> *out - The storage built
+  // @return Status The status code returned
+  static Status Build(std::vector<std::deque<std::shared_ptr<Node>>> *nodes,
+                      std::vector<std::deque<std::shared_ptr<Edge>>> *edges,
+                      const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &node_features,
+                      const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &edge_features,
+                      const std::unordered_map<FeatureType, std::shared_ptr<Feature>> &graph_features,
+                      const mindrecord::json &meta, std::unique_ptr<GraphCsr> *out);
+
+  // Map a snapshot file written by Save, the arrays are read from the file on demand
+  // @param std::string &path - The snapshot file
+  // @param std::unique_ptr<GraphCsr> *out - The storage loaded
+  // @return Status The status code returned
+  static Status Load(const std::string &path, std::unique_ptr<GraphCsr> *out);
+
+  // Write the image to a snapshot file
+  // @param std::string &path - The snapshot file
+  // @return Status The status code returned
+  Status Save(const std::string &path) const;
+
+  int64_t num_nodes() const { return num_nodes_; }
+
+  int64_t num_edges() const { return num_edges_; }
+
+  // @return int64_t - The row of a node, -1 if there is no such node
+  int64_t NodeRow(NodeIdType id) const { return Lookup(node_lookup_, node_ids_, num_nodes_, id); }
+
+  // @return int64_t - The row of an edge, -1 if there is no such edge
+  int64_t EdgeRow(EdgeIdType id) const { return Lookup(edge_lookup_, edge_ids_, num_edges_, id); }
+
+  NodeIdType NodeId(int64_t row) const { return node_ids_[row]; }
+
+  NodeType GetNodeType(int64_t row) const { return node_types_[row]; }
+
+  EdgeIdType EdgeId(int64_t row) const { return edge_ids_[row]; }
+
+  EdgeType GetEdgeType(int64_t row) const { return edge_types_[row]; }
+
+  // @return NodeIdType - The source node of an edge
+  NodeIdType EdgeSrc(int64_t row) const { return edge_src_[row]; }
+
+  // @return NodeIdType - The destination node of an edge
+  NodeIdType EdgeDst(int64_t row) const { return edge_dst_[row]; }
+
+  // @param NodeType neighbor_type - Type of the neighbors
+  // @return const Adjacency * - The neighbors of that type, nullptr if no node has any
+  const Adjacency *GetAdjacency(NodeType neighbor_type) const;
+
+  // Get the neighbors of a node, the same as LocalNode::GetAllNeighbors
+  // @param int64_t row - Row of the node
+  // @param NodeType neighbor_type - Type of the neighbors
+  // @param std::vector<NodeIdType> *out - Returned neighbors id
+  // @param bool exclude_itself - Whether the node itself comes first in the output
+  void GetAllNeighbors(int64_t row, NodeType neighbor_type, std::vector<NodeIdType> *out, bool exclude_itself) const;
+
+  // Sample the neighbors of a node, the same way as LocalNode::GetSampledNeighbors, appending them to the output
+  // @param int64_t row - Row of the node
+  // @param NodeType neighbor_type - Type of the neighbors
+  // @param int32_t samples_num - Number of neighbors to be acquired
+  // @param SamplingStrategy strategy - Sampling strategy
+  // @param std::mt19937 *rnd - The random generator
+  // @param std::vector<int32_t> *scratch - A buffer reused from call to call
+  // @param std::vector<NodeIdType> *out - Returned neighbors id
+  // @return Status The status code returned
+  Status SampleNeighbors(int64_t row, NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
+                         std::mt19937 *rnd, std::vector<int32_t> *scratch, std::vector<NodeIdType> *out) const;
+
+  // Find the edge from a node to another one, the same as LocalNode::GetEdgeByAdjNodeId
+  // @param int64_t src_row - Row of the source node
+  // @param NodeIdType dst_id - The destination node
+  // @return EdgeIdType - The edge, -1 if the nodes are not adjacent
+  EdgeIdType GetEdgeByAdjNodeId(int64_t src_row, NodeIdType dst_id) const;
+
+  // @return const FeatureColumn * - The column of a node feature type, nullptr if there is none
+  const FeatureColumn *GetNodeFeature(FeatureType type) const;
+
+  // @return const FeatureColumn * - The column of an edge feature type, nullptr if there is none
+  const FeatureColumn *GetEdgeFeature(FeatureType type) const;
+
+  const std::map<FeatureType, FeatureColumn> &node_features() const { return node_features_; }
+
+  const std::map<FeatureType, FeatureColumn> &edge_features() const { return edge_features_; }
+
+  // The graph features, as columns of a single row
+  const std::map<FeatureType, FeatureColumn> &graph_features() const { return graph_features_; }
+
+  const mindrecord::json &meta() const { return meta_; }
+
+ private:
+  // How ids are mapped to rows
+  struct IdLookup {
+    bool direct = true;
+    int32_t min_id = 0;
+    int64_t size = 0;
+    const int32_t *rows = nullptr;  // indexed by id - min_id when direct, rows sorted by id otherwise
+  };
+
+  static int64_t Lookup(const IdLookup &lookup, const int32_t *ids, int64_t num, int32_t id);
+
+  // Set the arrays up from an image
+  // @param const uint8_t *image - Start of the image
+  // @param size_t size - Size of the image
+  // @return Status The status code returned
+  Status Parse(const uint8_t *image, size_t size);
+
+  std::vector<uint8_t> image_;                         // The image when it is built or read
+  std::shared_ptr<mindrecord::ShardMappedFile> file_;  // The image when it is mapped
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+
+  mindrecord::json meta_;
+  int64_t num_nodes_ = 0;
+  int64_t num_edges_ = 0;
+  const NodeIdType *node_ids_ = nullptr;
+  const NodeType *node_types_ = nullptr;
+  IdLookup node_lookup_;
+  const EdgeIdType *edge_ids_ = nullptr;
+  const EdgeType *edge_types_ = nullptr;
+  const NodeIdType *edge_src_ = nullptr;
+  const NodeIdType *edge_dst_ = nullptr;
+  IdLookup edge_lookup_;
+  std::unordered_map<NodeType, Adjacency> adjacency_;
+  std::map<FeatureType, FeatureColumn> node_features_;
+  std::map<FeatureType, FeatureColumn> edge_features_;
+  std::map<FeatureType, FeatureColumn> graph_features_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_CSR_H_
@@ -97,6 +97,20 @@ class GraphData {
                                      const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy,
                                      std::shared_ptr<Tensor> *out) = 0;
 
+  // Get sampled neighbors and the features of all the nodes sampled, in one call.
+  // @param std::vector<NodeType> node_list - List of nodes
+  // @param std::vector<NodeIdType> neighbor_nums - Number of neighbors sampled per hop
+  // @param std::vector<NodeType> neighbor_types - Neighbor type sampled per hop
+  // @param std::SamplingStrategy strategy - Sampling strategy
+  // @param std::vector<FeatureType> feature_types - Types of node features
+  // @param TensorRow *out - Returned neighbor's id, followed by a feature tensor per feature type with the features
+  //     of each of them, the default feature for the padding ids.
+  // @return Status The status code returned
+  virtual Status GetSampledSubgraph(const std::vector<NodeIdType> &node_list,
+                                    const std::vector<NodeIdType> &neighbor_nums,
+                                    const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy,
+                                    const std::vector<FeatureType> &feature_types, TensorRow *out) = 0;
+
   // Get negative sampled neighbors.
   // @param std::vector<NodeType> node_list - List of nodes
   // @param NodeIdType samples_num - Number of neighbors sampled
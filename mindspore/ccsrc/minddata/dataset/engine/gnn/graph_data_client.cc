@@ -197,6 +197,51 @@ Status GraphDataClient::GetSampledNeighbors(const std::vector<NodeIdType> &node_
   return Status::OK();
 }
 
+Status GraphDataClient::GetSampledSubgraph(const std::vector<NodeIdType> &node_list,
+                                           const std::vector<NodeIdType> &neighbor_nums,
+                                           const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy,
+                                           const std::vector<FeatureType> &feature_types, TensorRow *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+#if !defined(_WIN32) && !defined(_WIN64)
+  CHECK_FAIL_RETURN_UNEXPECTED(!feature_types.empty(), "Input feature_types is empty");
+  GnnGraphDataRequestPb request;
+  GnnGraphDataResponsePb response;
+  request.set_op_name(GET_SAMPLED_SUBGRAPH);
+  for (const auto &node_id : node_list) {
+    request.add_id(static_cast<google::protobuf::int32>(node_id));
+  }
+  for (const auto &num : neighbor_nums) {
+    request.add_number(static_cast<google::protobuf::int32>(num));
+  }
+  for (const auto &type : neighbor_types) {
+    request.add_type(static_cast<google::protobuf::int32>(type));
+  }
+  for (const auto &type : feature_types) {
+    request.add_feature_type(static_cast<google::protobuf::int32>(type));
+  }
+  request.set_strategy(static_cast<google::protobuf::int32>(strategy));
+  RETURN_IF_NOT_OK(GetGraphData(request, &response));
+  CHECK_FAIL_RETURN_UNEXPECTED(feature_types.size() + 1 == response.result_data().size(),
+                               "RPC failed: The number of returned tensor is abnormal");
+  // The neighbors come first, then where the features of each type are in the shared memory
+  std::shared_ptr<Tensor> neighbors;
+  RETURN_IF_NOT_OK(PbToTensor(&response.result_data()[0], &neighbors));
+  TensorRow tensors;
+  tensors.push_back(neighbors);
+  for (size_t i = 0; i < feature_types.size(); ++i) {
+    std::shared_ptr<Tensor> tensor;
+    RETURN_IF_NOT_OK(PbToTensor(&response.result_data()[static_cast<int>(i + 1)], &tensor));
+    std::shared_ptr<Tensor> fea_tensor;
+    RETURN_IF_NOT_OK(ParseNodeFeatureFromMemory(neighbors, feature_types[i], tensor, &fea_tensor));
+    tensors.push_back(std::move(fea_tensor));
+  }
+  *out = std::move(tensors);
+#else
+  RETURN_STATUS_UNEXPECTED("This operation is not supported in Windows OS.");
+#endif
+  return Status::OK();
+}
+
 Status GraphDataClient::GetNegSampledNeighbors(const std::vector<NodeIdType> &node_list, NodeIdType samples_num,
                                                NodeType neg_neighbor_type, std::shared_ptr<Tensor> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
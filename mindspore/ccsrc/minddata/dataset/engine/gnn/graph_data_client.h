@@ -101,6 +101,18 @@ class GraphDataClient : public GraphData {
                              const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy,
                              std::shared_ptr<Tensor> *out) override;
 
+  // Get sampled neighbors and the features of all the nodes sampled, in one request.
+  // @param std::vector<NodeType> node_list - List of nodes
+  // @param std::vector<NodeIdType> neighbor_nums - Number of neighbors sampled per hop
+  // @param std::vector<NodeType> neighbor_types - Neighbor type sampled per hop
+  // @param std::SamplingStrategy strategy - Sampling strategy
+  // @param std::vector<FeatureType> feature_types - Types of node features
+  // @param TensorRow *out - Returned neighbor's id, followed by the node features of them
+  // @return Status The status code returned
+  Status GetSampledSubgraph(const std::vector<NodeIdType> &node_list, const std::vector<NodeIdType> &neighbor_nums,
+                            const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy,
+                            const std::vector<FeatureType> &feature_types, TensorRow *out) override;
+
   // Get negative sampled neighbors.
   // @param std::vector<NodeType> node_list - List of nodes
   // @param NodeIdType samples_num - Number of neighbors sampled
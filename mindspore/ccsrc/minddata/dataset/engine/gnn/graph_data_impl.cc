@@ -15,7 +15,11 @@
  */
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 
+#include <sys/stat.h>
+
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <functional>
 #include <iterator>
 #include <numeric>
@@ -24,19 +28,45 @@
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 #include "minddata/dataset/engine/gnn/graph_loader_array.h"
+#include "minddata/dataset/util/path.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/task_manager.h"
 namespace mindspore {
 namespace dataset {
 namespace gnn {
+namespace {
+// The random generator of a chunk of input nodes, a function of the seed of the call and of the chunk only, so that
+// the results do not depend on the number of workers
+std::mt19937 ChunkRandom(uint32_t seed, size_t chunk) {
+  std::seed_seq seq{seed, static_cast<uint32_t>(chunk)};
+  return std::mt19937(seq);
+}
+
+// The size and modification time of the dataset file a snapshot is built from, null if the graph is not loaded from a
+// file, to tell when the snapshot no longer matches the dataset
+mindrecord::json SourceInfo(const std::string &dataset_file) {
+  struct stat st;
+  if (dataset_file.empty() || stat(dataset_file.c_str(), &st) != 0) {
+    return mindrecord::json();
+  }
+  mindrecord::json info;
+  info["file"] = dataset_file;
+  info["size"] = static_cast<int64_t>(st.st_size);
+  info["mtime"] = static_cast<int64_t>(st.st_mtime);
+  return info;
+}
+}  // namespace
 
 GraphDataImpl::GraphDataImpl(const std::string &data_format, const std::string &dataset_file, int32_t num_workers,
-                             bool server_mode)
+                             bool server_mode, const std::string &storage_format, const std::string &snapshot_file)
     : data_format_(data_format),
       dataset_file_(dataset_file),
       num_workers_(num_workers),
       rnd_(GetRandomDevice()),
       random_walk_(this),
-      server_mode_(server_mode) {
+      server_mode_(server_mode),
+      storage_format_(storage_format),
+      snapshot_file_(snapshot_file) {
   rnd_.seed(GetSeed());
   MS_LOG(INFO) << "num_workers:" << num_workers;
 }
@@ -121,6 +151,12 @@ Status GraphDataImpl::GetNodesFromEdges(const std::vector<EdgeIdType> &edge_list
   std::vector<std::vector<NodeIdType>> node_list;
   node_list.reserve(edge_list.size());
   for (const auto &edge_id : edge_list) {
+    if (csr_ != nullptr) {
+      int64_t row = csr_->EdgeRow(edge_id);
+      CHECK_FAIL_RETURN_UNEXPECTED(row >= 0, "Invalid edge id:" + std::to_string(edge_id));
+      node_list.push_back({csr_->EdgeSrc(row), csr_->EdgeDst(row)});
+      continue;
+    }
     auto itr = edge_id_map_.find(edge_id);
     if (itr == edge_id_map_.end()) {
       std::string err_msg = "Invalid edge id:" + std::to_string(edge_id);
@@ -147,11 +183,20 @@ Status GraphDataImpl::GetEdgesFromNodes(const std::vector<std::pair<NodeIdType,
   edge_list.reserve(node_list.size());
 
   for (const auto &node_id : node_list) {
-    std::shared_ptr<Node> src_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_id.first, &src_node));
-
     EdgeIdType edge_id;
-    src_node->GetEdgeByAdjNodeId(node_id.second, &edge_id);
+    if (csr_ != nullptr) {
+      int64_t row = csr_->NodeRow(node_id.first);
+      CHECK_FAIL_RETURN_UNEXPECTED(row >= 0, "Invalid node id:" + std::to_string(node_id.first));
+      edge_id = csr_->GetEdgeByAdjNodeId(row, node_id.second);
+      if (edge_id == -1) {
+        MS_LOG(WARNING) << "Number " << node_id.second << " node is not adjacent to number " << node_id.first
+                        << " node.";
+      }
+    } else {
+      std::shared_ptr<Node> src_node;
+      RETURN_IF_NOT_OK(GetNodeByNodeId(node_id.first, &src_node));
+      src_node->GetEdgeByAdjNodeId(node_id.second, &edge_id);
+    }
 
     std::vector<EdgeIdType> connection_edge = {edge_id};
     edge_list.emplace_back(std::move(connection_edge));
@@ -176,16 +221,14 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   // Collect information of adjacent table
   neighbors.resize(node_list.size());
   for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
     if (format == OutputFormat::kNormal) {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
+      RETURN_IF_NOT_OK(GetNodeNeighbors(node_list[i], neighbor_type, &neighbors[i]));
       max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
     } else if (format == OutputFormat::kCoo) {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i], true));
+      RETURN_IF_NOT_OK(GetNodeNeighbors(node_list[i], neighbor_type, &neighbors[i], true));
       total_edge_num += neighbors[i].size();
     } else {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i], true));
+      RETURN_IF_NOT_OK(GetNodeNeighbors(node_list[i], neighbor_type, &neighbors[i], true));
       total_edge_num += neighbors[i].size();
       if (i < node_list.size() - 1) {
         offset_table[i + 1] = total_edge_num;
@@ -228,6 +271,20 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   return Status::OK();
 }
 
+Status GraphDataImpl::GetNodeNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out,
+                                       bool exclude_itself) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  if (csr_ != nullptr) {
+    int64_t row = csr_->NodeRow(id);
+    CHECK_FAIL_RETURN_UNEXPECTED(row >= 0, "Invalid node id:" + std::to_string(id));
+    csr_->GetAllNeighbors(row, neighbor_type, out, exclude_itself);
+    return Status::OK();
+  }
+  std::shared_ptr<Node> node;
+  RETURN_IF_NOT_OK(GetNodeByNodeId(id, &node));
+  return node->GetAllNeighbors(neighbor_type, out, exclude_itself);
+}
+
 Status GraphDataImpl::CheckSamplesNum(NodeIdType samples_num) {
   NodeIdType all_nodes_number =
     std::accumulate(node_type_map_.begin(), node_type_map_.end(), 0,
@@ -263,53 +320,141 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
   }
   RETURN_UNEXPECTED_IF_NULL(out);
   std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
+  uint32_t seed = rnd_();
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), [&](size_t chunk, size_t begin, size_t end) -> Status {
+    std::mt19937 rnd = ChunkRandom(seed, chunk);
+    std::vector<int32_t> scratch;
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      RETURN_IF_NOT_OK(SampleHops(node_list[node_idx], neighbor_nums, neighbor_types, strategy, &rnd, &scratch,
+                                  &neighbors_vec[node_idx]));
+    }
+    return Status::OK();
+  }));
+  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors_vec, DataType(DataType::DE_INT32), out));
+  return Status::OK();
+}
+
+Status GraphDataImpl::SampleHops(NodeIdType node_id, const std::vector<NodeIdType> &neighbor_nums,
+                                 const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy,
+                                 std::mt19937 *rnd, std::vector<int32_t> *scratch, std::vector<NodeIdType> *out) {
+  if (csr_ != nullptr) {
+    CHECK_FAIL_RETURN_UNEXPECTED(csr_->NodeRow(node_id) >= 0, "Invalid node id:" + std::to_string(node_id));
+  } else {
     std::shared_ptr<Node> input_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &input_node));
-    neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
-    std::vector<NodeIdType> input_list = {node_list[node_idx]};
-    for (size_t i = 0; i < neighbor_nums.size(); ++i) {
-      std::vector<NodeIdType> neighbors;
-      neighbors.reserve(input_list.size() * neighbor_nums[i]);
-      for (const auto &node_id : input_list) {
-        if (node_id == kDefaultNodeId) {
-          for (int32_t j = 0; j < neighbor_nums[i]; ++j) {
-            neighbors.emplace_back(kDefaultNodeId);
-          }
-        } else {
-          std::shared_ptr<Node> node;
-          RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &node));
-          std::vector<NodeIdType> out;
-          RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], strategy, &out, &rnd_));
-          neighbors.insert(neighbors.end(), out.begin(), out.end());
-        }
+    RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &input_node));
+  }
+  out->emplace_back(node_id);
+  std::vector<NodeIdType> input_list = {node_id};
+  std::vector<NodeIdType> neighbors;
+  for (size_t i = 0; i < neighbor_nums.size(); ++i) {
+    neighbors.clear();
+    neighbors.reserve(input_list.size() * neighbor_nums[i]);
+    for (const auto &id : input_list) {
+      if (id == kDefaultNodeId) {
+        neighbors.insert(neighbors.end(), neighbor_nums[i], kDefaultNodeId);
+      } else if (csr_ != nullptr) {
+        int64_t row = csr_->NodeRow(id);
+        CHECK_FAIL_RETURN_UNEXPECTED(row >= 0, "Invalid node id:" + std::to_string(id));
+        RETURN_IF_NOT_OK(csr_->SampleNeighbors(row, neighbor_types[i], neighbor_nums[i], strategy, rnd, scratch,
+                                               &neighbors));
+      } else {
+        std::shared_ptr<Node> node;
+        RETURN_IF_NOT_OK(GetNodeByNodeId(id, &node));
+        std::vector<NodeIdType> sampled;
+        RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], strategy, &sampled, rnd));
+        neighbors.insert(neighbors.end(), sampled.begin(), sampled.end());
       }
-      neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
-      input_list = std::move(neighbors);
     }
+    out->insert(out->end(), neighbors.begin(), neighbors.end());
+    input_list.swap(neighbors);
   }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors_vec, DataType(DataType::DE_INT32), out));
   return Status::OK();
 }
 
-Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
-                                     size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data,
-                                     int32_t samples_num, std::vector<NodeIdType> *out_samples) {
+Status GraphDataImpl::GetSampledSubgraph(const std::vector<NodeIdType> &node_list,
+                                         const std::vector<NodeIdType> &neighbor_nums,
+                                         const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy,
+                                         const std::vector<FeatureType> &feature_types, TensorRow *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(!feature_types.empty(), "Input feature_types is empty");
+  std::shared_ptr<Tensor> neighbors;
+  RETURN_IF_NOT_OK(GetSampledNeighbors(node_list, neighbor_nums, neighbor_types, strategy, &neighbors));
+  TensorRow features;
+  RETURN_IF_NOT_OK(GetNodeFeature(neighbors, feature_types, &features));
+  TensorRow tensors;
+  tensors.push_back(neighbors);
+  for (auto &feature : features) {
+    tensors.push_back(std::move(feature));
+  }
+  *out = std::move(tensors);
+  return Status::OK();
+}
+
+Status GraphDataImpl::ParallelFor(size_t num_items, const std::function<Status(size_t, size_t, size_t)> &func) {
+  size_t num_chunks = (num_items + kParallelChunkSize - 1) / kParallelChunkSize;
+  size_t num_tasks = std::min(num_chunks, static_cast<size_t>(std::max(num_workers_, 1)));
+  std::atomic<size_t> next_chunk(0);
+  auto worker = [&]() -> Status {
+    for (size_t chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+      Status rc = func(chunk, chunk * kParallelChunkSize, std::min(num_items, (chunk + 1) * kParallelChunkSize));
+      if (rc.IsError()) {
+        // Leave the remaining chunks to nobody
+        next_chunk = num_chunks;
+        return rc;
+      }
+    }
+    return Status::OK();
+  };
+  if (num_tasks <= 1) {
+    return worker();
+  }
+  // The calling thread is one of the workers
+  TaskGroup vg;
+  Status rc;
+  for (size_t i = 1; i < num_tasks && rc.IsOk(); ++i) {
+    rc = vg.CreateAsyncTask("GraphDataImpl", worker);
+  }
+  Status own_rc = worker();
+  RETURN_IF_NOT_OK(vg.join_all(Task::WaitFlag::kBlocking));
+  RETURN_IF_NOT_OK(rc);
+  RETURN_IF_NOT_OK(own_rc);
+  return vg.GetTaskErrorIfAny();
+}
+
+Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data,
+                                     const std::unordered_set<NodeIdType> &exclude_data, int32_t samples_num,
+                                     std::mt19937 *rnd, std::vector<NodeIdType> *out_samples) {
   CHECK_FAIL_RETURN_UNEXPECTED(!data.empty(), "Input data is empty.");
-  RETURN_UNEXPECTED_IF_NULL(start_index);
+  RETURN_UNEXPECTED_IF_NULL(rnd);
   RETURN_UNEXPECTED_IF_NULL(out_samples);
-  size_t index = *start_index;
-  for (size_t i = index; i < shuffled_ids.size(); ++i) {
-    ++index;
-    if (exclude_data.find(data[shuffled_ids[i]]) != exclude_data.end()) {
-      continue;
+  if ((exclude_data.size() + samples_num) * 2 < data.size()) {
+    // Few are excluded or drawn, draw from the whole data and reject, rather than copying the candidates
+    std::uniform_int_distribution<size_t> dist(0, data.size() - 1);
+    std::unordered_set<NodeIdType> drawn;
+    for (int32_t i = 0; i < samples_num;) {
+      NodeIdType id = data[dist(*rnd)];
+      if (exclude_data.find(id) != exclude_data.end() || !drawn.insert(id).second) {
+        continue;
+      }
+      out_samples->emplace_back(id);
+      ++i;
     }
-    out_samples->emplace_back(data[shuffled_ids[i]]);
-    if (out_samples->size() >= samples_num) {
-      break;
+    return Status::OK();
+  }
+  std::vector<NodeIdType> candidates;
+  std::copy_if(data.begin(), data.end(), std::back_inserter(candidates),
+               [&exclude_data](NodeIdType id) { return exclude_data.find(id) == exclude_data.end(); });
+  CHECK_FAIL_RETURN_UNEXPECTED(!candidates.empty(), "There is no data to sample out of the excluded data.");
+  // Partial Fisher-Yates shuffles, starting a new one when all the candidates have been drawn
+  size_t pos = candidates.size();
+  for (int32_t i = 0; i < samples_num; ++i, ++pos) {
+    if (pos >= candidates.size()) {
+      pos = 0;
     }
+    std::uniform_int_distribution<size_t> dist(pos, candidates.size() - 1);
+    std::swap(candidates[pos], candidates[dist(*rnd)]);
+    out_samples->emplace_back(candidates[pos]);
   }
-  *start_index = index;
   return Status::OK();
 }
 
@@ -321,47 +466,27 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   RETURN_UNEXPECTED_IF_NULL(out);
 
   const std::vector<NodeIdType> &all_nodes = node_type_map_[neg_neighbor_type];
-  std::vector<NodeIdType> shuffled_id(all_nodes.size());
-  std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
-  std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-  size_t start_index = 0;
-  bool need_shuffle = false;
-
-  std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
-  neg_neighbors_vec.resize(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
+  std::vector<std::vector<NodeIdType>> neg_neighbors_vec(node_list.size());
+  uint32_t seed = rnd_();
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), [&](size_t chunk, size_t begin, size_t end) -> Status {
+    std::mt19937 rnd = ChunkRandom(seed, chunk);
     std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
-    std::unordered_set<NodeIdType> exclude_nodes;
-    (void)std::transform(neighbors.begin(), neighbors.end(),
-                         std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
-                         [](const NodeIdType node) { return node; });
-    neg_neighbors_vec[node_idx].emplace_back(node->id());
-    if (all_nodes.size() > exclude_nodes.size()) {
-      while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
-        RETURN_IF_NOT_OK(NegativeSample(all_nodes, shuffled_id, &start_index, exclude_nodes, samples_num + 1,
-                                        &neg_neighbors_vec[node_idx]));
-        if (start_index >= shuffled_id.size()) {
-          start_index = start_index % shuffled_id.size();
-          need_shuffle = true;
-        }
-      }
-    } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
-                    << " neg_neighbor_type:" << neg_neighbor_type;
-      // If there are no negative neighbors, they are filled with kDefaultNodeId
-      for (int32_t i = 0; i < samples_num; ++i) {
-        neg_neighbors_vec[node_idx].emplace_back(kDefaultNodeId);
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      neighbors.clear();
+      RETURN_IF_NOT_OK(GetNodeNeighbors(node_list[node_idx], neg_neighbor_type, &neighbors));
+      std::unordered_set<NodeIdType> exclude_nodes(neighbors.begin(), neighbors.end());
+      neg_neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
+      if (all_nodes.size() > exclude_nodes.size()) {
+        RETURN_IF_NOT_OK(NegativeSample(all_nodes, exclude_nodes, samples_num, &rnd, &neg_neighbors_vec[node_idx]));
+      } else {
+        MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node_list[node_idx]
+                      << " neg_neighbor_type:" << neg_neighbor_type;
+        // If there are no negative neighbors, they are filled with kDefaultNodeId
+        neg_neighbors_vec[node_idx].insert(neg_neighbors_vec[node_idx].end(), samples_num, kDefaultNodeId);
       }
     }
-    if (need_shuffle) {
-      std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-      start_index = 0;
-      need_shuffle = false;
-    }
-  }
+    return Status::OK();
+  }));
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neg_neighbors_vec, DataType(DataType::DE_INT32), out));
   return Status::OK();
 }
@@ -413,6 +538,12 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
     std::shared_ptr<Feature> default_feature;
     // If no feature can be obtained, fill in the default value
     RETURN_IF_NOT_OK(GetNodeDefaultFeature(f_type, &default_feature));
+    if (csr_ != nullptr) {
+      std::shared_ptr<Tensor> fea_tensor;
+      RETURN_IF_NOT_OK(GatherFeatureCsr(nodes, true, f_type, default_feature, &fea_tensor));
+      tensors.push_back(fea_tensor);
+      continue;
+    }
 
     TensorShape shape(default_feature->Value()->shape());
     auto shape_vec = nodes->shape().AsVector();
@@ -421,21 +552,25 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
     std::shared_ptr<Tensor> fea_tensor;
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, default_feature->Value()->type(), &fea_tensor));
 
-    dsize_t index = 0;
-    for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
-      std::shared_ptr<Feature> feature;
-      if (*node_itr == kDefaultNodeId) {
-        feature = default_feature;
-      } else {
-        std::shared_ptr<Node> node;
-
-        if (!GetNodeByNodeId(*node_itr, &node).IsOk() || !node->GetFeatures(f_type, &feature).IsOk()) {
+    // Each worker fills the rows of its own nodes
+    CHECK_FAIL_RETURN_UNEXPECTED(nodes->type() == DataType(DataType::DE_INT32), "Input nodes should be of int32.");
+    const auto *node_ids = reinterpret_cast<const NodeIdType *>(nodes->GetBuffer());
+    RETURN_IF_NOT_OK(ParallelFor(static_cast<size_t>(size), [&](size_t, size_t begin, size_t end) -> Status {
+      for (size_t index = begin; index < end; ++index) {
+        std::shared_ptr<Feature> feature;
+        if (node_ids[index] == kDefaultNodeId) {
           feature = default_feature;
+        } else {
+          std::shared_ptr<Node> node;
+
+          if (!GetNodeByNodeId(node_ids[index], &node).IsOk() || !node->GetFeatures(f_type, &feature).IsOk()) {
+            feature = default_feature;
+          }
         }
+        RETURN_IF_NOT_OK(fea_tensor->InsertTensor({static_cast<dsize_t>(index)}, feature->Value()));
       }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
-      index++;
-    }
+      return Status::OK();
+    }));
 
     TensorShape reshape(nodes->shape());
     for (auto s : default_feature->Value()->shape().AsVector()) {
@@ -503,6 +638,12 @@ Status GraphDataImpl::GetEdgeFeature(const std::shared_ptr<Tensor> &edges,
     std::shared_ptr<Feature> default_feature;
     // If no feature can be obtained, fill in the default value
     RETURN_IF_NOT_OK(GetEdgeDefaultFeature(f_type, &default_feature));
+    if (csr_ != nullptr) {
+      std::shared_ptr<Tensor> fea_tensor;
+      RETURN_IF_NOT_OK(GatherFeatureCsr(edges, false, f_type, default_feature, &fea_tensor));
+      tensors.push_back(fea_tensor);
+      continue;
+    }
 
     TensorShape shape(default_feature->Value()->shape());
     auto shape_vec = edges->shape().AsVector();
@@ -535,6 +676,45 @@ Status GraphDataImpl::GetEdgeFeature(const std::shared_ptr<Tensor> &edges,
   return Status::OK();
 }
 
+Status GraphDataImpl::GatherFeatureCsr(const std::shared_ptr<Tensor> &ids, bool is_node, FeatureType feature_type,
+                                       const std::shared_ptr<Feature> &default_feature, std::shared_ptr<Tensor> *out) {
+  const GraphCsr::FeatureColumn *column = is_node ? csr_->GetNodeFeature(feature_type)
+                                                  : csr_->GetEdgeFeature(feature_type);
+  const std::shared_ptr<Tensor> &default_value = default_feature->Value();
+  auto row_bytes = static_cast<size_t>(default_value->SizeInBytes());
+  CHECK_FAIL_RETURN_UNEXPECTED(column == nullptr || column->row_bytes == row_bytes,
+                               "[Internal ERROR] Feature " + std::to_string(feature_type) +
+                                 " of the csr storage does not match its default feature.");
+  TensorShape shape(ids->shape());
+  for (auto s : default_value->shape().AsVector()) {
+    shape = shape.AppendDim(s);
+  }
+  std::shared_ptr<Tensor> fea_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, default_value->type(), &fea_tensor));
+  if (row_bytes > 0) {
+    uchar *dst = nullptr;
+    TensorShape remaining = TensorShape::CreateUnknownRankShape();
+    RETURN_IF_NOT_OK(fea_tensor->StartAddrOfIndex({}, &dst, &remaining));
+    // Copy each feature as a row of the column, the ids which have none get the default feature
+    CHECK_FAIL_RETURN_UNEXPECTED(ids->type() == DataType(DataType::DE_INT32), "Input ids should be of int32.");
+    const auto *id_data = reinterpret_cast<const int32_t *>(ids->GetBuffer());
+    RETURN_IF_NOT_OK(ParallelFor(static_cast<size_t>(ids->Size()), [&](size_t, size_t begin, size_t end) -> Status {
+      for (size_t i = begin; i < end; ++i) {
+        int64_t row = -1;
+        if (column != nullptr && (!is_node || id_data[i] != kDefaultNodeId)) {
+          row = is_node ? csr_->NodeRow(id_data[i]) : csr_->EdgeRow(id_data[i]);
+        }
+        const uint8_t *src = row >= 0 ? column->data + row * row_bytes : default_value->GetBuffer();
+        (void)std::memcpy(dst + i * row_bytes, src, row_bytes);
+      }
+      return Status::OK();
+    }));
+  }
+  fea_tensor->Squeeze();
+  *out = std::move(fea_tensor);
+  return Status::OK();
+}
+
 Status GraphDataImpl::GetEdgeFeatureSharedMemory(const std::shared_ptr<Tensor> &edges, FeatureType type,
                                                  std::shared_ptr<Tensor> *out) {
   if (!edges || edges->Size() == 0) {
@@ -591,6 +771,14 @@ Status GraphDataImpl::Init() {
   if (data_format_ != "mindrecord") {
     RETURN_STATUS_UNEXPECTED("Data Format should be `mindrecord` as dataset file is provided.");
   }
+  RETURN_IF_NOT_OK(CheckStorageFormat());
+  if (UseSnapshot()) {
+    bool loaded = false;
+    RETURN_IF_NOT_OK(LoadSnapshot(&loaded));
+    if (loaded) {
+      return Status::OK();
+    }
+  }
   GraphLoader gl(this, dataset_file_, num_workers_, server_mode_);
 
   // ask graph_loader to load everything into memory
@@ -605,6 +793,14 @@ Status GraphDataImpl::Init(int32_t num_nodes, const std::shared_ptr<Tensor> &edg
                            const std::unordered_map<std::int16_t, std::shared_ptr<Tensor>> &graph_feat,
                            const std::shared_ptr<Tensor> &node_type, const std::shared_ptr<Tensor> &edge_type) {
   MS_LOG(INFO) << "Create graph with loading numpy array data.";
+  RETURN_IF_NOT_OK(CheckStorageFormat());
+  if (UseSnapshot()) {
+    bool loaded = false;
+    RETURN_IF_NOT_OK(LoadSnapshot(&loaded));
+    if (loaded) {
+      return Status::OK();
+    }
+  }
   GraphLoaderFromArray gl(this, num_nodes, edge, node_feat, edge_feat, graph_feat, node_type, edge_type, num_workers_,
                           server_mode_);
   RETURN_IF_NOT_OK(gl.InitAndLoad());
@@ -613,6 +809,105 @@ Status GraphDataImpl::Init(int32_t num_nodes, const std::shared_ptr<Tensor> &edg
   return Status::OK();
 }
 
+Status GraphDataImpl::CheckStorageFormat() {
+  CHECK_FAIL_RETURN_UNEXPECTED(storage_format_ == kObjectStorage || storage_format_ == kCsrStorage,
+                               "Invalid storage format, should be 'object' or 'csr', but got: " + storage_format_);
+  CHECK_FAIL_RETURN_UNEXPECTED(storage_format_ == kCsrStorage || snapshot_file_.empty(),
+                               "A graph snapshot file is only supported with the 'csr' storage format.");
+  CHECK_FAIL_RETURN_UNEXPECTED(storage_format_ == kObjectStorage || !server_mode_,
+                               "The 'csr' storage format is not supported in server mode.");
+  return Status::OK();
+}
+
+bool GraphDataImpl::UseSnapshot() const {
+  return storage_format_ == kCsrStorage && !snapshot_file_.empty() && Path(snapshot_file_).Exists();
+}
+
+Status GraphDataImpl::BuildCsr(std::vector<std::deque<std::shared_ptr<Node>>> *nodes,
+                               std::vector<std::deque<std::shared_ptr<Edge>>> *edges) {
+  // What the feature maps and the schema hold is kept in the snapshot to restore them from it
+  mindrecord::json meta;
+  for (const auto &item : node_feature_map_) {
+    meta["node_feature_map"][std::to_string(item.first)] = item.second;
+  }
+  for (const auto &item : edge_feature_map_) {
+    meta["edge_feature_map"][std::to_string(item.first)] = item.second;
+  }
+  meta["data_schema"] = data_schema_;
+  meta["source"] = SourceInfo(dataset_file_);
+  RETURN_IF_NOT_OK(GraphCsr::Build(nodes, edges, default_node_feature_map_, default_edge_feature_map_,
+                                   graph_feature_map_, meta, &csr_));
+  IndexCsr();
+  if (!snapshot_file_.empty()) {
+    RETURN_IF_NOT_OK(csr_->Save(snapshot_file_));
+  }
+  return Status::OK();
+}
+
+Status GraphDataImpl::LoadSnapshot(bool *loaded) {
+  RETURN_UNEXPECTED_IF_NULL(loaded);
+  RETURN_IF_NOT_OK(GraphCsr::Load(snapshot_file_, &csr_));
+  if (csr_->meta().value("source", mindrecord::json()) != SourceInfo(dataset_file_)) {
+    MS_LOG(WARNING) << "The graph snapshot " << snapshot_file_ << " was not built from the current " << dataset_file_
+                    << ", it is rebuilt from the dataset.";
+    csr_.reset();
+    *loaded = false;
+    return Status::OK();
+  }
+  *loaded = true;
+  IndexCsr();
+  try {
+    const mindrecord::json &meta = csr_->meta();
+    for (const auto &key : {"node_feature_map", "edge_feature_map"}) {
+      auto &feature_map = std::string(key) == "node_feature_map" ? node_feature_map_ : edge_feature_map_;
+      if (meta.contains(key)) {
+        for (auto itr = meta[key].begin(); itr != meta[key].end(); ++itr) {
+          feature_map[static_cast<NodeType>(std::stoi(itr.key()))] = itr.value().get<std::unordered_set<FeatureType>>();
+        }
+      }
+    }
+    data_schema_ = meta["data_schema"];
+  } catch (const std::exception &e) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse the graph snapshot: " + std::string(e.what()));
+  }
+  // The default features are zeros of the type and shape of their column
+  auto zero_features = [](const std::map<FeatureType, GraphCsr::FeatureColumn> &columns,
+                          std::unordered_map<FeatureType, std::shared_ptr<Feature>> *features) -> Status {
+    for (const auto &item : columns) {
+      std::shared_ptr<Tensor> zero_tensor;
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(item.second.shape, item.second.type, &zero_tensor));
+      RETURN_IF_NOT_OK(zero_tensor->Zero());
+      (*features)[item.first] = std::make_shared<Feature>(item.first, zero_tensor);
+    }
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(zero_features(csr_->node_features(), &default_node_feature_map_));
+  RETURN_IF_NOT_OK(zero_features(csr_->edge_features(), &default_edge_feature_map_));
+  for (const auto &item : csr_->graph_features()) {
+    std::shared_ptr<Tensor> tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateFromMemory(item.second.shape, item.second.type, item.second.data, &tensor));
+    graph_feature_map_[item.first] = std::make_shared<Feature>(item.first, tensor);
+  }
+  return Status::OK();
+}
+
+void GraphDataImpl::IndexCsr() {
+  node_type_map_.clear();
+  edge_type_map_.clear();
+  for (int64_t row = 0; row < csr_->num_nodes(); ++row) {
+    node_type_map_[csr_->GetNodeType(row)].push_back(csr_->NodeId(row));
+  }
+  for (int64_t row = 0; row < csr_->num_edges(); ++row) {
+    edge_type_map_[csr_->GetEdgeType(row)].push_back(csr_->EdgeId(row));
+  }
+  for (auto &itr : node_type_map_) {
+    itr.second.shrink_to_fit();
+  }
+  for (auto &itr : edge_type_map_) {
+    itr.second.shrink_to_fit();
+  }
+}
+
 Status GraphDataImpl::GetMetaInfo(MetaInfo *meta_info) {
   RETURN_UNEXPECTED_IF_NULL(meta_info);
   meta_info->node_type.resize(node_type_map_.size());
@@ -749,12 +1044,10 @@ Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node,
   while (walk.size() - 1 < meta_path_.size()) {
     // current nodE
     auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
 
     // current neighbors
     std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
+    RETURN_IF_NOT_OK(graph_->GetNodeNeighbors(cur_node_id, meta_path_[walk.size() - 1], &cur_neighbors, true));
     std::sort(cur_neighbors.begin(), cur_neighbors.end());
 
     // break if no neighbors
@@ -798,10 +1091,8 @@ Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_
                                                          std::shared_ptr<StochasticIndex> *node_probability) {
   RETURN_UNEXPECTED_IF_NULL(node_probability);
   // Generate alias nodes
-  std::shared_ptr<Node> node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(node_id, &node));
   std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNodeNeighbors(node_id, node_type, &neighbors, true));
   std::sort(neighbors.begin(), neighbors.end());
   auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
   *node_probability =
@@ -814,15 +1105,11 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
                                                          std::shared_ptr<StochasticIndex> *edge_probability) {
   RETURN_UNEXPECTED_IF_NULL(edge_probability);
   // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(src, &src_node));
   std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNodeNeighbors(src, meta_path_[meta_path_index], &src_neighbors, true));
 
-  std::shared_ptr<Node> dst_node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(dst, &dst_node));
   std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNodeNeighbors(dst, meta_path_[meta_path_index + 1], &dst_neighbors, true));
 
   CHECK_FAIL_RETURN_UNEXPECTED(std::fabs(step_home_param_) > std::numeric_limits<float>::epsilon(),
                                "Invalid data, step home parameter can't be zero.");
@@ -17,6 +17,8 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_DATA_IMPL_H_
 
 #include <algorithm>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <string>
 #include <map>
@@ -25,6 +27,7 @@
 #include <vector>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/graph_csr.h"
 #include "minddata/dataset/engine/gnn/graph_data.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
@@ -37,6 +40,10 @@ namespace gnn {
 
 const float kGnnEpsilon = 0.0001;
 const uint32_t kMaxNumWalks = 80;
+// Number of input nodes a worker takes at a time, with a random generator of its own
+const size_t kParallelChunkSize = 256;
+const char kObjectStorage[] = "object";
+const char kCsrStorage[] = "csr";
 using StochasticIndex = std::pair<std::vector<int32_t>, std::vector<float>>;
 
 class GraphDataImpl : public GraphData {
@@ -45,8 +52,14 @@ class GraphDataImpl : public GraphData {
   // @param std::string data_format - support mindrecord or array
   // @param std::string dataset_file -
   // @param int32_t num_workers - number of parallel threads
+  // @param bool server_mode - whether the graph is served to clients
+  // @param std::string storage_format - object to keep a Node and an Edge object per node and edge, csr to keep the
+  //     graph in contiguous arrays, see GraphCsr
+  // @param std::string snapshot_file - with the csr storage, a snapshot of the graph mapped in place of loading the
+  //     dataset if it exists, written after loading the dataset otherwise
   GraphDataImpl(const std::string &data_format, const std::string &dataset_file, int32_t num_workers,
-                bool server_mode = false);
+                bool server_mode = false, const std::string &storage_format = kObjectStorage,
+                const std::string &snapshot_file = "");
 
   ~GraphDataImpl() override;
 
@@ -97,6 +110,19 @@ class GraphDataImpl : public GraphData {
                              const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy,
                              std::shared_ptr<Tensor> *out) override;
 
+  // Get sampled neighbors and the features of all the nodes sampled, in one call.
+  // @param std::vector<NodeType> node_list - List of nodes
+  // @param std::vector<NodeIdType> neighbor_nums - Number of neighbors sampled per hop
+  // @param std::vector<NodeType> neighbor_types - Neighbor type sampled per hop
+  // @param std::SamplingStrategy strategy - Sampling strategy
+  // @param std::vector<FeatureType> feature_types - Types of node features
+  // @param TensorRow *out - Returned neighbor's id as GetSampledNeighbors does, followed by the node features of
+  //     them as GetNodeFeature does
+  // @return Status The status code returned
+  Status GetSampledSubgraph(const std::vector<NodeIdType> &node_list, const std::vector<NodeIdType> &neighbor_nums,
+                            const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy,
+                            const std::vector<FeatureType> &feature_types, TensorRow *out) override;
+
   // Get negative sampled neighbors.
   // @param std::vector<NodeType> node_list - List of nodes
   // @param NodeIdType samples_num - Number of neighbors sampled
@@ -271,15 +297,75 @@ class GraphDataImpl : public GraphData {
   // @return Status The status code returned
   Status GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge);
 
-  // Negative sampling
+  // Negative sampling, the samples are distinct until all the data out of exclude_data has been drawn
   // @param std::vector<NodeIdType> &input_data - The data set to be sampled
-  // @param std::unordered_set<NodeIdType> &exclude_data - Data to be excluded
+  // @param std::unordered_set<NodeIdType> &exclude_data - Data to be excluded, a subset of the data
   // @param int32_t samples_num -
-  // @param std::vector<NodeIdType> *out_samples - Sampling results returned
+  // @param std::mt19937 *rnd - The random generator
+  // @param std::vector<NodeIdType> *out_samples - Sampling results appended
   // @return Status The status code returned
-  Status NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
-                        size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data, int32_t samples_num,
-                        std::vector<NodeIdType> *out_samples);
+  Status NegativeSample(const std::vector<NodeIdType> &data, const std::unordered_set<NodeIdType> &exclude_data,
+                        int32_t samples_num, std::mt19937 *rnd, std::vector<NodeIdType> *out_samples);
+
+  // Run a function over chunks of kParallelChunkSize items, on up to num_workers_ threads
+  // @param size_t num_items - Number of items
+  // @param std::function<Status(size_t, size_t, size_t)> func - Called with the index of the chunk and the range of
+  //     its items, for each chunk
+  // @return Status The status code returned
+  Status ParallelFor(size_t num_items, const std::function<Status(size_t, size_t, size_t)> &func);
+
+  // Get the neighbors of a node from either storage
+  // @param NodeIdType id - The node
+  // @param NodeType neighbor_type - type of neighbor
+  // @param std::vector<NodeIdType> *out - Returned neighbors id
+  // @param bool exclude_itself - Whether the node itself is left out of the output
+  // @return Status The status code returned
+  Status GetNodeNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out,
+                          bool exclude_itself = false);
+
+  // Sample the neighbors of a node hop by hop, the neighbors of a whole hop going to one buffer
+  // @param NodeIdType node_id - The node
+  // @param std::vector<NodeIdType> neighbor_nums - Number of neighbors sampled per hop
+  // @param std::vector<NodeType> neighbor_types - Neighbor type sampled per hop
+  // @param std::SamplingStrategy strategy - Sampling strategy
+  // @param std::mt19937 *rnd - The random generator
+  // @param std::vector<int32_t> *scratch - A buffer reused from call to call
+  // @param std::vector<NodeIdType> *out - Returned node followed by its neighbors of each hop
+  // @return Status The status code returned
+  Status SampleHops(NodeIdType node_id, const std::vector<NodeIdType> &neighbor_nums,
+                    const std::vector<NodeType> &neighbor_types, SamplingStrategy strategy, std::mt19937 *rnd,
+                    std::vector<int32_t> *scratch, std::vector<NodeIdType> *out);
+
+  // Gather the features of nodes or edges from the columns of the csr storage
+  // @param std::shared_ptr<Tensor> ids - List of nodes or edges
+  // @param bool is_node - Whether the ids are nodes or edges
+  // @param FeatureType feature_type - type of feature
+  // @param std::shared_ptr<Feature> default_feature - The feature of the ids which have none
+  // @param std::shared_ptr<Tensor> *out - Returned features, a row per id
+  // @return Status The status code returned
+  Status GatherFeatureCsr(const std::shared_ptr<Tensor> &ids, bool is_node, FeatureType feature_type,
+                          const std::shared_ptr<Feature> &default_feature, std::shared_ptr<Tensor> *out);
+
+  // Store the nodes and edges of a graph loader in csr form, then write the snapshot if one is asked for
+  // @param std::vector<std::deque<std::shared_ptr<Node>>> *nodes - The nodes loaded
+  // @param std::vector<std::deque<std::shared_ptr<Edge>>> *edges - The edges loaded
+  // @return Status The status code returned
+  Status BuildCsr(std::vector<std::deque<std::shared_ptr<Node>>> *nodes,
+                  std::vector<std::deque<std::shared_ptr<Edge>>> *edges);
+
+  // Map the snapshot file in place of loading the dataset, and restore what the loader would have filled
+  // @param bool *loaded - False if the snapshot was written from another version of the dataset file, the graph is
+  //     then to be loaded from the dataset
+  // @return Status The status code returned
+  Status LoadSnapshot(bool *loaded);
+
+  // Fill the node and edge type maps from the csr storage
+  void IndexCsr();
+
+  // @return bool - Whether the graph is mapped from its snapshot rather than loaded
+  bool UseSnapshot() const;
+
+  Status CheckStorageFormat();
 
   Status CheckSamplesNum(NodeIdType samples_num);
 
@@ -295,6 +381,10 @@ class GraphDataImpl : public GraphData {
 #if !defined(_WIN32) && !defined(_WIN64)
   std::unique_ptr<GraphSharedMemory> graph_shared_memory_;
 #endif
+  std::string storage_format_;
+  std::string snapshot_file_;
+  // The graph in csr form with the csr storage, node_id_map_ and edge_id_map_ are left empty then
+  std::unique_ptr<GraphCsr> csr_;
   std::unordered_map<NodeType, std::vector<NodeIdType>> node_type_map_;
   std::unordered_map<NodeIdType, std::shared_ptr<Node>> node_id_map_;
 
@@ -38,7 +38,8 @@ static std::unordered_map<uint32_t, pFunction> g_get_graph_data_func_ = {
   {GET_NEG_SAMPLED_NEIGHBORS, &GraphDataServiceImpl::GetNegSampledNeighbors},
   {RANDOM_WALK, &GraphDataServiceImpl::RandomWalk},
   {GET_NODE_FEATURE, &GraphDataServiceImpl::GetNodeFeature},
-  {GET_EDGE_FEATURE, &GraphDataServiceImpl::GetEdgeFeature}};
+  {GET_EDGE_FEATURE, &GraphDataServiceImpl::GetEdgeFeature},
+  {GET_SAMPLED_SUBGRAPH, &GraphDataServiceImpl::GetSampledSubgraph}};
 
 GraphDataServiceImpl::GraphDataServiceImpl(GraphDataServer *server, GraphDataImpl *graph_data_impl)
     : server_(server), graph_data_impl_(graph_data_impl) {}
@@ -262,6 +263,33 @@ Status GraphDataServiceImpl::GetSampledNeighbors(const GnnGraphDataRequestPb *re
   return Status::OK();
 }
 
+Status GraphDataServiceImpl::GetSampledSubgraph(const GnnGraphDataRequestPb *request,
+                                                GnnGraphDataResponsePb *response) {
+  CHECK_FAIL_RETURN_UNEXPECTED(request->id_size() > 0, "The input node id is empty");
+  CHECK_FAIL_RETURN_UNEXPECTED(request->number_size() > 0, "The input neighbor number is empty");
+  CHECK_FAIL_RETURN_UNEXPECTED(request->type_size() > 0, "The input neighbor type is empty");
+  CHECK_FAIL_RETURN_UNEXPECTED(request->feature_type_size() > 0, "The input feature type is empty");
+
+  std::vector<NodeIdType> node_list(request->id().begin(), request->id().end());
+  std::vector<NodeIdType> neighbor_nums(request->number().begin(), request->number().end());
+  std::vector<NodeType> neighbor_types;
+  neighbor_types.resize(request->type().size());
+  std::transform(request->type().begin(), request->type().end(), neighbor_types.begin(),
+                 [](const google::protobuf::int32 type) { return static_cast<NodeType>(type); });
+  SamplingStrategy strategy = static_cast<SamplingStrategy>(request->strategy());
+  std::shared_ptr<Tensor> neighbors;
+  RETURN_IF_NOT_OK(
+    graph_data_impl_->GetSampledNeighbors(node_list, neighbor_nums, neighbor_types, strategy, &neighbors));
+  RETURN_IF_NOT_OK(TensorToPb(neighbors, response->add_result_data()));
+  // The features are located in the shared memory, as GetNodeFeature does, the client reads them from there
+  for (const auto &type : request->feature_type()) {
+    std::shared_ptr<Tensor> tensor;
+    RETURN_IF_NOT_OK(graph_data_impl_->GetNodeFeatureSharedMemory(neighbors, type, &tensor));
+    RETURN_IF_NOT_OK(TensorToPb(tensor, response->add_result_data()));
+  }
+  return Status::OK();
+}
+
 Status GraphDataServiceImpl::GetNegSampledNeighbors(const GnnGraphDataRequestPb *request,
                                                     GnnGraphDataResponsePb *response) {
   CHECK_FAIL_RETURN_UNEXPECTED(request->id_size() > 0, "The input node id is empty");
@@ -53,6 +53,7 @@ class GraphDataServiceImpl {
   Status GetEdgesFromNodes(const GnnGraphDataRequestPb *request, GnnGraphDataResponsePb *response);
   Status GetAllNeighbors(const GnnGraphDataRequestPb *request, GnnGraphDataResponsePb *response);
   Status GetSampledNeighbors(const GnnGraphDataRequestPb *request, GnnGraphDataResponsePb *response);
+  Status GetSampledSubgraph(const GnnGraphDataRequestPb *request, GnnGraphDataResponsePb *response);
   Status GetNegSampledNeighbors(const GnnGraphDataRequestPb *request, GnnGraphDataResponsePb *response);
   Status RandomWalk(const GnnGraphDataRequestPb *request, GnnGraphDataResponsePb *response);
   Status GetNodeFeature(const GnnGraphDataRequestPb *request, GnnGraphDataResponsePb *response);
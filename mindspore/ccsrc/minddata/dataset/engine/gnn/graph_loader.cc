@@ -46,6 +46,11 @@ GraphLoader::GraphLoader(GraphDataImpl *graph_impl, std::string mr_filepath, int
 
 Status GraphLoader::GetNodesAndEdges() {
   MS_LOG(INFO) << "Start to fill node and edges into graph.";
+  if (graph_impl_->storage_format_ == kCsrStorage) {
+    // The nodes and edges are copied to contiguous arrays rather than linked to each other
+    MergeFeatureMaps();
+    return graph_impl_->BuildCsr(&n_deques_, &e_deques_);
+  }
   NodeIdMap *n_id_map = &graph_impl_->node_id_map_;
   EdgeIdMap *e_id_map = &graph_impl_->edge_id_map_;
   for (std::deque<std::shared_ptr<Node>> &dq : n_deques_) {
@@ -67,6 +67,7 @@ class GraphLoader {
   // nodes and edges are added to map without any connection. That's because there nodes and edges are read in
   // random order. src_node and dst_node in Edge are node_id only with -1 as type.
   // features attached to each node and edge are expected to be filled correctly
+  // with the csr storage format, the nodes and edges are stored in GraphCsr arrays instead
   Status GetNodesAndEdges();
 
  protected:
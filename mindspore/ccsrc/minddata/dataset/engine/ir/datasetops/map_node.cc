@@ -42,7 +42,8 @@ MapNode::MapNode(std::shared_ptr<DatasetNode> child, std::vector<std::shared_ptr
       DatasetNode(std::move(cache)),
       callbacks_(callbacks),
       offload_(offload),
-      python_mp_(std::move(python_mp)) {
+      python_mp_(std::move(python_mp)),
+      batch_compute_(false) {
   this->AddChild(child);
 }
 
@@ -52,6 +53,7 @@ std::shared_ptr<DatasetNode> MapNode::Copy() {
                                         offload_, python_mp_);
   (void)node->SetNumWorkers(num_workers_);
   (void)node->SetConnectorQueueSize(connector_que_size_);
+  node->SetBatchCompute(batch_compute_);
   return node;
 }
 
@@ -94,6 +96,7 @@ Status MapNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) {
   if (python_mp_ != nullptr) {
     map_op->SetPythonMp(python_mp_);
   }
+  map_op->SetBatchCompute(batch_compute_);
   node_ops->push_back(map_op);
   return Status::OK();
 }
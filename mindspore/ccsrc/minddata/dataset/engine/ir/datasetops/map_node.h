@@ -94,6 +94,12 @@ class MapNode : public DatasetNode {
   /// \brief setter to set offload flag of node
   void SetOffload(ManualOffloadMode offload);
 
+  /// \brief Whether the map runs its operations on whole batches, see TensorOp::BatchCompute
+  bool IsBatchCompute() const { return batch_compute_; }
+
+  /// \brief setter to make the map run its operations on whole batches, only valid when every input row is a batch
+  void SetBatchCompute(bool batch_compute) { batch_compute_ = batch_compute; }
+
   /// \brief Get the arguments of node
   /// \param[out] out_json JSON string of all attributes
   /// \return Status of the function
@@ -128,6 +134,9 @@ class MapNode : public DatasetNode {
   ManualOffloadMode offload_;
 
   std::shared_ptr<PythonMultiprocessingRuntime> python_mp_;
+
+  /// \brief Whether to call TensorOp::BatchCompute instead of TensorOp::Compute
+  bool batch_compute_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -87,7 +87,8 @@ Status MindDataNode::ValidateParams() {
 
   RETURN_IF_NOT_OK(
     ValidateEnum("MindDataset", "ShuffleMode", shuffle_mode_,
-                 {ShuffleMode::kFalse, ShuffleMode::kFiles, ShuffleMode::kGlobal, ShuffleMode::kInfile}));
+                 {ShuffleMode::kFalse, ShuffleMode::kFiles, ShuffleMode::kGlobal, ShuffleMode::kInfile,
+                  ShuffleMode::kPartial}));
 
   std::vector<std::string> dataset_file_vec =
     search_for_pattern_ ? std::vector<std::string>{dataset_file_} : dataset_files_;
@@ -21,6 +21,7 @@
 #include <utility>
 #include "minddata/dataset/core/tensor_row.h"
 #include "minddata/dataset/engine/connector.h"
+#include "minddata/dataset/engine/perf/op_latency.h"
 
 #include "minddata/dataset/include/dataset/constants.h"
 
@@ -31,15 +32,40 @@ class OperatorConnector : public Queue<TensorRow> {
  public:
   /// Constructor of OperatorConnector
   /// \param queue_capacity The number of element (TensorRows) for the queue.
-  explicit OperatorConnector(int32_t queue_capacity) : Queue<TensorRow>(queue_capacity), out_rows_count_(0) {}
+  explicit OperatorConnector(int32_t queue_capacity)
+      : Queue<TensorRow>(queue_capacity), out_rows_count_(0), latency_(nullptr) {}
 
   /// Destructor of -OperatorConnector
   ~OperatorConnector() = default;
 
   Status PopFront(TensorRow *row) override {
     out_rows_count_++;
-    return Queue::PopFront(row);
+    if (latency_ == nullptr) {
+      return Queue::PopFront(row);
+    }
+    uint64_t start = LatencyRecorder::Now();
+    RETURN_IF_NOT_OK(Queue::PopFront(row));
+    if (row->Flags() == TensorRow::kFlagNone) {
+      latency_->PopWait()->Record(LatencyRecorder::Now() - start);
+    }
+    return Status::OK();
   }
+
+  Status Add(const TensorRow &row) noexcept {
+    TensorRow copy = row;
+    return Add(std::move(copy));
+  }
+
+  Status Add(TensorRow &&row) noexcept {
+    if (latency_ == nullptr || row.Flags() != TensorRow::kFlagNone) {
+      return Queue::Add(std::move(row));
+    }
+    uint64_t start = LatencyRecorder::Now();
+    Status rc = Queue::Add(std::move(row));
+    latency_->PushWait()->Record(LatencyRecorder::Now() - start);
+    return rc;
+  }
+
   Status SendEOE() noexcept {
     TensorRow eoe = TensorRow(TensorRow::kFlagEOE);
     return Add(std::move(eoe));
@@ -51,8 +77,14 @@ class OperatorConnector : public Queue<TensorRow> {
   }
   auto out_rows_count() const { return out_rows_count_; }
 
+  /// Record the time the producer waits for room and the consumer waits for rows. The data rows are recorded,
+  /// the eoe and eof messages are not.
+  /// \param latency The latencies of the op producing into this connector, nullptr to stop recording
+  void SetLatency(OpLatency *latency) { latency_ = latency; }
+
  private:
   int64_t out_rows_count_;
+  OpLatency *latency_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/opt/optional/batch_compute_pass.h"
+
+#include <memory>
+#include <string>
+
+#include "minddata/dataset/engine/ir/datasetops/batch_node.h"
+#include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/ir/tensor_operation.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+
+namespace mindspore {
+namespace dataset {
+
+Status BatchComputePass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
+  RETURN_UNEXPECTED_IF_NULL(node);
+  RETURN_UNEXPECTED_IF_NULL(modified);
+  if (node->IsBatchCompute() || node->Children().size() != 1) {
+    return Status::OK();
+  }
+  if (HasBatchedKernels(node) && ProducesBatches(node->Children()[0])) {
+    MS_LOG(INFO) << "Map after batch runs its operations on whole batches.";
+    node->SetBatchCompute(true);
+    *modified = true;
+  }
+  return Status::OK();
+}
+
+bool BatchComputePass::ProducesBatches(const std::shared_ptr<DatasetNode> &node) {
+  std::shared_ptr<DatasetNode> current = node;
+  while (current != nullptr) {
+    std::string name = current->Name();
+    if (name == kBatchNode) {
+#ifdef ENABLE_PYTHON
+      // per_batch_map may return anything, not necessarily one row per element of the batch
+      auto batch_node = std::dynamic_pointer_cast<BatchNode>(current);
+      return batch_node != nullptr && !batch_node->BatchMapFunc();
+#else
+      return true;
+#endif
+    }
+    if (name == kMapNode) {
+      // a map keeps the batches only if it runs on them with batched kernels
+      auto map_node = std::dynamic_pointer_cast<MapNode>(current);
+      if (map_node == nullptr || !HasBatchedKernels(map_node)) {
+        return false;
+      }
+    } else if (name != kProjectNode && name != kRenameNode) {
+      return false;
+    }
+    if (current->Children().size() != 1) {
+      return false;
+    }
+    current = current->Children()[0];
+  }
+  return false;
+}
+
+bool BatchComputePass::HasBatchedKernels(const std::shared_ptr<MapNode> &node) {
+  for (const auto &operation : node->operations()) {
+    // random ops are never batched, the rows of a batch must get their own random parameters
+    if (operation == nullptr || operation->IsRandomOp()) {
+      return false;
+    }
+    std::shared_ptr<TensorOp> tensor_op = operation->Build();
+    if (tensor_op == nullptr || !tensor_op->SupportsBatchCompute()) {
+      return false;
+    }
+  }
+  return !node->operations().empty();
+}
+}  // namespace dataset
+}  // namespace mindspore
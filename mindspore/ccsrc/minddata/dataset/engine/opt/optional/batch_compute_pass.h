@@ -0,0 +1,51 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_BATCH_COMPUTE_PASS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_BATCH_COMPUTE_PASS_H_
+
+#include <memory>
+
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+
+/// \class BatchComputePass batch_compute_pass.h
+/// \brief An optional optimization pass making the maps applied after a batch run their tensor ops on the whole
+///     batch (TensorOp::BatchCompute) instead of row by row, when every op of the map has a batched kernel
+class BatchComputePass : public IRNodePass {
+  /// \brief Switches the MapNode to batch compute if it is eligible
+  /// \param[in] node The node being visited
+  /// \param[in, out] *modified indicates whether the node has been modified
+  /// \return Status The status code returned
+  Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+  /// \brief Whether every row coming out of a node is a batch made by a BatchNode, i.e. the node is a BatchNode
+  ///     without per_batch_map, or only projects, renames and batch computing maps stand between the node and one
+  /// \param[in] node The node
+  /// \return true if the rows are batches
+  static bool ProducesBatches(const std::shared_ptr<DatasetNode> &node);
+
+  /// \brief Whether every operation of a map has a batched kernel, see TensorOp::SupportsBatchCompute
+  /// \param[in] node The map
+  /// \return true if the map can run in batch compute
+  static bool HasBatchedKernels(const std::shared_ptr<MapNode> &node);
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_BATCH_COMPUTE_PASS_H_
@@ -16,14 +16,27 @@
 
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
+#include "minddata/dataset/audio/ir/kernels/amplitude_to_db_ir.h"
+#include "minddata/dataset/audio/ir/kernels/mel_scale_ir.h"
+#include "minddata/dataset/audio/ir/kernels/spectrogram_ir.h"
+#include "minddata/dataset/audio/kernels/mel_scale_op.h"
+#include "minddata/dataset/audio/kernels/mel_spectrogram_op.h"
+#include "minddata/dataset/audio/kernels/spectrogram_op.h"
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
 
@@ -34,36 +47,146 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
   RETURN_UNEXPECTED_IF_NULL(node);
   RETURN_UNEXPECTED_IF_NULL(modified);
   std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
+  bool fused = false;
+  RETURN_IF_NOT_OK(FuseDecodeRandomCropResize(&ops, &fused));
+  // Normalize and HWC2CHW usually follow the crop, so they are fused on top of the fused decode
+  RETURN_IF_NOT_OK(FuseNormalizeHwcToChw(&ops, &fused));
+  RETURN_IF_NOT_OK(FuseMelSpectrogram(&ops, &fused));
+  if (fused) {
+    node->setOperations(ops);
+    *modified = true;
+  }
+  return Status::OK();
+}
 
+Status TensorOpFusionPass::FuseDecodeRandomCropResize(std::vector<std::shared_ptr<TensorOperation>> *ops,
+                                                      bool *fused) {
   // start temporary code, to deal with pre-built TensorOperation
   std::vector<std::string> pattern = {kDecodeOp, kRandomCropAndResizeOp};
-  auto itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
+  auto itr = std::search(ops->begin(), ops->end(), pattern.begin(), pattern.end(),
                          [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
-  if (itr != ops.end()) {
+  if (itr != ops->end()) {
     MS_LOG(WARNING) << "Fusing pre-build Decode and RandomCropResize into one pre-build.";
     auto fused_op = dynamic_cast<RandomCropAndResizeOp *>((*(itr + 1))->Build().get());
     RETURN_UNEXPECTED_IF_NULL(fused_op);
     (*itr) = std::make_shared<transforms::PreBuiltOperation>(std::make_shared<RandomCropDecodeResizeOp>(*fused_op));
-    ops.erase(itr + 1);
-    node->setOperations(ops);
-    *modified = true;
+    ops->erase(itr + 1);
+    *fused = true;
     return Status::OK();
   }  // end of temporary code, needs to be deleted when tensorOperation's pybind completes
 
   // logic below is for non-prebuilt TensorOperation
   pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
-  itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
+  itr = std::search(ops->begin(), ops->end(), pattern.begin(), pattern.end(),
                     [](auto op, const std::string &nm) { return op != nullptr ? op->Name() == nm : false; });
 
   // return here if no pattern is found
-  RETURN_OK_IF_TRUE(itr == ops.end());
+  RETURN_OK_IF_TRUE(itr == ops->end());
   auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
   RETURN_UNEXPECTED_IF_NULL(fused_ir);
   // fuse the two ops
   (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
-  ops.erase(itr + 1);
-  node->setOperations(ops);
-  *modified = true;
+  ops->erase(itr + 1);
+  *fused = true;
+  return Status::OK();
+}
+
+Status TensorOpFusionPass::FuseNormalizeHwcToChw(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *fused) {
+  auto name_of = [ops](size_t i) { return (*ops)[i] != nullptr ? (*ops)[i]->Name() : std::string(); };
+  for (size_t i = 0; i + 1 < ops->size(); i++) {
+    std::string name = name_of(i);
+    std::string next = name_of(i + 1);
+    if ((name != kNormalizeOp && name != vision::kNormalizeOperation) ||
+        (next != kHwcToChwOp && next != vision::kHwcToChwOperation)) {
+      continue;
+    }
+    std::vector<float> mean;
+    std::vector<float> std;
+    if (name == kNormalizeOp) {
+      auto normalize_op = std::dynamic_pointer_cast<NormalizeOp>((*ops)[i]->Build());
+      RETURN_UNEXPECTED_IF_NULL(normalize_op);
+      if (!normalize_op->IsHwc()) {
+        continue;
+      }
+      mean = normalize_op->Mean();
+      std = normalize_op->Std();
+    } else {
+      auto *normalize_ir = dynamic_cast<vision::NormalizeOperation *>((*ops)[i].get());
+      RETURN_UNEXPECTED_IF_NULL(normalize_ir);
+      if (!normalize_ir->IsHwc()) {
+        continue;
+      }
+      mean = normalize_ir->Mean();
+      std = normalize_ir->Std();
+    }
+    size_t last = i + 1;
+    // the output is already float32, a TypeCast to float32 right after it has nothing left to do
+    std::string after = last + 1 < ops->size() ? name_of(last + 1) : std::string();
+    if (after == transforms::kTypeCastOperation) {
+      auto *type_cast_ir = dynamic_cast<transforms::TypeCastOperation *>((*ops)[last + 1].get());
+      if (type_cast_ir != nullptr && type_cast_ir->GetDataType() == DataType(DataType::DE_FLOAT32)) {
+        last++;
+      }
+    } else if (after == kTypeCastOp) {
+      auto type_cast_op = std::dynamic_pointer_cast<TypeCastOp>((*ops)[last + 1]->Build());
+      if (type_cast_op != nullptr && type_cast_op->GetDataType() == DataType(DataType::DE_FLOAT32)) {
+        last++;
+      }
+    }
+
+    size_t first = i;
+    std::shared_ptr<TensorOp> fused_op;
+    std::string prev = i > 0 ? name_of(i - 1) : std::string();
+    if (prev == kRandomCropDecodeResizeOp || prev == vision::kRandomCropDecodeResizeOperation) {
+      auto crop_op = std::dynamic_pointer_cast<RandomCropDecodeResizeOp>((*ops)[i - 1]->Build());
+      RETURN_UNEXPECTED_IF_NULL(crop_op);
+      fused_op = std::make_shared<RandomCropDecodeResizeNormalizeOp>(*crop_op, mean, std);
+      first = i - 1;
+    } else {
+      fused_op = std::make_shared<NormalizeHwcToChwOp>(mean, std);
+    }
+    MS_LOG(INFO) << "Fusing " << (last - first + 1) << " ops into one pre-build " << fused_op->Name() << ".";
+    (*ops)[first] = std::make_shared<transforms::PreBuiltOperation>(fused_op);
+    (void)ops->erase(ops->begin() + first + 1, ops->begin() + last + 1);
+    *fused = true;
+    // look for more pairs after the fused op
+    i = first;
+  }
+  return Status::OK();
+}
+
+Status TensorOpFusionPass::FuseMelSpectrogram(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *fused) {
+  auto name_of = [ops](size_t i) { return (*ops)[i] != nullptr ? (*ops)[i]->Name() : std::string(); };
+  for (size_t i = 0; i + 1 < ops->size(); i++) {
+    std::string name = name_of(i);
+    std::string next = name_of(i + 1);
+    if ((name != kSpectrogramOp && name != audio::kSpectrogramOperation) ||
+        (next != kMelScaleOp && next != audio::kMelScaleOperation)) {
+      continue;
+    }
+    auto spectrogram_op = std::dynamic_pointer_cast<SpectrogramOp>((*ops)[i]->Build());
+    RETURN_UNEXPECTED_IF_NULL(spectrogram_op);
+    // the complex and the two sided spectrograms have nothing to gain from the fused op
+    if (!spectrogram_op->UsesEngine()) {
+      continue;
+    }
+    auto mel_scale_op = std::dynamic_pointer_cast<MelScaleOp>((*ops)[i + 1]->Build());
+    RETURN_UNEXPECTED_IF_NULL(mel_scale_op);
+    size_t last = i + 1;
+    std::shared_ptr<TensorOp> amplitude_to_db_op;
+    std::string after = last + 1 < ops->size() ? name_of(last + 1) : std::string();
+    if (after == kAmplitudeToDBOp || after == audio::kAmplitudeToDBOperation) {
+      amplitude_to_db_op = (*ops)[last + 1]->Build();
+      RETURN_UNEXPECTED_IF_NULL(amplitude_to_db_op);
+      last++;
+    }
+    auto fused_op = std::make_shared<MelSpectrogramOp>(spectrogram_op, mel_scale_op, amplitude_to_db_op);
+    MS_LOG(INFO) << "Fusing " << (last - i + 1) << " ops into one pre-build " << fused_op->Name() << ".";
+    (*ops)[i] = std::make_shared<transforms::PreBuiltOperation>(fused_op);
+    (void)ops->erase(ops->begin() + i + 1, ops->begin() + last + 1);
+    *fused = true;
+    return Status::OK();
+  }
   return Status::OK();
 }
 }  // namespace dataset
@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 
 #include <memory>
+#include <vector>
 #include "minddata/dataset/engine/opt/pass.h"
 
 namespace mindspore {
@@ -31,6 +32,25 @@ class TensorOpFusionPass : public IRNodePass {
   /// \param[in, out] *modified indicates whether the node has been visited
   /// \return Status The status code returned
   Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+  /// \brief Fuses Decode followed by RandomResizedCrop into RandomCropDecodeResize
+  /// \param[in, out] ops The operations of the MapOp
+  /// \param[out] fused Set to true if the operations have been changed
+  /// \return Status The status code returned
+  Status FuseDecodeRandomCropResize(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *fused);
+
+  /// \brief Fuses Normalize of an HWC image followed by HWC2CHW (and a no-op TypeCast to float32) into a single
+  ///     pass, together with the RandomCropDecodeResize right before them if there is one
+  /// \param[in, out] ops The operations of the MapOp
+  /// \param[out] fused Set to true if the operations have been changed
+  /// \return Status The status code returned
+  Status FuseNormalizeHwcToChw(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *fused);
+
+  /// \brief Fuses Spectrogram followed by MelScale (and AmplitudeToDB) into a mel spectrogram computed frame by frame
+  /// \param[in, out] ops The operations of the MapOp
+  /// \param[out] fused Set to true if the operations have been changed
+  /// \return Status The status code returned
+  Status FuseMelSpectrogram(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *fused);
 };
 }  // namespace dataset
 }  // namespace mindspore
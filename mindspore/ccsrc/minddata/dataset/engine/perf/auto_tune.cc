@@ -17,6 +17,7 @@
 #include "minddata/dataset/engine/perf/auto_tune.h"
 
 #include <algorithm>
+#include <fstream>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -48,11 +49,17 @@ AutoTune::AutoTune(TreeAdapter *tree_adap, ProfilingManager *profiling_mgr)
       AT_change_(false),
       phase_1_best_time_(-1),
       phase_1_no_improve_count_(0),
+      cur_batch_time_(0.0),
       count_down_(0),
       phase_3_state_(AutoTuneMemPhase::kAutoTuneMemInit),
       phase_3_ID_(0),
       avg_batch_time(0.0),
       phase_3_prev_avg_(0.0),
+      monitor_regress_count_(0),
+      cpu_budget_(GlobalContext::config_manager()->autotune_cpu_budget()),
+      mem_budget_(GlobalContext::config_manager()->autotune_memory_budget()),
+      cpu_util_(0.0),
+      mem_util_(0.0),
       save_autoconfig_(GlobalContext::config_manager()->save_autoconfig()) {
   max_workers_ = GlobalContext::config_manager()->num_cpu_threads();
   autotune_json_filepath_ = GlobalContext::config_manager()->get_autotune_json_filepath();
@@ -74,6 +81,16 @@ Status AutoTune::Main() {
                        "disk. Disable offload to prevent this from happening.";
   }
   bool output_final_config = save_autoconfig_ && !nodes_offloaded;
+#ifndef ENABLE_ANDROID
+  const std::string start_config = GlobalContext::config_manager()->autotune_start_config();
+  if (!start_config.empty()) {
+    Status rc = LoadStartConfig(start_config);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Dataset AutoTune starts from the current configuration, the start configuration is "
+                      << "ignored: " << rc.GetErrDescription();
+    }
+  }
+#endif
   bool output_intermediate_config = save_intermediate_autoconfig_ && output_final_config;
   RETURN_IF_NOT_OK(ATMainLoop(output_intermediate_config));
   RETURN_IF_NOT_OK(profiling_manager_->Stop());
@@ -160,6 +177,9 @@ Status AutoTune::SaveAutotuneConfig(const std::string &file_name) {
   RETURN_IF_NOT_OK(SummarizeTreeConfiguration(&summary));
   nlohmann::json out_json;
   out_json["summary"] = summary;
+  nlohmann::json config;
+  GetTreeConfiguration(&config);
+  out_json["config"] = config;
   out_json["tree"] = autotune_config_json_;
   std::string remark_value = "The following file has been auto-generated by the Dataset AutoTune.";
   if (tree_modifier_->GetRequestsCount() == 0) {
@@ -185,8 +205,77 @@ Status AutoTune::SetAutotuneConfigJson() {
   }
   return Status::OK();
 }
+
+Status AutoTune::LoadStartConfig(const std::string &file_name) {
+  nlohmann::json in_json;
+  try {
+    std::ifstream in(file_name);
+    CHECK_FAIL_RETURN_UNEXPECTED(in.is_open(), "Failed to open AutoTune configuration file: " + file_name);
+    in >> in_json;
+  } catch (const std::exception &err) {
+    RETURN_STATUS_UNEXPECTED("Invalid AutoTune configuration file: " + file_name + ", " + err.what());
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(in_json.contains("config") && in_json["config"].is_array(),
+                               "AutoTune configuration file: " + file_name + " has no \"config\" entry.");
+  const nlohmann::json &config = in_json["config"];
+  std::vector<std::shared_ptr<DatasetOp>> tuned_ops;
+  ExecutionTree *tree = tree_adapter_->tree_.get();
+  for (auto itr = tree->begin(); itr != tree->end(); (void)itr++) {
+    if (!itr->inlined() && itr->Name() != "DataQueueOp") {
+      (void)tuned_ops.emplace_back(itr.get());
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(config.size() == tuned_ops.size(),
+                               "AutoTune configuration file: " + file_name + " describes " +
+                                 std::to_string(config.size()) + " operations, but the pipeline has " +
+                                 std::to_string(tuned_ops.size()) + ".");
+  for (size_t i = 0; i < tuned_ops.size(); i++) {
+    CHECK_FAIL_RETURN_UNEXPECTED(config[i].value("op_name", "") == tuned_ops[i]->Name(),
+                                 "AutoTune configuration file: " + file_name + " does not match the pipeline at " +
+                                   tuned_ops[i]->NameWithID() + ".");
+  }
+  // The change requests are applied by the ops asynchronously, so the best configuration is taken from the file
+  phase_1_best_workers.clear();
+  phase_1_best_queue.clear();
+  for (size_t i = 0; i < tuned_ops.size(); i++) {
+    const auto &op = tuned_ops[i];
+    int32_t workers = op->NumWorkers();
+    int32_t queue = op->ConnectorCapacity();
+    if (!SkipOpsCheck(op->id())) {
+      int32_t saved_workers = config[i].value("num_parallel_workers", workers);
+      if (workers > 0 && saved_workers > 0 && saved_workers != workers) {
+        RETURN_IF_NOT_OK(RequestNumWorkerChange(op->id(), workers, &saved_workers));
+        workers = saved_workers;
+      }
+      int32_t saved_queue = config[i].value("prefetch_size", queue);
+      if (saved_queue > 0 && saved_queue != queue) {
+        queue = std::max(std::min(saved_queue, MAX_QUEUE_SIZE), MIN_QUEUE_SIZE);
+        RETURN_IF_NOT_OK(RequestConnectorCapacityChange(op->id(), op->ConnectorCapacity(), queue));
+      }
+    }
+    phase_1_best_workers.push_back(workers);
+    phase_1_best_queue.push_back(queue);
+  }
+  AT_change_ = false;
+  MS_LOG(INFO) << "Dataset AutoTune starts from the configuration in: " << file_name;
+  return Status::OK();
+}
 #endif
 
+void AutoTune::GetTreeConfiguration(nlohmann::json *out) const {
+  *out = nlohmann::json::array();
+  ExecutionTree const *tree = tree_adapter_->tree_.get();
+  for (auto itr = tree->begin(); itr != tree->end(); (void)itr++) {
+    if (!itr->inlined() && itr->Name() != "DataQueueOp") {
+      nlohmann::json op_config;
+      op_config["op_name"] = itr->Name();
+      op_config["num_parallel_workers"] = itr->NumWorkers();
+      op_config["prefetch_size"] = itr->ConnectorCapacity();
+      out->push_back(op_config);
+    }
+  }
+}
+
 Status AutoTune::SummarizeTreeConfiguration(std::vector<std::string> *out) {
   constexpr int op_name_width = 20;
   constexpr int val_width = 2;
@@ -399,6 +488,8 @@ Status AutoTune::RunIterationStep() {
 }
 
 Status AutoTune::RegisterWorkersQueue() {
+  phase_1_best_workers.clear();
+  phase_1_best_queue.clear();
   ExecutionTree *tree = tree_adapter_->tree_.get();
   for (auto itr = tree->begin(); itr != tree->end(); (void)itr++) {
     if (!itr->inlined() && itr->Name() != "DataQueueOp") {
@@ -444,6 +535,7 @@ Status AutoTune::TrackPipelineTime() {
   }
   double avg_time_pipeline = Mean(pipeline_times);
   double avg_time_batch = Mean(batch_times);
+  cur_batch_time_ = avg_time_batch;
   (void)avg_pipeline_times_.push_back(avg_time_pipeline);
   MS_LOG(INFO) << "Average Pipeline time is " << avg_time_pipeline << " ms. The avg pipeline time for all epochs is "
                << Mean(avg_pipeline_times_) << "ms";
@@ -473,10 +565,117 @@ Status AutoTune::TrackPipelineTime() {
 
 Status AutoTune::RunIteration() {
   RETURN_IF_NOT_OK(TrackPipelineTime());
+  RETURN_IF_NOT_OK(UpdateSystemUtil());
+  RETURN_IF_NOT_OK(EnforceBudget());
   if (AT_phase_ == AutoTunePhase::kAutoTunePhaseTime) {
     RETURN_IF_NOT_OK(AnalyseTime());
   } else if (AT_phase_ == AutoTunePhase::kAutoTunePhaseMemory) {
     RETURN_IF_NOT_OK(AnalyseMemory());
+  } else if (AT_phase_ == AutoTunePhase::kAutoTunePhaseMonitor) {
+    RETURN_IF_NOT_OK(AnalyseMonitor());
+  }
+  return Status::OK();
+}
+
+Status AutoTune::UpdateSystemUtil() {
+#ifndef ENABLE_ANDROID
+  std::vector<uint8_t> user_util;
+  std::vector<uint8_t> sys_util;
+  std::vector<float> mem_used;
+  std::vector<float> mem_total;
+  if (mode_ == AutoTuneMode::kAutoTuneModeEpoch) {
+    RETURN_IF_NOT_OK(profiling_manager_->GetUserCpuUtilByEpoch(cur_epoch_running_, &user_util));
+    RETURN_IF_NOT_OK(profiling_manager_->GetSysCpuUtilByEpoch(cur_epoch_running_, &sys_util));
+    RETURN_IF_NOT_OK(
+      profiling_manager_->GetSystemMemoryInfoByEpoch(SystemMemoryMetric::kMemoryUsed, cur_epoch_running_, &mem_used));
+    RETURN_IF_NOT_OK(
+      profiling_manager_->GetSystemMemoryInfoByEpoch(SystemMemoryMetric::kMemoryTotal, cur_epoch_running_, &mem_total));
+  } else if (mode_ == AutoTuneMode::kAutoTuneModeStep) {
+    int32_t end_step = cur_step_running_ - 1;
+    RETURN_IF_NOT_OK(profiling_manager_->GetUserCpuUtilByStep(last_step_autotuned_, end_step, &user_util));
+    RETURN_IF_NOT_OK(profiling_manager_->GetSysCpuUtilByStep(last_step_autotuned_, end_step, &sys_util));
+    RETURN_IF_NOT_OK(profiling_manager_->GetSystemMemoryInfoByStep(SystemMemoryMetric::kMemoryUsed,
+                                                                   last_step_autotuned_, end_step, &mem_used));
+    RETURN_IF_NOT_OK(profiling_manager_->GetSystemMemoryInfoByStep(SystemMemoryMetric::kMemoryTotal,
+                                                                   last_step_autotuned_, end_step, &mem_total));
+  }
+  cpu_util_ = Mean(user_util) + Mean(sys_util);
+  double total = Mean(mem_total);
+  mem_util_ = total > 0 ? Mean(mem_used) / total * TO_PERCENT : 0.0;
+  MS_LOG(INFO) << "System CPU utilization: " << cpu_util_ << "% (budget " << cpu_budget_
+               << "%), memory utilization: " << mem_util_ << "% (budget " << mem_budget_ << "%).";
+#endif
+  return Status::OK();
+}
+
+Status AutoTune::EnforceBudget() {
+  std::map<int32_t, int32_t> ops_num_workers;
+  RETURN_IF_NOT_OK(GetOpsNumWorker(&ops_num_workers));
+  if (mem_util_ > mem_budget_) {
+    // Halve the largest queue which is still above the number of workers of its op
+    int32_t target_id = -1;
+    int64_t target_capacity = 0;
+    for (const auto &op_id : parallel_ops_ids_) {
+      int64_t capacity = ops_[op_id]->ConnectorCapacity();
+      if (!SkipOpsCheck(op_id) && capacity > ops_num_workers[op_id] && capacity > target_capacity) {
+        target_id = op_id;
+        target_capacity = capacity;
+      }
+    }
+    if (target_id != -1) {
+      MS_LOG(INFO) << "Memory utilization " << mem_util_ << "% is above the " << mem_budget_
+                   << "% budget, reducing the queue of Op (" << ops_[target_id]->NameWithID() << ").";
+      int64_t new_capacity = std::max(static_cast<int64_t>(target_capacity * QUEUE_REDUCTION_PERCENTAGE_EPOCH),
+                                      static_cast<int64_t>(ops_num_workers[target_id]));
+      RETURN_IF_NOT_OK(RequestConnectorCapacityChange(target_id, target_capacity, new_capacity));
+    }
+  }
+  if (cpu_util_ > cpu_budget_) {
+    // Take a worker from the op whose workers are the least busy
+    std::map<int32_t, double> ops_cpu_util;
+    RETURN_IF_NOT_OK(GetOpsCpuUtil(&ops_cpu_util));
+    int32_t target_id = -1;
+    double target_util = 0.0;
+    for (const auto &op_id : parallel_ops_ids_) {
+      int32_t num_workers = ops_num_workers[op_id];
+      if (SkipOpsCheck(op_id) || num_workers <= MIN_NUM_WORKERS) {
+        continue;
+      }
+      double worker_util = ops_cpu_util[op_id] / num_workers;
+      if (target_id == -1 || worker_util < target_util) {
+        target_id = op_id;
+        target_util = worker_util;
+      }
+    }
+    if (target_id != -1) {
+      MS_LOG(INFO) << "CPU utilization " << cpu_util_ << "% is above the " << cpu_budget_
+                   << "% budget, removing a worker of Op (" << ops_[target_id]->NameWithID() << ").";
+      int32_t requested_workers = ops_num_workers[target_id] + DECREMENT_WORKER;
+      RETURN_IF_NOT_OK(RequestNumWorkerChange(target_id, ops_num_workers[target_id], &requested_workers));
+    }
+  }
+  return Status::OK();
+}
+
+Status AutoTune::AnalyseMonitor() {
+  bool isBottleneck = false;
+  RETURN_IF_NOT_OK(IsDSaBottleneck(&isBottleneck));
+  if (isBottleneck && phase_1_best_time_ > 0 && cur_batch_time_ > phase_1_best_time_ * (1 + RETUNE_THRESHOLD)) {
+    monitor_regress_count_++;
+  } else {
+    monitor_regress_count_ = 0;
+  }
+  if (monitor_regress_count_ > RETUNE_PATIENCE) {
+    MS_LOG(INFO) << "Batch time " << cur_batch_time_ << " ms has regressed from the tuned " << phase_1_best_time_
+                 << " ms, Dataset AutoTune restarts tuning.";
+    monitor_regress_count_ = 0;
+    // The current configuration is the baseline of the new search
+    phase_1_best_time_ = cur_batch_time_;
+    phase_1_no_improve_count_ = 0;
+    RETURN_IF_NOT_OK(RegisterWorkersQueue());
+    phase_3_state_ = AutoTuneMemPhase::kAutoTuneMemInit;
+    OP_values.clear();
+    AT_phase_ = AutoTunePhase::kAutoTunePhaseTime;
   }
   return Status::OK();
 }
@@ -631,21 +830,31 @@ Status AutoTune::AnalyseTime() {
     int32_t requested_workers = 0;
     MS_LOG(DEBUG) << "Op (" << ops_[op_id]->NameWithID() << ") CPU=" << cpu_util / num_workers
                   << ", in=" << input_queue_util << "out=" << output_queue_util;
+    // budget - the new workers are expected to be as busy as the current ones
+    bool within_cpu_budget =
+      cpu_budget_ >= TO_PERCENT || cpu_util_ + cpu_util / num_workers * INCREMENT_WORKER <= cpu_budget_;
+    bool within_mem_budget = mem_budget_ >= TO_PERCENT || mem_util_ <= mem_budget_;
     // map decisions - queue
+    bool needs_workers = false;
     if (queue_diff > INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD) {
       MS_LOG(INFO) << "Op (" << ops_[op_id]->NameWithID()
                    << ") is slow, input connector utilization=" << input_queue_util
                    << ", output connector utilization=" << output_queue_util << ", diff= " << queue_diff << " > "
                    << INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD << " threshold.";
-      requested_workers = num_workers + INCREMENT_WORKER;
-      RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, &requested_workers));
+      needs_workers = true;
     } else if ((cpu_util / num_workers) > MAP_OP_WORKER_HIGH_THRESHOLD) {
       MS_LOG(INFO) << "Op (" << ops_[op_id]->NameWithID() << ") getting high average worker cpu utilization "
                    << (cpu_util / num_workers) << "% > " << MAP_OP_WORKER_HIGH_THRESHOLD << "% threshold.";
+      needs_workers = true;
+    }
+    if (needs_workers && within_cpu_budget) {
       requested_workers = num_workers + INCREMENT_WORKER;
       RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, &requested_workers));
+    } else if (needs_workers) {
+      MS_LOG(INFO) << "Op (" << ops_[op_id]->NameWithID() << ") gets no more workers, system CPU utilization "
+                   << cpu_util_ << "% would exceed the " << cpu_budget_ << "% budget.";
     }
-    if ((cpu_util / num_workers) < MAP_OP_WORKER_LOW_THRESHOLD &&
+    if ((cpu_util / num_workers) < MAP_OP_WORKER_LOW_THRESHOLD && within_mem_budget &&
         ((input_queue_util < INPUT_QUEUE_LOW) || (-1 * queue_diff > INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD))) {
       MS_LOG(INFO) << "Op (" << ops_[op_id]->NameWithID() << ") getting low average worker cpu utilization "
                    << (cpu_util / num_workers) << "% < " << MAP_OP_WORKER_LOW_THRESHOLD << "% threshold.";
@@ -708,10 +917,11 @@ Status AutoTune::AnalyseMemory() {
     phase_3_ID_ = 0;
   }
 
-  // Exit when all viable ops have been tested
+  // Keep watching the pipeline when all viable ops have been tested
   // Or if none found
   if (count_down_ == 0) {
-    AT_phase_ = AutoTunePhase::kAutoTuneEnd;
+    MS_LOG(INFO) << "Dataset AutoTune has tuned the pipeline and keeps monitoring it.";
+    AT_phase_ = AutoTunePhase::kAutoTunePhaseMonitor;
     return Status::OK();
   }
 
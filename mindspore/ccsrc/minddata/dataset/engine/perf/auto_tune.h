@@ -74,8 +74,18 @@ class AutoTune {
   /// Setter for autotune_config_json_
   /// \return Status code
   Status SetAutotuneConfigJson();
+
+  /// \brief Apply the workers and queue sizes saved by a previous run, so tuning starts from its result
+  /// \param file_name Name of a file written by SaveAutotuneConfig
+  /// \return Status object, an error if the file does not describe the current pipeline
+  Status LoadStartConfig(const std::string &file_name);
 #endif
 
+  /// \brief Helper to list the workers and queue size of each op in the order of the tree, as saved in the
+  ///     "config" entry of the AutoTune configuration file
+  /// \param[out] out json array with one object per op
+  void GetTreeConfiguration(nlohmann::json *out) const;
+
   /// Function to collect info from the tree
   /// \return Status code
   Status CollectOpsInfo();
@@ -146,7 +156,7 @@ class AutoTune {
   const float_t MAP_OP_WORKER_LOW_THRESHOLD = 35;
   // Running mode specifics
   enum AutoTuneMode { kAutoTuneModeEpoch, kAutoTuneModeStep };
-  enum AutoTunePhase { kAutoTunePhaseTime, kAutoTunePhaseMemory, kAutoTuneEnd };
+  enum AutoTunePhase { kAutoTunePhaseTime, kAutoTunePhaseMemory, kAutoTunePhaseMonitor, kAutoTuneEnd };
   enum AutoTuneMemPhase { kAutoTuneMemInit, kAutoTuneMemSet, kAutotTuneMemCompare };
   // Early stop specifics
   const int32_t EARLY_STOP_TRIAL_THRESHOLD_EPOCH = 4;
@@ -155,6 +165,10 @@ class AutoTune {
   const float MEMORY_COMPARISON_LOWER_BOUND_PERCENT = 0.02;
   const float QUEUE_REDUCTION_PERCENTAGE_EPOCH = 0.5;
   const float QUEUE_REDUCTION_PERCENTAGE_STEP = 0.8;
+  // Monitor specifics, tuning restarts when the batch time is RETUNE_THRESHOLD worse than the best one
+  // for more than RETUNE_PATIENCE iterations in a row
+  const double RETUNE_THRESHOLD = 0.2;
+  const int32_t RETUNE_PATIENCE = 2;
 
   /// Get the out connector capacity of the operator
   /// \param[in] op_id operator id
@@ -192,6 +206,18 @@ class AutoTune {
   /// \return Status code
   Status AnalyseMemory();
 
+  /// Watch the tuned pipeline and restart tuning when the batch time regresses
+  /// \return Status code
+  Status AnalyseMonitor();
+
+  /// Get the CPU and memory utilization of the whole system since the last iteration into cpu_util_ and mem_util_
+  /// \return Status code
+  Status UpdateSystemUtil();
+
+  /// Give back workers or queue capacity when the system is above the CPU or memory budget
+  /// \return Status code
+  Status EnforceBudget();
+
   /// Send a ChangeRequest to the operator to update the number of workers
   /// \param op_id operator ID
   /// \param old_workers Old number of workers for logging purposes
@@ -206,7 +232,7 @@ class AutoTune {
   /// \return Status code
   Status RequestConnectorCapacityChange(int32_t op_id, int32_t old_size, int32_t new_size);
 
-  /// Track the pipeline time of the current epoch into avg_pipeline_times_
+  /// Track the pipeline time of the current epoch into avg_pipeline_times_ and the batch time into cur_batch_time_
   /// \return Status code
   Status TrackPipelineTime();
 
@@ -281,6 +307,8 @@ class AutoTune {
   std::vector<int32_t> phase_1_best_workers;
   std::vector<int32_t> phase_1_best_queue;
 
+  double cur_batch_time_;
+
   // phase 2 - Analyse Memory
   int32_t count_down_;
   int32_t phase_3_state_;
@@ -289,6 +317,15 @@ class AutoTune {
   double phase_3_prev_avg_;
   std::vector<int32_t> OP_values;
 
+  // phase 3 - Monitor
+  int32_t monitor_regress_count_;
+
+  // Budget, in percent of the CPU and memory of the system
+  float cpu_budget_;
+  float mem_budget_;
+  double cpu_util_;
+  double mem_util_;
+
   /// True if should save AutoTune configuration
   bool save_autoconfig_;
 
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/bottleneck_analyzer.h"
+
+#include <algorithm>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr double kNsPerSecond = 1e9;
+// An op is never counted busy less than this fraction of the interval, so a blocked op gets a large but finite ceiling
+constexpr double kMinBusyFraction = 0.01;
+}  // namespace
+
+double BottleneckAnalyzer::Ceiling(const OpLatencyTotals &op, const std::vector<OpLatencyTotals> &ops,
+                                   uint64_t interval_ns) {
+  uint64_t rows = op.push_wait.count;
+  if (rows == 0 || interval_ns == 0) {
+    return 0;
+  }
+  if (op.compute.count > 0 && op.compute.sum_ns > 0 && op.num_workers > 0) {
+    double mean_ns = static_cast<double>(op.compute.sum_ns) / static_cast<double>(op.compute.count);
+    return op.num_workers * kNsPerSecond / mean_ns;
+  }
+  // The op waits on its parent when pushing, and on its children when they are slow to give it rows
+  double waiting_ns = static_cast<double>(op.push_wait.sum_ns);
+  for (const auto &child : ops) {
+    if (std::find(op.children.begin(), op.children.end(), child.op_id) != op.children.end()) {
+      waiting_ns += static_cast<double>(child.pop_wait.sum_ns);
+    }
+  }
+  double interval = static_cast<double>(interval_ns);
+  double busy_ns = std::max(interval - waiting_ns, interval * kMinBusyFraction);
+  return static_cast<double>(rows) * kNsPerSecond / busy_ns;
+}
+
+Status BottleneckAnalyzer::Analyze(const std::vector<OpLatencyTotals> &ops, uint64_t interval_ns,
+                                   BottleneckReport *report) {
+  RETURN_UNEXPECTED_IF_NULL(report);
+  CHECK_FAIL_RETURN_UNEXPECTED(interval_ns > 0, "Expected a non empty interval to find the bottleneck.");
+  *report = BottleneckReport();
+  double interval = static_cast<double>(interval_ns);
+  if (!ops.empty()) {
+    report->consumer_wait = std::min(1.0, static_cast<double>(ops[0].pop_wait.sum_ns) / interval);
+  }
+  // The ops above a batch output fewer rows than those below it, the utilization compares them all the same
+  double highest = 0;
+  for (const auto &op : ops) {
+    double ceiling = Ceiling(op, ops, interval_ns);
+    if (ceiling <= 0) {
+      continue;
+    }
+    double throughput = static_cast<double>(op.push_wait.count) * kNsPerSecond / interval;
+    double utilization = throughput / ceiling;
+    if (utilization <= highest) {
+      continue;
+    }
+    highest = utilization;
+    report->op_id = op.op_id;
+    report->op_type = op.op_type;
+    report->throughput = throughput;
+    report->ceiling = ceiling;
+    report->tensor_op.clear();
+    report->tensor_op_share = 0;
+    // The TensorOp taking most of the compute time of a map is what to speed up
+    for (size_t i = 0; i < op.tensor_ops.size() && i < op.tensor_op_names.size(); i++) {
+      double share = op.compute.sum_ns == 0 ? 0
+                                            : static_cast<double>(op.tensor_ops[i].sum_ns) /
+                                                static_cast<double>(op.compute.sum_ns);
+      if (share > report->tensor_op_share) {
+        report->tensor_op = op.tensor_op_names[i];
+        report->tensor_op_share = std::min(share, 1.0);
+      }
+    }
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
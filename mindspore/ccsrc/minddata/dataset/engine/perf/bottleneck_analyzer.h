@@ -0,0 +1,81 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_BOTTLENECK_ANALYZER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_BOTTLENECK_ANALYZER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief The number and the sum of the latencies recorded over an interval.
+struct LatencyTotals {
+  uint64_t count = 0;
+  uint64_t sum_ns = 0;
+};
+
+/// \brief The latencies of a dataset op over an interval, see OpLatency.
+struct OpLatencyTotals {
+  int32_t op_id = 0;
+  std::string op_type;
+  int32_t num_workers = 0;
+  std::vector<int32_t> children;
+  LatencyTotals compute;
+  LatencyTotals push_wait;  // Its count is the number of rows the op output
+  LatencyTotals pop_wait;
+  std::vector<std::string> tensor_op_names;
+  std::vector<LatencyTotals> tensor_ops;
+};
+
+/// \brief The op limiting the throughput of a pipeline.
+struct BottleneckReport {
+  int32_t op_id = -1;  // -1 if no op output any row
+  std::string op_type;
+  double throughput = 0;  // Rows per second the op output
+  double ceiling = 0;     // Estimated rows per second the op could output if its input and output never waited
+  std::string tensor_op;  // The TensorOp taking the most time, if the op is a map
+  double tensor_op_share = 0;  // Fraction of the compute time of the op spent in that TensorOp
+  double consumer_wait = 0;    // Fraction of the interval the consumer of the pipeline waited for rows
+};
+
+/// \brief Finds the bottleneck of a pipeline from the latencies of its ops.
+///
+///     The ceiling of an op that times its workers (a map) is its number of workers over the mean compute time of a
+///     row. Any other op is assumed busy whenever it is not waiting for room in its output connector or for a row from
+///     its children, its ceiling is the number of rows it output over that busy time. The bottleneck is the op running
+///     closest to its ceiling: the ops above it wait for its rows and the ops below it wait for it to take theirs.
+class BottleneckAnalyzer {
+ public:
+  /// \brief Analyze the latencies of an interval.
+  /// \param[in] ops The latencies of the ops, the root first
+  /// \param[in] interval_ns The length of the interval in nanoseconds
+  /// \param[out] report The bottleneck
+  /// \return Status error if the interval is empty
+  static Status Analyze(const std::vector<OpLatencyTotals> &ops, uint64_t interval_ns, BottleneckReport *report);
+
+  /// \brief Estimate the throughput ceiling of an op.
+  /// \param[in] op The latencies of the op
+  /// \param[in] ops The latencies of all the ops, to find the time the op waited for its children
+  /// \param[in] interval_ns The length of the interval in nanoseconds
+  /// \return The ceiling in rows per second, 0 if the op output no row
+  static double Ceiling(const OpLatencyTotals &op, const std::vector<OpLatencyTotals> &ops, uint64_t interval_ns);
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_BOTTLENECK_ANALYZER_H_
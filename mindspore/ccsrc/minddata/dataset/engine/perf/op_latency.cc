@@ -0,0 +1,157 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/op_latency.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// A thread drops the histograms of the recorders destroyed since once it holds this many of them
+constexpr size_t kPruneThreadShards = 64;
+
+uint64_t NextRecorderId() {
+  static std::atomic<uint64_t> next_id{0};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+}  // namespace
+
+int32_t LatencyHistogram::BucketOf(uint64_t ns) {
+  if (ns < static_cast<uint64_t>(kSubBuckets)) {
+    return static_cast<int32_t>(ns);
+  }
+  auto exponent = 63 - __builtin_clzll(ns);
+  if (exponent >= kMaxExponent) {
+    return kNumBuckets - 1;
+  }
+  // The bits after the leading one pick the bucket within the power of two
+  auto sub_bucket = static_cast<int32_t>((ns >> (exponent - kSubBucketBits)) & (kSubBuckets - 1));
+  return (exponent - kSubBucketBits + 1) * kSubBuckets + sub_bucket;
+}
+
+uint64_t LatencyHistogram::BucketValue(int32_t bucket) {
+  if (bucket < kSubBuckets) {
+    return static_cast<uint64_t>(bucket);
+  }
+  int32_t shift = bucket / kSubBuckets - 1;
+  uint64_t lower = static_cast<uint64_t>(kSubBuckets + bucket % kSubBuckets) << shift;
+  return lower + ((1ULL << shift) >> 1);
+}
+
+void LatencyHistogram::Add(uint64_t ns) {
+  counts_[BucketOf(ns)]++;
+  count_++;
+  sum_ += ns;
+}
+
+void LatencyHistogram::Subtract(const LatencyHistogram &earlier) {
+  for (int32_t i = 0; i < kNumBuckets; i++) {
+    counts_[i] -= std::min(counts_[i], earlier.counts_[i]);
+  }
+  count_ -= std::min(count_, earlier.count_);
+  sum_ -= std::min(sum_, earlier.sum_);
+}
+
+uint64_t LatencyHistogram::Percentile(double quantile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  // The rank of the latency, from 1 to count_
+  auto rank = static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count_)));
+  rank = std::max<uint64_t>(rank, 1);
+  uint64_t seen = 0;
+  for (int32_t i = 0; i < kNumBuckets; i++) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      return BucketValue(i);
+    }
+  }
+  return BucketValue(kNumBuckets - 1);
+}
+
+LatencyRecorder::LatencyRecorder() : id_(NextRecorderId()) {}
+
+uint64_t LatencyRecorder::Now() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+LatencyRecorder::Shard *LatencyRecorder::ThreadShard() {
+  // The histograms of the calling thread by recorder. The recorders own them, a thread only keeps a weak reference to
+  // tell those of the recorders destroyed since.
+  struct ThreadEntry {
+    Shard *shard;
+    std::weak_ptr<Shard> owner;
+  };
+  thread_local std::unordered_map<uint64_t, ThreadEntry> thread_shards;
+  thread_local size_t prune_size = kPruneThreadShards;
+  auto it = thread_shards.find(id_);
+  if (it != thread_shards.end()) {
+    return it->second.shard;
+  }
+  if (thread_shards.size() >= prune_size) {
+    for (auto entry = thread_shards.begin(); entry != thread_shards.end();) {
+      entry = entry->second.owner.expired() ? thread_shards.erase(entry) : std::next(entry);
+    }
+    prune_size = std::max(kPruneThreadShards, thread_shards.size() * 2);
+  }
+  auto shard = std::make_shared<Shard>();
+  {
+    std::lock_guard<std::mutex> lock(mux_);
+    shards_.push_back(shard);
+  }
+  (void)thread_shards.emplace(id_, ThreadEntry{shard.get(), shard});
+  return shard.get();
+}
+
+void LatencyRecorder::Record(uint64_t ns) {
+  Shard *shard = ThreadShard();
+  // The calling thread is the only writer of its histogram, the atomics only let Snapshot read it meanwhile
+  std::atomic<uint64_t> &count = shard->counts[LatencyHistogram::BucketOf(ns)];
+  count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  shard->sum.store(shard->sum.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+}
+
+void LatencyRecorder::Snapshot(LatencyHistogram *histogram) const {
+  *histogram = LatencyHistogram();
+  uint64_t count = 0;
+  uint64_t sum = 0;
+  std::lock_guard<std::mutex> lock(mux_);
+  for (const auto &shard : shards_) {
+    for (int32_t i = 0; i < LatencyHistogram::kNumBuckets; i++) {
+      uint64_t bucket_count = shard->counts[i].load(std::memory_order_relaxed);
+      if (bucket_count != 0) {
+        histogram->AddToBucket(i, bucket_count);
+        count += bucket_count;
+      }
+    }
+    sum += shard->sum.load(std::memory_order_relaxed);
+  }
+  histogram->AddTotals(count, sum);
+}
+
+OpLatency::OpLatency(std::vector<std::string> tensor_op_names) : tensor_op_names_(std::move(tensor_op_names)) {
+  for (size_t i = 0; i < tensor_op_names_.size(); i++) {
+    tensor_ops_.push_back(std::make_unique<LatencyRecorder>());
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
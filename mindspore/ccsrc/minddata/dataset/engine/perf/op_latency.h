@@ -0,0 +1,154 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+/// \brief A distribution of latencies in nanoseconds, in log linear buckets: the values below 8 have a bucket each,
+///     above that every power of two is split into 8 buckets, so a percentile is within 6.25% of the true value.
+class LatencyHistogram {
+ public:
+  static constexpr int32_t kSubBucketBits = 3;
+  static constexpr int32_t kSubBuckets = 1 << kSubBucketBits;
+  // Values from 2^kMaxExponent ns (about 73 minutes) on are counted in the last bucket
+  static constexpr int32_t kMaxExponent = 42;
+  static constexpr int32_t kNumBuckets = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+  LatencyHistogram() : counts_{}, count_(0), sum_(0) {}
+
+  ~LatencyHistogram() = default;
+
+  /// \return The bucket of a latency
+  static int32_t BucketOf(uint64_t ns);
+
+  /// \return The latency reported for the values of a bucket, the middle of its range
+  static uint64_t BucketValue(int32_t bucket);
+
+  /// \brief Count a latency.
+  void Add(uint64_t ns);
+
+  /// \brief Add the counts of a bucket, which were recorded elsewhere.
+  void AddToBucket(int32_t bucket, uint64_t count) { counts_[bucket] += count; }
+
+  /// \brief Add the sum of latencies and their number, which were recorded elsewhere.
+  void AddTotals(uint64_t count, uint64_t sum) {
+    count_ += count;
+    sum_ += sum;
+  }
+
+  /// \brief Remove the latencies of an earlier snapshot of the same recorder, leaving those recorded since.
+  void Subtract(const LatencyHistogram &earlier);
+
+  /// \return The number of latencies
+  uint64_t Count() const { return count_; }
+
+  /// \return The sum of the latencies in nanoseconds
+  uint64_t Sum() const { return sum_; }
+
+  /// \return The mean latency in nanoseconds, 0 if there is none
+  double Mean() const { return count_ == 0 ? 0 : static_cast<double>(sum_) / static_cast<double>(count_); }
+
+  /// \brief The latency below which a fraction of the latencies fall.
+  /// \param[in] quantile The fraction, in [0, 1]
+  /// \return The latency in nanoseconds, 0 if there is none
+  uint64_t Percentile(double quantile) const;
+
+ private:
+  std::array<uint64_t, kNumBuckets> counts_;
+  uint64_t count_;
+  uint64_t sum_;
+};
+
+/// \brief Records latencies from any number of threads without a lock.
+///
+///     Each thread counts in a histogram of its own, created the first time it records. Only that thread writes to it,
+///     so a count is a relaxed load and store with no locked instruction and no cache line shared with another thread.
+///     The histograms of the threads are only merged, into a LatencyHistogram, when the profiler takes a sample.
+class LatencyRecorder {
+ public:
+  LatencyRecorder();
+
+  ~LatencyRecorder() = default;
+
+  LatencyRecorder(const LatencyRecorder &) = delete;
+  LatencyRecorder &operator=(const LatencyRecorder &) = delete;
+
+  /// \return The time of a steady clock in nanoseconds, to measure the latencies with
+  static uint64_t Now();
+
+  /// \brief Count a latency in the histogram of the calling thread.
+  void Record(uint64_t ns);
+
+  /// \brief Merge the histograms of the threads. The latencies recorded meanwhile may be counted or not.
+  /// \param[out] histogram The latencies recorded so far
+  void Snapshot(LatencyHistogram *histogram) const;
+
+ private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, LatencyHistogram::kNumBuckets> counts{};
+    std::atomic<uint64_t> sum{0};
+  };
+
+  // The histogram of the calling thread, created on its first record
+  Shard *ThreadShard();
+
+  const uint64_t id_;       // Unique in the process, the key of the histograms of this recorder in each thread
+  mutable std::mutex mux_;  // Guards the list of the histograms, not their counts
+  std::vector<std::shared_ptr<Shard>> shards_;
+};
+
+/// \brief The latencies of the rows of a dataset op, shared by the op, its output connector and the profiler.
+class OpLatency {
+ public:
+  /// \param[in] tensor_op_names The names of the TensorOps the op applies to the rows, if it is a map
+  explicit OpLatency(std::vector<std::string> tensor_op_names);
+
+  ~OpLatency() = default;
+
+  /// \return Time a worker spends computing a row
+  LatencyRecorder *Compute() { return &compute_; }
+
+  /// \return Time the op waits for room in its output connector, while its parent is slower
+  LatencyRecorder *PushWait() { return &push_wait_; }
+
+  /// \return Time the parent waits for a row from the output connector, while this op is slower
+  LatencyRecorder *PopWait() { return &pop_wait_; }
+
+  /// \return Time a TensorOp of a map spends on a row
+  LatencyRecorder *TensorOp(size_t index) { return tensor_ops_[index].get(); }
+
+  /// \return The names of the TensorOps
+  const std::vector<std::string> &TensorOpNames() const { return tensor_op_names_; }
+
+ private:
+  LatencyRecorder compute_;
+  LatencyRecorder push_wait_;
+  LatencyRecorder pop_wait_;
+  std::vector<std::string> tensor_op_names_;
+  std::vector<std::unique_ptr<LatencyRecorder>> tensor_ops_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_H_
@@ -0,0 +1,253 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/op_latency_sampler.h"
+
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/util/path.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr double kMedian = 0.5;
+constexpr double kTail = 0.99;
+constexpr uint64_t kNsPerMs = 1000000;
+// The stages of every op, the TensorOps of a map follow them
+enum OpStage { kCompute = 0, kPushWait = 1, kPopWait = 2, kFirstTensorOp = 3 };
+
+LatencyTotals Difference(const LatencyTotals &later, const LatencyTotals &earlier) {
+  LatencyTotals totals;
+  totals.count = later.count - std::min(later.count, earlier.count);
+  totals.sum_ns = later.sum_ns - std::min(later.sum_ns, earlier.sum_ns);
+  return totals;
+}
+}  // namespace
+
+Status OpLatencySampler::Init() {
+  ops_.clear();
+  // Tree Iterator is in PostOrder (leaf first, e.g., 3,2,1), the ops are kept root first.
+  for (auto &node : *tree_) {
+    OpEntry entry;
+    entry.op_id = node.id();
+    entry.op_type = node.Name();
+    entry.num_workers = static_cast<const DatasetOp &>(node).NumWorkers();
+    for (const auto &child : node.Children()) {
+      entry.children.push_back(child->id());
+    }
+    // An op already recording keeps its recorders, its threads may be running
+    entry.latency = node.Latency() != nullptr ? node.Latency() : node.EnableLatency();
+    entry.stages.push_back({"compute", entry.latency->Compute()});
+    entry.stages.push_back({"push_wait", entry.latency->PushWait()});
+    entry.stages.push_back({"pop_wait", entry.latency->PopWait()});
+    const auto &names = entry.latency->TensorOpNames();
+    for (size_t i = 0; i < names.size(); i++) {
+      entry.stages.push_back({names[i], entry.latency->TensorOp(i)});
+    }
+    for (auto &stage : entry.stages) {
+      stage.recorder->Snapshot(&stage.first);
+      stage.last = stage.first;
+    }
+    ops_.push_back(std::move(entry));
+  }
+  std::reverse(ops_.begin(), ops_.end());
+  return Status::OK();
+}
+
+Status OpLatencySampler::Sample() {
+  if (!active_) {
+    return Status::OK();
+  }
+  std::vector<std::vector<StageSample>> sample;
+  LatencyHistogram current;
+  for (auto &op : ops_) {
+    std::vector<StageSample> op_sample;
+    for (auto &stage : op.stages) {
+      stage.recorder->Snapshot(&current);
+      LatencyHistogram interval = current;
+      interval.Subtract(stage.last);
+      LatencyHistogram total = current;
+      total.Subtract(stage.first);
+      stage.last = current;
+      op_sample.push_back({{total.Count(), total.Sum()},
+                           interval.Count(),
+                           interval.Percentile(kMedian),
+                           interval.Percentile(kTail)});
+    }
+    sample.push_back(std::move(op_sample));
+  }
+  std::lock_guard<std::mutex> guard(lock_);
+  samples_.push_back(std::move(sample));
+  (void)ts_.emplace_back(ProfilingTime::GetCurMilliSecond());
+  return Status::OK();
+}
+
+std::vector<OpLatencyTotals> OpLatencySampler::Totals(size_t first, size_t last) const {
+  std::vector<OpLatencyTotals> result;
+  for (size_t i = 0; i < ops_.size(); i++) {
+    const auto &op = ops_[i];
+    OpLatencyTotals totals;
+    totals.op_id = op.op_id;
+    totals.op_type = op.op_type;
+    totals.num_workers = op.num_workers;
+    totals.children = op.children;
+    auto stage_totals = [this, first, last, i](size_t stage) {
+      return Difference(samples_[last][i][stage].totals, samples_[first][i][stage].totals);
+    };
+    totals.compute = stage_totals(kCompute);
+    totals.push_wait = stage_totals(kPushWait);
+    totals.pop_wait = stage_totals(kPopWait);
+    for (size_t stage = kFirstTensorOp; stage < op.stages.size(); stage++) {
+      totals.tensor_op_names.push_back(op.stages[stage].name);
+      totals.tensor_ops.push_back(stage_totals(stage));
+    }
+    result.push_back(std::move(totals));
+  }
+  return result;
+}
+
+Status OpLatencySampler::GetOpLatencies(uint64_t start_time, uint64_t end_time, std::vector<OpLatencyTotals> *result,
+                                        uint64_t *interval_ns) {
+  RETURN_UNEXPECTED_IF_NULL(result);
+  RETURN_UNEXPECTED_IF_NULL(interval_ns);
+  CHECK_FAIL_RETURN_UNEXPECTED(start_time < end_time,
+                               "Expected start_time < end_time. Got start_ts: " + std::to_string(start_time) +
+                                 " end_ts: " + std::to_string(end_time));
+  std::lock_guard<std::mutex> guard(lock_);
+  auto lower = std::lower_bound(ts_.begin(), ts_.end(), start_time);
+  auto upper = std::upper_bound(ts_.begin(), ts_.end(), end_time);
+  CHECK_FAIL_RETURN_UNEXPECTED(std::distance(lower, upper) >= 2,
+                               "Expected at least two latency samples between start_ts: " +
+                                 std::to_string(start_time) + " and end_ts: " + std::to_string(end_time));
+  auto first = static_cast<size_t>(std::distance(ts_.begin(), lower));
+  auto last = static_cast<size_t>(std::distance(ts_.begin(), upper)) - 1;
+  *result = Totals(first, last);
+  *interval_ns = (ts_[last] - ts_[first]) * kNsPerMs;
+  return Status::OK();
+}
+
+Status OpLatencySampler::GetBottleneck(uint64_t start_time, uint64_t end_time, BottleneckReport *result) {
+  RETURN_UNEXPECTED_IF_NULL(result);
+  std::vector<OpLatencyTotals> ops;
+  uint64_t interval_ns = 0;
+  RETURN_IF_NOT_OK(GetOpLatencies(start_time, end_time, &ops, &interval_ns));
+  return BottleneckAnalyzer::Analyze(ops, interval_ns, result);
+}
+
+Status OpLatencySampler::SaveToFile(const std::string &dir_path, const std::string &rank_id) {
+  Path path = GetFileName(dir_path, rank_id);
+  // Remove the file if it exists (from prior profiling usage)
+  RETURN_IF_NOT_OK(path.Remove());
+  std::string file_path = path.ToString();
+
+  nlohmann::json output;
+  output["sampling_interval"] = GlobalContext::config_manager()->monitor_sampling_interval();
+  std::lock_guard<std::mutex> guard(lock_);
+  output["time_stamp"] = ts_;
+  LatencyHistogram total;
+  for (size_t i = 0; i < ops_.size(); i++) {
+    const auto &op = ops_[i];
+    nlohmann::json json_op;
+    json_op["op_id"] = op.op_id;
+    json_op["op_type"] = op.op_type;
+    json_op["num_workers"] = op.num_workers;
+    nlohmann::json tensor_ops = nlohmann::json::array();
+    for (size_t stage = 0; stage < op.stages.size(); stage++) {
+      nlohmann::json metric;
+      std::vector<uint64_t> count, p50, p99;
+      for (const auto &sample : samples_) {
+        count.push_back(sample[i][stage].count);
+        p50.push_back(sample[i][stage].p50_ns);
+        p99.push_back(sample[i][stage].p99_ns);
+      }
+      metric["count"] = count;
+      metric["p50_ns"] = p50;
+      metric["p99_ns"] = p99;
+      // The percentiles over the whole run, including the rows after the last sample
+      op.stages[stage].recorder->Snapshot(&total);
+      total.Subtract(op.stages[stage].first);
+      metric["total"] = {{"count", total.Count()},
+                         {"mean_ns", total.Mean()},
+                         {"p50_ns", total.Percentile(kMedian)},
+                         {"p99_ns", total.Percentile(kTail)}};
+      if (stage < kFirstTensorOp) {
+        json_op["metrics"][op.stages[stage].name] = metric;
+      } else {
+        metric["name"] = op.stages[stage].name;
+        tensor_ops.push_back(metric);
+      }
+    }
+    if (!tensor_ops.empty()) {
+      json_op["metrics"]["tensor_ops"] = tensor_ops;
+    }
+    output["op_info"].push_back(json_op);
+  }
+
+  // The bottleneck over the whole run
+  if (ts_.size() >= 2 && ts_.back() > ts_.front()) {
+    BottleneckReport report;
+    RETURN_IF_NOT_OK(BottleneckAnalyzer::Analyze(Totals(0, ts_.size() - 1), (ts_.back() - ts_.front()) * kNsPerMs,
+                                                 &report));
+    if (report.op_id >= 0) {
+      output["bottleneck"] = {{"op_id", report.op_id},
+                              {"op_type", report.op_type},
+                              {"throughput", report.throughput},
+                              {"throughput_ceiling", report.ceiling},
+                              {"tensor_op", report.tensor_op},
+                              {"tensor_op_share", report.tensor_op_share},
+                              {"consumer_wait", report.consumer_wait}};
+      MS_LOG(INFO) << "The bottleneck of the pipeline is " << report.op_type << "(id: " << report.op_id
+                   << "), outputting " << report.throughput << " rows/sec out of an estimated ceiling of "
+                   << report.ceiling << " rows/sec.";
+    }
+  }
+
+  // Discard the content of the file when opening.
+  std::ofstream os(file_path, std::ios::trunc);
+  os << output;
+  os.close();
+  return Status::OK();
+}
+
+Status OpLatencySampler::ChangeFileMode(const std::string &dir_path, const std::string &rank_id) {
+  Path path = GetFileName(dir_path, rank_id);
+  std::string file_path = path.ToString();
+  if (chmod(common::SafeCStr(file_path), S_IRUSR | S_IWUSR) == -1) {
+    std::string err_str = "Change file mode failed," + file_path;
+    return Status(StatusCode::kMDUnexpectedError, err_str);
+  }
+  return Status::OK();
+}
+
+void OpLatencySampler::Clear() {
+  std::lock_guard<std::mutex> guard(lock_);
+  ts_.clear();
+  samples_.clear();
+  ops_.clear();
+}
+
+Path OpLatencySampler::GetFileName(const std::string &dir_path, const std::string &rank_id) {
+  return Path(dir_path) / Path("op_latency_profiling_" + rank_id + ".json");
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_SAMPLER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_SAMPLER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/engine/perf/bottleneck_analyzer.h"
+#include "minddata/dataset/engine/perf/op_latency.h"
+#include "minddata/dataset/engine/perf/profiling.h"
+
+namespace mindspore {
+namespace dataset {
+class ExecutionTree;
+
+// Samples the latency histograms of every op in the pipeline: the compute time of the rows in the map workers and
+// of each of their TensorOps, and the time rows wait on both sides of the output connectors. Each sample keeps the
+// p50 and p99 of the interval since the previous one, the totals find the bottleneck over any range of samples.
+class OpLatencySampler : public Sampling {
+ public:
+  explicit OpLatencySampler(ExecutionTree *tree) : tree_(tree) {}
+
+  ~OpLatencySampler() override = default;
+
+  // Start recording the latencies in the ops of the tree, which must not be launched yet unless they already record.
+  Status Init() override;
+
+  // Driver function for the sampling, merges the histograms of every op.
+  Status Sample() override;
+
+  std::string Name() const override { return kOpLatencySamplerName; }
+
+  // Save sampling data to file
+  // @return Status The status code returned
+  Status SaveToFile(const std::string &dir_path, const std::string &rank_id) override;
+
+  Status ChangeFileMode(const std::string &dir_path, const std::string &rank_id) override;
+
+  // Get the latencies of the ops between the first sample at or after start time and the last one at or before end
+  // time.
+  // @param start_time - the start of the interval, in milliseconds
+  // @param end_time - the end of the interval, in milliseconds
+  // @param result - the latencies of the ops, the root first
+  // @param interval_ns - the time between the two samples, in nanoseconds
+  // @return Status The status code returned
+  Status GetOpLatencies(uint64_t start_time, uint64_t end_time, std::vector<OpLatencyTotals> *result,
+                        uint64_t *interval_ns);
+
+  // Find the bottleneck of the pipeline between start and end time
+  // @param start_time - the start of the interval, in milliseconds
+  // @param end_time - the end of the interval, in milliseconds
+  // @param result - the bottleneck
+  // @return Status The status code returned
+  Status GetBottleneck(uint64_t start_time, uint64_t end_time, BottleneckReport *result);
+
+  // Clear all collected data
+  void Clear() override;
+
+ protected:
+  Path GetFileName(const std::string &dir_path, const std::string &rank_id) override;
+
+ private:
+  // A histogram of an op, and its snapshots at Init and at the last sample
+  struct Stage {
+    std::string name;
+    LatencyRecorder *recorder;
+    LatencyHistogram first;
+    LatencyHistogram last;
+  };
+
+  // The recorded stages of an op: compute, push wait, pop wait and then the TensorOps
+  struct OpEntry {
+    int32_t op_id;
+    std::string op_type;
+    int32_t num_workers;
+    std::vector<int32_t> children;
+    std::shared_ptr<OpLatency> latency;
+    std::vector<Stage> stages;
+  };
+
+  // A stage at a sample: the totals since Init, and the percentiles of the interval since the previous sample
+  struct StageSample {
+    LatencyTotals totals;
+    uint64_t count;
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+  };
+
+  // Totals of the ops between two samples
+  std::vector<OpLatencyTotals> Totals(size_t first, size_t last) const;
+
+  ExecutionTree *tree_ = nullptr;
+  std::vector<OpEntry> ops_;                                  // The root first
+  std::vector<std::vector<std::vector<StageSample>>> samples_;  // By sample, op and stage
+  std::vector<uint64_t> ts_;                                  // time of sample
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_OP_LATENCY_SAMPLER_H_
@@ -25,6 +25,8 @@
 #include "minddata/dataset/engine/perf/connector_size.h"
 #include "minddata/dataset/engine/perf/cpu_sampler.h"
 #include "minddata/dataset/engine/perf/monitor.h"
+#include "minddata/dataset/engine/perf/op_latency_sampler.h"
+#include "minddata/dataset/engine/perf/tensor_pool_sampler.h"
 #include "minddata/dataset/engine/tree_adapter.h"
 #include "minddata/dataset/util/log_adapter.h"
 #include "minddata/dataset/util/path.h"
@@ -260,6 +262,15 @@ Status ProfilingManager::RegisterTree(const TreeAdapter *tree_adapter) {
   std::shared_ptr<Sampling> cpu_sampler = std::make_shared<CpuSampler>(tree_);
   RETURN_IF_NOT_OK(RegisterSamplingNode(cpu_sampler));
 #endif
+  if (tree_->TensorPool() != nullptr) {
+    std::shared_ptr<Sampling> tensor_pool_sampler = std::make_shared<TensorPoolSampler>(tree_->TensorPool());
+    RETURN_IF_NOT_OK(RegisterSamplingNode(tensor_pool_sampler));
+  }
+  // The latencies of the rows are timed by the ops themselves, only when the user asked for profiling
+  if (profiling_) {
+    std::shared_ptr<Sampling> op_latency_sampler = std::make_shared<OpLatencySampler>(tree_);
+    RETURN_IF_NOT_OK(RegisterSamplingNode(op_latency_sampler));
+  }
   // can insert a correct timestamp so that we can ignore the samples that were taken
   // during start up of the pipeline.
   (void)epoch_end_ts_.emplace_back(0);
@@ -686,6 +697,25 @@ Status ProfilingManager::GetConnectorCapacityByTime(uint64_t start_ts, uint64_t
   return GetConnectorCapacityByStep(start_step, end_step, result);
 }
 
+Status ProfilingManager::GetBottleneckByEpoch(int32_t epoch_num, BottleneckReport *result) {
+  uint64_t start_ts = 0, end_ts = 0;
+  RETURN_IF_NOT_OK(EpochToTimeInterval(epoch_num, &start_ts, &end_ts));
+  return GetBottleneckByTime(start_ts, end_ts, result);
+}
+
+Status ProfilingManager::GetBottleneckByStep(int32_t start_step, int32_t end_step, BottleneckReport *result) {
+  uint64_t start_ts = 0, end_ts = 0;
+  RETURN_IF_NOT_OK(StepToTimeInterval(start_step, end_step, &start_ts, &end_ts));
+  return GetBottleneckByTime(start_ts, end_ts, result);
+}
+
+Status ProfilingManager::GetBottleneckByTime(uint64_t start_ts, uint64_t end_ts, BottleneckReport *result) {
+  std::shared_ptr<Sampling> node;
+  RETURN_IF_NOT_OK(GetSamplingNode(kOpLatencySamplerName, &node));
+  auto latency_node = std::dynamic_pointer_cast<OpLatencySampler>(node);
+  return latency_node->GetBottleneck(start_ts, end_ts, result);
+}
+
 Status ProfilingManager::GetNumberOfProfiledSteps(int32_t *steps) {
   std::shared_ptr<Tracing> node;
   if (GetTracingNode(kDeviceQueueTracingName, &node).IsOk() ||
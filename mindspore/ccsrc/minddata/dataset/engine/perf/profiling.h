@@ -36,11 +36,14 @@ class ExecutionTree;
 class TreeConsumer;
 class CpuSampler;
 class TreeAdapter;
+struct BottleneckReport;
 
 const char kDeviceQueueTracingName[] = "Device_Queue_Tracing";
 const char kDatasetIteratorTracingName[] = "Dataset_Iterator_Tracing";
 const char kConnectorSizeSamplingName[] = "Connector_Size_Sampling";
 const char kCpuSamplerName[] = "Cpu_Sampler";
+const char kTensorPoolSamplerName[] = "Tensor_Pool_Sampler";
+const char kOpLatencySamplerName[] = "Op_Latency_Sampler";
 
 // Values for process memory metrics - common for profiling and cpu_sampler
 enum ProcessMemoryMetric { kPSS, kRSS, kVSS };
@@ -497,6 +500,26 @@ class ProfilingManager {
   /// \return Status object with the error code
   Status GetEmptyQueueFrequencyByTime(uint64_t start_ts, uint64_t end_ts, float_t *result);
 
+  /// \brief API to find the op limiting the throughput of the pipeline, from the latencies of its rows
+  /// \param [in] epoch_num The epoch number for which results are requested
+  /// \param [out] result The bottleneck op and its estimated throughput ceiling
+  /// \return Status object with the error code
+  Status GetBottleneckByEpoch(int32_t epoch_num, BottleneckReport *result);
+
+  /// \brief API to find the op limiting the throughput of the pipeline, from the latencies of its rows
+  /// \param [in] start_step The step interval start range
+  /// \param [in] end_step The step interval end range
+  /// \param [out] result The bottleneck op and its estimated throughput ceiling
+  /// \return Status object with the error code
+  Status GetBottleneckByStep(int32_t start_step, int32_t end_step, BottleneckReport *result);
+
+  /// \brief API to find the op limiting the throughput of the pipeline, from the latencies of its rows
+  /// \param [in] start_ts The time interval start range in ms
+  /// \param [in] end_ts The time interval end range in ms
+  /// \param [out] result The bottleneck op and its estimated throughput ceiling
+  /// \return Status object with the error code
+  Status GetBottleneckByTime(uint64_t start_ts, uint64_t end_ts, BottleneckReport *result);
+
   // Register profile node to tree
   // @param node - Profiling node
   // @return Status The status code returned
@@ -0,0 +1,106 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/tensor_pool_sampler.h"
+
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/util/path.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace dataset {
+Status TensorPoolSampler::Sample() {
+  if (!active_) {
+    return Status::OK();
+  }
+  TensorBufferPool::Stats stats = pool_->GetStats();
+  std::lock_guard<std::mutex> guard(lock_);
+  samples_.push_back(stats);
+  (void)ts_.emplace_back(ProfilingTime::GetCurMilliSecond());
+  return Status::OK();
+}
+
+Status TensorPoolSampler::SaveToFile(const std::string &dir_path, const std::string &rank_id) {
+  Path path = GetFileName(dir_path, rank_id);
+  // Remove the file if it exists (from prior profiling usage)
+  RETURN_IF_NOT_OK(path.Remove());
+  std::string file_path = path.ToString();
+
+  nlohmann::json output;
+  output["sampling_interval"] = GlobalContext::config_manager()->monitor_sampling_interval();
+  output["capacity_bytes"] = pool_->capacity();
+  std::lock_guard<std::mutex> guard(lock_);
+  output["time_stamp"] = ts_;
+  std::vector<uint64_t> hits, misses, bytes_in_pool, bytes_in_use;
+  for (const auto &sample : samples_) {
+    hits.push_back(sample.hits);
+    misses.push_back(sample.misses);
+    bytes_in_pool.push_back(sample.bytes_in_pool);
+    bytes_in_use.push_back(sample.bytes_in_use);
+  }
+  output["hits"] = hits;
+  output["misses"] = misses;
+  output["bytes_in_pool"] = bytes_in_pool;
+  output["bytes_in_use"] = bytes_in_use;
+
+  // Discard the content of the file when opening.
+  std::ofstream os(file_path, std::ios::trunc);
+  os << output;
+  os.close();
+  return Status::OK();
+}
+
+Status TensorPoolSampler::ChangeFileMode(const std::string &dir_path, const std::string &rank_id) {
+  Path path = GetFileName(dir_path, rank_id);
+  std::string file_path = path.ToString();
+  if (chmod(common::SafeCStr(file_path), S_IRUSR | S_IWUSR) == -1) {
+    std::string err_str = "Change file mode failed," + file_path;
+    return Status(StatusCode::kMDUnexpectedError, err_str);
+  }
+  return Status::OK();
+}
+
+Status TensorPoolSampler::GetSamples(uint64_t start_time, uint64_t end_time,
+                                     std::vector<TensorBufferPool::Stats> *result) {
+  RETURN_UNEXPECTED_IF_NULL(result);
+  CHECK_FAIL_RETURN_UNEXPECTED(start_time < end_time,
+                               "Expected start_time < end_time. Got start_ts: " + std::to_string(start_time) +
+                                 " end_ts: " + std::to_string(end_time));
+  std::lock_guard<std::mutex> guard(lock_);
+  auto lower = std::lower_bound(ts_.begin(), ts_.end(), start_time);
+  auto upper = std::upper_bound(ts_.begin(), ts_.end(), end_time);
+  (void)result->insert(result->end(), samples_.begin() + std::distance(ts_.begin(), lower),
+                       samples_.begin() + std::distance(ts_.begin(), upper));
+  return Status::OK();
+}
+
+void TensorPoolSampler::Clear() {
+  std::lock_guard<std::mutex> guard(lock_);
+  ts_.clear();
+  samples_.clear();
+}
+
+Path TensorPoolSampler::GetFileName(const std::string &dir_path, const std::string &rank_id) {
+  return Path(dir_path) / Path("tensor_pool_profiling_" + rank_id + ".json");
+}
+}  // namespace dataset
+}  // namespace mindspore
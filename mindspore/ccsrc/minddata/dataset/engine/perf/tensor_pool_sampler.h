@@ -0,0 +1,69 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_TENSOR_POOL_SAMPLER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_TENSOR_POOL_SAMPLER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/engine/perf/profiling.h"
+#include "minddata/dataset/util/tensor_buffer_pool.h"
+
+namespace mindspore {
+namespace dataset {
+// Samples the counters of the tensor buffer pool of a pipeline: the hits and misses of the allocations,
+// and the bytes of the buffers held by the pool and in use by the rows.
+class TensorPoolSampler : public Sampling {
+ public:
+  explicit TensorPoolSampler(std::shared_ptr<TensorBufferPool> pool) : pool_(std::move(pool)) {}
+
+  ~TensorPoolSampler() override = default;
+
+  Status Init() override { return Status::OK(); }
+
+  // Driver function for the sampling, takes a snapshot of the counters of the pool.
+  Status Sample() override;
+
+  std::string Name() const override { return kTensorPoolSamplerName; }
+
+  // Save sampling data to file
+  // @return Status The status code returned
+  Status SaveToFile(const std::string &dir_path, const std::string &rank_id) override;
+
+  Status ChangeFileMode(const std::string &dir_path, const std::string &rank_id) override;
+
+  // Get the samples taken between start and end time
+  // @param start_time - the start of the interval, in milliseconds
+  // @param end_time - the end of the interval, in milliseconds
+  // @param result - the samples
+  // @return Status The status code returned
+  Status GetSamples(uint64_t start_time, uint64_t end_time, std::vector<TensorBufferPool::Stats> *result);
+
+  // Clear all collected data
+  void Clear() override;
+
+ protected:
+  Path GetFileName(const std::string &dir_path, const std::string &rank_id) override;
+
+ private:
+  std::shared_ptr<TensorBufferPool> pool_;
+  std::vector<TensorBufferPool::Stats> samples_;
+  std::vector<uint64_t> ts_;  // time of sample
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_TENSOR_POOL_SAMPLER_H_
@@ -0,0 +1,74 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/pipeline_state.h"
+
+#include <string>
+
+#include "minddata/dataset/engine/datasetops/dataset_op.h"
+
+namespace mindspore {
+namespace dataset {
+StateHistory::StateHistory(int32_t size) : size_(static_cast<size_t>(size)), base_step_(0), first_step_(1) {}
+
+void StateHistory::AddOp(DatasetOp *op) {
+  std::lock_guard<std::mutex> lock(mux_);
+  ops_[op->id()] = op;
+}
+
+void StateHistory::Restart(int64_t step) {
+  std::lock_guard<std::mutex> lock(mux_);
+  states_.clear();
+  base_step_ = step;
+  first_step_ = step + 1;
+}
+
+void StateHistory::Record(const TensorRow &row) {
+  std::lock_guard<std::mutex> lock(mux_);
+  states_.push_back(row.getState());
+  if (states_.size() <= size_) {
+    return;
+  }
+  states_.pop_front();
+  first_step_++;
+  // Nothing before the oldest state left can be restored any more
+  for (auto state = states_.front(); state != nullptr; state = state->child) {
+    auto it = ops_.find(state->op_id);
+    if (it != ops_.end()) {
+      it->second->ReleaseState(*state);
+    }
+  }
+}
+
+Status StateHistory::Get(int64_t step, std::shared_ptr<const RowState> *state) const {
+  RETURN_UNEXPECTED_IF_NULL(state);
+  std::lock_guard<std::mutex> lock(mux_);
+  auto last_step = first_step_ + static_cast<int64_t>(states_.size()) - 1;
+  if (step < first_step_ || step > last_step) {
+    RETURN_STATUS_UNEXPECTED("The state of step " + std::to_string(step) + " is not kept, the history holds steps " +
+                             std::to_string(first_step_) + " to " + std::to_string(last_step) + ".");
+  }
+  *state = states_[step - first_step_];
+  CHECK_FAIL_RETURN_UNEXPECTED(*state != nullptr,
+                               "The row of step " + std::to_string(step) + " does not carry the pipeline state.");
+  return Status::OK();
+}
+
+int64_t StateHistory::BaseStep() const {
+  std::lock_guard<std::mutex> lock(mux_);
+  return base_step_;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PIPELINE_STATE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PIPELINE_STATE_H_
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class DatasetOp;
+
+/// \brief The state of an operator right after it sent a row, carried by the row. An operator which keeps a state
+/// between rows puts its own state on the rows it sends, linked to the state of the latest row it got from its child.
+/// An operator which only transforms the rows it gets passes their state along. The row which reaches the consumer
+/// then tells where each operator of the pipeline was when the row was sent, in a few integers.
+struct RowState {
+  RowState(int32_t op_id, std::vector<int64_t> cursor, std::shared_ptr<const RowState> child)
+      : op_id(op_id), cursor(std::move(cursor)), child(std::move(child)) {}
+
+  int32_t op_id;                          // The operator which sent the row
+  std::vector<int64_t> cursor;            // Where the operator was, the meaning is up to the operator
+  std::shared_ptr<const RowState> child;  // The state of the child of the operator, null for a leaf
+};
+
+/// \brief The states of the rows sent to the consumer over the last steps of a pipeline. When the pipeline is reset
+/// to one of these steps, the new pipeline is restored to the state of the step instead of skipping the rows before.
+class StateHistory {
+ public:
+  /// \brief Constructor
+  /// \param[in] size The number of steps kept
+  explicit StateHistory(int32_t size);
+
+  ~StateHistory() = default;
+
+  /// \brief Register an operator of the tree, which is told when the states before the history are dropped
+  /// \param[in] op The operator
+  void AddOp(DatasetOp *op);
+
+  /// \brief Count the steps from the given step, for a pipeline restored to it
+  /// \param[in] step The step of the restored state
+  void Restart(int64_t step);
+
+  /// \brief Keep the state of a row sent to the consumer. The state of the oldest step is dropped if the history is
+  /// full, and the operators are told they will not be restored to it.
+  /// \param[in] row The row
+  void Record(const TensorRow &row);
+
+  /// \brief Get the state of the pipeline after the given step
+  /// \param[in] step The step, as the number of rows sent since the start of the first epoch
+  /// \param[out] state The state carried by the row of the step
+  /// \return Status object, error if the step is not in the history
+  Status Get(int64_t step, std::shared_ptr<const RowState> *state) const;
+
+  /// \return The step the counting started from, that of a restored pipeline or 0
+  int64_t BaseStep() const;
+
+ private:
+  const size_t size_;
+  mutable std::mutex mux_;
+  std::deque<std::shared_ptr<const RowState>> states_;  // The state of each step from first_step_ on
+  int64_t base_step_;
+  int64_t first_step_;
+  std::unordered_map<int32_t, DatasetOp *> ops_;  // The operators of the tree by id, no ownership
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PIPELINE_STATE_H_
@@ -16,9 +16,12 @@
 
 #include "minddata/dataset/engine/tree_adapter.h"
 
+#include <unordered_map>
+
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/ir/datasetops/root_node.h"
 #ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/opt/optional/batch_compute_pass.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/pre/cache_transform_pass.h"
 #include "minddata/dataset/engine/opt/pre/node_offload_pass.h"
@@ -102,6 +105,8 @@ Status TreeAdapter::Optimize(std::shared_ptr<DatasetNode> ir) {
   MS_LOG(INFO) << "Running optimization pass loops";
 #ifndef ENABLE_ANDROID
   (void)optimizations.emplace_back(std::make_unique<TensorOpFusionPass>());
+  // after the fusion, which may replace the operations of the maps
+  (void)optimizations.emplace_back(std::make_unique<BatchComputePass>());
 #endif
   // Apply optimization pass actions
   for (auto i = 0; i < optimizations.size(); i++) {
@@ -174,6 +179,11 @@ Status TreeAdapter::Build(std::shared_ptr<DatasetNode> root_ir) {
   RETURN_UNEXPECTED_IF_NULL(root_ir);
   // Create ExecutionTree
   tree_ = std::make_unique<ExecutionTree>();
+  // Only the rows sent to a consumer are counted as steps, so that a reset can be restored to one of them
+  auto cfg = GlobalContext::config_manager();
+  if (usage_ != kDeGetter && cfg->fast_recovery()) {
+    tree_->EnableStateHistory(cfg->state_history_size());
+  }
 
   // Build the Execution tree from the child of the IR root node, which represent the root of the input IR tree
   std::shared_ptr<DatasetOp> root_op;
@@ -265,6 +275,7 @@ Status TreeAdapter::GetNext(TensorRow *row) {
     std::string err = "EOF buffer encountered. User tries to fetch data beyond the specified number of epochs.";
     RETURN_STATUS_UNEXPECTED(err);
   }
+  tree_->RecordRowState(*row);
 
   // Record profiling info
 #ifndef ENABLE_SECURITY
@@ -283,6 +294,98 @@ Status TreeAdapter::GetNext(TensorRow *row) {
   return Status::OK();
 }
 
+Status TreeAdapter::GetState(int64_t step, nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(tree_);
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  std::shared_ptr<StateHistory> history = tree_->state_history();
+  CHECK_FAIL_RETURN_UNEXPECTED(history != nullptr, "The pipeline does not keep the state of its last steps.");
+  if (!restored_state_.is_null() && step == history->BaseStep()) {
+    *out_json = restored_state_;
+    return Status::OK();
+  }
+  std::shared_ptr<const RowState> state;
+  RETURN_IF_NOT_OK(history->Get(step, &state));
+
+  std::unordered_map<int32_t, std::shared_ptr<DatasetOp>> ops;
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    ops[itr->id()] = itr.get();
+  }
+  // Each operator which keeps a state put it on the row, linked to the state of its child
+  std::unordered_map<int32_t, nlohmann::json> op_states;
+  for (; state != nullptr; state = state->child) {
+    auto it = ops.find(state->op_id);
+    CHECK_FAIL_RETURN_UNEXPECTED(it != ops.end(), "[Internal ERROR] Invalid pipeline state.");
+    nlohmann::json op_state;
+    RETURN_IF_NOT_OK(it->second->GetState(*state, &op_state));
+    op_states[state->op_id] = std::move(op_state);
+  }
+  // An operator which did not get a row since the pipeline was restored is still in its restored state
+  if (!restored_state_.is_null()) {
+    for (const auto &op_state : restored_state_["ops"]) {
+      (void)op_states.emplace(op_state["id"].get<int32_t>(), op_state["state"]);
+    }
+  }
+
+  nlohmann::json op_list = nlohmann::json::array();
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    auto it = op_states.find(itr->id());
+    if (it != op_states.end()) {
+      op_list.push_back({{"id", itr->id()}, {"name", itr->Name()}, {"state", it->second}});
+    } else {
+      CHECK_FAIL_RETURN_UNEXPECTED(itr->Stateless(), "The state of " + itr->NameWithID() + " cannot be restored.");
+    }
+  }
+  *out_json = {{"step", step}, {"ops", std::move(op_list)}};
+  return Status::OK();
+}
+
+Status TreeAdapter::RestoreState(const nlohmann::json &state) {
+  RETURN_UNEXPECTED_IF_NULL(tree_);
+  CHECK_FAIL_RETURN_UNEXPECTED(!launched_, "[Internal ERROR] The state of a launched pipeline cannot be restored.");
+  CHECK_FAIL_RETURN_UNEXPECTED(state.contains("step") && state.contains("ops"), "Invalid pipeline state.");
+  std::unordered_map<int32_t, std::shared_ptr<DatasetOp>> ops;
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    ops[itr->id()] = itr.get();
+  }
+  std::unordered_map<int32_t, bool> restored;
+  for (const auto &op_state : state["ops"]) {
+    auto id = op_state["id"].get<int32_t>();
+    auto it = ops.find(id);
+    CHECK_FAIL_RETURN_UNEXPECTED(it != ops.end() && it->second->Name() == op_state["name"].get<std::string>(),
+                                 "The pipeline state does not match the pipeline at operator " + std::to_string(id) +
+                                   ".");
+    RETURN_IF_NOT_OK(it->second->RestoreState(op_state["state"]));
+    restored[id] = true;
+  }
+  for (const auto &op : ops) {
+    CHECK_FAIL_RETURN_UNEXPECTED(restored.count(op.first) > 0 || op.second->Stateless(),
+                                 "The pipeline state does not hold the state of " + op.second->NameWithID() + ".");
+  }
+  int32_t num_eoes = 0;
+  RETURN_IF_NOT_OK(RestoreRepeatsRecur(tree_->root(), &num_eoes));
+
+  auto step = state["step"].get<int64_t>();
+  if (tree_->state_history() != nullptr) {
+    tree_->state_history()->Restart(step);
+  }
+  restored_state_ = state;
+  MS_LOG(INFO) << "The pipeline is restored to step " << step << ".";
+  return Status::OK();
+}
+
+Status TreeAdapter::RestoreRepeatsRecur(const std::shared_ptr<DatasetOp> &op, int32_t *num_eoes) {
+  RETURN_UNEXPECTED_IF_NULL(op);
+  auto children = op->Children();
+  CHECK_FAIL_RETURN_UNEXPECTED(children.size() <= 1,
+                               "The state of " + op->NameWithID() + " with several children cannot be restored.");
+  int32_t child_eoes = 0;
+  if (!children.empty()) {
+    RETURN_IF_NOT_OK(RestoreRepeatsRecur(children[0], &child_eoes));
+  }
+  *num_eoes = op->RestoreRepeats(child_eoes);
+  return Status::OK();
+}
+
 Status TreeAdapter::Launch() {
   CHECK_FAIL_RETURN_UNEXPECTED(tree_ != nullptr, "Tree is a nullptr.");
   RETURN_IF_NOT_OK(tree_->Launch());
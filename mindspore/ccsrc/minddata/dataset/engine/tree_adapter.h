@@ -81,6 +81,20 @@ class TreeAdapter {
 
   Status Launch();
 
+  /// \brief Gives the state of the pipeline after the given step, from the state carried by the row of the step.
+  ///     Only available if the pipeline keeps the states of the last steps, see ConfigManager::state_history_size().
+  ///     The states are kept in memory only, they are not saved with a checkpoint of the network.
+  /// \param[in] step The number of rows sent since the start of the first epoch
+  /// \param[out] out_json The state of each operator
+  /// \return Status error if the state of the step is not kept or an operator does not support it
+  Status GetState(int64_t step, nlohmann::json *out_json);
+
+  /// \brief Restores the pipeline to a state given by GetState, instead of skipping the rows before the step.
+  ///     Called after the pipeline is compiled and before it is launched.
+  /// \param[in] state The state of each operator
+  /// \return Status error if the state does not match the pipeline
+  Status RestoreState(const nlohmann::json &state);
+
   // Set optional optimization pass
   void SetOptimize(bool value) { optimize_ = value; }
 
@@ -120,6 +134,9 @@ class TreeAdapter {
   // This RECURSIVE function walks the (optimized) IR tree in DFS to build its corresponding Execution tree.
   Status BuildExecutionTreeRecur(std::shared_ptr<DatasetNode> ir, std::shared_ptr<DatasetOp> *op);
 
+  // This RECURSIVE function sets the repeat counters of the restored operators from the leaves up.
+  Status RestoreRepeatsRecur(const std::shared_ptr<DatasetOp> &op, int32_t *num_eoes);
+
   std::unordered_map<std::string, int32_t> column_name_map_;
   std::shared_ptr<DatasetNode> input_ir_;
   std::shared_ptr<DatasetNode> root_ir_;
@@ -144,6 +161,7 @@ class TreeAdapter {
   };
   CompileState tree_state_;
   nlohmann::json offload_json_;
+  nlohmann::json restored_state_;  // The state the pipeline was restored to, null if it was not
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -123,7 +123,9 @@ enum class DATASET_API ShuffleMode {
   kFalse = 0,   ///< No shuffling is performed.
   kFiles = 1,   ///< Shuffle files only.
   kGlobal = 2,  ///< Shuffle both the files and samples.
-  kInfile = 3   ///< Shuffle data within each file.
+  kInfile = 3,  ///< Shuffle data within each file.
+  kPartial = 4  ///< Shuffle blocks of samples of all the files, then samples within windows of blocks, with an order
+                ///< computed on demand from the seed instead of kept in memory.
 };
 
 /// \brief Possible scale for input audio.
@@ -3848,6 +3848,7 @@ class DATASET_API MindDataDataset : public Dataset {
   ///    ShuffleMode::kFiles - Shuffle files only.
   ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
   ///    ShuffleMode::kInfile - Shuffle samples in file.
+  ///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
   /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
   MindDataDataset(const std::vector<char> &dataset_file, const std::vector<std::vector<char>> &columns_list,
                   const std::shared_ptr<Sampler> &sampler, const nlohmann::json *padded_sample, int64_t num_padded,
@@ -3868,6 +3869,7 @@ class DATASET_API MindDataDataset : public Dataset {
   ///    ShuffleMode::kFiles - Shuffle files only.
   ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
   ///    ShuffleMode::kInfile - Shuffle samples in file.
+  ///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
   /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
   MindDataDataset(const std::vector<char> &dataset_file, const std::vector<std::vector<char>> &columns_list,
                   const Sampler *sampler, const nlohmann::json *padded_sample, int64_t num_padded,
@@ -3888,6 +3890,7 @@ class DATASET_API MindDataDataset : public Dataset {
   ///    ShuffleMode::kFiles - Shuffle files only.
   ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
   ///    ShuffleMode::kInfile - Shuffle samples in file.
+  ///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
   /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
   MindDataDataset(const std::vector<char> &dataset_file, const std::vector<std::vector<char>> &columns_list,
                   const std::reference_wrapper<Sampler> &sampler, const nlohmann::json *padded_sample,
@@ -3907,6 +3910,7 @@ class DATASET_API MindDataDataset : public Dataset {
   ///    ShuffleMode::kFiles - Shuffle files only.
   ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
   ///    ShuffleMode::kInfile - Shuffle data within each file.
+  ///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
   /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
   MindDataDataset(const std::vector<std::vector<char>> &dataset_files,
                   const std::vector<std::vector<char>> &columns_list, const std::shared_ptr<Sampler> &sampler,
@@ -3927,6 +3931,7 @@ class DATASET_API MindDataDataset : public Dataset {
   ///    ShuffleMode::kFiles - Shuffle files only.
   ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
   ///    ShuffleMode::kInfile - Shuffle data within each file.
+  ///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
   /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
   MindDataDataset(const std::vector<std::vector<char>> &dataset_files,
                   const std::vector<std::vector<char>> &columns_list, const Sampler *sampler,
@@ -3947,6 +3952,7 @@ class DATASET_API MindDataDataset : public Dataset {
   ///    ShuffleMode::kFiles - Shuffle files only.
   ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
   ///    ShuffleMode::kInfile - Shuffle samples in file.
+  ///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
   /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
   MindDataDataset(const std::vector<std::vector<char>> &dataset_files,
                   const std::vector<std::vector<char>> &columns_list, const std::reference_wrapper<Sampler> &sampler,
@@ -3973,6 +3979,7 @@ class DATASET_API MindDataDataset : public Dataset {
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle samples in file.
+///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the current MindDataDataset.
 /// \par Example
@@ -4013,6 +4020,7 @@ MindData(const std::string &dataset_file, const std::vector<std::string> &column
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle samples in file.
+///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the MindDataDataset.
 inline std::shared_ptr<MindDataDataset> DATASET_API
@@ -4036,6 +4044,7 @@ MindData(const std::string &dataset_file, const std::vector<std::string> &column
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle samples in file.
+///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the MindDataDataset.
 inline std::shared_ptr<MindDataDataset> DATASET_API MindData(
@@ -4060,6 +4069,7 @@ inline std::shared_ptr<MindDataDataset> DATASET_API MindData(
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle samples in file.
+///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the MindDataDataset.
 /// \par Example
@@ -4101,6 +4111,7 @@ MindData(const std::vector<std::string> &dataset_files, const std::vector<std::s
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle data within each file.
+///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the MindDataDataset.
 inline std::shared_ptr<MindDataDataset> DATASET_API
@@ -4124,6 +4135,7 @@ MindData(const std::vector<std::string> &dataset_files, const std::vector<std::s
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle samples in file.
+///    ShuffleMode::kPartial - Shuffle blocks of samples, then samples within windows of blocks.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the MindDataDataset.
 inline std::shared_ptr<MindDataDataset> DATASET_API MindData(
@@ -15,6 +15,9 @@
  */
 #include "minddata/dataset/kernels/data/one_hot_op.h"
 
+#include <string>
+#include <vector>
+
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/data/data_utils.h"
 #include "minddata/dataset/kernels/tensor_op.h"
@@ -27,6 +30,34 @@ Status OneHotOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   return s;
 }
 
+Status OneHotOp::BatchCompute(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  CHECK_FAIL_RETURN_UNEXPECTED(input.size() == 1, "OneHot: OneHot can only accept one tensor as input.");
+  std::shared_ptr<Tensor> labels = input[0];
+  CHECK_FAIL_RETURN_UNEXPECTED(labels->Rank() > 0, "OneHot: the input tensor is not batched.");
+  TensorShape batch_shape = labels->shape();
+  std::vector<dsize_t> dims = batch_shape.AsVector();
+  dsize_t batch_size = dims[0];
+  // the labels of one row, squeezed the same way as OneHotEncoding squeezes its input
+  TensorShape row_shape = TensorShape(std::vector<dsize_t>(dims.begin() + 1, dims.end())).Squeeze();
+  if (row_shape.Rank() > 1) {
+    RETURN_STATUS_UNEXPECTED("OneHot: OneHot only supports scalars or 1D input, got rank: " +
+                             std::to_string(row_shape.Rank()));
+  }
+  dsize_t labels_per_row = row_shape.NumOfElements();
+
+  // encode the labels of all the rows as one 1D tensor, then give each row the shape of its own encoding
+  RETURN_IF_NOT_OK(labels->Reshape(TensorShape({batch_size * labels_per_row})));
+  std::shared_ptr<Tensor> encoded;
+  Status rc = OneHotEncoding(labels, &encoded, num_classes_, smoothing_rate_);
+  RETURN_IF_NOT_OK(labels->Reshape(batch_shape));
+  RETURN_IF_NOT_OK(rc);
+  TensorShape encoded_row_shape = TensorShape({labels_per_row, static_cast<dsize_t>(num_classes_)}).Squeeze();
+  RETURN_IF_NOT_OK(encoded->Reshape(encoded_row_shape.PrependDim(batch_size)));
+  output->push_back(encoded);
+  return Status::OK();
+}
+
 Status OneHotOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
   outputs.clear();
@@ -34,6 +34,11 @@ class OneHotOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  // Encodes the labels of the whole batch in one go.
+  Status BatchCompute(const TensorRow &input, TensorRow *output) override;
+
+  bool SupportsBatchCompute() const override { return true; }
+
   Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
 
   std::string Name() const override { return kOneHotOp; }
@@ -43,6 +43,8 @@ class TypeCastOp : public TensorOp {
 
   std::string Name() const override { return kTypeCastOp; }
 
+  DataType GetDataType() const { return type_; }
+
  private:
   DataType type_;
 };
@@ -251,6 +251,15 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
                  std::vector<float> std, bool is_hwc);
 
+/// \brief Returns Normalized image in CHW format, the same as Normalize on an HWC image followed by HwcToChw
+///     but computed in a single pass over the image, with SIMD for uint8 RGB images
+/// \param input: Tensor of shape <H,W,C> in RGB order and any OpenCv compatible type, see CVTensor.
+/// \param mean: vector of float values which are mean of each channel in RGB order
+/// \param std:  vector of float values which are std of each channel in RGB order
+/// \param output: Normalized image Tensor of shape <C,H,W> and type DE_FLOAT32
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, std::vector<float> mean,
+                         std::vector<float> std);
+
 /// \brief Returns Normalized and padded image
 /// \param input: Tensor of shape <H,W,C> in RGB order and any OpenCv compatible type, see CVTensor.
 /// \param mean: vector of float values which are mean of each channel
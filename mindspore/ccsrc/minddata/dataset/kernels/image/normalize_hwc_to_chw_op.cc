@@ -0,0 +1,70 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+NormalizeHwcToChwOp::NormalizeHwcToChwOp(const std::vector<float> &mean, const std::vector<float> &std)
+    : mean_(mean), std_(std) {}
+
+Status NormalizeHwcToChwOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  dsize_t rank = input->Rank();
+  CHECK_FAIL_RETURN_UNEXPECTED(rank == kMinImageRank || rank == kDefaultImageRank,
+                               "NormalizeHwcToChw: input tensor is not in shape of <H,W> or <H,W,C>, but got rank: " +
+                                 std::to_string(rank));
+  return NormalizeHwcToChw(input, output, mean_, std_);
+}
+
+Status NormalizeHwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  CHECK_FAIL_RETURN_UNEXPECTED(!inputs.empty(), "NormalizeHwcToChwOp::OutputShape inputs size should > 0");
+  if (inputs[0].Rank() == kMinImageRank) {
+    (void)outputs.emplace_back(inputs[0]);
+  } else if (inputs[0].Rank() == kDefaultImageRank) {
+    (void)outputs.emplace_back(TensorShape{inputs[0][2], inputs[0][0], inputs[0][1]});
+  }
+  if (!outputs.empty()) {
+    return Status::OK();
+  }
+  return Status(StatusCode::kMDUnexpectedError,
+                "NormalizeHwcToChw: invalid input shape, expected 2D or 3D input, but got input dimension is:" +
+                  std::to_string(inputs[0].Rank()));
+}
+
+Status NormalizeHwcToChwOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = DataType(DataType::DE_FLOAT32);
+  return Status::OK();
+}
+
+void NormalizeHwcToChwOp::Print(std::ostream &out) const {
+  out << Name() << ", mean: {";
+  for (const auto &m : mean_) {
+    out << m << ", ";
+  }
+  out << "}" << std::endl << "std: {";
+  for (const auto &s : std_) {
+    out << s << ", ";
+  }
+  out << "}" << std::endl;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -16,6 +16,7 @@
 #include "minddata/dataset/kernels/image/normalize_op.h"
 
 #include <random>
+#include <string>
 #include <vector>
 
 #include "minddata/dataset/kernels/data/data_utils.h"
@@ -71,6 +72,61 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
   }
 }
 
+#ifndef ENABLE_ANDROID
+Status NormalizeOp::BatchCompute(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  CHECK_FAIL_RETURN_UNEXPECTED(input.size() == 1, "Normalize: Normalize can only accept one tensor as input.");
+  std::shared_ptr<Tensor> batch = input[0];
+  TensorShape batch_shape = batch->shape();
+  dsize_t rank = batch_shape.Rank();
+  if (rank <= kMinImageRank || batch_shape.NumOfElements() == 0) {
+    // the rows are not images, or there is nothing to normalize, let Compute() deal with each row
+    return TensorOp::BatchCompute(input, output);
+  }
+
+  // The kernel cycles through the channels, so the images of the batch are normalized as one tall image:
+  // [N, H, W] as [N * H, W], [..., H, W, C] as [N * H, W, C] and [..., C, H, W] as [N * C, H, W] with mean and std
+  // repeated for every image.
+  std::vector<float> mean = mean_;
+  std::vector<float> std = std_;
+  TensorShape image_shape({batch_shape[0] * batch_shape[1], batch_shape[2]});
+  if (rank > kDefaultImageRank) {
+    dsize_t num_images = batch_shape.NumOfElements() / (batch_shape[-3] * batch_shape[-2] * batch_shape[-1]);
+    if (is_hwc_) {
+      image_shape = TensorShape({num_images * batch_shape[-3], batch_shape[-2], batch_shape[-1]});
+    } else {
+      dsize_t num_channels = batch_shape[-3];
+      if (mean.size() == 1 && std.size() == 1) {
+        mean.resize(num_channels, mean[0]);
+        std.resize(num_channels, std[0]);
+      }
+      CHECK_FAIL_RETURN_UNEXPECTED(mean.size() == static_cast<size_t>(num_channels) && std.size() == mean.size(),
+                                   "Normalize: number of channels does not match the size of mean and std vectors, "
+                                   "got channels: " +
+                                     std::to_string(num_channels) + ", size of mean: " + std::to_string(mean.size()));
+      std::vector<float> image_mean = mean;
+      std::vector<float> image_std = std;
+      mean.reserve(num_images * num_channels);
+      std.reserve(num_images * num_channels);
+      for (dsize_t i = 1; i < num_images; i++) {
+        mean.insert(mean.end(), image_mean.begin(), image_mean.end());
+        std.insert(std.end(), image_std.begin(), image_std.end());
+      }
+      image_shape = TensorShape({num_images * num_channels, batch_shape[-2], batch_shape[-1]});
+    }
+  }
+
+  RETURN_IF_NOT_OK(batch->Reshape(image_shape));
+  std::shared_ptr<Tensor> normalized;
+  Status rc = Normalize(batch, &normalized, mean, std, is_hwc_);
+  RETURN_IF_NOT_OK(batch->Reshape(batch_shape));
+  RETURN_IF_NOT_OK(rc);
+  RETURN_IF_NOT_OK(normalized->Reshape(batch_shape));
+  output->push_back(normalized);
+  return Status::OK();
+}
+#endif
+
 void NormalizeOp::Print(std::ostream &out) const {
   out << "NormalizeOp, mean: ";
   for (const auto &m : mean_) {
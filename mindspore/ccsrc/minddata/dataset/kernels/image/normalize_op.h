@@ -36,8 +36,21 @@ class NormalizeOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+#ifndef ENABLE_ANDROID
+  // Normalizes the images of the whole batch in a single pass, without splitting the batch into images.
+  Status BatchCompute(const TensorRow &input, TensorRow *output) override;
+
+  bool SupportsBatchCompute() const override { return true; }
+#endif
+
   std::string Name() const override { return kNormalizeOp; }
 
+  const std::vector<float> &Mean() const { return mean_; }
+
+  const std::vector<float> &Std() const { return std_; }
+
+  bool IsHwc() const { return is_hwc_; }
+
  private:
   std::vector<float> mean_;
   std::vector<float> std_;
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
+
+#include "minddata/dataset/kernels/image/image_utils.h"
+
+namespace mindspore {
+namespace dataset {
+Status RandomCropDecodeResizeNormalizeOp::Compute(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  TensorRow resized;
+  RETURN_IF_NOT_OK(RandomCropDecodeResizeOp::Compute(input, &resized));
+  output->resize(resized.size());
+  for (size_t i = 0; i < resized.size(); i++) {
+    RETURN_IF_NOT_OK(NormalizeHwcToChw(resized[i], &(*output)[i], mean_, std_));
+  }
+  return Status::OK();
+}
+
+Status RandomCropDecodeResizeNormalizeOp::OutputType(const std::vector<DataType> &inputs,
+                                                     std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  for (auto &type : outputs) {
+    type = DataType(DataType::DE_FLOAT32);
+  }
+  return Status::OK();
+}
+
+void RandomCropDecodeResizeNormalizeOp::Print(std::ostream &out) const {
+  out << Name() << ": " << target_height_ << " " << target_width_ << ", mean: ";
+  for (const auto &m : mean_) {
+    out << m << ", ";
+  }
+  out << "std: ";
+  for (const auto &s : std_) {
+    out << s << ", ";
+  }
+  out << std::endl;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -256,6 +256,8 @@ class TypeCastOperation : public TensorOperation {
 
   static Status from_json(nlohmann::json op_params, std::shared_ptr<TensorOperation> *operation);
 
+  DataType GetDataType() const { return data_type_; }
+
  private:
   DataType data_type_;
 };
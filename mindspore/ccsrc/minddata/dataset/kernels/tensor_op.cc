@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/kernels/tensor_op.h"
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace mindspore {
@@ -47,6 +48,91 @@ Status TensorOp::Compute(const TensorRow &input, TensorRow *output) {
                 "Is this TensorOp oneToOne? If no, please implement this Compute() in the derived class.");
 }
 
+namespace {
+// Splits a batched Tensor into the Tensors of its rows.
+Status UnstackTensor(const std::shared_ptr<Tensor> &input, std::vector<std::shared_ptr<Tensor>> *output) {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  std::vector<dsize_t> batch_shape = input->shape().AsVector();
+  TensorShape row_shape(std::vector<dsize_t>(batch_shape.begin() + 1, batch_shape.end()));
+  for (dsize_t i = 0; i < input->shape()[0]; i++) {
+    std::shared_ptr<Tensor> row;
+    RETURN_IF_NOT_OK(input->Slice(&row, {SliceOption(Slice(i, i + 1))}));
+    RETURN_IF_NOT_OK(row->Reshape(row_shape));
+    output->push_back(std::move(row));
+  }
+  return Status::OK();
+}
+
+// Stacks the Tensors of the rows into a batched Tensor, the same way as BatchOp does.
+Status StackTensors(const std::vector<std::shared_ptr<Tensor>> &input, std::shared_ptr<Tensor> *output) {
+  CHECK_FAIL_RETURN_UNEXPECTED(!input.empty(), "BatchCompute: the batch is empty.");
+  const TensorShape &row_shape = input[0]->shape();
+  const DataType &row_type = input[0]->type();
+  for (const auto &row : input) {
+    CHECK_FAIL_RETURN_UNEXPECTED(row->shape() == row_shape && row->type() == row_type,
+                                 "BatchCompute: the rows of the batch produced tensors of different shapes or types, "
+                                 "expected: " + row_shape.ToString() + " " + row_type.ToString() +
+                                   ", got: " + row->shape().ToString() + " " + row->type().ToString());
+  }
+  TensorShape batch_shape = row_shape.PrependDim(static_cast<dsize_t>(input.size()));
+  if (row_type.IsNumeric()) {
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(batch_shape, row_type, output));
+    if (batch_shape.NumOfElements() != 0) {
+      for (size_t i = 0; i < input.size(); i++) {
+        RETURN_IF_NOT_OK((*output)->InsertTensor({static_cast<dsize_t>(i)}, input[i]));
+      }
+    }
+  } else {
+    std::vector<std::string> strings;
+    for (const auto &row : input) {
+      for (auto itr = row->begin<std::string_view>(); itr != row->end<std::string_view>(); ++itr) {
+        strings.emplace_back(*itr);
+      }
+    }
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(strings, batch_shape, row_type, output));
+  }
+  return Status::OK();
+}
+}  // namespace
+
+// Name: BatchCompute()
+// Description: This BatchCompute() falls back to Compute() on every row of the batch.
+//              The derived class with a batched kernel should override this function.
+Status TensorOp::BatchCompute(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  std::vector<std::vector<std::shared_ptr<Tensor>>> in_columns(input.size());
+  for (size_t col = 0; col < input.size(); col++) {
+    CHECK_FAIL_RETURN_UNEXPECTED(input[col]->Rank() > 0, "BatchCompute: the input tensor is not batched.");
+    CHECK_FAIL_RETURN_UNEXPECTED(input[col]->shape()[0] == input[0]->shape()[0],
+                                 "BatchCompute: the input tensors have different batch sizes.");
+    RETURN_IF_NOT_OK(UnstackTensor(input[col], &in_columns[col]));
+  }
+  dsize_t batch_size = input[0]->shape()[0];
+  std::vector<std::vector<std::shared_ptr<Tensor>>> out_columns;
+  for (dsize_t i = 0; i < batch_size; i++) {
+    TensorRow in_row;
+    TensorRow out_row;
+    for (auto &column : in_columns) {
+      in_row.push_back(std::move(column[i]));
+    }
+    RETURN_IF_NOT_OK(Compute(in_row, &out_row));
+    if (out_columns.empty()) {
+      out_columns.resize(out_row.size());
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(out_row.size() == out_columns.size(),
+                                 "BatchCompute: the rows of the batch produced different numbers of tensors.");
+    for (size_t col = 0; col < out_row.size(); col++) {
+      out_columns[col].push_back(std::move(out_row[col]));
+    }
+  }
+  for (const auto &column : out_columns) {
+    std::shared_ptr<Tensor> out;
+    RETURN_IF_NOT_OK(StackTensors(column, &out));
+    output->push_back(std::move(out));
+  }
+  return Status::OK();
+}
+
 Status TensorOp::Compute(const std::shared_ptr<DeviceTensor> &input, std::shared_ptr<DeviceTensor> *output) {
   IO_CHECK(input, output);
   return Status(StatusCode::kMDUnexpectedError,
@@ -82,6 +82,7 @@ constexpr char kHorizontalFlipOp[] = "HorizontalFlipOp";
 constexpr char kHwcToChwOp[] = "HWC2CHWOp";
 constexpr char kInvertOp[] = "InvertOp";
 constexpr char kMixUpBatchOp[] = "MixUpBatchOp";
+constexpr char kNormalizeHwcToChwOp[] = "NormalizeHwcToChwOp";
 constexpr char kNormalizeOp[] = "NormalizeOp";
 constexpr char kNormalizePadOp[] = "NormalizePadOp";
 constexpr char kPadOp[] = "PadOp";
@@ -95,6 +96,7 @@ constexpr char kRandomColorAdjustOp[] = "RandomColorAdjustOp";
 constexpr char kRandomColorOp[] = "RandomColorOp";
 constexpr char kRandomCropAndResizeOp[] = "RandomCropAndResizeOp";
 constexpr char kRandomCropAndResizeWithBBoxOp[] = "RandomCropAndResizeWithBBoxOp";
+constexpr char kRandomCropDecodeResizeNormalizeOp[] = "RandomCropDecodeResizeNormalizeOp";
 constexpr char kRandomCropDecodeResizeOp[] = "RandomCropDecodeResizeOp";
 constexpr char kRandomCropOp[] = "RandomCropOp";
 constexpr char kRandomCropWithBBoxOp[] = "RandomCropWithBBoxOp";
@@ -189,6 +191,7 @@ constexpr char kMagphaseOp[] = "MagphaseOp";
 constexpr char kMaskAlongAxisIIDOp[] = "MaskAlongAxisIIDOp";
 constexpr char kMaskAlongAxisOp[] = "MaskAlongAxisOp";
 constexpr char kMelScaleOp[] = "MelScaleOp";
+constexpr char kMelSpectrogramOp[] = "MelSpectrogramOp";
 constexpr char kMuLawDecodingOp[] = "MuLawDecodingOp";
 constexpr char kMuLawEncodingOp[] = "MuLawEncodingOp";
 constexpr char kOverdriveOp[] = "OverdriveOp";
@@ -256,6 +259,21 @@ class TensorOp {
   // @return Status
   virtual Status Compute(const TensorRow &input, TensorRow *output);
 
+  // Perform the operation on a whole batch at once. Every input Tensor holds the batch along its first dimension,
+  // and every output Tensor must hold the results of the rows in the same order.
+  // The default implementation splits the batch into rows, calls Compute() on each row and stacks the results,
+  // so the rows must produce Tensors of the same shape. Ops with a batched kernel override it, together with
+  // SupportsBatchCompute().
+  // @param input is a vector of shared_ptr to the batched Tensors (pass by const reference).
+  // @param output is the address to an empty vector of shared_ptr to Tensor.
+  // @return Status
+  virtual Status BatchCompute(const TensorRow &input, TensorRow *output);
+
+  // Returns true if BatchCompute() processes the batch in one go instead of falling back to per-row Compute().
+  // Such an op must give the same result as the per-row execution of the batch.
+  // @return true/false
+  virtual bool SupportsBatchCompute() const { return false; }
+
   // Perform an operation on one DeviceTensor and produce one DeviceTensor. This is for 1-to-1 column MapOp
   // @param input shares the ownership of the Tensor (increase the ref count).
   // @param output the address to a shared_ptr where the result will be placed.
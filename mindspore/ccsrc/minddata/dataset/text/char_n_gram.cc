@@ -31,15 +31,19 @@ Status CharNGram::BuildFromFile(std::shared_ptr<CharNGram> *char_n_gram, const s
   return Status::OK();
 }
 
-std::vector<float> CharNGram::Lookup(const std::string &token, const std::vector<float> &unk_init,
-                                     bool lower_case_backup) {
+Status CharNGram::BuildFromBinary(std::shared_ptr<CharNGram> *char_n_gram, const std::string &path) {
+  RETURN_UNEXPECTED_IF_NULL(char_n_gram);
+  auto binary_vectors = std::make_shared<CharNGram>();
+  RETURN_IF_NOT_OK(binary_vectors->LoadBinary(path));
+  *char_n_gram = std::move(binary_vectors);
+  return Status::OK();
+}
+
+void CharNGram::LookupInto(const std::string &token, const std::vector<float> &unk_init, bool lower_case_backup,
+                           float *out) const {
   std::vector<float> init_vec(dim_, 0);
-  if (!unk_init.empty()) {
-    if (unk_init.size() != dim_) {
-      MS_LOG(WARNING) << "CharNGram: size of unk_init is not the same as vectors, will initialize with zero vectors.";
-    } else {
-      init_vec = unk_init;
-    }
+  if (unk_init.size() == dim_) {
+    init_vec = unk_init;
   }
   std::string lower_token = token;
   if (lower_case_backup) {
@@ -58,40 +62,30 @@ std::vector<float> CharNGram::Lookup(const std::string &token, const std::vector
   int len = chars.size();
   int num_vectors = 0;
   std::vector<float> vector_value_sum(dim_, 0);
-  std::vector<float> vector_value_temp;
   // The length of meaningful characters in the pre-training file is 2, 3, 4.
   const int slice_len[3] = {2, 3, 4};
   const int slice_len_size = sizeof(slice_len) / sizeof(slice_len[0]);
   for (int i = 0; i < slice_len_size; i++) {
     int end = len - slice_len[i] + 1;
     for (int pos = 0; pos < end; pos++) {
-      std::vector<std::string> gram_vec;
-      std::vector<std::string>::const_iterator first = chars.begin() + pos;
-      std::vector<std::string>::const_iterator second = first + slice_len[i];
-      gram_vec.assign(first, second);
-      std::string c = "";
-      std::string gram = std::accumulate(gram_vec.begin(), gram_vec.end(), c);
-      std::string gram_key = std::to_string(slice_len[i]) + "gram-" + gram;
-      auto str_index = map_.find(gram_key);
-      if (str_index == map_.end()) {
-        vector_value_temp = init_vec;
-      } else {
-        vector_value_temp = str_index->second;
+      std::string gram_key = std::to_string(slice_len[i]) + "gram-";
+      for (int j = pos; j < pos + slice_len[i]; j++) {
+        gram_key += chars[j];
       }
-      if (vector_value_temp != init_vec) {
-        std::transform(vector_value_temp.begin(), vector_value_temp.end(), vector_value_sum.begin(),
-                       vector_value_sum.begin(), std::plus<float>());
+      // An n-gram whose vector is init_vec counts as not found
+      const float *vector_value = Find(gram_key);
+      if (vector_value != nullptr && !std::equal(init_vec.begin(), init_vec.end(), vector_value)) {
+        std::transform(vector_value, vector_value + dim_, vector_value_sum.begin(), vector_value_sum.begin(),
+                       std::plus<float>());
         num_vectors++;
       }
     }
   }
-  std::vector<float> vector_value(dim_, 0);
   if (num_vectors > 0) {
-    std::transform(vector_value_sum.begin(), vector_value_sum.end(), vector_value.begin(),
+    std::transform(vector_value_sum.begin(), vector_value_sum.end(), out,
                    [&num_vectors](float value) -> float { return value / num_vectors; });
-    return vector_value;
   } else {
-    return init_vec;
+    std::copy(init_vec.begin(), init_vec.end(), out);
   }
 }
 }  // namespace dataset
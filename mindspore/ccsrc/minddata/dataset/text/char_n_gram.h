@@ -50,14 +50,18 @@ class CharNGram : public Vectors {
   static Status BuildFromFile(std::shared_ptr<CharNGram> *char_n_gram, const std::string &path,
                               int32_t max_vectors = 0);
 
-  /// \brief Look up embedding vectors of token.
+  /// \brief Build CharNGram from a binary vector file written by Vectors::ConvertToBinary, which is memory mapped.
+  /// \param[out] char_n_gram CharNGram object which contains the pre-train vectors.
+  /// \param[in] path Path to the binary vector file.
+  static Status BuildFromBinary(std::shared_ptr<CharNGram> *char_n_gram, const std::string &path);
+
+  /// \brief Look up the embedding vector of token into a buffer, as the mean of the vectors of its character n-grams.
   /// \param[in] token A token to be looked up.
-  /// \param[in] unk_init In case of the token is out-of-vectors (OOV), the result will be initialized with `unk_init`.
-  ///     (default={}, means to initialize with zero vectors).
-  /// \param[in] lower_case_backup Whether to look up the token in the lower case (Default = false).
-  /// \return The vector of the input token.
-  std::vector<float> Lookup(const std::string &token, const std::vector<float> &unk_init = {},
-                            bool lower_case_backup = false);
+  /// \param[in] unk_init The vector of an out-of-vectors (OOV) token, zero vectors if it is not of dimension Dim().
+  /// \param[in] lower_case_backup Whether to look up the token in the lower case.
+  /// \param[out] out The buffer of Dim() floats the vector is copied to.
+  void LookupInto(const std::string &token, const std::vector<float> &unk_init, bool lower_case_backup,
+                  float *out) const override;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,334 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/compiled_vocab.h"
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include "securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr size_t kBucketSize = 4;         // The average number of words per bucket of the perfect hash
+constexpr uint32_t kMaxSeed = 1u << 20;   // The seeds tried for a bucket before giving up
+constexpr size_t kNumBytes = 256;         // The children a node of the trie can have
+constexpr uint64_t kGoldenRatio = 0x9E3779B97F4A7C15ULL;
+constexpr uint32_t kMaxFailures = 16;     // The bases tried at a free slot before it is no longer tried
+
+uint64_t Mix(uint64_t x) {
+  constexpr int kShift = 33;
+  x ^= x >> kShift;
+  x *= 0xFF51AFD7ED558CCDULL;
+  x ^= x >> kShift;
+  x *= 0xC4CEB9FE1A85EC53ULL;
+  x ^= x >> kShift;
+  return x;
+}
+
+// The bytes 10xxxxxx continue a UTF-8 character, a word can not end right before them
+bool IsContinuationByte(char c) {
+  constexpr uint8_t kMask = 0xC0;
+  constexpr uint8_t kContinuation = 0x80;
+  return (static_cast<uint8_t>(c) & kMask) == kContinuation;
+}
+
+// Places the nodes of a double-array trie. The free slots are kept in a list, so that the search for the base of a
+// node does not go through the slots already taken. A free slot which failed as the slot of the first child of many
+// nodes is dropped from the list, as it sits among taken slots.
+class DoubleArrayBuilder {
+ public:
+  DoubleArrayBuilder(std::vector<int32_t> *base, std::vector<int32_t> *check, std::vector<int32_t> *terminal)
+      : base_(base), check_(check), terminal_(terminal) {
+    Grow(kNumBytes);
+  }
+
+  // Take a slot for a node
+  void Take(int32_t slot, int32_t parent) {
+    Unlink(slot);
+    (*check_)[slot] = parent;
+  }
+
+  // Find a base for the children of a node, the slots base + byte of all the child bytes are free
+  int32_t FindBase(const std::vector<uint8_t> &bytes) {
+    int32_t slot = head_;
+    while (true) {
+      if (slot == kEnd) {
+        slot = static_cast<int32_t>(check_->size());
+        Grow(check_->size() * 2);
+      }
+      int32_t base = slot - bytes.front();
+      int32_t next = next_[slot];
+      if (base > 0) {
+        if (static_cast<size_t>(base) + kNumBytes > check_->size()) {
+          Grow(static_cast<size_t>(base) + kNumBytes);
+          next = next_[slot];
+        }
+        if (std::all_of(bytes.begin(), bytes.end(), [this, base](uint8_t b) { return (*check_)[base + b] == -1; })) {
+          return base;
+        }
+        if (++failures_[slot] >= kMaxFailures) {
+          Unlink(slot);
+        }
+      }
+      slot = next;
+    }
+  }
+
+ private:
+  static constexpr int32_t kEnd = -1;       // The end of the list
+  static constexpr int32_t kUnlinked = -2;  // A slot out of the list
+
+  void Grow(size_t size) {
+    auto old_size = static_cast<int32_t>(check_->size());
+    base_->resize(size, 0);
+    check_->resize(size, -1);
+    terminal_->resize(size, -1);
+    next_.resize(size, kEnd);
+    prev_.resize(size, kEnd);
+    failures_.resize(size, 0);
+    // The slot 0 is the root
+    for (int32_t slot = std::max(1, old_size); slot < static_cast<int32_t>(size); ++slot) {
+      prev_[slot] = tail_;
+      if (tail_ == kEnd) {
+        head_ = slot;
+      } else {
+        next_[tail_] = slot;
+      }
+      tail_ = slot;
+    }
+  }
+
+  void Unlink(int32_t slot) {
+    if (prev_[slot] == kUnlinked) {
+      return;
+    }
+    if (prev_[slot] == kEnd) {
+      head_ = next_[slot];
+    } else {
+      next_[prev_[slot]] = next_[slot];
+    }
+    if (next_[slot] == kEnd) {
+      tail_ = prev_[slot];
+    } else {
+      prev_[next_[slot]] = prev_[slot];
+    }
+    prev_[slot] = kUnlinked;
+  }
+
+  std::vector<int32_t> *base_;
+  std::vector<int32_t> *check_;
+  std::vector<int32_t> *terminal_;
+  std::vector<int32_t> next_;
+  std::vector<int32_t> prev_;
+  std::vector<uint32_t> failures_;
+  int32_t head_ = kEnd;
+  int32_t tail_ = kEnd;
+};
+}  // namespace
+
+Status CompiledVocab::Build(const Vocab &vocab, std::shared_ptr<CompiledVocab> *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  std::vector<std::pair<std::string_view, WordIdType>> words;
+  words.reserve(vocab.GetVocab().size());
+  size_t total_length = 0;
+  for (const auto &[word, id] : vocab.GetVocab()) {
+    (void)words.emplace_back(word, id);
+    total_length += word.size();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(total_length <= std::numeric_limits<uint32_t>::max(),
+                               "CompiledVocab: the words of the vocab do not fit in 4GB.");
+  std::sort(words.begin(), words.end());
+
+  auto compiled = std::shared_ptr<CompiledVocab>(new CompiledVocab());
+  compiled->arena_.reserve(total_length);
+  compiled->entries_.reserve(words.size());
+  for (const auto &[word, id] : words) {
+    compiled->entries_.push_back(
+      {static_cast<uint32_t>(compiled->arena_.size()), static_cast<uint32_t>(word.size()), id});
+    (void)compiled->arena_.append(word);
+  }
+  RETURN_IF_NOT_OK(compiled->BuildHash());
+  compiled->BuildTrie();
+  *out = std::move(compiled);
+  return Status::OK();
+}
+
+uint64_t CompiledVocab::Hash(std::string_view word) {
+  uint64_t hash = kGoldenRatio ^ word.size();
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= word.size(); i += sizeof(uint64_t)) {
+    uint64_t chunk = 0;
+    (void)memcpy_s(&chunk, sizeof(chunk), word.data() + i, sizeof(chunk));
+    hash = Mix(hash ^ chunk);
+  }
+  uint64_t tail = 0;
+  constexpr int kBitsPerByte = 8;
+  for (int shift = 0; i < word.size(); ++i, shift += kBitsPerByte) {
+    tail |= static_cast<uint64_t>(static_cast<uint8_t>(word[i])) << shift;
+  }
+  return Mix(hash ^ tail);
+}
+
+size_t CompiledVocab::SlotOf(uint64_t hash, uint32_t seed) const {
+  return static_cast<size_t>(Mix(hash + seed * kGoldenRatio) % slots_.size());
+}
+
+Status CompiledVocab::BuildHash() {
+  // Hash and displace: the words are spread over small buckets, then from the largest bucket on, each bucket gets
+  // the first seed which sends all its words to free slots
+  const size_t num_words = entries_.size();
+  const size_t num_buckets = std::max<size_t>(1, num_words / kBucketSize);
+  const size_t num_slots = num_words + num_words / kBucketSize + 1;
+  std::vector<uint64_t> hashes(num_words);
+  std::vector<std::vector<int32_t>> buckets(num_buckets);
+  for (size_t i = 0; i < num_words; ++i) {
+    hashes[i] = Hash(WordOf(entries_[i]));
+    buckets[hashes[i] % num_buckets].push_back(static_cast<int32_t>(i));
+  }
+  std::vector<size_t> order(num_buckets);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&buckets](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+  seeds_.assign(num_buckets, 0);
+  slots_.assign(num_slots, -1);
+  std::vector<size_t> taken;
+  for (size_t bucket : order) {
+    const auto &words = buckets[bucket];
+    if (words.empty()) {
+      break;
+    }
+    bool placed = false;
+    for (uint32_t seed = 1; seed <= kMaxSeed && !placed; ++seed) {
+      taken.clear();
+      placed = true;
+      for (int32_t word : words) {
+        size_t slot = SlotOf(hashes[word], seed);
+        if (slots_[slot] != -1 || std::find(taken.begin(), taken.end(), slot) != taken.end()) {
+          placed = false;
+          break;
+        }
+        taken.push_back(slot);
+      }
+      if (placed) {
+        for (size_t i = 0; i < words.size(); ++i) {
+          slots_[taken[i]] = words[i];
+        }
+        seeds_[bucket] = seed;
+      }
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(placed, "CompiledVocab: failed to build the perfect hash of the vocab.");
+  }
+  return Status::OK();
+}
+
+WordIdType CompiledVocab::Lookup(std::string_view word) const {
+  if (entries_.empty()) {
+    return Vocab::kNoTokenExists;
+  }
+  uint64_t hash = Hash(word);
+  int32_t entry = slots_[SlotOf(hash, seeds_[hash % seeds_.size()])];
+  return entry >= 0 && WordOf(entries_[entry]) == word ? entries_[entry].id : Vocab::kNoTokenExists;
+}
+
+void CompiledVocab::BuildTrie() {
+  // The words are sorted, so the words below a node are a range of entries, and the words below each of its children
+  // are consecutive ranges of it. The nodes are placed level by level.
+  struct Range {
+    int32_t node;
+    size_t begin;
+    size_t end;
+    size_t depth;
+  };
+  base_.clear();
+  check_.clear();
+  terminal_.clear();
+  DoubleArrayBuilder builder(&base_, &check_, &terminal_);
+  check_[Root()] = Root();
+  std::deque<Range> queue{{Root(), 0, entries_.size(), 0}};
+  std::vector<uint8_t> bytes;
+  std::vector<size_t> starts;
+  while (!queue.empty()) {
+    Range range = queue.front();
+    queue.pop_front();
+    size_t begin = range.begin;
+    if (begin < range.end && entries_[begin].length == range.depth) {
+      terminal_[range.node] = static_cast<int32_t>(begin++);
+    }
+    if (begin == range.end) {
+      continue;
+    }
+    bytes.clear();
+    starts.clear();
+    for (size_t i = begin; i < range.end; ++i) {
+      auto byte = static_cast<uint8_t>(arena_[entries_[i].offset + range.depth]);
+      if (bytes.empty() || bytes.back() != byte) {
+        bytes.push_back(byte);
+        starts.push_back(i);
+      }
+    }
+    starts.push_back(range.end);
+    int32_t base = builder.FindBase(bytes);
+    base_[range.node] = base;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      int32_t child = base + bytes[i];
+      builder.Take(child, range.node);
+      queue.push_back({child, starts[i], starts[i + 1], range.depth + 1});
+    }
+  }
+  // Drop the free slots past the last node
+  size_t size = check_.size();
+  while (size > 1 && check_[size - 1] == -1) {
+    --size;
+  }
+  base_.resize(size);
+  check_.resize(size);
+  terminal_.resize(size);
+  base_.shrink_to_fit();
+  check_.shrink_to_fit();
+  terminal_.shrink_to_fit();
+}
+
+int32_t CompiledVocab::Walk(int32_t node, std::string_view text) const {
+  for (size_t i = 0; i < text.size() && node >= 0; ++i) {
+    node = Next(node, static_cast<uint8_t>(text[i]));
+  }
+  return node;
+}
+
+size_t CompiledVocab::LongestPrefix(int32_t node, std::string_view text, std::string_view *word,
+                                    WordIdType *id) const {
+  size_t matched = 0;
+  int32_t entry = -1;
+  for (size_t i = 0; i < text.size() && node >= 0; ++i) {
+    node = Next(node, static_cast<uint8_t>(text[i]));
+    if (node >= 0 && terminal_[node] >= 0 && (i + 1 == text.size() || !IsContinuationByte(text[i + 1]))) {
+      matched = i + 1;
+      entry = terminal_[node];
+    }
+  }
+  if (entry >= 0) {
+    *word = WordOf(entries_[entry]);
+    *id = entries_[entry].id;
+  }
+  return matched;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_COMPILED_VOCAB_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_COMPILED_VOCAB_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "minddata/dataset/include/dataset/text.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A read only copy of a Vocab laid out for the tokenizers. The words are stored back to back in one arena.
+///     A whole word is looked up with a perfect hash, which probes a single slot and compares a string_view, and the
+///     longest word starting a text is found with a double-array trie in one pass over the text. Neither lookup
+///     allocates memory. Words appended to the Vocab afterwards are not seen.
+class CompiledVocab {
+ public:
+  /// \brief Compile a vocab.
+  /// \param[in] vocab The vocab
+  /// \param[out] out The compiled vocab
+  /// \return Status error if the perfect hash could not be built
+  static Status Build(const Vocab &vocab, std::shared_ptr<CompiledVocab> *out);
+
+  ~CompiledVocab() = default;
+
+  /// \brief Lookup the id of a word.
+  /// \param[in] word The word
+  /// \return The id of the word, Vocab::kNoTokenExists if it is not in the vocab
+  WordIdType Lookup(std::string_view word) const;
+
+  /// \return The root node of the trie, which stands for the empty prefix
+  static constexpr int32_t Root() { return 0; }
+
+  /// \brief Walk the trie along the bytes of a text, e.g. along the suffix indicator of WordPiece.
+  /// \param[in] node The node to start from
+  /// \param[in] text The text
+  /// \return The node reached, -1 if no word of the vocab starts with the prefix of the node followed by the text
+  int32_t Walk(int32_t node, std::string_view text) const;
+
+  /// \brief Find the longest word made of the prefix of a node followed by the start of a text. Only the words which
+  ///     end on a UTF-8 character boundary of the text are considered.
+  /// \param[in] node The node to start from
+  /// \param[in] text The text
+  /// \param[out] word The word found, pointing to the arena
+  /// \param[out] id The id of the word
+  /// \return The number of bytes of the text matched, 0 if no word was found
+  size_t LongestPrefix(int32_t node, std::string_view text, std::string_view *word, WordIdType *id) const;
+
+  /// \return The number of words
+  size_t Size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    uint32_t offset;  // Where the word starts in the arena
+    uint32_t length;
+    WordIdType id;
+  };
+
+  CompiledVocab() = default;
+
+  std::string_view WordOf(const Entry &entry) const {
+    return std::string_view(arena_).substr(entry.offset, entry.length);
+  }
+
+  // The hash of a word selects its bucket, and mixed with the seed of the bucket selects its slot
+  static uint64_t Hash(std::string_view word);
+
+  size_t SlotOf(uint64_t hash, uint32_t seed) const;
+
+  // The child of a node for a byte, -1 if there is none
+  int32_t Next(int32_t node, uint8_t byte) const {
+    auto next = static_cast<size_t>(base_[node]) + byte;
+    return base_[node] > 0 && next < check_.size() && check_[next] == node ? static_cast<int32_t>(next) : -1;
+  }
+
+  Status BuildHash();
+
+  void BuildTrie();
+
+  std::string arena_;
+  std::vector<Entry> entries_;  // Sorted by word
+
+  // Perfect hash
+  std::vector<uint32_t> seeds_;  // The seed of each bucket
+  std::vector<int32_t> slots_;   // The entry in each slot, -1 if the slot is empty
+
+  // Double-array trie, the child of node n for byte b is base_[n] + b if check_[base_[n] + b] == n
+  std::vector<int32_t> base_;
+  std::vector<int32_t> check_;     // The parent of each node, -1 if the slot is free
+  std::vector<int32_t> terminal_;  // The entry ending at each node, -1 if none
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_COMPILED_VOCAB_H_
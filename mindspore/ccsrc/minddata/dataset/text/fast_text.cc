@@ -46,5 +46,13 @@ Status FastText::BuildFromFile(std::shared_ptr<FastText> *fast_text, const std::
   *fast_text = std::make_shared<FastText>(std::move(map), vector_dim);
   return Status::OK();
 }
+
+Status FastText::BuildFromBinary(std::shared_ptr<FastText> *fast_text, const std::string &path) {
+  RETURN_UNEXPECTED_IF_NULL(fast_text);
+  auto binary_vectors = std::make_shared<FastText>();
+  RETURN_IF_NOT_OK(binary_vectors->LoadBinary(path));
+  *fast_text = std::move(binary_vectors);
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
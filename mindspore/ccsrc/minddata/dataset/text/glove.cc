@@ -52,5 +52,13 @@ Status GloVe::BuildFromFile(std::shared_ptr<GloVe> *glove, const std::string &pa
   *glove = std::make_shared<GloVe>(std::move(map), vector_dim);
   return Status::OK();
 }
+
+Status GloVe::BuildFromBinary(std::shared_ptr<GloVe> *glove, const std::string &path) {
+  RETURN_UNEXPECTED_IF_NULL(glove);
+  auto binary_vectors = std::make_shared<GloVe>();
+  RETURN_IF_NOT_OK(binary_vectors->LoadBinary(path));
+  *glove = std::move(binary_vectors);
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -49,6 +49,11 @@ class GloVe : public Vectors {
   /// \param[in] path Path to the pre-trained word vector file.
   /// \param[in] max_vectors This can be used to limit the number of pre-trained vectors loaded (default=0, no limit).
   static Status BuildFromFile(std::shared_ptr<GloVe> *glove, const std::string &path, int32_t max_vectors = 0);
+
+  /// \brief Build GloVe from a binary vector file written by Vectors::ConvertToBinary, which is memory mapped.
+  /// \param[out] glove GloVe object which contains the pre-train vectors.
+  /// \param[in] path Path to the binary vector file.
+  static Status BuildFromBinary(std::shared_ptr<GloVe> *glove, const std::string &path);
 };
 }  // namespace dataset
 }  // namespace mindspore
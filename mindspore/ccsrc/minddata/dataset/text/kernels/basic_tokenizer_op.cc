@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "minddata/dataset/text/kernels/basic_tokenizer_op.h"
+#include <array>
 #include <memory>
 #include <queue>
 #include <string>
@@ -24,8 +25,36 @@
 #include "unicode/errorcode.h"
 #include "unicode/normalizer2.h"
 
+#include "minddata/dataset/text/kernels/data_utils.h"
+
 namespace mindspore {
 namespace dataset {
+namespace {
+constexpr size_t kNumAsciiChars = 128;
+
+enum class AsciiClass : uint8_t { kWord, kSpace, kPunct };
+
+// The class of each ASCII character for TokenizeAscii. The control characters are replaced by spaces, and the
+// punctuation characters are those of the ASCII ranges of kCommonPattern.
+const std::array<AsciiClass, kNumAsciiChars> &AsciiClasses() {
+  static const std::array<AsciiClass, kNumAsciiChars> classes = [] {
+    constexpr char kDelete = 0x7F;
+    std::array<AsciiClass, kNumAsciiChars> table{};
+    for (size_t i = 0; i < kNumAsciiChars; ++i) {
+      auto c = static_cast<char>(i);
+      if (c <= ' ' || c == kDelete) {
+        table[i] = AsciiClass::kSpace;
+      } else if ((c >= '!' && c <= '/') || (c >= ':' && c <= '@') || (c >= '[' && c <= '`') || (c >= '{' && c <= '~')) {
+        table[i] = AsciiClass::kPunct;
+      } else {
+        table[i] = AsciiClass::kWord;
+      }
+    }
+    return table;
+  }();
+  return classes;
+}
+}  // namespace
 
 const bool BasicTokenizerOp::kDefLowerCase = false;
 const bool BasicTokenizerOp::kDefKeepWhitespace = false;
@@ -91,7 +120,7 @@ Status BasicTokenizerOp::CaseFoldWithoutUnusedWords(const std::string_view &text
   for (int i = 0; i < text.length(); i++) {
     if (text[i] == '[') {
       start = i;
-      ++len;
+      len = 1;
     } else if (text[i] == ']' && start >= 0) {
       ++len;
       std::string word(text.substr(start, len));
@@ -123,6 +152,7 @@ Status BasicTokenizerOp::CaseFoldWithoutUnusedWords(const std::string_view &text
     icu::StringByteSink<std::string> sink(&temp);
     nfkc_case_fold->normalizeUTF8(0, icu::StringPiece(process_text.data(), process_text.size()), sink, nullptr, error);
     *output += temp + preserve_token;
+    start = i;
   }
   return Status::OK();
 }
@@ -149,6 +179,30 @@ Status BasicTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   if (input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED("BasicTokenizer: the input should be of type string.");
   }
+  std::string_view text;
+  RETURN_IF_NOT_OK(input[0]->GetItemAt(&text, {}));
+  if (IsAscii(text)) {
+    std::string processed;
+    std::vector<uint32_t> offsets_start, offsets_limit;
+    TokenizeAscii(text, &processed, &offsets_start, &offsets_limit);
+    std::vector<std::string> tokens;
+    tokens.reserve(offsets_start.size());
+    for (size_t i = 0; i < offsets_start.size(); ++i) {
+      (void)tokens.emplace_back(processed, offsets_start[i], offsets_limit[i] - offsets_start[i]);
+    }
+    if (tokens.empty()) {
+      (void)tokens.emplace_back("");
+      offsets_start.push_back(0);
+      offsets_limit.push_back(0);
+    }
+    std::shared_ptr<Tensor> token_tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(tokens, &token_tensor));
+    output->push_back(token_tensor);
+    if (with_offsets_) {
+      RETURN_IF_NOT_OK(AppendOffsetsHelper(offsets_start, offsets_limit, output));
+    }
+    return Status::OK();
+  }
   std::shared_ptr<Tensor> cur_input;
   std::shared_ptr<Tensor> processed_tensor;
   if (lower_case_) {
@@ -172,5 +226,85 @@ Status BasicTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   RETURN_IF_NOT_OK(replace_control_chars_->Compute(cur_input, &processed_tensor));
   return regex_tokenizer_->Compute(TensorRow(0, {std::move(processed_tensor)}), output);
 }
+
+size_t BasicTokenizerOp::MatchUnusedToken(std::string_view text, size_t pos) {
+  std::string_view rest = text.substr(pos);
+  for (const auto &word : kUnusedWords) {
+    if (rest.substr(0, word.size()) == word) {
+      return word.size();
+    }
+  }
+  // [unused\d+]
+  constexpr std::string_view kNumberedPrefix = "[unused";
+  if (rest.substr(0, kNumberedPrefix.size()) != kNumberedPrefix) {
+    return 0;
+  }
+  size_t end = kNumberedPrefix.size();
+  while (end < rest.size() && rest[end] >= '0' && rest[end] <= '9') {
+    ++end;
+  }
+  return end > kNumberedPrefix.size() && end < rest.size() && rest[end] == ']' ? end + 1 : 0;
+}
+
+void BasicTokenizerOp::TokenizeAscii(std::string_view text, std::string *processed,
+                                     std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const {
+  const auto &classes = AsciiClasses();
+  // 1. Case fold except the unused tokens, which the regular expression keeps whole, and replace the control
+  // characters. ASCII needs no other normalization.
+  processed->resize(text.size());
+  for (size_t i = 0; i < text.size();) {
+    size_t len = preserve_unused_token_ && text[i] == '[' ? MatchUnusedToken(text, i) : 0;
+    if (len > 0) {
+      (void)processed->replace(i, len, text.substr(i, len));
+      i += len;
+      continue;
+    }
+    char c = text[i];
+    if (classes[static_cast<uint8_t>(c)] == AsciiClass::kSpace) {
+      c = ' ';
+    } else if (lower_case_ && c >= 'A' && c <= 'Z') {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+    (*processed)[i++] = c;
+  }
+
+  // 2. Split on the unused tokens, the runs of spaces and the punctuation characters, in the order of the alternatives
+  // of the delimiter pattern
+  std::string_view view(*processed);
+  auto add_token = [offsets_start, offsets_limit](size_t start, size_t limit) {
+    offsets_start->push_back(static_cast<uint32_t>(start));
+    offsets_limit->push_back(static_cast<uint32_t>(limit));
+  };
+  size_t token_start = 0;
+  for (size_t i = 0; i < view.size();) {
+    size_t delim_end = preserve_unused_token_ && view[i] == '[' ? i + MatchUnusedToken(view, i) : i;
+    bool keep_delim = true;
+    if (delim_end == i) {
+      AsciiClass char_class = classes[static_cast<uint8_t>(view[i])];
+      if (char_class == AsciiClass::kWord) {
+        ++i;
+        continue;
+      }
+      delim_end = i + 1;
+      if (char_class == AsciiClass::kSpace) {
+        while (delim_end < view.size() && view[delim_end] == ' ') {
+          ++delim_end;
+        }
+        keep_delim = keep_whitespace_;
+      }
+    }
+    if (i > token_start) {
+      add_token(token_start, i);
+    }
+    if (keep_delim) {
+      add_token(i, delim_end);
+    }
+    i = delim_end;
+    token_start = i;
+  }
+  if (token_start < view.size()) {
+    add_token(token_start, view.size());
+  }
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -17,7 +17,9 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_BASIC_TOKENIZER_OP_H_
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_set>
+#include <vector>
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
@@ -47,6 +49,16 @@ class BasicTokenizerOp : public TokenizerOp {
 
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
+  /// \brief Tokenize a text made of ASCII characters only. The normalization, the case folding and the regular
+  ///     expressions of Compute all come down to a table of the class of each character, so the text is tokenized
+  ///     in one pass without ICU, with the same tokens and offsets.
+  /// \param[in] text The text, see IsAscii
+  /// \param[out] processed The text after the case folding and the replacement of the control characters
+  /// \param[out] offsets_start The start offset in processed of each token
+  /// \param[out] offsets_limit The limit offset in processed of each token
+  void TokenizeAscii(std::string_view text, std::string *processed, std::vector<uint32_t> *offsets_start,
+                     std::vector<uint32_t> *offsets_limit) const;
+
  protected:
   Status CaseFoldWithoutUnusedWords(const std::string_view &text, const std::unordered_set<std::string> &unused_words,
                                     std::string *output);
@@ -55,6 +67,9 @@ class BasicTokenizerOp : public TokenizerOp {
   std::string Name() const override { return kBasicTokenizerOp; }
 
  private:
+  // The length of the unused token which starts at the given position of the text, 0 if there is none
+  static size_t MatchUnusedToken(std::string_view text, size_t pos);
+
   static const char kCommonPattern[];
   static const char kUnusedPattern[];
   static const std::unordered_set<std::string> kUnusedWords;
@@ -14,10 +14,52 @@
  * limitations under the License.
  */
 #include "minddata/dataset/text/kernels/bert_tokenizer_op.h"
+
+#include <iterator>
+#include <vector>
+
+#include "minddata/dataset/text/kernels/data_utils.h"
+
 namespace mindspore {
 namespace dataset {
+Status BertTokenizerOp::ComputeAscii(std::string_view text, TensorRow *output) {
+  std::string processed;
+  std::vector<uint32_t> word_starts, word_limits;
+  basic_tokenizer_.TokenizeAscii(text, &processed, &word_starts, &word_limits);
+  std::string_view words(processed);
+  std::vector<std::string> out_tokens;
+  std::vector<std::string> temp_tokens;
+  std::vector<uint32_t> offsets_start, offsets_limit;
+  for (size_t i = 0; i < word_starts.size(); ++i) {
+    temp_tokens.clear();
+    RETURN_IF_NOT_OK(wordpiece_tokenizer_.TokenizeWord(words.substr(word_starts[i], word_limits[i] - word_starts[i]),
+                                                       word_starts[i], &temp_tokens, &offsets_start, &offsets_limit));
+    out_tokens.insert(out_tokens.end(), std::make_move_iterator(temp_tokens.begin()),
+                      std::make_move_iterator(temp_tokens.end()));
+  }
+  if (out_tokens.empty()) {
+    (void)out_tokens.emplace_back("");
+    offsets_start.push_back(0);
+    offsets_limit.push_back(0);
+  }
+  std::shared_ptr<Tensor> token_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateFromVector(out_tokens, &token_tensor));
+  output->push_back(token_tensor);
+  if (with_offsets_) {
+    RETURN_IF_NOT_OK(AppendOffsetsHelper(offsets_start, offsets_limit, output));
+  }
+  return Status::OK();
+}
+
 Status BertTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
+  if (input.size() == 1 && input[0]->Rank() == 0 && input[0]->type() == DataType::DE_STRING) {
+    std::string_view text;
+    RETURN_IF_NOT_OK(input[0]->GetItemAt(&text, {}));
+    if (IsAscii(text)) {
+      return ComputeAscii(text, output);
+    }
+  }
   TensorRow basic_tensor;
   RETURN_IF_NOT_OK(basic_tokenizer_.Compute(input, &basic_tensor));
   RETURN_IF_NOT_OK(wordpiece_tokenizer_.Compute(basic_tensor, output));
@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_BERT_TOKENIZER_OP_H_
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
@@ -40,7 +41,8 @@ class BertTokenizerOp : public TensorOp {
                            const bool &preserve_unused_token = BasicTokenizerOp::kDefPreserveUnusedToken,
                            const bool &with_offsets = TokenizerOp::kDefWithOffsets)
       : wordpiece_tokenizer_(vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets),
-        basic_tokenizer_(lower_case, keep_whitespace, normalization_form, preserve_unused_token, with_offsets) {}
+        basic_tokenizer_(lower_case, keep_whitespace, normalization_form, preserve_unused_token, with_offsets),
+        with_offsets_(with_offsets) {}
 
   ~BertTokenizerOp() override = default;
 
@@ -49,8 +51,13 @@ class BertTokenizerOp : public TensorOp {
   std::string Name() const override { return kBertTokenizerOp; }
 
  private:
+  // Tokenize a text made of ASCII characters only in a single pass, each word of the basic tokenizer is split into
+  // subwords right away, without a tensor of the words in between
+  Status ComputeAscii(std::string_view text, TensorRow *output);
+
   WordpieceTokenizerOp wordpiece_tokenizer_;
   BasicTokenizerOp basic_tokenizer_;
+  bool with_offsets_;
 };
 }  // namespace dataset
 }  // namespace mindspore
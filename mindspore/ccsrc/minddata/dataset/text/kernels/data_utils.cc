@@ -65,5 +65,24 @@ Status AppendOffsetsHelper(const std::vector<uint32_t> &offsets_start, const std
   output->push_back(offsets_limit_tensor);
   return Status::OK();
 }
+
+bool IsAscii(std::string_view text) {
+  constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+  constexpr uint8_t kHighBit = 0x80;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= text.size(); i += sizeof(uint64_t)) {
+    uint64_t chunk = 0;
+    (void)memcpy_s(&chunk, sizeof(chunk), text.data() + i, sizeof(chunk));
+    if ((chunk & kHighBits) != 0) {
+      return false;
+    }
+  }
+  for (; i < text.size(); ++i) {
+    if ((static_cast<uint8_t>(text[i]) & kHighBit) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/include/dataset/constants.h"
@@ -46,6 +47,11 @@ Status SlidingWindowHelper(const std::shared_ptr<Tensor> &input, std::shared_ptr
 /// \return Status return code
 Status AppendOffsetsHelper(const std::vector<uint32_t> &offsets_start, const std::vector<uint32_t> &offsets_limit,
                            TensorRow *output);
+
+/// \brief Helper method that checks whether a text is made of ASCII characters only, 8 bytes at a time.
+/// \param[in] text - Input text.
+/// \return True if no byte of the text has its high bit set
+bool IsAscii(std::string_view text);
 }  // namespace dataset
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_TEXT_DATA_UTILS_H_
@@ -20,7 +20,16 @@ namespace mindspore {
 namespace dataset {
 
 LookupOp::LookupOp(std::shared_ptr<Vocab> vocab, WordIdType default_id, const DataType &data_type)
-    : vocab_(vocab), default_id_(default_id), type_(data_type) {}
+    : vocab_(vocab), default_id_(default_id), type_(data_type) {
+  if (vocab_ != nullptr) {
+    Status rc = CompiledVocab::Build(*vocab_, &compiled_vocab_);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Lookup: failed to compile the vocab, the words are looked up in the vocab map. "
+                      << rc.GetErrDescription();
+      compiled_vocab_ = nullptr;
+    }
+  }
+}
 
 Status LookupOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   IO_CHECK(input, output);
@@ -30,7 +39,8 @@ Status LookupOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   std::vector<WordIdType> word_ids;
   word_ids.reserve(input->Size());
   for (auto itr = input->begin<std::string_view>(); itr != input->end<std::string_view>(); ++itr) {
-    WordIdType word_id = vocab_->TokensToIds(std::string(*itr));
+    WordIdType word_id =
+      compiled_vocab_ != nullptr ? compiled_vocab_->Lookup(*itr) : vocab_->TokensToIds(std::string(*itr));
     word_ids.emplace_back(word_id == Vocab::kNoTokenExists ? default_id_ : word_id);
     CHECK_FAIL_RETURN_UNEXPECTED(word_ids.back() != Vocab::kNoTokenExists,
                                  "Lookup: invalid data, token: \"" + std::string(*itr) +
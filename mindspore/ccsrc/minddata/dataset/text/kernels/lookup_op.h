@@ -25,6 +25,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/include/dataset/text.h"
 #include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/text/compiled_vocab.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -58,6 +59,7 @@ class LookupOp : public TensorOp {
 
  private:
   std::shared_ptr<Vocab> vocab_;
+  std::shared_ptr<CompiledVocab> compiled_vocab_;  // null if the vocab could not be compiled
   WordIdType default_id_;
   DataType type_;  // type of tensor after lookup
 };
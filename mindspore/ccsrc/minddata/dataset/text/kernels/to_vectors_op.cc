@@ -28,21 +28,20 @@ Status ToVectorsOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
                                "ToVectors: unk_init must be the same length as vectors, but got unk_init: " +
                                  std::to_string(unk_init_.size()) + " and vectors: " + std::to_string(vectors_->Dim()));
 
-  std::vector<float> vectors_vec;
-  int len = 0;
-  for (auto itr = input->begin<std::string_view>(); itr != input->end<std::string_view>(); ++itr) {
-    std::vector<float> vectors_value = vectors_->Lookup(std::string(*itr), unk_init_, lower_case_backup_);
-    CHECK_FAIL_RETURN_UNEXPECTED(!vectors_value.empty(), "ToVectors: invalid data, token: \"" + std::string(*itr) +
-                                                           "\" doesn't exist in vectors and no unk_init is specified.");
-    vectors_vec.insert(vectors_vec.end(), vectors_value.begin(), vectors_value.end());
-    len++;
-  }
+  CHECK_FAIL_RETURN_UNEXPECTED(vectors_->Dim() > 0, "ToVectors: invalid data, vectors are empty.");
 
-  int dim = static_cast<int>(vectors_vec.size() / len);
-  if (vectors_vec.size() == dim) {
-    RETURN_IF_NOT_OK(Tensor::CreateFromVector(vectors_vec, output));
-  } else {
-    RETURN_IF_NOT_OK(Tensor::CreateFromVector(vectors_vec, TensorShape({len, dim}), output));
+  // The vectors are copied straight from the vectors, or the mapped binary file, into the output
+  dsize_t len = input->Size();
+  dsize_t dim = vectors_->Dim();
+  TensorShape shape = len == 1 ? TensorShape({dim}) : TensorShape({len, dim});
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, DataType(DataType::DE_FLOAT32), output));
+  if (len == 0) {
+    return Status::OK();
+  }
+  float *out = &(*(*output)->begin<float>());
+  for (auto itr = input->begin<std::string_view>(); itr != input->end<std::string_view>(); ++itr) {
+    vectors_->LookupInto(std::string(*itr), unk_init_, lower_case_backup_, out);
+    out += dim;
   }
   return Status::OK();
 }
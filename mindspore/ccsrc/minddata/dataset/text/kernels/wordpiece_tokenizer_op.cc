@@ -33,7 +33,19 @@ WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
       vocab_(vocab),
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
-      unknown_token_(unknown_token) {}
+      unknown_token_(unknown_token),
+      suffix_node_(-1) {
+  if (vocab_ != nullptr) {
+    Status rc = CompiledVocab::Build(*vocab_, &compiled_vocab_);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "WordpieceTokenizer: failed to compile the vocab, the words are looked up in the vocab map. "
+                      << rc.GetErrDescription();
+      compiled_vocab_ = nullptr;
+    } else {
+      suffix_node_ = compiled_vocab_->Walk(CompiledVocab::Root(), suffix_indicator_);
+    }
+  }
+}
 
 Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
                                         bool *out_found, int *out_end) const {
@@ -81,24 +93,32 @@ Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const in
   return Status::OK();
 }
 
+void WordpieceTokenizerOp::FoundLongToken(std::string_view input_token, const uint32_t &basic_start,
+                                          std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+                                          std::vector<uint32_t> *offsets_limit) const {
+  offsets_start->push_back(basic_start);
+  if (!unknown_token_.empty()) {
+    offsets_limit->push_back(basic_start + unknown_token_.size());
+    (void)out_tokens->emplace_back(unknown_token_);
+  } else {
+    (void)out_tokens->emplace_back(input_token);
+    offsets_limit->push_back(basic_start + input_token.size());
+  }
+}
+
 Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
                                        std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                        std::vector<uint32_t> *offsets_limit) const {
   if (input_token.size() > static_cast<int>(max_bytes_per_token_)) {
-    offsets_start->push_back(basic_start);
-    if (!unknown_token_.empty()) {
-      offsets_limit->push_back(basic_start + unknown_token_.size());
-      (void)out_tokens->emplace_back(unknown_token_);
-    } else {
-      (void)out_tokens->emplace_back(input_token);
-      offsets_limit->push_back(basic_start + input_token.size());
-    }
+    FoundLongToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
     return Status::OK();
   }
   RuneStrArray runes;
   if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
     RETURN_STATUS_UNEXPECTED("WordpieceTokenizer: Decode utf8 string failed.");
   }
+  // The offsets of the subwords found before an unknown part are dropped with the subwords
+  size_t num_offsets = offsets_start->size();
   int end = 0;
   for (int start = 0; start < static_cast<int>(input_token.size());) {
     bool found = false;
@@ -109,12 +129,58 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
       offsets_limit->push_back(static_cast<uint32_t>(basic_start + end));
       start = end;
     } else {
+      offsets_start->resize(num_offsets);
+      offsets_limit->resize(num_offsets);
       return FoundNoToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
     }
   }
   return Status::OK();
 }
 
+Status WordpieceTokenizerOp::GetCompiledTokens(std::string_view input_token, const uint32_t &basic_start,
+                                               std::vector<std::string> *out_tokens,
+                                               std::vector<uint32_t> *offsets_start,
+                                               std::vector<uint32_t> *offsets_limit) const {
+  if (input_token.size() > static_cast<size_t>(max_bytes_per_token_)) {
+    FoundLongToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
+    return Status::OK();
+  }
+  // An ASCII word is always valid UTF-8
+  if (!IsAscii(input_token)) {
+    RuneStrArray runes;
+    if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
+      RETURN_STATUS_UNEXPECTED("WordpieceTokenizer: Decode utf8 string failed.");
+    }
+  }
+  // The subword found is the word of the vocab itself, the suffix indicator included
+  size_t num_offsets = offsets_start->size();
+  for (size_t start = 0; start < input_token.size();) {
+    int32_t node = start == 0 ? CompiledVocab::Root() : suffix_node_;
+    std::string_view subword;
+    WordIdType id = Vocab::kNoTokenExists;
+    size_t len = node < 0 ? 0 : compiled_vocab_->LongestPrefix(node, input_token.substr(start), &subword, &id);
+    if (len == 0) {
+      offsets_start->resize(num_offsets);
+      offsets_limit->resize(num_offsets);
+      return FoundNoToken(std::string(input_token), basic_start, out_tokens, offsets_start, offsets_limit);
+    }
+    (void)out_tokens->emplace_back(subword);
+    offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
+    offsets_limit->push_back(static_cast<uint32_t>(basic_start + start + len));
+    start += len;
+  }
+  return Status::OK();
+}
+
+Status WordpieceTokenizerOp::TokenizeWord(std::string_view input_token, const uint32_t &basic_start,
+                                          std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+                                          std::vector<uint32_t> *offsets_limit) const {
+  if (compiled_vocab_ != nullptr) {
+    return GetCompiledTokens(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
+  }
+  return GetTokens(std::string(input_token), basic_start, out_tokens, offsets_start, offsets_limit);
+}
+
 Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
   if (input[0]->Rank() > 1 || input[0]->type() != DataType::DE_STRING) {
@@ -131,7 +197,7 @@ Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
+    RETURN_IF_NOT_OK(TokenizeWord(*iter, basic_start, &temp_tokens, &offsets_start, &offsets_limit));
     out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
     count++;
   }
@@ -25,6 +25,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/include/dataset/text.h"
 #include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/text/compiled_vocab.h"
 #include "minddata/dataset/text/kernels/tokenizer_op.h"
 #include "minddata/dataset/util/status.h"
 
@@ -46,6 +47,16 @@ class WordpieceTokenizerOp : public TokenizerOp {
 
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
+  /// \brief Split a word into the subwords of the vocab.
+  /// \param[in] input_token The word
+  /// \param[in] basic_start The offset of the word
+  /// \param[out] out_tokens The subwords, or the unknown token if the word can not be split
+  /// \param[out] offsets_start The start offset of each subword is appended to it
+  /// \param[out] offsets_limit The limit offset of each subword is appended to it
+  /// \return Status error if the word is not valid UTF-8
+  Status TokenizeWord(std::string_view input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+                      std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
+
  protected:
   Status AddSubword(const std::string &input_token, const int &start, const int &end,
                     std::vector<std::string> *out_tokens) const;
@@ -55,6 +66,12 @@ class WordpieceTokenizerOp : public TokenizerOp {
                     int *out_end) const;
   Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
                    std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
+  // Split a word in one pass over it, walking the trie of the compiled vocab
+  Status GetCompiledTokens(std::string_view input_token, const uint32_t &basic_start,
+                           std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
+                           std::vector<uint32_t> *offsets_limit) const;
+  void FoundLongToken(std::string_view input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
+                      std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
 
   std::string Name() const override { return kWordpieceTokenizerOp; }
 
@@ -63,6 +80,8 @@ class WordpieceTokenizerOp : public TokenizerOp {
   const std::string suffix_indicator_;
   const int max_bytes_per_token_;
   const std::string unknown_token_;
+  std::shared_ptr<CompiledVocab> compiled_vocab_;  // Null if the vocab could not be compiled
+  int32_t suffix_node_;                            // The trie node of the suffix indicator, -1 if no word starts so
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -60,9 +60,8 @@ Status Vectors::InferShape(const std::string &path, int32_t max_vectors, int32_t
   return Status::OK();
 }
 
-Status Vectors::Load(const std::string &path, int32_t max_vectors,
-                     std::unordered_map<std::string, std::vector<float>> *map, int32_t *vector_dim) {
-  RETURN_UNEXPECTED_IF_NULL(map);
+Status Vectors::ReadFile(const std::string &path, int32_t max_vectors, int32_t *vector_dim,
+                         const std::function<Status(const std::string &, std::vector<float> &&)> &add) {
   RETURN_UNEXPECTED_IF_NULL(vector_dim);
   auto realpath = FileUtils::GetRealPath(common::SafeCStr(path));
   CHECK_FAIL_RETURN_UNEXPECTED(realpath.has_value(), "Vectors: get real path failed, path: " + path);
@@ -105,15 +104,37 @@ Status Vectors::Load(const std::string &path, int32_t max_vectors,
                                std::to_string(dim) + " while expecting " + std::to_string(*vector_dim));
     }
 
-    auto token_index = map->find(token);
-    if (token_index == map->end()) {
-      (*map)[token] = vector_values;
+    Status rc = add(token, std::move(vector_values));
+    if (rc.IsError()) {
+      file_reader.close();
+      return rc;
     }
   }
   file_reader.close();
   return Status::OK();
 }
 
+Status Vectors::Load(const std::string &path, int32_t max_vectors,
+                     std::unordered_map<std::string, std::vector<float>> *map, int32_t *vector_dim) {
+  RETURN_UNEXPECTED_IF_NULL(map);
+  return ReadFile(path, max_vectors, vector_dim, [map](const std::string &token, std::vector<float> &&vector_values) {
+    auto token_index = map->find(token);
+    if (token_index == map->end()) {
+      (*map)[token] = std::move(vector_values);
+    }
+    return Status::OK();
+  });
+}
+
+Status Vectors::LoadBinary(const std::string &path) {
+  auto realpath = FileUtils::GetRealPath(common::SafeCStr(path));
+  CHECK_FAIL_RETURN_UNEXPECTED(realpath.has_value(), "Vectors: get real path failed, path: " + path);
+  RETURN_IF_NOT_OK(VectorsFile::Open(realpath.value(), &file_));
+  map_.clear();
+  dim_ = file_->Dim();
+  return Status::OK();
+}
+
 Vectors::Vectors(const std::unordered_map<std::string, std::vector<float>> &map, int32_t dim) {
   map_ = map;
   dim_ = dim;
@@ -128,26 +149,65 @@ Status Vectors::BuildFromFile(std::shared_ptr<Vectors> *vectors, const std::stri
   return Status::OK();
 }
 
+Status Vectors::ConvertToBinary(const std::string &path, const std::string &binary_path, int32_t max_vectors) {
+  VectorsFile::Writer writer;
+  int vector_dim = -1;
+  bool opened = false;
+  RETURN_IF_NOT_OK(ReadFile(path, max_vectors, &vector_dim,
+                            [&](const std::string &token, std::vector<float> &&vector_values) {
+                              if (!opened) {
+                                RETURN_IF_NOT_OK(writer.Open(binary_path, vector_dim));
+                                opened = true;
+                              }
+                              return writer.Add(token, vector_values);
+                            }));
+  return writer.Close();
+}
+
+Status Vectors::BuildFromBinary(std::shared_ptr<Vectors> *vectors, const std::string &path) {
+  RETURN_UNEXPECTED_IF_NULL(vectors);
+  auto binary_vectors = std::make_shared<Vectors>();
+  RETURN_IF_NOT_OK(binary_vectors->LoadBinary(path));
+  *vectors = std::move(binary_vectors);
+  return Status::OK();
+}
+
+const float *Vectors::Find(const std::string &token) const {
+  if (file_ != nullptr) {
+    return file_->Find(token);
+  }
+  auto str_index = map_.find(token);
+  return str_index == map_.end() ? nullptr : str_index->second.data();
+}
+
 std::vector<float> Vectors::Lookup(const std::string &token, const std::vector<float> &unk_init,
                                    bool lower_case_backup) {
-  std::vector<float> init_vec(dim_, 0);
-  if (!unk_init.empty()) {
-    if (unk_init.size() != dim_) {
-      MS_LOG(WARNING) << "Vectors: size of unk_init is not the same as vectors, will initialize with zero vectors.";
-    } else {
-      init_vec = unk_init;
-    }
+  if (!unk_init.empty() && unk_init.size() != dim_) {
+    MS_LOG(WARNING) << "Vectors: size of unk_init is not the same as vectors, will initialize with zero vectors.";
   }
-  std::string lower_token = token;
+  std::vector<float> vector_value(dim_, 0);
+  LookupInto(token, unk_init, lower_case_backup, vector_value.data());
+  return vector_value;
+}
+
+void Vectors::LookupInto(const std::string &token, const std::vector<float> &unk_init, bool lower_case_backup,
+                         float *out) const {
+  const float *vector_value = nullptr;
   if (lower_case_backup) {
+    std::string lower_token = token;
     transform(lower_token.begin(), lower_token.end(), lower_token.begin(), ::tolower);
-  }
-  auto str_index = map_.find(lower_token);
-  if (str_index == map_.end()) {
-    return init_vec;
+    vector_value = Find(lower_token);
   } else {
-    return str_index->second;
+    vector_value = Find(token);
+  }
+  if (vector_value == nullptr) {
+    if (unk_init.size() != dim_) {
+      std::fill(out, out + dim_, 0.0F);
+      return;
+    }
+    vector_value = unk_init.data();
   }
+  std::copy(vector_value, vector_value + dim_, out);
 }
 }  // namespace dataset
 }  // namespace mindspore
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <fstream>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <string>
@@ -28,6 +29,7 @@
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/include/dataset/iterator.h"
+#include "minddata/dataset/text/vectors_file.h"
 
 namespace mindspore {
 namespace dataset {
@@ -51,6 +53,19 @@ class Vectors {
   /// \param[in] max_vectors This can be used to limit the number of pre-trained vectors loaded (default=0, no limit).
   static Status BuildFromFile(std::shared_ptr<Vectors> *vectors, const std::string &path, int32_t max_vectors = 0);
 
+  /// \brief Convert a pre-train vector file to a binary vector file, which is loaded by BuildFromBinary. Only the
+  ///     tokens are held in memory during the conversion.
+  /// \param[in] path Path to the pre-trained word vector file.
+  /// \param[in] binary_path Path to the binary vector file to write.
+  /// \param[in] max_vectors This can be used to limit the number of pre-trained vectors converted (default=0, no limit).
+  static Status ConvertToBinary(const std::string &path, const std::string &binary_path, int32_t max_vectors = 0);
+
+  /// \brief Build Vectors from a binary vector file. The file is memory mapped instead of read into the heap, so the
+  ///     workers loading the same file share its pages.
+  /// \param[out] vectors Vectors object which contains the pre-train vectors.
+  /// \param[in] path Path to the binary vector file.
+  static Status BuildFromBinary(std::shared_ptr<Vectors> *vectors, const std::string &path);
+
   /// \brief Look up embedding vectors of token.
   /// \param[in] token A token to be looked up.
   /// \param[in] unk_init In case of the token is out-of-vectors (OOV), the result will be initialized with `unk_init`.
@@ -60,6 +75,14 @@ class Vectors {
   virtual std::vector<float> Lookup(const std::string &token, const std::vector<float> &unk_init = {},
                                     bool lower_case_backup = false);
 
+  /// \brief Look up the embedding vector of token into a buffer, without allocating it.
+  /// \param[in] token A token to be looked up.
+  /// \param[in] unk_init The vector of an out-of-vectors (OOV) token, zero vectors if it is not of dimension Dim().
+  /// \param[in] lower_case_backup Whether to look up the token in the lower case.
+  /// \param[out] out The buffer of Dim() floats the vector is copied to.
+  virtual void LookupInto(const std::string &token, const std::vector<float> &unk_init, bool lower_case_backup,
+                          float *out) const;
+
   /// \brief Getter of dimension.
   const int32_t &Dim() const { return dim_; }
 
@@ -81,8 +104,26 @@ class Vectors {
   static Status Load(const std::string &path, int32_t max_vectors,
                      std::unordered_map<std::string, std::vector<float>> *map, int32_t *vector_dim);
 
+  /// \brief Read a pre-train vector file one vector at a time.
+  /// \param[in] path Path to the pre-trained word vector file.
+  /// \param[in] max_vectors Maximum number of pre-trained word vectors to be read, must be non negative.
+  /// \param[out] vector_dim The dimension of the vectors in the file, known before the first vector is passed.
+  /// \param[in] add Called with each token and its vector, in the order of the file.
+  static Status ReadFile(const std::string &path, int32_t max_vectors, int32_t *vector_dim,
+                         const std::function<Status(const std::string &, std::vector<float> &&)> &add);
+
+  /// \brief Map a binary vector file as the vectors of this object.
+  /// \param[in] path Path to the binary vector file.
+  Status LoadBinary(const std::string &path);
+
+  /// \brief Find the vector of a token, in the binary vector file if one is loaded.
+  /// \param[in] token The token.
+  /// \return The Dim() floats of the vector, nullptr if the token is not in the vectors.
+  const float *Find(const std::string &token) const;
+
   int32_t dim_;
   std::unordered_map<std::string, std::vector<float>> map_;
+  std::shared_ptr<VectorsFile> file_;  // The mapped binary vector file, map_ is empty if it is set
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,228 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/vectors_file.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr char kMagic[] = "MSVECTOR";
+constexpr uint32_t kVersion = 1;
+// The matrix starts right after the header, on a cache line
+constexpr uint64_t kMatrixOffset = 64;
+constexpr char kTmpSuffix[] = ".tmp";
+
+struct Header {
+  char magic[sizeof(kMagic) - 1];
+  uint32_t version;
+  int32_t dim;
+  uint64_t num_rows;
+  uint64_t tokens_offset;  // The tokens back to back, after the matrix
+  uint64_t tokens_size;
+  uint64_t index_offset;  // The index, after the tokens
+};
+static_assert(sizeof(Header) <= kMatrixOffset, "The header overlaps the matrix");
+
+uint64_t AlignUp(uint64_t offset, uint64_t alignment) { return (offset + alignment - 1) / alignment * alignment; }
+}  // namespace
+
+Status VectorsFile::Writer::Open(const std::string &path, int32_t dim) {
+  CHECK_FAIL_RETURN_UNEXPECTED(dim > 0, "Vectors: dimension of the vectors must be positive, but got: " +
+                                          std::to_string(dim));
+  path_ = path;
+  dim_ = dim;
+  num_rows_ = 0;
+  rows_.clear();
+  // The file is written aside and renamed once complete, a reader never maps a partial file
+  file_.open(path_ + kTmpSuffix, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED(file_.is_open(), "Vectors: failed to create binary vector file: " + path_ + kTmpSuffix);
+  // The header is written last, once the sizes are known
+  (void)file_.seekp(static_cast<std::streamoff>(kMatrixOffset));
+  return Status::OK();
+}
+
+Status VectorsFile::Writer::Add(const std::string &token, const std::vector<float> &vector) {
+  CHECK_FAIL_RETURN_UNEXPECTED(file_.is_open(), "Vectors: binary vector file is not open.");
+  CHECK_FAIL_RETURN_UNEXPECTED(vector.size() == static_cast<size_t>(dim_),
+                               "Vectors: all vectors must have the same number of dimensions, but got dim " +
+                                 std::to_string(vector.size()) + " while expecting " + std::to_string(dim_));
+  if (rows_.find(token) != rows_.end()) {
+    return Status::OK();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(num_rows_ < std::numeric_limits<uint32_t>::max(),
+                               "Vectors: too many vectors for a binary vector file.");
+  (void)file_.write(reinterpret_cast<const char *>(vector.data()),
+                    static_cast<std::streamsize>(vector.size() * sizeof(float)));
+  CHECK_FAIL_RETURN_UNEXPECTED(file_.good(), "Vectors: failed to write binary vector file: " + path_);
+  rows_[token] = num_rows_++;
+  return Status::OK();
+}
+
+Status VectorsFile::Writer::Close() {
+  CHECK_FAIL_RETURN_UNEXPECTED(file_.is_open(), "Vectors: binary vector file is not open.");
+  CHECK_FAIL_RETURN_UNEXPECTED(num_rows_ > 0, "Vectors: invalid file, file is empty.");
+  std::vector<std::pair<std::string_view, uint32_t>> tokens;
+  tokens.reserve(rows_.size());
+  for (const auto &[token, row] : rows_) {
+    (void)tokens.emplace_back(token, row);
+  }
+  std::sort(tokens.begin(), tokens.end());
+
+  Header header{};
+  (void)memcpy_s(header.magic, sizeof(header.magic), kMagic, sizeof(header.magic));
+  header.version = kVersion;
+  header.dim = dim_;
+  header.num_rows = num_rows_;
+  header.tokens_offset = kMatrixOffset + static_cast<uint64_t>(num_rows_) * dim_ * sizeof(float);
+  std::vector<IndexEntry> index;
+  index.reserve(tokens.size());
+  for (const auto &[token, row] : tokens) {
+    index.push_back({header.tokens_size, static_cast<uint32_t>(token.size()), row});
+    (void)file_.write(token.data(), static_cast<std::streamsize>(token.size()));
+    header.tokens_size += token.size();
+  }
+  header.index_offset = AlignUp(header.tokens_offset + header.tokens_size, alignof(IndexEntry));
+  (void)file_.seekp(static_cast<std::streamoff>(header.index_offset));
+  (void)file_.write(reinterpret_cast<const char *>(index.data()),
+                    static_cast<std::streamsize>(index.size() * sizeof(IndexEntry)));
+  (void)file_.seekp(0);
+  (void)file_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file_.close();
+  rows_.clear();
+  std::string tmp_path = path_ + kTmpSuffix;
+  if (file_.fail() || std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    (void)std::remove(tmp_path.c_str());
+    RETURN_STATUS_UNEXPECTED("Vectors: failed to write binary vector file: " + path_);
+  }
+  return Status::OK();
+}
+
+VectorsFile::Writer::~Writer() {
+  // A file which was not closed is incomplete
+  if (file_.is_open()) {
+    file_.close();
+    (void)std::remove((path_ + kTmpSuffix).c_str());
+  }
+}
+
+Status VectorsFile::Open(const std::string &path, std::shared_ptr<VectorsFile> *file) {
+  RETURN_UNEXPECTED_IF_NULL(file);
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(path.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Vectors: invalid file, failed to open binary vector file: " + path +
+                                          ", error: " + std::string(strerror(errno)));
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < kMatrixOffset) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED("Vectors: invalid file, binary vector file is truncated: " + path);
+  }
+  auto size = static_cast<uint64_t>(st.st_size);
+  // A shared read only mapping, every process mapping the file reads the same pages of the page cache
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping keeps its own reference to the file, the descriptor is not needed any more.
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED(addr != MAP_FAILED, "[Internal ERROR] Failed to mmap file: " + path +
+                                                      ", error: " + std::string(strerror(errno)));
+  // The tokens hit rows all over the matrix, reading ahead would only load rows never looked up
+  (void)madvise(addr, size, MADV_RANDOM);
+  auto mapped = std::shared_ptr<VectorsFile>(new VectorsFile(static_cast<uint8_t *>(addr), size));
+  RETURN_IF_NOT_OK(mapped->Parse(path));
+  *file = std::move(mapped);
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED("[Internal ERROR] mmap is not supported on this platform, file: " + path);
+#endif
+}
+
+VectorsFile::~VectorsFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr) {
+    if (munmap(data_, size_) != 0) {
+      MS_LOG(ERROR) << "[Internal ERROR] Failed to munmap, error: " << strerror(errno);
+    }
+    data_ = nullptr;
+  }
+#endif
+}
+
+Status VectorsFile::Parse(const std::string &path) {
+  Header header{};
+  (void)memcpy_s(&header, sizeof(header), data_, sizeof(header));
+  const std::string invalid = "Vectors: invalid file, " + path + " is not a binary vector file";
+  CHECK_FAIL_RETURN_UNEXPECTED(memcmp(header.magic, kMagic, sizeof(header.magic)) == 0, invalid + ".");
+  CHECK_FAIL_RETURN_UNEXPECTED(header.version == kVersion,
+                               invalid + " of version " + std::to_string(kVersion) + ", but got version " +
+                                 std::to_string(header.version) + ".");
+  CHECK_FAIL_RETURN_UNEXPECTED(header.dim > 0, invalid + ", the dimension is not positive.");
+  CHECK_FAIL_RETURN_UNEXPECTED(header.num_rows > 0 && header.num_rows <= std::numeric_limits<uint32_t>::max(),
+                               invalid + ", the number of vectors is out of range.");
+  // The sections must follow each other within the file. The sizes are bounded by the file size before they are
+  // multiplied or subtracted, so that a corrupted header can not overflow them.
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    size_ >= kMatrixOffset &&
+      static_cast<uint64_t>(header.dim) <= (size_ - kMatrixOffset) / sizeof(float) / header.num_rows,
+    invalid + ", the file is truncated.");
+  uint64_t matrix_size = header.num_rows * static_cast<uint64_t>(header.dim) * sizeof(float);
+  uint64_t index_size = header.num_rows * sizeof(IndexEntry);
+  CHECK_FAIL_RETURN_UNEXPECTED(header.tokens_offset == kMatrixOffset + matrix_size && header.tokens_offset <= size_ &&
+                                 header.tokens_size <= size_ - header.tokens_offset &&
+                                 header.index_offset % alignof(IndexEntry) == 0 &&
+                                 header.index_offset >= header.tokens_offset + header.tokens_size &&
+                                 header.index_offset <= size_ && index_size <= size_ - header.index_offset,
+                               invalid + ", the file is truncated.");
+  dim_ = header.dim;
+  num_rows_ = header.num_rows;
+  matrix_ = reinterpret_cast<const float *>(data_ + kMatrixOffset);
+  tokens_ = reinterpret_cast<const char *>(data_ + header.tokens_offset);
+  index_ = reinterpret_cast<const IndexEntry *>(data_ + header.index_offset);
+  for (uint64_t i = 0; i < num_rows_; i++) {
+    CHECK_FAIL_RETURN_UNEXPECTED(index_[i].row < num_rows_ && index_[i].offset <= header.tokens_size &&
+                                   index_[i].length <= header.tokens_size - index_[i].offset,
+                                 invalid + ", the index is corrupted.");
+  }
+  return Status::OK();
+}
+
+const float *VectorsFile::Find(std::string_view token) const {
+  auto token_of = [this](const IndexEntry &entry) {
+    return std::string_view(tokens_ + entry.offset, entry.length);
+  };
+  auto end = index_ + num_rows_;
+  auto it = std::lower_bound(index_, end, token, [&token_of](const IndexEntry &entry, std::string_view key) {
+    return token_of(entry) < key;
+  });
+  if (it == end || token_of(*it) != token) {
+    return nullptr;
+  }
+  return matrix_ + static_cast<uint64_t>(it->row) * dim_;
+}
+}  // namespace dataset
+}  // namespace mindspore
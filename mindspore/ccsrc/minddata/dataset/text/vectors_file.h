@@ -0,0 +1,115 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VECTORS_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VECTORS_FILE_H_
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Pre-trained word vectors in a binary file, which is memory mapped read only. The processes loading the same
+///     file share its pages in the page cache, and only the rows looked up are ever read from disk.
+///
+///     The file holds a header, the matrix of the vectors in the order of the text file, the tokens back to back, and
+///     an index of the tokens sorted for a binary search. The numbers are in the byte order of the host.
+class VectorsFile {
+ public:
+  /// \brief Writes a binary file one vector at a time, only the tokens are kept in memory.
+  class Writer {
+   public:
+    Writer() : dim_(0), num_rows_(0) {}
+
+    /// \brief Remove the file if it was not closed.
+    ~Writer();
+
+    /// \brief Create the file, written to the path with a ".tmp" suffix until it is closed.
+    /// \param[in] path Path to the binary file
+    /// \param[in] dim Dimension of the vectors
+    /// \return Status error if the file can not be created
+    Status Open(const std::string &path, int32_t dim);
+
+    /// \brief Append a vector. A token already added is skipped, the first vector of a token is kept.
+    /// \param[in] token The token
+    /// \param[in] vector The vector of the token, of the dimension of the file
+    /// \return Status error if the file can not be written
+    Status Add(const std::string &token, const std::vector<float> &vector);
+
+    /// \brief Write the index and the header, then move the file to its path, the file is complete after it.
+    /// \return Status error if the file can not be written
+    Status Close();
+
+   private:
+    std::string path_;
+    std::ofstream file_;
+    int32_t dim_;
+    uint32_t num_rows_;
+    std::unordered_map<std::string, uint32_t> rows_;  // The row of each token
+  };
+
+  /// \brief Map a binary file into memory.
+  /// \param[in] path Path to the binary file
+  /// \param[out] file The mapped file
+  /// \return Status error if the file is not a valid binary vectors file, or mmap is not supported on this platform
+  static Status Open(const std::string &path, std::shared_ptr<VectorsFile> *file);
+
+  ~VectorsFile();
+
+  VectorsFile(const VectorsFile &) = delete;
+  VectorsFile &operator=(const VectorsFile &) = delete;
+
+  /// \brief Find the vector of a token.
+  /// \param[in] token The token
+  /// \return The Dim() floats of the vector in the mapped matrix, nullptr if the token is not in the file
+  const float *Find(std::string_view token) const;
+
+  /// \return The dimension of the vectors
+  int32_t Dim() const { return dim_; }
+
+  /// \return The number of vectors
+  uint64_t Size() const { return num_rows_; }
+
+ private:
+  struct IndexEntry {
+    uint64_t offset;  // Where the token starts among the tokens
+    uint32_t length;
+    uint32_t row;
+  };
+
+  VectorsFile(uint8_t *data, uint64_t size)
+      : data_(data), size_(size), dim_(0), num_rows_(0), matrix_(nullptr), tokens_(nullptr), index_(nullptr) {}
+
+  // Check the header and the index against the size of the file
+  Status Parse(const std::string &path);
+
+  uint8_t *data_;
+  uint64_t size_;
+  int32_t dim_;
+  uint64_t num_rows_;
+  const float *matrix_;
+  const char *tokens_;
+  const IndexEntry *index_;  // Sorted by token
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VECTORS_FILE_H_
@@ -0,0 +1,584 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/async_file_reader.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#if defined(_WIN32) || defined(_WIN64)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define MD_ENABLE_IO_URING
+#endif
+#endif
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+#ifdef MD_ENABLE_IO_URING
+// A minimal io_uring on top of the raw system calls, only what AsyncFileReader needs: one producer and one
+// consumer (the reader's thread), readv requests and blocking waits for completions.
+class IoUring {
+ public:
+  static Status Create(uint32_t entries, std::unique_ptr<IoUring> *ring) {
+    struct io_uring_params params;
+    (void)memset(&params, 0, sizeof(params));
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Failed to set up io_uring, error: " + std::string(strerror(errno)));
+    std::unique_ptr<IoUring> new_ring(new IoUring(fd, entries));
+    RETURN_IF_NOT_OK(new_ring->Map(params));
+    *ring = std::move(new_ring);
+    return Status::OK();
+  }
+
+  ~IoUring() {
+    if (sqes_ != nullptr) {
+      (void)munmap(sqes_, sqes_size_);
+    }
+    if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+      (void)munmap(cq_ptr_, cq_size_);
+    }
+    if (sq_ptr_ != nullptr) {
+      (void)munmap(sq_ptr_, sq_size_);
+    }
+    (void)close(ring_fd_);
+  }
+
+  // Queues a read of `len` bytes at `offset` into `buf` and submits it to the kernel.
+  // @param user_data - returned with the completion, below the number of entries of the ring.
+  Status SubmitRead(int fd, void *buf, size_t len, uint64_t offset, uint64_t user_data) {
+    CHECK_FAIL_RETURN_UNEXPECTED(user_data < iovs_.size(), "[Internal ERROR] Invalid io_uring request id.");
+    // The vector has to stay valid until the request completes, hence one per request id.
+    struct iovec *iov = &iovs_[user_data];
+    iov->iov_base = buf;
+    iov->iov_len = len;
+    unsigned tail = *sq_tail_;
+    unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    CHECK_FAIL_RETURN_UNEXPECTED(tail - head < sq_entries_, "[Internal ERROR] io_uring submission queue is full.");
+    unsigned index = tail & *sq_mask_;
+    struct io_uring_sqe *sqe = &sqes_[index];
+    (void)memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(iov);
+    sqe->len = 1;
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    while (true) {
+      auto ret = syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0);
+      if (ret >= 0) {
+        return Status::OK();
+      }
+      if (errno != EINTR) {
+        break;
+      }
+    }
+    // The kernel did not consume the entry, take it back so the ring stays consistent.
+    __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+    RETURN_STATUS_UNEXPECTED("Failed to submit io_uring request, error: " + std::string(strerror(errno)));
+  }
+
+  // Blocks until one request completes.
+  Status WaitCompletion(uint64_t *user_data, int32_t *res) {
+    while (true) {
+      unsigned head = *cq_head_;
+      unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+      if (head != tail) {
+        const struct io_uring_cqe *cqe = &cqes_[head & *cq_mask_];
+        *user_data = cqe->user_data;
+        *res = cqe->res;
+        __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+        return Status::OK();
+      }
+      auto ret = syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (ret < 0 && errno != EINTR) {
+        RETURN_STATUS_UNEXPECTED("Failed to wait for io_uring completion, error: " + std::string(strerror(errno)));
+      }
+    }
+  }
+
+ private:
+  IoUring(int fd, uint32_t entries) : ring_fd_(fd), iovs_(entries) {}
+
+  Status Map(const struct io_uring_params &params) {
+    sq_entries_ = params.sq_entries;
+    sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      sq_size_ = std::max(sq_size_, cq_size_);
+      cq_size_ = sq_size_;
+    }
+#endif
+    void *sq = mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    CHECK_FAIL_RETURN_UNEXPECTED(sq != MAP_FAILED, "Failed to map io_uring submission queue.");
+    sq_ptr_ = sq;
+    if (single_mmap) {
+      cq_ptr_ = sq_ptr_;
+    } else {
+      void *cq =
+        mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+      CHECK_FAIL_RETURN_UNEXPECTED(cq != MAP_FAILED, "Failed to map io_uring completion queue.");
+      cq_ptr_ = cq;
+    }
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    CHECK_FAIL_RETURN_UNEXPECTED(sqes != MAP_FAILED, "Failed to map io_uring submission entries.");
+    sqes_ = static_cast<struct io_uring_sqe *>(sqes);
+
+    auto *sq_base = static_cast<char *>(sq_ptr_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq_base + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq_base + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned *>(sq_base + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq_base + params.sq_off.array);
+    auto *cq_base = static_cast<char *>(cq_ptr_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq_base + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq_base + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned *>(cq_base + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe *>(cq_base + params.cq_off.cqes);
+    return Status::OK();
+  }
+
+  int ring_fd_;
+  std::vector<struct iovec> iovs_;
+  unsigned sq_entries_ = 0;
+  void *sq_ptr_ = nullptr;
+  size_t sq_size_ = 0;
+  void *cq_ptr_ = nullptr;
+  size_t cq_size_ = 0;
+  struct io_uring_sqe *sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  unsigned *sq_head_ = nullptr;
+  unsigned *sq_tail_ = nullptr;
+  unsigned *sq_mask_ = nullptr;
+  unsigned *sq_array_ = nullptr;
+  unsigned *cq_head_ = nullptr;
+  unsigned *cq_tail_ = nullptr;
+  unsigned *cq_mask_ = nullptr;
+  struct io_uring_cqe *cqes_ = nullptr;
+};
+#else
+class IoUring {};
+#endif
+
+IoThreadPool::IoThreadPool(int32_t num_threads) : stop_(false) {
+  num_threads = std::max(num_threads, 1);
+  for (int32_t i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(&IoThreadPool::Run, this);
+  }
+}
+
+IoThreadPool::~IoThreadPool() {
+  {
+    std::unique_lock<std::mutex> lock(mux_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+void IoThreadPool::Submit(std::function<void()> &&job) {
+  {
+    std::unique_lock<std::mutex> lock(mux_);
+    jobs_.push_back(std::move(job));
+  }
+  cv_.notify_one();
+}
+
+void IoThreadPool::Run() {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mux_);
+      cv_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+      if (jobs_.empty()) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    job();
+  }
+}
+
+AsyncFileReader::AsyncFileReader(int fd, int64_t file_size, std::string file_path)
+    : fd_(fd),
+      file_size_(file_size),
+      file_path_(std::move(file_path)),
+      backend_(Backend::kSync),
+      next_offset_(0),
+      current_(0),
+      has_current_(false),
+      data_(nullptr),
+      available_(0),
+      eof_(false) {}
+
+AsyncFileReader::~AsyncFileReader() {
+  Drain();
+  for (auto &block : blocks_) {
+    ::operator delete(block.buffer, std::align_val_t(kBufferAlignment));
+    block.buffer = nullptr;
+  }
+  ring_.reset();
+#if defined(_WIN32) || defined(_WIN64)
+  (void)_close(fd_);
+#else
+  (void)close(fd_);
+#endif
+}
+
+Status AsyncFileReader::Open(const std::string &file_path, int32_t depth, const std::shared_ptr<IoThreadPool> &pool,
+                             std::unique_ptr<AsyncFileReader> *reader) {
+  RETURN_UNEXPECTED_IF_NULL(reader);
+#if defined(_WIN32) || defined(_WIN64)
+  int fd = _open(file_path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+  int fd = open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+  CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Invalid file, failed to open " + file_path +
+                                          ", the file is damaged or permission denied.");
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+#if defined(_WIN32) || defined(_WIN64)
+    (void)_close(fd);
+#else
+    (void)close(fd);
+#endif
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to get the size of " + file_path);
+  }
+  std::unique_ptr<AsyncFileReader> new_reader(new AsyncFileReader(fd, static_cast<int64_t>(st.st_size), file_path));
+  RETURN_IF_NOT_OK(new_reader->Start(depth, pool));
+  *reader = std::move(new_reader);
+  return Status::OK();
+}
+
+bool AsyncFileReader::IoUringSupported() {
+#ifdef MD_ENABLE_IO_URING
+  static const bool supported = []() {
+    std::unique_ptr<IoUring> ring;
+    Status rc = IoUring::Create(1, &ring);
+    if (rc.IsError()) {
+      MS_LOG(INFO) << "io_uring is not available, reads ahead are issued by threads. " << rc.GetErrDescription();
+      return false;
+    }
+    return true;
+  }();
+  return supported;
+#else
+  return false;
+#endif
+}
+
+std::string AsyncFileReader::BackendName() const {
+  switch (backend_) {
+    case Backend::kIoUring:
+      return "io_uring";
+    case Backend::kThreadPool:
+      return "thread pool";
+    default:
+      return "sync";
+  }
+}
+
+Status AsyncFileReader::Start(int32_t depth, const std::shared_ptr<IoThreadPool> &pool) {
+#if defined(_WIN32) || defined(_WIN64)
+  // Without pread the descriptor can not be shared between threads, read on the calling thread.
+  depth = 0;
+#endif
+  // No point in more buffers than blocks in the file.
+  int64_t num_blocks = (file_size_ + kBlockSize - 1) / kBlockSize;
+  depth = static_cast<int32_t>(std::min(static_cast<int64_t>(std::max(depth, 0)), num_blocks));
+  if (depth > 0) {
+#ifdef MD_ENABLE_IO_URING
+    if (IoUringSupported() && IoUring::Create(static_cast<uint32_t>(depth), &ring_).IsOk()) {
+      backend_ = Backend::kIoUring;
+    }
+#endif
+    if (backend_ == Backend::kSync && pool != nullptr) {
+      pool_ = pool;
+      backend_ = Backend::kThreadPool;
+    }
+  }
+
+  size_t num_buffers = backend_ == Backend::kSync ? 1 : static_cast<size_t>(depth);
+  blocks_.resize(num_buffers);
+  for (auto &block : blocks_) {
+    block.buffer = static_cast<char *>(::operator new(kBlockSize, std::align_val_t(kBufferAlignment), std::nothrow));
+    CHECK_FAIL_RETURN_UNEXPECTED(block.buffer != nullptr, "Failed to allocate read buffer for " + file_path_);
+  }
+  if (backend_ != Backend::kSync) {
+    for (auto &block : blocks_) {
+      RETURN_IF_NOT_OK(Submit(&block));
+    }
+  }
+  return Status::OK();
+}
+
+Status AsyncFileReader::Submit(Block *block) {
+  block->result = 0;
+  if (next_offset_ >= file_size_) {
+    block->requested = 0;
+    return Status::OK();
+  }
+  block->offset = next_offset_;
+  block->requested = std::min(kBlockSize, file_size_ - next_offset_);
+  next_offset_ += block->requested;
+  if (backend_ == Backend::kIoUring) {
+#ifdef MD_ENABLE_IO_URING
+    block->pending = true;
+    Status rc = ring_->SubmitRead(fd_, block->buffer, static_cast<size_t>(block->requested),
+                                  static_cast<uint64_t>(block->offset), static_cast<uint64_t>(block - blocks_.data()));
+    if (rc.IsError()) {
+      // Wait() reads the block on the calling thread instead.
+      MS_LOG(WARNING) << rc.GetErrDescription();
+      block->pending = false;
+    }
+#endif
+  } else if (backend_ == Backend::kThreadPool) {
+    {
+      std::unique_lock<std::mutex> lock(mux_);
+      block->pending = true;
+    }
+    pool_->Submit([this, block]() {
+      int64_t result = ReadAt(block->offset, block->buffer, block->requested);
+      std::unique_lock<std::mutex> lock(mux_);
+      block->result = result;
+      block->pending = false;
+      // Notify with the lock held, the reader may be destroyed as soon as it sees the block is done.
+      cv_.notify_all();
+    });
+  }
+  return Status::OK();
+}
+
+Status AsyncFileReader::Wait(Block *block) {
+  if (backend_ == Backend::kIoUring) {
+#ifdef MD_ENABLE_IO_URING
+    while (block->pending) {
+      uint64_t user_data = 0;
+      int32_t res = 0;
+      RETURN_IF_NOT_OK(ring_->WaitCompletion(&user_data, &res));
+      CHECK_FAIL_RETURN_UNEXPECTED(user_data < blocks_.size(), "[Internal ERROR] Unknown io_uring completion.");
+      blocks_[user_data].result = res;
+      blocks_[user_data].pending = false;
+    }
+#endif
+  } else if (backend_ == Backend::kThreadPool) {
+    std::unique_lock<std::mutex> lock(mux_);
+    cv_.wait(lock, [block]() { return !block->pending; });
+  }
+  if (block->result == -EINTR || block->result == -EAGAIN) {
+    block->result = 0;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(block->result >= 0, "Invalid file, failed to read " + file_path_ +
+                                                     ", error: " + std::string(strerror(-block->result)));
+  if (block->result < block->requested) {
+    // A short read, finish the block here.
+    int64_t result =
+      ReadAt(block->offset + block->result, block->buffer + block->result, block->requested - block->result);
+    CHECK_FAIL_RETURN_UNEXPECTED(result >= 0, "Invalid file, failed to read " + file_path_ +
+                                                ", error: " + std::string(strerror(-result)));
+    block->result += result;
+  }
+  return Status::OK();
+}
+
+bool AsyncFileReader::NextBlock() {
+  if (eof_) {
+    return false;
+  }
+  Status rc;
+  Block *block = &blocks_[0];
+  if (backend_ == Backend::kSync) {
+    rc = Submit(block);
+  } else {
+    if (has_current_) {
+      // The consumer is done with the current buffer, reuse it for the next block not yet requested.
+      rc = Submit(&blocks_[current_]);
+      current_ = (current_ + 1) % blocks_.size();
+    }
+    has_current_ = true;
+    block = &blocks_[current_];
+  }
+  if (rc.IsOk() && block->requested > 0) {
+    rc = Wait(block);
+  }
+  if (rc.IsError()) {
+    error_ = rc;
+    eof_ = true;
+    return false;
+  }
+  if (block->requested == 0 || block->result == 0) {
+    eof_ = true;
+    return false;
+  }
+  data_ = block->buffer;
+  available_ = block->result;
+  return true;
+}
+
+int64_t AsyncFileReader::ReadAt(int64_t offset, char *dest, int64_t count) const {
+  int64_t done = 0;
+  while (done < count) {
+#if defined(_WIN32) || defined(_WIN64)
+    if (_lseeki64(fd_, offset + done, SEEK_SET) < 0) {
+      return -errno;
+    }
+    auto ret = _read(fd_, dest + done, static_cast<unsigned int>(count - done));
+#else
+    auto ret = pread(fd_, dest + done, static_cast<size_t>(count - done), static_cast<off_t>(offset + done));
+#endif
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -errno;
+    }
+    if (ret == 0) {
+      break;
+    }
+    done += ret;
+  }
+  return done;
+}
+
+void AsyncFileReader::Drain() {
+  if (backend_ == Backend::kIoUring) {
+#ifdef MD_ENABLE_IO_URING
+    for (auto &block : blocks_) {
+      while (block.pending) {
+        uint64_t user_data = 0;
+        int32_t res = 0;
+        Status rc = ring_->WaitCompletion(&user_data, &res);
+        if (rc.IsError() || user_data >= blocks_.size()) {
+          // Give up on the ring, closing it cancels whatever is still in flight.
+          MS_LOG(ERROR) << "Failed to drain io_uring of " << file_path_ << ". " << rc.GetErrDescription();
+          ring_.reset();
+          for (auto &b : blocks_) {
+            b.pending = false;
+          }
+          return;
+        }
+        blocks_[user_data].pending = false;
+      }
+    }
+#endif
+  } else if (backend_ == Backend::kThreadPool) {
+    std::unique_lock<std::mutex> lock(mux_);
+    cv_.wait(lock, [this]() {
+      return std::none_of(blocks_.begin(), blocks_.end(), [](const Block &block) { return block.pending; });
+    });
+  }
+}
+
+bool AsyncFileReader::GetLine(std::string *line) {
+  line->clear();
+  bool extracted = false;
+  while (true) {
+    if (available_ == 0 && !NextBlock()) {
+      return extracted;
+    }
+    extracted = true;
+    auto *newline = static_cast<const char *>(memchr(data_, '\n', static_cast<size_t>(available_)));
+    if (newline != nullptr) {
+      auto length = static_cast<int64_t>(newline - data_);
+      (void)line->append(data_, static_cast<size_t>(length));
+      data_ += length + 1;
+      available_ -= length + 1;
+#if defined(_WIN32) || defined(_WIN64)
+      // The file is opened in binary mode, drop the '\r' a text mode stream would have translated away.
+      if (!line->empty() && line->back() == '\r') {
+        line->pop_back();
+      }
+#endif
+      return true;
+    }
+    (void)line->append(data_, static_cast<size_t>(available_));
+    available_ = 0;
+  }
+}
+
+int AsyncFileReader::Get() {
+  if (available_ == 0 && !NextBlock()) {
+    return kEof;
+  }
+  int chr = static_cast<unsigned char>(*data_);
+  ++data_;
+  --available_;
+  return chr;
+}
+
+int AsyncFileReader::Peek() {
+  if (available_ == 0 && !NextBlock()) {
+    return kEof;
+  }
+  return static_cast<unsigned char>(*data_);
+}
+
+int64_t AsyncFileReader::Read(char *dest, int64_t count) {
+  int64_t done = 0;
+  while (done < count) {
+    if (available_ == 0 && !NextBlock()) {
+      break;
+    }
+    int64_t n = std::min(available_, count - done);
+    (void)memcpy(dest + done, data_, static_cast<size_t>(n));
+    data_ += n;
+    available_ -= n;
+    done += n;
+  }
+  return done;
+}
+
+int64_t AsyncFileReader::Ignore(int64_t count) {
+  int64_t done = 0;
+  while (done < count) {
+    if (available_ == 0 && !NextBlock()) {
+      break;
+    }
+    int64_t n = std::min(available_, count - done);
+    data_ += n;
+    available_ -= n;
+    done += n;
+  }
+  return done;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,186 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_ASYNC_FILE_READER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_ASYNC_FILE_READER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class IoUring;
+
+// A small pool of threads doing blocking reads on behalf of AsyncFileReader, used when io_uring is not
+// available. The pool is shared by all the readers of an op, so the number of reads in flight is bounded
+// by the number of threads rather than by the number of open files.
+class IoThreadPool {
+ public:
+  // @param num_threads - number of threads of the pool.
+  explicit IoThreadPool(int32_t num_threads);
+
+  // Waits for the queued jobs to finish and joins the threads.
+  ~IoThreadPool();
+
+  IoThreadPool(const IoThreadPool &) = delete;
+  IoThreadPool &operator=(const IoThreadPool &) = delete;
+
+  // Queues a job, it is run by the first idle thread.
+  // @param job - the job.
+  void Submit(std::function<void()> &&job);
+
+ private:
+  void Run();
+
+  std::mutex mux_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> jobs_;
+  bool stop_;
+  std::vector<std::thread> threads_;
+};
+
+// Reads a file sequentially with up to `depth` large reads kept in flight ahead of the consumer.
+//
+// The file is split into blocks of kBlockSize bytes read into aligned buffers. As soon as the consumer moves
+// past a buffer, the buffer is queued again for the next block not yet requested, so the parser on the
+// worker thread finds the data already in memory instead of waiting for the disk on every call.
+//
+// The reads are issued through io_uring when the kernel supports it, otherwise through an IoThreadPool.
+// With a depth of 0 (or without either backend) the reader reads one block at a time on the calling thread,
+// which still saves the per call overhead of std::ifstream.
+//
+// The accessors mirror the subset of std::istream used by the text and record parsers. They never throw;
+// an I/O error ends the stream and is reported by GetError().
+class AsyncFileReader {
+ public:
+  // Size of one read, and alignment of the read buffers and offsets.
+  static constexpr int64_t kBlockSize = 1024 * 1024;
+  static constexpr size_t kBufferAlignment = 4096;
+  // End of the stream, the same value as std::char_traits<char>::eof().
+  static constexpr int kEof = -1;
+
+  // Opens a file and starts reading ahead.
+  // @param file_path - path of the file.
+  // @param depth - number of reads to keep in flight, 0 to read on the calling thread.
+  // @param pool - the thread pool to read with when io_uring is not available, may be nullptr.
+  // @param reader - the opened reader.
+  // @return Status - the error code returned.
+  static Status Open(const std::string &file_path, int32_t depth, const std::shared_ptr<IoThreadPool> &pool,
+                     std::unique_ptr<AsyncFileReader> *reader);
+
+  // Whether io_uring can be used in this process. Checked once by creating a ring.
+  static bool IoUringSupported();
+
+  // Waits for the reads in flight and closes the file.
+  ~AsyncFileReader();
+
+  AsyncFileReader(const AsyncFileReader &) = delete;
+  AsyncFileReader &operator=(const AsyncFileReader &) = delete;
+
+  // Extracts characters up to the next '\n', the same as std::getline.
+  // @param line - the line without the '\n'.
+  // @return false if the stream was at its end and nothing was extracted.
+  bool GetLine(std::string *line);
+
+  // Extracts one character.
+  // @return the character as an unsigned char converted to int, kEof at the end of the stream.
+  int Get();
+
+  // Returns the next character without extracting it.
+  // @return the character as an unsigned char converted to int, kEof at the end of the stream.
+  int Peek();
+
+  // Extracts up to `count` bytes.
+  // @param dest - the destination, at least `count` bytes.
+  // @param count - number of bytes.
+  // @return number of bytes extracted, less than `count` only at the end of the stream.
+  int64_t Read(char *dest, int64_t count);
+
+  // Extracts and discards up to `count` bytes.
+  // @param count - number of bytes.
+  // @return number of bytes discarded, less than `count` only at the end of the stream.
+  int64_t Ignore(int64_t count);
+
+  // @return whether an extraction hit the end of the stream (or an error), the same as std::istream::eof.
+  bool Eof() const { return eof_; }
+
+  // @return Status - the I/O error which ended the stream, OK if there was none.
+  Status GetError() const { return error_; }
+
+  // @return the backend used by this reader, for logging.
+  std::string BackendName() const;
+
+ private:
+  struct Block {
+    char *buffer = nullptr;
+    int64_t offset = 0;     // offset in the file of the first byte of the block
+    int64_t requested = 0;  // number of bytes requested
+    int64_t result = 0;     // number of bytes read, or -errno
+    bool pending = false;   // whether a read into the buffer is in flight
+  };
+
+  enum class Backend { kSync, kIoUring, kThreadPool };
+
+  AsyncFileReader(int fd, int64_t file_size, std::string file_path);
+
+  // Allocates the buffers and submits the first reads.
+  Status Start(int32_t depth, const std::shared_ptr<IoThreadPool> &pool);
+
+  // Requests the next block of the file into a buffer, if the file has any left.
+  Status Submit(Block *block);
+
+  // Waits until the read into a buffer completes and fixes up short or failed reads.
+  Status Wait(Block *block);
+
+  // Releases the current buffer and makes the next block the current one.
+  // @return false at the end of the file or on error.
+  bool NextBlock();
+
+  // Reads exactly `count` bytes from `offset` unless the file ends first, on the calling thread.
+  // @return number of bytes read, or -errno.
+  int64_t ReadAt(int64_t offset, char *dest, int64_t count) const;
+
+  // Waits for every read in flight, needed before the buffers can be freed.
+  void Drain();
+
+  int fd_;
+  int64_t file_size_;
+  std::string file_path_;
+  Backend backend_;
+  std::unique_ptr<IoUring> ring_;
+  std::shared_ptr<IoThreadPool> pool_;
+  std::mutex mux_;  // guards Block::pending and Block::result of the thread pool backend
+  std::condition_variable cv_;
+  std::vector<Block> blocks_;
+  int64_t next_offset_;  // offset of the next block to request
+  size_t current_;       // index of the block being consumed
+  bool has_current_;     // whether the consumer has started on blocks_[current_]
+  const char *data_;     // unread bytes of the current block
+  int64_t available_;
+  bool eof_;
+  Status error_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_ASYNC_FILE_READER_H_
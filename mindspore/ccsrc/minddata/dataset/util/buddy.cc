@@ -111,6 +111,17 @@ void BuddySpace::Free(const BSpaceDescriptor *desc) {
   return FreeNoLock(desc);
 }
 
+void BuddySpace::Free(addr_t addr, uint64_t sz) {
+  // Rebuild the descriptor AllocNoLock gave out for this address and size
+  BSpaceDescriptor desc{0};
+  desc.sig = static_cast<int>(0xDEADBEEF);
+  desc.addr = static_cast<rel_addr_t>(addr / static_cast<addr_t>(min_));
+  desc.req_size = SizeToBlock(sz);
+  desc.blk_size = NextPowerOf2(desc.req_size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  return FreeNoLock(&desc);
+}
+
 std::ostream &operator<<(std::ostream &os, const BuddySpace &s) {
   const int32_t kLvlOffset = 4;
   os << "1 unit = " << s.GetMinSize() << "\n"
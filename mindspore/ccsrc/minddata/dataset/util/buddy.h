@@ -57,6 +57,9 @@ class BuddySpace {
 
   void Free(const BSpaceDescriptor *desc);
 
+  // Free a space given the address returned by Alloc and the size asked for, instead of the descriptor.
+  void Free(addr_t addr, uint64_t sz);
+
   uint64_t GetMinSize() const { return min_; }
 
   uint64_t GetMaxSize() const { return max_; }
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "minddata/dataset/util/memory_pool.h"
+
+#include <utility>
+
 #include "./securec.h"
 
 namespace mindspore {
@@ -33,6 +36,19 @@ Status DeMalloc(std::size_t s, void **p, bool init_to_zero = false) {
     return Status::OK();
   }
 }
+
+namespace {
+thread_local std::shared_ptr<MemoryPool> thread_memory_pool = nullptr;
+}  // namespace
+
+std::shared_ptr<MemoryPool> GetThreadMemoryPool() { return thread_memory_pool; }
+
+ThreadMemoryPoolGuard::ThreadMemoryPoolGuard(std::shared_ptr<MemoryPool> pool)
+    : prev_pool_(std::move(thread_memory_pool)) {
+  thread_memory_pool = std::move(pool);
+}
+
+ThreadMemoryPoolGuard::~ThreadMemoryPoolGuard() { thread_memory_pool = std::move(prev_pool_); }
 }  // namespace dataset
 }  // namespace mindspore
 
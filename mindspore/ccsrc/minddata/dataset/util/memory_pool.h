@@ -45,6 +45,25 @@ class MemoryPool {
 };
 
 Status DeMalloc(std::size_t s, void **p, bool);
+
+// Returns the memory pool the tensors created by the calling thread allocate their data from,
+// nullptr if the thread uses the global memory pool.
+std::shared_ptr<MemoryPool> GetThreadMemoryPool();
+
+// Sets the memory pool of the calling thread (see GetThreadMemoryPool) for the lifetime of the guard
+// and restores the previous one when the guard goes out of scope.
+class ThreadMemoryPoolGuard {
+ public:
+  explicit ThreadMemoryPoolGuard(std::shared_ptr<MemoryPool> pool);
+
+  ~ThreadMemoryPoolGuard();
+
+  ThreadMemoryPoolGuard(const ThreadMemoryPoolGuard &) = delete;
+  ThreadMemoryPoolGuard &operator=(const ThreadMemoryPoolGuard &) = delete;
+
+ private:
+  std::shared_ptr<MemoryPool> prev_pool_;
+};
 }  // namespace dataset
 }  // namespace mindspore
 
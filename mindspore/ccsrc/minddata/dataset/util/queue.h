@@ -30,11 +30,14 @@
 #include "minddata/dataset/util/log_adapter.h"
 #include "minddata/dataset/util/services.h"
 #include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/ring_buffer.h"
 #include "minddata/dataset/util/task_manager.h"
 
 namespace mindspore {
 namespace dataset {
-// A simple thread safe queue using a fixed size array
+// A simple thread safe queue using a fixed size array.
+// When created with lock_free set, the elements are kept in a lock free RingBuffer instead, and the
+// mutex/condition variable pair below is bypassed. Resize is not supported in that mode.
 template <typename T>
 class Queue {
  public:
@@ -44,29 +47,36 @@ class Queue {
   using reference = T &;
   using const_reference = const T &;
 
-  explicit Queue(int sz)
-      : sz_(sz), arr_(Services::GetAllocator<T>()), head_(0), tail_(0), my_name_(Services::GetUniqueID()) {
-    Status rc = arr_.allocate(sz);
-    if (rc.IsError()) {
-      MS_LOG(ERROR) << "Fail to create a queue.";
-      std::terminate();
-    } else {
-      MS_LOG(DEBUG) << "Create Q with uuid " << my_name_ << " of size " << sz_ << ".";
+  explicit Queue(int sz) : Queue(sz, false, nullptr) {}
+
+  Queue(int sz, bool lock_free) : Queue(sz, lock_free, nullptr) {
+    if (lock_free) {
+      ring_ = std::make_unique<RingBuffer<T>>(sz);
+      MS_LOG(DEBUG) << "Create lock free Q with uuid " << my_name_ << " of size " << sz_ << ".";
     }
   }
 
   virtual ~Queue() { ResetQue(); }
 
   size_t size() const {
+    if (ring_ != nullptr) {
+      return ring_->size();
+    }
     size_t v = tail_ - head_;
     return (v >= 0) ? v : 0;
   }
 
   size_t capacity() const { return sz_; }
 
-  bool empty() const { return head_ == tail_; }
+  bool empty() const { return ring_ != nullptr ? ring_->empty() : head_ == tail_; }
+
+  bool lock_free() const { return ring_ != nullptr; }
 
   void Reset() {
+    if (ring_ != nullptr) {
+      ring_->Reset();
+      return;
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     ResetQue();
     extra_arr_.clear();
@@ -74,6 +84,9 @@ class Queue {
 
   // Producer
   Status Add(const_reference ele) noexcept {
+    if (ring_ != nullptr) {
+      return ring_->Add(ele);
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
     Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
@@ -88,6 +101,9 @@ class Queue {
   }
 
   Status Add(T &&ele) noexcept {
+    if (ring_ != nullptr) {
+      return ring_->Add(std::forward<T>(ele));
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
     Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
@@ -103,6 +119,9 @@ class Queue {
 
   template <typename... Ts>
   Status EmplaceBack(Ts &&... args) noexcept {
+    if (ring_ != nullptr) {
+      return ring_->EmplaceBack(std::forward<Ts>(args)...);
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
     Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
@@ -119,6 +138,9 @@ class Queue {
 
   // Consumer
   virtual Status PopFront(pointer p) {
+    if (ring_ != nullptr) {
+      return ring_->PopFront(p);
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when empty
     Status rc = empty_cv_.Wait(&_lock, [this]() -> bool { return !empty(); });
@@ -133,6 +155,9 @@ class Queue {
   }
 
   Status Register(TaskGroup *vg) {
+    if (ring_ != nullptr) {
+      return ring_->Register(vg);
+    }
     Status rc1 = empty_cv_.Register(vg->GetIntrpService());
     Status rc2 = full_cv_.Register(vg->GetIntrpService());
     if (rc1.IsOk()) {
@@ -143,6 +168,7 @@ class Queue {
   }
 
   Status Resize(int32_t new_capacity) {
+    CHECK_FAIL_RETURN_UNEXPECTED(ring_ == nullptr, "Resize is not supported by a lock free queue.");
     std::unique_lock<std::mutex> _lock(mux_);
     CHECK_FAIL_RETURN_UNEXPECTED(new_capacity > 0,
                                  "New capacity: " + std::to_string(new_capacity) + ", should be larger than 0");
@@ -195,6 +221,22 @@ class Queue {
   std::mutex mux_;
   CondVar empty_cv_;
   CondVar full_cv_;
+  std::unique_ptr<RingBuffer<T>> ring_;
+
+  // Constructor shared by the two public ones, the array is only allocated for the mutex based queue.
+  Queue(int sz, bool lock_free, std::nullptr_t)
+      : sz_(sz), arr_(Services::GetAllocator<T>()), head_(0), tail_(0), my_name_(Services::GetUniqueID()) {
+    if (lock_free) {
+      return;
+    }
+    Status rc = arr_.allocate(sz);
+    if (rc.IsError()) {
+      MS_LOG(ERROR) << "Fail to create a queue.";
+      std::terminate();
+    } else {
+      MS_LOG(DEBUG) << "Create Q with uuid " << my_name_ << " of size " << sz_ << ".";
+    }
+  }
 
   // Helper function for Add, must be called when holding a lock
   Status AddWhileHoldingLock(const_reference ele) {
@@ -239,12 +281,17 @@ class Queue {
 template <typename T>
 class QueueList {
  public:
-  QueueList() {}
+  QueueList() : lock_free_(false) {}
 
-  void Init(int num_queues, int capacity) {
+  /// Create the queues of the list.
+  /// \param num_queues Number of queues
+  /// \param capacity Capacity of each queue
+  /// \param lock_free Whether the queues are backed by a lock free RingBuffer
+  void Init(int num_queues, int capacity, bool lock_free = false) {
+    lock_free_ = lock_free;
     (void)queue_list_.reserve(num_queues);
     for (int i = 0; i < num_queues; i++) {
-      (void)queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity));
+      (void)queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity, lock_free_));
     }
   }
 
@@ -267,7 +314,7 @@ class QueueList {
   ~QueueList() = default;
 
   Status AddQueue(TaskGroup *vg) {
-    (void)queue_list_.emplace_back(std::make_unique<Queue<T>>(queue_list_[0]->capacity()));
+    (void)queue_list_.emplace_back(std::make_unique<Queue<T>>(queue_list_[0]->capacity(), lock_free_));
     return queue_list_[queue_list_.size() - 1]->Register(vg);
   }
   Status RemoveLastQueue() {
@@ -281,6 +328,7 @@ class QueueList {
   // requirement that objects must have copy semantics.  To resolve this, we use a vector of unique
   // pointers.  This allows us to provide dynamic creation of queues in a container.
   std::vector<std::unique_ptr<Queue<T>>> queue_list_;
+  bool lock_free_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,231 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_BUFFER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/log_adapter.h"
+#include "minddata/dataset/util/status.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+// Size of a cache line on the platforms we run on. The head and tail indices of the ring are placed on
+// different cache lines so that producers and consumers do not false share.
+constexpr size_t kCacheLineSize = 64;
+
+// A bounded multi-producer multi-consumer lock free ring buffer.
+//
+// Each slot carries a sequence number (D. Vyukov's bounded MPMC queue). A producer claims the slot at the
+// tail when its sequence equals the tail index; a consumer claims the slot at the head when its sequence
+// equals head + 1. Claiming is a single CAS on the (cache line padded) head or tail, so the fast path never
+// takes a lock.
+//
+// Blocking conditions:
+//   1. Add() spins for a short while when the ring is full, then parks on a condition variable.
+//   2. PopFront() spins for a short while when the ring is empty, then parks on a condition variable.
+// The opposite side only takes the park mutex when it sees a parked waiter, so in steady state there is
+// no futex traffic at all.
+template <typename T>
+class RingBuffer {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_reference = const T &;
+
+  // Number of failed attempts before a thread yields, and before it parks.
+  static constexpr int32_t kSpinCount = 64;
+  static constexpr int32_t kYieldCount = 16;
+
+  explicit RingBuffer(int32_t sz)
+      : sz_(sz > 0 ? static_cast<size_t>(sz) : 1),
+        cells_(std::make_unique<Cell[]>(sz_)),
+        head_(0),
+        tail_(0),
+        num_waiting_producers_(0),
+        num_waiting_consumers_(0) {
+    for (size_t i = 0; i < sz_; ++i) {
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~RingBuffer() = default;
+
+  size_t size() const {
+    size_t tail = tail_.load(std::memory_order_acquire);
+    size_t head = head_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  size_t capacity() const { return sz_; }
+
+  bool empty() const { return size() == 0; }
+
+  // Try to add an element without blocking. The element is moved from only if the call succeeds.
+  bool TryAdd(T &&ele) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell *cell = &cells_[pos % sz_];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell->data = std::move(ele);
+          cell->seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // The slot has not been consumed since the last lap, the ring is full.
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Try to pop an element without blocking.
+  bool TryPopFront(pointer p) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell *cell = &cells_[pos % sz_];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          *p = std::move(cell->data);
+          cell->seq.store(pos + sz_, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // Nothing has been produced into this slot yet, the ring is empty.
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Producer
+  Status Add(const_reference ele) noexcept {
+    T copy(ele);
+    return Add(std::move(copy));
+  }
+
+  Status Add(T &&ele) noexcept {
+    if (!SpinUntil([this, &ele]() { return TryAdd(std::move(ele)); })) {
+      std::unique_lock<std::mutex> lck(mux_);
+      num_waiting_producers_.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      Status rc = full_cv_.Wait(&lck, [this, &ele]() { return TryAdd(std::move(ele)); });
+      num_waiting_producers_.fetch_sub(1, std::memory_order_relaxed);
+      if (rc.IsError()) {
+        empty_cv_.Interrupt();
+        return rc;
+      }
+    }
+    WakeUp(&num_waiting_consumers_, &empty_cv_);
+    return Status::OK();
+  }
+
+  template <typename... Ts>
+  Status EmplaceBack(Ts &&... args) noexcept {
+    return Add(T(std::forward<Ts>(args)...));
+  }
+
+  // Consumer
+  Status PopFront(pointer p) noexcept {
+    if (!SpinUntil([this, p]() { return TryPopFront(p); })) {
+      std::unique_lock<std::mutex> lck(mux_);
+      num_waiting_consumers_.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      Status rc = empty_cv_.Wait(&lck, [this, p]() { return TryPopFront(p); });
+      num_waiting_consumers_.fetch_sub(1, std::memory_order_relaxed);
+      if (rc.IsError()) {
+        full_cv_.Interrupt();
+        return rc;
+      }
+    }
+    WakeUp(&num_waiting_producers_, &full_cv_);
+    return Status::OK();
+  }
+
+  // Drop all the elements in the ring. The caller must make sure no producer or consumer is active.
+  void Reset() {
+    T val;
+    while (TryPopFront(&val)) {
+    }
+    empty_cv_.ResetIntrpState();
+    full_cv_.ResetIntrpState();
+  }
+
+  Status Register(TaskGroup *vg) {
+    RETURN_UNEXPECTED_IF_NULL(vg);
+    RETURN_IF_NOT_OK(empty_cv_.Register(vg->GetIntrpService()));
+    return full_cv_.Register(vg->GetIntrpService());
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> seq;
+    T data;
+  };
+
+  // Retry f() a bounded number of times, yielding the cpu after a few failed attempts.
+  template <typename F>
+  bool SpinUntil(const F &f) {
+    for (int32_t i = 0; i < kSpinCount; ++i) {
+      if (f()) {
+        return true;
+      }
+      if (i >= kSpinCount - kYieldCount) {
+        std::this_thread::yield();
+      }
+    }
+    return false;
+  }
+
+  // Notify the other side only if someone is parked. The fence pairs with the one taken by the waiter
+  // after it announces itself, so either we see the waiter or the waiter sees our update.
+  void WakeUp(std::atomic<int32_t> *num_waiting, CondVar *cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (num_waiting->load(std::memory_order_relaxed) > 0) {
+      // Taking the lock guarantees the waiter is either before its predicate check or already asleep.
+      std::unique_lock<std::mutex> lck(mux_);
+      lck.unlock();
+      cv->NotifyAll();
+    }
+  }
+
+  const size_t sz_;
+  std::unique_ptr<Cell[]> cells_;
+  alignas(kCacheLineSize) std::atomic<size_t> head_;
+  alignas(kCacheLineSize) std::atomic<size_t> tail_;
+  alignas(kCacheLineSize) std::atomic<int32_t> num_waiting_producers_;
+  std::atomic<int32_t> num_waiting_consumers_;
+  std::mutex mux_;
+  CondVar empty_cv_;
+  CondVar full_cv_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_RING_BUFFER_H_
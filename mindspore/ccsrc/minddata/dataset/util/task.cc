@@ -55,7 +55,8 @@ void Task::operator()() {
     auto intrp_service = vg->GetIntrpService();
     rc_ = intrp_service->Register(&uuid, this);
     if (rc_.IsOk()) {
-      // Now we can run the given task.
+      // Now we can run the given task. The tensors it creates are allocated from the pool of its group.
+      ThreadMemoryPoolGuard pool_guard(vg->GetMemoryPool());
       rc_ = fnc_obj_();
     }
     // Some error codes are ignored, e.g. interrupt. Others we just shutdown the group.
@@ -25,9 +25,11 @@
 #include <memory>
 #include <string>
 #include <set>
+#include <utility>
 #include "minddata/dataset/util/allocator.h"
 #include "minddata/dataset/util/intrp_service.h"
 #include "minddata/dataset/util/lock.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/services.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/util/task.h"
@@ -153,6 +155,13 @@ class TaskGroup : public Service {
 
   std::shared_ptr<IntrpService> GetIntrpService();
 
+  // Sets the memory pool the tensors created by the tasks of the group are allocated from.
+  // @param pool - the memory pool, nullptr to use the global pool. Only tasks created afterwards use it.
+  void SetMemoryPool(std::shared_ptr<MemoryPool> pool) { mem_pool_ = std::move(pool); }
+
+  // @return the memory pool of the tasks of the group, nullptr if they use the global pool.
+  std::shared_ptr<MemoryPool> GetMemoryPool() const { return mem_pool_; }
+
  private:
   Status rc_;
   // Can't use rw_lock_ as we will lead to deadlatch. Create another mutex to serialize access to rc_.
@@ -160,6 +169,7 @@ class TaskGroup : public Service {
   RWLock rw_lock_;
   List<Task> grp_list_;
   std::shared_ptr<IntrpService> intrp_svc_;
+  std::shared_ptr<MemoryPool> mem_pool_;
 };
 
 namespace this_thread {
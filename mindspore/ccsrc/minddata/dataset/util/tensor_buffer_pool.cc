@@ -0,0 +1,193 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/tensor_buffer_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include "./securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Every buffer starts with a header recording its size class, so Deallocate knows where to put it back.
+// The header is as large as the alignment malloc guarantees for the data that follows it.
+struct BufferHeader {
+  int64_t size_class;  // kUnpooled for the buffers above kMaxPooledSize
+  uint64_t size;       // bytes after the header
+};
+constexpr size_t kHeaderSize = std::max(sizeof(BufferHeader), alignof(std::max_align_t));
+constexpr int64_t kUnpooled = -1;
+constexpr int kClassesPerPow2 = 4;
+constexpr int kClassesPerPow2Bits = 2;
+constexpr int kMinPooledSizeBits = 6;  // log2(kMinPooledSize)
+
+int FloorLog2(uint64_t n) {
+  int bits = 0;
+  while (n >>= 1) {
+    bits++;
+  }
+  return bits;
+}
+
+BufferHeader *HeaderOf(void *p) { return reinterpret_cast<BufferHeader *>(static_cast<char *>(p) - kHeaderSize); }
+}  // namespace
+
+TensorBufferPool::TensorBufferPool(uint64_t capacity)
+    : capacity_(capacity),
+      free_lists_(SizeClass(kMaxPooledSize) + 1),
+      hits_(0),
+      misses_(0),
+      bytes_in_pool_(0),
+      bytes_in_use_(0) {}
+
+TensorBufferPool::~TensorBufferPool() { Trim(); }
+
+int TensorBufferPool::SizeClass(size_t n) {
+  if (n <= kMinPooledSize) {
+    return 0;
+  }
+  // n is in (2^bits, 2^(bits + 1)], which is split into kClassesPerPow2 classes
+  int bits = FloorLog2(n - 1);
+  size_t step = static_cast<size_t>(1) << (bits - kClassesPerPow2Bits);
+  size_t sub_class = (n - 1 - (static_cast<size_t>(1) << bits)) / step;
+  return 1 + (bits - kMinPooledSizeBits) * kClassesPerPow2 + static_cast<int>(sub_class);
+}
+
+size_t TensorBufferPool::ClassSize(int size_class) {
+  if (size_class == 0) {
+    return kMinPooledSize;
+  }
+  int bits = kMinPooledSizeBits + (size_class - 1) / kClassesPerPow2;
+  size_t sub_class = static_cast<size_t>((size_class - 1) % kClassesPerPow2);
+  return (static_cast<size_t>(1) << bits) + (sub_class + 1) * (static_cast<size_t>(1) << (bits - kClassesPerPow2Bits));
+}
+
+Status TensorBufferPool::Allocate(size_t n, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  int64_t size_class = kUnpooled;
+  size_t size = n;
+  if (n <= kMaxPooledSize) {
+    size_class = SizeClass(n);
+    size = ClassSize(static_cast<int>(size_class));
+    FreeList &list = free_lists_[size_class];
+    void *buffer = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(list.mux);
+      if (!list.buffers.empty()) {
+        buffer = list.buffers.back();
+        list.buffers.pop_back();
+      }
+    }
+    if (buffer != nullptr) {
+      bytes_in_pool_ -= size;
+      bytes_in_use_ += size;
+      ++hits_;
+      *p = buffer;
+      return Status::OK();
+    }
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(DeMalloc(size + kHeaderSize, &q, false));
+  auto *header = static_cast<BufferHeader *>(q);
+  header->size_class = size_class;
+  header->size = size;
+  bytes_in_use_ += size;
+  ++misses_;
+  *p = static_cast<char *>(q) + kHeaderSize;
+  return Status::OK();
+}
+
+void TensorBufferPool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  BufferHeader *header = HeaderOf(p);
+  uint64_t size = header->size;
+  bytes_in_use_ -= size;
+  if (header->size_class != kUnpooled) {
+    // reserve the room first, so concurrent frees can not take the pool above its capacity
+    uint64_t in_pool = bytes_in_pool_.fetch_add(size) + size;
+    if (in_pool <= capacity_) {
+      FreeList &list = free_lists_[header->size_class];
+      std::lock_guard<std::mutex> lock(list.mux);
+      list.buffers.push_back(p);
+      return;
+    }
+    bytes_in_pool_ -= size;
+  }
+  free(header);
+}
+
+Status TensorBufferPool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  if (*p != nullptr && new_sz <= HeaderOf(*p)->size) {
+    // the buffer is already large enough
+    return Status::OK();
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  if (*p != nullptr) {
+    if (old_sz > 0) {
+      errno_t err = memcpy_s(q, new_sz, *p, old_sz);
+      if (err != EOK) {
+        Deallocate(q);
+        RETURN_STATUS_UNEXPECTED("Failed to copy the buffer, error: " + std::to_string(err));
+      }
+    }
+    Deallocate(*p);
+  }
+  *p = q;
+  return Status::OK();
+}
+
+uint64_t TensorBufferPool::get_max_size() const { return std::numeric_limits<uint64_t>::max(); }
+
+int TensorBufferPool::PercentFree() const {
+  const int kHundredPercent = 100;
+  if (capacity_ == 0) {
+    return kHundredPercent;
+  }
+  uint64_t in_pool = std::min(bytes_in_pool_.load(), capacity_);
+  return static_cast<int>(kHundredPercent - in_pool * kHundredPercent / capacity_);
+}
+
+TensorBufferPool::Stats TensorBufferPool::GetStats() const {
+  Stats stats;
+  stats.hits = hits_.load();
+  stats.misses = misses_.load();
+  stats.bytes_in_pool = bytes_in_pool_.load();
+  stats.bytes_in_use = bytes_in_use_.load();
+  return stats;
+}
+
+void TensorBufferPool::Trim() {
+  for (size_t size_class = 0; size_class < free_lists_.size(); size_class++) {
+    FreeList &list = free_lists_[size_class];
+    std::vector<void *> buffers;
+    {
+      std::lock_guard<std::mutex> lock(list.mux);
+      buffers.swap(list.buffers);
+    }
+    for (void *p : buffers) {
+      bytes_in_pool_ -= HeaderOf(p)->size;
+      free(HeaderOf(p));
+    }
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
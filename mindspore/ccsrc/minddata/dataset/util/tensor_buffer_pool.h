@@ -0,0 +1,105 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_TENSOR_BUFFER_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_TENSOR_BUFFER_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "minddata/dataset/util/memory_pool.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// A memory pool recycling the data buffers of the tensors of one pipeline.
+//
+// Requests are rounded up to a size class, four classes per power of two so at most a quarter of a buffer
+// is wasted. A freed buffer is kept in the free list of its class, and the next request of the same class
+// takes it back instead of going to malloc. Rows of a pipeline mostly have the same shapes, so after the
+// first few rows almost every tensor reuses the buffer of a row which has died, e.g. the rows concatenated
+// by a BatchOp. Buffers above kMaxPooledSize, or freed while the pool already holds `capacity` bytes, are
+// returned to the system.
+//
+// The pool is thread safe: the buffers are allocated by the workers of the pipeline and freed by whichever
+// thread drops the last reference to the row.
+class TensorBufferPool : public MemoryPool {
+ public:
+  // Counters of the pool, sampled by the profiler.
+  struct Stats {
+    uint64_t hits = 0;           // allocations served from a free list
+    uint64_t misses = 0;         // allocations which went to the system
+    uint64_t bytes_in_pool = 0;  // bytes of the free buffers held by the pool
+    uint64_t bytes_in_use = 0;   // bytes of the buffers handed out and not freed yet
+  };
+
+  static constexpr size_t kMinPooledSize = 64;
+  static constexpr size_t kMaxPooledSize = 64 * 1024 * 1024;
+
+  // @param capacity - the maximum number of bytes of free buffers to keep.
+  explicit TensorBufferPool(uint64_t capacity);
+
+  // Frees the buffers of the free lists.
+  ~TensorBufferPool() override;
+
+  TensorBufferPool(const TensorBufferPool &) = delete;
+  TensorBufferPool &operator=(const TensorBufferPool &) = delete;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override;
+
+  // @return the percentage of the capacity not taken by free buffers.
+  int PercentFree() const override;
+
+  // @return a snapshot of the counters.
+  Stats GetStats() const;
+
+  // Frees all the buffers of the free lists.
+  void Trim();
+
+  // @return the maximum number of bytes of free buffers to keep.
+  uint64_t capacity() const { return capacity_; }
+
+  // Number of the size class a request of n bytes is rounded up to, n must not exceed kMaxPooledSize.
+  static int SizeClass(size_t n);
+
+  // Size of the buffers of a size class.
+  static size_t ClassSize(int size_class);
+
+ private:
+  struct FreeList {
+    std::mutex mux;
+    std::vector<void *> buffers;
+  };
+
+  uint64_t capacity_;
+  std::vector<FreeList> free_lists_;
+  std::atomic<uint64_t> hits_;
+  std::atomic<uint64_t> misses_;
+  std::atomic<uint64_t> bytes_in_pool_;
+  std::atomic<uint64_t> bytes_in_use_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_TENSOR_BUFFER_POOL_H_
@@ -186,7 +186,7 @@ void BindShardReader(const py::module *m) {
 
 void BindShardIndexGenerator(const py::module *m) {
   (void)py::class_<ShardIndexGenerator>(*m, "ShardIndexGenerator", py::module_local())
-    .def(py::init<const std::string &, bool>())
+    .def(py::init<const std::string &, bool, bool>())
     .def("build",
          [](ShardIndexGenerator &s) {
            THROW_IF_ERROR(s.Build());
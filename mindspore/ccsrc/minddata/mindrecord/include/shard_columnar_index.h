@@ -0,0 +1,160 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_mapped_file.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief suffix of the columnar index file written next to a mindrecord file
+const char kColumnarIndexSuffix[] = ".idx";
+
+/// \brief The fixed columns of the columnar index, they have the same meaning as the columns of the INDEXES table.
+enum ColumnarIndexColumn : int {
+  kIndexRowId = 0,
+  kIndexRowGroupId,
+  kIndexPageIdRaw,
+  kIndexPageOffsetRaw,
+  kIndexPageOffsetRawEnd,
+  kIndexPageIdBlob,
+  kIndexPageOffsetBlob,
+  kIndexPageOffsetBlobEnd,
+  kIndexFixedColumnCount
+};
+
+/// \brief Type of an index field, derived from the sql type the field would have in the INDEXES table.
+enum ColumnarIndexFieldType : uint64_t { kIndexInteger = 0, kIndexNumeric = 1, kIndexText = 2 };
+
+/// \brief A compact, read only index of one mindrecord file, used by ShardReader instead of the sqlite meta file.
+///
+/// The file is a header followed by one array per column, all of them aligned to 8 bytes so the file can be
+/// used in place once mapped:
+///   - header: magic, version, size of the indexed mindrecord file, number of rows, number of fields, shard name
+///             and the name and type of each index field
+///   - the fixed columns (ROW_ID, ROW_GROUP_ID, PAGE_ID_RAW, ...) as uint64 arrays, rows sorted by ROW_ID
+///   - for each index field its values (int64, double, or string offsets followed by the string bytes), and the
+///     row numbers sorted by value, which serve DISTINCT and equality lookups without a scan of the values
+class MINDRECORD_API ShardColumnarIndex {
+ public:
+  ~ShardColumnarIndex() = default;
+
+  /// \brief load the columnar index of a mindrecord file
+  /// \param[in] file_path path of the mindrecord file, the index is read from file_path + kColumnarIndexSuffix
+  /// \param[out] index the loaded index
+  /// \return Status the status of Status, an error if the index does not exist, is corrupted, or is stale
+  static Status Load(const std::string &file_path, std::shared_ptr<ShardColumnarIndex> *index);
+
+  /// \brief number of rows in the index
+  uint64_t NumRows() const { return num_rows_; }
+
+  /// \brief get a fixed column
+  /// \param[in] column the column
+  /// \return pointer to NumRows() values
+  const uint64_t *Column(ColumnarIndexColumn column) const { return fixed_columns_[column]; }
+
+  /// \brief get the id of an index field
+  /// \param[in] field_name the field name as generated by ShardIndexGenerator::GenerateFieldName
+  /// \return the id, -1 if the field is not in the index
+  int GetFieldId(const std::string &field_name) const;
+
+  /// \brief type of an index field
+  ColumnarIndexFieldType GetFieldType(int field_id) const { return fields_[field_id].type; }
+
+  /// \brief value of an integer field
+  int64_t GetInteger(int field_id, uint64_t row) const { return fields_[field_id].integers[row]; }
+
+  /// \brief value of a numeric field
+  double GetNumeric(int field_id, uint64_t row) const { return fields_[field_id].numerics[row]; }
+
+  /// \brief value of a text field
+  std::string GetText(int field_id, uint64_t row) const;
+
+  /// \brief value of a field formatted the way sqlite prints it
+  std::string GetValueString(int field_id, uint64_t row) const;
+
+  /// \brief convert the value of a field to json according to the type of the field in the schema
+  /// \param[in] field_id the field
+  /// \param[in] row the row
+  /// \param[in] schema_type type in the mindrecord schema, e.g. int32, float64, string
+  /// \return json value
+  json GetJsonValue(int field_id, uint64_t row, const std::string &schema_type) const;
+
+  /// \brief collect the distinct values of a field, formatted the way sqlite prints them
+  /// \param[in] field_id the field
+  /// \param[out] values the distinct values are inserted into the set
+  void GetDistinctValues(int field_id, std::set<std::string> *values) const;
+
+  /// \brief find the rows whose field equals to the value, the same as "WHERE field = value" in sql
+  /// \param[in] field_id the field
+  /// \param[in] value the value, converted according to the type of the field
+  /// \param[out] rows the rows in ascending order
+  void FindRows(int field_id, const std::string &value, std::vector<uint64_t> *rows) const;
+
+  /// \brief write the columnar index of a mindrecord file
+  /// \param[in] file_path path of the mindrecord file, the index is written to file_path + kColumnarIndexSuffix
+  /// \param[in] fields the index fields, pairs of field name and sql type
+  /// \param[in] rows the rows generated for the INDEXES table, in any order
+  /// \return Status the status of Status
+  static Status Write(const std::string &file_path, const std::vector<std::pair<std::string, std::string>> &fields,
+                      const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &rows);
+
+ private:
+  struct Field {
+    std::string name;
+    ColumnarIndexFieldType type = kIndexText;
+    const int64_t *integers = nullptr;
+    const double *numerics = nullptr;
+    const uint64_t *text_offsets = nullptr;
+    const char *text_data = nullptr;
+    const uint64_t *sorted_rows = nullptr;
+  };
+
+  ShardColumnarIndex() = default;
+
+  /// \brief check the header and locate every column in data_
+  Status Parse(const std::string &file_name, uint64_t file_size);
+
+  /// \brief compare the value of a field in a row with a value
+  /// \return negative, zero or positive like strcmp
+  int CompareValue(const Field &field, uint64_t row, const std::string &text, int64_t integer, double numeric) const;
+
+  /// \brief whether two rows have the same value of a field
+  bool SameValue(const Field &field, uint64_t row_a, uint64_t row_b) const;
+
+  std::shared_ptr<ShardMappedFile> mapped_file_;
+  std::vector<uint8_t> buffer_;  // used when mmap is not available
+  const uint8_t *data_ = nullptr;
+  uint64_t size_ = 0;
+  uint64_t num_rows_ = 0;
+  const uint64_t *fixed_columns_[kIndexFixedColumnCount] = {nullptr};
+  std::vector<Field> fields_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_COLUMNAR_INDEX_H_
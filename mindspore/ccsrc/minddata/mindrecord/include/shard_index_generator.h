@@ -34,7 +34,11 @@ using INDEX_FIELDS = std::vector<std::tuple<std::string, std::string, std::strin
 using ROW_DATA = std::vector<std::vector<std::tuple<std::string, std::string, std::string>>>;
 class MINDRECORD_API ShardIndexGenerator {
  public:
-  explicit ShardIndexGenerator(const std::string &file_path, bool append = false);
+  /// \brief constructor
+  /// \param[in] file_path path of one of the mindrecord files
+  /// \param[in] append whether the mindrecord files are opened for appending
+  /// \param[in] columnar_index whether to write a columnar index next to each file besides the sqlite meta file
+  explicit ShardIndexGenerator(const std::string &file_path, bool append = false, bool columnar_index = false);
 
   Status Build();
 
@@ -58,7 +62,7 @@ class MINDRECORD_API ShardIndexGenerator {
   /// \brief create databases for indexes
   Status WriteToDatabase();
 
-  static Status Finalize(const std::vector<std::string> file_names);
+  static Status Finalize(const std::vector<std::string> file_names, bool columnar_index = false);
 
  private:
   static int Callback(void *not_used, int argc, char **argv, char **az_col_name);
@@ -110,6 +114,7 @@ class MINDRECORD_API ShardIndexGenerator {
 
   std::string file_path_;
   bool append_;
+  bool columnar_index_;
   ShardHeader shard_header_;
   uint64_t page_size_;
   uint64_t header_size_;
@@ -117,6 +122,7 @@ class MINDRECORD_API ShardIndexGenerator {
   std::atomic_int task_;
   std::atomic_bool write_success_;
   std::vector<std::pair<uint64_t, std::string>> fields_;
+  std::vector<std::pair<std::string, std::string>> columnar_index_fields_;  // pair of field name and sql type
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief A read only view of a whole mindrecord file, backed by mmap.
+///
+/// The mapping is read only, a consumer that needs to modify a blob copies it first (a dataset Tensor
+/// borrowing a blob does it on its first mutable access). The mapping lives as long as the last
+/// shared_ptr to it, which is how blobs handed out by ShardReader keep their pages valid.
+class MINDRECORD_API ShardMappedFile {
+ public:
+  ~ShardMappedFile();
+
+  ShardMappedFile(const ShardMappedFile &) = delete;
+  ShardMappedFile &operator=(const ShardMappedFile &) = delete;
+
+  /// \brief map a file into memory
+  /// \param[in] file_path path of the file
+  /// \param[out] mapped_file the mapped file
+  /// \return Status the status of Status, an error if mmap is not supported on this platform
+  static Status Open(const std::string &file_path, std::shared_ptr<ShardMappedFile> *mapped_file);
+
+  /// \brief start address of the mapping
+  const uint8_t *Data() const { return data_; }
+
+  /// \brief size of the mapping in bytes
+  uint64_t Size() const { return size_; }
+
+ private:
+  ShardMappedFile(uint8_t *data, uint64_t size) : data_(data), size_(size) {}
+
+  uint8_t *data_;
+  uint64_t size_;
+};
+
+/// \brief A blob borrowed from a mapped file.
+///
+/// data aliases the owning ShardMappedFile, so copying the view only bumps a reference count.
+struct ShardBlobView {
+  std::shared_ptr<const uint8_t> data;
+  uint64_t size = 0;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
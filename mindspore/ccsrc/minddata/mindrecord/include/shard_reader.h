@@ -44,9 +44,11 @@
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_mapped_file.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
 #include "minddata/mindrecord/include/shard_reader.h"
@@ -175,6 +177,17 @@ class MINDRECORD_API ShardReader {
   /// \brief return a row by id
   /// \return a batch of images and image data
   TASK_CONTENT GetNextById(const int64_t &task_id, const int32_t &consumer_id);
+
+  /// \brief return a row by id without copying its blob out of the mapped file
+  /// \param[in] task_id id of the task
+  /// \param[in] consumer_id id of the consumer, selects the file stream if the files are not mapped
+  /// \param[out] task_type type of the task, the blob of a padded task is empty
+  /// \param[out] blob blob of the row, it keeps the mapped file alive as long as it is referenced
+  /// \param[out] var_fields scalar variable fields of the row
+  /// \return Status the status of Status
+  Status GetNextViewById(const int64_t &task_id, const int32_t &consumer_id, TaskType *task_type,
+                         ShardBlobView *blob, json *var_fields);
+
   /// \brief  get blob filed list
   /// \return blob field list
   std::pair<ShardType, std::vector<std::string>> GetBlobFields();
@@ -187,11 +200,23 @@ class MINDRECORD_API ShardReader {
   /// \return null
   void SetAllInIndex(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief read blobs from memory mapped files instead of file streams, must be set before Open
+  /// \return null
+  void SetUseMmap(bool use_mmap) { use_mmap_ = use_mmap; }
+
+  /// \brief check if blobs are read from memory mapped files
+  bool UseMmap() const { return !mapped_files_.empty(); }
+
   /// \brief get all classes
   Status GetAllClasses(const std::string &category_field, std::shared_ptr<std::set<std::string>> category_ptr);
 
-  /// \brief get a read-only ptr to the sampled ids for this epoch
-  const std::vector<int64_t> *GetSampleIds();
+  /// \brief get the number of sampled ids for this epoch
+  int64_t GetSampleCount() const;
+
+  /// \brief get a sampled id for this epoch
+  /// \param[in] pos position of the id, less than GetSampleCount()
+  /// \return the id of the task at the position
+  int64_t GetSampleId(int64_t pos);
 
   /// \brief get the size of blob data
   Status GetTotalBlobSize(int64_t *total_blob_size);
@@ -204,6 +229,9 @@ class MINDRECORD_API ShardReader {
   /// \brief sqlite call back function
   static int SelectCallback(void *p_data, int num_fields, char **p_fields, char **p_col_names);
 
+  /// \brief open the meta files of the shards which are read through their columnar index
+  Status OpenAllDatabases();
+
  private:
   /// \brief wrap up labels to json format
   Status ConvertLabelToJson(const std::vector<std::vector<std::string>> &labels, std::shared_ptr<std::fstream> fs,
@@ -227,6 +255,30 @@ class MINDRECORD_API ShardReader {
                             std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
                             std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
 
+  /// \brief read rows in one shard from its columnar index, all the rows if row_id is negative
+  Status ReadRowsInColumnarIndex(int shard_id, int64_t row_id, const std::vector<std::string> &columns,
+                                 std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
+                                 std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr);
+
+  /// \brief read the label of a row from raw data page and keep the specified columns
+  Status ReadRawLabel(const std::shared_ptr<std::fstream> &fs, uint64_t raw_page_id, uint64_t label_start,
+                      uint64_t label_end, const std::vector<std::string> &columns, json *label);
+
+  /// \brief load the columnar index of every shard in parallel, nullptr for the shards without a valid one
+  void LoadColumnarIndexes(std::vector<std::shared_ptr<ShardColumnarIndex>> *indexes);
+
+  /// \brief get the id of a column in the columnar index of a shard
+  Status GetColumnarIndexFieldId(int shard_id, const std::string &column, int *field_id);
+
+  /// \brief find the rows of a blob page which match the criteria in the columnar index, any page if page_id < 0
+  Status FindRowsInColumnarIndex(int shard_id, int page_id, const std::pair<std::string, std::string> &criteria,
+                                 std::vector<uint64_t> *rows);
+
+  /// \brief get column values from the columnar index
+  Status GetLabelsFromColumnarIndex(int page_id, int shard_id, const std::vector<std::string> &columns,
+                                    const std::pair<std::string, std::string> &criteria,
+                                    std::shared_ptr<std::vector<json>> *labels_ptr);
+
   /// \brief initialize reader
   Status Init(const std::vector<std::string> &file_paths, bool load_dataset);
 
@@ -282,6 +334,16 @@ class MINDRECORD_API ShardReader {
   /// \brief read one row by one task
   Status ConsumerOneTask(int64_t task_id, uint32_t consumer_id, std::shared_ptr<TASK_CONTENT> *task_content_pt);
 
+  /// \brief locate the blob of one task in its shard file
+  Status GetTaskBlobLocation(int64_t task_id, TaskType *task_type, uint32_t *shard_id, uint64_t *file_offset,
+                             uint64_t *blob_size, json *var_fields);
+
+  /// \brief copy blob_size bytes at file_offset of a shard file to dst
+  Status ReadBlob(uint32_t consumer_id, uint32_t shard_id, uint64_t file_offset, uint64_t blob_size, uint8_t *dst);
+
+  /// \brief map all the shard files, falls back to file streams on failure
+  void MapFiles();
+
   /// \brief get labels from binary file
   Status GetLabelsFromBinaryFile(int shard_id, const std::vector<std::string> &columns,
                                  const std::vector<std::vector<std::string>> &label_offsets,
@@ -291,6 +353,10 @@ class MINDRECORD_API ShardReader {
   void GetClassesInShard(sqlite3 *db, int shard_id, const std::string &sql,
                          std::shared_ptr<std::set<std::string>> category_ptr);
 
+  /// \brief get classes in one shard from its columnar index
+  void GetClassesInColumnarIndex(int shard_id, const std::string &field_name,
+                                 std::shared_ptr<std::set<std::string>> category_ptr);
+
   /// \brief get number of classes
   int64_t GetNumClasses(const std::string &category_field);
 
@@ -306,9 +372,11 @@ class MINDRECORD_API ShardReader {
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardColumnarIndex>> column_indexes_;              // columnar index list, one per shard
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::shared_ptr<ShardMappedFile>> mapped_files_;                   // mapped file list, one per shard
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -321,6 +389,7 @@ class MINDRECORD_API ShardReader {
   // flags
   bool all_in_index_ = true;  // if all columns are stored in index-table
   bool interrupt_ = false;    // reader interrupted
+  bool use_mmap_ = false;     // read blobs from memory mapped files
 
   int64_t num_padded_;  // number of padding samples
 
@@ -45,6 +45,9 @@ class MINDRECORD_API ShardShuffle : public ShardOperator {
   // Shuffle the file sequence but keep the order of data within each file
   Status ShuffleFiles(ShardTaskList &tasks);  // NOLINT
 
+  // Shuffle the blocks of all the files, then the data within windows of blocks, see ShardShuffleOrder
+  Status ShufflePartial(ShardTaskList &tasks);  // NOLINT
+
   uint32_t shuffle_seed_;
   int64_t no_of_samples_;
   bool replacement_;
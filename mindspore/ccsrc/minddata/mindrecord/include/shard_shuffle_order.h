@@ -0,0 +1,98 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_SHUFFLE_ORDER_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_SHUFFLE_ORDER_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "minddata/mindrecord/include/mindrecord_macro.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief The order of the tasks produced by the partial shuffle, computed on demand instead of kept in a
+/// permutation of all the tasks.
+///
+/// The tasks of each shard are cut into blocks of consecutive tasks, the padded tasks making a shard of their own.
+///   - level 1: the blocks of all the shards are permuted
+///   - level 2: the permuted blocks are taken window by window, and the tasks of a window are permuted together
+/// Only the block list and the permutations of the few windows read last are held in memory. The order is a function of the seed
+/// alone, so it is the same across runs and whatever the number of workers reading it. The shuffles are done with
+/// a portable generator rather than std::shuffle, whose result depends on the standard library.
+class MINDRECORD_API ShardShuffleOrder {
+ public:
+  /// \brief number of consecutive tasks of a block
+  static constexpr int64_t kBlockTasks = 1024;
+  /// \brief number of blocks interleaved by a window
+  static constexpr int64_t kWindowBlocks = 64;
+  /// \brief number of window permutations kept, so the workers reading on both sides of a window boundary do not
+  /// reload the windows in turn
+  static constexpr size_t kCachedWindows = 4;
+
+  /// \brief build the order of the tasks
+  /// \param[in] shard_sample_count number of tasks up to the end of each shard, as kept by ShardOperator
+  /// \param[in] num_tasks total number of tasks, those after the last shard are padded tasks
+  /// \param[in] seed the seed of both levels
+  /// \param[in] block_tasks number of consecutive tasks of a block
+  /// \param[in] window_blocks number of blocks interleaved by a window
+  ShardShuffleOrder(const std::vector<int64_t> &shard_sample_count, int64_t num_tasks, uint32_t seed,
+                    int64_t block_tasks = kBlockTasks, int64_t window_blocks = kWindowBlocks);
+
+  ~ShardShuffleOrder() = default;
+
+  /// \brief take a range of the order, wrapping around at its end, the same as ShardSample does with a permutation
+  /// \param[in] start position of the first task of the range
+  /// \param[in] count number of tasks of the range
+  /// \return the order of the range
+  std::shared_ptr<ShardShuffleOrder> Slice(int64_t start, int64_t count) const;
+
+  /// \brief number of tasks of the order
+  int64_t Size() const { return ranges_.empty() ? num_tasks_ : ranges_.back().second; }
+
+  /// \brief get the task at a position of the order, sequential positions are the cheapest
+  /// \param[in] pos the position, less than Size()
+  /// \return the task id
+  int64_t Get(int64_t pos);
+
+ private:
+  ShardShuffleOrder(const ShardShuffleOrder &other);
+
+  /// \brief compute the permuted tasks of a window
+  std::shared_ptr<std::vector<int64_t>> LoadWindow(int64_t window) const;
+
+  uint32_t seed_;
+  int64_t num_tasks_;
+  // the permuted blocks, as the first task and the number of tasks of each
+  std::vector<int64_t> block_start_;
+  std::vector<int64_t> block_size_;
+  int64_t window_blocks_;
+  // position of the first task of each window, with the total number of tasks at the end
+  std::vector<int64_t> window_offset_;
+  // the slices taken, as the start and the number of tasks of each, relative to the previous one
+  std::vector<std::pair<int64_t, int64_t>> ranges_;
+  // the windows last read by Get, the most recent first
+  std::mutex mutex_;
+  std::list<std::pair<int64_t, std::shared_ptr<std::vector<int64_t>>>> windows_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_SHUFFLE_ORDER_H_
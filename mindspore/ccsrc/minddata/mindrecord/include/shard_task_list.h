@@ -19,12 +19,14 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
 #include "minddata/mindrecord/include/common/shard_utils.h"
 #include "minddata/mindrecord/include/mindrecord_macro.h"
+#include "minddata/mindrecord/include/shard_shuffle_order.h"
 
 namespace mindspore {
 namespace mindrecord {
@@ -78,6 +80,9 @@ class MINDRECORD_API ShardTaskList {
 
   int64_t GetTaskSampleByID(int64_t id);
 
+  // The number of sampled ids, those of shuffle_order_ when it is set
+  int64_t SampleCount() const;
+
   int64_t GetRandomTaskID();
 
   static ShardTaskList Combine(std::vector<ShardTaskList> &category_tasks, bool replacement,  // NOLINT
@@ -91,6 +96,9 @@ class MINDRECORD_API ShardTaskList {
 
   std::vector<int64_t> sample_ids_;  // The list of actual ids that were sampled
 
+  // The sampled ids computed on demand by the partial shuffle, sample_ids_ and permutation_ are empty when it is set
+  std::shared_ptr<ShardShuffleOrder> shuffle_order_;
+
   std::vector<ShardTask> task_list_;  // The full list of tasks
 };
 
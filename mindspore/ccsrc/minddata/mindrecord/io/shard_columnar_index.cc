@@ -0,0 +1,482 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_columnar_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <unordered_map>
+
+#include "minddata/mindrecord/include/shard_error.h"
+#include "utils/file_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const char kColumnarIndexMagic[] = "MRCOLIDX";
+const uint64_t kColumnarIndexVersion = 1;
+const char *const kFixedColumnPlaceholders[kIndexFixedColumnCount] = {
+  ":ROW_ID",          ":ROW_GROUP_ID", ":PAGE_ID_RAW",      ":PAGE_OFFSET_RAW",
+  ":PAGE_OFFSET_RAW_END", ":PAGE_ID_BLOB", ":PAGE_OFFSET_BLOB", ":PAGE_OFFSET_BLOB_END"};
+
+uint64_t AlignUp(uint64_t size) { return (size + kInt64Len - 1) / kInt64Len * kInt64Len; }
+
+void AppendU64(std::vector<uint8_t> *out, uint64_t value) {
+  auto p = reinterpret_cast<const uint8_t *>(&value);
+  out->insert(out->end(), p, p + sizeof(value));
+}
+
+void AppendBytes(std::vector<uint8_t> *out, const void *data, uint64_t size) {
+  auto p = static_cast<const uint8_t *>(data);
+  out->insert(out->end(), p, p + size);
+  out->resize(out->size() + AlignUp(size) - size, 0);
+}
+
+void AppendString(std::vector<uint8_t> *out, const std::string &str) {
+  AppendU64(out, str.size());
+  AppendBytes(out, str.data(), str.size());
+}
+
+ColumnarIndexFieldType ConvertSQLType(const std::string &sql_type) {
+  if (sql_type == "INTEGER") {
+    return kIndexInteger;
+  } else if (sql_type == "NUMERIC") {
+    return kIndexNumeric;
+  }
+  return kIndexText;
+}
+
+// Format a double the way sqlite does ("%!.15g"), so category values read from either index look the same.
+std::string FormatNumeric(double value) {
+  const int kBufferSize = 32;
+  char buffer[kBufferSize] = {0};
+  (void)snprintf(buffer, kBufferSize, "%.15g", value);
+  std::string str(buffer);
+  if (std::isfinite(value) && str.find_first_of(".e") == std::string::npos) {
+    str += ".0";
+  }
+  return str;
+}
+
+// Cursor over the bytes of an index file, every read is bounds checked.
+class IndexCursor {
+ public:
+  IndexCursor(const uint8_t *data, uint64_t size) : data_(data), size_(size), pos_(0) {}
+
+  bool ReadU64(uint64_t *value) {
+    if (size_ - pos_ < kInt64Len) {
+      return false;
+    }
+    (void)memcpy(value, data_ + pos_, kInt64Len);
+    pos_ += kInt64Len;
+    return true;
+  }
+
+  // Take `count` elements of `elem_size` bytes, the cursor moves to the next 8 bytes boundary.
+  bool Take(uint64_t count, uint64_t elem_size, const uint8_t **ptr) {
+    if (elem_size != 0 && count > (size_ - pos_) / elem_size) {
+      return false;
+    }
+    uint64_t bytes = AlignUp(count * elem_size);
+    if (bytes > size_ - pos_) {
+      return false;
+    }
+    *ptr = data_ + pos_;
+    pos_ += bytes;
+    return true;
+  }
+
+  bool ReadString(std::string *str) {
+    uint64_t len = 0;
+    const uint8_t *ptr = nullptr;
+    if (!ReadU64(&len) || !Take(len, 1, &ptr)) {
+      return false;
+    }
+    str->assign(reinterpret_cast<const char *>(ptr), len);
+    return true;
+  }
+
+  bool AtEnd() const { return pos_ == size_; }
+
+ private:
+  const uint8_t *data_;
+  uint64_t size_;
+  uint64_t pos_;
+};
+}  // namespace
+
+Status ShardColumnarIndex::Load(const std::string &file_path, std::shared_ptr<ShardColumnarIndex> *index) {
+  RETURN_UNEXPECTED_IF_NULL_MR(index);
+  std::string index_path = file_path + kColumnarIndexSuffix;
+  auto realpath = FileUtils::GetRealPath(index_path.c_str());
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(realpath.has_value(), "Invalid file, columnar index: " + index_path + " not exist.");
+
+  std::ifstream data_file(file_path, std::ios::in | std::ios::binary | std::ios::ate);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(data_file.good(), "Invalid file, failed to open mindrecord file: " + file_path);
+  auto file_size = static_cast<uint64_t>(data_file.tellg());
+  data_file.close();
+
+  std::shared_ptr<ShardColumnarIndex> result(new ShardColumnarIndex());
+  if (ShardMappedFile::Open(realpath.value(), &result->mapped_file_).IsOk()) {
+    result->data_ = result->mapped_file_->Data();
+    result->size_ = result->mapped_file_->Size();
+  } else {
+    std::ifstream fin(realpath.value(), std::ios::in | std::ios::binary | std::ios::ate);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(fin.good(), "Invalid file, failed to open columnar index: " + index_path);
+    auto size = static_cast<uint64_t>(fin.tellg());
+    result->buffer_.resize(size);
+    (void)fin.seekg(0, std::ios::beg);
+    auto &io_read = fin.read(reinterpret_cast<char *>(result->buffer_.data()), size);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(io_read.good(), "Invalid file, failed to read columnar index: " + index_path);
+    result->data_ = result->buffer_.data();
+    result->size_ = size;
+  }
+
+  std::shared_ptr<std::string> fn_ptr;
+  RETURN_IF_NOT_OK_MR(GetFileName(file_path, &fn_ptr));
+  RETURN_IF_NOT_OK_MR(result->Parse(*fn_ptr, file_size));
+  *index = result;
+  return Status::OK();
+}
+
+Status ShardColumnarIndex::Parse(const std::string &file_name, uint64_t file_size) {
+  IndexCursor cursor(data_, size_);
+  const uint8_t *magic = nullptr;
+  uint64_t version = 0;
+  uint64_t indexed_file_size = 0;
+  uint64_t num_fields = 0;
+  std::string shard_name;
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(cursor.Take(kInt64Len, 1, &magic) &&
+                                    memcmp(magic, kColumnarIndexMagic, kInt64Len) == 0 && cursor.ReadU64(&version) &&
+                                    version == kColumnarIndexVersion,
+                                  "Invalid file, the header of columnar index of " + file_name + " is invalid.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(cursor.ReadU64(&indexed_file_size) && cursor.ReadU64(&num_rows_) &&
+                                    cursor.ReadU64(&num_fields) && cursor.ReadString(&shard_name),
+                                  "Invalid file, the header of columnar index of " + file_name + " is truncated.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_name == file_name,
+                                  "Invalid file, columnar index is built for: " + shard_name + ", not: " + file_name);
+  // the mindrecord file is changed after the index is written, e.g. appended without index
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(indexed_file_size == file_size,
+                                  "Invalid file, columnar index of " + file_name + " is stale.");
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(num_fields <= kMaxFieldCount,
+                                  "Invalid file, the number of fields in columnar index of " + file_name +
+                                    " exceeds " + std::to_string(kMaxFieldCount) + ".");
+  fields_.resize(num_fields);
+  for (auto &field : fields_) {
+    uint64_t type = 0;
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(
+      cursor.ReadU64(&type) && type <= kIndexText && cursor.ReadString(&field.name),
+      "Invalid file, the field description in columnar index of " + file_name + " is invalid.");
+    field.type = static_cast<ColumnarIndexFieldType>(type);
+  }
+
+  const uint8_t *ptr = nullptr;
+  for (int i = 0; i < kIndexFixedColumnCount; ++i) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(cursor.Take(num_rows_, kInt64Len, &ptr),
+                                    "Invalid file, columnar index of " + file_name + " is truncated.");
+    fixed_columns_[i] = reinterpret_cast<const uint64_t *>(ptr);
+  }
+  for (auto &field : fields_) {
+    bool ok = true;
+    if (field.type == kIndexInteger) {
+      ok = cursor.Take(num_rows_, kInt64Len, &ptr);
+      field.integers = reinterpret_cast<const int64_t *>(ptr);
+    } else if (field.type == kIndexNumeric) {
+      ok = cursor.Take(num_rows_, kInt64Len, &ptr);
+      field.numerics = reinterpret_cast<const double *>(ptr);
+    } else {
+      ok = cursor.Take(num_rows_ + 1, kInt64Len, &ptr);
+      if (ok) {
+        field.text_offsets = reinterpret_cast<const uint64_t *>(ptr);
+        ok = cursor.Take(field.text_offsets[num_rows_], 1, &ptr);
+        field.text_data = reinterpret_cast<const char *>(ptr);
+        for (uint64_t row = 0; ok && row < num_rows_; ++row) {
+          ok = field.text_offsets[row] <= field.text_offsets[row + 1];
+        }
+      }
+    }
+    ok = ok && cursor.Take(num_rows_, kInt64Len, &ptr);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(ok, "Invalid file, columnar index of " + file_name + " is truncated.");
+    field.sorted_rows = reinterpret_cast<const uint64_t *>(ptr);
+    for (uint64_t i = 0; i < num_rows_; ++i) {
+      CHECK_FAIL_RETURN_UNEXPECTED_MR(field.sorted_rows[i] < num_rows_,
+                                      "Invalid file, columnar index of " + file_name + " is corrupted.");
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(cursor.AtEnd(), "Invalid file, columnar index of " + file_name + " is corrupted.");
+  return Status::OK();
+}
+
+int ShardColumnarIndex::GetFieldId(const std::string &field_name) const {
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    if (fields_[i].name == field_name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+std::string ShardColumnarIndex::GetText(int field_id, uint64_t row) const {
+  const auto &field = fields_[field_id];
+  return std::string(field.text_data + field.text_offsets[row], field.text_offsets[row + 1] - field.text_offsets[row]);
+}
+
+std::string ShardColumnarIndex::GetValueString(int field_id, uint64_t row) const {
+  const auto &field = fields_[field_id];
+  if (field.type == kIndexInteger) {
+    return std::to_string(field.integers[row]);
+  } else if (field.type == kIndexNumeric) {
+    return FormatNumeric(field.numerics[row]);
+  }
+  return GetText(field_id, row);
+}
+
+json ShardColumnarIndex::GetJsonValue(int field_id, uint64_t row, const std::string &schema_type) const {
+  const auto &field = fields_[field_id];
+  if (field.type == kIndexText) {
+    return GetText(field_id, row);
+  }
+  double numeric = field.type == kIndexInteger ? static_cast<double>(field.integers[row]) : field.numerics[row];
+  int64_t integer = field.type == kIndexInteger ? field.integers[row] : static_cast<int64_t>(field.numerics[row]);
+  if (schema_type == "int32") {
+    return static_cast<int32_t>(integer);
+  } else if (schema_type == "int64") {
+    return integer;
+  } else if (schema_type == "float32") {
+    return static_cast<float>(numeric);
+  } else if (schema_type == "float64") {
+    return numeric;
+  }
+  return GetValueString(field_id, row);
+}
+
+void ShardColumnarIndex::GetDistinctValues(int field_id, std::set<std::string> *values) const {
+  const auto &field = fields_[field_id];
+  for (uint64_t i = 0; i < num_rows_; ++i) {
+    // rows are sorted by value, only the first row of each run is new
+    if (i == 0 || !SameValue(field, field.sorted_rows[i - 1], field.sorted_rows[i])) {
+      (void)values->emplace(GetValueString(field_id, field.sorted_rows[i]));
+    }
+  }
+}
+
+bool ShardColumnarIndex::SameValue(const Field &field, uint64_t row_a, uint64_t row_b) const {
+  if (field.type == kIndexInteger) {
+    return field.integers[row_a] == field.integers[row_b];
+  } else if (field.type == kIndexNumeric) {
+    return field.numerics[row_a] == field.numerics[row_b];
+  }
+  uint64_t len = field.text_offsets[row_a + 1] - field.text_offsets[row_a];
+  return len == field.text_offsets[row_b + 1] - field.text_offsets[row_b] &&
+         memcmp(field.text_data + field.text_offsets[row_a], field.text_data + field.text_offsets[row_b], len) == 0;
+}
+
+int ShardColumnarIndex::CompareValue(const Field &field, uint64_t row, const std::string &text, int64_t integer,
+                                     double numeric) const {
+  if (field.type == kIndexInteger) {
+    return field.integers[row] < integer ? -1 : (field.integers[row] > integer ? 1 : 0);
+  } else if (field.type == kIndexNumeric) {
+    return field.numerics[row] < numeric ? -1 : (field.numerics[row] > numeric ? 1 : 0);
+  }
+  uint64_t len = field.text_offsets[row + 1] - field.text_offsets[row];
+  int ret = memcmp(field.text_data + field.text_offsets[row], text.data(), std::min<uint64_t>(len, text.size()));
+  if (ret != 0) {
+    return ret;
+  }
+  return len < text.size() ? -1 : (len > text.size() ? 1 : 0);
+}
+
+void ShardColumnarIndex::FindRows(int field_id, const std::string &value, std::vector<uint64_t> *rows) const {
+  const auto &field = fields_[field_id];
+  int64_t integer = 0;
+  double numeric = 0;
+  try {
+    if (field.type == kIndexInteger) {
+      size_t pos = 0;
+      integer = std::stoll(value, &pos);
+      if (pos != value.size()) {
+        return;
+      }
+    } else if (field.type == kIndexNumeric) {
+      numeric = std::stod(value);
+    }
+  } catch (...) {
+    // a value which is not a number never equals to a number
+    return;
+  }
+  const uint64_t *begin = field.sorted_rows;
+  const uint64_t *end = field.sorted_rows + num_rows_;
+  auto lower = std::lower_bound(begin, end, 0, [&](uint64_t row, int) {
+    return CompareValue(field, row, value, integer, numeric) < 0;
+  });
+  auto upper = std::upper_bound(lower, end, 0, [&](int, uint64_t row) {
+    return CompareValue(field, row, value, integer, numeric) > 0;
+  });
+  rows->assign(lower, upper);
+  std::sort(rows->begin(), rows->end());
+}
+
+Status ShardColumnarIndex::Write(
+  const std::string &file_path, const std::vector<std::pair<std::string, std::string>> &fields,
+  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &rows) {
+  // placeholder in the rows -> column, the fixed columns come first
+  std::unordered_map<std::string, size_t> columns;
+  for (int i = 0; i < kIndexFixedColumnCount; ++i) {
+    columns[kFixedColumnPlaceholders[i]] = static_cast<size_t>(i);
+  }
+  for (size_t i = 0; i < fields.size(); ++i) {
+    columns[":" + fields[i].first] = kIndexFixedColumnCount + i;
+  }
+
+  uint64_t num_rows = rows.size();
+  std::vector<std::vector<uint64_t>> fixed(kIndexFixedColumnCount, std::vector<uint64_t>(num_rows, 0));
+  std::vector<ColumnarIndexFieldType> types;
+  for (const auto &field : fields) {
+    types.push_back(ConvertSQLType(field.second));
+  }
+  std::vector<std::vector<int64_t>> integers(fields.size());
+  std::vector<std::vector<double>> numerics(fields.size());
+  std::vector<std::vector<std::string>> texts(fields.size());
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (types[i] == kIndexInteger) {
+      integers[i].resize(num_rows, 0);
+    } else if (types[i] == kIndexNumeric) {
+      numerics[i].resize(num_rows, 0);
+    } else {
+      texts[i].resize(num_rows);
+    }
+  }
+  for (uint64_t r = 0; r < num_rows; ++r) {
+    for (const auto &value : rows[r]) {
+      auto iter = columns.find(std::get<0>(value));
+      if (iter == columns.end()) {
+        continue;
+      }
+      const auto &str = std::get<2>(value);
+      try {
+        if (iter->second < kIndexFixedColumnCount) {
+          fixed[iter->second][r] = std::stoull(str);
+          continue;
+        }
+        auto f = iter->second - kIndexFixedColumnCount;
+        if (types[f] == kIndexInteger) {
+          integers[f][r] = std::stoll(str);
+        } else if (types[f] == kIndexNumeric) {
+          numerics[f][r] = std::stod(str);
+        } else {
+          texts[f][r] = str;
+        }
+      } catch (...) {
+        RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to convert value: " + str + " of " +
+                                    std::get<0>(value) + " for columnar index.");
+      }
+    }
+  }
+
+  // rows are stored in ROW_ID order, the same as "ORDER BY ROW_ID"
+  std::vector<uint64_t> order(num_rows);
+  std::iota(order.begin(), order.end(), 0);
+  const auto &row_ids = fixed[kIndexRowId];
+  std::sort(order.begin(), order.end(), [&row_ids](uint64_t a, uint64_t b) { return row_ids[a] < row_ids[b]; });
+
+  std::shared_ptr<std::string> fn_ptr;
+  RETURN_IF_NOT_OK_MR(GetFileName(file_path, &fn_ptr));
+  std::ifstream data_file(file_path, std::ios::in | std::ios::binary | std::ios::ate);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(data_file.good(), "Invalid file, failed to open mindrecord file: " + file_path);
+  auto file_size = static_cast<uint64_t>(data_file.tellg());
+  data_file.close();
+
+  std::vector<uint8_t> out;
+  AppendBytes(&out, kColumnarIndexMagic, kInt64Len);
+  AppendU64(&out, kColumnarIndexVersion);
+  AppendU64(&out, file_size);
+  AppendU64(&out, num_rows);
+  AppendU64(&out, fields.size());
+  AppendString(&out, *fn_ptr);
+  for (size_t i = 0; i < fields.size(); ++i) {
+    AppendU64(&out, types[i]);
+    AppendString(&out, fields[i].first);
+  }
+  for (const auto &column : fixed) {
+    for (auto r : order) {
+      AppendU64(&out, column[r]);
+    }
+  }
+  std::vector<uint64_t> sorted_rows(num_rows);
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (types[i] == kIndexInteger) {
+      for (auto r : order) {
+        AppendBytes(&out, &integers[i][r], kInt64Len);
+      }
+    } else if (types[i] == kIndexNumeric) {
+      for (auto r : order) {
+        AppendBytes(&out, &numerics[i][r], kInt64Len);
+      }
+    } else {
+      uint64_t offset = 0;
+      AppendU64(&out, offset);
+      for (auto r : order) {
+        offset += texts[i][r].size();
+        AppendU64(&out, offset);
+      }
+      std::string text_data;
+      text_data.reserve(offset);
+      for (auto r : order) {
+        text_data += texts[i][r];
+      }
+      AppendBytes(&out, text_data.data(), text_data.size());
+    }
+    // row numbers (in ROW_ID order) sorted by value
+    std::iota(sorted_rows.begin(), sorted_rows.end(), 0);
+    std::stable_sort(sorted_rows.begin(), sorted_rows.end(), [&](uint64_t a, uint64_t b) {
+      if (types[i] == kIndexInteger) {
+        return integers[i][order[a]] < integers[i][order[b]];
+      } else if (types[i] == kIndexNumeric) {
+        return numerics[i][order[a]] < numerics[i][order[b]];
+      }
+      return texts[i][order[a]] < texts[i][order[b]];
+    });
+    for (auto r : sorted_rows) {
+      AppendU64(&out, r);
+    }
+  }
+
+  // write to a temporary file first, a reader never sees a partially written index
+  std::string index_path = file_path + kColumnarIndexSuffix;
+  std::string tmp_path = index_path + ".tmp";
+  std::ofstream fout(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fout.good(), "Invalid file, failed to open columnar index for writing: " + tmp_path +
+                                                 ". Please check file path and permission.");
+  auto &io_write = fout.write(reinterpret_cast<const char *>(out.data()), static_cast<std::streamsize>(out.size()));
+  if (!io_write.good()) {
+    fout.close();
+    (void)std::remove(tmp_path.c_str());
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to write columnar index: " + tmp_path);
+  }
+  fout.close();
+  if (std::rename(tmp_path.c_str(), index_path.c_str()) != 0) {
+    (void)std::remove(tmp_path.c_str());
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to rename columnar index to: " + index_path);
+  }
+  MS_LOG(INFO) << "Write columnar index of " << num_rows << " rows to: " << index_path;
+  return Status::OK();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
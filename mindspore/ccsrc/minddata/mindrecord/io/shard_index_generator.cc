@@ -15,14 +15,18 @@
  */
 #include "minddata/mindrecord/include/shard_index_generator.h"
 
+#include <cstdio>
+
+#include "minddata/mindrecord/include/shard_columnar_index.h"
 #include "utils/file_utils.h"
 #include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace mindrecord {
-ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool append)
+ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool append, bool columnar_index)
     : file_path_(file_path),
       append_(append),
+      columnar_index_(columnar_index),
       page_size_(0),
       header_size_(0),
       schema_count_(0),
@@ -511,6 +515,7 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
       "-a): " +
       shard_address);
   }
+  ROW_DATA all_rows;
   (void)sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
   for (int raw_page_id : raw_page_ids) {
     std::shared_ptr<std::string> sql_ptr;
@@ -520,6 +525,10 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
                                     in);
     RELEASE_AND_RETURN_IF_NOT_OK_MR(BindParameterExecuteSQL(db, *sql_ptr, *row_data_ptr), db, in);
     MS_LOG(INFO) << "Insert " << row_data_ptr->size() << " rows to index db.";
+    if (columnar_index_) {
+      (void)all_rows.insert(all_rows.end(), std::make_move_iterator(row_data_ptr->begin()),
+                            std::make_move_iterator(row_data_ptr->end()));
+    }
   }
   (void)sqlite3_exec(db, "END TRANSACTION;", nullptr, nullptr, nullptr);
   in.close();
@@ -527,6 +536,13 @@ Status ShardIndexGenerator::ExecuteTransaction(const int &shard_no, sqlite3 *db,
   // Close database
   sqlite3_close(db);
   db = nullptr;
+
+  if (columnar_index_) {
+    RETURN_IF_NOT_OK_MR(ShardColumnarIndex::Write(shard_address, columnar_index_fields_, all_rows));
+  } else {
+    // an index left by a previous write does not match the data any more
+    (void)std::remove((shard_address + kColumnarIndexSuffix).c_str());
+  }
   return Status::OK();
 }
 
@@ -539,6 +555,16 @@ Status ShardIndexGenerator::WriteToDatabase() {
                                   "[Internal ERROR] 'shard_count': " + std::to_string(shard_header_.GetShardCount()) +
                                     "is not in range (0, " + std::to_string(kMaxShardCount) + "].");
 
+  columnar_index_fields_.clear();
+  for (const auto &field : fields_) {
+    std::shared_ptr<Schema> schema_ptr;
+    RETURN_IF_NOT_OK_MR(shard_header_.GetSchemaByID(field.first, &schema_ptr));
+    std::shared_ptr<std::string> fn_ptr;
+    RETURN_IF_NOT_OK_MR(GenerateFieldName(field, &fn_ptr));
+    columnar_index_fields_.emplace_back(*fn_ptr,
+                                        ConvertJsonToSQL(TakeFieldType(field.second, schema_ptr->GetSchema()["schema"])));
+  }
+
   task_ = 0;  // set two atomic vars to initial value
   write_success_ = true;
 
@@ -595,9 +621,9 @@ void ShardIndexGenerator::DatabaseWriter() {
     shard_no = task_++;
   }
 }
-Status ShardIndexGenerator::Finalize(const std::vector<std::string> file_names) {
+Status ShardIndexGenerator::Finalize(const std::vector<std::string> file_names, bool columnar_index) {
   CHECK_FAIL_RETURN_UNEXPECTED_MR(!file_names.empty(), "[Internal ERROR] the size of mindrecord files is 0.");
-  ShardIndexGenerator sg{file_names[0]};
+  ShardIndexGenerator sg{file_names[0], false, columnar_index};
   RETURN_IF_NOT_OK_MR(sg.Build());
   RETURN_IF_NOT_OK_MR(sg.WriteToDatabase());
   return Status::OK();
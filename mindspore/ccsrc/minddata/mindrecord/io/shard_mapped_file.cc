@@ -0,0 +1,69 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_mapped_file.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <cerrno>
+#include <cstring>
+
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+Status ShardMappedFile::Open(const std::string &file_path, std::shared_ptr<ShardMappedFile> *mapped_file) {
+  RETURN_UNEXPECTED_IF_NULL_MR(mapped_file);
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(file_path.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(fd >= 0, "Invalid file, failed to open file: " + file_path +
+                                             " for mmap, error: " + std::string(strerror(errno)));
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED_MR("Invalid file, failed to get the size of file: " + file_path + " for mmap.");
+  }
+  auto size = static_cast<uint64_t>(st.st_size);
+  // Read only, so a row read twice always sees the bytes of the file. Writing through a blob faults.
+  void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file, the descriptor is not needed any more.
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(addr != MAP_FAILED, "[Internal ERROR] Failed to mmap file: " + file_path +
+                                                         ", error: " + std::string(strerror(errno)));
+  // Blob rows are mostly visited in a shuffled order.
+  (void)madvise(addr, size, MADV_RANDOM);
+  *mapped_file = std::shared_ptr<ShardMappedFile>(new ShardMappedFile(static_cast<uint8_t *>(addr), size));
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] mmap is not supported on this platform, file: " + file_path);
+#endif
+}
+
+ShardMappedFile::~ShardMappedFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr) {
+    if (munmap(data_, size_) != 0) {
+      MS_LOG(ERROR) << "[Internal ERROR] Failed to munmap, error: " << strerror(errno);
+    }
+    data_ = nullptr;
+  }
+#endif
+}
+}  // namespace mindrecord
+}  // namespace mindspore
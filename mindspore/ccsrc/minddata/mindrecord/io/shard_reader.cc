@@ -17,6 +17,8 @@
 #include "minddata/mindrecord/include/shard_reader.h"
 
 #include <algorithm>
+#include <atomic>
+#include <numeric>
 #include <thread>
 
 #include "utils/file_utils.h"
@@ -83,9 +85,17 @@ Status ShardReader::Init(const std::vector<std::string> &file_paths, bool load_d
       *meta_data_ptr == *first_meta_data_ptr,
       "Invalid file, the metadata of mindrecord file: " + file +
         " is different from others, please make sure all the mindrecord files generated by the same script.");
+  }
+  // A valid columnar index is checked against its file while loading, only the files without one need their meta file.
+  std::vector<std::shared_ptr<ShardColumnarIndex>> indexes;
+  LoadColumnarIndexes(&indexes);
+  for (size_t x = 0; x < file_paths_.size(); ++x) {
     sqlite3 *db = nullptr;
-    RETURN_IF_NOT_OK_MR(VerifyDataset(&db, file));
+    if (indexes[x] == nullptr) {
+      RETURN_IF_NOT_OK_MR(VerifyDataset(&db, file_paths_[x]));
+    }
     database_paths_.push_back(db);
+    column_indexes_.push_back(indexes[x]);
   }
   ShardHeader sh = ShardHeader();
   RETURN_IF_NOT_OK_MR(sh.BuildDataset(file_paths_, load_dataset));
@@ -169,6 +179,40 @@ Status ShardReader::VerifyDataset(sqlite3 **db, const string &file) {
   return Status::OK();
 }
 
+void ShardReader::LoadColumnarIndexes(std::vector<std::shared_ptr<ShardColumnarIndex>> *indexes) {
+  indexes->assign(file_paths_.size(), nullptr);
+  std::atomic<size_t> next_file(0);
+  auto loader = [this, indexes, &next_file]() {
+    for (size_t x = next_file++; x < file_paths_.size(); x = next_file++) {
+      if (!FileUtils::GetRealPath((file_paths_[x] + kColumnarIndexSuffix).c_str()).has_value()) {
+        continue;
+      }
+      auto rc = ShardColumnarIndex::Load(file_paths_[x], &(*indexes)[x]);
+      if (rc.IsError()) {
+        MS_LOG(WARNING) << "Failed to load the columnar index, read the meta file instead. " << rc.ToString();
+        (*indexes)[x] = nullptr;
+      }
+    }
+  };
+  auto num_workers = std::min(static_cast<size_t>(GetMaxThreadNum()), file_paths_.size());
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_workers; ++t) {
+    threads.emplace_back(loader);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+Status ShardReader::OpenAllDatabases() {
+  for (size_t x = 0; x < database_paths_.size(); ++x) {
+    if (database_paths_[x] == nullptr) {
+      RETURN_IF_NOT_OK_MR(VerifyDataset(&database_paths_[x], file_paths_[x]));
+    }
+  }
+  return Status::OK();
+}
+
 Status ShardReader::CheckColumnList(const std::vector<std::string> &selected_columns) {
   auto schema_ptr = GetShardHeader()->GetSchemas()[0];
   auto schema = schema_ptr->GetSchema()["schema"];
@@ -212,9 +256,31 @@ Status ShardReader::Open(int n_consumer) {
     }
     MS_LOG(INFO) << "Succeed to open file, path: " << file;
   }
+  if (use_mmap_) {
+    MapFiles();
+  }
   return Status::OK();
 }
 
+void ShardReader::MapFiles() {
+  std::vector<std::shared_ptr<ShardMappedFile>> mapped_files;
+  for (const auto &file : file_paths_) {
+    std::shared_ptr<ShardMappedFile> mapped_file;
+    auto realpath = FileUtils::GetRealPath(file.c_str());
+    Status rc = realpath.has_value()
+                  ? ShardMappedFile::Open(realpath.value(), &mapped_file)
+                  : STATUS_ERROR_MR(StatusCode::kMDUnexpectedError, "Failed to get the realpath of file: " + file);
+    if (rc.IsError()) {
+      MS_LOG(WARNING) << "Failed to map mindrecord files, read them through file streams instead. " << rc.ToString();
+      mapped_files_.clear();
+      return;
+    }
+    mapped_files.push_back(std::move(mapped_file));
+  }
+  // Blobs handed out before keep the previous mappings alive until they are released.
+  mapped_files_ = std::move(mapped_files);
+}
+
 Status ShardReader::ExtendRandomFileStreams(const int n_new_consumers) {
   CHECK_FAIL_RETURN_UNEXPECTED_MR(n_new_consumers > 0,
                                   "n_new_consumers must be a positive number. Got: " + std::to_string(n_new_consumers));
@@ -295,6 +361,7 @@ Status ShardReader::ShrinkRandomFileStreams(const int n_remove_consumers) {
 }
 
 void ShardReader::FileStreamsOperator() {
+  mapped_files_.clear();
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; --i) {
     if (file_streams_[i] != nullptr) {
       file_streams_[i]->close();
@@ -316,6 +383,7 @@ void ShardReader::FileStreamsOperator() {
       database_paths_[i] = nullptr;
     }
   }
+  column_indexes_.clear();
 }
 
 ShardReader::~ShardReader() { Close(); }
@@ -399,31 +467,12 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
       (*offset_ptr)[shard_id].emplace_back(
         std::vector<uint64_t>{static_cast<uint64_t>(shard_id), group_id, offset_start, offset_end});
       if (!all_in_index_) {
-        int raw_page_id = std::stoi(labels[i][3]);
-        uint64_t label_start = std::stoull(labels[i][4]) + kInt64Len;
-        uint64_t label_end = std::stoull(labels[i][5]);
-        auto len = label_end - label_start;
-        auto label_raw = std::vector<uint8_t>(len);
-        auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-        if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-          fs->close();
-          RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
-        }
-        auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-        if (!io_read.good() || io_read.fail() || io_read.bad()) {
-          fs->close();
-          RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
-        }
-        json label_json = json::from_msgpack(label_raw);
         json tmp;
-        if (!columns.empty()) {
-          for (const auto &col : columns) {
-            if (label_json.find(col) != label_json.end()) {
-              tmp[col] = label_json[col];
-            }
-          }
-        } else {
-          tmp = label_json;
+        auto rc = ReadRawLabel(fs, std::stoull(labels[i][3]), std::stoull(labels[i][4]), std::stoull(labels[i][5]),
+                               columns, &tmp);
+        if (rc.IsError()) {
+          fs->close();
+          return rc;
         }
         (*col_val_ptr)[shard_id].emplace_back(tmp);
       } else {
@@ -449,6 +498,33 @@ Status ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string
   return Status::OK();
 }
 
+Status ShardReader::ReadRawLabel(const std::shared_ptr<std::fstream> &fs, uint64_t raw_page_id, uint64_t label_start,
+                                 uint64_t label_end, const std::vector<std::string> &columns, json *label) {
+  label_start += kInt64Len;
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(label_end >= label_start, "[Internal ERROR] The offset of label is invalid.");
+  auto len = label_end - label_start;
+  auto label_raw = std::vector<uint8_t>(len);
+  auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
+  }
+  auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
+  }
+  json label_json = json::from_msgpack(label_raw);
+  if (!columns.empty()) {
+    for (const auto &col : columns) {
+      if (label_json.find(col) != label_json.end()) {
+        (*label)[col] = label_json[col];
+      }
+    }
+  } else {
+    *label = label_json;
+  }
+  return Status::OK();
+}
+
 Status ShardReader::ConvertJsonValue(const std::vector<std::string> &label, const std::vector<std::string> &columns,
                                      const json &schema, json *value) {
   for (unsigned int j = 0; j < columns.size(); ++j) {
@@ -508,6 +584,137 @@ Status ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, con
   return ConvertLabelToJson(labels, fs, offset_ptr, shard_id, columns, col_val_ptr);
 }
 
+Status ShardReader::ReadRowsInColumnarIndex(int shard_id, int64_t row_id, const std::vector<std::string> &columns,
+                                            std::shared_ptr<std::vector<std::vector<std::vector<uint64_t>>>> offset_ptr,
+                                            std::shared_ptr<std::vector<std::vector<json>>> col_val_ptr) {
+  const auto &index = column_indexes_[shard_id];
+  uint64_t begin = 0;
+  uint64_t end = index->NumRows();
+  if (row_id >= 0) {
+    // rows are sorted by ROW_ID
+    const uint64_t *row_ids = index->Column(kIndexRowId);
+    auto iter = std::lower_bound(row_ids, row_ids + end, static_cast<uint64_t>(row_id));
+    begin = static_cast<uint64_t>(iter - row_ids);
+    end = (begin < end && *iter == static_cast<uint64_t>(row_id)) ? begin + 1 : begin;
+  }
+
+  std::vector<int> field_ids;
+  std::vector<std::string> field_types;
+  std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
+  if (all_in_index_) {
+    auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+    for (const auto &col : columns) {
+      int field_id = -1;
+      RETURN_IF_NOT_OK_MR(GetColumnarIndexFieldId(shard_id, col, &field_id));
+      field_ids.push_back(field_id);
+      field_types.push_back(schema[col]["type"].get<std::string>());
+    }
+  } else {
+    std::string file_name = file_paths_[shard_id];
+    auto realpath = FileUtils::GetRealPath(file_name.c_str());
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(
+      realpath.has_value(),
+      "Invalid file, failed to get the realpath of mindrecord files. Please check file: " + file_name);
+    fs->open(realpath.value(), std::ios::in | std::ios::binary);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(fs->good(),
+                                    "Invalid file, failed to open files for reading mindrecord files. Please check file "
+                                    "path, permission and open files limit(ulimit -a): " +
+                                      file_name);
+  }
+
+  const uint64_t *group_ids = index->Column(kIndexRowGroupId);
+  const uint64_t *blob_starts = index->Column(kIndexPageOffsetBlob);
+  const uint64_t *blob_ends = index->Column(kIndexPageOffsetBlobEnd);
+  const uint64_t *raw_page_ids = index->Column(kIndexPageIdRaw);
+  const uint64_t *raw_starts = index->Column(kIndexPageOffsetRaw);
+  const uint64_t *raw_ends = index->Column(kIndexPageOffsetRawEnd);
+  (*offset_ptr)[shard_id].reserve(end - begin);
+  (*col_val_ptr)[shard_id].reserve(end - begin);
+  for (uint64_t row = begin; row < end; ++row) {
+    (*offset_ptr)[shard_id].emplace_back(std::vector<uint64_t>{static_cast<uint64_t>(shard_id), group_ids[row],
+                                                               blob_starts[row] + kInt64Len, blob_ends[row]});
+    json label;
+    if (all_in_index_) {
+      for (size_t j = 0; j < columns.size(); ++j) {
+        label[columns[j]] = index->GetJsonValue(field_ids[j], row, field_types[j]);
+      }
+    } else {
+      auto rc = ReadRawLabel(fs, raw_page_ids[row], raw_starts[row], raw_ends[row], columns, &label);
+      if (rc.IsError()) {
+        fs->close();
+        return rc;
+      }
+    }
+    (*col_val_ptr)[shard_id].emplace_back(std::move(label));
+  }
+  fs->close();
+  MS_LOG(INFO) << "Succeed to get " << (end - begin) << " records from shard " << std::to_string(shard_id)
+               << " columnar index.";
+  return Status::OK();
+}
+
+Status ShardReader::GetColumnarIndexFieldId(int shard_id, const std::string &column, int *field_id) {
+  std::shared_ptr<std::string> fn_ptr;
+  RETURN_IF_NOT_OK_MR(ShardIndexGenerator::GenerateFieldName(std::make_pair(column_schema_id_[column], column), &fn_ptr));
+  *field_id = column_indexes_[shard_id]->GetFieldId(*fn_ptr);
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(*field_id >= 0, "[Internal ERROR] 'field': " + column +
+                                                    " can not found in columnar index of: " + file_paths_[shard_id]);
+  return Status::OK();
+}
+
+Status ShardReader::FindRowsInColumnarIndex(int shard_id, int page_id,
+                                            const std::pair<std::string, std::string> &criteria,
+                                            std::vector<uint64_t> *rows) {
+  const auto &index = column_indexes_[shard_id];
+  std::vector<uint64_t> candidates;
+  if (!criteria.first.empty()) {
+    int field_id = -1;
+    RETURN_IF_NOT_OK_MR(GetColumnarIndexFieldId(shard_id, criteria.first, &field_id));
+    index->FindRows(field_id, criteria.second, &candidates);
+  } else {
+    candidates.resize(index->NumRows());
+    std::iota(candidates.begin(), candidates.end(), 0);
+  }
+  const uint64_t *page_ids = index->Column(kIndexPageIdBlob);
+  for (auto row : candidates) {
+    if (page_id < 0 || page_ids[row] == static_cast<uint64_t>(page_id)) {
+      rows->push_back(row);
+    }
+  }
+  return Status::OK();
+}
+
+Status ShardReader::GetLabelsFromColumnarIndex(int page_id, int shard_id, const std::vector<std::string> &columns,
+                                               const std::pair<std::string, std::string> &criteria,
+                                               std::shared_ptr<std::vector<json>> *labels_ptr) {
+  std::vector<uint64_t> rows;
+  RETURN_IF_NOT_OK_MR(FindRowsInColumnarIndex(shard_id, page_id, criteria, &rows));
+  const auto &index = column_indexes_[shard_id];
+  if (all_in_index_) {
+    auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+    std::vector<int> field_ids(columns.size(), -1);
+    for (size_t j = 0; j < columns.size(); ++j) {
+      RETURN_IF_NOT_OK_MR(GetColumnarIndexFieldId(shard_id, columns[j], &field_ids[j]));
+    }
+    for (auto row : rows) {
+      json construct_json;
+      for (size_t j = 0; j < columns.size(); ++j) {
+        construct_json[columns[j]] =
+          index->GetJsonValue(field_ids[j], row, schema[columns[j]]["type"].get<std::string>());
+      }
+      (*labels_ptr)->emplace_back(std::move(construct_json));
+    }
+    return Status::OK();
+  }
+  std::vector<std::vector<std::string>> label_offsets;
+  for (auto row : rows) {
+    label_offsets.emplace_back(std::vector<std::string>{std::to_string(index->Column(kIndexPageIdRaw)[row]),
+                                                        std::to_string(index->Column(kIndexPageOffsetRaw)[row]),
+                                                        std::to_string(index->Column(kIndexPageOffsetRawEnd)[row])});
+  }
+  return GetLabelsFromBinaryFile(shard_id, columns, label_offsets, labels_ptr);
+}
+
 Status ShardReader::GetAllClasses(const std::string &category_field,
                                   std::shared_ptr<std::set<std::string>> category_ptr) {
   std::map<std::string, uint64_t> index_columns;
@@ -524,7 +731,11 @@ Status ShardReader::GetAllClasses(const std::string &category_field,
   std::string sql = "SELECT DISTINCT " + *fn_ptr + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, category_ptr);
+    if (column_indexes_[x] != nullptr) {
+      threads[x] = std::thread(&ShardReader::GetClassesInColumnarIndex, this, x, *fn_ptr, category_ptr);
+    } else {
+      threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, category_ptr);
+    }
   }
 
   for (int x = 0; x < shard_count_; x++) {
@@ -558,6 +769,23 @@ void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string
   sqlite3_free(errmsg);
 }
 
+void ShardReader::GetClassesInColumnarIndex(int shard_id, const std::string &field_name,
+                                            std::shared_ptr<std::set<std::string>> category_ptr) {
+  const auto &index = column_indexes_[shard_id];
+  int field_id = index->GetFieldId(field_name);
+  if (field_id < 0) {
+    MS_LOG(ERROR) << "[Internal ERROR] 'field': " << field_name
+                  << " can not found in columnar index of: " << file_paths_[shard_id];
+    return;
+  }
+  std::set<std::string> categories;
+  index->GetDistinctValues(field_id, &categories);
+  MS_LOG(INFO) << "Succeed to get " << categories.size() << " records from shard " << std::to_string(shard_id)
+               << " columnar index.";
+  std::lock_guard<std::mutex> lck(shard_locker_);
+  category_ptr->insert(categories.begin(), categories.end());
+}
+
 Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
                                     std::shared_ptr<ROW_GROUPS> *row_group_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(row_group_ptr);
@@ -582,7 +810,13 @@ Status ShardReader::ReadAllRowGroup(const std::vector<std::string> &columns,
 
   std::vector<std::thread> thread_read_db = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    thread_read_db[x] = std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, columns, offset_ptr, col_val_ptr);
+    if (column_indexes_[x] != nullptr) {
+      thread_read_db[x] =
+        std::thread(&ShardReader::ReadRowsInColumnarIndex, this, x, -1, columns, offset_ptr, col_val_ptr);
+    } else {
+      thread_read_db[x] =
+        std::thread(&ShardReader::ReadAllRowsInShard, this, x, sql, columns, offset_ptr, col_val_ptr);
+    }
   }
 
   for (int x = 0; x < shard_count_; x++) {
@@ -600,6 +834,11 @@ Status ShardReader::ReadRowGroupByShardIDAndSampleID(const std::vector<std::stri
   auto offset_ptr = std::make_shared<std::vector<std::vector<std::vector<uint64_t>>>>(
     shard_count_, std::vector<std::vector<uint64_t>>{});
   auto col_val_ptr = std::make_shared<std::vector<std::vector<json>>>(shard_count_, std::vector<json>{});
+  if (column_indexes_[shard_id] != nullptr) {
+    RETURN_IF_NOT_OK_MR(ReadRowsInColumnarIndex(shard_id, sample_id, columns, offset_ptr, col_val_ptr));
+    *row_group_ptr = std::make_shared<ROW_GROUPS>(std::move(*offset_ptr), std::move(*col_val_ptr));
+    return Status::OK();
+  }
   if (all_in_index_) {
     for (unsigned int i = 0; i < columns.size(); ++i) {
       fields += ',';
@@ -673,6 +912,20 @@ int ShardReader::SelectCallback(void *p_data, int num_fields, char **p_fields, c
 
 std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int shard_id,
                                                                const std::pair<std::string, std::string> &criteria) {
+  if (column_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    auto rc = FindRowsInColumnarIndex(shard_id, page_id, criteria, &rows);
+    if (rc.IsError()) {
+      MS_LOG(ERROR) << rc.ToString();
+      return std::vector<std::vector<uint64_t>>();
+    }
+    std::vector<std::vector<uint64_t>> res;
+    for (auto row : rows) {
+      res.emplace_back(std::vector<uint64_t>{column_indexes_[shard_id]->Column(kIndexPageOffsetBlob)[row] + kInt64Len,
+                                             column_indexes_[shard_id]->Column(kIndexPageOffsetBlobEnd)[row]});
+    }
+    return res;
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql =
@@ -721,6 +974,18 @@ std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int
 Status ShardReader::GetPagesByCategory(int shard_id, const std::pair<std::string, std::string> &criteria,
                                        std::shared_ptr<std::vector<uint64_t>> *pages_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(pages_ptr);
+  if (column_indexes_[shard_id] != nullptr) {
+    std::vector<uint64_t> rows;
+    RETURN_IF_NOT_OK_MR(FindRowsInColumnarIndex(shard_id, -1, criteria, &rows));
+    std::set<uint64_t> visited;
+    for (auto row : rows) {
+      auto page_id = column_indexes_[shard_id]->Column(kIndexPageIdBlob)[row];
+      if (visited.insert(page_id).second) {
+        (*pages_ptr)->emplace_back(page_id);
+      }
+    }
+    return Status::OK();
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql = "SELECT DISTINCT PAGE_ID_BLOB FROM INDEXES WHERE 1 = 1 ";
@@ -901,6 +1166,9 @@ Status ShardReader::GetLabels(int page_id, int shard_id, const std::vector<std::
                               const std::pair<std::string, std::string> &criteria,
                               std::shared_ptr<std::vector<json>> *labels_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(labels_ptr);
+  if (column_indexes_[shard_id] != nullptr) {
+    return GetLabelsFromColumnarIndex(page_id, shard_id, columns, criteria, labels_ptr);
+  }
   if (all_in_index_) {
     auto db = database_paths_[shard_id];
     std::string fields;
@@ -991,6 +1259,10 @@ int64_t ShardReader::GetNumClasses(const std::string &category_field) {
   auto category_ptr = std::make_shared<std::set<std::string>>();
   sqlite3 *db = nullptr;
   for (int x = 0; x < shard_count; x++) {
+    if (x < column_indexes_.size() && column_indexes_[x] != nullptr) {
+      threads[x] = std::thread(&ShardReader::GetClassesInColumnarIndex, this, x, *fn_ptr, category_ptr);
+      continue;
+    }
     std::string path_utf8 = "";
 #if defined(_WIN32) || defined(_WIN64)
     path_utf8 = FileUtils::GB2312ToUTF_8((file_paths_[x] + ".db").data());
@@ -1327,40 +1599,40 @@ Status ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, uint
   }
   num_rows_ = tasks_.Size();
   MS_LOG(INFO) << "The total number of samples is " << num_rows_
-               << ", the number of samples after sampling is: " << tasks_.sample_ids_.size();
+               << ", the number of samples after sampling is: " << tasks_.SampleCount();
 
   return Status::OK();
 }
 
-Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
-                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
-  RETURN_UNEXPECTED_IF_NULL_MR(task_content_ptr);
+Status ShardReader::GetTaskBlobLocation(int64_t task_id, TaskType *task_type, uint32_t *shard_id,
+                                        uint64_t *file_offset, uint64_t *blob_size, json *var_fields) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_type);
+  RETURN_UNEXPECTED_IF_NULL_MR(shard_id);
+  RETURN_UNEXPECTED_IF_NULL_MR(file_offset);
+  RETURN_UNEXPECTED_IF_NULL_MR(blob_size);
+  RETURN_UNEXPECTED_IF_NULL_MR(var_fields);
   // All tasks are done
   CHECK_FAIL_RETURN_UNEXPECTED_MR(task_id < tasks_.Size(), "[Internal ERROR] 'task_id': " + std::to_string(task_id) +
                                                              " is out of bound: " + std::to_string(tasks_.Size()));
-  uint32_t shard_id = 0;
   uint32_t group_id = 0;
   uint32_t blob_start = 0;
   uint32_t blob_end = 0;
-  json var_fields;
   // Pick up task from task list
   ShardTask task = tasks_.GetTaskByID(task_id);
 
   // check task type
-  auto task_type = std::get<0>(task);
-  if (task_type == TaskType::kPaddedTask) {
-    *task_content_ptr =
-      std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+  *task_type = std::get<0>(task);
+  if (*task_type == TaskType::kPaddedTask) {
     return Status::OK();
   }
 
-  shard_id = std::get<0>(std::get<1>(task));  // shard id
+  *shard_id = std::get<0>(std::get<1>(task));  // shard id
 
   if (lazy_load_ == false) {
     group_id = std::get<1>(std::get<1>(task));  // group id
     blob_start = std::get<2>(task)[0];          // blob start
     blob_end = std::get<2>(task)[1];            // blob end
-    var_fields = std::get<3>(task);             // scalar variable field
+    *var_fields = std::get<3>(task);            // scalar variable field
   } else {
     // get scalar variable fields by sample id
     uint32_t sample_id_in_shard = std::get<1>(std::get<1>(task));
@@ -1368,36 +1640,72 @@ Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
     // read the meta from index
     std::shared_ptr<ROW_GROUPS> row_group_ptr;
     RETURN_IF_NOT_OK_MR(
-      ReadRowGroupByShardIDAndSampleID(selected_columns_, shard_id, sample_id_in_shard, &row_group_ptr));
+      ReadRowGroupByShardIDAndSampleID(selected_columns_, *shard_id, sample_id_in_shard, &row_group_ptr));
     auto &offsets = std::get<0>(*row_group_ptr);
     auto &local_columns = std::get<1>(*row_group_ptr);
 
-    group_id = offsets[shard_id][0][1];       // group_id
-    blob_start = offsets[shard_id][0][2];     // blob start
-    blob_end = offsets[shard_id][0][3];       // blob end
-    var_fields = local_columns[shard_id][0];  // scalar variable field
+    group_id = offsets[*shard_id][0][1];        // group_id
+    blob_start = offsets[*shard_id][0][2];      // blob start
+    blob_end = offsets[*shard_id][0][3];        // blob end
+    *var_fields = local_columns[*shard_id][0];  // scalar variable field
   }
 
-  // read the blob from data file
+  // locate the blob in data file
   std::shared_ptr<Page> page_ptr;
-  RETURN_IF_NOT_OK_MR(shard_header_->GetPageByGroupId(group_id, shard_id, &page_ptr));
+  RETURN_IF_NOT_OK_MR(shard_header_->GetPageByGroupId(group_id, *shard_id, &page_ptr));
   MS_LOG(DEBUG) << "[Internal ERROR] Success to get page by group id: " << group_id;
 
-  // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
-  auto file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  *blob_size = blob_end - blob_start;
+  *file_offset = header_size_ + page_size_ * (page_ptr->GetPageID()) + blob_start;
+  return Status::OK();
+}
+
+Status ShardReader::ReadBlob(uint32_t consumer_id, uint32_t shard_id, uint64_t file_offset, uint64_t blob_size,
+                             uint8_t *dst) {
+  if (blob_size == 0) {
+    return Status::OK();
+  }
+  RETURN_UNEXPECTED_IF_NULL_MR(dst);
+  if (!mapped_files_.empty()) {
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(shard_id < mapped_files_.size() &&
+                                      file_offset + blob_size <= mapped_files_[shard_id]->Size(),
+                                    "[Internal ERROR] blob is out of the bound of the mapped file.");
+    auto ret = memcpy_s(dst, blob_size, mapped_files_[shard_id]->Data() + file_offset, blob_size);
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(ret == 0, "[Internal ERROR] Failed to call securec func [memcpy_s]");
+    return Status::OK();
+  }
 
   auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
   if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
     file_streams_random_[consumer_id][shard_id]->close();
     RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to seekg file.");
   }
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
+  auto &io_read = file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(dst), blob_size);
   if (!io_read.good() || io_read.fail() || io_read.bad()) {
     file_streams_random_[consumer_id][shard_id]->close();
     RETURN_STATUS_UNEXPECTED_MR("[Internal ERROR] Failed to read file.");
   }
+  return Status::OK();
+}
+
+Status ShardReader::ConsumerOneTask(int64_t task_id, uint32_t consumer_id,
+                                    std::shared_ptr<TASK_CONTENT> *task_content_ptr) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_content_ptr);
+  TaskType task_type = TaskType::kCommonTask;
+  uint32_t shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  json var_fields;
+  RETURN_IF_NOT_OK_MR(GetTaskBlobLocation(task_id, &task_type, &shard_id, &file_offset, &blob_size, &var_fields));
+  if (task_type == TaskType::kPaddedTask) {
+    *task_content_ptr =
+      std::make_shared<TASK_CONTENT>(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    return Status::OK();
+  }
+
+  // Pack image list
+  std::vector<uint8_t> images(blob_size);
+  RETURN_IF_NOT_OK_MR(ReadBlob(consumer_id, shard_id, file_offset, blob_size, images.data()));
 
   // Deliver batch data to output map
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
@@ -1422,12 +1730,12 @@ void ShardReader::ConsumerByRow(int consumer_id) {
     sample_id_pos = sample_id_position_++;
 
     // All tasks are done
-    if (sample_id_pos >= static_cast<int>(tasks_.sample_ids_.size())) {
+    if (sample_id_pos >= tasks_.SampleCount()) {
       return;
     }
     auto task_content_ptr =
       std::make_shared<TASK_CONTENT>(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
-    if (ConsumerOneTask(tasks_.sample_ids_[sample_id_pos], consumer_id, &task_content_ptr).IsError()) {
+    if (ConsumerOneTask(tasks_.GetTaskSampleByID(sample_id_pos), consumer_id, &task_content_ptr).IsError()) {
       MS_LOG(ERROR) << "[Internal ERROR] Error raised in ConsumerOneTask function.";
       return;
     }
@@ -1451,7 +1759,7 @@ std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetNext() {
   if (interrupt_) {
     return std::vector<std::tuple<std::vector<uint8_t>, json>>();
   }
-  if (deliver_id_ >= static_cast<int>(tasks_.sample_ids_.size())) {
+  if (deliver_id_ >= tasks_.SampleCount()) {
     return std::vector<std::tuple<std::vector<uint8_t>, json>>();
   }
 
@@ -1481,6 +1789,39 @@ TASK_CONTENT ShardReader::GetNextById(const int64_t &task_id, const int32_t &con
   return std::move(*task_content_ptr);
 }
 
+Status ShardReader::GetNextViewById(const int64_t &task_id, const int32_t &consumer_id, TaskType *task_type,
+                                    ShardBlobView *blob, json *var_fields) {
+  RETURN_UNEXPECTED_IF_NULL_MR(task_type);
+  RETURN_UNEXPECTED_IF_NULL_MR(blob);
+  RETURN_UNEXPECTED_IF_NULL_MR(var_fields);
+  *blob = ShardBlobView();
+  *task_type = TaskType::kCommonTask;
+  if (interrupt_) {
+    return Status::OK();
+  }
+  uint32_t shard_id = 0;
+  uint64_t file_offset = 0;
+  uint64_t blob_size = 0;
+  RETURN_IF_NOT_OK_MR(GetTaskBlobLocation(task_id, task_type, &shard_id, &file_offset, &blob_size, var_fields));
+  if (*task_type == TaskType::kPaddedTask) {
+    return Status::OK();
+  }
+
+  if (!mapped_files_.empty()) {
+    const auto &mapped_file = mapped_files_[shard_id];
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(file_offset + blob_size <= mapped_file->Size(),
+                                    "[Internal ERROR] blob is out of the bound of the mapped file.");
+    // Alias the mapping, the blob keeps the whole file mapped until it is released.
+    blob->data = std::shared_ptr<const uint8_t>(mapped_file, mapped_file->Data() + file_offset);
+  } else {
+    auto buffer = std::make_shared<std::vector<uint8_t>>(blob_size);
+    RETURN_IF_NOT_OK_MR(ReadBlob(consumer_id, shard_id, file_offset, blob_size, buffer->data()));
+    blob->data = std::shared_ptr<const uint8_t>(buffer, buffer->data());
+  }
+  blob->size = blob_size;
+  return Status::OK();
+}
+
 Status ShardReader::UnCompressBlob(const std::vector<uint8_t> &raw_blob_data,
                                    std::shared_ptr<std::vector<std::vector<uint8_t>>> *blob_data_ptr) {
   RETURN_UNEXPECTED_IF_NULL_MR(blob_data_ptr);
@@ -1544,10 +1885,9 @@ void ShardReader::ShuffleTask() {
   }
 }
 
-const std::vector<int64_t> *ShardReader::GetSampleIds() {
-  // return const reference to private sample id list.
-  return &(this->tasks_.sample_ids_);
-}
+int64_t ShardReader::GetSampleCount() const { return tasks_.SampleCount(); }
+
+int64_t ShardReader::GetSampleId(int64_t pos) { return tasks_.GetTaskSampleByID(pos); }
 
 }  // namespace mindrecord
 }  // namespace mindspore
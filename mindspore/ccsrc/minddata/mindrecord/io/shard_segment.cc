@@ -33,6 +33,8 @@ Status ShardSegment::GetCategoryFields(std::shared_ptr<vector<std::string>> *fie
     return Status::OK();
   }
 
+  // the category fields are listed from the meta file, which is not opened if the columnar index is used
+  RETURN_IF_NOT_OK_MR(OpenAllDatabases());
   std::string sql = "PRAGMA table_info(INDEXES);";
   std::vector<std::vector<std::string>> field_names;
 
@@ -95,6 +97,7 @@ Status ShardSegment::WrapCategoryInfo(std::shared_ptr<CATEGORY_INFO> *category_i
                                   "Invalid data, field: " + current_category_field_ + "is invalid.");
   std::string sql = "SELECT " + current_category_field_ + ", COUNT(" + current_category_field_ +
                     ") AS `value_occurrence` FROM indexes GROUP BY " + current_category_field_ + ";";
+  RETURN_IF_NOT_OK_MR(OpenAllDatabases());
 
   for (auto &db : database_paths_) {
     std::vector<std::vector<std::string>> field_count;
@@ -77,7 +77,24 @@ int64_t ShardSample::GetNumSamples(int64_t dataset_size, int64_t num_classes) {
 }
 
 Status ShardSample::UpdateTasks(ShardTaskList &tasks, int64_t taking) {
-  if (tasks.permutation_.empty()) {
+  if (tasks.shuffle_order_ != nullptr && sampler_type_ != kSubsetRandomSampler && sampler_type_ != kSubsetSampler) {
+    // take the same range as below, as a slice of the order instead of a list of ids
+    auto total_no = tasks.SampleCount();
+    CHECK_FAIL_RETURN_UNEXPECTED_MR(
+      total_no > 0, "[Internal ERROR] 'total_no' should be positive but got: " + std::to_string(total_no));
+    int64_t start = partition_id_ * taking;
+    int64_t count = taking;
+    if (!nums_per_shard_.empty()) {
+      start = partition_id_ - 1 >= 0 ? nums_per_shard_[partition_id_ - 1] : 0;
+      count = nums_per_shard_[partition_id_] - start;
+    }
+    if (no_of_samples_ != 0) {
+      count = std::min(count, no_of_samples_);
+    }
+    ShardTaskList new_tasks;
+    new_tasks.shuffle_order_ = tasks.shuffle_order_->Slice(start, count);
+    ShardTaskList::TaskListSwap(tasks, new_tasks);
+  } else if (tasks.permutation_.empty()) {
     ShardTaskList new_tasks;
     auto total_no = tasks.sample_ids_.size();
     CHECK_FAIL_RETURN_UNEXPECTED_MR(
@@ -131,7 +148,7 @@ Status ShardSample::UpdateTasks(ShardTaskList &tasks, int64_t taking) {
 Status ShardSample::Execute(ShardTaskList &tasks) {
   if (offset_ != -1) {
     int64_t old_v = 0;
-    int64_t num_rows_ = tasks.sample_ids_.size();
+    int64_t num_rows_ = tasks.SampleCount();
     for (int64_t x = 0; x < denominator_; x++) {
       int64_t samples_per_buffer_ = (num_rows_ + offset_) / denominator_;
       int64_t remainder = (num_rows_ + offset_) % denominator_;
@@ -147,7 +164,7 @@ Status ShardSample::Execute(ShardTaskList &tasks) {
     }
   }
   int no_of_categories = static_cast<int>(tasks.categories);
-  int64_t total_no = tasks.sample_ids_.size();
+  int64_t total_no = tasks.SampleCount();
   int64_t taking = 0;
   if (sampler_type_ == kCustomTopNSampler) {  // non sharding case constructor #1
     no_of_samples_ = std::min(no_of_samples_, total_no);
@@ -36,7 +36,7 @@ int64_t ShardSequentialSample::GetNumSamples(int64_t dataset_size, int64_t num_c
 
 Status ShardSequentialSample::Execute(ShardTaskList &tasks) {
   int64_t taking;
-  int64_t total_no = static_cast<int64_t>(tasks.sample_ids_.size());
+  int64_t total_no = tasks.SampleCount();
   if (no_of_samples_ == 0 && (per_ >= -kEpsilon && per_ <= kEpsilon)) {
     taking = total_no;
   } else if (per_ > kEpsilon && per_ <= 1.0f) {
@@ -17,6 +17,7 @@
 #include "minddata/mindrecord/include/shard_shuffle.h"
 
 #include <algorithm>
+#include <memory>
 
 namespace mindspore {
 namespace mindrecord {
@@ -156,6 +157,25 @@ Status ShardShuffle::ShuffleInfile(ShardTaskList &tasks) {
   return Status::OK();
 }
 
+Status ShardShuffle::ShufflePartial(ShardTaskList &tasks) {
+  if (no_of_samples_ == 0) {
+    no_of_samples_ = tasks.Size();
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED_MR(
+    no_of_samples_ > 0, "Invalid input, 'num_samples' should be positive but got: " + std::to_string(no_of_samples_));
+  // the order is computed from the seed when the samples are read, so neither the permutation nor the sampled ids
+  // of the whole dataset are kept in memory
+  auto total_no = tasks.Size();
+  auto order = std::make_shared<ShardShuffleOrder>(GetShardSampleCount(), total_no, shuffle_seed_);
+  if (no_of_samples_ < total_no) {
+    order = order->Slice(0, no_of_samples_);
+  }
+  ShardTaskList new_tasks;
+  new_tasks.shuffle_order_ = order;
+  ShardTaskList::TaskListSwap(tasks, new_tasks);
+  return Status::OK();
+}
+
 Status ShardShuffle::Execute(ShardTaskList &tasks) {
   if (reshuffle_each_epoch_) {
     shuffle_seed_++;
@@ -164,6 +184,9 @@ Status ShardShuffle::Execute(ShardTaskList &tasks) {
                                   "[Internal ERROR] task categories should be greater than or equal to 1 but got: " +
                                     std::to_string(tasks.categories));
   if (shuffle_type_ == kShuffleSample) {  // shuffle each sample
+    if (GetShuffleMode() == dataset::ShuffleMode::kPartial && replacement_ == false) {
+      return ShufflePartial(tasks);
+    }
     if (tasks.permutation_.empty() == true) {
       tasks.MakePerm();
     }
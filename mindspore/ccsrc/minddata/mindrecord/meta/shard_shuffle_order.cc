@@ -0,0 +1,138 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_shuffle_order.h"
+
+#include <algorithm>
+#include <random>
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+// Fisher-Yates shuffle, unlike std::shuffle its result is the same with every standard library
+template <typename T>
+void PortableShuffle(std::vector<T> *items, std::mt19937_64 *gen) {
+  for (size_t i = items->size(); i > 1; --i) {
+    size_t j = static_cast<size_t>((*gen)() % i);
+    std::swap((*items)[i - 1], (*items)[j]);
+  }
+}
+}  // namespace
+
+ShardShuffleOrder::ShardShuffleOrder(const std::vector<int64_t> &shard_sample_count, int64_t num_tasks, uint32_t seed,
+                                     int64_t block_tasks, int64_t window_blocks)
+    : seed_(seed),
+      num_tasks_(num_tasks),
+      window_blocks_(std::max<int64_t>(window_blocks, 1)) {
+  block_tasks = std::max<int64_t>(block_tasks, 1);
+  // cut each shard, and the padded tasks after the last one, into blocks
+  std::vector<int64_t> shard_end(shard_sample_count.begin(), shard_sample_count.end());
+  if (shard_end.empty() || shard_end.back() < num_tasks) {
+    shard_end.push_back(num_tasks);
+  }
+  std::vector<std::pair<int64_t, int64_t>> blocks;
+  int64_t shard_start = 0;
+  for (auto end : shard_end) {
+    end = std::min(end, num_tasks);
+    for (int64_t start = shard_start; start < end; start += block_tasks) {
+      blocks.emplace_back(start, std::min(block_tasks, end - start));
+    }
+    shard_start = std::max(shard_start, end);
+  }
+
+  // level 1, permute the blocks
+  std::mt19937_64 gen(seed_);
+  PortableShuffle(&blocks, &gen);
+  block_start_.reserve(blocks.size());
+  block_size_.reserve(blocks.size());
+  window_offset_.reserve(blocks.size() / window_blocks_ + 2);
+  int64_t offset = 0;
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    if (i % window_blocks_ == 0) {
+      window_offset_.push_back(offset);
+    }
+    block_start_.push_back(blocks[i].first);
+    block_size_.push_back(blocks[i].second);
+    offset += blocks[i].second;
+  }
+  window_offset_.push_back(offset);
+}
+
+ShardShuffleOrder::ShardShuffleOrder(const ShardShuffleOrder &other)
+    : seed_(other.seed_),
+      num_tasks_(other.num_tasks_),
+      block_start_(other.block_start_),
+      block_size_(other.block_size_),
+      window_blocks_(other.window_blocks_),
+      window_offset_(other.window_offset_),
+      ranges_(other.ranges_) {}
+
+std::shared_ptr<ShardShuffleOrder> ShardShuffleOrder::Slice(int64_t start, int64_t count) const {
+  std::shared_ptr<ShardShuffleOrder> slice(new ShardShuffleOrder(*this));
+  int64_t size = Size();
+  slice->ranges_.emplace_back(size > 0 ? start % size : 0, std::max<int64_t>(count, 0));
+  return slice;
+}
+
+int64_t ShardShuffleOrder::Get(int64_t pos) {
+  // map the position through the slices, each of which wraps around at the end of the previous one
+  int64_t global_pos = pos;
+  for (size_t i = ranges_.size(); i > 0; --i) {
+    int64_t outer_size = i > 1 ? ranges_[i - 2].second : num_tasks_;
+    global_pos = (ranges_[i - 1].first + global_pos) % std::max<int64_t>(outer_size, 1);
+  }
+  auto it = std::upper_bound(window_offset_.begin(), window_offset_.end(), global_pos);
+  int64_t window = static_cast<int64_t>(it - window_offset_.begin()) - 1;
+  int64_t offset = global_pos - window_offset_[window];
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto cached = windows_.begin(); cached != windows_.end(); ++cached) {
+      if (cached->first == window) {
+        windows_.splice(windows_.begin(), windows_, cached);
+        return (*windows_.front().second)[offset];
+      }
+    }
+  }
+  // the permutation is computed out of the lock, the workers reading cached windows are not held up by it
+  auto tasks = LoadWindow(window);
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (std::none_of(windows_.begin(), windows_.end(), [window](const auto &cached) { return cached.first == window; })) {
+    windows_.emplace_front(window, tasks);
+    if (windows_.size() > kCachedWindows) {
+      windows_.pop_back();
+    }
+  }
+  return (*tasks)[offset];
+}
+
+std::shared_ptr<std::vector<int64_t>> ShardShuffleOrder::LoadWindow(int64_t window) const {
+  auto tasks = std::make_shared<std::vector<int64_t>>();
+  int64_t first_block = window * window_blocks_;
+  int64_t last_block = std::min<int64_t>(first_block + window_blocks_, static_cast<int64_t>(block_start_.size()));
+  tasks->reserve(window_offset_[window + 1] - window_offset_[window]);
+  for (int64_t block = first_block; block < last_block; ++block) {
+    for (int64_t i = 0; i < block_size_[block]; ++i) {
+      tasks->push_back(block_start_[block] + i);
+    }
+  }
+  // level 2, interleave the tasks of the window, with a generator of its own so windows load in any order
+  std::seed_seq seq{seed_, static_cast<uint32_t>(window), static_cast<uint32_t>(static_cast<uint64_t>(window) >> 32)};
+  std::mt19937_64 gen(seq);
+  PortableShuffle(tasks.get(), &gen);
+  return tasks;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
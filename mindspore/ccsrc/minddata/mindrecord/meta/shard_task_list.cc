@@ -26,6 +26,7 @@ ShardTaskList::ShardTaskList(const ShardTaskList &other)
     : categories(other.categories),
       permutation_(other.permutation_),
       sample_ids_(other.sample_ids_),
+      shuffle_order_(other.shuffle_order_),
       task_list_(other.task_list_) {}
 
 ShardTaskList &ShardTaskList::operator=(const ShardTaskList &other) {
@@ -33,13 +34,14 @@ ShardTaskList &ShardTaskList::operator=(const ShardTaskList &other) {
   std::swap(categories, tmp.categories);
   permutation_.swap(tmp.permutation_);
   sample_ids_.swap(tmp.sample_ids_);
+  shuffle_order_.swap(tmp.shuffle_order_);
   task_list_.swap(tmp.task_list_);
   return *this;
 }
 
 void ShardTaskList::InitSampleIds() {
   // no-op if there already exists sample ids.  Do not clobber previous list
-  if (sample_ids_.empty()) {
+  if (sample_ids_.empty() && shuffle_order_ == nullptr) {
     sample_ids_ = std::vector<int64_t>(task_list_.size());
     for (auto i = 0; i < task_list_.size(); i++) {
       sample_ids_[i] = i;
@@ -66,6 +68,7 @@ void ShardTaskList::TaskListSwap(ShardTaskList &orig_tasks, ShardTaskList &new_t
   std::swap(orig_tasks.categories, new_tasks.categories);
   std::swap(orig_tasks.permutation_, new_tasks.permutation_);
   std::swap(orig_tasks.sample_ids_, new_tasks.sample_ids_);
+  std::swap(orig_tasks.shuffle_order_, new_tasks.shuffle_order_);
 }
 
 void ShardTaskList::PopBack() { task_list_.pop_back(); }
@@ -85,11 +88,17 @@ int64_t ShardTaskList::SizeOfRows() const {
 
 ShardTask &ShardTaskList::GetTaskByID(int64_t id) { return task_list_[id]; }
 
-int64_t ShardTaskList::GetTaskSampleByID(int64_t id) { return sample_ids_[id]; }
+int64_t ShardTaskList::GetTaskSampleByID(int64_t id) {
+  return shuffle_order_ != nullptr ? shuffle_order_->Get(id) : sample_ids_[id];
+}
+
+int64_t ShardTaskList::SampleCount() const {
+  return shuffle_order_ != nullptr ? shuffle_order_->Size() : static_cast<int64_t>(sample_ids_.size());
+}
 
 int64_t ShardTaskList::GetRandomTaskID() {
   std::mt19937 gen = GetRandomDevice();
-  std::uniform_int_distribution<> dis(0, sample_ids_.size() - 1);
+  std::uniform_int_distribution<> dis(0, SampleCount() - 1);
   return dis(gen);
 }
 
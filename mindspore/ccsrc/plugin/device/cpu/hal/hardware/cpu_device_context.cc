@@ -16,11 +16,14 @@
 
 #include "plugin/device/cpu/hal/hardware/cpu_device_context.h"
 #include <map>
+#include <memory>
 #include <string>
 #include "plugin/device/cpu/hal/device/cpu_device_address.h"
 #include "plugin/device/cpu/hal/device/cpu_memory_manager.h"
+#include "plugin/device/cpu/hal/hardware/cpu_memory_pool.h"
 #include "plugin/device/cpu/optimizer/reg_cpu_const_input_to_attr.h"
 #include "plugin/device/cpu/hal/hardware/cpu_somas.h"
+#include "utils/ms_utils.h"
 #ifdef ENABLE_AKG
 #include "plugin/device/cpu/kernel/akg/akg_cpu_kernel_build.h"
 #endif
@@ -351,6 +354,34 @@ void CPUKernelExecutor::CreateKernel(const std::vector<CNodePtr> &nodes) const {
 #endif
 }
 
+namespace {
+constexpr char kSomasStaticArenaEnv[] = "MS_DEV_CPU_SOMAS_STATIC_ARENA";
+
+// Allocate the whole somas block of the graph once and keep it across the steps, so that the kernels of the graph run
+// without the memory alloc and free actors, and the tensors taken over by the somas never call the memory manager
+// actor. The arena comes from the persistent memory of the CPU memory pool, so that it counts in the statistics and
+// the limit of the pool, and it is given back to the pool with the graph.
+void AllocSomasStaticArena(const KernelGraphPtr &kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto somas_info = kernel_graph->MutableSomasInfo();
+  MS_EXCEPTION_IF_NULL(somas_info);
+  if ((somas_info->whole_block_size_ == 0) || (somas_info->static_arena_ != nullptr)) {
+    return;
+  }
+  auto arena = CPUMemoryPool::GetInstance().AllocTensorMem(somas_info->whole_block_size_, true);
+  if (arena == nullptr) {
+    MS_LOG(WARNING) << "Allocate somas static arena failed for graph " << kernel_graph->graph_id()
+                    << ", size: " << somas_info->whole_block_size_ << ". The somas memory is allocated in every step.";
+    return;
+  }
+  somas_info->static_arena_ =
+    std::shared_ptr<void>(arena, [](void *ptr) { CPUMemoryPool::GetInstance().FreeTensorMem(ptr); });
+  somas_info->base_address_ = arena;
+  MS_LOG(INFO) << "Somas static arena allocate success for graph " << kernel_graph->graph_id()
+               << ", size: " << somas_info->whole_block_size_;
+}
+}  // namespace
+
 void CPUKernelExecutor::PreprocessBeforeRun(const FuncGraphPtr &graph) const {
   MS_EXCEPTION_IF_NULL(graph);
   auto kernel_graph = graph->cast<KernelGraphPtr>();
@@ -370,6 +401,10 @@ void CPUKernelExecutor::PreprocessBeforeRun(const FuncGraphPtr &graph) const {
     if (ret) {
       MS_LOG(INFO) << "Somas allocate success for graph " << kernel_graph->graph_id()
                    << " somas size: " << kernel_graph->somas_whole_block_size();
+      // The single op graphs are cached by the pynative mode, keeping an arena for each of them wastes memory.
+      if (!kernel_graph->is_from_single_op() && (common::GetEnv(kSomasStaticArenaEnv) == "1")) {
+        AllocSomasStaticArena(kernel_graph);
+      }
     } else {
       MS_LOG(WARNING) << "Somas allocate failed for graph " << kernel_graph->graph_id();
     }
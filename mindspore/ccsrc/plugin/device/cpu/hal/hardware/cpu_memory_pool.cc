@@ -25,6 +25,8 @@ namespace cpu {
 namespace {
 const size_t kKBToByte = 1024;
 const size_t kLineMaxSize = 1024;
+// Serve the tensors from the size class bins and the thread caches instead of the best-fit pool.
+constexpr char kSizeClassMemPoolEnv[] = "MS_DEV_CPU_MEM_POOL_SIZE_CLASS";
 
 size_t GetSystemMemorySize(const std::string &key) {
 #if defined(_WIN32) || defined(_WIN64) || defined(__APPLE__)
@@ -64,6 +66,11 @@ size_t GetSystemMemorySize(const std::string &key) {
 }
 }  // namespace
 
+CPUMemoryPool::CPUMemoryPool() {
+  set_size_class_enabled(common::GetEnv(kSizeClassMemPoolEnv) == "1");
+  MS_LOG(INFO) << "The size class memory pool is " << (size_class_enabled() ? "enabled." : "disabled.");
+}
+
 size_t CPUMemoryPool::AllocDeviceMem(size_t alloc_size, DeviceMemPtr *addr) {
   if (alloc_size == 0) {
     MS_LOG(EXCEPTION) << "The memory alloc size is 0.";
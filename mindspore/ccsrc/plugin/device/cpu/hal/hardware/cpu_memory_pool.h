@@ -19,12 +19,12 @@
 
 #include <memory>
 #include "utils/ms_utils.h"
-#include "common/mem_reuse/mem_dynamic_allocator.h"
+#include "common/mem_reuse/mem_size_class_allocator.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-class BACKEND_EXPORT CPUMemoryPool : public DynamicMemPoolBestFit {
+class BACKEND_EXPORT CPUMemoryPool : public DynamicMemPoolSizeClass {
  public:
   ~CPUMemoryPool() override = default;
 
@@ -38,7 +38,7 @@ class BACKEND_EXPORT CPUMemoryPool : public DynamicMemPoolBestFit {
   size_t free_mem_size() override;
 
  private:
-  CPUMemoryPool() = default;
+  CPUMemoryPool();
   DISABLE_COPY_AND_ASSIGN(CPUMemoryPool);
 
   size_t total_used_memory_{0};
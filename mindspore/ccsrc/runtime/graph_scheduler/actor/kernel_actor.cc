@@ -15,6 +15,7 @@
  */
 
 #include "runtime/graph_scheduler/actor/kernel_actor.h"
+#include <algorithm>
 #include "runtime/graph_scheduler/actor/memory_manager_actor.h"
 #include "runtime/graph_scheduler/actor/output_actor.h"
 #include "runtime/graph_scheduler/actor/recorder_actor.h"
@@ -31,6 +32,10 @@ namespace {
 bool IsSomasEnable(const SomasInfo *somas_info) {
   return ((somas_info != nullptr) && (somas_info->whole_block_size_ != 0));
 }
+
+bool IsSomasStaticArena(const SomasInfo *somas_info) {
+  return ((somas_info != nullptr) && (somas_info->static_arena_ != nullptr));
+}
 }  // namespace
 
 using distributed::collective::CollectiveManager;
@@ -374,6 +379,25 @@ void KernelActor::SendMemoryFreeReq(OpContext<DeviceTensor> *const context) {
   }
 }
 
+bool KernelActor::IsMemoryFreeNeeded() const {
+  // Only the graph in the static somas arena skips the memory free, the other graphs keep the free request to make the
+  // memory reuse and the execution order of the memory manager actor unchanged.
+  if (!IsSomasStaticArena(somas_info_)) {
+    return memory_free_list_.size() > 0;
+  }
+  for (auto &copy_input_device_tensor : copy_input_device_tensors_) {
+    if ((copy_input_device_tensor != nullptr) && (copy_input_device_tensor->GetPtr() != nullptr)) {
+      return true;
+    }
+  }
+  // The device tensors taken over by the somas or persisted in the device tensor store have no reference count to
+  // decrease, the memory manager actor need not be called when all the device tensors are these ones.
+  return std::any_of(memory_free_list_.begin(), memory_free_list_.end(), [](const DeviceTensor *device_tensor) {
+    return (device_tensor == nullptr) || (device_tensor->original_ref_count() != SIZE_MAX) ||
+           (device_tensor->dynamic_ref_count() != INT32_MAX);
+  });
+}
+
 void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
   MS_EXCEPTION_IF_NULL(context);
   MS_EXCEPTION_IF_NULL(kernel_);
@@ -700,7 +724,7 @@ void KernelActor::PostLaunchKernel(OpContext<DeviceTensor> *const context) {
   // the next actor and the actor is asynchronous execution. So it is necessary to ensure that SendMemoryFreeReq of the
   // current actor is in front of SendMemoryAllocReq of the next actor. One is to reuse the memory more fully, the
   // other is to ensure the execution order and avoid the illegal memory timing problem.
-  if (memory_free_list_.size() > 0) {
+  if (IsMemoryFreeNeeded()) {
     SendMemoryFreeReq(context);
   }
 
@@ -152,6 +152,9 @@ class KernelActor : public DebugAwareActor {
   void PreLaunchKernel(OpContext<DeviceTensor> *const context);
   // The processing after kernel launch: 1.erase input, 2.free memory, 3.send output.
   void PostLaunchKernel(OpContext<DeviceTensor> *const context);
+  // Whether there is the memory to free after kernel launch, the graph in the static somas arena skips the free request
+  // when all the device tensors are taken over by the somas or persisted in the device tensor store.
+  bool IsMemoryFreeNeeded() const;
   // Back refresh the dynamic device tensor stores that have been triggered copy.
   void RefreshDeviceTensorCopyStore(OpContext<DeviceTensor> *const context);
 
@@ -80,6 +80,8 @@ using distributed::recovery::RecoveryContext;
 namespace {
 constexpr char kNumaEnableEnv[] = "MS_ENABLE_NUMA";
 constexpr char kNumaEnableEnv2[] = "DATASET_ENABLE_NUMA";
+// Schedule the actors on a run queue per actor thread with work stealing, instead of a queue shared by the threads.
+constexpr char kActorWorkStealingEnv[] = "MS_DEV_ACTOR_WORK_STEALING";
 
 // For the transform state synchronization.
 constexpr char kTransformFinishPrefix[] = "TRANSFORM_FINISH_";
@@ -400,13 +402,16 @@ void GraphScheduler::Initialize() {
   auto actor_manager = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actor_manager);
   size_t actor_queue_size = 81920;
-  auto ret = actor_manager->Initialize(true, actor_thread_num, actor_and_kernel_thread_num, actor_queue_size);
+  bool work_stealing = common::GetEnv(kActorWorkStealingEnv) == "1";
+  auto ret = actor_manager->Initialize(true, actor_thread_num, actor_and_kernel_thread_num, actor_queue_size,
+                                       work_stealing);
   if (ret != MINDRT_OK) {
     MS_LOG(EXCEPTION) << "Actor manager init failed.";
   }
   common::SetOMPThreadNum();
   MS_LOG(INFO) << "The actor thread number: " << actor_thread_num
-               << ", the kernel thread number: " << (actor_and_kernel_thread_num - actor_thread_num);
+               << ", the kernel thread number: " << (actor_and_kernel_thread_num - actor_thread_num)
+               << ", work stealing: " << work_stealing;
 
 #ifdef ENABLE_RPC_ACTOR
   // Create and initialize RpcNodeScheduler.
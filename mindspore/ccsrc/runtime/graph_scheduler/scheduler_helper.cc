@@ -587,6 +587,10 @@ void SchedulerHelper::AddMemoryAllocSign(AbstractActor *const from_actor, Abstra
   if (to_graph->somas_whole_block_size() == 0) {
     return;
   }
+  // The static arena of somas is allocated once before running, no need to alloc it in every step.
+  if (to_graph->is_somas_static_arena()) {
+    return;
+  }
 
   // Set the memory alloc info.
   to_actor->memory_alloc_insert_position_ = from_actor;
@@ -601,6 +605,10 @@ void SchedulerHelper::AddMemoryFreeSign(AbstractActor *const from_actor, Abstrac
   if (from_graph->somas_whole_block_size() == 0) {
     return;
   }
+  // The static arena of somas is allocated once before running, no need to free it in every step.
+  if (from_graph->is_somas_static_arena()) {
+    return;
+  }
 
   // Set the memory free info.
   from_actor->memory_free_insert_position_ = to_actor;
@@ -31,6 +31,7 @@ namespace mindspore {
 class ActorMgr;
 class ActorWorker;
 class ActorThreadPool;
+class MessagePool;
 
 // should be at least greater than 1
 constexpr uint32_t MAX_ACTOR_RECORD_SIZE = 3;
@@ -215,6 +216,8 @@ class MS_CORE_API ActorBase {
 
   ActorThreadPool *pool_{nullptr};
   std::shared_ptr<ActorMgr> actor_mgr_;
+  // recycles the messages this actor sends, created on the first run
+  MessagePool *msg_pool_{nullptr};
 };
 using ActorReference = std::shared_ptr<ActorBase>;
 };  // namespace mindspore
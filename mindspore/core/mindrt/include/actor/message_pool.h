@@ -0,0 +1,77 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MESSAGE_POOL_H
+#define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MESSAGE_POOL_H
+
+#include <atomic>
+#include <cstddef>
+
+#include "utils/macros.h"
+
+namespace mindspore {
+// Recycles the memory of the messages an actor sends. A message is allocated by the thread running the sending actor
+// and freed by the thread running the receiving actor once handled, the memory then goes back to the pool of the
+// sender, so an actor sending the same messages every step allocates nothing once warmed up.
+class MS_CORE_API MessagePool {
+ public:
+  // The largest message recycled, the larger ones and those sent from outside of an actor go to the heap.
+  static constexpr size_t kMaxMessageSize = 512;
+  // The most freed blocks the owner keeps for reuse each time it takes them back, the others go back to the heap, so
+  // a burst of messages does not keep its memory for the life of the actor.
+  static constexpr size_t kMaxCachedBlocks = 128;
+
+  MessagePool() = default;
+  ~MessagePool();
+
+  MessagePool(const MessagePool &) = delete;
+  MessagePool &operator=(const MessagePool &) = delete;
+
+  // allocate the memory of a message, from the pool of the actor running on the current thread if there is one
+  static void *Allocate(size_t size);
+
+  // free the memory of a message allocated by Allocate, from any thread
+  static void Free(void *ptr);
+
+  // make the pool the one of the actor running on the current thread, return the previous one
+  static MessagePool *SetCurrent(MessagePool *pool);
+
+  // called by the actor owning the pool when it is destroyed, the pool is deleted with the last message it allocated
+  void Release();
+
+  // the number of blocks the pool holds, cached or in flight, only read by the owner
+  size_t num_blocks() const { return num_blocks_; }
+
+ private:
+  struct Block;
+
+  // only called by the thread running the owning actor
+  Block *Take();
+  // called by any thread
+  void Give(Block *block);
+  void Unref();
+
+  // the blocks freed by the receivers, pushed by any thread and taken all at once by the owner
+  std::atomic<Block *> returned_{nullptr};
+  // the blocks taken by the owner
+  Block *cached_{nullptr};
+  // one for the owner, and one for each message allocated and not freed yet
+  std::atomic<size_t> refs_{1};
+  size_t num_blocks_{0};
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MESSAGE_POOL_H
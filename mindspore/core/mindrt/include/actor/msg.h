@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 
+#include <atomic>
 #include <utility>
 #include <string>
 
@@ -85,6 +86,9 @@ class MessageBase {
   size_t size;
 
   Type type;
+
+  // the link to the next message in the mailbox of the receiver, see MpscMailBox
+  std::atomic<MessageBase *> next{nullptr};
 };
 }  // namespace mindspore
 
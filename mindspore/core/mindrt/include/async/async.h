@@ -17,13 +17,16 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ASYNC_ASYNC_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ASYNC_ASYNC_H
 
+#include <new>
 #include <tuple>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 #include "actor/actor.h"
 #include "actor/log.h"
 #include "actor/actormgr.h"
+#include "actor/message_pool.h"
 #include "async/apply.h"
 #include "async/future.h"
 
@@ -40,8 +43,40 @@ class MessageAsync : public MessageBase {
   MessageHandler handler;
 };
 
+// calls a method returning void with the stored arguments, without the heap allocation of a std::function, and
+// recycles its memory through the message pool of the sending actor
+template <typename T, typename Method, typename Tuple>
+class MessageApply : public MessageBase {
+ public:
+  MessageApply(Method method, Tuple &&args)
+      : MessageBase("Async", Type::KASYNC), method(method), args(std::move(args)) {}
+  ~MessageApply() override = default;
+  void Run(ActorBase *actor) override {
+    MINDRT_ASSERT(actor != nullptr);
+    T *t = static_cast<T *>(actor);
+    MINDRT_ASSERT(t != nullptr);
+    Apply(t, method, args);
+  }
+
+  static void *operator new(size_t size, const std::nothrow_t &) noexcept { return MessagePool::Allocate(size); }
+  static void operator delete(void *ptr) noexcept { MessagePool::Free(ptr); }
+  static void operator delete(void *ptr, const std::nothrow_t &) noexcept { MessagePool::Free(ptr); }
+
+ private:
+  Method method;
+  Tuple args;
+};
+
 namespace internal {
 
+template <typename T, typename Method, typename Tuple>
+void AsyncApply(const AID &aid, Method method, Tuple &&tuple) {
+  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageApply<T, Method, typename std::decay<Tuple>::type>(
+    method, std::forward<Tuple>(tuple)));
+  MINDRT_OOM_EXIT(msg);
+  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+}
+
 template <typename R>
 struct AsyncHelper;
 
@@ -95,41 +130,17 @@ struct AsyncHelper {
 // return void
 template <typename T>
 void Async(const AID &aid, void (T::*method)()) {
-  std::function<void(ActorBase *)> handler = [method](ActorBase *actor) {
-    MINDRT_ASSERT(actor != nullptr);
-    T *t = static_cast<T *>(actor);
-    MINDRT_ASSERT(t != nullptr);
-    (t->*method)();
-  };
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::AsyncApply<T>(aid, method, std::tuple<>());
 }
 
 template <typename T, typename Arg0, typename Arg1>
 void Async(const AID &aid, void (T::*method)(Arg0), Arg1 &&arg) {
-  std::function<void(ActorBase *)> handler = [method, arg](ActorBase *actor) {
-    MINDRT_ASSERT(actor != nullptr);
-    T *t = static_cast<T *>(actor);
-    MINDRT_ASSERT(t != nullptr);
-    (t->*method)(arg);
-  };
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::AsyncApply<T>(aid, method, std::tuple<typename std::decay<Arg1>::type>(std::forward<Arg1>(arg)));
 }
 
 template <typename T, typename... Args0, typename... Args1>
 void Async(const AID &aid, void (T::*method)(Args0...), std::tuple<Args1...> &&tuple) {
-  std::function<void(ActorBase *)> handler = [method, tuple](ActorBase *actor) {
-    MINDRT_ASSERT(actor != nullptr);
-    T *t = static_cast<T *>(actor);
-    MINDRT_ASSERT(t != nullptr);
-    Apply(t, method, tuple);
-  };
-  auto msg = std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler)));
-  MINDRT_OOM_EXIT(msg);
-  (void)ActorMgr::GetActorMgrRef()->Send(aid, std::move(msg));
+  internal::AsyncApply<T>(aid, method, std::move(tuple));
 }
 
 template <typename T, typename... Args0, typename... Args1>
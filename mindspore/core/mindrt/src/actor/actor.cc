@@ -17,8 +17,21 @@
 #include "actor/actor.h"
 #include "actor/actormgr.h"
 #include "actor/iomgr.h"
+#include "actor/message_pool.h"
 
 namespace mindspore {
+namespace {
+// the messages sent while an actor runs come from its pool
+class CurrentMessagePool {
+ public:
+  explicit CurrentMessagePool(MessagePool *pool) : previous_(MessagePool::SetCurrent(pool)) {}
+  ~CurrentMessagePool() { (void)MessagePool::SetCurrent(previous_); }
+
+ private:
+  MessagePool *previous_;
+};
+}  // namespace
+
 ActorBase::ActorBase() : mailbox(nullptr), id("", ActorMgr::GetActorMgrRef()->GetUrl()), actionFunctions() {}
 
 ActorBase::ActorBase(const std::string &name)
@@ -27,7 +40,13 @@ ActorBase::ActorBase(const std::string &name)
 ActorBase::ActorBase(const std::string &name, ActorThreadPool *pool)
     : mailbox(nullptr), id(name, ActorMgr::GetActorMgrRef()->GetUrl()), actionFunctions(), pool_(pool) {}
 
-ActorBase::~ActorBase() {}
+ActorBase::~ActorBase() {
+  if (msg_pool_ != nullptr) {
+    // the messages still in flight keep the pool alive
+    msg_pool_->Release();
+    msg_pool_ = nullptr;
+  }
+}
 
 void ActorBase::Spawn(const std::shared_ptr<ActorBase>, std::unique_ptr<MailBox> mailboxPtr) {
   // lock here or await(). and unlock at Quit() or at await.
@@ -126,6 +145,10 @@ void ActorBase::Run() {
     return ERRORCODE_SUCCESS;
   };
 
+  if (msg_pool_ == nullptr) {
+    msg_pool_ = new (std::nothrow) MessagePool();
+  }
+  CurrentMessagePool current_pool(msg_pool_);
   if (this->mailbox->TakeAllMsgsEachTime()) {
     while (auto msgs = mailbox->GetMsgs()) {
       for (auto it = msgs->begin(); it != msgs->end(); ++it) {
@@ -49,7 +49,8 @@ ActorMgr::~ActorMgr() {
   }
 }
 
-int ActorMgr::Initialize(bool use_inner_pool, size_t actor_thread_num, size_t max_thread_num, size_t actor_queue_size) {
+int ActorMgr::Initialize(bool use_inner_pool, size_t actor_thread_num, size_t max_thread_num, size_t actor_queue_size,
+                         bool work_stealing) {
   bool expected = false;
   if (!initialized_.compare_exchange_strong(expected, true)) {
     MS_LOG(DEBUG) << "Actor Manager has been initialized before";
@@ -58,6 +59,7 @@ int ActorMgr::Initialize(bool use_inner_pool, size_t actor_thread_num, size_t ma
   // create inner thread pool only when specified use_inner_pool
   if (use_inner_pool) {
     ActorThreadPool::set_actor_queue_size(actor_queue_size);
+    ActorThreadPool::set_work_stealing(work_stealing);
     if (max_thread_num <= actor_thread_num) {
       inner_pool_ = ActorThreadPool::CreateThreadPool(actor_thread_num);
       if (inner_pool_ == nullptr) {
@@ -73,6 +75,8 @@ int ActorMgr::Initialize(bool use_inner_pool, size_t actor_thread_num, size_t ma
       inner_pool_->SetActorThreadNum(actor_thread_num);
       inner_pool_->SetKernelThreadNum(max_thread_num - actor_thread_num);
     }
+    // the thread pools created independently keep the shared actor queue
+    ActorThreadPool::set_work_stealing(false);
     if (inner_pool_ != nullptr) {
       inner_pool_->SetMaxSpinCount(kDefaultSpinCount);
       inner_pool_->SetSpinCountMaxValue();
@@ -246,7 +250,7 @@ AID ActorMgr::Spawn(const ActorReference &actor, bool shareThread) {
   MS_LOG(DEBUG) << "ACTOR was spawned,a=" << actor->GetAID().Name().c_str();
 
   if (shareThread) {
-    auto mailbox = std::make_unique<NonblockingMailBox>();
+    auto mailbox = std::make_unique<MpscMailBox>();
     auto hook = std::make_unique<std::function<void()>>([actor]() {
       auto actor_mgr = actor->get_actor_mgr();
       if (actor_mgr != nullptr) {
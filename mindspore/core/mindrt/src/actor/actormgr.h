@@ -53,8 +53,9 @@ class MS_CORE_API ActorMgr {
 
   void Finalize();
   // initialize actor manager resource, do not create inner thread pool by default
+  // work_stealing schedules the actors of the inner thread pool on a run queue per actor thread instead of a shared one
   int Initialize(bool use_inner_pool = false, size_t actor_thread_num = 1, size_t max_thread_num = 1,
-                 size_t actor_queue_size = kMaxHqueueSize);
+                 size_t actor_queue_size = kMaxHqueueSize, bool work_stealing = false);
 
   void RemoveActor(const std::string &name);
   ActorReference GetActor(const AID &id);
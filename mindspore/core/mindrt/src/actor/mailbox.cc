@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "actor/mailbox.h"
+#include <thread>
 
 namespace mindspore {
 int BlockingMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
@@ -70,6 +71,75 @@ std::list<std::unique_ptr<MessageBase>> *NonblockingMailBox::GetMsgs() {
   return ret;
 }
 
+MpscMailBox::~MpscMailBox() {
+  while (auto msg = Pop()) {
+    delete msg;
+  }
+}
+
+void MpscMailBox::Push(MessageBase *msg) {
+  msg->next.store(nullptr, std::memory_order_relaxed);
+  MessageBase *prev = head_.exchange(msg, std::memory_order_acq_rel);
+  // the consumer sees an empty queue until the link is stored
+  prev->next.store(msg, std::memory_order_release);
+}
+
+MessageBase *MpscMailBox::Pop() {
+  MessageBase *tail = tail_;
+  MessageBase *next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (next == nullptr) {
+      return nullptr;
+    }
+    tail_ = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+  if (tail != head_.load(std::memory_order_acquire)) {
+    // a producer is between its exchange and its link
+    return nullptr;
+  }
+  // the last message, put the stub behind it to be able to take it
+  Push(&stub_);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    tail_ = next;
+    return tail;
+  }
+  return nullptr;
+}
+
+int MpscMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
+  // count first, the consumer then keeps polling until the message is linked
+  bool empty = count_.fetch_add(1, std::memory_order_acq_rel) == 0;
+  Push(msg.release());
+  if (empty && notifyHook) {
+    (*notifyHook.get())();
+  }
+  return 0;
+}
+
+std::unique_ptr<MessageBase> MpscMailBox::GetMsg() {
+  while (true) {
+    MessageBase *msg = Pop();
+    if (msg != nullptr) {
+      ++taken_;
+      return std::unique_ptr<MessageBase>(msg);
+    }
+    size_t taken = taken_;
+    taken_ = 0;
+    if (count_.fetch_sub(taken, std::memory_order_acq_rel) == taken) {
+      return nullptr;
+    }
+    // enqueued but not linked yet
+    std::this_thread::yield();
+  }
+}
+
 int HQueMailBox::EnqueueMessage(std::unique_ptr<mindspore::MessageBase> msg) {
   bool empty = mailbox.Empty();
   MessageBase *msgPtr = msg.release();
@@ -16,6 +16,7 @@
 
 #ifndef MINDSPORE_MAILBOX_H
 #define MINDSPORE_MAILBOX_H
+#include <atomic>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -82,6 +83,31 @@ class NonblockingMailBox : public MailBox {
   bool released_ = true;
 };
 
+// an unbounded lock-free mailbox linking the messages through MessageBase::next, any thread enqueues and only the
+// thread running the actor takes, one message at a time
+// refer to Vyukov, "Intrusive MPSC node-based queue"
+class MpscMailBox : public MailBox {
+ public:
+  MpscMailBox() : head_(&stub_), tail_(&stub_) { takeAllMsgsEachTime = false; }
+  ~MpscMailBox() override;
+  int EnqueueMessage(std::unique_ptr<MessageBase> msg) override;
+  std::list<std::unique_ptr<MessageBase>> *GetMsgs() override { return nullptr; }
+  // returns nullptr only once every enqueued message was taken, the next enqueue then calls the notify hook again
+  std::unique_ptr<MessageBase> GetMsg() override;
+
+ private:
+  void Push(MessageBase *msg);
+  MessageBase *Pop();
+
+  MessageBase stub_;
+  // the producers only write head_, keep it away from the tail_ of the consumer
+  alignas(64) std::atomic<MessageBase *> head_;
+  alignas(64) MessageBase *tail_;
+  // the messages enqueued and not released by GetMsg yet, the hook is called when it leaves zero
+  std::atomic<size_t> count_{0};
+  size_t taken_{0};
+};
+
 class HQueMailBox : public MailBox {
  public:
   HQueMailBox() { takeAllMsgsEachTime = false; }
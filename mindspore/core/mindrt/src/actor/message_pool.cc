@@ -0,0 +1,134 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "actor/message_pool.h"
+
+#include <cstddef>
+#include <new>
+
+namespace mindspore {
+// the header in front of the memory of every message, keeps the message aligned like the heap does
+struct alignas(alignof(std::max_align_t)) MessagePool::Block {
+  // nullptr when the message was allocated from the heap
+  MessagePool *pool;
+  Block *next;
+};
+
+namespace {
+thread_local MessagePool *current_pool = nullptr;
+}  // namespace
+
+MessagePool::~MessagePool() {
+  Block *lists[] = {cached_, returned_.exchange(nullptr, std::memory_order_acquire)};
+  for (auto block : lists) {
+    while (block != nullptr) {
+      Block *next = block->next;
+      ::operator delete(block);
+      block = next;
+    }
+  }
+}
+
+void *MessagePool::Allocate(size_t size) {
+  MessagePool *pool = current_pool;
+  Block *block = nullptr;
+  if (pool != nullptr && size <= kMaxMessageSize) {
+    block = pool->Take();
+    if (block == nullptr) {
+      block = static_cast<Block *>(::operator new(sizeof(Block) + kMaxMessageSize, std::nothrow));
+      if (block == nullptr) {
+        return nullptr;
+      }
+      ++pool->num_blocks_;
+    }
+    (void)pool->refs_.fetch_add(1, std::memory_order_relaxed);
+    block->pool = pool;
+  } else {
+    block = static_cast<Block *>(::operator new(sizeof(Block) + size, std::nothrow));
+    if (block == nullptr) {
+      return nullptr;
+    }
+    block->pool = nullptr;
+  }
+  block->next = nullptr;
+  return block + 1;
+}
+
+void MessagePool::Free(void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  Block *block = static_cast<Block *>(ptr) - 1;
+  MessagePool *pool = block->pool;
+  if (pool == nullptr) {
+    ::operator delete(block);
+    return;
+  }
+  pool->Give(block);
+  pool->Unref();
+}
+
+MessagePool *MessagePool::SetCurrent(MessagePool *pool) {
+  MessagePool *previous = current_pool;
+  current_pool = pool;
+  return previous;
+}
+
+void MessagePool::Release() {
+  if (current_pool == this) {
+    current_pool = nullptr;
+  }
+  Unref();
+}
+
+MessagePool::Block *MessagePool::Take() {
+  if (cached_ == nullptr) {
+    // only the owner takes, and it takes the whole list at once, so a block can not come back under its feet
+    cached_ = returned_.exchange(nullptr, std::memory_order_acquire);
+    if (cached_ == nullptr) {
+      return nullptr;
+    }
+    // the blocks beyond the cap, left by a burst of messages, go back to the heap
+    Block *last = cached_;
+    for (size_t count = 1; last->next != nullptr && count < kMaxCachedBlocks; ++count) {
+      last = last->next;
+    }
+    Block *extra = last->next;
+    last->next = nullptr;
+    while (extra != nullptr) {
+      Block *next = extra->next;
+      ::operator delete(extra);
+      --num_blocks_;
+      extra = next;
+    }
+  }
+  Block *block = cached_;
+  cached_ = block->next;
+  return block;
+}
+
+void MessagePool::Give(Block *block) {
+  Block *head = returned_.load(std::memory_order_relaxed);
+  do {
+    block->next = head;
+  } while (!returned_.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void MessagePool::Unref() {
+  if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete this;
+  }
+}
+}  // namespace mindspore
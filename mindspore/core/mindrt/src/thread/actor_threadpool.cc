@@ -22,6 +22,16 @@
 
 namespace mindspore {
 size_t ActorThreadPool::actor_queue_size_ = kMaxHqueueSize;
+bool ActorThreadPool::work_stealing_ = false;
+
+namespace {
+constexpr int64_t kLocalActorQueueSize = 1024;
+// an actor thread takes from the shared actor queue first once in a while, so that its run queue can not starve it
+constexpr uint32_t kSharedQueueInterval = 61;
+// the pool and the index of the actor thread running on the current thread
+thread_local const ThreadPool *local_pool = nullptr;
+thread_local size_t local_index = 0;
+}  // namespace
 
 void ActorWorker::CreateThread() { thread_ = std::thread(&ActorWorker::RunWithSpin, this); }
 
@@ -38,6 +48,8 @@ void ActorWorker::RunWithSpin() {
   _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
   _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
 #endif
+  local_pool = pool_;
+  local_index = worker_id_;
   while (alive_) {
     // only run either local KernelTask or PoolQueue ActorTask
     if (RunLocalKernelTask() || RunQueueActorTask()) {
@@ -85,10 +97,10 @@ ActorThreadPool::~ActorThreadPool() {
   do {
     {
 #ifdef USE_HQUEUE
-      terminate = actor_queue_.Empty();
+      terminate = actor_queue_.Empty() && LocalQueuesEmpty();
 #else
       std::lock_guard<std::mutex> _l(actor_mutex_);
-      terminate = actor_queue_.empty();
+      terminate = actor_queue_.empty() && LocalQueuesEmpty();
 #endif
     }
     if (!terminate) {
@@ -109,24 +121,75 @@ ActorThreadPool::~ActorThreadPool() {
 }
 
 ActorBase *ActorThreadPool::PopActorFromQueue() {
+  // the run queue of the current actor thread first, the actors it made ready are likely still in its cache
+  bool local = local_pool == this && local_index < local_queues_.size();
+  if (local) {
+    thread_local uint32_t pop_count = 0;
+    if (++pop_count % kSharedQueueInterval != 0) {
+      auto actor = local_queues_[local_index]->Pop();
+      if (actor != nullptr) {
+        return actor;
+      }
+    }
+  }
 #ifdef USE_HQUEUE
-  return actor_queue_.Dequeue();
+  auto actor = actor_queue_.Dequeue();
 #else
-  std::lock_guard<std::mutex> _l(actor_mutex_);
-  if (actor_queue_.empty()) {
-    return nullptr;
+  ActorBase *actor = nullptr;
+  {
+    std::lock_guard<std::mutex> _l(actor_mutex_);
+    if (!actor_queue_.empty()) {
+      actor = actor_queue_.front();
+      actor_queue_.pop();
+    }
   }
-  auto actor = actor_queue_.front();
-  actor_queue_.pop();
-  return actor;
 #endif
+  if (actor == nullptr && local) {
+    actor = local_queues_[local_index]->Pop();
+    if (actor == nullptr) {
+      actor = StealActor(local_index);
+    }
+  }
+  return actor;
+}
+
+ActorBase *ActorThreadPool::StealActor(size_t thief) {
+  size_t queue_num = local_queues_.size();
+  // start from a random victim, so that the thieves do not all contend on the same run queue
+  thread_local uint32_t seed = static_cast<uint32_t>(thief + 1) * 2654435761U;
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  size_t start = seed % queue_num;
+  for (size_t i = 0; i < queue_num; ++i) {
+    size_t victim = (start + i) % queue_num;
+    if (victim == thief) {
+      continue;
+    }
+    auto actor = local_queues_[victim]->Steal();
+    if (actor != nullptr) {
+      return actor;
+    }
+  }
+  return nullptr;
+}
+
+bool ActorThreadPool::LocalQueuesEmpty() const {
+  for (auto &queue : local_queues_) {
+    if (!queue->Empty()) {
+      return false;
+    }
+  }
+  return true;
 }
 
 void ActorThreadPool::PushActorToQueue(ActorBase *actor) {
   if (!actor) {
     return;
   }
-  {
+  // an actor made ready by an actor thread runs on that thread, unless an idle actor thread steals it
+  bool pushed = local_pool == this && local_index < local_queues_.size() && local_queues_[local_index]->Push(actor);
+  if (!pushed) {
 #ifdef USE_HQUEUE
     while (!actor_queue_.Enqueue(actor)) {
     }
@@ -155,6 +218,21 @@ int ActorThreadPool::ActorQueueInit() {
   return THREAD_OK;
 }
 
+int ActorThreadPool::LocalQueuesInit() {
+  if (!work_stealing_) {
+    return THREAD_OK;
+  }
+  for (size_t i = 0; i < actor_thread_num_; ++i) {
+    (void)local_queues_.emplace_back(std::make_unique<WorkStealingDeque<ActorBase>>());
+    if (local_queues_[i]->Init(kLocalActorQueueSize) != true) {
+      THREAD_ERROR("init local actor queue failed.");
+      local_queues_.clear();
+      return THREAD_ERROR;
+    }
+  }
+  return THREAD_OK;
+}
+
 int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list) {
   if (actor_thread_num > all_thread_num) {
     THREAD_ERROR("thread num is invalid");
@@ -176,6 +254,10 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
   if (TaskQueuesInit(total_thread_num) != THREAD_OK) {
     return THREAD_ERROR;
   }
+  // the actor threads start taking actors as soon as they are created
+  if (LocalQueuesInit() != THREAD_OK) {
+    return THREAD_ERROR;
+  }
 
   if (ThreadPool::CreateThreads<ActorWorker>(actor_thread_num_, core_list) != THREAD_OK) {
     return THREAD_ERROR;
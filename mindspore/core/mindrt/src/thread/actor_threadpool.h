@@ -19,6 +19,7 @@
 
 #include <queue>
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
@@ -26,6 +27,7 @@
 #include "thread/core_affinity.h"
 #include "actor/actor.h"
 #include "thread/hqueue.h"
+#include "thread/work_stealing_deque.h"
 #ifndef USE_HQUEUE
 #define USE_HQUEUE
 #endif
@@ -58,11 +60,16 @@ class ActorThreadPool : public ThreadPool {
   ~ActorThreadPool() override;
 
   static void set_actor_queue_size(size_t actor_queue_size) { actor_queue_size_ = actor_queue_size; }
+  // Support to schedule the actors of the thread pools created afterwards on a run queue per actor thread: an actor
+  // made ready by an actor thread runs on that thread, the idle actor threads steal from the others.
+  static void set_work_stealing(bool work_stealing) { work_stealing_ = work_stealing; }
 
   virtual int ActorQueueInit();
   virtual void PushActorToQueue(ActorBase *actor);
   virtual ActorBase *PopActorFromQueue();
 
+  bool work_stealing() const { return !local_queues_.empty(); }
+
  protected:
   ActorThreadPool() = default;
 
@@ -73,12 +80,19 @@ class ActorThreadPool : public ThreadPool {
 #else
   std::queue<ActorBase *> actor_queue_;
 #endif
+  // The run queue of each actor thread when work stealing, the actor_queue_ then takes the actors made ready by the
+  // other threads and those overflowing a run queue.
+  std::vector<std::unique_ptr<WorkStealingDeque<ActorBase>>> local_queues_;
 
  private:
   int CreateThreads(size_t actor_thread_num, size_t all_thread_num, const std::vector<int> &core_list);
+  int LocalQueuesInit();
+  bool LocalQueuesEmpty() const;
+  ActorBase *StealActor(size_t thief);
 
   // Support to set the size of actor queue.
   static size_t actor_queue_size_;
+  static bool work_stealing_;
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_CORE_MINDRT_RUNTIME_ACTOR_THREADPOOL_H_
@@ -43,9 +43,17 @@ __all__ = ['set_sending_batches', 'load', '_init_device_info',
            'set_enable_shared_mem', 'get_enable_shared_mem',
            'set_enable_autotune', 'get_enable_autotune',
            'set_autotune_interval', 'get_autotune_interval',
+           'set_autotune_budget', 'get_autotune_budget',
+           'set_autotune_start_config', 'get_autotune_start_config',
            'set_auto_offload', 'get_auto_offload',
            'set_enable_watchdog', 'get_enable_watchdog',
            'set_fast_recovery', 'get_fast_recovery',
+           'set_state_history_size', 'get_state_history_size',
+           'set_lock_free_connector', 'get_lock_free_connector',
+           'set_mindrecord_mmap', 'get_mindrecord_mmap',
+           'set_async_read_depth', 'get_async_read_depth',
+           'set_tensor_pool_size', 'get_tensor_pool_size',
+           'set_shuffle_spill_dir', 'get_shuffle_spill_dir',
            'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval']
 
 INT32_MAX = 2147483647
@@ -483,7 +491,8 @@ def set_enable_autotune(enable, filepath_prefix=None):
 
     An example of the generated JSON file is as follows. "remark" file will conclude that if the dataset has been
     tuned or not. "summary" filed will show the tuned configuration of dataset pipeline. Users can modify scripts
-    based on the tuned result.
+    based on the tuned result. "config" field lists the same configuration, it is read by
+    `set_autotune_start_config` to start AutoTune of a later run from the tuned result.
 
     .. code-block::
 
@@ -495,6 +504,10 @@ def set_enable_autotune(enable, filepath_prefix=None):
                 "MapOp(ID:3)         (num_parallel_workers: 2, prefetch_size:64)",
                 "BatchOp(ID:2)       (num_parallel_workers: 8, prefetch_size:64)"
             ],
+            "config": [
+                {"op_name": "BatchOp", "num_parallel_workers": 8, "prefetch_size": 64},
+                ...
+            ],
             "tree": {
                 ...
             }
@@ -586,6 +599,89 @@ def get_autotune_interval():
     return _config.get_autotune_interval()
 
 
+def set_autotune_budget(cpu_util, memory_util):
+    """
+    Set the CPU and memory budget of AutoTune, as percentages of the CPU and memory of the whole system.
+
+    AutoTune does not give an operation more workers when the system CPU utilization would go above `cpu_util`,
+    and does not grow the queues when the system memory utilization is above `memory_util`. When the system is
+    over budget, AutoTune takes workers away from the least busy operation, or shrinks the largest queue, until
+    the utilization is back within the budget. The memory utilization includes the shared memory used by
+    the multiprocessing workers. The default budget is 100 for both, which means no budget.
+
+    Args:
+        cpu_util (Union[int, float]): Percentage of the system CPU the system may use, in range (0, 100].
+        memory_util (Union[int, float]): Percentage of the system memory the system may use, in range (0, 100].
+
+    Raises:
+        TypeError: If `cpu_util` or `memory_util` is not of type int or float.
+        ValueError: If `cpu_util` or `memory_util` is not within the range (0, 100].
+
+    Examples:
+        >>> # keep a quarter of the CPU and of the memory for the training process
+        >>> ds.config.set_autotune_budget(75, 75)
+    """
+    for name, value in (("cpu_util", cpu_util), ("memory_util", memory_util)):
+        if not isinstance(value, (int, float)) or isinstance(value, bool):
+            raise TypeError("{} must be of type int or float.".format(name))
+        if value <= 0 or value > 100:
+            raise ValueError("{} is not within the required range (0, 100].".format(name))
+    _config.set_autotune_budget(float(cpu_util), float(memory_util))
+
+
+def get_autotune_budget():
+    """
+    Get the CPU and memory budget of AutoTune.
+
+    Returns:
+        tuple[float, float], the percentages of the system CPU and memory the system may use.
+
+    Examples:
+        >>> cpu_util, memory_util = ds.config.get_autotune_budget()
+    """
+    return _config.get_autotune_cpu_budget(), _config.get_autotune_memory_budget()
+
+
+def set_autotune_start_config(json_filepath):
+    """
+    Set an AutoTune configuration file saved by a previous run, see `set_enable_autotune`, for AutoTune to
+    start from. The number of workers and the prefetch size of each operation are set from the file when the
+    pipeline starts, and AutoTune carries on tuning from there. The file is ignored with a warning if it does
+    not describe the same operations as the pipeline.
+
+    Args:
+        json_filepath (str): Path of the AutoTune configuration file, None or empty to start from the
+            configuration of the pipeline.
+
+    Raises:
+        TypeError: If `json_filepath` is not of type str.
+        RuntimeError: If `json_filepath` does not exist.
+
+    Examples:
+        >>> ds.config.set_enable_autotune(True, "/path/to/autotune_out")
+        >>> ds.config.set_autotune_start_config("/path/to/autotune_out_0.json")
+    """
+    json_filepath = replace_none(json_filepath, "")
+    if not isinstance(json_filepath, str):
+        raise TypeError("json_filepath must be of type str.")
+    if json_filepath and not os.path.isfile(json_filepath):
+        raise RuntimeError("The AutoTune configuration file {} does not exist.".format(json_filepath))
+    _config.set_autotune_start_config(json_filepath)
+
+
+def get_autotune_start_config():
+    """
+    Get the AutoTune configuration file AutoTune starts from.
+
+    Returns:
+        str, path of the AutoTune configuration file, empty if AutoTune starts from the configuration of the pipeline.
+
+    Examples:
+        >>> json_filepath = ds.config.get_autotune_start_config()
+    """
+    return _config.get_autotune_start_config()
+
+
 def get_enable_shared_mem():
     """
     Get the default state of shared mem enabled variable.
@@ -832,3 +928,235 @@ def get_fast_recovery():
         >>> is_fast_recovery = ds.config.get_fast_recovery()
     """
     return _config.get_fast_recovery()
+
+
+def set_state_history_size(size):
+    """
+    Set the number of steps whose pipeline state is kept when the fast recovery mode is enabled.
+    The state of each operation (sampler position, shuffle buffer and random generator, partial batch,
+    file offsets) is carried along with the rows sent to the model, and kept for the last `size` steps.
+    When the pipeline is reset to one of these steps, the new pipeline is restored to the state of the step
+    instead of skipping the rows before it, so the recovery time no longer grows with the step.
+    A step out of the kept range, or a pipeline with an operation whose state cannot be restored (such as zip,
+    concat or GeneratorDataset), falls back to skipping the rows. When set to 0, no state is kept.
+
+    Note:
+        - The default value is 0: the states are only kept when this is set together with the fast recovery mode.
+        - The states are kept in memory by the running pipeline, for the reset done within the same process (such
+          as the one after a failed step). They are not saved with the checkpoint of the network, so a job started
+          again from a checkpoint file recovers the dataset by skipping the rows.
+        - A shuffle operation keeps a copy of the rows of its buffer and of the rows it fetched during the kept
+          steps, so the memory it uses is about doubled.
+
+    Args:
+        size (int): The number of steps whose state is kept, in range [0, INT32_MAX].
+
+    Raises:
+        TypeError: If `size` is not of type int.
+        ValueError: If `size` < 0 or `size` > INT32_MAX.
+
+    Examples:
+        >>> ds.config.set_fast_recovery(True)
+        >>> ds.config.set_state_history_size(64)
+    """
+    if not isinstance(size, int) or isinstance(size, bool):
+        raise TypeError("size isn't of type int.")
+    if size < 0 or size > INT32_MAX:
+        raise ValueError("size is not within the required range [0, INT32_MAX].")
+    _config.set_state_history_size(size)
+
+
+def get_state_history_size():
+    """
+    Get the number of steps whose pipeline state is kept when the fast recovery mode is enabled.
+
+    Returns:
+        int, the number of steps whose state is kept, 0 if the pipeline is recovered by skipping rows.
+
+    Examples:
+        >>> state_history_size = ds.config.get_state_history_size()
+    """
+    return _config.get_state_history_size()
+
+
+def set_lock_free_connector(lock_free_connector):
+    """
+    Set whether the queues between the workers of a parallel operation (such as map) and its collector
+    are lock free ring buffers instead of mutex guarded queues. This reduces the synchronization overhead
+    when a large number of workers is used.
+
+    Args:
+        lock_free_connector (bool): Whether to use lock free ring buffers for the worker queues.
+
+    Raises:
+        TypeError: If `lock_free_connector` is not a boolean data type.
+
+    Examples:
+        >>> ds.config.set_lock_free_connector(True)
+    """
+    if not isinstance(lock_free_connector, bool):
+        raise TypeError("lock_free_connector must be a boolean dtype.")
+    _config.set_lock_free_connector(lock_free_connector)
+
+
+def get_lock_free_connector():
+    """
+    Get whether the worker queues of the dataset pipeline are lock free ring buffers.
+
+    Returns:
+        bool, whether lock free ring buffers are used for the worker queues.
+
+    Examples:
+        >>> lock_free_connector = ds.config.get_lock_free_connector()
+    """
+    return _config.get_lock_free_connector()
+
+
+def set_mindrecord_mmap(mindrecord_mmap):
+    """
+    Set whether MindDataset memory maps the MindRecord files. When enabled, the blob of a sample is read
+    from the mapped file instead of through a file stream, and a numeric column stored without compression
+    is passed on as a tensor that borrows the mapped memory, without any copy. Files which can not be
+    mapped are read through file streams as before.
+
+    Args:
+        mindrecord_mmap (bool): Whether to memory map the MindRecord files.
+
+    Raises:
+        TypeError: If `mindrecord_mmap` is not a boolean data type.
+
+    Examples:
+        >>> ds.config.set_mindrecord_mmap(True)
+    """
+    if not isinstance(mindrecord_mmap, bool):
+        raise TypeError("mindrecord_mmap must be a boolean dtype.")
+    _config.set_mindrecord_mmap(mindrecord_mmap)
+
+
+def get_mindrecord_mmap():
+    """
+    Get whether MindDataset memory maps the MindRecord files.
+
+    Returns:
+        bool, whether the MindRecord files are memory mapped.
+
+    Examples:
+        >>> mindrecord_mmap = ds.config.get_mindrecord_mmap()
+    """
+    return _config.get_mindrecord_mmap()
+
+
+def set_async_read_depth(depth):
+    """
+    Set the number of reads kept in flight for each file by TFRecordDataset, TextFileDataset, CSVDataset,
+    CLUEDataset and the datasets built on them. The files are read ahead in large blocks through io_uring,
+    or through a small pool of threads if io_uring is not available, so that a few parallel workers are
+    enough to keep the disk busy. When set to 0, each worker reads its file synchronously.
+
+    Args:
+        depth (int): The number of reads kept in flight for each file, in range [0, 64].
+
+    Raises:
+        TypeError: If `depth` is not of type int.
+        ValueError: If `depth` < 0 or `depth` > 64.
+
+    Examples:
+        >>> ds.config.set_async_read_depth(4)
+    """
+    if not isinstance(depth, int) or isinstance(depth, bool):
+        raise TypeError("depth isn't of type int.")
+    if depth < 0 or depth > 64:
+        raise ValueError("depth is not within the required range [0, 64].")
+    _config.set_async_read_depth(depth)
+
+
+def get_async_read_depth():
+    """
+    Get the number of reads kept in flight for each file by the file based datasets.
+
+    Returns:
+        int, the number of reads kept in flight for each file, 0 if the files are read synchronously.
+
+    Examples:
+        >>> depth = ds.config.get_async_read_depth()
+    """
+    return _config.get_async_read_depth()
+
+
+def set_tensor_pool_size(size):
+    """
+    Set the size of the tensor buffer pool of each pipeline, in MB. The pool keeps the data buffers of the
+    rows which have been consumed and hands them to the next rows of the same size, e.g. the rows concatenated
+    by a batch operation, instead of going through the system allocator for every tensor. The pool only keeps
+    up to `size` MB of free buffers. When set to 0, the tensors are allocated from the global memory pool.
+
+    The hits, misses and bytes held by the pool are recorded by the dataset profiler.
+
+    Args:
+        size (int): The size of the tensor buffer pool in MB, in range [0, INT32_MAX].
+
+    Raises:
+        TypeError: If `size` is not of type int.
+        ValueError: If `size` < 0 or `size` > INT32_MAX.
+
+    Examples:
+        >>> ds.config.set_tensor_pool_size(1024)
+    """
+    if not isinstance(size, int) or isinstance(size, bool):
+        raise TypeError("size isn't of type int.")
+    if size < 0 or size > INT32_MAX:
+        raise ValueError("size is not within the required range [0, INT32_MAX].")
+    _config.set_tensor_pool_size(size)
+
+
+def get_tensor_pool_size():
+    """
+    Get the size of the tensor buffer pool of each pipeline, in MB.
+
+    Returns:
+        int, the size of the tensor buffer pool in MB, 0 if the tensors are not pooled.
+
+    Examples:
+        >>> tensor_pool_size = ds.config.get_tensor_pool_size()
+    """
+    return _config.get_tensor_pool_size()
+
+
+def set_shuffle_spill_dir(spill_dir):
+    """
+    Set the directory the shuffle operations write their buffered rows to. With a large `buffer_size`, the
+    shuffle buffer can hold a large share of the dataset. When a directory is set, the shuffle operations
+    created afterwards only keep the location of each buffered row in memory, and write the rows themselves
+    to files of the directory, which are removed when the pipeline ends. Every row is then written and read
+    back once, which is slower than keeping it in memory, see the dataset profiler for the throughput of the
+    shuffle operation. The output is the same as when shuffling in memory.
+
+    Args:
+        spill_dir (str): Path of an existing directory, None or empty to keep the shuffle buffer in memory.
+
+    Raises:
+        TypeError: If `spill_dir` is not of type str.
+        RuntimeError: If `spill_dir` is not an existing directory.
+
+    Examples:
+        >>> ds.config.set_shuffle_spill_dir("/path/to/local/disk")
+    """
+    spill_dir = replace_none(spill_dir, "")
+    if not isinstance(spill_dir, str):
+        raise TypeError("spill_dir must be of type str.")
+    if spill_dir and not os.path.isdir(spill_dir):
+        raise RuntimeError("The shuffle spill directory {} does not exist.".format(spill_dir))
+    _config.set_shuffle_spill_dir(os.path.realpath(spill_dir) if spill_dir else "")
+
+
+def get_shuffle_spill_dir():
+    """
+    Get the directory the shuffle operations write their buffered rows to.
+
+    Returns:
+        str, path of the directory, empty if the shuffle buffer is kept in memory.
+
+    Examples:
+        >>> spill_dir = ds.config.get_shuffle_spill_dir()
+    """
+    return _config.get_shuffle_spill_dir()
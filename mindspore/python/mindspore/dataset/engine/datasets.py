@@ -134,15 +134,19 @@ class Shuffle(str, Enum):
     - Shuffle.GLOBAL: Shuffle both the files and samples.
     - Shuffle.FILES: Shuffle files only.
     - Shuffle.INFILE: Shuffle data within each file.
+    - Shuffle.PARTIAL: Shuffle blocks of samples of all the files, then samples within windows of blocks.
+      Only supported by MindDataset.
     """
     GLOBAL: str = "global"
     FILES: str = "files"
     INFILE: str = "infile"
+    PARTIAL: str = "partial"
 
 
 ShuffleToShuffleMode = {Shuffle.FILES: cde.ShuffleMode.FILES,
                         Shuffle.GLOBAL: cde.ShuffleMode.GLOBAL,
-                        Shuffle.INFILE: cde.ShuffleMode.INFILE}
+                        Shuffle.INFILE: cde.ShuffleMode.INFILE,
+                        Shuffle.PARTIAL: cde.ShuffleMode.PARTIAL}
 
 
 def shuffle_to_shuffle_mode(shuffle):
@@ -2020,6 +2024,8 @@ class SourceDataset(Dataset):
                 self.shuffle_flag = 1  # Files shuffle
             elif shuffle == Shuffle.INFILE:
                 self.shuffle_flag = 3  # Infile shuffle
+            elif shuffle == Shuffle.PARTIAL:
+                raise ValueError("'Shuffle.PARTIAL' is only supported by MindDataset.")
 
     def parse(self, children=None):
         raise NotImplementedError("Dataset has to implement parse method.")
@@ -122,7 +122,7 @@ class MindDataset(MappableDataset, UnionBaseDataset):
             Default: None, performs global shuffle. Bool type and Shuffle enum are both supported to pass in.
             If shuffle is False, no shuffling will be performed.
             If shuffle is True, performs global shuffle.
-            There are three levels of shuffling, desired shuffle enum defined by mindspore.dataset.Shuffle.
+            There are four levels of shuffling, desired shuffle enum defined by mindspore.dataset.Shuffle.
 
             - Shuffle.GLOBAL: Global shuffle of all rows of data in dataset, same as setting shuffle to True.
 
@@ -130,6 +130,11 @@ class MindDataset(MappableDataset, UnionBaseDataset):
 
             - Shuffle.INFILE: Keep the file sequence the same but shuffle the data within each file.
 
+            - Shuffle.PARTIAL: Shuffle blocks of consecutive rows of all the files, then the rows within windows
+              of blocks. The order is computed from the seed as the data is read instead of being kept in memory,
+              which suits datasets with a very large number of rows, and it does not depend on the number of
+              parallel workers.
+
         num_shards (int, optional): Number of shards that the dataset will be divided into. Default: None.
             When this argument is specified, 'num_samples' reflects the maximum sample number of per shard.
         shard_id (int, optional): The shard ID within `num_shards`. Default: None. This
@@ -31,7 +31,8 @@ from mindspore._c_dataengine import OutputFormat as Format
 from .validators import check_gnn_graphdata, check_gnn_get_all_nodes, check_gnn_get_all_edges, \
     check_gnn_get_nodes_from_edges, check_gnn_get_edges_from_nodes, check_gnn_get_all_neighbors, \
     check_gnn_get_sampled_neighbors, check_gnn_get_neg_sampled_neighbors, check_gnn_get_node_feature, \
-    check_gnn_get_edge_feature, check_gnn_random_walk, check_gnn_graph, check_gnn_get_graph_feature
+    check_gnn_get_edge_feature, check_gnn_random_walk, check_gnn_graph, check_gnn_get_graph_feature, \
+    check_gnn_get_sampled_subgraph
 from ..core.validator_helpers import replace_none
 from .datasets_user_defined import GeneratorDataset
 
@@ -102,6 +103,18 @@ class GraphData:
         auto_shutdown (bool, optional): Valid when `working_mode` is set to 'server',
             when the number of connected clients reaches `num_client` and no client is being connected,
             the server automatically exits. Default: True.
+        storage_format (str, optional): How the graph is kept in memory, now supports 'object'/'csr'. This
+            parameter is only valid when `working_mode` is set to 'local'. Default: 'object'.
+
+            - 'object', a node object and an edge object for each node and edge.
+
+            - 'csr', the nodes, the edges, their features and the adjacency lists in contiguous arrays,
+              which take less memory and are faster to sample from on large graphs.
+
+        snapshot_file (str, optional): Snapshot of the graph, only valid when `storage_format` is 'csr'.
+            The snapshot is written after the dataset is loaded if the file does not exist, and is mapped
+            in place of loading the dataset otherwise. A snapshot written from a `dataset_file` of another size
+            or modification time is rebuilt. Default: None, no snapshot.
 
     Raises:
         ValueError: If `dataset_file` does not exist or permission denied.
@@ -110,6 +123,8 @@ class GraphData:
         TypeError: If `hostname` is illegal.
         ValueError: If `port` is not in range [1024, 65535].
         ValueError: If `num_client` is not in range [1, 255].
+        ValueError: If `storage_format` is not 'object' or 'csr', or is 'csr' while `working_mode` is not 'local'.
+        ValueError: If `snapshot_file` is set while `storage_format` is not 'csr'.
 
     Supported Platforms:
         ``CPU``
@@ -123,16 +138,18 @@ class GraphData:
 
     @check_gnn_graphdata
     def __init__(self, dataset_file, num_parallel_workers=None, working_mode='local', hostname='127.0.0.1', port=50051,
-                 num_client=1, auto_shutdown=True):
+                 num_client=1, auto_shutdown=True, storage_format='object', snapshot_file=None):
         self._dataset_file = dataset_file
         self._working_mode = working_mode
         self.data_format = "mindrecord"
         if num_parallel_workers is None:
             num_parallel_workers = 1
+        if snapshot_file is None:
+            snapshot_file = ""
 
         if working_mode in ['local', 'client']:
             self._graph_data = GraphDataClient(self.data_format, dataset_file, num_parallel_workers, working_mode,
-                                               hostname, port)
+                                               hostname, port, storage_format, snapshot_file)
             atexit.register(self._stop)
 
         if working_mode == 'server':
@@ -394,6 +411,47 @@ class GraphData:
         return self._graph_data.get_sampled_neighbors(
             node_list, neighbor_nums, neighbor_types, DE_C_INTER_SAMPLING_STRATEGY.get(strategy)).as_array()
 
+    @check_gnn_get_sampled_subgraph
+    def get_sampled_subgraph(self, node_list, neighbor_nums, neighbor_types, feature_types,
+                             strategy=SamplingStrategy.RANDOM):
+        """
+        Get sampled neighbors and the node features of all the nodes sampled, in one call.
+
+        The result is the same as calling `get_sampled_neighbors` and then `get_node_feature` on the
+        sampled neighbors, while the graph is only queried once, which saves a round trip to the server
+        when `working_mode` is 'client'.
+
+        Args:
+            node_list (Union[list, numpy.ndarray]): The given list of nodes.
+            neighbor_nums (Union[list, numpy.ndarray]): Number of neighbors sampled per hop.
+            neighbor_types (Union[list, numpy.ndarray]): Neighbor type sampled per hop, type of each element in
+                neighbor_types should be int.
+            feature_types (Union[list, numpy.ndarray]): The given list of node feature types.
+            strategy (SamplingStrategy, optional): Sampling strategy. Default: SamplingStrategy.RANDOM.
+                It can be any of [SamplingStrategy.RANDOM, SamplingStrategy.EDGE_WEIGHT].
+
+        Returns:
+            list[numpy.ndarray], array of neighbors padded with -1 as `get_sampled_neighbors` returns,
+            followed by an array of features per feature type, with the default feature for the padding.
+
+        Examples:
+            >>> nodes = graph_data.get_all_nodes(node_type=1)
+            >>> neighbors, features = graph_data.get_sampled_subgraph(node_list=nodes, neighbor_nums=[2, 2],
+            ...                                                       neighbor_types=[2, 1], feature_types=[2])
+
+        Raises:
+            TypeError: If `node_list` is not list or ndarray.
+            TypeError: If `neighbor_nums` is not list or ndarray.
+            TypeError: If `neighbor_types` is not list or ndarray.
+            TypeError: If `feature_types` is not list or ndarray.
+        """
+        if not isinstance(strategy, SamplingStrategy):
+            raise TypeError("Wrong input type for strategy, should be enum of 'SamplingStrategy'.")
+        if self._working_mode == 'server':
+            raise Exception("This method is not supported when working mode is server.")
+        return [t.as_array() for t in self._graph_data.get_sampled_subgraph(
+            node_list, neighbor_nums, neighbor_types, DE_C_INTER_SAMPLING_STRATEGY.get(strategy), feature_types)]
+
     @check_gnn_get_neg_sampled_neighbors
     def get_neg_sampled_neighbors(self, node_list, neg_neighbor_num, neg_neighbor_type):
         """
@@ -898,6 +956,62 @@ class Graph(GraphData):
         return self._graph_data.get_sampled_neighbors(
             node_list, neighbor_nums, neighbor_int_types, DE_C_INTER_SAMPLING_STRATEGY.get(strategy)).as_array()
 
+    @check_gnn_get_sampled_subgraph
+    def get_sampled_subgraph(self, node_list, neighbor_nums, neighbor_types, feature_types,
+                             strategy=SamplingStrategy.RANDOM):
+        """
+        Get sampled neighbors and the node features of all the nodes sampled, in one call.
+
+        The result is the same as calling `get_sampled_neighbors` and then `get_node_feature` on the
+        sampled neighbors, while the graph is only queried once.
+
+        Args:
+            node_list (Union[list, numpy.ndarray]): The given list of nodes.
+            neighbor_nums (Union[list, numpy.ndarray]): Number of neighbors sampled per hop.
+            neighbor_types (Union[list, numpy.ndarray]): Neighbor type sampled per hop, type of each element in
+                neighbor_types should be str.
+            feature_types (Union[list, numpy.ndarray]): The given list of node feature types, each element should
+                be string.
+            strategy (SamplingStrategy, optional): Sampling strategy. Default: SamplingStrategy.RANDOM.
+                It can be any of [SamplingStrategy.RANDOM, SamplingStrategy.EDGE_WEIGHT].
+
+        Returns:
+            list[numpy.ndarray], array of neighbors padded with -1 as `get_sampled_neighbors` returns,
+            followed by an array of features per feature type, with the default feature for the padding.
+
+        Examples:
+            >>> nodes = graph.get_all_nodes(node_type="0")
+            >>> neighbors, features = graph.get_sampled_subgraph(node_list=nodes, neighbor_nums=[2, 2],
+            ...                                                  neighbor_types=["0", "0"],
+            ...                                                  feature_types=["node_feature_1"])
+
+        Raises:
+            TypeError: If `node_list` is not list or ndarray.
+            TypeError: If `neighbor_nums` is not list or ndarray.
+            TypeError: If `neighbor_types` is not list or ndarray.
+            TypeError: If `feature_types` is not list or ndarray.
+        """
+        if not isinstance(strategy, SamplingStrategy):
+            raise TypeError("Wrong input type for strategy, should be enum of 'SamplingStrategy'.")
+        if self._working_mode == 'server':
+            raise Exception("This method is not supported when working mode is server.")
+
+        neighbor_int_types = []
+        for neighbor_type in neighbor_types:
+            if neighbor_type not in self.node_type_mapping:
+                raise ValueError("Given neighbor node type {} is not exist in graph, existed is: {}."
+                                 .format(neighbor_type, list(self.node_type_mapping.keys())))
+            neighbor_int_types.append(self.node_type_mapping[neighbor_type])
+        feature_int_types = []
+        for feature_type in feature_types:
+            if feature_type not in self.node_feature_type_mapping:
+                raise ValueError("Given node feature type {} is not exist in graph, existed is: {}."
+                                 .format(feature_type, list(self.node_feature_type_mapping.keys())))
+            feature_int_types.append(self.node_feature_type_mapping[feature_type])
+        return [t.as_array() for t in self._graph_data.get_sampled_subgraph(
+            node_list, neighbor_nums, neighbor_int_types, DE_C_INTER_SAMPLING_STRATEGY.get(strategy),
+            feature_int_types)]
+
     @check_gnn_get_neg_sampled_neighbors
     def get_neg_sampled_neighbors(self, node_list, neg_neighbor_num, neg_neighbor_type):
         """
@@ -1899,7 +1899,7 @@ def check_gnn_graphdata(method):
     @wraps(method)
     def new_method(self, *args, **kwargs):
         [dataset_file, num_parallel_workers, working_mode, hostname,
-         port, num_client, auto_shutdown], _ = parse_user_args(method, *args, **kwargs)
+         port, num_client, auto_shutdown, storage_format, snapshot_file], _ = parse_user_args(method, *args, **kwargs)
         check_file(dataset_file)
         if num_parallel_workers is not None:
             check_num_parallel_workers(num_parallel_workers)
@@ -1914,6 +1914,15 @@ def check_gnn_graphdata(method):
         type_check(num_client, (int,), "num_client")
         check_value(num_client, (1, 255), "num_client")
         type_check(auto_shutdown, (bool,), "auto_shutdown")
+        type_check(storage_format, (str,), "storage_format")
+        if storage_format not in {'object', 'csr'}:
+            raise ValueError("Invalid storage format, please enter 'object' or 'csr'.")
+        if storage_format == 'csr' and working_mode != 'local':
+            raise ValueError("The 'csr' storage format is only supported when working_mode is 'local'.")
+        if snapshot_file is not None:
+            type_check(snapshot_file, (str,), "snapshot_file")
+            if storage_format != 'csr':
+                raise ValueError("snapshot_file is only supported when storage_format is 'csr'.")
         return method(self, *args, **kwargs)
 
     return new_method
@@ -2085,6 +2094,43 @@ def check_gnn_get_sampled_neighbors(method):
     return new_method
 
 
+def check_gnn_get_sampled_subgraph(method):
+    """A wrapper that wraps a parameter checker around the GNN `get_sampled_subgraph` function."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        [node_list, neighbor_nums, neighbor_types, feature_types, _], _ = parse_user_args(method, *args, **kwargs)
+
+        check_gnn_list_or_ndarray(node_list, 'node_list')
+
+        check_gnn_list_or_ndarray(neighbor_nums, 'neighbor_nums')
+        neighbor_nums = list(neighbor_nums)
+        if not neighbor_nums or len(neighbor_nums) > 6:
+            raise ValueError("Wrong number of input members for {0}, should be between 1 and 6, got {1}.".format(
+                'neighbor_nums', len(neighbor_nums)))
+
+        if "GraphData" in str(type(self)):
+            check_gnn_list_or_ndarray(neighbor_types, 'neighbor_types')
+            check_gnn_list_or_ndarray(feature_types, 'feature_types')
+        else:
+            check_gnn_list_or_ndarray(neighbor_types, 'neighbor_types', str)
+            check_gnn_list_or_ndarray(feature_types, 'feature_types', str)
+        neighbor_types = list(neighbor_types)
+        if not neighbor_types or len(neighbor_types) > 6:
+            raise ValueError("Wrong number of input members for {0}, should be between 1 and 6, got {1}.".format(
+                'neighbor_types', len(neighbor_types)))
+
+        if len(neighbor_nums) != len(neighbor_types):
+            raise ValueError(
+                "The number of members of neighbor_nums and neighbor_types is inconsistent.")
+        if not list(feature_types):
+            raise ValueError("Input feature_types can not be empty.")
+
+        return method(self, *args, **kwargs)
+
+    return new_method
+
+
 def check_gnn_get_neg_sampled_neighbors(method):
     """A wrapper that wraps a parameter checker around the GNN `get_neg_sampled_neighbors` function."""
 
@@ -2171,7 +2217,7 @@ def check_gnn_get_node_feature(method):
         if "GraphData" in str(type(self)):
             check_gnn_list_or_ndarray(feature_types, 'feature_types')
         else:
-            check_gnn_list_or_ndarray(feature_types, 'feature_types', data_type=str)
+            check_gnn_list_or_ndarray(feature_types, 'feature_types', str)
 
         return method(self, *args, **kwargs)
 
@@ -2209,7 +2255,7 @@ def check_gnn_get_edge_feature(method):
         if "GraphData" in str(type(self)):
             check_gnn_list_or_ndarray(feature_types, 'feature_types')
         else:
-            check_gnn_list_or_ndarray(feature_types, 'feature_types', data_type=str)
+            check_gnn_list_or_ndarray(feature_types, 'feature_types', str)
 
         return method(self, *args, **kwargs)
 
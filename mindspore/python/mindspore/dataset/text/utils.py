@@ -24,7 +24,8 @@ import numpy as np
 import mindspore._c_dataengine as cde
 from .validators import check_vocab, check_from_file, check_from_list, check_from_dict, check_from_dataset, \
     check_from_dataset_sentencepiece, check_from_file_sentencepiece, check_save_model, \
-    check_from_file_vectors, check_tokens_to_ids, check_ids_to_tokens
+    check_from_file_vectors, check_from_binary_vectors, check_convert_to_binary_vectors, \
+    check_tokens_to_ids, check_ids_to_tokens
 
 
 class CharNGram(cde.CharNGram):
@@ -61,6 +62,29 @@ class CharNGram(cde.CharNGram):
         max_vectors = max_vectors if max_vectors is not None else 0
         return super().from_file(file_path, max_vectors)
 
+    @classmethod
+    @check_from_binary_vectors
+    def from_binary(cls, file_path):
+        """
+        Build a `CharNGram` vector from a binary vector file written by `Vectors.convert_to_binary`.
+        The file is memory mapped instead of read into memory, so the workers which load the same file share it.
+
+        Args:
+            file_path (str): Path of the binary vector file.
+
+        Returns:
+            CharNGram, CharNGram vector build from a binary vector file.
+
+        Raises:
+            RuntimeError: If `file_path` is not a valid binary vector file.
+
+        Examples:
+            >>> import mindspore.dataset.text as text
+            >>> char_n_gram = text.CharNGram.from_binary("/path/to/binary/file")
+        """
+
+        return super().from_binary(file_path)
+
 
 class FastText(cde.FastText):
     """
@@ -97,6 +121,29 @@ class FastText(cde.FastText):
         max_vectors = max_vectors if max_vectors is not None else 0
         return super().from_file(file_path, max_vectors)
 
+    @classmethod
+    @check_from_binary_vectors
+    def from_binary(cls, file_path):
+        """
+        Build a FastText vector from a binary vector file written by `Vectors.convert_to_binary`.
+        The file is memory mapped instead of read into memory, so the workers which load the same file share it.
+
+        Args:
+            file_path (str): Path of the binary vector file.
+
+        Returns:
+            FastText, FastText vector build from a binary vector file.
+
+        Raises:
+            RuntimeError: If `file_path` is not a valid binary vector file.
+
+        Examples:
+            >>> import mindspore.dataset.text as text
+            >>> fast_text = text.FastText.from_binary("/path/to/binary/file")
+        """
+
+        return super().from_binary(file_path)
+
 
 class GloVe(cde.GloVe):
     """
@@ -133,6 +180,29 @@ class GloVe(cde.GloVe):
         max_vectors = max_vectors if max_vectors is not None else 0
         return super().from_file(file_path, max_vectors)
 
+    @classmethod
+    @check_from_binary_vectors
+    def from_binary(cls, file_path):
+        """
+        Build a GloVe vector from a binary vector file written by `Vectors.convert_to_binary`.
+        The file is memory mapped instead of read into memory, so the workers which load the same file share it.
+
+        Args:
+            file_path (str): Path of the binary vector file.
+
+        Returns:
+            GloVe, GloVe vector build from a binary vector file.
+
+        Raises:
+            RuntimeError: If `file_path` is not a valid binary vector file.
+
+        Examples:
+            >>> import mindspore.dataset.text as text
+            >>> glove = text.GloVe.from_binary("/path/to/binary/file")
+        """
+
+        return super().from_binary(file_path)
+
 
 class JiebaMode(IntEnum):
     """
@@ -374,6 +444,55 @@ class Vectors(cde.Vectors):
         max_vectors = max_vectors if max_vectors is not None else 0
         return super().from_file(file_path, max_vectors)
 
+    @classmethod
+    @check_from_binary_vectors
+    def from_binary(cls, file_path):
+        """
+        Build a vector from a binary vector file written by `Vectors.convert_to_binary`.
+        The file is memory mapped instead of read into memory, so the workers which load the same file share it.
+
+        Args:
+            file_path (str): Path of the binary vector file.
+
+        Returns:
+            Vectors, Vectors build from a binary vector file.
+
+        Raises:
+            RuntimeError: If `file_path` is not a valid binary vector file.
+
+        Examples:
+            >>> import mindspore.dataset.text as text
+            >>> vector = text.Vectors.from_binary("/path/to/binary/file")
+        """
+
+        return super().from_binary(file_path)
+
+    @classmethod
+    @check_convert_to_binary_vectors
+    def convert_to_binary(cls, file_path, binary_path, max_vectors=None):
+        """
+        Convert a pre-trained vector file to a binary vector file, which can be loaded by `from_binary` of
+        `Vectors`, `CharNGram`, `FastText` and `GloVe`. Only the tokens are kept in memory during the conversion.
+
+        Args:
+            file_path (str): Path of the file that contains the vectors.
+            binary_path (str): Path of the binary vector file to write.
+            max_vectors (int, optional): This can be used to limit the number of pre-trained vectors converted.
+                Default: None, no limit.
+
+        Raises:
+            RuntimeError: If `file_path` contains invalid data, or `binary_path` can not be written.
+            ValueError: If `max_vectors` is invalid.
+            TypeError: If `max_vectors` is not type of integer.
+
+        Examples:
+            >>> import mindspore.dataset.text as text
+            >>> text.Vectors.convert_to_binary("/path/to/vectors/file", "/path/to/binary/file")
+        """
+
+        max_vectors = max_vectors if max_vectors is not None else 0
+        super().convert_to_binary(file_path, binary_path, max_vectors)
+
 
 class Vocab:
     """
@@ -87,6 +87,7 @@ class FileWriter:
 
         self._shard_num = shard_num
         self._index_generator = True
+        self._columnar_index = False
         suffix_shard_size = len(str(self._shard_num - 1))
 
         if self._shard_num == 1:
@@ -156,6 +157,8 @@ class FileWriter:
             self._file_name = file_name
 
         self._header = header
+        # keep the columnar index up to date if the files are written with it
+        self._columnar_index = os.path.exists(self._file_name + ".idx")
         self._writer.open_for_append(self._file_name)
 
     def add_schema(self, content, desc=None):
@@ -326,6 +329,27 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_columnar_index(self, enable):
+        """
+        Set whether to write a columnar index file (with suffix `.idx`) next to each MindRecord file \
+        besides the database file. MindDataset opens the columnar index instead of the database file \
+        when it is valid, which makes opening a dataset with many MindRecord files much faster.
+
+        Args:
+            enable (bool): Whether to write the columnar index. Default: False.
+
+        Raises:
+            ParamValueError: If `enable` is not bool.
+
+        Examples:
+            >>> from mindspore.mindrecord import FileWriter
+            >>> writer = FileWriter(file_name="test.mindrecord", shard_num=1)
+            >>> writer.set_columnar_index(True)
+        """
+        if not isinstance(enable, bool):
+            raise ParamValueError("Parameter enable's type is not bool.")
+        self._columnar_index = enable
+
     def commit(self):
         """
         Flush data in memory to disk and generate the corresponding database files.
@@ -352,9 +376,10 @@ class FileWriter:
         ret = self._writer.commit()
         if self._index_generator:
             if self._append:
-                self._generator = ShardIndexGenerator(self._file_name, self._append)
+                self._generator = ShardIndexGenerator(self._file_name, self._append, self._columnar_index)
             elif len(self._paths) >= 1:
-                self._generator = ShardIndexGenerator(os.path.realpath(self._paths[0]), self._append)
+                self._generator = ShardIndexGenerator(os.path.realpath(self._paths[0]), self._append,
+                                                      self._columnar_index)
             self._generator.build()
             self._generator.write_to_db()
 
@@ -365,10 +390,10 @@ class FileWriter:
             if os.path.exists(item):
                 os.chmod(item, stat.S_IRUSR | stat.S_IWUSR)
                 mindrecord_files.append(item)
-            index_file = item + ".db"
-            if os.path.exists(index_file):
-                os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
-                index_files.append(index_file)
+            for index_file in (item + ".db", item + ".idx"):
+                if os.path.exists(index_file):
+                    os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
+                    index_files.append(index_file)
 
         logger.info("The list of mindrecord files created are: {}, and the list of index files are: {}".format(
             mindrecord_files, index_files))
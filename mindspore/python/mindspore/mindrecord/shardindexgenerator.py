@@ -31,12 +31,13 @@ class ShardIndexGenerator:
     Args:
         path (str): Absolute path of MindRecord File.
         append (bool): If True, open existed MindRecord Files for appending, or create new MindRecord Files.
+        columnar_index (bool): If True, write a columnar index file next to each MindRecord File as well.
 
     Raises:
         MRMIndexGeneratorError: If failed to create index generator.
     """
-    def __init__(self, path, append=False):
-        self._generator = ms.ShardIndexGenerator(path, append)
+    def __init__(self, path, append=False, columnar_index=False):
+        self._generator = ms.ShardIndexGenerator(path, append, columnar_index)
         if not self._generator:
             logger.critical("Failed to create index generator.")
             raise MRMIndexGeneratorError
@@ -0,0 +1,147 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/util/async_file_reader.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestAsyncFileReader : public UT::Common {
+ public:
+  MindDataTestAsyncFileReader() {}
+
+  void TearDown() override {
+    for (auto &file : files_) {
+      (void)std::remove(file.c_str());
+    }
+  }
+
+  // Write a file of random lines, with empty lines and without a trailing '\n'.
+  std::string MakeFile(const std::string &name, int64_t size) {
+    std::string file = "./" + name;
+    std::mt19937 rng(static_cast<uint32_t>(size));
+    std::uniform_int_distribution<int> len_dist(0, 300);
+    std::uniform_int_distribution<int> chr_dist(0, 255);
+    std::string content;
+    while (static_cast<int64_t>(content.size()) < size) {
+      int len = len_dist(rng);
+      for (int i = 0; i < len; ++i) {
+        char c = static_cast<char>(chr_dist(rng));
+        content.push_back(c == '\n' ? 'x' : c);
+      }
+      content.push_back('\n');
+    }
+    content.resize(size);
+    std::ofstream out(file, std::ios::binary);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+    out.close();
+    files_.push_back(file);
+    return file;
+  }
+
+  std::vector<std::string> files_;
+};
+
+/// Feature: AsyncFileReader
+/// Description: Read files of various sizes line by line with every backend
+/// Expectation: The lines are the same as the lines read by std::getline
+TEST_F(MindDataTestAsyncFileReader, TestGetLine) {
+  std::vector<int64_t> sizes = {0, 1, 4095, AsyncFileReader::kBlockSize, 3 * AsyncFileReader::kBlockSize + 123};
+  auto pool = std::make_shared<IoThreadPool>(4);
+  for (auto size : sizes) {
+    std::string file = MakeFile("async_file_reader_" + std::to_string(size) + ".txt", size);
+    std::vector<std::string> expected;
+    std::ifstream handle(file);
+    std::string line;
+    while (getline(handle, line)) {
+      expected.push_back(line);
+    }
+    for (int32_t depth : {0, 1, 4, 16}) {
+      for (auto &reader_pool : {pool, std::shared_ptr<IoThreadPool>()}) {
+        std::unique_ptr<AsyncFileReader> reader;
+        ASSERT_OK(AsyncFileReader::Open(file, depth, reader_pool, &reader));
+        std::vector<std::string> lines;
+        while (reader->GetLine(&line)) {
+          lines.push_back(line);
+        }
+        EXPECT_OK(reader->GetError());
+        EXPECT_EQ(lines, expected) << "size: " << size << ", depth: " << depth << ", " << reader->BackendName();
+      }
+    }
+  }
+}
+
+/// Feature: AsyncFileReader
+/// Description: Mix Peek, Get, Read and Ignore across the buffer boundaries
+/// Expectation: The bytes are the same as the content of the file
+TEST_F(MindDataTestAsyncFileReader, TestReadAndIgnore) {
+  int64_t size = 2 * AsyncFileReader::kBlockSize + 7;
+  std::string file = MakeFile("async_file_reader_read.bin", size);
+  std::ifstream handle(file, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(handle)), std::istreambuf_iterator<char>());
+  ASSERT_EQ(static_cast<int64_t>(content.size()), size);
+
+  auto pool = std::make_shared<IoThreadPool>(2);
+  std::unique_ptr<AsyncFileReader> reader;
+  ASSERT_OK(AsyncFileReader::Open(file, 3, pool, &reader));
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int64_t> step_dist(1, AsyncFileReader::kBlockSize / 3);
+  int64_t pos = 0;
+  while (pos < size) {
+    int64_t step = step_dist(rng);
+    int64_t expected = std::min(step, size - pos);
+    ASSERT_EQ(reader->Peek(), static_cast<unsigned char>(content[pos]));
+    if (step % 3 == 0) {
+      ASSERT_EQ(reader->Ignore(step), expected);
+    } else if (step % 3 == 1) {
+      ASSERT_EQ(reader->Get(), static_cast<unsigned char>(content[pos]));
+      expected = 1;
+    } else {
+      std::string buffer(step, '\0');
+      ASSERT_EQ(reader->Read(&buffer[0], step), expected);
+      ASSERT_EQ(buffer.substr(0, expected), content.substr(pos, expected));
+    }
+    pos += expected;
+  }
+  EXPECT_EQ(reader->Peek(), AsyncFileReader::kEof);
+  EXPECT_EQ(reader->Get(), AsyncFileReader::kEof);
+  char c;
+  EXPECT_EQ(reader->Read(&c, 1), 0);
+  EXPECT_OK(reader->GetError());
+}
+
+/// Feature: AsyncFileReader
+/// Description: Close readers before they have consumed the file
+/// Expectation: The reads in flight are waited for, nothing is leaked or corrupted
+TEST_F(MindDataTestAsyncFileReader, TestCloseEarly) {
+  std::string file = MakeFile("async_file_reader_early.txt", 5 * AsyncFileReader::kBlockSize);
+  auto pool = std::make_shared<IoThreadPool>(1);
+  for (int i = 0; i < 10; ++i) {
+    std::unique_ptr<AsyncFileReader> reader;
+    ASSERT_OK(AsyncFileReader::Open(file, 8, pool, &reader));
+    std::string line;
+    EXPECT_TRUE(reader->GetLine(&line));
+  }
+  std::unique_ptr<AsyncFileReader> reader;
+  EXPECT_ERROR(AsyncFileReader::Open("./async_file_reader_not_exist.txt", 4, pool, &reader));
+}
@@ -0,0 +1,148 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/data/duplicate_op.h"
+#include "minddata/dataset/kernels/data/one_hot_op.h"
+#include "minddata/dataset/kernels/data/unique_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestBatchCompute : public UT::Common {
+ public:
+  MindDataTestBatchCompute() {}
+
+  // Random tensor of the given shape and type.
+  template <typename T>
+  std::shared_ptr<Tensor> RandomTensor(const TensorShape &shape, int max_value = 255) {
+    std::mt19937 rng(static_cast<uint32_t>(shape.NumOfElements()));
+    std::uniform_int_distribution<int> dist(0, max_value);
+    std::vector<T> values(shape.NumOfElements());
+    for (auto &value : values) {
+      value = static_cast<T>(dist(rng));
+    }
+    std::shared_ptr<Tensor> tensor;
+    EXPECT_OK(Tensor::CreateFromVector(values, shape, &tensor));
+    return tensor;
+  }
+
+  // Checks that the batched kernel of an op gives exactly the result of the per-row execution of the batch.
+  void CheckSameAsPerRow(const std::shared_ptr<TensorOp> &op, const std::shared_ptr<Tensor> &input) {
+    ASSERT_TRUE(op->SupportsBatchCompute());
+    TensorRow batch(0, {input});
+    std::vector<TensorShape> input_shapes;
+    for (const auto &tensor : batch) {
+      input_shapes.push_back(tensor->shape());
+    }
+    TensorRow expected;
+    ASSERT_OK(op->TensorOp::BatchCompute(batch, &expected));
+    TensorRow output;
+    ASSERT_OK(op->BatchCompute(batch, &output));
+    ASSERT_EQ(output.size(), expected.size());
+    for (size_t i = 0; i < output.size(); i++) {
+      EXPECT_EQ(output[i]->shape(), expected[i]->shape()) << op->Name() << ", input: " << batch[0]->shape();
+      EXPECT_EQ(*output[i], *expected[i]) << op->Name() << ", input: " << batch[0]->shape();
+    }
+    // the input batch is left as it was
+    for (size_t i = 0; i < batch.size(); i++) {
+      EXPECT_EQ(batch[i]->shape(), input_shapes[i]);
+    }
+  }
+};
+
+/// Feature: BatchCompute
+/// Description: Normalize batches of HWC, CHW and gray images, and batches of batches
+/// Expectation: The batched kernel gives exactly the result of the per-row execution
+TEST_F(MindDataTestBatchCompute, TestNormalize) {
+  std::vector<float> mean = {123.675, 116.28, 103.53};
+  std::vector<float> std = {58.395, 57.12, 57.375};
+  auto hwc = std::make_shared<NormalizeOp>(mean, std, true);
+  CheckSameAsPerRow(hwc, RandomTensor<uint8_t>(TensorShape({4, 5, 6, 3})));
+  CheckSameAsPerRow(hwc, RandomTensor<float>(TensorShape({1, 7, 2, 3})));
+  CheckSameAsPerRow(hwc, RandomTensor<uint8_t>(TensorShape({2, 3, 5, 6, 3})));
+  auto chw = std::make_shared<NormalizeOp>(mean, std, false);
+  CheckSameAsPerRow(chw, RandomTensor<uint8_t>(TensorShape({4, 3, 5, 6})));
+  CheckSameAsPerRow(chw, RandomTensor<int32_t>(TensorShape({2, 3, 3, 5, 6})));
+  // a single mean and std value applies to every channel
+  auto gray = std::make_shared<NormalizeOp>(std::vector<float>{127.5}, std::vector<float>{127.5}, false);
+  CheckSameAsPerRow(gray, RandomTensor<uint8_t>(TensorShape({4, 3, 5, 6})));
+  CheckSameAsPerRow(gray, RandomTensor<uint8_t>(TensorShape({4, 5, 6})));
+  gray = std::make_shared<NormalizeOp>(std::vector<float>{127.5}, std::vector<float>{127.5}, true);
+  CheckSameAsPerRow(gray, RandomTensor<uint8_t>(TensorShape({4, 5, 6})));
+
+  // the errors of the rows are reported for the batch
+  TensorRow output;
+  EXPECT_ERROR(chw->BatchCompute(TensorRow(0, {RandomTensor<uint8_t>(TensorShape({4, 5, 6, 3}))}), &output));
+  output.clear();
+  EXPECT_ERROR(hwc->BatchCompute(TensorRow(0, {RandomTensor<uint8_t>(TensorShape({4, 6}))}), &output));
+}
+
+/// Feature: BatchCompute
+/// Description: OneHot on batches of scalar labels, of single labels and of label sequences
+/// Expectation: The batched kernel gives exactly the result of the per-row execution, shapes included
+TEST_F(MindDataTestBatchCompute, TestOneHot) {
+  auto one_hot = std::make_shared<OneHotOp>(10, 0.0);
+  CheckSameAsPerRow(one_hot, RandomTensor<int32_t>(TensorShape({5}), 9));
+  CheckSameAsPerRow(one_hot, RandomTensor<int32_t>(TensorShape({5, 1}), 9));
+  CheckSameAsPerRow(one_hot, RandomTensor<int32_t>(TensorShape({1}), 9));
+  CheckSameAsPerRow(one_hot, RandomTensor<uint8_t>(TensorShape({3, 4}), 9));
+  CheckSameAsPerRow(std::make_shared<OneHotOp>(10, 0.1), RandomTensor<int64_t>(TensorShape({6}), 9));
+
+  TensorRow output;
+  ASSERT_OK(one_hot->BatchCompute(TensorRow(0, {RandomTensor<int32_t>(TensorShape({5}), 9)}), &output));
+  EXPECT_EQ(output[0]->shape(), TensorShape({5, 10}));
+  output.clear();
+  EXPECT_ERROR(one_hot->BatchCompute(TensorRow(0, {RandomTensor<int32_t>(TensorShape({5, 2, 2}), 9)}), &output));
+}
+
+/// Feature: BatchCompute
+/// Description: Ops without a batched kernel on numeric and string batches
+/// Expectation: The rows are processed one by one and stacked, rows of different shapes are reported
+TEST_F(MindDataTestBatchCompute, TestPerRowFallback) {
+  auto duplicate = std::make_shared<DuplicateOp>();
+  EXPECT_FALSE(duplicate->SupportsBatchCompute());
+  std::shared_ptr<Tensor> numbers = RandomTensor<int64_t>(TensorShape({3, 2}));
+  TensorRow output;
+  ASSERT_OK(duplicate->BatchCompute(TensorRow(0, {numbers}), &output));
+  ASSERT_EQ(output.size(), 2);
+  EXPECT_EQ(*output[0], *numbers);
+  EXPECT_EQ(*output[1], *numbers);
+
+  std::shared_ptr<Tensor> strings;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<std::string>{"a", "bc", "", "def"}, TensorShape({4}), &strings));
+  output.clear();
+  ASSERT_OK(duplicate->BatchCompute(TensorRow(0, {strings}), &output));
+  ASSERT_EQ(output.size(), 2);
+  EXPECT_EQ(*output[1], *strings);
+
+  // Unique gives rows of different shapes, which can not be stacked
+  std::shared_ptr<Tensor> ragged;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<int32_t>{1, 1, 2, 1, 2, 3}, TensorShape({2, 3}), &ragged));
+  output.clear();
+  EXPECT_ERROR(std::make_shared<UniqueOp>()->BatchCompute(TensorRow(0, {ragged}), &output));
+  // scalars are not batches
+  std::shared_ptr<Tensor> scalar;
+  ASSERT_OK(Tensor::CreateScalar<int32_t>(1, &scalar));
+  output.clear();
+  EXPECT_ERROR(duplicate->BatchCompute(TensorRow(0, {scalar}), &output));
+}
@@ -13,6 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -5239,3 +5243,126 @@ TEST_F(MindDataTestPipeline, TestCharNGramsWithNotExistFile) {
   Status s = CharNGram::BuildFromFile(&char_n_gram, vectors_dir);
   EXPECT_NE(s, Status::OK());
 }
+
+/// Feature: Vectors
+/// Description: Test ConvertToBinary and BuildFromBinary, then ToVectors on the mapped vectors
+/// Expectation: The mapped vectors look up the same vectors as those read from the text file
+TEST_F(MindDataTestPipeline, TestVectorsFromBinary) {
+  MS_LOG(INFO) << "Doing MindDataTestPipeline-TestVectorsFromBinary.";
+  std::string vectors_dir = datasets_root_path_ + "/testVectors/vectors.txt";
+  std::string binary_dir = "./test_vectors_from_binary.bin";
+  ASSERT_OK(Vectors::ConvertToBinary(vectors_dir, binary_dir));
+  std::shared_ptr<Vectors> vectors;
+  ASSERT_OK(Vectors::BuildFromFile(&vectors, vectors_dir));
+  std::shared_ptr<Vectors> binary_vectors;
+  ASSERT_OK(Vectors::BuildFromBinary(&binary_vectors, binary_dir));
+  EXPECT_EQ(binary_vectors->Dim(), vectors->Dim());
+
+  std::vector<float> unknown_init(6, -1);
+  for (const std::string token : {"ok", "!", "this", "is", "my", "home", ".", "none", "", "This", "HOME"}) {
+    EXPECT_EQ(binary_vectors->Lookup(token), vectors->Lookup(token));
+    EXPECT_EQ(binary_vectors->Lookup(token, unknown_init, true), vectors->Lookup(token, unknown_init, true));
+  }
+
+  // Create a TextFile dataset
+  std::string data_file = datasets_root_path_ + "/testVectors/words.txt";
+  std::shared_ptr<Dataset> ds = TextFile({data_file}, 0, ShuffleMode::kFalse);
+  EXPECT_NE(ds, nullptr);
+  std::shared_ptr<TensorTransform> lookup = std::make_shared<text::ToVectors>(binary_vectors);
+  ds = ds->Map({lookup}, {"text"});
+  EXPECT_NE(ds, nullptr);
+  std::shared_ptr<Iterator> iter = ds->CreateIterator();
+  EXPECT_NE(iter, nullptr);
+
+  std::unordered_map<std::string, mindspore::MSTensor> row;
+  ASSERT_OK(iter->GetNextRow(&row));
+  uint64_t i = 0;
+  std::vector<std::vector<float>> expected = {{0.418, 0.24968, -0.41242, 0.1217, 0.34527, -0.04445718411},
+                                              {0, 0, 0, 0, 0, 0},
+                                              {0.15164, 0.30177, -0.16763, 0.17684, 0.31719, 0.33973},
+                                              {0.70853, 0.57088, -0.4716, 0.18048, 0.54449, 0.72603},
+                                              {0.68047, -0.039263, 0.30186, -0.17792, 0.42962, 0.032246},
+                                              {0.26818, 0.14346, -0.27877, 0.016257, 0.11384, 0.69923},
+                                              {0, 0, 0, 0, 0, 0}};
+  while (row.size() != 0) {
+    auto ind = row["text"];
+    TensorPtr de_expected_item;
+    dsize_t dim = 6;
+    ASSERT_OK(Tensor::CreateFromVector(expected[i], TensorShape({dim}), &de_expected_item));
+    mindspore::MSTensor ms_expected_item =
+      mindspore::MSTensor(std::make_shared<mindspore::dataset::DETensor>(de_expected_item));
+    EXPECT_MSTENSOR_EQ(ind, ms_expected_item);
+    ASSERT_OK(iter->GetNextRow(&row));
+    i++;
+  }
+  EXPECT_EQ(i, 7);
+
+  // Manually terminate the pipeline
+  iter->Stop();
+  (void)std::remove(binary_dir.c_str());
+}
+
+/// Feature: CharNGram
+/// Description: Test BuildFromBinary of CharNGram, which looks up the n-grams of a token in the mapped vectors
+/// Expectation: The mapped vectors look up the same vectors as those read from the text file
+TEST_F(MindDataTestPipeline, TestCharNGramFromBinary) {
+  MS_LOG(INFO) << "Doing MindDataTestPipeline-TestCharNGramFromBinary.";
+  std::string vectors_dir = datasets_root_path_ + "/testVectors/char_n_gram_20.txt";
+  std::string binary_dir = "./test_char_n_gram_from_binary.bin";
+  ASSERT_OK(Vectors::ConvertToBinary(vectors_dir, binary_dir));
+  std::shared_ptr<CharNGram> char_n_gram;
+  ASSERT_OK(CharNGram::BuildFromFile(&char_n_gram, vectors_dir));
+  std::shared_ptr<CharNGram> binary_char_n_gram;
+  ASSERT_OK(CharNGram::BuildFromBinary(&binary_char_n_gram, binary_dir));
+
+  std::vector<float> unknown_init(5, -1);
+  for (const std::string token : {"ok", "!", "This", "iS", "my", "HOME", ".", "the", "eat"}) {
+    EXPECT_EQ(binary_char_n_gram->Lookup(token), char_n_gram->Lookup(token));
+    EXPECT_EQ(binary_char_n_gram->Lookup(token, unknown_init, true), char_n_gram->Lookup(token, unknown_init, true));
+  }
+  (void)std::remove(binary_dir.c_str());
+}
+
+/// Feature: Vectors
+/// Description: Test BuildFromBinary with a text vector file and a file that is not exist
+/// Expectation: Throw correct error and message
+TEST_F(MindDataTestPipeline, TestVectorsFromBinaryWithWrongFile) {
+  MS_LOG(INFO) << "Doing MindDataTestPipeline-TestVectorsFromBinaryWithWrongFile.";
+  std::shared_ptr<Vectors> vectors;
+  EXPECT_ERROR(Vectors::BuildFromBinary(&vectors, datasets_root_path_ + "/testVectors/vectors.txt"));
+  EXPECT_ERROR(Vectors::BuildFromBinary(&vectors, datasets_root_path_ + "/testVectors/no_vectors.bin"));
+  EXPECT_ERROR(Vectors::ConvertToBinary(datasets_root_path_ + "/testVectors/vectors_empty.txt", "./empty.bin"));
+  EXPECT_NE(access("./empty.bin", F_OK), 0);
+  EXPECT_NE(access("./empty.bin.tmp", F_OK), 0);
+}
+
+/// Feature: Vectors
+/// Description: Test BuildFromBinary with binary vector files whose header has sizes out of the file
+/// Expectation: Throw correct error and message
+TEST_F(MindDataTestPipeline, TestVectorsFromBinaryWithCorruptedHeader) {
+  MS_LOG(INFO) << "Doing MindDataTestPipeline-TestVectorsFromBinaryWithCorruptedHeader.";
+  std::string binary_dir = "./test_vectors_corrupted_header.bin";
+  // Offsets of the dimension and of the tokens offset in the header
+  const std::streamoff dim_offset = 12;
+  const std::streamoff tokens_offset = 24;
+  auto build_corrupted = [&binary_dir](std::streamoff offset, const char *value, std::streamsize size) {
+    std::fstream file(binary_dir, std::ios::in | std::ios::out | std::ios::binary);
+    (void)file.seekp(offset);
+    (void)file.write(value, size);
+    file.close();
+    std::shared_ptr<Vectors> vectors;
+    return Vectors::BuildFromBinary(&vectors, binary_dir);
+  };
+  std::string vectors_dir = datasets_root_path_ + "/testVectors/vectors.txt";
+  ASSERT_OK(Vectors::ConvertToBinary(vectors_dir, binary_dir));
+  EXPECT_NE(access((binary_dir + ".tmp").c_str(), F_OK), 0);
+  // A dimension whose matrix would overflow the size of the file
+  int32_t dim = std::numeric_limits<int32_t>::max();
+  EXPECT_ERROR(build_corrupted(dim_offset, reinterpret_cast<const char *>(&dim), sizeof(dim)));
+
+  ASSERT_OK(Vectors::ConvertToBinary(vectors_dir, binary_dir));
+  // The tokens past the end of the file
+  uint64_t offset = std::numeric_limits<uint64_t>::max() - 8;
+  EXPECT_ERROR(build_corrupted(tokens_offset, reinterpret_cast<const char *>(&offset), sizeof(offset)));
+  (void)std::remove(binary_dir.c_str());
+}
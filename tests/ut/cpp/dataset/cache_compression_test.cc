@@ -0,0 +1,149 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/cache/cache_compression.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestCacheCompression : public UT::Common {
+ public:
+  MindDataTestCacheCompression() {}
+
+  // A smooth image of <height, width, 3> with some noise
+  static std::vector<uint8_t> MakeImage(int32_t height, int32_t width) {
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int32_t> noise(0, 3);
+    std::vector<uint8_t> image(height * width * 3);
+    for (int32_t h = 0; h < height; ++h) {
+      for (int32_t w = 0; w < width; ++w) {
+        for (int32_t c = 0; c < 3; ++c) {
+          image[(h * width + w) * 3 + c] = static_cast<uint8_t>(h + w * (c + 1) + noise(gen));
+        }
+      }
+    }
+    return image;
+  }
+
+  // Compress a row in two pieces, decompress it and check it comes back the same
+  static void RoundTrip(CacheCompression compression, const std::vector<uint8_t> &row, int32_t delta_stride,
+                        size_t *packed_sz) {
+    auto half = row.size() / 2;
+    std::vector<ReadableSlice> buf{ReadableSlice(row.data(), half),
+                                   ReadableSlice(row.data() + half, row.size() - half)};
+    std::vector<uint8_t> packed;
+    ASSERT_OK(CacheRowCodec::Compress(compression, buf, delta_stride, &packed));
+    *packed_sz = packed.size();
+    if (packed.empty()) {
+      return;
+    }
+    std::vector<uint8_t> out(row.size());
+    WritableSlice dest(out.data(), out.size());
+    size_t raw_sz = 0;
+    ASSERT_OK(CacheRowCodec::Decompress(ReadableSlice(packed.data(), packed.size()), &dest, &raw_sz));
+    EXPECT_EQ(raw_sz, row.size());
+    EXPECT_EQ(out, row);
+  }
+};
+
+/// Feature: CacheRowCodec
+/// Description: Compress an image with the fast codec, with and without the delta filter
+/// Expectation: The image comes back the same, and the delta filter makes it smaller
+TEST_F(MindDataTestCacheCompression, TestFastImage) {
+  auto image = MakeImage(64, 64);
+  size_t plain_sz = 0;
+  size_t delta_sz = 0;
+  RoundTrip(CacheCompression::kFast, image, 0, &plain_sz);
+  RoundTrip(CacheCompression::kFast, image, 3, &delta_sz);
+  EXPECT_GT(delta_sz, 0);
+  EXPECT_LT(delta_sz, image.size());
+  EXPECT_TRUE(plain_sz == 0 || delta_sz < plain_sz);
+}
+
+/// Feature: CacheRowCodec
+/// Description: Compress rows of random bytes, of repeated bytes and of a single byte with the fast codec
+/// Expectation: Random bytes are not compressed, the others come back the same
+TEST_F(MindDataTestCacheCompression, TestFastPatterns) {
+  std::mt19937 gen(1);
+  std::vector<uint8_t> random(4096);
+  for (auto &b : random) {
+    b = static_cast<uint8_t>(gen());
+  }
+  size_t packed_sz = 0;
+  RoundTrip(CacheCompression::kFast, random, 0, &packed_sz);
+  EXPECT_EQ(packed_sz, 0);
+
+  // Long runs need lengths past the 4 bits of the token
+  std::vector<uint8_t> runs(100000, 7);
+  for (size_t i = 0; i < runs.size(); i += 1000) {
+    runs[i] = static_cast<uint8_t>(i);
+  }
+  RoundTrip(CacheCompression::kFast, runs, 0, &packed_sz);
+  EXPECT_GT(packed_sz, 0);
+  EXPECT_LT(packed_sz, runs.size() / 20);
+
+  std::vector<uint8_t> one(1, 1);
+  RoundTrip(CacheCompression::kFast, one, 0, &packed_sz);
+  EXPECT_EQ(packed_sz, 0);
+}
+
+#ifdef ENABLE_CACHE
+/// Feature: CacheRowCodec
+/// Description: Compress an image with zlib and the delta filter
+/// Expectation: The image comes back the same
+TEST_F(MindDataTestCacheCompression, TestZlibImage) {
+  auto image = MakeImage(32, 48);
+  size_t packed_sz = 0;
+  RoundTrip(CacheCompression::kZlib, image, 3, &packed_sz);
+  EXPECT_GT(packed_sz, 0);
+  EXPECT_LT(packed_sz, image.size());
+}
+#endif
+
+/// Feature: CacheRowCodec
+/// Description: Decompress a corrupted row and a row into a buffer too small
+/// Expectation: Both fail without writing past the buffer
+TEST_F(MindDataTestCacheCompression, TestCorrupted) {
+  auto image = MakeImage(16, 16);
+  std::vector<uint8_t> packed;
+  ASSERT_OK(CacheRowCodec::Compress(CacheCompression::kFast, {ReadableSlice(image.data(), image.size())}, 3, &packed));
+  ASSERT_FALSE(packed.empty());
+
+  std::vector<uint8_t> small(image.size() - 1);
+  WritableSlice small_dest(small.data(), small.size());
+  EXPECT_ERROR(CacheRowCodec::Decompress(ReadableSlice(packed.data(), packed.size()), &small_dest));
+
+  std::vector<uint8_t> out(image.size());
+  WritableSlice dest(out.data(), out.size());
+  EXPECT_ERROR(CacheRowCodec::Decompress(ReadableSlice(packed.data(), packed.size() / 2), &dest));
+  EXPECT_ERROR(CacheRowCodec::Decompress(ReadableSlice(image.data(), image.size()), &dest));
+}
+
+/// Feature: CacheCompression
+/// Description: Convert the codec names
+/// Expectation: Known names convert back and forth, others are refused
+TEST_F(MindDataTestCacheCompression, TestNames) {
+  for (auto name : {"none", "fast", "zlib"}) {
+    CacheCompression compression;
+    ASSERT_OK(StringToCacheCompression(name, &compression));
+    EXPECT_EQ(CacheCompressionToString(compression), name);
+  }
+  CacheCompression compression;
+  EXPECT_ERROR(StringToCacheCompression("lz4", &compression));
+}
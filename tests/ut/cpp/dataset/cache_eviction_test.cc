@@ -0,0 +1,126 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/cache/cache_eviction.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestCacheEviction : public UT::Common {
+ public:
+  MindDataTestCacheEviction() {}
+
+  // Evict all the rows left in an evictor, in the order they are picked
+  static std::vector<CacheEvictor::key_type> EvictAll(CacheEvictor *evictor) {
+    std::vector<CacheEvictor::key_type> keys;
+    CacheEvictor::key_type key;
+    while (evictor->Evict(&key)) {
+      keys.push_back(key);
+    }
+    return keys;
+  }
+};
+
+/// Feature: LruCacheEvictor
+/// Description: Add rows, use some of them and remove one, then evict all of them
+/// Expectation: The rows are evicted from the least to the most recently used, and the removed row is never evicted
+TEST_F(MindDataTestCacheEviction, TestLru) {
+  std::unique_ptr<CacheEvictor> evictor;
+  ASSERT_OK(CacheEvictor::CreateCacheEvictor(CacheEvictionPolicy::kLru, &evictor));
+  for (CacheEvictor::key_type key = 0; key < 5; ++key) {
+    evictor->Add(key);
+  }
+  evictor->Touch(0);
+  evictor->Touch(2);
+  evictor->Remove(3);
+  // A row not in the tier is ignored
+  evictor->Touch(100);
+  EXPECT_EQ(evictor->Size(), 4);
+  EXPECT_EQ(EvictAll(evictor.get()), std::vector<CacheEvictor::key_type>({1, 4, 0, 2}));
+  EXPECT_EQ(evictor->Size(), 0);
+}
+
+/// Feature: ClockCacheEvictor
+/// Description: Add rows, use some of them, then evict all of them
+/// Expectation: The rows used get a second chance, and the slot of an evicted row is used again
+TEST_F(MindDataTestCacheEviction, TestClock) {
+  std::unique_ptr<CacheEvictor> evictor;
+  ASSERT_OK(CacheEvictor::CreateCacheEvictor(CacheEvictionPolicy::kClock, &evictor));
+  for (CacheEvictor::key_type key = 0; key < 4; ++key) {
+    evictor->Add(key);
+  }
+  evictor->Touch(0);
+  evictor->Touch(1);
+  CacheEvictor::key_type key;
+  ASSERT_TRUE(evictor->Evict(&key));
+  EXPECT_EQ(key, 2);
+  // Takes the slot of row 2
+  evictor->Add(10);
+  EXPECT_EQ(evictor->Size(), 4);
+  EXPECT_EQ(EvictAll(evictor.get()), std::vector<CacheEvictor::key_type>({3, 0, 1, 10}));
+}
+
+/// Feature: LfuCacheEvictor
+/// Description: Add rows, use them a different number of times, then evict all of them
+/// Expectation: The rows are evicted from the least to the most frequently used, the least recently used first
+/// among those used as often
+TEST_F(MindDataTestCacheEviction, TestLfu) {
+  std::unique_ptr<CacheEvictor> evictor;
+  ASSERT_OK(CacheEvictor::CreateCacheEvictor(CacheEvictionPolicy::kLfu, &evictor));
+  for (CacheEvictor::key_type key = 0; key < 4; ++key) {
+    evictor->Add(key);
+  }
+  evictor->Touch(0);
+  evictor->Touch(0);
+  evictor->Touch(1);
+  evictor->Touch(3);
+  evictor->Remove(2);
+  EXPECT_EQ(EvictAll(evictor.get()), std::vector<CacheEvictor::key_type>({1, 3, 0}));
+}
+
+/// Feature: CacheQuota
+/// Description: Reserve and release memory and disk space against a quota
+/// Expectation: A reservation beyond the limit fails and reserves nothing, and a limit of 0 means no limit
+TEST_F(MindDataTestCacheEviction, TestQuota) {
+  CacheQuota quota(100, 0);
+  EXPECT_TRUE(quota.ReserveMemory(60));
+  EXPECT_FALSE(quota.ReserveMemory(50));
+  EXPECT_EQ(quota.GetMemoryUsage(), 60);
+  quota.ReleaseMemory(20);
+  EXPECT_TRUE(quota.ReserveMemory(50));
+  EXPECT_EQ(quota.GetMemoryUsage(), 90);
+  EXPECT_TRUE(quota.ReserveDisk(1UL << 40));
+  EXPECT_EQ(quota.GetDiskUsage(), 1UL << 40);
+}
+
+/// Feature: CacheEvictionPolicy
+/// Description: Convert the names of the policies and an invalid name
+/// Expectation: The names convert both ways, and an invalid name is an error
+TEST_F(MindDataTestCacheEviction, TestPolicyName) {
+  for (auto policy : {CacheEvictionPolicy::kNone, CacheEvictionPolicy::kLru, CacheEvictionPolicy::kClock,
+                      CacheEvictionPolicy::kLfu}) {
+    CacheEvictionPolicy out;
+    ASSERT_OK(StringToCacheEvictionPolicy(CacheEvictionPolicyToString(policy), &out));
+    EXPECT_EQ(out, policy);
+  }
+  CacheEvictionPolicy out;
+  EXPECT_ERROR(StringToCacheEvictionPolicy("fifo", &out));
+  std::unique_ptr<CacheEvictor> evictor;
+  EXPECT_ERROR(CacheEvictor::CreateCacheEvictor(CacheEvictionPolicy::kNone, &evictor));
+}
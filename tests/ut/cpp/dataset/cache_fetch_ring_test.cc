@@ -0,0 +1,187 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/cache/cache_fetch_ring.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestCacheFetchRing : public UT::Common {
+ public:
+  MindDataTestCacheFetchRing() : mem_(CacheFetchRing::RequiredSize() + kAlignment) {}
+
+  // Placed like a block of the shared memory, which is aligned to at least a cache line
+  void *RingAddr() {
+    auto addr = reinterpret_cast<uintptr_t>(mem_.data());
+    return reinterpret_cast<void *>((addr + kAlignment - 1) / kAlignment * kAlignment);
+  }
+
+ private:
+  static constexpr uintptr_t kAlignment = 64;
+  std::vector<char> mem_;
+};
+
+/// Feature: CacheFetchRing
+/// Description: Submit requests while no poller runs, then while a poller answers them
+/// Expectation: Requests are refused without a poller, then each request gets its own result back
+TEST_F(MindDataTestCacheFetchRing, TestSubmitAndPoll) {
+  CacheFetchRing client(RingAddr());
+  client.Init();
+  int32_t slot = -1;
+  // Nobody polls the ring yet
+  EXPECT_EQ(client.Submit("0", &slot).StatusCode(), StatusCode::kMDNotImplementedYet);
+
+  CacheFetchRing server(RingAddr());
+  server.PollerStarted();
+  std::thread poller([&server]() {
+    int32_t round = 0;
+    std::string payload;
+    while (!server.IsClosed()) {
+      int32_t s = -1;
+      if (server.Poll(&s, &payload)) {
+        round = 0;
+        auto n = std::stoll(payload);
+        if (n < 0) {
+          server.Complete(s, Status(StatusCode::kMDOutOfMemory, "no memory"), -1);
+        } else {
+          server.Complete(s, Status::OK(), n * 2);
+        }
+      } else {
+        CacheFetchRing::Backoff(round++);
+      }
+    }
+    server.PollerStopped();
+  });
+
+  std::vector<std::thread> clients;
+  std::vector<int64_t> results(4 * CacheFetchRing::kNumSlots, -1);
+  for (auto i = 0; i < 4; ++i) {
+    clients.emplace_back([&client, &results, i]() {
+      for (size_t k = i; k < results.size(); k += 4) {
+        int32_t s = -1;
+        Status rc;
+        // Retry while all the slots are in use by the other threads
+        do {
+          rc = client.Submit(std::to_string(k), &s);
+        } while (rc.StatusCode() == StatusCode::kMDNotImplementedYet);
+        if (rc.IsOk()) {
+          rc = client.WaitForResult(s, 10, &results[k]);
+        }
+      }
+    });
+  }
+  for (auto &t : clients) {
+    t.join();
+  }
+  for (size_t k = 0; k < results.size(); ++k) {
+    EXPECT_EQ(results[k], static_cast<int64_t>(k * 2));
+  }
+
+  // The error of the server comes back to the client
+  int64_t addr = 0;
+  ASSERT_OK(client.Submit("-1", &slot));
+  EXPECT_EQ(client.WaitForResult(slot, 10, &addr).StatusCode(), StatusCode::kMDOutOfMemory);
+
+  // A payload too big is refused
+  std::string big(CacheFetchRing::kMaxPayloadSize + 1, '1');
+  EXPECT_EQ(client.Submit(big, &slot).StatusCode(), StatusCode::kMDNotImplementedYet);
+
+  client.Close();
+  EXPECT_TRUE(client.WaitForPollers(10000));
+  poller.join();
+  EXPECT_EQ(client.Submit("0", &slot).StatusCode(), StatusCode::kMDNotImplementedYet);
+}
+
+/// Feature: CacheFetchRing
+/// Description: Time out on requests not picked up yet and on requests the poller is working on, more times than the
+/// ring has slots
+/// Expectation: Each timeout gives the slot back, right away or once the poller completes the request, and the poller
+/// learns that its result is not read
+TEST_F(MindDataTestCacheFetchRing, TestTimeout) {
+  CacheFetchRing client(RingAddr());
+  client.Init();
+  CacheFetchRing server(RingAddr());
+  server.PollerStarted();
+  int32_t slot = -1;
+  int32_t polled = -1;
+  int64_t addr = -1;
+  std::string payload;
+
+  // Nobody picks the request up, so the client takes it back
+  ASSERT_OK(client.Submit("1", &slot));
+  EXPECT_EQ(client.WaitForResult(slot, 0, &addr).StatusCode(), StatusCode::kMDTimeOut);
+  EXPECT_FALSE(server.Poll(&polled, &payload));
+
+  // The poller has the request when the client gives up on it
+  for (auto i = 0; i < 2 * CacheFetchRing::kNumSlots; ++i) {
+    ASSERT_OK(client.Submit(std::to_string(i), &slot));
+    ASSERT_TRUE(server.Poll(&polled, &payload));
+    EXPECT_EQ(polled, slot);
+    EXPECT_EQ(client.WaitForResult(slot, 0, &addr).StatusCode(), StatusCode::kMDTimeOut);
+    EXPECT_FALSE(server.Complete(polled, Status::OK(), i));
+  }
+
+  // All the slots are free again
+  std::vector<int32_t> slots(CacheFetchRing::kNumSlots);
+  for (auto &s : slots) {
+    ASSERT_OK(client.Submit("2", &s));
+  }
+  EXPECT_EQ(client.Submit("2", &slot).StatusCode(), StatusCode::kMDNotImplementedYet);
+  for (auto s : slots) {
+    ASSERT_TRUE(server.Poll(&polled, &payload));
+    EXPECT_TRUE(server.Complete(polled, Status::OK(), 2));
+    ASSERT_OK(client.WaitForResult(s, 10, &addr));
+    EXPECT_EQ(addr, 2);
+  }
+  client.Close();
+  server.PollerStopped();
+}
+
+/// Feature: CacheFetchRing
+/// Description: Close the ring while the poller works on one request and another one waits
+/// Expectation: The request in progress gets its result, the waiting one is taken back once the poller stops, and
+/// no request is accepted any more
+TEST_F(MindDataTestCacheFetchRing, TestClose) {
+  CacheFetchRing client(RingAddr());
+  client.Init();
+  CacheFetchRing server(RingAddr());
+  server.PollerStarted();
+  int32_t first = -1;
+  int32_t second = -1;
+  int32_t polled = -1;
+  int64_t addr = -1;
+  std::string payload;
+  ASSERT_OK(client.Submit("1", &first));
+  ASSERT_OK(client.Submit("2", &second));
+  ASSERT_TRUE(server.Poll(&polled, &payload));
+  EXPECT_EQ(payload, "1");
+
+  client.Close();
+  EXPECT_TRUE(server.IsClosed());
+  EXPECT_FALSE(client.WaitForPollers(10));
+  EXPECT_TRUE(server.Complete(polled, Status::OK(), 1));
+  ASSERT_OK(client.WaitForResult(first, 10, &addr));
+  EXPECT_EQ(addr, 1);
+
+  server.PollerStopped();
+  EXPECT_TRUE(client.WaitForPollers(10));
+  EXPECT_EQ(client.WaitForResult(second, 10, &addr).StatusCode(), StatusCode::kMDNotImplementedYet);
+  EXPECT_EQ(client.Submit("3", &first).StatusCode(), StatusCode::kMDNotImplementedYet);
+}
@@ -0,0 +1,176 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/text/compiled_vocab.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+namespace {
+// Exposes the tokenization through the unordered_map of the vocab, to check the compiled one against it
+class LegacyWordpieceTokenizerOp : public WordpieceTokenizerOp {
+ public:
+  using WordpieceTokenizerOp::GetTokens;
+  using WordpieceTokenizerOp::WordpieceTokenizerOp;
+};
+}  // namespace
+
+class MindDataTestCompiledVocab : public UT::Common {
+ public:
+  void SetUp() override {
+    std::mt19937 gen(0);
+    const std::string letters = "abcdefg";
+    std::unordered_map<WordType, WordIdType> words;
+    WordIdType id = 0;
+    for (auto special : {"[UNK]", "[CLS]", "[SEP]", "中", "中国", "##国"}) {
+      words[special] = id++;
+    }
+    constexpr int kNumWords = 20000;
+    constexpr int kMaxLength = 6;
+    while (words.size() < kNumWords) {
+      std::string word = gen() % 3 == 0 ? "##" : "";
+      for (size_t length = gen() % kMaxLength + 1; length > 0; length--) {
+        word += letters[gen() % letters.size()];
+      }
+      if (words.find(word) == words.end()) {
+        words[word] = id++;
+      }
+    }
+    vocab_ = std::make_shared<Vocab>(words);
+    for (int i = 0; i < kNumWords; i++) {
+      std::string text;
+      for (size_t length = gen() % (kMaxLength * 2) + 1; length > 0; length--) {
+        text += letters[gen() % letters.size()];
+      }
+      texts_.push_back(text);
+    }
+  }
+
+  std::shared_ptr<Vocab> vocab_;
+  std::vector<std::string> texts_;  // Random words, most of them not in the vocab
+};
+
+/// Feature: CompiledVocab
+/// Description: Test Lookup and LongestPrefix against the unordered_map of the Vocab
+/// Expectation: Both give the same ids as the Vocab
+TEST_F(MindDataTestCompiledVocab, TestLookup) {
+  std::shared_ptr<CompiledVocab> compiled;
+  ASSERT_OK(CompiledVocab::Build(*vocab_, &compiled));
+  EXPECT_EQ(compiled->Size(), vocab_->GetVocab().size());
+  for (const auto &[word, id] : vocab_->GetVocab()) {
+    EXPECT_EQ(compiled->Lookup(word), id);
+  }
+  for (const auto &text : texts_) {
+    EXPECT_EQ(compiled->Lookup(text), vocab_->TokensToIds(text));
+  }
+  EXPECT_EQ(compiled->Lookup(""), Vocab::kNoTokenExists);
+
+  auto suffix = compiled->Walk(CompiledVocab::Root(), "##");
+  ASSERT_GE(suffix, 0);
+  EXPECT_EQ(compiled->Walk(CompiledVocab::Root(), "xyz"), -1);
+  for (const auto &text : texts_) {
+    for (auto node : {CompiledVocab::Root(), suffix}) {
+      std::string prefix = node == suffix ? "##" : "";
+      size_t expect = 0;
+      for (size_t length = text.size(); length > 0; length--) {
+        if (vocab_->TokensToIds(prefix + text.substr(0, length)) != Vocab::kNoTokenExists) {
+          expect = length;
+          break;
+        }
+      }
+      std::string_view word;
+      WordIdType id = Vocab::kNoTokenExists;
+      ASSERT_EQ(compiled->LongestPrefix(node, text, &word, &id), expect);
+      if (expect > 0) {
+        EXPECT_EQ(word, prefix + text.substr(0, expect));
+        EXPECT_EQ(id, vocab_->TokensToIds(std::string(word)));
+      }
+    }
+  }
+
+  // "中" is a word, but the first byte of "丫" is not
+  std::string_view word;
+  WordIdType id = Vocab::kNoTokenExists;
+  EXPECT_EQ(compiled->LongestPrefix(CompiledVocab::Root(), "中国人", &word, &id), std::string("中国").size());
+  EXPECT_EQ(compiled->LongestPrefix(CompiledVocab::Root(), "丫", &word, &id), 0);
+}
+
+/// Feature: WordpieceTokenizer op
+/// Description: Test the tokens and offsets of the compiled vocab against those of the unordered_map of the Vocab
+/// Expectation: Both give the same tokens and offsets
+TEST_F(MindDataTestCompiledVocab, TestWordpieceEquivalence) {
+  LegacyWordpieceTokenizerOp op(vocab_, "##", 8, "[UNK]", true);
+  texts_.push_back("中国");
+  texts_.push_back("中中国");
+  texts_.push_back("中国中国中国");
+  for (const auto &text : texts_) {
+    std::vector<std::string> tokens;
+    std::vector<uint32_t> starts;
+    std::vector<uint32_t> limits;
+    ASSERT_OK(op.TokenizeWord(text, 3, &tokens, &starts, &limits));
+    std::vector<std::string> expect_tokens;
+    std::vector<uint32_t> expect_starts;
+    std::vector<uint32_t> expect_limits;
+    ASSERT_OK(op.GetTokens(text, 3, &expect_tokens, &expect_starts, &expect_limits));
+    EXPECT_EQ(tokens, expect_tokens);
+    EXPECT_EQ(starts, expect_starts);
+    EXPECT_EQ(limits, expect_limits);
+  }
+}
+
+/// Feature: WordpieceTokenizer op
+/// Description: Measure the tokens per second of the compiled vocab against the unordered_map of the Vocab.
+/// Expectation: Both run, the tokens per second of one core are printed
+TEST_F(MindDataTestCompiledVocab, DISABLED_TestThroughput) {
+  constexpr int kNumRounds = 10;
+  LegacyWordpieceTokenizerOp op(vocab_, "##", 100, "[UNK]", false);
+  size_t num_tokens = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kNumRounds; i++) {
+    for (const auto &text : texts_) {
+      std::vector<std::string> tokens;
+      std::vector<uint32_t> starts;
+      std::vector<uint32_t> limits;
+      ASSERT_OK(op.GetTokens(text, 0, &tokens, &starts, &limits));
+      num_tokens += tokens.size();
+    }
+  }
+  auto middle = std::chrono::steady_clock::now();
+  for (int i = 0; i < kNumRounds; i++) {
+    for (const auto &text : texts_) {
+      std::vector<std::string> tokens;
+      std::vector<uint32_t> starts;
+      std::vector<uint32_t> limits;
+      ASSERT_OK(op.TokenizeWord(text, 0, &tokens, &starts, &limits));
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double map_sec = std::chrono::duration<double>(middle - start).count();
+  double compiled_sec = std::chrono::duration<double>(end - middle).count();
+  std::cout << "WordPiece tokens/sec per core, unordered_map: " << num_tokens / map_sec
+            << ", compiled: " << num_tokens / compiled_sec << std::endl;
+}
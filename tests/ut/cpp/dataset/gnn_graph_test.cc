@@ -13,18 +13,24 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <sys/stat.h>
+#include <utime.h>
+
 #include <algorithm>
 #include <string>
 #include <map>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include "common/common.h"
 #include "gtest/gtest.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/engine/gnn/node.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
+#include "minddata/dataset/util/path.h"
 
 using namespace mindspore::dataset;
 using namespace mindspore::dataset::gnn;
@@ -429,3 +435,163 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+/// Feature: GNNGraph
+/// Description: Test the csr storage format, built from the dataset and mapped from its snapshot
+/// Expectation: Output is equal to the output of the object storage format
+TEST_F(MindDataTestGNNGraph, TestCsrStorage) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  std::string snapshot = "./gnn_graph_test_csr.snapshot";
+  (void)Path(snapshot).Remove();
+
+  GraphDataImpl object_graph("mindrecord", path, 1);
+  ASSERT_OK(object_graph.Init());
+  MetaInfo meta_info;
+  ASSERT_OK(object_graph.GetMetaInfo(&meta_info));
+
+  // Everything but the sampling outputs, which depend on the random generator
+  auto dump = [&meta_info](GraphDataImpl *graph) {
+    std::vector<std::string> out;
+    std::shared_ptr<Tensor> tensor;
+    for (auto node_type : meta_info.node_type) {
+      std::shared_ptr<Tensor> nodes;
+      EXPECT_OK(graph->GetAllNodes(node_type, &nodes));
+      out.push_back(nodes->ToString());
+      std::vector<NodeIdType> node_list;
+      for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+        node_list.push_back(*itr);
+      }
+      for (auto neighbor_type : meta_info.node_type) {
+        EXPECT_OK(graph->GetAllNeighbors(node_list, neighbor_type, OutputFormat::kNormal, &tensor));
+        out.push_back(tensor->ToString());
+        EXPECT_OK(graph->GetSampledNeighbors(node_list, {3, 2}, {neighbor_type, neighbor_type},
+                                             SamplingStrategy::kRandom, &tensor));
+        out.push_back(tensor->shape().ToString());
+      }
+      TensorRow features;
+      EXPECT_OK(graph->GetNodeFeature(nodes, meta_info.node_feature_type, &features));
+      for (const auto &feature : features) {
+        out.push_back(feature->ToString());
+      }
+    }
+    for (auto edge_type : meta_info.edge_type) {
+      std::shared_ptr<Tensor> edges;
+      EXPECT_OK(graph->GetAllEdges(edge_type, &edges));
+      out.push_back(edges->ToString());
+      std::vector<EdgeIdType> edge_list;
+      for (auto itr = edges->begin<EdgeIdType>(); itr != edges->end<EdgeIdType>(); ++itr) {
+        edge_list.push_back(*itr);
+      }
+      EXPECT_OK(graph->GetNodesFromEdges(edge_list, &tensor));
+      out.push_back(tensor->ToString());
+      TensorRow features;
+      EXPECT_OK(graph->GetEdgeFeature(edges, meta_info.edge_feature_type, &features));
+      for (const auto &feature : features) {
+        out.push_back(feature->ToString());
+      }
+    }
+    EXPECT_OK(graph->GetEdgesFromNodes({{101, 201}, {103, 207}, {108, 208}, {110, 201}, {204, 105}, {208, 108}},
+                                       &tensor));
+    out.push_back(tensor->ToString());
+    return out;
+  };
+  std::vector<std::string> expected = dump(&object_graph);
+
+  GraphDataImpl csr_graph("mindrecord", path, 1, false, kCsrStorage, snapshot);
+  ASSERT_OK(csr_graph.Init());
+  EXPECT_EQ(dump(&csr_graph), expected);
+  EXPECT_TRUE(Path(snapshot).Exists());
+
+  GraphDataImpl snapshot_graph("mindrecord", path, 1, false, kCsrStorage, snapshot);
+  ASSERT_OK(snapshot_graph.Init());
+  EXPECT_EQ(dump(&snapshot_graph), expected);
+  MetaInfo snapshot_meta_info;
+  ASSERT_OK(snapshot_graph.GetMetaInfo(&snapshot_meta_info));
+  EXPECT_EQ(snapshot_meta_info.node_num, meta_info.node_num);
+  EXPECT_EQ(snapshot_meta_info.edge_num, meta_info.edge_num);
+
+  // the snapshot of another version of the dataset file is rebuilt rather than mapped
+  struct stat dataset_stat;
+  struct stat snapshot_stat;
+  ASSERT_EQ(stat(path.c_str(), &dataset_stat), 0);
+  ASSERT_EQ(stat(snapshot.c_str(), &snapshot_stat), 0);
+  struct utimbuf times = {dataset_stat.st_atime, dataset_stat.st_mtime + 10};
+  ASSERT_EQ(utime(path.c_str(), &times), 0);
+  GraphDataImpl rebuilt_graph("mindrecord", path, 1, false, kCsrStorage, snapshot);
+  Status rc = rebuilt_graph.Init();
+  times.modtime = dataset_stat.st_mtime;
+  ASSERT_EQ(utime(path.c_str(), &times), 0);
+  ASSERT_OK(rc);
+  EXPECT_EQ(dump(&rebuilt_graph), expected);
+  struct stat rebuilt_stat;
+  ASSERT_EQ(stat(snapshot.c_str(), &rebuilt_stat), 0);
+  EXPECT_NE(rebuilt_stat.st_ino, snapshot_stat.st_ino);
+
+  GraphDataImpl bad_graph("mindrecord", path, 1, false, "columns");
+  EXPECT_ERROR(bad_graph.Init());
+  ASSERT_OK(Path(snapshot).Remove());
+}
+
+/// Feature: GraphData
+/// Description: Sample neighbors and negative neighbors with 1 and 4 workers and the same seed, then get a subgraph
+/// Expectation: The samples are the same whatever the number of workers, and the features of the subgraph are
+///     those of its nodes
+TEST_F(MindDataTestGNNGraph, TestParallelSampling) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(135);
+  GraphDataImpl graph("mindrecord", path, 1);
+  ASSERT_OK(graph.Init());
+  GraphDataImpl parallel_graph("mindrecord", path, 4);
+  ASSERT_OK(parallel_graph.Init());
+  GlobalContext::config_manager()->set_seed(original_seed);
+
+  MetaInfo meta_info;
+  ASSERT_OK(graph.GetMetaInfo(&meta_info));
+  std::shared_ptr<Tensor> nodes;
+  ASSERT_OK(graph.GetAllNodes(meta_info.node_type[0], &nodes));
+  // Enough input nodes for several chunks
+  std::vector<NodeIdType> node_list;
+  for (int i = 0; i < 100; ++i) {
+    for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+      node_list.push_back(*itr);
+    }
+  }
+  NodeType neighbor_type = meta_info.node_type[1];
+
+  std::shared_ptr<Tensor> neighbors;
+  std::shared_ptr<Tensor> parallel_neighbors;
+  ASSERT_OK(graph.GetSampledNeighbors(node_list, {3, 2}, {neighbor_type, meta_info.node_type[0]},
+                                      SamplingStrategy::kRandom, &neighbors));
+  ASSERT_OK(parallel_graph.GetSampledNeighbors(node_list, {3, 2}, {neighbor_type, meta_info.node_type[0]},
+                                               SamplingStrategy::kRandom, &parallel_neighbors));
+  EXPECT_EQ(neighbors->ToString(), parallel_neighbors->ToString());
+
+  ASSERT_OK(graph.GetNegSampledNeighbors(node_list, 3, neighbor_type, &neighbors));
+  ASSERT_OK(parallel_graph.GetNegSampledNeighbors(node_list, 3, neighbor_type, &parallel_neighbors));
+  EXPECT_EQ(neighbors->ToString(), parallel_neighbors->ToString());
+  // Negative neighbors are distinct from each other
+  auto shape = neighbors->shape().AsVector();
+  std::vector<NodeIdType> sampled;
+  for (auto itr = neighbors->begin<NodeIdType>(); itr != neighbors->end<NodeIdType>(); ++itr) {
+    sampled.push_back(*itr);
+  }
+  for (int64_t i = 0; i < shape[0]; ++i) {
+    std::unordered_set<NodeIdType> row(sampled.begin() + i * shape[1] + 1, sampled.begin() + (i + 1) * shape[1]);
+    if (row.count(kDefaultNodeId) == 0) {
+      EXPECT_EQ(row.size(), shape[1] - 1);
+    }
+  }
+
+  TensorRow subgraph;
+  ASSERT_OK(parallel_graph.GetSampledSubgraph(node_list, {3, 2}, {neighbor_type, meta_info.node_type[0]},
+                                              SamplingStrategy::kRandom, meta_info.node_feature_type, &subgraph));
+  ASSERT_EQ(subgraph.size(), meta_info.node_feature_type.size() + 1);
+  std::vector<dsize_t> expected_shape = {static_cast<dsize_t>(node_list.size()), 1 + 3 + 3 * 2};
+  EXPECT_EQ(subgraph[0]->shape().AsVector(), expected_shape);
+  TensorRow features;
+  ASSERT_OK(graph.GetNodeFeature(subgraph[0], meta_info.node_feature_type, &features));
+  for (size_t i = 0; i < features.size(); ++i) {
+    EXPECT_EQ(subgraph[i + 1]->ToString(), features[i]->ToString());
+  }
+}
@@ -0,0 +1,213 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/audio/kernels/amplitude_to_db_op.h"
+#include "minddata/dataset/audio/kernels/audio_utils.h"
+#include "minddata/dataset/audio/kernels/mel_scale_op.h"
+#include "minddata/dataset/audio/kernels/mel_spectrogram_op.h"
+#include "minddata/dataset/audio/kernels/spectrogram_op.h"
+#include "minddata/dataset/audio/kernels/stft_engine.h"
+#include "minddata/dataset/kernels/data/data_utils.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestMelSpectrogramOp : public UT::Common {
+ public:
+  // Random waveform of the given shape, in [-1, 1]
+  std::shared_ptr<Tensor> RandomWaveform(const TensorShape &shape) {
+    std::mt19937 rng(static_cast<uint32_t>(shape.NumOfElements()));
+    std::uniform_real_distribution<float> dist(-1.0, 1.0);
+    std::vector<float> values(shape.NumOfElements());
+    for (auto &value : values) {
+      value = dist(rng);
+    }
+    std::shared_ptr<Tensor> waveform;
+    EXPECT_OK(Tensor::CreateFromVector(values, shape, &waveform));
+    return waveform;
+  }
+
+  // The waveform as float64, which Spectrogram still computes with the naive DFT
+  std::shared_ptr<Tensor> AsDouble(const std::shared_ptr<Tensor> &input) {
+    std::shared_ptr<Tensor> output;
+    EXPECT_OK(TypeCast(input, &output, DataType(DataType::DE_FLOAT64)));
+    return output;
+  }
+
+  // Checks the float32 output against the float64 one, to a tolerance relative to the largest value
+  void ExpectClose(const std::shared_ptr<Tensor> &actual, const std::shared_ptr<Tensor> &expected, double rtol) {
+    ASSERT_EQ(actual->shape(), expected->shape());
+    ASSERT_EQ(actual->type(), DataType(DataType::DE_FLOAT32));
+    ASSERT_EQ(expected->type(), DataType(DataType::DE_FLOAT64));
+    double max_value = 0;
+    for (auto itr = expected->begin<double>(); itr != expected->end<double>(); ++itr) {
+      max_value = std::max(max_value, std::abs(*itr));
+    }
+    auto value = actual->begin<float>();
+    for (auto itr = expected->begin<double>(); itr != expected->end<double>(); ++itr, ++value) {
+      ASSERT_NEAR(*value, *itr, rtol * max_value);
+    }
+  }
+};
+
+/// Feature: RealFft
+/// Description: Test the power spectrum of power of two and other sizes against a DFT in double
+/// Expectation: The power spectra are the same up to float rounding
+TEST_F(MindDataTestMelSpectrogramOp, TestRealFft) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> dist(-1.0, 1.0);
+  for (int32_t n : {1, 2, 4, 8, 16, 64, 512, 1024, 6, 9, 400}) {
+    std::vector<float> frame(n);
+    std::vector<float> window(n);
+    for (int32_t k = 0; k < n; ++k) {
+      frame[k] = dist(rng);
+      window[k] = dist(rng);
+    }
+    RealFft fft(n);
+    RealFft::Workspace workspace;
+    fft.InitWorkspace(&workspace);
+    std::vector<float> power(n / 2 + 1);
+    fft.PowerSpectrum(frame.data(), window.data(), &workspace, power.data());
+    for (int32_t k = 0; k <= n / 2; ++k) {
+      std::complex<double> bin = 0;
+      for (int32_t t = 0; t < n; ++t) {
+        bin += static_cast<double>(frame[t]) * window[t] * std::polar(1.0, -2 * PI * k * t / n);
+      }
+      ASSERT_NEAR(power[k], std::norm(bin), 1e-5 * n * n) << "n: " << n << ", bin: " << k;
+    }
+  }
+}
+
+/// Feature: Spectrogram op
+/// Description: Test the power spectrogram of float32 waveforms, computed by the real FFT, against the naive DFT of
+///     float64 waveforms, with all the windows and padding modes
+/// Expectation: The spectrograms are the same up to float rounding
+TEST_F(MindDataTestMelSpectrogramOp, TestSpectrogramEquivalence) {
+  struct Args {
+    int32_t n_fft;
+    int32_t win_length;
+    int32_t hop_length;
+    int32_t pad;
+    WindowType window;
+    float power;
+    bool normalized;
+    bool center;
+    BorderType pad_mode;
+  };
+  std::vector<Args> all_args = {
+    {512, 400, 160, 0, WindowType::kHann, 2.0, false, true, BorderType::kReflect},
+    {400, 400, 200, 0, WindowType::kHamming, 1.0, true, true, BorderType::kConstant},
+    {256, 256, 64, 10, WindowType::kBlackman, 1.5, false, true, BorderType::kSymmetric},
+    {64, 33, 20, 3, WindowType::kBartlett, 2.0, true, false, BorderType::kEdge},
+    {128, 1, 50, 0, WindowType::kHann, 2.0, false, true, BorderType::kEdge},
+    {32, 32, 8, 0, WindowType::kKaiser, 2.0, false, true, BorderType::kReflect},
+  };
+  for (const auto &args : all_args) {
+    // The short waveform has to be reflected several times to fill the centering
+    for (const auto &shape : {TensorShape({2, 3, 1000}), TensorShape({1500}), TensorShape({2, 100})}) {
+      auto waveform = RandomWaveform(shape);
+      std::shared_ptr<Tensor> output;
+      SpectrogramOp op(args.n_fft, args.win_length, args.hop_length, args.pad, args.window, args.power,
+                       args.normalized, args.center, args.pad_mode, true);
+      ASSERT_OK(op.Compute(waveform, &output));
+      std::shared_ptr<Tensor> expected;
+      ASSERT_OK(Spectrogram(AsDouble(waveform), &expected, args.pad, args.window, args.n_fft, args.hop_length,
+                            args.win_length, args.power, args.normalized, args.center, args.pad_mode, true));
+      ExpectClose(output, expected, 1e-5);
+    }
+  }
+}
+
+/// Feature: MelSpectrogram op
+/// Description: Test the fused op against Spectrogram, MelScale and AmplitudeToDB of float64 waveforms
+/// Expectation: The mel spectrograms are the same up to float rounding
+TEST_F(MindDataTestMelSpectrogramOp, TestMelSpectrogramEquivalence) {
+  auto waveform = RandomWaveform(TensorShape({2, 16000}));
+  auto spectrogram = std::make_shared<SpectrogramOp>(512, 400, 160, 0, WindowType::kHann, 2.0, false, true,
+                                                     BorderType::kReflect, true);
+  for (auto mel_type : {MelType::kHtk, MelType::kSlaney}) {
+    auto mel_scale = std::make_shared<MelScaleOp>(80, 16000, 0, 8000, 257, NormType::kSlaney, mel_type);
+    std::shared_ptr<Tensor> linear;
+    std::shared_ptr<Tensor> expected;
+    ASSERT_OK(spectrogram->Compute(AsDouble(waveform), &linear));
+    ASSERT_OK(mel_scale->Compute(linear, &expected));
+    std::shared_ptr<Tensor> output;
+    ASSERT_OK(MelSpectrogramOp(spectrogram, mel_scale).Compute(waveform, &output));
+    EXPECT_EQ(output->shape(), TensorShape({2, 80, 101}));
+    ExpectClose(output, expected, 1e-5);
+
+    // In decibels, the values more than 40 dB below the top are clipped
+    auto amplitude_to_db = std::make_shared<AmplitudeToDBOp>(ScaleType::kPower, 1.0, 1e-10, 40.0);
+    std::shared_ptr<Tensor> expected_db;
+    ASSERT_OK(amplitude_to_db->Compute(expected, &expected_db));
+    ASSERT_OK(MelSpectrogramOp(spectrogram, mel_scale, amplitude_to_db).Compute(waveform, &output));
+    ASSERT_EQ(output->shape(), expected_db->shape());
+    auto value = output->begin<float>();
+    for (auto itr = expected_db->begin<double>(); itr != expected_db->end<double>(); ++itr, ++value) {
+      ASSERT_NEAR(*value, *itr, 1e-2);
+    }
+  }
+
+  // The filterbank must have as many frequencies as the spectrogram
+  auto mel_scale = std::make_shared<MelScaleOp>(80, 16000, 0, 8000, 201, NormType::kNone, MelType::kHtk);
+  std::shared_ptr<Tensor> output;
+  EXPECT_ERROR(MelSpectrogramOp(spectrogram, mel_scale).Compute(waveform, &output));
+}
+
+/// Feature: MelSpectrogram op
+/// Description: Measure the clips per second of the fused op against Spectrogram, MelScale and AmplitudeToDB computed
+///     with the naive DFT.
+/// Expectation: Both run, the clips per second of one core are printed
+TEST_F(MindDataTestMelSpectrogramOp, DISABLED_TestThroughput) {
+  constexpr int kNumRounds = 3;
+  // 4 seconds at 16 kHz, 25 ms windows every 10 ms
+  auto waveform = RandomWaveform(TensorShape({64000}));
+  auto spectrogram = std::make_shared<SpectrogramOp>(512, 400, 160, 0, WindowType::kHann, 2.0, false, true,
+                                                     BorderType::kReflect, true);
+  auto mel_scale = std::make_shared<MelScaleOp>(80, 16000, 0, 8000, 257, NormType::kNone, MelType::kHtk);
+  auto amplitude_to_db = std::make_shared<AmplitudeToDBOp>(ScaleType::kPower, 1.0, 1e-10, 80.0);
+  MelSpectrogramOp fused(spectrogram, mel_scale, amplitude_to_db);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kNumRounds; i++) {
+    std::shared_ptr<Tensor> linear;
+    std::shared_ptr<Tensor> mel;
+    std::shared_ptr<Tensor> output;
+    ASSERT_OK(spectrogram->Compute(AsDouble(waveform), &linear));
+    ASSERT_OK(mel_scale->Compute(linear, &mel));
+    ASSERT_OK(amplitude_to_db->Compute(mel, &output));
+  }
+  auto middle = std::chrono::steady_clock::now();
+  for (int i = 0; i < kNumRounds; i++) {
+    std::shared_ptr<Tensor> output;
+    ASSERT_OK(fused.Compute(waveform, &output));
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double unfused_sec = std::chrono::duration<double>(middle - start).count();
+  double fused_sec = std::chrono::duration<double>(end - middle).count();
+  std::cout << "Mel spectrogram clips/sec per core, naive DFT: " << kNumRounds / unfused_sec
+            << ", fused real FFT: " << kNumRounds / fused_sec << std::endl;
+}
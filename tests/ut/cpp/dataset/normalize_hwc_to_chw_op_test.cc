@@ -0,0 +1,167 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_normalize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestNormalizeHwcToChwOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestNormalizeHwcToChwOp() : CVOpCommon() {}
+
+  // Random image of the given shape and type.
+  template <typename T>
+  std::shared_ptr<Tensor> RandomImage(const TensorShape &shape) {
+    std::mt19937 rng(static_cast<uint32_t>(shape.NumOfElements()));
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<T> values(shape.NumOfElements());
+    for (auto &value : values) {
+      value = static_cast<T>(dist(rng));
+    }
+    std::shared_ptr<Tensor> image;
+    EXPECT_OK(Tensor::CreateFromVector(values, shape, &image));
+    return image;
+  }
+
+  // Checks that the fused op gives exactly the output of Normalize followed by HWC2CHW.
+  void CheckSameAsUnfused(const std::shared_ptr<Tensor> &input, const std::vector<float> &mean,
+                          const std::vector<float> &std) {
+    std::shared_ptr<Tensor> normalized;
+    std::shared_ptr<Tensor> expected;
+    ASSERT_OK(NormalizeOp(mean, std, true).Compute(input, &normalized));
+    ASSERT_OK(HwcToChwOp().Compute(normalized, &expected));
+    std::shared_ptr<Tensor> output;
+    ASSERT_OK(NormalizeHwcToChwOp(mean, std).Compute(input, &output));
+    ASSERT_EQ(output->shape(), expected->shape());
+    ASSERT_EQ(output->type(), expected->type());
+    ASSERT_EQ(output->SizeInBytes(), expected->SizeInBytes());
+    EXPECT_EQ(memcmp(output->GetBuffer(), expected->GetBuffer(), output->SizeInBytes()), 0)
+      << "shape: " << input->shape() << ", type: " << input->type();
+  }
+};
+
+/// Feature: NormalizeHwcToChw op
+/// Description: Normalize and transpose images of various shapes and types
+/// Expectation: Output is exactly the output of Normalize followed by HWC2CHW
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestSameAsUnfused) {
+  std::vector<float> mean = {123.675, 116.28, 103.53};
+  std::vector<float> std = {58.395, 57.12, 57.375};
+  // sizes around the 16 pixel blocks of the SIMD kernels
+  for (auto &dims : std::vector<std::vector<dsize_t>>{{1, 1, 3}, {1, 15, 3}, {4, 4, 3}, {7, 13, 3}, {224, 224, 3}}) {
+    TensorShape shape(dims);
+    CheckSameAsUnfused(RandomImage<uint8_t>(shape), mean, std);
+    CheckSameAsUnfused(RandomImage<float>(shape), mean, std);
+  }
+  CheckSameAsUnfused(input_tensor_, mean, std);
+  CheckSameAsUnfused(RandomImage<uint8_t>(TensorShape({9, 11, 3})), {127.5}, {127.5});
+  CheckSameAsUnfused(RandomImage<uint8_t>(TensorShape({9, 11, 1})), {127.5}, {127.5});
+  CheckSameAsUnfused(RandomImage<uint8_t>(TensorShape({9, 11, 4})), {1, 2, 3, 4}, {5, 6, 7, 8});
+  CheckSameAsUnfused(RandomImage<int32_t>(TensorShape({9, 11, 3})), mean, std);
+  CheckSameAsUnfused(RandomImage<uint8_t>(TensorShape({9, 11})), {127.5}, {127.5});
+}
+
+/// Feature: NormalizeHwcToChw op
+/// Description: Pass invalid mean, std and shapes
+/// Expectation: The errors of Normalize and HWC2CHW are returned
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestInvalidInput) {
+  std::shared_ptr<Tensor> output;
+  auto image = RandomImage<uint8_t>(TensorShape({8, 8, 3}));
+  EXPECT_ERROR(NormalizeHwcToChwOp({1, 2}, {1, 2, 3}).Compute(image, &output));
+  EXPECT_ERROR(NormalizeHwcToChwOp({1, 2}, {1, 2}).Compute(image, &output));
+  EXPECT_ERROR(NormalizeHwcToChwOp({1}, {1}).Compute(RandomImage<uint8_t>(TensorShape({2, 8, 8, 3})), &output));
+}
+
+/// Feature: RandomCropDecodeResizeNormalize op
+/// Description: Run the fused op and the ops it replaces with the same seed
+/// Expectation: Outputs are exactly the same
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestFusedDecodeSameAsUnfused) {
+  std::vector<float> mean = {121.0, 115.0, 100.0};
+  std::vector<float> std = {70.0, 68.0, 71.0};
+  NormalizeOp normalize(mean, std, true);
+  HwcToChwOp hwc_to_chw;
+  for (int k = 0; k < 5; k++) {
+    GlobalContext::config_manager()->set_seed(k);
+    auto expected_op = RandomCropDecodeResizeOp(224, 224);
+    // the copy starts from the same random state, so both ops pick the same crop
+    auto fused_op = RandomCropDecodeResizeNormalizeOp(expected_op, mean, std);
+    TensorRow input;
+    input.push_back(raw_input_tensor_);
+    TensorRow resized;
+    ASSERT_OK(expected_op.Compute(input, &resized));
+    std::shared_ptr<Tensor> normalized;
+    std::shared_ptr<Tensor> expected;
+    ASSERT_OK(normalize.Compute(resized[0], &normalized));
+    ASSERT_OK(hwc_to_chw.Compute(normalized, &expected));
+    TensorRow output;
+    ASSERT_OK(fused_op.Compute(input, &output));
+    ASSERT_EQ(output.size(), 1);
+    ASSERT_EQ(output[0]->shape(), TensorShape({3, 224, 224}));
+    ASSERT_EQ(output[0]->shape(), expected->shape());
+    EXPECT_EQ(memcmp(output[0]->GetBuffer(), expected->GetBuffer(), expected->SizeInBytes()), 0);
+  }
+}
+
+/// Feature: RandomCropDecodeResizeNormalize op
+/// Description: Measure the throughput of the fused op against Decode, RandomResizedCrop, Normalize and HWC2CHW.
+/// Expectation: Both run, the images per second of one core are printed
+TEST_F(MindDataTestNormalizeHwcToChwOp, DISABLED_TestThroughput) {
+  constexpr int kNumImages = 50;
+  std::vector<float> mean = {123.675, 116.28, 103.53};
+  std::vector<float> std = {58.395, 57.12, 57.375};
+  DecodeOp decode(true);
+  RandomCropAndResizeOp crop(224, 224);
+  NormalizeOp normalize(mean, std, true);
+  HwcToChwOp hwc_to_chw;
+  RandomCropDecodeResizeNormalizeOp fused(RandomCropDecodeResizeOp(224, 224), mean, std);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kNumImages; i++) {
+    std::shared_ptr<Tensor> decoded;
+    std::shared_ptr<Tensor> normalized;
+    std::shared_ptr<Tensor> output;
+    TensorRow cropped;
+    ASSERT_OK(decode.Compute(raw_input_tensor_, &decoded));
+    ASSERT_OK(crop.Compute(TensorRow(0, {decoded}), &cropped));
+    ASSERT_OK(normalize.Compute(cropped[0], &normalized));
+    ASSERT_OK(hwc_to_chw.Compute(normalized, &output));
+  }
+  auto middle = std::chrono::steady_clock::now();
+  for (int i = 0; i < kNumImages; i++) {
+    TensorRow output;
+    ASSERT_OK(fused.Compute(TensorRow(0, {raw_input_tensor_}), &output));
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  double unfused_sec = std::chrono::duration<double>(middle - start).count();
+  double fused_sec = std::chrono::duration<double>(end - middle).count();
+  std::cout << "Images/sec per core, unfused: " << kNumImages / unfused_sec << ", fused: " << kNumImages / fused_sec
+            << std::endl;
+}
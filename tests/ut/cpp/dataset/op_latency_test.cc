@@ -0,0 +1,251 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/perf/bottleneck_analyzer.h"
+#include "minddata/dataset/engine/perf/op_latency.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestOpLatency : public UT::Common {
+ public:
+  MindDataTestOpLatency() {}
+};
+
+/// Feature: LatencyHistogram
+/// Description: Put latencies across the whole range in the buckets and read the value of their bucket back
+/// Expectation: The buckets are increasing and the value of a bucket is within 6.25% of the latencies in it
+TEST_F(MindDataTestOpLatency, TestHistogramBuckets) {
+  int32_t previous = -1;
+  for (uint64_t ns = 1; ns < (1ULL << LatencyHistogram::kMaxExponent); ns += ns / 7 + 1) {
+    int32_t bucket = LatencyHistogram::BucketOf(ns);
+    EXPECT_GE(bucket, previous);
+    EXPECT_LT(bucket, LatencyHistogram::kNumBuckets);
+    previous = bucket;
+    double value = static_cast<double>(LatencyHistogram::BucketValue(bucket));
+    EXPECT_LE(std::abs(value - static_cast<double>(ns)), 0.0625 * static_cast<double>(ns) + 1) << ns;
+  }
+  EXPECT_EQ(LatencyHistogram::BucketOf(0), 0);
+  EXPECT_EQ(LatencyHistogram::BucketOf(UINT64_MAX), LatencyHistogram::kNumBuckets - 1);
+}
+
+/// Feature: LatencyHistogram
+/// Description: Add the latencies from 1 to 100000 ns and subtract an earlier snapshot
+/// Expectation: The count, mean and percentiles are those of the latencies, within the precision of a bucket
+TEST_F(MindDataTestOpLatency, TestHistogramPercentile) {
+  constexpr uint64_t kNumValues = 100000;
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Percentile(0.5), 0);
+  for (uint64_t ns = 1; ns <= kNumValues; ns++) {
+    histogram.Add(ns);
+  }
+  EXPECT_EQ(histogram.Count(), kNumValues);
+  EXPECT_DOUBLE_EQ(histogram.Mean(), (kNumValues + 1) / 2.0);
+  EXPECT_NEAR(histogram.Percentile(0.5), 50000, 50000 * 0.0625);
+  EXPECT_NEAR(histogram.Percentile(0.99), 99000, 99000 * 0.0625);
+  EXPECT_LE(histogram.Percentile(0), 1);
+
+  LatencyHistogram later = histogram;
+  for (uint64_t i = 0; i < kNumValues; i++) {
+    later.Add(1000000);
+  }
+  later.Subtract(histogram);
+  EXPECT_EQ(later.Count(), kNumValues);
+  EXPECT_EQ(later.Sum(), kNumValues * 1000000);
+  EXPECT_NEAR(later.Percentile(0.5), 1000000, 1000000 * 0.0625);
+}
+
+/// Feature: LatencyRecorder
+/// Description: Record from several threads at once
+/// Expectation: The snapshot counts every latency of every thread
+TEST_F(MindDataTestOpLatency, TestRecorderThreads) {
+  constexpr int32_t kNumThreads = 12;
+  constexpr uint64_t kPerThread = 20000;
+  LatencyRecorder recorder;
+  std::vector<std::thread> threads;
+  for (int32_t t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&recorder, t]() {
+      for (uint64_t i = 0; i < kPerThread; i++) {
+        recorder.Record(static_cast<uint64_t>(t + 1) * 1000);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  LatencyHistogram histogram;
+  recorder.Snapshot(&histogram);
+  EXPECT_EQ(histogram.Count(), kNumThreads * kPerThread);
+  EXPECT_EQ(histogram.Sum(), kPerThread * 1000 * kNumThreads * (kNumThreads + 1) / 2);
+  EXPECT_NEAR(histogram.Percentile(1.0), kNumThreads * 1000, kNumThreads * 1000 * 0.0625);
+}
+
+/// Feature: LatencyRecorder
+/// Description: Record from one thread into many recorders, each destroyed before the next one is created
+/// Expectation: Each recorder counts only its own latencies
+TEST_F(MindDataTestOpLatency, TestRecorderLifetime) {
+  constexpr uint64_t kNumRecorders = 300;
+  for (uint64_t r = 1; r <= kNumRecorders; r++) {
+    auto recorder = std::make_unique<LatencyRecorder>();
+    for (uint64_t i = 0; i < r; i++) {
+      recorder->Record(r);
+    }
+    LatencyHistogram histogram;
+    recorder->Snapshot(&histogram);
+    EXPECT_EQ(histogram.Count(), r);
+    EXPECT_EQ(histogram.Sum(), r * r);
+  }
+}
+
+namespace {
+constexpr int32_t kNumTensorOps = 3;
+constexpr int32_t kImageSize = 224 * 224 * 3;
+
+// A TensorOp on an image, a normalize of its pixels
+void NormalizeImage(const std::vector<uint8_t> &image, std::vector<float> *output) {
+  for (int32_t i = 0; i < kImageSize; i++) {
+    (*output)[i] = (static_cast<float>(image[i]) - 120.0f) / 58.0f;
+  }
+}
+
+// What the profiler records for a row of a map: the pop and push waits around its connectors, the time of the row
+// and the time of each TensorOp
+void RecordRow(OpLatency *latency) {
+  uint64_t pop = LatencyRecorder::Now();
+  latency->PopWait()->Record(LatencyRecorder::Now() - pop);
+  uint64_t row_start = LatencyRecorder::Now();
+  uint64_t start = LatencyRecorder::Now();
+  for (int32_t i = 0; i < kNumTensorOps; i++) {
+    uint64_t end = LatencyRecorder::Now();
+    latency->TensorOp(i)->Record(end - start);
+    start = end;
+  }
+  latency->Compute()->Record(LatencyRecorder::Now() - row_start);
+  uint64_t push = LatencyRecorder::Now();
+  latency->PushWait()->Record(LatencyRecorder::Now() - push);
+}
+}  // namespace
+
+/// Feature: LatencyRecorder
+/// Description: Time the recording of a row of a map with 3 TensorOps, and the row itself, 3 normalizes of an image
+/// Expectation: The recording takes less than 2% of the time of the row
+TEST_F(MindDataTestOpLatency, DISABLED_TestRecorderOverhead) {
+  constexpr int32_t kNumRows = 1000;
+  constexpr int32_t kNumRecords = 1000000;
+  OpLatency latency({"NormalizeOp", "NormalizeOp", "NormalizeOp"});
+  auto start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < kNumRecords; i++) {
+    RecordRow(&latency);
+  }
+  double record_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  std::vector<uint8_t> image(kImageSize, 1);
+  std::vector<float> output(kImageSize);
+  start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < kNumRows; i++) {
+    for (int32_t j = 0; j < kNumTensorOps; j++) {
+      NormalizeImage(image, &output);
+      image[i % kImageSize] = static_cast<uint8_t>(output[j]);
+    }
+  }
+  double row_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  LatencyHistogram histogram;
+  latency.Compute()->Snapshot(&histogram);
+  EXPECT_EQ(histogram.Count(), kNumRecords);
+  double overhead = (record_ns / kNumRecords) / (row_ns / kNumRows);
+  MS_LOG(INFO) << "Recording a row takes " << record_ns / kNumRecords << " ns, a row " << row_ns / kNumRows
+               << " ns, overhead " << overhead * 100 << "%.";
+  EXPECT_LT(overhead, 0.02);
+}
+
+namespace {
+// Generator(0) -> Map(1) -> Batch(2), the root first
+std::vector<OpLatencyTotals> Pipeline() {
+  std::vector<OpLatencyTotals> ops(3);
+  ops[0].op_id = 2;
+  ops[0].op_type = "BatchOp";
+  ops[0].num_workers = 1;
+  ops[0].children = {1};
+  ops[1].op_id = 1;
+  ops[1].op_type = "MapOp";
+  ops[1].num_workers = 4;
+  ops[1].children = {0};
+  ops[1].tensor_op_names = {"DecodeOp", "ResizeOp"};
+  ops[2].op_id = 0;
+  ops[2].op_type = "GeneratorOp";
+  ops[2].num_workers = 1;
+  return ops;
+}
+}  // namespace
+
+/// Feature: BottleneckAnalyzer
+/// Description: A map whose workers take 10 ms a row under a fast generator, over one second
+/// Expectation: The map is the bottleneck, with a ceiling of 400 rows/sec and decode as its slowest TensorOp
+TEST_F(MindDataTestOpLatency, TestAnalyzerMapBottleneck) {
+  constexpr uint64_t kSecond = 1000000000;
+  auto ops = Pipeline();
+  ops[0].push_wait = {12, 1000};
+  ops[0].pop_wait = {12, kSecond / 2};
+  ops[1].compute = {400, 400 * 10000000ULL};
+  ops[1].tensor_ops = {{400, 300 * 10000000ULL}, {400, 100 * 10000000ULL}};
+  ops[1].push_wait = {400, 4000};
+  ops[1].pop_wait = {400, kSecond * 9 / 10};
+  ops[2].push_wait = {500, kSecond * 95 / 100};
+  ops[2].pop_wait = {500, 1000};
+  BottleneckReport report;
+  ASSERT_OK(BottleneckAnalyzer::Analyze(ops, kSecond, &report));
+  EXPECT_EQ(report.op_id, 1);
+  EXPECT_EQ(report.op_type, "MapOp");
+  EXPECT_DOUBLE_EQ(report.ceiling, 400);
+  EXPECT_DOUBLE_EQ(report.throughput, 400);
+  EXPECT_EQ(report.tensor_op, "DecodeOp");
+  EXPECT_DOUBLE_EQ(report.tensor_op_share, 0.75);
+  EXPECT_DOUBLE_EQ(report.consumer_wait, 0.5);
+}
+
+/// Feature: BottleneckAnalyzer
+/// Description: A generator busy all the time under a map which waits for its rows
+/// Expectation: The generator is the bottleneck, neither the map nor the batch above it
+TEST_F(MindDataTestOpLatency, TestAnalyzerSourceBottleneck) {
+  constexpr uint64_t kSecond = 1000000000;
+  auto ops = Pipeline();
+  ops[0].push_wait = {3, 1000};
+  ops[0].pop_wait = {3, kSecond * 9 / 10};
+  ops[1].compute = {100, 100 * 1000000ULL};
+  ops[1].tensor_ops = {{100, 50 * 1000000ULL}, {100, 50 * 1000000ULL}};
+  ops[1].push_wait = {100, 1000};
+  ops[1].pop_wait = {100, kSecond * 9 / 10};
+  ops[2].push_wait = {100, 1000};
+  ops[2].pop_wait = {100, kSecond * 9 / 10};
+  BottleneckReport report;
+  ASSERT_OK(BottleneckAnalyzer::Analyze(ops, kSecond, &report));
+  EXPECT_EQ(report.op_id, 0);
+  EXPECT_EQ(report.op_type, "GeneratorOp");
+  EXPECT_NEAR(report.ceiling, 100, 1);
+  EXPECT_TRUE(report.tensor_op.empty());
+
+  // No row output gives no bottleneck, an empty interval is an error
+  std::vector<OpLatencyTotals> idle = Pipeline();
+  ASSERT_OK(BottleneckAnalyzer::Analyze(idle, kSecond, &report));
+  EXPECT_EQ(report.op_id, -1);
+  EXPECT_ERROR(BottleneckAnalyzer::Analyze(ops, 0, &report));
+}
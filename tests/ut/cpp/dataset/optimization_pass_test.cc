@@ -20,15 +20,20 @@
 #include "common/common.h"
 #include "gtest/gtest.h"
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/engine/ir/datasetops/batch_node.h"
 #include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/engine/opt/optional/batch_compute_pass.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/post/auto_worker_pass.h"
+#include "minddata/dataset/include/dataset/audio.h"
 #include "minddata/dataset/include/dataset/transforms.h"
 #include "minddata/dataset/include/dataset/vision.h"
 #include "minddata/dataset/include/dataset/vision_lite.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
 
@@ -120,3 +125,188 @@ TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassPreBuiltTensorO
   ASSERT_EQ(fused_ops.size(), 1);
   ASSERT_EQ(fused_ops[0]->Name(), kRandomCropDecodeResizeOp);
 }
+
+/// Feature: IR Optimization
+/// Description: Test TensorOpFusionPass on Decode, RandomResizedCrop, Normalize, HWC2CHW and TypeCast to float32
+/// Expectation: All the operations are fused into RandomCropDecodeResizeNormalizeOp
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassNormalizeHwcToChw) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassNormalizeHwcToChw.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto decode_op = vision::Decode();
+  auto random_resized_crop_op = vision::RandomResizedCrop({100});
+  auto normalize_op = vision::Normalize({121.0, 115.0, 100.0}, {70.0, 68.0, 71.0});
+  auto hwc_to_chw_op = vision::HWC2CHW();
+  auto type_cast_op = transforms::TypeCast(mindspore::DataType::kNumberTypeFloat32);
+  std::shared_ptr<Dataset> root = ImageFolder(folder_path, false)
+                                    ->Map({decode_op, random_resized_crop_op, normalize_op, hwc_to_chw_op, type_cast_op},
+                                          {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  // no deepcopy is performed because this doesn't go through tree_adapter
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, true);
+  ASSERT_NE(map_node, nullptr);
+  auto fused_ops = map_node->operations();
+  ASSERT_EQ(fused_ops.size(), 1);
+  ASSERT_EQ(fused_ops[0]->Name(), kRandomCropDecodeResizeNormalizeOp);
+}
+
+/// Feature: IR Optimization
+/// Description: Test TensorOpFusionPass on pre-built Normalize and HWC2CHW, with and without is_hwc, and twice in a map
+/// Expectation: Each Normalize of an HWC image and HWC2CHW are fused into NormalizeHwcToChwOp, the others are kept
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassNormalizeHwcToChwPreBuilt) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassNormalizeHwcToChwPreBuilt.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::vector<float> mean = {121.0, 115.0, 100.0};
+  std::vector<float> std = {70.0, 68.0, 71.0};
+  auto decode = std::make_shared<transforms::PreBuiltOperation>(vision::DecodeOperation(true).Build());
+  auto hwc_to_chw = std::make_shared<transforms::PreBuiltOperation>(vision::HwcToChwOperation().Build());
+  std::shared_ptr<DatasetNode> root = ImageFolder(folder_path, false)->IRNode();
+
+  auto normalize = std::make_shared<transforms::PreBuiltOperation>(vision::NormalizeOperation(mean, std, true).Build());
+  std::vector<std::shared_ptr<TensorOperation>> op_list = {decode, normalize, hwc_to_chw};
+  std::shared_ptr<MapNode> map_node = std::make_shared<MapNode>(root, op_list, std::vector<std::string>{"image"});
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  fusion_pass.Run(map_node, &modified);
+  EXPECT_EQ(modified, true);
+  auto fused_ops = map_node->operations();
+  ASSERT_EQ(fused_ops.size(), 2);
+  EXPECT_EQ(fused_ops[0]->Name(), kDecodeOp);
+  EXPECT_EQ(fused_ops[1]->Name(), kNormalizeHwcToChwOp);
+
+  // Every pair of the map is fused, with the pre-built TypeCast to float32 after it
+  auto type_cast = std::make_shared<transforms::PreBuiltOperation>(
+    transforms::TypeCastOperation(DataType(DataType::DE_FLOAT32)).Build());
+  op_list = {decode, normalize, hwc_to_chw, type_cast, normalize, hwc_to_chw};
+  map_node = std::make_shared<MapNode>(root, op_list, std::vector<std::string>{"image"});
+  modified = false;
+  fusion_pass.Run(map_node, &modified);
+  EXPECT_EQ(modified, true);
+  fused_ops = map_node->operations();
+  ASSERT_EQ(fused_ops.size(), 3);
+  EXPECT_EQ(fused_ops[0]->Name(), kDecodeOp);
+  EXPECT_EQ(fused_ops[1]->Name(), kNormalizeHwcToChwOp);
+  EXPECT_EQ(fused_ops[2]->Name(), kNormalizeHwcToChwOp);
+
+  // Normalize of a CHW image can not be fused with HWC2CHW
+  normalize = std::make_shared<transforms::PreBuiltOperation>(vision::NormalizeOperation(mean, std, false).Build());
+  op_list = {decode, normalize, hwc_to_chw};
+  map_node = std::make_shared<MapNode>(root, op_list, std::vector<std::string>{"image"});
+  modified = false;
+  fusion_pass.Run(map_node, &modified);
+  EXPECT_EQ(modified, false);
+  EXPECT_EQ(map_node->operations().size(), 3);
+}
+
+/// Feature: IR Optimization
+/// Description: Test BatchComputePass on maps before and after a batch, with and without batched kernels
+/// Expectation: Only the maps after the batch whose operations all have a batched kernel run on whole batches
+TEST_F(MindDataTestOptimizationPass, MindDataTestBatchComputePass) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestBatchComputePass.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto type_cast = std::make_shared<transforms::TypeCast>(mindspore::DataType::kNumberTypeFloat32);
+  auto normalize =
+    std::make_shared<vision::Normalize>(std::vector<float>{121.0, 115.0, 100.0}, std::vector<float>{70.0, 68.0, 71.0});
+  auto decode = std::make_shared<vision::Decode>();
+  auto resize = std::make_shared<vision::Resize>(std::vector<int32_t>{32, 32});
+  auto flip = std::make_shared<vision::RandomVerticalFlip>(0.5);
+  std::shared_ptr<Dataset> decoded = ImageFolder(folder_path, false)->Map({decode, resize}, {"image"});
+  std::shared_ptr<Dataset> normalized = decoded->Batch(2)->Map({normalize}, {"image"});
+  std::shared_ptr<Dataset> renormalized = normalized->Project({"image"})->Map({normalize}, {"image"});
+  std::shared_ptr<Dataset> cast = renormalized->Map({type_cast, normalize}, {"image"});
+  std::shared_ptr<Dataset> flipped = cast->Map({flip}, {"image"});
+  std::shared_ptr<Dataset> root = flipped->Map({normalize}, {"image"});
+
+  BatchComputePass batch_compute_pass;
+  bool modified = false;
+  ASSERT_OK(batch_compute_pass.Run(root->IRNode(), &modified));
+  EXPECT_TRUE(modified);
+  // before the batch
+  EXPECT_FALSE(std::dynamic_pointer_cast<MapNode>(decoded->IRNode())->IsBatchCompute());
+  // right after the batch, and after a project and a batched map
+  EXPECT_TRUE(std::dynamic_pointer_cast<MapNode>(normalized->IRNode())->IsBatchCompute());
+  EXPECT_TRUE(std::dynamic_pointer_cast<MapNode>(renormalized->IRNode())->IsBatchCompute());
+  // TypeCast has no batched kernel, the map already casts each batch as a whole
+  EXPECT_FALSE(std::dynamic_pointer_cast<MapNode>(cast->IRNode())->IsBatchCompute());
+  // random ops are run row by row, and so are the maps after them
+  EXPECT_FALSE(std::dynamic_pointer_cast<MapNode>(flipped->IRNode())->IsBatchCompute());
+  EXPECT_FALSE(std::dynamic_pointer_cast<MapNode>(root->IRNode())->IsBatchCompute());
+}
+
+/// Feature: IR Optimization
+/// Description: Run the same pipeline with a map after batch in batch compute and in per-row execution
+/// Expectation: Both pipelines give the same batches
+TEST_F(MindDataTestOptimizationPass, MindDataTestBatchComputePipeline) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestBatchComputePipeline.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::vector<std::shared_ptr<Iterator>> iters;
+  for (bool batch_compute : {false, true}) {
+    auto normalize = std::make_shared<vision::Normalize>(std::vector<float>{121.0, 115.0, 100.0},
+                                                         std::vector<float>{70.0, 68.0, 71.0});
+    auto decode = std::make_shared<vision::Decode>();
+    auto resize = std::make_shared<vision::Resize>(std::vector<int32_t>{24, 32});
+    std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false)
+                                    ->Map({decode, resize}, {"image"})
+                                    ->Batch(3)
+                                    ->Map({normalize}, {"image"});
+    std::dynamic_pointer_cast<MapNode>(ds->IRNode())->SetBatchCompute(batch_compute);
+    iters.push_back(ds->CreateIterator());
+    ASSERT_NE(iters.back(), nullptr);
+  }
+  uint64_t num_batches = 0;
+  std::unordered_map<std::string, mindspore::MSTensor> expected;
+  std::unordered_map<std::string, mindspore::MSTensor> batch;
+  ASSERT_OK(iters[0]->GetNextRow(&expected));
+  ASSERT_OK(iters[1]->GetNextRow(&batch));
+  while (!expected.empty()) {
+    ASSERT_EQ(batch.size(), expected.size());
+    EXPECT_EQ(batch["image"].Shape(), expected["image"].Shape());
+    ASSERT_EQ(batch["image"].DataSize(), expected["image"].DataSize());
+    EXPECT_EQ(memcmp(batch["image"].Data().get(), expected["image"].Data().get(), batch["image"].DataSize()), 0);
+    EXPECT_EQ(batch["label"].Shape(), expected["label"].Shape());
+    num_batches++;
+    ASSERT_OK(iters[0]->GetNextRow(&expected));
+    ASSERT_OK(iters[1]->GetNextRow(&batch));
+  }
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(num_batches, 15);
+  iters[0]->Stop();
+  iters[1]->Stop();
+}
+
+/// Feature: IR Optimization
+/// Description: Test TensorOpFusionPass on Spectrogram, MelScale and AmplitudeToDB, and on a complex Spectrogram
+/// Expectation: The three operations are fused into MelSpectrogramOp, the complex spectrogram is kept
+TEST_F(MindDataTestOptimizationPass, MindDataTestTensorFusionPassMelSpectrogram) {
+  MS_LOG(INFO) << "Doing MindDataTestOptimizationPass-MindDataTestTensorFusionPassMelSpectrogram.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  auto spectrogram_op = audio::Spectrogram(512, 400, 160);
+  auto mel_scale_op = audio::MelScale(80, 16000, 0, 8000, 257);
+  auto amplitude_to_db_op = audio::AmplitudeToDB();
+  std::shared_ptr<Dataset> root =
+    ImageFolder(folder_path, false)->Map({spectrogram_op, mel_scale_op, amplitude_to_db_op}, {"image"});
+
+  TensorOpFusionPass fusion_pass;
+  bool modified = false;
+  std::shared_ptr<MapNode> map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  // no deepcopy is performed because this doesn't go through tree_adapter
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, true);
+  ASSERT_NE(map_node, nullptr);
+  auto fused_ops = map_node->operations();
+  ASSERT_EQ(fused_ops.size(), 1);
+  ASSERT_EQ(fused_ops[0]->Name(), kMelSpectrogramOp);
+
+  // the complex spectrogram of power 0 is not fused
+  auto complex_spectrogram_op = audio::Spectrogram(512, 400, 160, 0, WindowType::kHann, 0);
+  root = ImageFolder(folder_path, false)->Map({complex_spectrogram_op, mel_scale_op}, {"image"});
+  map_node = std::dynamic_pointer_cast<MapNode>(root->IRNode());
+  modified = false;
+  fusion_pass.Run(root->IRNode(), &modified);
+  EXPECT_EQ(modified, false);
+  ASSERT_NE(map_node, nullptr);
+  EXPECT_EQ(map_node->operations().size(), 2);
+}
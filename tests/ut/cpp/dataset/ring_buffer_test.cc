@@ -0,0 +1,195 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/util/queue.h"
+#include "minddata/dataset/util/ring_buffer.h"
+#include "minddata/dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestRingBuffer : public UT::Common {
+ public:
+  MindDataTestRingBuffer() {}
+
+  void SetUp() {}
+
+  // Push num_rows rows per producer into its own queue of a QueueList, and pop all of them in round robin
+  // order from a single consumer (the same pattern as ParallelOp workers and their collector).
+  // @return the elapsed time in milliseconds
+  double RunQueueList(int32_t num_producers, int64_t num_rows, bool lock_free);
+};
+
+double MindDataTestRingBuffer::RunQueueList(int32_t num_producers, int64_t num_rows, bool lock_free) {
+  constexpr int32_t kQueueCapacity = 16;
+  TaskGroup vg;
+  QueueList<TensorRow> queues;
+  queues.Init(num_producers, kQueueCapacity, lock_free);
+  EXPECT_OK(queues.Register(&vg));
+  std::atomic<int64_t> sum(0);
+  auto start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < num_producers; ++i) {
+    EXPECT_OK(vg.CreateAsyncTask("Producer", [&queues, i, num_rows]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int64_t j = 0; j < num_rows; ++j) {
+        TensorRow row(j, {});
+        RETURN_IF_NOT_OK(queues[i]->Add(std::move(row)));
+      }
+      return Status::OK();
+    }));
+  }
+  EXPECT_OK(vg.CreateAsyncTask("Consumer", [&queues, &sum, num_producers, num_rows]() -> Status {
+    TaskManager::FindMe()->Post();
+    for (int64_t j = 0; j < num_rows * num_producers; ++j) {
+      TensorRow row;
+      RETURN_IF_NOT_OK(queues[static_cast<int>(j % num_producers)]->PopFront(&row));
+      sum += row.getId();
+    }
+    return Status::OK();
+  }));
+  vg.join_all(Task::WaitFlag::kBlocking);
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_OK(vg.GetTaskErrorIfAny());
+  EXPECT_EQ(sum, num_producers * (num_rows * (num_rows - 1) / 2));
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/// Feature: RingBuffer
+/// Description: Test add and pop of unique pointers, and the full and empty conditions
+/// Expectation: Output is equal to the expected output
+TEST_F(MindDataTestRingBuffer, TestBasic) {
+  RingBuffer<std::unique_ptr<int>> ring(3);
+  ASSERT_EQ(ring.capacity(), 3);
+  ASSERT_TRUE(ring.empty());
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_OK(ring.Add(std::make_unique<int>(i)));
+  }
+  ASSERT_EQ(ring.size(), 3);
+  // The ring is full now, the element must not be moved from
+  auto extra = std::make_unique<int>(100);
+  ASSERT_FALSE(ring.TryAdd(std::move(extra)));
+  ASSERT_NE(extra.get(), nullptr);
+  std::unique_ptr<int> v;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_OK(ring.PopFront(&v));
+    ASSERT_EQ(*v, i);
+  }
+  ASSERT_FALSE(ring.TryPopFront(&v));
+  // Wrap around a few laps
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_OK(ring.EmplaceBack(new int(i)));
+    ASSERT_OK(ring.PopFront(&v));
+    ASSERT_EQ(*v, i);
+  }
+  ASSERT_TRUE(ring.empty());
+}
+
+/// Feature: Queue
+/// Description: Test a lock free Queue and QueueList
+/// Expectation: Output is equal to the expected output, and Resize is rejected
+TEST_F(MindDataTestRingBuffer, TestLockFreeQueue) {
+  Queue<std::shared_ptr<int>> que(3, true);
+  ASSERT_TRUE(que.lock_free());
+  std::shared_ptr<int> a = std::make_shared<int>(20);
+  ASSERT_OK(que.Add(a));
+  ASSERT_EQ(a.use_count(), 2);
+  ASSERT_OK(que.EmplaceBack(std::make_shared<int>(30)));
+  ASSERT_EQ(que.size(), 2);
+  std::shared_ptr<int> b;
+  ASSERT_OK(que.PopFront(&b));
+  ASSERT_EQ(*b, 20);
+  ASSERT_ERROR(que.Resize(5));
+  que.Reset();
+  ASSERT_TRUE(que.empty());
+
+  QueueList<std::unique_ptr<int>> my_list_of_queues;
+  my_list_of_queues.Init(4, 3, true);
+  ASSERT_OK(my_list_of_queues[2]->Add(std::make_unique<int>(99)));
+  std::unique_ptr<int> popped;
+  ASSERT_OK(my_list_of_queues[2]->PopFront(&popped));
+  ASSERT_EQ(*popped, 99);
+}
+
+/// Feature: RingBuffer
+/// Description: Test many producers and consumers sharing a single small ring
+/// Expectation: Every element is popped exactly once
+TEST_F(MindDataTestRingBuffer, TestMultiProducerMultiConsumer) {
+  constexpr int32_t kNumProducers = 8;
+  constexpr int32_t kNumConsumers = 4;
+  constexpr int64_t kNumRows = 20000;
+  TaskGroup vg;
+  RingBuffer<int64_t> ring(4);
+  ASSERT_OK(ring.Register(&vg));
+  std::atomic<int64_t> sum(0);
+  std::atomic<int64_t> count(0);
+  for (int32_t i = 0; i < kNumProducers; ++i) {
+    ASSERT_OK(vg.CreateAsyncTask("Producer", [&ring]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int64_t j = 1; j <= kNumRows; ++j) {
+        RETURN_IF_NOT_OK(ring.Add(j));
+      }
+      return Status::OK();
+    }));
+  }
+  for (int32_t i = 0; i < kNumConsumers; ++i) {
+    ASSERT_OK(vg.CreateAsyncTask("Consumer", [&ring, &sum, &count]() -> Status {
+      TaskManager::FindMe()->Post();
+      for (int64_t j = 0; j < kNumRows * kNumProducers / kNumConsumers; ++j) {
+        int64_t v = 0;
+        RETURN_IF_NOT_OK(ring.PopFront(&v));
+        sum += v;
+        count++;
+      }
+      return Status::OK();
+    }));
+  }
+  vg.join_all(Task::WaitFlag::kBlocking);
+  ASSERT_OK(vg.GetTaskErrorIfAny());
+  ASSERT_EQ(count, kNumRows * kNumProducers);
+  ASSERT_EQ(sum, kNumProducers * (kNumRows * (kNumRows + 1) / 2));
+  ASSERT_TRUE(ring.empty());
+}
+
+/// Feature: Queue
+/// Description: Test a QueueList of 8 producers and a consumer popping round robin, mutex based and lock free
+/// Expectation: Both deliver every row
+TEST_F(MindDataTestRingBuffer, TestQueueListProducers) {
+  constexpr int32_t kNumProducers = 8;
+  constexpr int64_t kNumRows = 1000;
+  (void)RunQueueList(kNumProducers, kNumRows, false);
+  (void)RunQueueList(kNumProducers, kNumRows, true);
+}
+
+/// Feature: RingBuffer
+/// Description: Compare the mutex based Queue with the lock free one at 1, 8 and 64 producers.
+/// Expectation: Both deliver every row, the timing is printed
+TEST_F(MindDataTestRingBuffer, DISABLED_TestPerfQueueList) {
+  constexpr int64_t kTotalRows = 256000;
+  for (int32_t num_producers : {1, 8, 64}) {
+    int64_t num_rows = kTotalRows / num_producers;
+    double mutex_ms = RunQueueList(num_producers, num_rows, false);
+    double lock_free_ms = RunQueueList(num_producers, num_rows, true);
+    std::cout << "Producers: " << num_producers << ", rows: " << num_rows * num_producers
+              << ", Queue: " << mutex_ms << " ms, lock free Queue: " << lock_free_ms << " ms" << std::endl;
+  }
+}
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/engine/cache/storage_container.h"
+#include "minddata/dataset/util/path.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestStorageContainer : public UT::Common {
+ public:
+  MindDataTestStorageContainer() {}
+};
+
+/// Feature: StorageContainer
+/// Description: Insert buffers made of several slices, read them back, then free them and insert again
+/// Expectation: The data read is the data inserted, and the space freed is handed out again
+TEST_F(MindDataTestStorageContainer, TestInsertReadFree) {
+  std::string file = "./storage_container_test.spill";
+  std::shared_ptr<StorageContainer> container;
+  ASSERT_OK(StorageContainer::CreateStorageContainer(&container, file));
+
+  std::string header = "header";
+  std::vector<std::string> payloads;
+  std::vector<off64_t> offsets;
+  for (int i = 0; i < 8; i++) {
+    payloads.push_back(std::string(1000 * (i + 1), static_cast<char>('a' + i)));
+    off64_t offset = 0;
+    ASSERT_OK(container->Insert({ReadableSlice(header.data(), header.size()),
+                                 ReadableSlice(payloads[i].data(), payloads[i].size())},
+                                &offset));
+    offsets.push_back(offset);
+  }
+  for (int i = 0; i < 8; i++) {
+    std::string data(header.size() + payloads[i].size(), '\0');
+    WritableSlice dest(&data[0], data.size());
+    ASSERT_OK(container->Read(&dest, offsets[i]));
+    EXPECT_EQ(data, header + payloads[i]);
+  }
+
+  // The space of a freed buffer of the same size is the first one found again
+  container->Free(offsets[0], header.size() + payloads[0].size());
+  off64_t offset = 0;
+  ASSERT_OK(container->Insert({ReadableSlice(payloads[0].data(), payloads[0].size())}, &offset));
+  EXPECT_EQ(offset, offsets[0]);
+
+  container.reset();
+  ASSERT_OK(Path(file).Remove());
+}
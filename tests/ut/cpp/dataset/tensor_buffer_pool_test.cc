@@ -0,0 +1,162 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/util/tensor_buffer_pool.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestTensorBufferPool : public UT::Common {
+ public:
+  MindDataTestTensorBufferPool() {}
+};
+
+/// Feature: TensorBufferPool
+/// Description: Round sizes up to the size classes
+/// Expectation: Every size fits its class, and wastes at most a quarter of the buffer
+TEST_F(MindDataTestTensorBufferPool, TestSizeClass) {
+  EXPECT_EQ(TensorBufferPool::SizeClass(1), 0);
+  EXPECT_EQ(TensorBufferPool::ClassSize(0), TensorBufferPool::kMinPooledSize);
+  EXPECT_EQ(TensorBufferPool::ClassSize(TensorBufferPool::SizeClass(224 * 224 * 3)), 163840);
+  int prev_class = 0;
+  for (size_t n = 1; n <= TensorBufferPool::kMaxPooledSize; n += n / 7 + 1) {
+    int size_class = TensorBufferPool::SizeClass(n);
+    size_t size = TensorBufferPool::ClassSize(size_class);
+    ASSERT_GE(size, n);
+    ASSERT_GE(size_class, prev_class);
+    if (size_class > 0) {
+      ASSERT_LT(TensorBufferPool::ClassSize(size_class - 1), n);
+      ASSERT_LE(size - n, size / 4);
+    }
+    prev_class = size_class;
+  }
+  EXPECT_EQ(TensorBufferPool::ClassSize(TensorBufferPool::SizeClass(TensorBufferPool::kMaxPooledSize)),
+            TensorBufferPool::kMaxPooledSize);
+}
+
+/// Feature: TensorBufferPool
+/// Description: Allocate, free and allocate again buffers of various sizes
+/// Expectation: Freed buffers are reused up to the capacity of the pool, and the counters follow
+TEST_F(MindDataTestTensorBufferPool, TestReuse) {
+  TensorBufferPool pool(1024 * 1024);
+  void *p = nullptr;
+  ASSERT_OK(pool.Allocate(1000, &p));
+  memset(p, 1, 1000);
+  auto stats = pool.GetStats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 0);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+  pool.Deallocate(p);
+  EXPECT_EQ(pool.GetStats().bytes_in_pool, 1024);
+  EXPECT_EQ(pool.GetStats().bytes_in_use, 0);
+
+  // a request of the same class gets the same buffer back
+  void *q = nullptr;
+  ASSERT_OK(pool.Allocate(1010, &q));
+  EXPECT_EQ(q, p);
+  stats = pool.GetStats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.bytes_in_pool, 0);
+
+  // growing within the class keeps the buffer, growing past it moves the data
+  ASSERT_OK(pool.Reallocate(&q, 1000, 1024));
+  EXPECT_EQ(q, p);
+  ASSERT_OK(pool.Reallocate(&q, 1000, 5000));
+  EXPECT_NE(q, p);
+  EXPECT_EQ(static_cast<unsigned char *>(q)[999], 1);
+  pool.Deallocate(q);
+
+  // buffers above the largest class and above the capacity are not kept
+  ASSERT_OK(pool.Allocate(TensorBufferPool::kMaxPooledSize + 1, &p));
+  pool.Deallocate(p);
+  std::vector<void *> buffers(5);
+  for (auto &buffer : buffers) {
+    ASSERT_OK(pool.Allocate(300 * 1024, &buffer));
+  }
+  for (auto &buffer : buffers) {
+    pool.Deallocate(buffer);
+  }
+  EXPECT_LE(pool.GetStats().bytes_in_pool, pool.capacity());
+  EXPECT_EQ(pool.GetStats().bytes_in_use, 0);
+  pool.Trim();
+  EXPECT_EQ(pool.GetStats().bytes_in_pool, 0);
+  EXPECT_EQ(pool.PercentFree(), 100);
+}
+
+/// Feature: TensorBufferPool
+/// Description: Allocate buffers in some threads and free them in others
+/// Expectation: The counters are consistent after all the buffers are freed
+TEST_F(MindDataTestTensorBufferPool, TestConcurrent) {
+  auto pool = std::make_shared<TensorBufferPool>(256 * 1024 * 1024);
+  constexpr int kNumThreads = 4;
+  constexpr int kNumBuffers = 2000;
+  std::vector<std::vector<void *>> buffers(kNumThreads, std::vector<void *>(kNumBuffers, nullptr));
+  for (int round = 0; round < 2; round++) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumThreads; t++) {
+      threads.emplace_back([&pool, &buffers, t]() {
+        for (int i = 0; i < kNumBuffers; i++) {
+          EXPECT_OK(pool->Allocate(64 + (i % 13) * 1000, &buffers[t][i]));
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    threads.clear();
+    for (int t = 0; t < kNumThreads; t++) {
+      // free the buffers allocated by another thread
+      threads.emplace_back([&pool, &buffers, t]() {
+        for (auto p : buffers[(t + 1) % kNumThreads]) {
+          pool->Deallocate(p);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+  auto stats = pool->GetStats();
+  EXPECT_EQ(stats.hits + stats.misses, 2 * kNumThreads * kNumBuffers);
+  EXPECT_EQ(stats.hits, kNumThreads * kNumBuffers);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+/// Feature: TensorBufferPool
+/// Description: Create tensors with and without a memory pool set for the thread
+/// Expectation: The data of the tensors comes from the pool of the thread when there is one
+TEST_F(MindDataTestTensorBufferPool, TestThreadMemoryPool) {
+  auto pool = std::make_shared<TensorBufferPool>(1024 * 1024);
+  std::shared_ptr<Tensor> tensor;
+  ASSERT_OK(Tensor::CreateEmpty(TensorShape({16, 16}), DataType(DataType::DE_FLOAT32), &tensor));
+  EXPECT_EQ(pool->GetStats().misses, 0);
+  {
+    ThreadMemoryPoolGuard guard(pool);
+    EXPECT_EQ(GetThreadMemoryPool(), pool);
+    ASSERT_OK(Tensor::CreateEmpty(TensorShape({16, 16}), DataType(DataType::DE_FLOAT32), &tensor));
+    EXPECT_EQ(pool->GetStats().misses, 1);
+  }
+  EXPECT_EQ(GetThreadMemoryPool(), nullptr);
+  // the tensor returns its buffer to the pool it came from
+  tensor.reset();
+  EXPECT_EQ(pool->GetStats().bytes_in_pool, 16 * 16 * sizeof(float));
+  EXPECT_EQ(pool->GetStats().bytes_in_use, 0);
+}
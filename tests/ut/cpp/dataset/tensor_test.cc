@@ -618,3 +618,92 @@ TEST_F(MindDataTestTensorDE, TensorEmpty) {
   t2->Invalidate();
   ASSERT_TRUE(!t2->HasData());
 }
+
+/// Feature: Tensor
+/// Description: Test a Tensor that borrows its memory, including moving it into a CVTensor
+/// Expectation: No data is copied, the owner is kept alive as long as the tensor references it
+TEST_F(MindDataTestTensorDE, TensorView) {
+  auto buffer = std::make_shared<std::vector<float>>(std::vector<float>{1, 2, 3, 4, 5, 6});
+  std::shared_ptr<const void> owner(buffer, buffer->data());
+  auto src = reinterpret_cast<const uchar *>(buffer->data());
+  std::shared_ptr<Tensor> t;
+  ASSERT_OK(Tensor::CreateFromMemoryView(TensorShape({2, 3}), DataType(DataType::DE_FLOAT32), src,
+                                         buffer->size() * sizeof(float), owner, &t));
+  ASSERT_TRUE(t->IsView());
+  ASSERT_EQ(t->GetBuffer(), src);
+  ASSERT_EQ(buffer.use_count(), 3);
+  float o;
+  ASSERT_OK(t->GetItemAt<float>(&o, {1, 2}));
+  ASSERT_EQ(o, 6);
+
+  // CVTensor exposes its data as a writable cv::Mat, so it copies the data and drops the owner
+  std::shared_ptr<CVTensor> cv_t = CVTensor::AsCVTensor(t);
+  ASSERT_FALSE(cv_t->IsView());
+  ASSERT_NE(cv_t->GetBuffer(), src);
+  ASSERT_EQ(cv_t->mat().at<float>(1, 0), 4);
+  ASSERT_EQ(buffer.use_count(), 2);
+  t.reset();
+  cv_t.reset();
+
+  // A copy does not borrow
+  ASSERT_OK(Tensor::CreateFromMemoryView(TensorShape({6}), DataType(DataType::DE_FLOAT32), src,
+                                         buffer->size() * sizeof(float), owner, &t));
+  std::shared_ptr<Tensor> copy;
+  ASSERT_OK(Tensor::CreateFromTensor(t, &copy));
+  ASSERT_FALSE(copy->IsView());
+  ASSERT_NE(copy->GetBuffer(), src);
+  ASSERT_EQ(*copy, *t);
+
+  // Unaligned memory, string type or wrong length can not be borrowed
+  ASSERT_ERROR(Tensor::CreateFromMemoryView(TensorShape({1}), DataType(DataType::DE_FLOAT32), src + 1, sizeof(float),
+                                            owner, &t));
+  ASSERT_ERROR(Tensor::CreateFromMemoryView(TensorShape({1}), DataType(DataType::DE_STRING), src, sizeof(float),
+                                            owner, &t));
+  ASSERT_ERROR(Tensor::CreateFromMemoryView(TensorShape({2}), DataType(DataType::DE_FLOAT32), src, sizeof(float),
+                                            owner, &t));
+}
+
+/// Feature: Tensor
+/// Description: Write into tensors that borrow the same memory, through SetItemAt, Fill and an iterator
+/// Expectation: Each write copies the data of the view first, the memory and the other views are unchanged
+TEST_F(MindDataTestTensorDE, TensorViewCopyOnWrite) {
+  auto buffer = std::make_shared<std::vector<int32_t>>(std::vector<int32_t>{1, 2, 3, 4});
+  std::shared_ptr<const void> owner(buffer, buffer->data());
+  auto src = reinterpret_cast<const uchar *>(buffer->data());
+  dsize_t length = buffer->size() * sizeof(int32_t);
+  std::shared_ptr<Tensor> t1;
+  std::shared_ptr<Tensor> t2;
+  std::shared_ptr<Tensor> t3;
+  ASSERT_OK(Tensor::CreateFromMemoryView(TensorShape({4}), DataType(DataType::DE_INT32), src, length, owner, &t1));
+  ASSERT_OK(Tensor::CreateFromMemoryView(TensorShape({4}), DataType(DataType::DE_INT32), src, length, owner, &t2));
+  ASSERT_OK(Tensor::CreateFromMemoryView(TensorShape({2, 2}), DataType(DataType::DE_INT32), src, length, owner, &t3));
+
+  ASSERT_OK(t1->SetItemAt<int32_t>({0}, 10));
+  ASSERT_FALSE(t1->IsView());
+  ASSERT_OK(t2->Fill<int32_t>(20));
+  ASSERT_FALSE(t2->IsView());
+  for (auto it = t3->begin<int32_t>(); it != t3->end<int32_t>(); ++it) {
+    *it += 30;
+  }
+  ASSERT_FALSE(t3->IsView());
+
+  ASSERT_EQ(*buffer, std::vector<int32_t>({1, 2, 3, 4}));
+  ASSERT_EQ(buffer.use_count(), 2);
+  int32_t o;
+  ASSERT_OK(t1->GetItemAt<int32_t>(&o, {0}));
+  ASSERT_EQ(o, 10);
+  ASSERT_OK(t1->GetItemAt<int32_t>(&o, {3}));
+  ASSERT_EQ(o, 4);
+  ASSERT_OK(t2->GetItemAt<int32_t>(&o, {1}));
+  ASSERT_EQ(o, 20);
+  ASSERT_OK(t3->GetItemAt<int32_t>(&o, {1, 1}));
+  ASSERT_EQ(o, 34);
+
+  // Reading does not copy
+  std::shared_ptr<Tensor> t4;
+  ASSERT_OK(Tensor::CreateFromMemoryView(TensorShape({4}), DataType(DataType::DE_INT32), src, length, owner, &t4));
+  ASSERT_OK(t4->GetItemAt<int32_t>(&o, {2}));
+  ASSERT_EQ(o, 3);
+  ASSERT_TRUE(t4->IsView());
+  ASSERT_EQ(t4->GetBuffer(), src);
+}
@@ -382,4 +382,33 @@ std::shared_ptr<Tensor> input;
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+
+/// Feature: BasicTokenizer op
+/// Description: Test BasicTokenizerOp on an ASCII text with an unused token, which takes the fast path
+/// Expectation: The tokens and offsets are those of the normalize and regex pipeline
+TEST_F(MindDataTestTokenizerOp, TestBasicTokenizerAscii) {
+  MS_LOG(INFO) << "Doing TestBasicTokenizerAscii.";
+  auto basic_tokenizer = std::make_unique<BasicTokenizerOp>(true, false, NormalizeForm::kNone, true, true);
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateScalar<std::string>("Hello, [UNK] World!", &input);
+  TensorRow output;
+  ASSERT_OK(basic_tokenizer->Compute(TensorRow(0, {input}), &output));
+  ASSERT_EQ(output.size(), 3);
+  EXPECT_EQ(output[0]->Size(), 5);
+  CheckEqual(output[0], {0}, "hello");
+  CheckEqual(output[0], {1}, ",");
+  CheckEqual(output[0], {2}, "[UNK]");
+  CheckEqual(output[0], {3}, "world");
+  CheckEqual(output[0], {4}, "!");
+  std::vector<uint32_t> expect_start = {0, 5, 7, 13, 18};
+  std::vector<uint32_t> expect_limit = {5, 6, 12, 18, 19};
+  for (dsize_t i = 0; i < 5; i++) {
+    uint32_t start = 0;
+    uint32_t limit = 0;
+    ASSERT_OK(output[1]->GetItemAt<uint32_t>(&start, {i}));
+    ASSERT_OK(output[2]->GetItemAt<uint32_t>(&limit, {i}));
+    EXPECT_EQ(start, expect_start[i]);
+    EXPECT_EQ(limit, expect_limit[i]);
+  }
+}
@@ -0,0 +1,245 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "common/mem_reuse/mem_size_class_allocator.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore::device {
+namespace {
+constexpr size_t kUnitSize = 64 << 20;
+
+// Takes the memory blocks from the host.
+class HostMemPool : public DynamicMemPoolSizeClass {
+ public:
+  explicit HostMemPool(bool size_class_enabled) {
+    set_size_class_enabled(size_class_enabled);
+    SetMemAllocUintSize(kUnitSize, kUnitSize);
+  }
+  ~HostMemPool() override { ReleaseDeviceRes(); }
+
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    *addr = malloc(size);
+    return *addr == nullptr ? 0 : size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    free(addr);
+    return true;
+  }
+  size_t free_mem_size() override { return SIZE_MAX; }
+};
+
+// The sizes of the tensors, mostly small with a few up to 4M.
+size_t RandomSize(std::mt19937 *gen) {
+  std::uniform_int_distribution<size_t> shift(6, 22);
+  std::uniform_int_distribution<size_t> fraction(0, 1023);
+  size_t size = size_t(1) << shift(*gen);
+  return size + size * fraction(*gen) / 1024;
+}
+
+// Allocates and frees rounds of tensors, checks that no two tensors overlap by writing a tag at both ends.
+void AllocFreeRounds(DynamicMemPoolBestFit *pool, size_t rounds, uint32_t seed, bool check) {
+  constexpr size_t kLiveTensors = 16;
+  std::mt19937 gen(seed);
+  std::vector<std::pair<uint8_t *, size_t>> tensors;
+  for (size_t round = 0; round < rounds; ++round) {
+    for (size_t i = 0; i < kLiveTensors; ++i) {
+      size_t size = RandomSize(&gen);
+      auto addr = static_cast<uint8_t *>(pool->AllocTensorMem(size));
+      ASSERT_NE(addr, nullptr);
+      if (check) {
+        uint8_t tag = static_cast<uint8_t>(seed + i);
+        addr[0] = tag;
+        addr[size - 1] = tag;
+      }
+      tensors.emplace_back(addr, size);
+    }
+    for (size_t i = 0; i < tensors.size(); ++i) {
+      if (check) {
+        uint8_t tag = static_cast<uint8_t>(seed + i);
+        ASSERT_EQ(tensors[i].first[0], tag);
+        ASSERT_EQ(tensors[i].first[tensors[i].second - 1], tag);
+      }
+      pool->FreeTensorMem(tensors[i].first);
+    }
+    tensors.clear();
+  }
+}
+}  // namespace
+
+class TestMemSizeClassAllocator : public UT::Common {
+ public:
+  TestMemSizeClassAllocator() {}
+};
+
+/// Feature: Size class memory pool.
+/// Description: Get the size class of the sizes around the bounds of the classes.
+/// Expectation: The powers of two up to 32K and the runs of pages up to 1M are classes, the larger sizes are not.
+TEST_F(TestMemSizeClassAllocator, SizeClass) {
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassOf(512), 0);
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassOf(1024), 1);
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassOf(1536), 2);
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassSize(2), 2048);
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassOf(32 << 10), 6);
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassOf((32 << 10) + 512), 7);
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassSize(7), kSizeClassPageSize);
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassOf(1 << 20), kSizeClassNum - 1);
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassSize(kSizeClassNum - 1), 1 << 20);
+  EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassOf((1 << 20) + 512), -1);
+  for (int size_class = 0; size_class < static_cast<int>(kSizeClassNum); ++size_class) {
+    EXPECT_EQ(DynamicMemPoolSizeClass::SizeClassOf(DynamicMemPoolSizeClass::SizeClassSize(size_class)), size_class);
+  }
+}
+
+/// Feature: Size class memory pool.
+/// Description: Allocate and free tensors of random sizes from several threads, which flush their caches at the end.
+/// Expectation: The tensors do not overlap, and all the memory coalesces back into one free span per memory block.
+TEST_F(TestMemSizeClassAllocator, AllocFreeThreads) {
+  constexpr size_t kNumThreads = 4;
+  HostMemPool pool(true);
+  ASSERT_TRUE(pool.size_class_enabled());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&pool, i]() {
+      AllocFreeRounds(&pool, 200, static_cast<uint32_t>(i), true);
+      pool.FlushThreadCache();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto stats = pool.GetSizeClassMemStats();
+  EXPECT_GT(stats.total_mem_size_, 0);
+  EXPECT_GT(stats.used_mem_peak_size_, 0);
+  EXPECT_EQ(stats.used_mem_size_, 0);
+  EXPECT_EQ(stats.cached_mem_size_, 0);
+  EXPECT_EQ(stats.slab_free_mem_size_, 0);
+  EXPECT_EQ(stats.free_mem_size_, stats.total_mem_size_);
+  EXPECT_EQ(stats.free_span_num_, stats.total_mem_size_ / kUnitSize);
+  EXPECT_GT(stats.InternalFragmentation(), 0);
+  EXPECT_LT(stats.InternalFragmentation(), 0.5);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+}
+
+/// Feature: Size class memory pool.
+/// Description: Allocate and free tensors from more threads than the thread cache slots, one after another, and let
+///     each thread exit without flushing its cache.
+/// Expectation: Every thread gets a cache from the slots of the exited threads, and their memory goes back to the
+///     central heap when they exit.
+TEST_F(TestMemSizeClassAllocator, ThreadExit) {
+  constexpr size_t kNumThreads = 2000;
+  HostMemPool pool(true);
+  size_t cached_threads = 0;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    std::thread thread([&pool, &cached_threads]() {
+      auto addr = pool.AllocTensorMem(1024);
+      ASSERT_NE(addr, nullptr);
+      pool.FreeTensorMem(addr);
+      if (pool.GetSizeClassMemStats().cached_mem_size_ > 0) {
+        ++cached_threads;
+      }
+    });
+    thread.join();
+  }
+  EXPECT_EQ(cached_threads, kNumThreads);
+  auto stats = pool.GetSizeClassMemStats();
+  EXPECT_EQ(stats.cached_mem_size_, 0);
+  EXPECT_EQ(stats.used_mem_size_, 0);
+  EXPECT_EQ(stats.free_span_num_, stats.total_mem_size_ / kUnitSize);
+}
+
+/// Feature: Size class memory pool.
+/// Description: Allocate continuous memory and small tensors, then free the pieces in any order.
+/// Expectation: The pieces are continuous, and their span goes back to the heap with the last piece.
+TEST_F(TestMemSizeClassAllocator, ContinuousMem) {
+  HostMemPool pool(true);
+  auto small = pool.AllocTensorMem(100);
+  ASSERT_NE(small, nullptr);
+  auto addr_list = pool.AllocContinuousTensorMem({1024, 4096, 100000});
+  ASSERT_EQ(addr_list.size(), 3);
+  EXPECT_EQ(addr_list[1], AddressOffset(addr_list[0], 1024));
+  EXPECT_EQ(addr_list[2], AddressOffset(addr_list[1], 4096));
+  auto used = pool.TotalUsedMemStatistics();
+  pool.FreeTensorMem(addr_list[1]);
+  pool.FreeTensorMem(addr_list[2]);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), used);
+  pool.FreeTensorMem(addr_list[0]);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), used - 2 * kSizeClassPageSize);
+
+  // Larger than the size classes and the memory block.
+  auto large = pool.AllocTensorMem(kUnitSize + 1);
+  ASSERT_NE(large, nullptr);
+  EXPECT_EQ(pool.GetSizeClassMemStats().total_mem_size_, kUnitSize * 3);
+  pool.FreeTensorMem(large);
+  pool.FreeTensorMem(small);
+  pool.FlushThreadCache();
+  auto stats = pool.GetSizeClassMemStats();
+  EXPECT_EQ(stats.used_mem_size_, 0);
+  EXPECT_EQ(stats.free_span_num_, 2);
+  EXPECT_DOUBLE_EQ(stats.ExternalFragmentation(), 1.0 / 3);
+}
+
+/// Feature: Size class memory pool.
+/// Description: Use the pool without enabling the size classes.
+/// Expectation: The best-fit pool serves the memory.
+TEST_F(TestMemSizeClassAllocator, BestFitFallback) {
+  HostMemPool pool(false);
+  AllocFreeRounds(&pool, 10, 0, true);
+  EXPECT_EQ(pool.GetSizeClassMemStats().total_mem_size_, 0);
+  EXPECT_GT(pool.TotalMemStatistics(), 0);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+}
+
+/// Feature: Size class memory pool.
+/// Description: Allocate and free tensors of random sizes from 1 to 8 threads with the best-fit pool and with the size
+///     class pool.
+/// Expectation: It runs, the allocations per second and the fragmentation are printed.
+TEST_F(TestMemSizeClassAllocator, DISABLED_AllocThroughputBenchmark) {
+  constexpr size_t kRounds = 2000;
+  for (size_t num_threads : {1, 2, 4, 8}) {
+    for (bool size_class_enabled : {false, true}) {
+      HostMemPool pool(size_class_enabled);
+      std::vector<std::thread> threads;
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&pool, i]() { AllocFreeRounds(&pool, kRounds, static_cast<uint32_t>(i), false); });
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+      auto end = std::chrono::steady_clock::now();
+      double seconds = std::chrono::duration<double>(end - start).count();
+      std::cout << (size_class_enabled ? "size class" : "best-fit  ") << ", " << num_threads
+                << " threads: " << num_threads * kRounds * 16 / seconds << " allocs/sec, peak used "
+                << pool.UsedMemPeakStatistics() / kMBToByte << "M of " << pool.TotalMemStatistics() / kMBToByte
+                << "M";
+      if (size_class_enabled) {
+        auto stats = pool.GetSizeClassMemStats();
+        std::cout << ", cached " << stats.cached_mem_size_ / kMBToByte << "M, internal fragmentation "
+                  << stats.InternalFragmentation() << ", external fragmentation " << stats.ExternalFragmentation();
+      }
+      std::cout << std::endl;
+    }
+  }
+}
+}  // namespace mindspore::device
@@ -18,6 +18,7 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,7 @@
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "minddata/mindrecord/include/shard_shuffle.h"
+#include "minddata/mindrecord/include/shard_shuffle_order.h"
 #include "ut_common.h"
 
 namespace mindspore {
@@ -374,6 +376,93 @@ TEST_F(TestShardOperator, TestShardShuffleCompare) {
   ASSERT_TRUE(different);
 }
 
+TEST_F(TestShardOperator, TestShardShuffleOrder) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test partial shuffle order"));
+
+  // 3 shards of 250, 400 and 90 tasks, then 10 padded tasks
+  const int64_t kNumTasks = 750;
+  std::vector<int64_t> shard_sample_count = {250, 650, 740};
+  ShardShuffleOrder order(shard_sample_count, kNumTasks, 5, 16, 4);
+  ShardShuffleOrder same_order(shard_sample_count, kNumTasks, 5, 16, 4);
+  ShardShuffleOrder other_order(shard_sample_count, kNumTasks, 6, 16, 4);
+  ASSERT_EQ(order.Size(), kNumTasks);
+
+  std::vector<int64_t> ids;
+  std::set<int64_t> unique_ids;
+  bool different = false;
+  for (int64_t i = 0; i < kNumTasks; i++) {
+    ids.push_back(order.Get(i));
+    unique_ids.insert(ids.back());
+    ASSERT_EQ(ids.back(), same_order.Get(i));
+    if (ids.back() != other_order.Get(i)) different = true;
+  }
+  ASSERT_EQ(unique_ids.size(), kNumTasks);
+  ASSERT_EQ(*unique_ids.begin(), 0);
+  ASSERT_EQ(*unique_ids.rbegin(), kNumTasks - 1);
+  ASSERT_TRUE(different);
+
+  // random access gives the same ids as a sequential read
+  for (int64_t i = kNumTasks - 1; i >= 0; i -= 7) {
+    ASSERT_EQ(same_order.Get(i), ids[i]);
+  }
+
+  // workers reading in turn from positions a window apart, so from more windows than the order keeps
+  const int64_t kWindowTasks = 16 * 4;
+  for (int64_t i = 0; i < kWindowTasks; i++) {
+    for (int64_t window = 0; window <= static_cast<int64_t>(ShardShuffleOrder::kCachedWindows); window++) {
+      int64_t pos = window * kWindowTasks + i;
+      ASSERT_EQ(order.Get(pos), ids[pos]);
+    }
+  }
+
+  // a slice wraps around at the end of the order, and a slice of a slice at the end of its own range
+  auto slice = order.Slice(700, 100);
+  ASSERT_EQ(slice->Size(), 100);
+  for (int64_t i = 0; i < 100; i++) {
+    ASSERT_EQ(slice->Get(i), ids[(700 + i) % kNumTasks]);
+  }
+  auto sub_slice = slice->Slice(90, 20);
+  for (int64_t i = 0; i < 20; i++) {
+    ASSERT_EQ(sub_slice->Get(i), ids[(700 + (90 + i) % 100) % kNumTasks]);
+  }
+}
+
+TEST_F(TestShardOperator, TestShardShufflePartial) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet"));
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  auto read_all = [&file_name, &column_list](uint32_t seed) {
+    std::vector<std::shared_ptr<ShardOperator>> ops;
+    auto shuffle = std::make_shared<ShardShuffle>(seed, 0, false, true, kShuffleSample);
+    shuffle->UpdateShuffleMode(dataset::ShuffleMode::kPartial);
+    ops.push_back(shuffle);
+    ShardReader dataset;
+    dataset.Open({file_name}, true, 4, column_list, ops);
+    dataset.Launch();
+    std::vector<std::string> file_names;
+    while (true) {
+      auto x = dataset.GetNext();
+      if (x.empty()) break;
+      file_names.push_back((std::get<1>(x[0]))["file_name"]);
+    }
+    dataset.Close();
+    return file_names;
+  };
+
+  ShardReader compare_dataset;
+  compare_dataset.Open({file_name}, true, 4, column_list);
+  compare_dataset.Launch();
+  int64_t num_rows = 0;
+  while (!compare_dataset.GetNext().empty()) num_rows++;
+  compare_dataset.Close();
+
+  auto file_names = read_all(1);
+  ASSERT_EQ(file_names.size(), num_rows);
+  ASSERT_EQ(std::set<std::string>(file_names.begin(), file_names.end()).size(), num_rows);
+  ASSERT_EQ(read_all(1), file_names);
+}
+
 TEST_F(TestShardOperator, TestShardCategoryShuffle1) {
   MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet"));
 
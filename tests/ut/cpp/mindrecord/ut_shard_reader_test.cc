@@ -15,10 +15,13 @@
  */
 
 #include <cstring>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "utils/ms_utils.h"
@@ -41,6 +44,7 @@ class TestShardReader : public UT::Common {
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(filename + kColumnarIndexSuffix));
     }
   }
 };
@@ -239,5 +243,107 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Close();
 }
+
+TEST_F(TestShardReader, TestShardReaderMmap) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet from mapped files"));
+  std::string file_name = "./imagenet.shard01";
+
+  ShardReader stream_reader;
+  ASSERT_TRUE(stream_reader.Open({file_name}, true, 4).IsOk());
+  ASSERT_TRUE(stream_reader.Launch(true).IsOk());
+  ASSERT_FALSE(stream_reader.UseMmap());
+
+  ShardReader mmap_reader;
+  mmap_reader.SetUseMmap(true);
+  ASSERT_TRUE(mmap_reader.Open({file_name}, true, 4).IsOk());
+  ASSERT_TRUE(mmap_reader.Launch(true).IsOk());
+  ASSERT_TRUE(mmap_reader.UseMmap());
+  ASSERT_EQ(mmap_reader.GetNumRows(), stream_reader.GetNumRows());
+
+  std::vector<ShardBlobView> views;
+  for (int64_t i = 0; i < stream_reader.GetNumRows(); ++i) {
+    auto expected = stream_reader.GetNextById(i, 0);
+    ASSERT_EQ(expected.second.size(), 1);
+    const auto &expected_blob = std::get<0>(expected.second[0]);
+
+    TaskType task_type;
+    ShardBlobView blob;
+    json var_fields;
+    ASSERT_TRUE(mmap_reader.GetNextViewById(i, 0, &task_type, &blob, &var_fields).IsOk());
+    ASSERT_EQ(task_type, TaskType::kCommonTask);
+    ASSERT_EQ(blob.size, expected_blob.size());
+    ASSERT_EQ(memcmp(blob.data.get(), expected_blob.data(), blob.size), 0);
+    ASSERT_EQ(var_fields, std::get<1>(expected.second[0]));
+    views.push_back(blob);
+  }
+  mmap_reader.Close();
+  stream_reader.Close();
+
+  // The blobs handed out keep their mapping alive after the reader is closed
+  ShardReader check_reader;
+  ASSERT_TRUE(check_reader.Open({file_name}, true, 1).IsOk());
+  ASSERT_TRUE(check_reader.Launch(true).IsOk());
+  for (int64_t i = 0; i < check_reader.GetNumRows(); ++i) {
+    auto expected = check_reader.GetNextById(i, 0);
+    const auto &expected_blob = std::get<0>(expected.second[0]);
+    ASSERT_EQ(memcmp(views[i].data.get(), expected_blob.data(), views[i].size), 0);
+  }
+  check_reader.Close();
+}
+
+TEST_F(TestShardReader, TestShardReaderColumnarIndex) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet through the columnar index"));
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  // rows and classes read through the meta files
+  std::vector<std::pair<std::vector<uint8_t>, json>> expected;
+  auto expected_classes = std::make_shared<std::set<std::string>>();
+  {
+    ShardReader reader;
+    ASSERT_TRUE(reader.Open({file_name}, true, 4, column_list).IsOk());
+    ASSERT_TRUE(reader.Launch(true).IsOk());
+    ASSERT_TRUE(reader.GetAllClasses("label", expected_classes).IsOk());
+    for (int64_t i = 0; i < reader.GetNumRows(); ++i) {
+      auto row = reader.GetNextById(i, 0);
+      ASSERT_EQ(row.second.size(), 1);
+      expected.emplace_back(std::get<0>(row.second[0]), std::get<1>(row.second[0]));
+    }
+    reader.Close();
+  }
+  ASSERT_FALSE(expected.empty());
+
+  ShardIndexGenerator generator(file_name, true, true);
+  ASSERT_TRUE(generator.Build().IsOk());
+  ASSERT_TRUE(generator.WriteToDatabase().IsOk());
+  // the meta files are not opened when every shard has a valid columnar index
+  for (int i = 1; i <= 4; i++) {
+    string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
+    remove(common::SafeCStr(db_name));
+  }
+
+  for (bool lazy_load : {false, true}) {
+    ShardReader reader;
+    ASSERT_TRUE(reader.Open({file_name}, true, 4, column_list, {}, 0, lazy_load).IsOk());
+    ASSERT_TRUE(reader.Launch(true).IsOk());
+    ASSERT_EQ(reader.GetNumRows(), static_cast<int64_t>(expected.size()));
+    auto classes = std::make_shared<std::set<std::string>>();
+    ASSERT_TRUE(reader.GetAllClasses("label", classes).IsOk());
+    ASSERT_EQ(*classes, *expected_classes);
+    for (int64_t i = 0; i < reader.GetNumRows(); ++i) {
+      auto row = reader.GetNextById(i, 0);
+      ASSERT_EQ(row.second.size(), 1);
+      ASSERT_EQ(std::get<0>(row.second[0]), expected[i].first);
+      ASSERT_EQ(std::get<1>(row.second[0]), expected[i].second);
+    }
+    reader.Close();
+  }
+
+  // a truncated index is rejected
+  std::ofstream("./imagenet.shard02.idx", std::ios::binary | std::ios::trunc) << "MRCOLIDX";
+  std::shared_ptr<ShardColumnarIndex> index;
+  ASSERT_FALSE(ShardColumnarIndex::Load("./imagenet.shard02", &index).IsOk());
+  ASSERT_TRUE(ShardColumnarIndex::Load("./imagenet.shard01", &index).IsOk());
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,287 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "actor/actormgr.h"
+#include "async/async.h"
+#include "thread/actor_threadpool.h"
+#include "thread/work_stealing_deque.h"
+
+namespace mindspore {
+class TestActorThreadPool : public UT::Common {
+ public:
+  TestActorThreadPool() {}
+};
+
+namespace {
+constexpr size_t kPingPongPairs = 16;
+constexpr int kPingPongMessages = 2000;
+constexpr size_t kFanOutLeaves = 64;
+constexpr int kFanOutRounds = 200;
+
+// Bounces a message with its peer until the count runs out
+class PingActor : public ActorBase {
+ public:
+  PingActor(const std::string &name, ActorThreadPool *pool, std::atomic<size_t> *finished)
+      : ActorBase(name, pool), finished_(finished) {}
+  ~PingActor() override = default;
+
+  void set_peer(const AID &peer) { peer_ = peer; }
+
+  void Ping(int remaining) {
+    if (remaining == 0) {
+      (void)finished_->fetch_add(1);
+      return;
+    }
+    Async(peer_, &PingActor::Ping, remaining - 1);
+  }
+
+ private:
+  AID peer_;
+  std::atomic<size_t> *finished_;
+};
+
+class FanOutRootActor;
+
+// Does a little work and answers the root
+class LeafActor : public ActorBase {
+ public:
+  LeafActor(const std::string &name, ActorThreadPool *pool, const AID &root) : ActorBase(name, pool), root_(root) {}
+  ~LeafActor() override = default;
+
+  void Work(int round);
+
+ private:
+  AID root_;
+  uint64_t state_{1};
+};
+
+// Sends a message to every leaf and starts the next round once they all answered, like an actor with many outputs
+class FanOutRootActor : public ActorBase {
+ public:
+  FanOutRootActor(const std::string &name, ActorThreadPool *pool, std::promise<void> *done)
+      : ActorBase(name, pool), done_(done) {}
+  ~FanOutRootActor() override = default;
+
+  void set_leaves(const std::vector<AID> &leaves) { leaves_ = leaves; }
+
+  void Start(int rounds) {
+    rounds_ = rounds;
+    SendRound(0);
+  }
+
+  void Answer(int round) {
+    if (++answers_ < leaves_.size()) {
+      return;
+    }
+    answers_ = 0;
+    if (round + 1 == rounds_) {
+      done_->set_value();
+      return;
+    }
+    SendRound(round + 1);
+  }
+
+ private:
+  void SendRound(int round) {
+    for (const auto &leaf : leaves_) {
+      Async(leaf, &LeafActor::Work, round);
+    }
+  }
+
+  std::vector<AID> leaves_;
+  size_t answers_{0};
+  int rounds_{0};
+  std::promise<void> *done_;
+};
+
+void LeafActor::Work(int round) {
+  for (int i = 0; i < 256; ++i) {
+    state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+  }
+  if (state_ == 0) {
+    return;
+  }
+  Async(root_, &FanOutRootActor::Answer, round);
+}
+
+ActorThreadPool *CreatePool(size_t thread_num, bool work_stealing) {
+  ActorThreadPool::set_work_stealing(work_stealing);
+  auto pool = ActorThreadPool::CreateThreadPool(thread_num);
+  ActorThreadPool::set_work_stealing(false);
+  if (pool != nullptr) {
+    pool->SetMaxSpinCount(kDefaultSpinCount);
+    pool->SetSpinCountMaxValue();
+  }
+  return pool;
+}
+
+void TerminateActors(const std::vector<std::shared_ptr<ActorBase>> &actors) {
+  for (const auto &actor : actors) {
+    ActorMgr::GetActorMgrRef()->Terminate(actor->GetAID());
+  }
+}
+
+// returns the seconds to bounce kPingPongMessages messages within each of kPingPongPairs pairs of actors
+double RunPingPong(ActorThreadPool *pool, const std::string &prefix) {
+  std::atomic<size_t> finished{0};
+  std::vector<std::shared_ptr<ActorBase>> actors;
+  std::vector<std::shared_ptr<PingActor>> firsts;
+  for (size_t i = 0; i < kPingPongPairs; ++i) {
+    auto ping = std::make_shared<PingActor>(prefix + "_ping_" + std::to_string(i), pool, &finished);
+    auto pong = std::make_shared<PingActor>(prefix + "_pong_" + std::to_string(i), pool, &finished);
+    ping->set_peer(pong->GetAID());
+    pong->set_peer(ping->GetAID());
+    (void)ActorMgr::GetActorMgrRef()->Spawn(ping);
+    (void)ActorMgr::GetActorMgrRef()->Spawn(pong);
+    actors.push_back(ping);
+    actors.push_back(pong);
+    firsts.push_back(ping);
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &ping : firsts) {
+    Async(ping->GetAID(), &PingActor::Ping, kPingPongMessages);
+  }
+  while (finished.load() < kPingPongPairs) {
+    std::this_thread::yield();
+  }
+  auto end = std::chrono::steady_clock::now();
+  TerminateActors(actors);
+  return std::chrono::duration<double>(end - start).count();
+}
+
+// returns the seconds for kFanOutRounds rounds of a root sending to kFanOutLeaves leaves and gathering their answers
+double RunFanOut(ActorThreadPool *pool, const std::string &prefix) {
+  std::promise<void> done;
+  auto root = std::make_shared<FanOutRootActor>(prefix + "_root", pool, &done);
+  std::vector<std::shared_ptr<ActorBase>> actors = {root};
+  std::vector<AID> leaves;
+  for (size_t i = 0; i < kFanOutLeaves; ++i) {
+    auto leaf = std::make_shared<LeafActor>(prefix + "_leaf_" + std::to_string(i), pool, root->GetAID());
+    (void)ActorMgr::GetActorMgrRef()->Spawn(leaf);
+    actors.push_back(leaf);
+    leaves.push_back(leaf->GetAID());
+  }
+  root->set_leaves(leaves);
+  (void)ActorMgr::GetActorMgrRef()->Spawn(root);
+  auto start = std::chrono::steady_clock::now();
+  Async(root->GetAID(), &FanOutRootActor::Start, kFanOutRounds);
+  done.get_future().wait();
+  auto end = std::chrono::steady_clock::now();
+  TerminateActors(actors);
+  return std::chrono::duration<double>(end - start).count();
+}
+}  // namespace
+
+/// Feature: Work stealing deque of the actor thread pool.
+/// Description: The owner pushes and pops while other threads steal.
+/// Expectation: Every element is taken exactly once.
+TEST_F(TestActorThreadPool, WorkStealingDeque) {
+  constexpr int kNumElements = 200000;
+  constexpr int kNumThieves = 3;
+  WorkStealingDeque<int> deque;
+  ASSERT_TRUE(deque.Init(100));
+  ASSERT_FALSE(deque.Init(100));
+  EXPECT_EQ(deque.Pop(), nullptr);
+  EXPECT_EQ(deque.Steal(), nullptr);
+
+  std::vector<int> values(kNumElements);
+  std::vector<std::atomic<int>> taken(kNumElements);
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < kNumThieves; ++i) {
+    thieves.emplace_back([&deque, &values, &taken, &stop]() {
+      while (!stop.load()) {
+        auto value = deque.Steal();
+        if (value != nullptr) {
+          (void)taken[value - values.data()].fetch_add(1);
+        }
+      }
+    });
+  }
+  int pushed = 0;
+  while (pushed < kNumElements) {
+    // push a few then pop one, a full deque is left to the thieves
+    for (int i = 0; i < 3 && pushed < kNumElements; ++i) {
+      if (deque.Push(&values[pushed])) {
+        ++pushed;
+      }
+    }
+    auto value = deque.Pop();
+    if (value != nullptr) {
+      (void)taken[value - values.data()].fetch_add(1);
+    }
+  }
+  while (auto value = deque.Pop()) {
+    (void)taken[value - values.data()].fetch_add(1);
+  }
+  stop = true;
+  for (auto &thief : thieves) {
+    thief.join();
+  }
+  EXPECT_TRUE(deque.Empty());
+  for (int i = 0; i < kNumElements; ++i) {
+    ASSERT_EQ(taken[i].load(), 1) << i;
+  }
+}
+
+/// Feature: Work stealing actor thread pool.
+/// Description: Run actor ping-pong and fan-out on the shared queue and on the work stealing run queues of 4 actor
+///     threads.
+/// Expectation: Every message is delivered with both schedulers.
+TEST_F(TestActorThreadPool, WorkStealingScheduler) {
+  constexpr size_t kThreadNum = 4;
+  for (bool work_stealing : {false, true}) {
+    auto pool = CreatePool(kThreadNum, work_stealing);
+    ASSERT_NE(pool, nullptr);
+    EXPECT_EQ(pool->work_stealing(), work_stealing);
+    std::string prefix = work_stealing ? "check_steal" : "check_shared";
+    (void)RunPingPong(pool, prefix);
+    (void)RunFanOut(pool, prefix);
+    delete pool;
+  }
+}
+
+/// Feature: Work stealing actor thread pool.
+/// Description: Run actor ping-pong and fan-out on the shared queue and on the work stealing run queues, from 4 to 64
+///     actor threads.
+/// Expectation: Every message is delivered with both schedulers, the time of each run is printed.
+TEST_F(TestActorThreadPool, DISABLED_SchedulerBenchmark) {
+  for (size_t thread_num : {4, 8, 16, 32, 64}) {
+    for (bool work_stealing : {false, true}) {
+      auto pool = CreatePool(thread_num, work_stealing);
+      ASSERT_NE(pool, nullptr);
+      EXPECT_EQ(pool->work_stealing(), work_stealing);
+      std::string prefix = (work_stealing ? "steal_" : "shared_") + std::to_string(thread_num);
+      double ping_pong_sec = RunPingPong(pool, prefix);
+      double fan_out_sec = RunFanOut(pool, prefix);
+      std::cout << (work_stealing ? "work stealing" : "shared queue ") << ", " << thread_num << " threads ("
+                << pool->GetActorThreadNum() << " started): ping-pong "
+                << kPingPongPairs * kPingPongMessages / ping_pong_sec << " msgs/sec, fan-out "
+                << kFanOutRounds * kFanOutLeaves * 2 / fan_out_sec << " msgs/sec" << std::endl;
+      delete pool;
+    }
+  }
+}
+}  // namespace mindspore
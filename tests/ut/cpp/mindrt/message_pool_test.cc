@@ -0,0 +1,309 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "actor/actormgr.h"
+#include "actor/mailbox.h"
+#include "actor/message_pool.h"
+#include "async/async.h"
+#include "thread/actor_threadpool.h"
+
+namespace mindspore {
+class TestMessagePool : public UT::Common {
+ public:
+  TestMessagePool() {}
+};
+
+namespace {
+constexpr int kBenchmarkMessages = 1000000;
+
+class CounterActor : public ActorBase {
+ public:
+  explicit CounterActor(const std::string &name) : ActorBase(name) {}
+  ~CounterActor() override = default;
+
+  void Add(int value) { sum_ += value; }
+
+  int64_t sum() const { return sum_; }
+
+ private:
+  int64_t sum_{0};
+};
+
+// Bounces a message with its peer until the count runs out
+class BounceActor : public ActorBase {
+ public:
+  BounceActor(const std::string &name, ActorThreadPool *pool, std::atomic<bool> *finished)
+      : ActorBase(name, pool), finished_(finished) {}
+  ~BounceActor() override = default;
+
+  void set_peer(const AID &peer) { peer_ = peer; }
+
+  void Bounce(int remaining) {
+    if (remaining == 0) {
+      *finished_ = true;
+      return;
+    }
+    Async(peer_, &BounceActor::Bounce, remaining - 1);
+  }
+
+ private:
+  AID peer_;
+  std::atomic<bool> *finished_;
+};
+
+// returns the seconds to send, take and run num_messages messages on one thread, with the std::function messages and
+// the locked list mailbox the actors used to have
+double RunListMailBox(CounterActor *actor, int num_messages) {
+  NonblockingMailBox mailbox;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_messages; ++i) {
+    std::function<void(ActorBase *)> handler = [i](ActorBase *actor) { static_cast<CounterActor *>(actor)->Add(i); };
+    (void)mailbox.EnqueueMessage(std::unique_ptr<MessageBase>(new (std::nothrow) MessageAsync(std::move(handler))));
+    auto msgs = mailbox.GetMsgs();
+    for (auto &msg : *msgs) {
+      msg->Run(actor);
+    }
+    msgs->clear();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+// the same with the pooled messages and the lock-free mailbox
+double RunMpscMailBox(CounterActor *actor, MessagePool *pool, int num_messages) {
+  MpscMailBox mailbox;
+  auto previous = MessagePool::SetCurrent(pool);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_messages; ++i) {
+    using Message = MessageApply<CounterActor, void (CounterActor::*)(int), std::tuple<int>>;
+    (void)mailbox.EnqueueMessage(
+      std::unique_ptr<MessageBase>(new (std::nothrow) Message(&CounterActor::Add, std::tuple<int>(i))));
+    auto msg = mailbox.GetMsg();
+    msg->Run(actor);
+  }
+  auto end = std::chrono::steady_clock::now();
+  (void)MessagePool::SetCurrent(previous);
+  return std::chrono::duration<double>(end - start).count();
+}
+}  // namespace
+
+/// Feature: Lock-free mailbox of the actors.
+/// Description: Several threads enqueue at once while one thread takes the messages each time the hook is called.
+/// Expectation: Every message is taken once, in order for each producer, and the hook is only called after the
+///     consumer found the mailbox empty.
+TEST_F(TestMessagePool, MpscMailBox) {
+  constexpr size_t kNumProducers = 4;
+  constexpr size_t kPerProducer = 50000;
+  MpscMailBox mailbox;
+  std::atomic<int> notified{0};
+  std::atomic<bool> double_notified{false};
+  mailbox.SetNotifyHook(std::make_unique<std::function<void()>>([&notified, &double_notified]() {
+    if (notified.fetch_add(1) != 0) {
+      double_notified = true;
+    }
+  }));
+  EXPECT_EQ(mailbox.GetMsg(), nullptr);
+
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < kNumProducers; ++p) {
+    producers.emplace_back([&mailbox, p]() {
+      for (size_t i = 0; i < kPerProducer; ++i) {
+        auto msg = std::make_unique<MessageBase>();
+        msg->data = reinterpret_cast<void *>(p);
+        msg->size = i;
+        (void)mailbox.EnqueueMessage(std::move(msg));
+      }
+    });
+  }
+  std::vector<size_t> next(kNumProducers, 0);
+  size_t received = 0;
+  while (received < kNumProducers * kPerProducer) {
+    if (notified.load() == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    notified = 0;
+    while (auto msg = mailbox.GetMsg()) {
+      auto p = reinterpret_cast<size_t>(msg->data);
+      ASSERT_LT(p, kNumProducers);
+      ASSERT_EQ(msg->size, next[p]);
+      ++next[p];
+      ++received;
+    }
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  EXPECT_FALSE(double_notified.load());
+  EXPECT_EQ(notified.load(), 0);
+  EXPECT_EQ(mailbox.GetMsg(), nullptr);
+
+  // the messages left behind are freed with the mailbox
+  auto left = std::make_unique<MpscMailBox>();
+  (void)left->EnqueueMessage(std::make_unique<MessageBase>());
+  (void)left->EnqueueMessage(std::make_unique<MessageBase>());
+}
+
+/// Feature: Message pool of the actors.
+/// Description: Allocate and free messages over and over, from the owner and from other threads, then release the
+///     pool with messages in flight.
+/// Expectation: The pool stops allocating once warmed up, gives the blocks of a burst beyond its cap back to the
+///     heap, and lives until the last message is freed.
+TEST_F(TestMessagePool, Recycle) {
+  constexpr size_t kInFlight = 16;
+  auto pool = new MessagePool();
+  auto previous = MessagePool::SetCurrent(pool);
+  std::vector<void *> msgs;
+  for (int round = 0; round < 100; ++round) {
+    for (size_t i = 0; i < kInFlight; ++i) {
+      auto msg = MessagePool::Allocate(MessagePool::kMaxMessageSize);
+      ASSERT_NE(msg, nullptr);
+      msgs.push_back(msg);
+    }
+    // the receivers free on their own threads
+    std::thread receiver([&msgs]() {
+      for (auto msg : msgs) {
+        MessagePool::Free(msg);
+      }
+    });
+    receiver.join();
+    msgs.clear();
+    EXPECT_EQ(pool->num_blocks(), kInFlight);
+  }
+
+  // a burst of messages, the blocks beyond the cap go back to the heap when the owner takes them back
+  constexpr size_t kBurst = MessagePool::kMaxCachedBlocks * 4;
+  for (size_t i = 0; i < kBurst; ++i) {
+    auto msg = MessagePool::Allocate(MessagePool::kMaxMessageSize);
+    ASSERT_NE(msg, nullptr);
+    msgs.push_back(msg);
+  }
+  EXPECT_EQ(pool->num_blocks(), kBurst);
+  std::thread receiver([&msgs]() {
+    for (auto msg : msgs) {
+      MessagePool::Free(msg);
+    }
+  });
+  receiver.join();
+  msgs.clear();
+  for (size_t i = 0; i < kInFlight; ++i) {
+    msgs.push_back(MessagePool::Allocate(MessagePool::kMaxMessageSize));
+  }
+  EXPECT_EQ(pool->num_blocks(), MessagePool::kMaxCachedBlocks);
+  for (auto msg : msgs) {
+    MessagePool::Free(msg);
+  }
+  msgs.clear();
+
+  // too large for the pool
+  auto large = MessagePool::Allocate(MessagePool::kMaxMessageSize + 1);
+  ASSERT_NE(large, nullptr);
+  MessagePool::Free(large);
+  EXPECT_EQ(pool->num_blocks(), MessagePool::kMaxCachedBlocks);
+
+  auto in_flight = MessagePool::Allocate(sizeof(MessageBase));
+  (void)MessagePool::SetCurrent(previous);
+  pool->Release();
+  MessagePool::Free(in_flight);
+
+  // no actor running, the message comes from the heap
+  auto outside = MessagePool::Allocate(sizeof(MessageBase));
+  ASSERT_NE(outside, nullptr);
+  MessagePool::Free(outside);
+}
+
+/// Feature: Lock-free mailbox and message pool of the actors.
+/// Description: Send, take and run messages with the old list mailbox and std::function messages, then with the
+///     lock-free mailbox and the pooled messages, then bounce messages between two actors of a thread pool.
+/// Expectation: Every message is run, and the pooled messages reuse a single block.
+TEST_F(TestMessagePool, RunMessages) {
+  constexpr int kNumMessages = 10000;
+  CounterActor list_actor("list_counter");
+  (void)RunListMailBox(&list_actor, kNumMessages);
+  CounterActor mpsc_actor("mpsc_counter");
+  auto pool = new MessagePool();
+  (void)RunMpscMailBox(&mpsc_actor, pool, kNumMessages);
+  EXPECT_EQ(pool->num_blocks(), 1);
+  pool->Release();
+  int64_t expected = static_cast<int64_t>(kNumMessages) * (kNumMessages - 1) / 2;
+  EXPECT_EQ(list_actor.sum(), expected);
+  EXPECT_EQ(mpsc_actor.sum(), expected);
+
+  auto thread_pool = ActorThreadPool::CreateThreadPool(2);
+  ASSERT_NE(thread_pool, nullptr);
+  std::atomic<bool> finished{false};
+  auto ping = std::make_shared<BounceActor>("check_bounce_ping", thread_pool, &finished);
+  auto pong = std::make_shared<BounceActor>("check_bounce_pong", thread_pool, &finished);
+  ping->set_peer(pong->GetAID());
+  pong->set_peer(ping->GetAID());
+  (void)ActorMgr::GetActorMgrRef()->Spawn(ping);
+  (void)ActorMgr::GetActorMgrRef()->Spawn(pong);
+  Async(ping->GetAID(), &BounceActor::Bounce, kNumMessages);
+  while (!finished.load()) {
+    std::this_thread::yield();
+  }
+  ActorMgr::GetActorMgrRef()->Terminate(ping->GetAID());
+  ActorMgr::GetActorMgrRef()->Terminate(pong->GetAID());
+  delete thread_pool;
+}
+
+/// Feature: Lock-free mailbox and message pool of the actors.
+/// Description: Time the runs above with a million messages.
+/// Expectation: Every message is run, the messages per second are printed.
+TEST_F(TestMessagePool, DISABLED_MailBoxBenchmark) {
+  CounterActor list_actor("list_counter");
+  double list_sec = RunListMailBox(&list_actor, kBenchmarkMessages);
+  CounterActor mpsc_actor("mpsc_counter");
+  auto pool = new MessagePool();
+  double mpsc_sec = RunMpscMailBox(&mpsc_actor, pool, kBenchmarkMessages);
+  EXPECT_EQ(pool->num_blocks(), 1);
+  pool->Release();
+  int64_t expected = static_cast<int64_t>(kBenchmarkMessages) * (kBenchmarkMessages - 1) / 2;
+  EXPECT_EQ(list_actor.sum(), expected);
+  EXPECT_EQ(mpsc_actor.sum(), expected);
+  std::cout << "list mailbox: " << kBenchmarkMessages / list_sec << " msgs/sec, lock-free mailbox with message pool: "
+            << kBenchmarkMessages / mpsc_sec << " msgs/sec" << std::endl;
+
+  auto thread_pool = ActorThreadPool::CreateThreadPool(2);
+  ASSERT_NE(thread_pool, nullptr);
+  std::atomic<bool> finished{false};
+  auto ping = std::make_shared<BounceActor>("bounce_ping", thread_pool, &finished);
+  auto pong = std::make_shared<BounceActor>("bounce_pong", thread_pool, &finished);
+  ping->set_peer(pong->GetAID());
+  pong->set_peer(ping->GetAID());
+  (void)ActorMgr::GetActorMgrRef()->Spawn(ping);
+  (void)ActorMgr::GetActorMgrRef()->Spawn(pong);
+  auto start = std::chrono::steady_clock::now();
+  Async(ping->GetAID(), &BounceActor::Bounce, kBenchmarkMessages / 10);
+  while (!finished.load()) {
+    std::this_thread::yield();
+  }
+  auto end = std::chrono::steady_clock::now();
+  ActorMgr::GetActorMgrRef()->Terminate(ping->GetAID());
+  ActorMgr::GetActorMgrRef()->Terminate(pong->GetAID());
+  std::cout << "actor ping-pong: " << kBenchmarkMessages / 10 / std::chrono::duration<double>(end - start).count()
+            << " msgs/sec" << std::endl;
+  delete thread_pool;
+}
+}  // namespace mindspore
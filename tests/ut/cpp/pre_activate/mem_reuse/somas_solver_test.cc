@@ -0,0 +1,260 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/common/somas/somas_solver_core.h"
+#include "backend/common/somas/somas_solver_pre.h"
+
+namespace mindspore::somas {
+namespace {
+constexpr size_t kAlignSize = 512;
+constexpr size_t kBitSetWidth = 64;
+
+struct TensorSpec {
+  size_t size;
+  size_t start;
+  size_t end;
+  bool lifelong;
+};
+
+// A graph of tensors living from the node producing them to their last consumer, mostly short lived with a few long
+// lived ones, the sizes from 512B to 4M. The tensors are indexed in the order of the nodes producing them, and the
+// tensors produced by the same node are continuous now and then.
+struct Problem {
+  std::vector<TensorSpec> specs;
+  std::vector<std::vector<size_t>> continuous;
+  std::vector<DynamicBitSet> constraints;
+
+  Problem(size_t num_tensors, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<size_t> shift(0, 13);
+    std::uniform_int_distribution<size_t> fraction(1, 8);
+    std::uniform_int_distribution<size_t> percent(0, 99);
+    std::geometric_distribution<size_t> short_life(0.3);
+    size_t num_nodes = num_tensors / 2 + 1;
+    std::uniform_int_distribution<size_t> node(0, num_nodes - 1);
+    for (size_t i = 0; i < num_tensors; ++i) {
+      size_t size = kAlignSize * fraction(gen) << shift(gen);
+      size_t start = i * num_nodes / num_tensors;
+      size_t life = percent(gen) < 10 ? node(gen) : short_life(gen);
+      bool lifelong = percent(gen) < 2;
+      // The next tensors come out of the same node, continuous with this one.
+      if (percent(gen) < 5 && i + 3 < num_tensors) {
+        std::vector<size_t> chain;
+        for (size_t j = 0; j < 3; ++j, ++i) {
+          specs.push_back({size, start, std::min(num_nodes - 1, start + life), false});
+          chain.push_back(i);
+        }
+        --i;
+        continuous.push_back(chain);
+        continue;
+      }
+      specs.push_back({size, start, std::min(num_nodes - 1, start + life), lifelong});
+    }
+    // The bit is true when the tensors can share memory, that is all but the tensors alive at the same time. The later
+    // tensors alive with a tensor follow it, as they start no earlier.
+    constraints.reserve(specs.size());
+    for (size_t i = 0; i < specs.size(); ++i) {
+      constraints.emplace_back(specs.size());
+      std::fill(constraints[i].bit_.begin(), constraints[i].bit_.end(), ~static_cast<uint64_t>(0));
+      for (size_t j = specs.size(); j < constraints[i].bit_size_ * kBitSetWidth; ++j) {
+        constraints[i].SetBitFalse(j);
+      }
+    }
+    for (size_t i = 0; i < specs.size(); ++i) {
+      constraints[i].SetBitFalse(i);
+      for (size_t j = i + 1; j < specs.size() && specs[j].start <= specs[i].end; ++j) {
+        constraints[i].SetBitFalse(j);
+        constraints[j].SetBitFalse(i);
+      }
+    }
+  }
+
+  TensorsDescMap CreateTensors() const {
+    TensorsDescMap tensors;
+    for (size_t i = 0; i < specs.size(); ++i) {
+      tensors[i] = std::make_shared<SomasSolverTensorDesc>(i, specs[i].size, 0, specs[i].lifelong);
+    }
+    for (const auto &chain : continuous) {
+      for (size_t i = 0; i + 1 < chain.size(); ++i) {
+        tensors[chain[i]]->right_ = tensors[chain[i + 1]];
+        tensors[chain[i + 1]]->left_ = tensors[chain[i]];
+      }
+    }
+    return tensors;
+  }
+
+  // The largest size alive at once, the lifelong tensors alive all the time.
+  size_t LowerBound() const {
+    size_t lifelong = 0;
+    std::vector<size_t> live;
+    for (const auto &spec : specs) {
+      if (spec.lifelong) {
+        lifelong += spec.size;
+        continue;
+      }
+      live.resize(std::max(live.size(), spec.end + 1), 0);
+      for (size_t time = spec.start; time <= spec.end; ++time) {
+        live[time] += spec.size;
+      }
+    }
+    return lifelong + *std::max_element(live.begin(), live.end());
+  }
+
+  // Check the tensors in conflict do not overlap and the continuous ones follow each other, returns the peak.
+  size_t Check(const TensorsDescMap &tensors) const {
+    size_t peak = 0;
+    for (size_t i = 0; i < specs.size(); ++i) {
+      const auto &t1 = tensors.at(i);
+      peak = std::max(peak, t1->offset_ + t1->size_);
+      EXPECT_EQ(t1->offset_ % kAlignSize, 0);
+      if (t1->right_ != nullptr) {
+        EXPECT_EQ(t1->right_->offset_, t1->offset_ + t1->size_);
+      }
+      for (size_t j = i + 1; j < specs.size(); ++j) {
+        const auto &t2 = tensors.at(j);
+        bool conflict = specs[i].lifelong || specs[j].lifelong || !constraints[i].IsBitTrue(j);
+        bool overlap = t1->offset_ < t2->offset_ + t2->size_ && t2->offset_ < t1->offset_ + t1->size_;
+        if (conflict && overlap) {
+          ADD_FAILURE() << "Tensors " << i << " and " << j << " overlap";
+          return peak;
+        }
+      }
+    }
+    return peak;
+  }
+};
+
+struct SolveResult {
+  size_t peak;
+  int64_t time;
+};
+
+std::shared_ptr<SolverTimeBudget> Budget(const std::chrono::nanoseconds &time) {
+  auto budget = std::make_shared<SolverTimeBudget>();
+  budget->Set(time);
+  return budget;
+}
+
+// Solve without a time budget when it is null.
+SolveResult Solve(const Problem &problem, AlgorithmType algorithm, FittingType fitting,
+                  const std::shared_ptr<SolverTimeBudget> &budget, bool check) {
+  auto tensors = problem.CreateTensors();
+  SomasSolverCore solver(tensors, &problem.constraints, 0, false);
+  solver.SetAlgorithmStrategy(algorithm);
+  solver.SetSortingStrategy(kGreaterSizeSmallerIndex);
+  solver.SetFittingStrategy(fitting);
+  solver.SetTimeBudget(budget);
+  auto start = std::chrono::steady_clock::now();
+  (void)solver.MemoryAllocationSolver();
+  auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  if (check && solver.GetUpperbound() != SIZE_MAX) {
+    EXPECT_EQ(problem.Check(tensors), solver.GetUpperbound());
+  }
+  return {solver.GetUpperbound(), time};
+}
+}  // namespace
+
+class TestSomasSolver : public UT::Common {
+ public:
+  TestSomasSolver() {}
+};
+
+/// Feature: Somas solver.
+/// Description: Solve random graphs with each algorithm and offset strategy.
+/// Expectation: The tensors in conflict do not overlap, the peak is no lower than the lower bound, and Global Fit is
+///     within 1% of the other algorithms.
+TEST_F(TestSomasSolver, AllAlgorithms) {
+  for (uint32_t seed = 0; seed < 4; ++seed) {
+    Problem problem(600, seed);
+    size_t lower_bound = problem.LowerBound();
+    size_t best_others = SIZE_MAX;
+    size_t global_fit = SIZE_MAX;
+    for (size_t algorithm = 0; algorithm < kNumAlgorithmTypes; ++algorithm) {
+      for (size_t fitting = 0; fitting < kNumFittingTypes; ++fitting) {
+        auto result = Solve(problem, AlgorithmType(algorithm), FittingType(fitting), nullptr, true);
+        ASSERT_NE(result.peak, SIZE_MAX);
+        EXPECT_GE(result.peak, lower_bound);
+        if (algorithm == kGlobalFit) {
+          global_fit = std::min(global_fit, result.peak);
+        } else {
+          best_others = std::min(best_others, result.peak);
+        }
+      }
+    }
+    EXPECT_LE(global_fit, best_others + best_others / 100);
+  }
+}
+
+/// Feature: Somas solver.
+/// Description: Solve with a time budget of 0.
+/// Expectation: Every algorithm gives up and leaves the upperbound SIZE_MAX.
+TEST_F(TestSomasSolver, TimeBudget) {
+  Problem problem(600, 0);
+  auto budget = Budget(std::chrono::nanoseconds(0));
+  for (size_t algorithm = 0; algorithm < kNumAlgorithmTypes; ++algorithm) {
+    EXPECT_EQ(Solve(problem, AlgorithmType(algorithm), kBest, budget, false).peak, SIZE_MAX);
+  }
+}
+
+/// Feature: Somas solver.
+/// Description: Solve a small graph with Global Fit in a budget of 10s, far more than it needs.
+/// Expectation: Global Fit places all the blocks, the peak is no lower than the lower bound and within 1% of the fast
+///     heuristics.
+TEST_F(TestSomasSolver, GlobalFitWithinBudget) {
+  Problem problem(200, 1);
+  auto budget = Budget(std::chrono::seconds(10));
+  auto global_fit = Solve(problem, kGlobalFit, kBest, budget, true).peak;
+  ASSERT_NE(global_fit, SIZE_MAX);
+  EXPECT_GE(global_fit, problem.LowerBound());
+  for (auto algorithm : {kManyObjects, kSingleObject}) {
+    auto peak = Solve(problem, algorithm, kBest, nullptr, true).peak;
+    EXPECT_LE(global_fit, peak + peak / 100);
+  }
+}
+
+/// Feature: Somas solver.
+/// Description: Solve graphs of 1000 to 100000 tensors with Shared Objects and the best fit, then with each algorithm
+///     and offset strategy in the budget the sweep gives them, twice the time of the first solution and no less than
+///     100ms.
+/// Expectation: It runs, the peak over the lower bound and the solve time are printed.
+TEST_F(TestSomasSolver, DISABLED_SolverBenchmark) {
+  constexpr int64_t kTimeScale = 2;
+  constexpr auto kMinBudget = std::chrono::milliseconds(100);
+  for (size_t num_tensors : {1000, 10000, 100000}) {
+    Problem problem(num_tensors, 1);
+    double lower_bound = static_cast<double>(problem.LowerBound());
+    std::shared_ptr<SolverTimeBudget> budget = nullptr;
+    for (size_t algorithm = 0; algorithm < kNumAlgorithmTypes; ++algorithm) {
+      for (size_t fitting = 0; fitting < kNumFittingTypes; ++fitting) {
+        auto result = Solve(problem, AlgorithmType(algorithm), FittingType(fitting), budget, false);
+        if (budget == nullptr) {
+          budget = Budget(std::max<std::chrono::nanoseconds>(std::chrono::milliseconds(result.time * kTimeScale),
+                                                              kMinBudget));
+        }
+        std::cout << num_tensors << " tensors, " << algorithmTypeNames[algorithm] << ", " << branchingNames[fitting]
+                  << ": peak / lower bound " << result.peak / lower_bound << ", " << result.time << " ms"
+                  << std::endl;
+      }
+    }
+  }
+}
+}  // namespace mindspore::somas
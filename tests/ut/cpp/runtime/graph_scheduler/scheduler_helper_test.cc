@@ -158,5 +158,42 @@ TEST_F(SchedulerHelperTest, AddMemoryFreeSign) {
   ASSERT_NE(from_actor->memory_free_insert_position(), nullptr);
   ASSERT_EQ(from_actor->memory_free_insert_position(), to_actor.get());
 }
+
+/// Feature: Static arena of somas.
+/// Description: Test AddMemoryAllocSign and AddMemoryFreeSign for the graph whose somas arena is preallocated.
+/// Expectation: No memory alloc or free actor is inserted for the graph.
+TEST_F(SchedulerHelperTest, AddMemorySignWithStaticArena) {
+  auto memory_manager_actor = std::make_shared<MemoryManagerActor>();
+  MS_EXCEPTION_IF_NULL(memory_manager_actor);
+  auto kernel_graph = std::make_shared<KernelGraph>();
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  std::vector<AnfNodePtr> inputs{NewValueNode(prim::kPrimLess)};
+  auto backend_node1 = kernel_graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(backend_node1);
+  auto backend_node2 = kernel_graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(backend_node2);
+  std::set<size_t> ref_input_indexes;
+  std::set<size_t> ref_output_indexes;
+
+  auto from_actor =
+    std::make_shared<KernelActor>("from_actor", backend_node1, nullptr, memory_manager_actor->GetAID(), nullptr,
+                                  nullptr, GraphExecutionStrategy::kPipeline, ref_input_indexes, ref_output_indexes);
+  auto to_actor =
+    std::make_shared<KernelActor>("to_actor", backend_node2, nullptr, memory_manager_actor->GetAID(), nullptr, nullptr,
+                                  GraphExecutionStrategy::kPipeline, ref_input_indexes, ref_output_indexes);
+
+  // Enable somas with the static arena.
+  auto somas_info = kernel_graph->MutableSomasInfo();
+  ASSERT_NE(somas_info, nullptr);
+  somas_info->whole_block_size_ = 1;
+  somas_info->static_arena_ = std::make_shared<uint8_t>(0);
+  somas_info->base_address_ = somas_info->static_arena_.get();
+  ASSERT_TRUE(kernel_graph->is_somas_static_arena());
+
+  SchedulerHelper::AddMemoryAllocSign(from_actor.get(), to_actor.get(), kernel_graph);
+  ASSERT_EQ(to_actor->memory_alloc_insert_position(), nullptr);
+  SchedulerHelper::AddMemoryFreeSign(from_actor.get(), to_actor.get(), kernel_graph);
+  ASSERT_EQ(from_actor->memory_free_insert_position(), nullptr);
+}
 }  // namespace runtime
 }  // namespace mindspore
@@ -470,6 +470,27 @@ HandleRcExit $? 0 0
 StopServer
 HandleRcExit $? 0 1
 
+# start cache server with a spilling path, an eviction policy and session quotas (in MB)
+cmd="${CACHE_ADMIN} --start -s /tmp -e lru --session_memory_quota 1 --session_disk_quota 2"
+CacheAdminCmd "${cmd}" 0
+sleep 1
+HandleRcExit $? 0 0
+
+GetSession
+HandleRcExit $? 1 1
+export SESSION_ID=$session_id
+PytestCmd "test_cache_nomap.py" "test_cache_nomap_eviction_demote"
+HandleRcExit $? 0 0
+
+GetSession
+HandleRcExit $? 1 1
+export SESSION_ID=$session_id
+PytestCmd "test_cache_nomap.py" "test_cache_nomap_eviction_drop"
+HandleRcExit $? 0 0
+
+StopServer
+HandleRcExit $? 0 1
+
 unset RUN_CACHE_TEST
 unset SESSION_ID
 
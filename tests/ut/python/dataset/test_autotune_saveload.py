@@ -197,6 +197,57 @@ class TestAutotuneSaveLoad:
 
         ds.config.set_seed(original_seed)
 
+    @staticmethod
+    def test_autotune_start_config(tmp_path, capfd):
+        """
+        Feature: Autotuning
+        Description: Save the final config of a Mnist pipeline and start AutoTune of later runs from it
+        Expectation: The config entry lists every op, a matching pipeline starts from it, a different one warns
+        """
+        original_autotune = ds.config.get_enable_autotune()
+        original_start_config = ds.config.get_autotune_start_config()
+
+        def create_pipeline(with_shuffle=False):
+            data = ds.MnistDataset(MNIST_DATA_DIR, num_samples=100, shuffle=False)
+            data = data.map(operations=transforms.OneHot(10), input_columns="label", num_parallel_workers=2)
+            if with_shuffle:
+                data = data.shuffle(10)
+            return data.batch(batch_size=10, drop_remainder=True)
+
+        ds.config.set_enable_autotune(True, str(tmp_path / "test_autotune_start_config_first"))
+        expected = [item["label"] for item in create_pipeline().create_dict_iterator(num_epochs=1, output_numpy=True)]
+        ds.config.set_enable_autotune(False)
+
+        file1 = tmp_path / ("test_autotune_start_config_first_" + os.environ['RANK_ID'] + ".json")
+        with file1.open() as f:
+            config = json.load(f)["config"]
+        assert [op["op_name"] for op in config] == ["BatchOp", "MapOp", "MnistOp"]
+        for op in config:
+            assert op["prefetch_size"] > 0
+        config[1]["num_parallel_workers"] = 3
+        with file1.open("w") as f:
+            json.dump({"config": config}, f)
+
+        ds.config.set_autotune_start_config(str(file1))
+        assert ds.config.get_autotune_start_config() == str(file1)
+        ds.config.set_enable_autotune(True, str(tmp_path / "test_autotune_start_config_second"))
+        output = [item["label"] for item in create_pipeline().create_dict_iterator(num_epochs=1, output_numpy=True)]
+        ds.config.set_enable_autotune(False)
+        assert len(output) == len(expected)
+        for out, exp in zip(output, expected):
+            np.testing.assert_array_equal(out, exp)
+        assert (tmp_path / ("test_autotune_start_config_second_" + os.environ['RANK_ID'] + ".json")).exists()
+
+        ds.config.set_enable_autotune(True)
+        for _ in create_pipeline(True).create_dict_iterator(num_epochs=1, output_numpy=True):
+            pass
+        ds.config.set_enable_autotune(False)
+        _, err = capfd.readouterr()
+        assert "the start configuration is ignored" in err
+
+        ds.config.set_autotune_start_config(original_start_config)
+        ds.config.set_enable_autotune(original_autotune)
+
     @staticmethod
     def test_autotune_imagefolder_pipeline_enum_parms(tmp_path):
         """
@@ -2538,6 +2538,94 @@ def test_cache_nomap_dataset_size2():
     logger.info("test_cache_nomap_dataset_size2 Ended.\n")
 
 
+
+@pytest.mark.skipif(os.environ.get('RUN_CACHE_TEST') != 'TRUE', reason="Require to bring up cache server")
+def test_cache_nomap_eviction_demote():
+    """
+    Feature: DatasetCache op
+    Description: Test a Cache over a RandomDataset larger than the session memory quota of the cache server,
+        started with an eviction policy, a spilling path and --session_memory_quota 1
+
+       Cache
+         |
+    RandomDataset
+
+    Expectation: Rows are moved to the disk, and every epoch after the first reads the rows of the first one
+    """
+    logger.info("Test cache nomap eviction demote")
+    if "SESSION_ID" in os.environ:
+        session_id = int(os.environ['SESSION_ID'])
+    else:
+        raise RuntimeError("Testcase requires SESSION_ID environment variable")
+
+    schema = ds.Schema()
+    schema.add_column('image', de_type=mstype.uint8, shape=[128, 128, 3])  # 49152 bytes
+    schema.add_column('label', de_type=mstype.uint8, shape=[1])
+    some_cache = ds.DatasetCache(session_id=session_id, size=0, spilling=True)
+
+    # 30 rows, about 1.5 MB
+    ds1 = ds.RandomDataset(schema=schema, total_rows=30, num_parallel_workers=4, cache=some_cache)
+    epochs = []
+    iter1 = ds1.create_dict_iterator(num_epochs=3, output_numpy=True)
+    for _ in range(3):
+        epochs.append(sorted(int(item["image"].sum()) for item in iter1))
+    assert len(epochs[0]) == 30
+    assert epochs[1] == epochs[0]
+    assert epochs[2] == epochs[0]
+
+    stat = some_cache.get_stat()
+    logger.info("Number of rows cached in memory: {}".format(stat.num_mem_cached))
+    logger.info("Number of rows spilled to disk: {}".format(stat.num_disk_cached))
+    assert stat.num_disk_cached > 0
+    assert stat.num_mem_cached + stat.num_disk_cached == 30
+    logger.info("test_cache_nomap_eviction_demote Ended.\n")
+
+
+@pytest.mark.skipif(os.environ.get('RUN_CACHE_TEST') != 'TRUE', reason="Require to bring up cache server")
+def test_cache_nomap_eviction_drop():
+    """
+    Feature: DatasetCache op
+    Description: Test a Cache after a Map producing more than the session memory and disk quotas of the cache server,
+        started with an eviction policy, a spilling path, --session_memory_quota 1 and --session_disk_quota 2
+
+       Cache
+         |
+    Map(Rescale)
+         |
+    RandomDataset
+
+    Expectation: Rows are dropped from the disk, and every epoch still produces all the rows
+    """
+    logger.info("Test cache nomap eviction drop")
+    if "SESSION_ID" in os.environ:
+        session_id = int(os.environ['SESSION_ID'])
+    else:
+        raise RuntimeError("Testcase requires SESSION_ID environment variable")
+
+    schema = ds.Schema()
+    schema.add_column('image', de_type=mstype.uint8, shape=[128, 128, 3])
+    schema.add_column('label', de_type=mstype.uint8, shape=[1])
+    some_cache = ds.DatasetCache(session_id=session_id, size=0, spilling=True)
+
+    # 40 rows of 196608 bytes after the Rescale to float32, about 7.5 MB
+    ds1 = ds.RandomDataset(schema=schema, total_rows=40, num_parallel_workers=4)
+    ds1 = ds1.map(operations=c_vision.Rescale(1.0, 0.0), input_columns=["image"], cache=some_cache)
+    iter1 = ds1.create_dict_iterator(num_epochs=3, output_numpy=True)
+    for _ in range(3):
+        num_iter = 0
+        for item in iter1:
+            assert item["image"].shape == (128, 128, 3)
+            assert item["image"].dtype == np.float32
+            num_iter += 1
+        assert num_iter == 40
+
+    stat = some_cache.get_stat()
+    logger.info("Number of rows cached in memory: {}".format(stat.num_mem_cached))
+    logger.info("Number of rows spilled to disk: {}".format(stat.num_disk_cached))
+    assert stat.num_mem_cached + stat.num_disk_cached < 40
+    logger.info("test_cache_nomap_eviction_drop Ended.\n")
+
+
 if __name__ == '__main__':
     # This is just a list of tests, don't try to run these tests with 'python test_cache_nomap.py'
     # since cache server is required to be brought up first
@@ -2599,3 +2687,5 @@ if __name__ == '__main__':
     test_cache_nomap_pyfunc_function()
     test_cache_nomap_dataset_size1()
     test_cache_nomap_dataset_size2()
+    test_cache_nomap_eviction_demote()
+    test_cache_nomap_eviction_drop()
@@ -516,6 +516,195 @@ def test_fast_recovery():
     assert "set_fast_recovery() missing 1 required positional argument: 'fast_recovery'" in str(error_info.value)
 
 
+def test_lock_free_connector():
+    """
+    Feature: Test the set_lock_free_connector function
+    Description: Run a parallel map with and without lock free worker connectors, and pass invalid inputs
+    Expectation: The output is the same in both modes, TypeError is raised when input is not a boolean
+    """
+    origin_lock_free_connector = ds.config.get_lock_free_connector()
+
+    def run_pipeline():
+        data = ds.NumpySlicesDataset(list(range(100)), column_names=["col"], shuffle=False)
+        data = data.map(operations=[lambda x: x * 2], input_columns=["col"], num_parallel_workers=4)
+        data = data.batch(8)
+        return [item["col"].tolist() for item in data.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    ds.config.set_lock_free_connector(False)
+    expected = run_pipeline()
+    ds.config.set_lock_free_connector(True)
+    assert ds.config.get_lock_free_connector()
+    assert run_pipeline() == expected
+    ds.config.set_lock_free_connector(origin_lock_free_connector)
+
+    config_error_func(ds.config.set_lock_free_connector, 1, TypeError, "lock_free_connector must be a boolean dtype")
+    config_error_func(ds.config.set_lock_free_connector, None, TypeError,
+                      "lock_free_connector must be a boolean dtype")
+
+
+def test_async_read_depth():
+    """
+    Feature: Test the set_async_read_depth function
+    Description: Read text, csv, clue and tfrecord files with and without async reads, and pass invalid inputs
+    Expectation: The output is the same in both modes, TypeError or ValueError is raised for invalid inputs
+    """
+    origin_async_read_depth = ds.config.get_async_read_depth()
+
+    def run_pipelines():
+        datasets = [ds.TextFileDataset(["../data/dataset/testTextFileDataset/1.txt",
+                                        "../data/dataset/testTextFileDataset/2.txt"], shuffle=False),
+                    ds.CSVDataset(["../data/dataset/testCSV/1.csv"], column_defaults=["1", "2", "3", "4"],
+                                  column_names=['col1', 'col2', 'col3', 'col4'], shuffle=False),
+                    ds.CLUEDataset(["../data/dataset/testCLUE/afqmc/train.json"], task='AFQMC', usage='train',
+                                   shuffle=False),
+                    ds.TFRecordDataset(["../data/dataset/testTFTestAllTypes/test.data"],
+                                       "../data/dataset/testTFTestAllTypes/datasetSchema.json", shuffle=False)]
+        results = []
+        for data in datasets:
+            results.append([[str(value) for value in item]
+                            for item in data.create_tuple_iterator(num_epochs=1, output_numpy=True)])
+        return results
+
+    ds.config.set_async_read_depth(0)
+    expected = run_pipelines()
+    assert all(expected)
+    ds.config.set_async_read_depth(4)
+    assert ds.config.get_async_read_depth() == 4
+    assert run_pipelines() == expected
+    ds.config.set_async_read_depth(origin_async_read_depth)
+
+    config_error_func(ds.config.set_async_read_depth, True, TypeError, "depth isn't of type int")
+    config_error_func(ds.config.set_async_read_depth, -1, ValueError, "depth is not within the required range")
+    config_error_func(ds.config.set_async_read_depth, 65, ValueError, "depth is not within the required range")
+
+
+def test_tensor_pool_size():
+    """
+    Feature: Test the set_tensor_pool_size function
+    Description: Run a map and batch pipeline with and without the tensor buffer pool, and pass invalid inputs
+    Expectation: The output is the same in both modes, TypeError or ValueError is raised for invalid inputs
+    """
+    origin_tensor_pool_size = ds.config.get_tensor_pool_size()
+
+    def run_pipeline():
+        data = ds.GeneratorDataset([(np.full((i % 7 + 1, 16), i, np.float32),) for i in range(64)], ["data"],
+                                   shuffle=False)
+        data = data.map(operations=[mindspore.dataset.transforms.TypeCast(np.float64)], input_columns=["data"],
+                        num_parallel_workers=2)
+        data = data.batch(4, pad_info={"data": ([7, 16], 0.0)})
+        return [item["data"] for item in data.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    ds.config.set_tensor_pool_size(0)
+    expected = run_pipeline()
+    ds.config.set_tensor_pool_size(16)
+    assert ds.config.get_tensor_pool_size() == 16
+    for _ in range(2):
+        output = run_pipeline()
+        assert len(output) == len(expected)
+        for out, exp in zip(output, expected):
+            np.testing.assert_array_equal(out, exp)
+    ds.config.set_tensor_pool_size(origin_tensor_pool_size)
+
+    config_error_func(ds.config.set_tensor_pool_size, 1.5, TypeError, "size isn't of type int")
+    config_error_func(ds.config.set_tensor_pool_size, -1, ValueError, "size is not within the required range")
+    config_error_func(ds.config.set_tensor_pool_size, 2147483648, ValueError,
+                      "size is not within the required range")
+
+
+def test_autotune_budget():
+    """
+    Feature: Test the set_autotune_budget and set_autotune_start_config functions
+    Description: Set valid and invalid AutoTune budgets and start configurations
+    Expectation: The values are set, TypeError, ValueError or RuntimeError is raised for invalid inputs
+    """
+    origin_budget = ds.config.get_autotune_budget()
+    origin_start_config = ds.config.get_autotune_start_config()
+    assert origin_budget == (100.0, 100.0)
+
+    ds.config.set_autotune_budget(80, 62.5)
+    assert ds.config.get_autotune_budget() == (80.0, 62.5)
+    ds.config.set_autotune_budget(*origin_budget)
+
+    with pytest.raises(TypeError, match="cpu_util must be of type int or float"):
+        ds.config.set_autotune_budget(True, 50)
+    with pytest.raises(TypeError, match="memory_util must be of type int or float"):
+        ds.config.set_autotune_budget(50, "50")
+    with pytest.raises(ValueError, match="cpu_util is not within the required range"):
+        ds.config.set_autotune_budget(0, 50)
+    with pytest.raises(ValueError, match="memory_util is not within the required range"):
+        ds.config.set_autotune_budget(50, 100.5)
+
+    config_file = "../data/dataset/declient.cfg"
+    ds.config.set_autotune_start_config(config_file)
+    assert ds.config.get_autotune_start_config() == config_file
+    ds.config.set_autotune_start_config(None)
+    assert ds.config.get_autotune_start_config() == ""
+    config_error_func(ds.config.set_autotune_start_config, 1, TypeError, "json_filepath must be of type str")
+    config_error_func(ds.config.set_autotune_start_config, "./not_exist_autotune.json", RuntimeError,
+                      "does not exist")
+    ds.config.set_autotune_start_config(origin_start_config)
+
+
+def test_shuffle_spill_dir():
+    """
+    Feature: Test the set_shuffle_spill_dir function
+    Description: Shuffle numeric and string rows with and without a spill directory, and pass invalid inputs
+    Expectation: The output is the same in both modes, TypeError or RuntimeError is raised for invalid inputs
+    """
+    origin_seed = ds.config.get_seed()
+    origin_spill_dir = ds.config.get_shuffle_spill_dir()
+    spill_dir = "./shuffle_spill_dir_test"
+    os.makedirs(spill_dir, exist_ok=True)
+
+    def run_pipeline():
+        ds.config.set_seed(3)
+        data = ds.GeneratorDataset([(np.full((i % 5 + 1, 8), i, np.int32), np.array("row{}".format(i)))
+                                    for i in range(100)], ["data", "text"], shuffle=False)
+        data = data.shuffle(16)
+        return [(item["data"], item["text"])
+                for item in data.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    ds.config.set_shuffle_spill_dir("")
+    expected = run_pipeline()
+    ds.config.set_shuffle_spill_dir(spill_dir)
+    assert ds.config.get_shuffle_spill_dir() == os.path.realpath(spill_dir)
+    output = run_pipeline()
+    assert len(output) == len(expected)
+    for (out_data, out_text), (exp_data, exp_text) in zip(output, expected):
+        np.testing.assert_array_equal(out_data, exp_data)
+        assert out_text == exp_text
+    ds.config.set_shuffle_spill_dir(None)
+    assert ds.config.get_shuffle_spill_dir() == ""
+
+    config_error_func(ds.config.set_shuffle_spill_dir, 1, TypeError, "spill_dir must be of type str")
+    config_error_func(ds.config.set_shuffle_spill_dir, "./not_exist_spill_dir", RuntimeError, "does not exist")
+    ds.config.set_shuffle_spill_dir(origin_spill_dir)
+    ds.config.set_seed(origin_seed)
+    for name in os.listdir(spill_dir):
+        os.remove(os.path.join(spill_dir, name))
+    os.rmdir(spill_dir)
+
+
+def test_state_history_size():
+    """
+    Feature: Test the set_state_history_size function
+    Description: Set valid and invalid sizes of the pipeline state history
+    Expectation: The values are set, TypeError or ValueError is raised for invalid inputs
+    """
+    origin_size = ds.config.get_state_history_size()
+    assert origin_size == 0
+    ds.config.set_state_history_size(128)
+    assert ds.config.get_state_history_size() == 128
+    ds.config.set_state_history_size(origin_size)
+    assert ds.config.get_state_history_size() == origin_size
+
+    config_error_func(ds.config.set_state_history_size, True, TypeError, "size isn't of type int")
+    config_error_func(ds.config.set_state_history_size, 1.5, TypeError, "size isn't of type int")
+    config_error_func(ds.config.set_state_history_size, -1, ValueError, "size is not within the required range")
+    config_error_func(ds.config.set_state_history_size, 2147483648, ValueError,
+                      "size is not within the required range")
+
+
 if __name__ == '__main__':
     test_basic()
     test_get_seed()
@@ -532,3 +721,9 @@ if __name__ == '__main__':
     test_multiprocessing_timeout_interval()
     test_config_bool_type_error()
     test_fast_recovery()
+    test_lock_free_connector()
+    test_async_read_depth()
+    test_tensor_pool_size()
+    test_autotune_budget()
+    test_shuffle_spill_dir()
+    test_state_history_size()
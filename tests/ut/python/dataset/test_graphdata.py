@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 # ==============================================================================
+import os
 import random
 import pytest
 import numpy as np
@@ -333,6 +334,75 @@ def test_graphdata_getedgesfromnodes():
     assert edges.tolist() == [1, 9, 31, 17, 20, 40]
 
 
+def test_graphdata_csr_storage():
+    """
+    Feature: GraphData
+    Description: Test GraphData with the csr storage format, built from the dataset and mapped from its snapshot
+    Expectation: Output is equal to the output of the object storage format
+    """
+    logger.info('test csr storage format\n')
+    snapshot_file = "./test_graphdata_csr.snapshot"
+    if os.path.exists(snapshot_file):
+        os.remove(snapshot_file)
+
+    def dump(g):
+        nodes = g.get_all_nodes(1)
+        edges = g.get_all_edges(0)
+        return [nodes.tolist(), g.get_all_neighbors(nodes, 2).tolist(),
+                [f.tolist() for f in g.get_node_feature(nodes, [1, 2, 3])],
+                g.get_nodes_from_edges(edges).tolist(), [f.tolist() for f in g.get_edge_feature(edges, [1, 2])],
+                g.get_edges_from_nodes([(101, 201), (103, 207), (204, 105)]).tolist(), g.graph_info()['node_num'],
+                g.graph_info()['edge_num']]
+
+    expected = dump(ds.GraphData(DATASET_FILE))
+    assert dump(ds.GraphData(DATASET_FILE, storage_format='csr')) == expected
+    assert dump(ds.GraphData(DATASET_FILE, storage_format='csr', snapshot_file=snapshot_file)) == expected
+    assert os.path.exists(snapshot_file)
+    g = ds.GraphData(DATASET_FILE, storage_format='csr', snapshot_file=snapshot_file)
+    assert dump(g) == expected
+    assert g.get_sampled_neighbors(g.get_all_nodes(1), [2, 3], [2, 1]).shape == (10, 9)
+
+    # the snapshot of another version of the dataset file is rebuilt rather than mapped
+    dataset_stat = os.stat(DATASET_FILE)
+    snapshot_inode = os.stat(snapshot_file).st_ino
+    os.utime(DATASET_FILE, (dataset_stat.st_atime, dataset_stat.st_mtime + 10))
+    try:
+        assert dump(ds.GraphData(DATASET_FILE, storage_format='csr', snapshot_file=snapshot_file)) == expected
+        assert os.stat(snapshot_file).st_ino != snapshot_inode
+    finally:
+        os.utime(DATASET_FILE, (dataset_stat.st_atime, dataset_stat.st_mtime))
+    os.remove(snapshot_file)
+
+    with pytest.raises(ValueError, match="Invalid storage format"):
+        ds.GraphData(DATASET_FILE, storage_format='columns')
+    with pytest.raises(ValueError, match="only supported when storage_format is 'csr'"):
+        ds.GraphData(DATASET_FILE, snapshot_file=snapshot_file)
+    with pytest.raises(ValueError, match="only supported when working_mode is 'local'"):
+        ds.GraphData(DATASET_FILE, working_mode='client', storage_format='csr')
+
+
+def test_graphdata_getsampledsubgraph():
+    """
+    Feature: GraphData
+    Description: Test GraphData get_sampled_subgraph, with both storage formats
+    Expectation: Output is the sampled neighbors followed by their features
+    """
+    logger.info('test get sampled subgraph.\n')
+    for storage_format in ['object', 'csr']:
+        g = ds.GraphData(DATASET_FILE, 2, storage_format=storage_format)
+        nodes = g.get_all_nodes(1)
+        neighbors, feature_1, feature_2 = g.get_sampled_subgraph(nodes, [2, 3], [2, 1], [1, 2])
+        assert neighbors.shape == (10, 9)
+        expected = g.get_node_feature(neighbors, [1, 2])
+        assert np.array_equal(feature_1, expected[0])
+        assert np.array_equal(feature_2, expected[1])
+
+    with pytest.raises(ValueError, match="inconsistent"):
+        g.get_sampled_subgraph(nodes, [2, 3], [2], [1])
+    with pytest.raises(ValueError, match="feature_types can not be empty"):
+        g.get_sampled_subgraph(nodes, [2, 3], [2, 1], [])
+
+
 if __name__ == '__main__':
     test_graphdata_getfullneighbor()
     test_graphdata_getnodefeature_input_check()
@@ -346,3 +416,5 @@ if __name__ == '__main__':
     test_graphdata_getedgesfromnodes()
     test_graphdata_getnodefeature_invalidcase()
     test_graphdata_getedgefeature_invalidcase()
+    test_graphdata_csr_storage()
+    test_graphdata_getsampledsubgraph()
@@ -2796,6 +2796,90 @@ def test_distributed_shuffle_with_multi_epochs(create_multi_mindrecord_files):
     ds.config.set_seed(original_seed)
 
 
+def test_partial_shuffle(create_multi_mindrecord_files):
+    """
+    Feature: MindDataset
+    Description: Test MindDataset with shuffle=Shuffle.PARTIAL, without and with num_shards and num_samples
+    Expectation: Every row is read once, in an order which only depends on the seed
+    """
+    original_seed = config_get_set_seed(1)
+    file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    files = [file_name + str(idx) for idx in range(4)]
+
+    def read_ids(num_parallel_workers, **kwargs):
+        data_set = ds.MindDataset(dataset_files=files, num_parallel_workers=num_parallel_workers,
+                                  shuffle=ds.Shuffle.PARTIAL, **kwargs)
+        return [item["id"].item() for item in data_set.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    ids = read_ids(2)
+    assert len(ids) == 52
+    assert sorted(ids) == list(range(52))
+    assert ids != list(range(52))
+    # the order does not depend on the number of workers
+    assert read_ids(4) == ids
+
+    ds.config.set_seed(2)
+    assert read_ids(2) != ids
+    ds.config.set_seed(1)
+
+    assert read_ids(2, num_samples=20) == ids[:20]
+
+    shard_ids = []
+    for shard_id in range(4):
+        shard = read_ids(2, num_shards=4, shard_id=shard_id)
+        assert len(shard) == 13
+        shard_ids.extend(shard)
+    assert sorted(shard_ids) == list(range(52))
+
+    with pytest.raises(ValueError, match="only supported by MindDataset"):
+        ds.TFRecordDataset(files, shuffle=ds.Shuffle.PARTIAL)
+
+    ds.config.set_seed(original_seed)
+
+
+def test_partial_shuffle_across_windows():
+    """
+    Feature: MindDataset
+    Description: Test shuffle=Shuffle.PARTIAL on more rows than a window of blocks, so the workers and the shards
+        read on both sides of block and window boundaries
+    Expectation: Every row is read once, in the same order whatever the number of workers
+    """
+    original_seed = config_get_set_seed(1)
+    file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    # a window is 64 blocks of 1024 rows
+    items = [40000, 30000]
+    files = [file_name + str(idx) for idx in range(len(items))]
+    try:
+        index = 0
+        for file, num_rows in zip(files, items):
+            writer = FileWriter(file)
+            writer.add_schema({"id": {"type": "int32"}}, "data is so cool")
+            writer.write_raw_data([{"id": i} for i in range(index, index + num_rows)])
+            writer.commit()
+            index += num_rows
+
+        def read_ids(num_parallel_workers, **kwargs):
+            data_set = ds.MindDataset(dataset_files=files, num_parallel_workers=num_parallel_workers,
+                                      shuffle=ds.Shuffle.PARTIAL, **kwargs)
+            return [item["id"].item() for item in data_set.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+        ids = read_ids(1)
+        assert sorted(ids) == list(range(sum(items)))
+        assert read_ids(8) == ids
+
+        shard_ids = []
+        for shard_id in range(3):
+            shard_ids.extend(read_ids(4, num_shards=3, shard_id=shard_id))
+        assert len(shard_ids) >= sum(items)
+        assert set(shard_ids) == set(ids)
+    finally:
+        ds.config.set_seed(original_seed)
+        for file in files:
+            for suffix in ("", ".db"):
+                if os.path.exists(file + suffix):
+                    os.remove(file + suffix)
+
+
 def test_field_is_null_numpy():
     """
     Feature: MindDataset
@@ -2987,6 +3071,147 @@ def test_minddataset_multi_files_with_empty_one(add_and_remove_three_nlp_file_wi
     read_multi_mindrecord_files([paths[1], paths[0], paths[2]])
     read_multi_mindrecord_files([paths[0], paths[2], paths[1]])
 
+def test_minddataset_mmap():
+    """
+    Feature: MindDataset
+    Description: Read float32/int64 arrays, bytes and scalars with the MindRecord files memory mapped
+    Expectation: Output is the same as reading the files through file streams, in every epoch
+    """
+    mindrecord_file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    origin_mindrecord_mmap = ds.config.get_mindrecord_mmap()
+    try:
+        data = [{"float32_array": np.arange(i, i + 12, dtype=np.float32).reshape(3, 4),
+                 "int64_array": np.array([i, -i, i * 1000000], dtype=np.int64),
+                 "image": bytes("image bytes abc" * (i + 1), encoding='UTF-8'),
+                 "label": i} for i in range(10)]
+        writer = FileWriter(mindrecord_file_name)
+        schema = {"float32_array": {"type": "float32", "shape": [3, 4]},
+                  "int64_array": {"type": "int64", "shape": [-1]},
+                  "image": {"type": "bytes"},
+                  "label": {"type": "int32"}}
+        writer.add_schema(schema, "data is so cool")
+        writer.write_raw_data(data)
+        writer.commit()
+
+        def read_all():
+            data_set = ds.MindDataset(dataset_files=mindrecord_file_name, num_parallel_workers=2, shuffle=False)
+            epochs = []
+            dataset_iter = data_set.create_dict_iterator(num_epochs=2, output_numpy=True)
+            for _ in range(2):
+                epochs.append([item for item in dataset_iter])
+            return epochs
+
+        ds.config.set_mindrecord_mmap(False)
+        expected = read_all()
+        ds.config.set_mindrecord_mmap(True)
+        assert ds.config.get_mindrecord_mmap()
+        result = read_all()
+        assert len(result) == len(expected)
+        for epoch, expected_epoch in zip(result, expected):
+            assert len(epoch) == 10
+            for index, (item, expected_item) in enumerate(zip(epoch, expected_epoch)):
+                assert (item["float32_array"] == data[index]["float32_array"]).all()
+                for field in item:
+                    assert (item[field] == expected_item[field]).all()
+    finally:
+        ds.config.set_mindrecord_mmap(origin_mindrecord_mmap)
+        os.remove("{}".format(mindrecord_file_name))
+        os.remove("{}.db".format(mindrecord_file_name))
+
+
+def test_minddataset_columnar_index():
+    """
+    Feature: MindDataset
+    Description: Write MindRecord files with the columnar index, and read them without the database files
+    Expectation: Output is the same as reading through the database files, also with PKSampler
+    """
+    mindrecord_file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    file_names = [mindrecord_file_name + str(x) for x in range(FILES_NUM)]
+    try:
+        data = [{"image": bytes("image bytes abc" * (i + 1), encoding='UTF-8'),
+                 "file_name": "{}.jpg".format(i),
+                 "label": i % 3,
+                 "score": i * 0.5} for i in range(20)]
+        schema = {"image": {"type": "bytes"},
+                  "file_name": {"type": "string"},
+                  "label": {"type": "int32"},
+                  "score": {"type": "float64"}}
+
+        def read_all(columns_list, sampler=None):
+            if sampler is None:
+                data_set = ds.MindDataset(dataset_files=file_names, columns_list=columns_list,
+                                          num_parallel_workers=2, shuffle=False)
+            else:
+                data_set = ds.MindDataset(dataset_files=file_names, columns_list=columns_list,
+                                          num_parallel_workers=2, sampler=sampler)
+            return [item for item in data_set.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+        results = []
+        for columnar_index in (False, True):
+            writer = FileWriter(mindrecord_file_name, FILES_NUM, overwrite=True)
+            writer.set_columnar_index(columnar_index)
+            writer.add_schema(schema, "data is so cool")
+            writer.add_index(["file_name", "label", "score"])
+            writer.write_raw_data(data)
+            writer.commit()
+            assert os.path.exists(file_names[0] + ".idx") == columnar_index
+            if columnar_index:
+                for x in file_names:
+                    os.remove("{}.db".format(x))
+            results.append((read_all(["file_name", "label", "score"]), read_all(["image", "label"]),
+                            read_all(["file_name", "label"], ds.PKSampler(2))))
+
+        for expected, result in zip(results[0], results[1]):
+            assert len(result) == len(expected)
+            assert result
+            for item, expected_item in zip(result, expected):
+                for field in item:
+                    assert (item[field] == expected_item[field]).all()
+    finally:
+        for x in file_names:
+            for suffix in ("", ".db", ".idx"):
+                if os.path.exists(x + suffix):
+                    os.remove(x + suffix)
+
+
+def test_minddataset_mmap_read_row_twice():
+    """
+    Feature: MindDataset
+    Description: Read the rows of memory mapped MindRecord files several times in one epoch with a sampler with
+        replacement, adding one in place to the float32 array of every row
+    Expectation: Every row read sees the bytes of the file, not the edits made to the earlier reads of the row
+    """
+    mindrecord_file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    origin_mindrecord_mmap = ds.config.get_mindrecord_mmap()
+    try:
+        data = [{"float32_array": np.arange(i, i + 12, dtype=np.float32).reshape(3, 4),
+                 "label": i} for i in range(5)]
+        writer = FileWriter(mindrecord_file_name)
+        schema = {"float32_array": {"type": "float32", "shape": [3, 4]},
+                  "label": {"type": "int32"}}
+        writer.add_schema(schema, "data is so cool")
+        writer.write_raw_data(data)
+        writer.commit()
+
+        def add_one(x):
+            x += 1
+            return x
+
+        ds.config.set_mindrecord_mmap(True)
+        sampler = ds.RandomSampler(replacement=True, num_samples=40)
+        data_set = ds.MindDataset(dataset_files=mindrecord_file_name, num_parallel_workers=2, sampler=sampler)
+        data_set = data_set.map(operations=add_one, input_columns=["float32_array"])
+        num_rows = 0
+        for item in data_set.create_dict_iterator(num_epochs=1, output_numpy=True):
+            assert (item["float32_array"] == data[item["label"]]["float32_array"] + 1).all()
+            num_rows += 1
+        assert num_rows == 40
+    finally:
+        ds.config.set_mindrecord_mmap(origin_mindrecord_mmap)
+        os.remove("{}".format(mindrecord_file_name))
+        os.remove("{}.db".format(mindrecord_file_name))
+
+
 if __name__ == '__main__':
     test_nlp_compress_data(add_and_remove_nlp_compress_file)
     test_nlp_compress_data_old_version(add_and_remove_nlp_compress_file)
@@ -3022,5 +3247,10 @@ if __name__ == '__main__':
     test_shuffle_with_global_infile_files(create_multi_mindrecord_files)
     test_distributed_shuffle_with_global_infile_files(create_multi_mindrecord_files)
     test_distributed_shuffle_with_multi_epochs(create_multi_mindrecord_files)
+    test_partial_shuffle(create_multi_mindrecord_files)
+    test_partial_shuffle_across_windows()
     test_field_is_null_numpy()
     test_for_loop_dataset_iterator(add_and_remove_nlp_compress_file)
+    test_minddataset_mmap()
+    test_minddataset_columnar_index()
+    test_minddataset_mmap_read_row_twice()
@@ -359,6 +359,85 @@ class TestMinddataProfilingManager:
         # Confirm dataset iterator file content
         self.confirm_dataset_iterator_file(dataset_iterator_file, 32)
 
+    def test_profiling_tensor_pool(self, tmp_path):
+        """
+        Feature: MindData Profiling Manager
+        Description: Test MindData profiling of a pipeline with a tensor buffer pool (Generator -> Map -> Batch)
+        Expectation: The counters of the pool are saved along with the other profiling files
+        """
+        tensor_pool_size_origin = ds.config.get_tensor_pool_size()
+        ds.config.set_tensor_pool_size(16)
+
+        source = [(np.ones((64, 64), np.float32) * x,) for x in range(256)]
+        data1 = ds.GeneratorDataset(source, ["data"])
+        data1 = data1.map(operations=[C.TypeCast(mstype.float64)], input_columns=["data"])
+        data1 = data1.batch(16)
+
+        for _ in data1:
+            pass
+
+        ds.config.set_tensor_pool_size(tensor_pool_size_origin)
+
+        # Stop MindData Profiling and save output files to tmp_path
+        self.md_profiler.stop()
+        self.md_profiler.save(str(tmp_path))
+
+        tensor_pool_file = str(tmp_path) + "/tensor_pool_profiling_0.json"
+        assert os.path.exists(tensor_pool_file) is True
+        with open(tensor_pool_file) as file1:
+            data = json.load(file1)
+            assert data["capacity_bytes"] == 16 * 1024 * 1024
+            num_samples = len(data["time_stamp"])
+            assert num_samples > 0
+            for counter in ["hits", "misses", "bytes_in_pool", "bytes_in_use"]:
+                assert len(data[counter]) == num_samples
+            # the counters only grow
+            assert data["hits"] == sorted(data["hits"])
+            assert data["misses"] == sorted(data["misses"])
+
+    def test_profiling_op_latency(self, tmp_path):
+        """
+        Feature: MindData Profiling Manager
+        Description: Test MindData profiling of the latencies of the ops (Generator -> Map -> Batch)
+        Expectation: Every row computed by the map and each of its TensorOps is counted in the latency file
+        """
+        source = [(np.ones((64, 64), np.float32) * x,) for x in range(256)]
+        data1 = ds.GeneratorDataset(source, ["data"])
+        data1 = data1.map(operations=[C.TypeCast(mstype.float64), C.TypeCast(mstype.int32)], input_columns=["data"],
+                          num_parallel_workers=2)
+        data1 = data1.batch(16)
+
+        num_iter = 0
+        for _ in data1.create_tuple_iterator(num_epochs=1):
+            num_iter += 1
+        assert num_iter == 16
+
+        # Stop MindData Profiling and save output files to tmp_path
+        self.md_profiler.stop()
+        self.md_profiler.save(str(tmp_path))
+
+        op_latency_file = str(tmp_path) + "/op_latency_profiling_0.json"
+        assert os.path.exists(op_latency_file) is True
+        with open(op_latency_file) as file1:
+            data = json.load(file1)
+            num_samples = len(data["time_stamp"])
+            op_info = {op["op_type"]: op for op in data["op_info"]}
+            assert sorted(op_info) == ["BatchOp", "GeneratorOp", "MapOp"]
+            for op in op_info.values():
+                for metric in ["compute", "push_wait", "pop_wait"]:
+                    assert len(op["metrics"][metric]["count"]) == num_samples
+                    assert len(op["metrics"][metric]["p99_ns"]) == num_samples
+            map_metrics = op_info["MapOp"]["metrics"]
+            assert map_metrics["compute"]["total"]["count"] == 256
+            assert map_metrics["push_wait"]["total"]["count"] == 256
+            assert op_info["BatchOp"]["metrics"]["push_wait"]["total"]["count"] == 16
+            assert op_info["GeneratorOp"]["metrics"]["compute"]["total"]["count"] == 0
+            tensor_ops = map_metrics["tensor_ops"]
+            assert [tensor_op["name"] for tensor_op in tensor_ops] == ["TypeCastOp", "TypeCastOp"]
+            for tensor_op in tensor_ops:
+                assert tensor_op["total"]["count"] == 256
+                assert tensor_op["total"]["p50_ns"] <= tensor_op["total"]["p99_ns"]
+
     def test_profiling_basic_pipeline(self, tmp_path):
         """
         Feature: MindData Profiling Manager
@@ -16,10 +16,12 @@
 Testing dataset pipeline failover Reset
 """
 import os
+import time
 import numpy as np
 import pytest
 import mindspore.dataset as ds
 import mindspore.dataset.vision as vision
+from mindspore import log as logger
 from util_minddataset import add_and_remove_cv_file
 
 # pylint: disable=no-value-for-parameter
@@ -371,6 +373,150 @@ def test_repeatable_reset_distributed(shard_id, num_parallel_workers, to_pil):
     ds.config.set_enable_shared_mem(original_shared_mem)
 
 
+def create_shuffled_np_dataset(size):
+    np_data = np.arange(size * 2).reshape((size, 2))
+    data = ds.NumpySlicesDataset(np_data, shuffle=True)
+    data = data.shuffle(8)
+    data = data.batch(3)
+    data = data.repeat(2)
+    return data
+
+
+def create_shuffled_tfrecord_dataset():
+    data_dir = "../data/dataset/test_tf_file_3_images2/"
+    files = [data_dir + "train-0000-of-000{}.data".format(i) for i in range(1, 5)]
+    data = ds.TFRecordDataset(files, data_dir + "datasetSchema.json", columns_list=["label"],
+                              shuffle=ds.Shuffle.FILES)
+    data = data.shuffle(4)
+    data = data.batch(2, drop_remainder=True)
+    return data
+
+
+def create_shuffled_minddata_dataset():
+    file_name = os.environ.get('PYTEST_CURRENT_TEST').split(':')[-1].split(' ')[0]
+    data = ds.MindDataset(file_name + "0", ["id", "label"], num_parallel_workers=2, shuffle=True)
+    data = data.shuffle(5)
+    data = data.batch(4)
+    return data
+
+
+def run_reset_with_state(create_func, num_epochs, failure_steps, history_size=1000):
+    """ Reset a pipeline which keeps the state of its steps, to steps in and out of the history """
+    original_seed = ds.config.get_seed()
+    original_fast_recovery = ds.config.get_fast_recovery()
+    original_history_size = ds.config.get_state_history_size()
+    ds.config.set_seed(1)
+    ds.config.set_fast_recovery(True)
+    ds.config.set_state_history_size(history_size)
+
+    data = create_func()
+    total_steps = data.get_dataset_size() * num_epochs
+    for failure_point in range(0, total_steps, failure_steps):
+        for reset_step in range(0, total_steps, failure_steps):
+            run_reset(data, num_epochs=num_epochs, failure_point=failure_point, reset_step=reset_step)
+
+    ds.config.set_seed(original_seed)
+    ds.config.set_fast_recovery(original_fast_recovery)
+    ds.config.set_state_history_size(original_history_size)
+
+
+def test_reset_state_np():
+    """
+    Feature: Dataset recovery
+    Description: Reset a pipeline with a random sampler, shuffle, batch and repeat to the state of a step
+    Expectation: Same datasets after reset as without failure
+    """
+    run_reset_with_state(lambda: create_shuffled_np_dataset(50), num_epochs=3, failure_steps=5)
+    run_reset_with_state(lambda: create_shuffled_np_dataset(50), num_epochs=3, failure_steps=5, history_size=4)
+
+
+def test_reset_state_tfrecord():
+    """
+    Feature: Dataset recovery
+    Description: Reset a pipeline with TFRecordDataset shuffling its files, shuffle and batch to the state of a step
+    Expectation: Same datasets after reset as without failure
+    """
+    run_reset_with_state(create_shuffled_tfrecord_dataset, num_epochs=3, failure_steps=2)
+
+
+def test_reset_state_mindrecord(add_and_remove_cv_file):  # pylint: disable=unused-argument, redefined-outer-name
+    """
+    Feature: Dataset recovery
+    Description: Reset a pipeline with a shuffled MindDataset, shuffle and batch to the state of a step
+    Expectation: Same datasets after reset as without failure
+    """
+    run_reset_with_state(create_shuffled_minddata_dataset, num_epochs=2, failure_steps=1)
+
+
+def create_shuffled_in_place_dataset(size):
+    def add_in_place(x):
+        x += 1000
+        return x
+
+    np_data = np.arange(size * 2).reshape((size, 2))
+    data = ds.NumpySlicesDataset(np_data, shuffle=False)
+    data = data.shuffle(8)
+    data = data.map(add_in_place, input_columns=["column_0"])
+    data = data.batch(3)
+    return data
+
+
+def test_reset_state_in_place():
+    """
+    Feature: Dataset recovery
+    Description: Reset a pipeline whose map changes the rows sent by shuffle in place, to the state of a step
+    Expectation: Same datasets after reset as without failure, the state of shuffle is not changed by the map
+    """
+    run_reset_with_state(lambda: create_shuffled_in_place_dataset(50), num_epochs=2, failure_steps=3)
+
+
+def test_reset_state_time():
+    """
+    Feature: Dataset recovery
+    Description: Reset a long pipeline late in the last epoch, by restoring the state of the step and by skipping
+    Expectation: Same rows after reset in both modes, the time of each reset is logged
+    """
+    original_seed = ds.config.get_seed()
+    original_fast_recovery = ds.config.get_fast_recovery()
+    original_history_size = ds.config.get_state_history_size()
+    ds.config.set_fast_recovery(True)
+    num_epochs = 4
+    size = 20000
+    failure_point = num_epochs * size // 4 - 10
+
+    def reset_and_fetch(history_size):
+        ds.config.set_seed(1)
+        ds.config.set_state_history_size(history_size)
+        np_data = np.arange(size * 4).reshape((size, 4))
+        data = ds.NumpySlicesDataset(np_data, shuffle=True).shuffle(100).batch(4)
+        itr = data.create_tuple_iterator(num_epochs=num_epochs, output_numpy=True)
+        ds.engine.datasets._set_training_dataset(itr)  # pylint: disable=W0212
+        step = 0
+        for _ in range(num_epochs):
+            for _ in itr:
+                step += 1
+                if step == failure_point:
+                    break
+            if step == failure_point:
+                break
+        start = time.time()
+        ds.engine.datasets._reset_training_dataset(failure_point)  # pylint: disable=W0212
+        rows = [d for _, d in zip(range(10), itr)]
+        return time.time() - start, rows
+
+    restore_time, restored = reset_and_fetch(100)
+    skip_time, skipped = reset_and_fetch(0)
+    logger.info("Reset to step {}: {:.3f}s by restoring the state, {:.3f}s by skipping.".format(
+        failure_point, restore_time, skip_time))
+    assert len(restored) == len(skipped) == 10
+    for x, y in zip(restored, skipped):
+        np.testing.assert_array_equal(x, y)
+
+    ds.config.set_seed(original_seed)
+    ds.config.set_fast_recovery(original_fast_recovery)
+    ds.config.set_state_history_size(original_history_size)
+
+
 if __name__ == "__main__":
     test_reset_np()
     test_reset_cifar1()
@@ -380,3 +526,8 @@ if __name__ == "__main__":
     test_reset_np_error()
     test_repeatable_reset_imagenet()
     test_repeatable_reset_distributed()
+    test_reset_state_np()
+    test_reset_state_tfrecord()
+    test_reset_state_mindrecord(add_and_remove_cv_file)
+    test_reset_state_in_place()
+    test_reset_state_time()
@@ -13,6 +13,8 @@
 # limitations under the License.
 # ==============================================================================
 
+import os
+
 import numpy as np
 import pytest
 
@@ -226,6 +228,63 @@ def test_vectors_invalid_input():
                        " but got <class 'str'>.", lower_case_backup="True")
 
 
+def test_vectors_from_binary():
+    """
+    Feature: Vectors
+    Description: Test converting a vector file to a binary vector file and loading it with from_binary
+    Expectation: ToVectors outputs the same vectors as those of the vector file
+    """
+    binary_path = "./test_vectors_from_binary.bin"
+    text.Vectors.convert_to_binary(DATASET_ROOT_PATH + "vectors.txt", binary_path)
+    vectors = text.Vectors.from_file(DATASET_ROOT_PATH + "vectors.txt")
+    binary_vectors = text.Vectors.from_binary(binary_path)
+    my_unk = [-1, -1, -1, -1, -1, -1]
+    to_vectors = T.ToVectors(vectors, unk_init=my_unk, lower_case_backup=True)
+    binary_to_vectors = T.ToVectors(binary_vectors, unk_init=my_unk, lower_case_backup=True)
+    for token in ["Ok", "!", "This", "is", "my", "home", "none"]:
+        assert np.array_equal(binary_to_vectors(token), to_vectors(token))
+    assert np.array_equal(binary_to_vectors(["this", "none", "is"]), to_vectors(["this", "none", "is"]))
+
+    data = ds.TextFileDataset(DATASET_ROOT_PATH + "words.txt", shuffle=False)
+    data = data.map(operations=text.ToVectors(binary_vectors), input_columns=["text"])
+    ind = 0
+    res = [[0.418, 0.24968, -0.41242, 0.1217, 0.34527, -0.04445718411],
+           [0, 0, 0, 0, 0, 0],
+           [0.15164, 0.30177, -0.16763, 0.17684, 0.31719, 0.33973],
+           [0.70853, 0.57088, -0.4716, 0.18048, 0.54449, 0.72603],
+           [0.68047, -0.039263, 0.30186, -0.17792, 0.42962, 0.032246],
+           [0.26818, 0.14346, -0.27877, 0.016257, 0.11384, 0.69923],
+           [0, 0, 0, 0, 0, 0]]
+    for d in data.create_dict_iterator(num_epochs=1, output_numpy=True):
+        res_array = np.array(res[ind], dtype=np.float32)
+        assert np.array_equal(res_array, d["text"]), ind
+        ind += 1
+    os.remove(binary_path)
+
+
+def test_vectors_from_binary_invalid_input():
+    """
+    Feature: Vectors
+    Description: Test convert_to_binary and from_binary with invalid parameters
+    Expectation: Correct error is raised as expected
+    """
+    with pytest.raises(RuntimeError) as error_info:
+        text.Vectors.from_binary(DATASET_ROOT_PATH + "vectors.txt")
+    assert "is not a binary vector file" in str(error_info.value)
+    with pytest.raises(RuntimeError) as error_info:
+        text.Vectors.from_binary(DATASET_ROOT_PATH + "not_exist.bin")
+    assert "get real path failed" in str(error_info.value)
+    with pytest.raises(RuntimeError) as error_info:
+        text.Vectors.convert_to_binary(DATASET_ROOT_PATH + "vectors_empty.txt", "./vectors_empty.bin")
+    assert "invalid file, file is empty." in str(error_info.value)
+    with pytest.raises(ValueError) as error_info:
+        text.Vectors.convert_to_binary(DATASET_ROOT_PATH + "vectors.txt", "./vectors.bin", max_vectors=-1)
+    assert "Input max_vectors is not within the required interval" in str(error_info.value)
+    with pytest.raises(TypeError) as error_info:
+        text.Vectors.convert_to_binary(DATASET_ROOT_PATH + "vectors.txt", 1)
+    assert "Argument binary_path with value 1 is not of type" in str(error_info.value)
+
+
 if __name__ == '__main__':
     test_vectors_all_tovectors_params_eager()
     test_vectors_from_file()
@@ -233,3 +292,5 @@ if __name__ == '__main__':
     test_vectors_from_file_all_buildfromfile_params_eager()
     test_vectors_from_file_eager()
     test_vectors_invalid_input()
+    test_vectors_from_binary()
+    test_vectors_from_binary_invalid_input()